@@ -0,0 +1,338 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_AFQMC_HAMOPSCACHE_HPP
+#define QMCPLUSPLUS_AFQMC_HAMOPSCACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "AFQMC/config.h"
+#include "AFQMC/Utilities/taskgroup.h"
+
+namespace qmcplusplus
+{
+namespace afqmc
+{
+/*
+ * Binary cache of fully constructed HamiltonianOperations.
+ * Every node writes the node-shared objects it holds into its own file, made of page aligned sections:
+ * a header with the key the file was built for, followed by the raw arrays of the objects in a fixed order.
+ * On load the node root maps the file and copies every section directly into the node-shared buffers,
+ * without any parsing, conversion or redistribution.
+ * The key identifies the inputs (a hash of the integrals and trial wavefunction plus all parameters),
+ * the task group layout and the precision, a file is only used if its stored key matches exactly.
+ */
+namespace hamops_cache
+{
+constexpr std::size_t page_size   = 4096;
+constexpr int format_version      = 1;
+constexpr char magic[8]           = {'A', 'F', 'Q', 'M', 'C', 'H', 'O', 'P'};
+constexpr std::uint64_t fnv_basis = 14695981039346656037ULL;
+
+inline std::size_t page_align(std::size_t n) { return (n + page_size - 1) / page_size * page_size; }
+
+/// 64 bit FNV-1a hash of a buffer, hashed by words for speed. Stable across runs, unlike std::hash
+inline std::uint64_t hash(const void* data, std::size_t bytes, std::uint64_t h = fnv_basis)
+{
+  const char* p = static_cast<const char*>(data);
+  for (; bytes >= sizeof(std::uint64_t); bytes -= sizeof(std::uint64_t), p += sizeof(std::uint64_t))
+  {
+    std::uint64_t w;
+    std::memcpy(&w, p, sizeof(std::uint64_t));
+    h ^= w;
+    h *= 1099511628211ULL;
+  }
+  for (; bytes > 0; --bytes, ++p)
+  {
+    h ^= static_cast<unsigned char>(*p);
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+/// hash of the shape and the non-zero elements of a csr matrix
+template<class CSR>
+inline std::uint64_t hash_csr(CSR const& A, std::uint64_t h = fnv_basis)
+{
+  std::size_t dims[2] = {std::size_t(A.size(0)), std::size_t(A.size(1))};
+  h                   = hash(dims, sizeof(dims), h);
+  auto pb             = to_address(A.pointers_begin());
+  auto pe             = to_address(A.pointers_end());
+  auto vals           = to_address(A.non_zero_values_data());
+  auto cols           = to_address(A.non_zero_indices2_data());
+  for (std::size_t i = 0; i < A.size(0); i++)
+  {
+    std::size_t nnz = pe[i] - pb[i];
+    h               = hash(&nnz, sizeof(nnz), h);
+    h               = hash(vals + (pb[i] - pb[0]), nnz * sizeof(*vals), h);
+    h               = hash(cols + (pb[i] - pb[0]), nnz * sizeof(*cols), h);
+  }
+  return h;
+}
+
+/// part of the key describing the task group layout and the precision of the build
+inline std::string layout_key(TaskGroup_& TGprop, TaskGroup_& TGwfn)
+{
+  std::ostringstream key;
+  key << "version=" << format_version << ";precision=" << sizeof(ValueType) << "," << sizeof(SPValueType) << ","
+      << sizeof(SPComplexType) << "," << sizeof(std::size_t) << ";ranks=" << TGwfn.getGlobalSize()
+      << ";nodes=" << TGwfn.getTotalNodes() << ";cores=" << TGwfn.getTotalCores()
+      << ";TGprop=" << TGprop.getNGroupsPerTG() << "," << TGprop.getNCoresPerTG()
+      << ";TGwfn=" << TGwfn.getNGroupsPerTG() << "," << TGwfn.getNCoresPerTG();
+  return key.str();
+}
+
+/// cache file of the node with index node for the given key
+inline std::string file_name(std::string const& cache_dir, std::string const& key, int node)
+{
+  std::ostringstream fname;
+  fname << cache_dir << "/hamops_" << std::hex << std::setw(16) << std::setfill('0')
+        << hash(key.data(), key.size()) << std::dec << "_node" << node << ".bin";
+  return fname.str();
+}
+
+struct header
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t key_size;
+  std::uint64_t file_size;
+};
+
+/*
+ * Writes a cache file section by section. Only used by the node root.
+ * The file is written under a temporary name and renamed by close(), so a partially written file is never read.
+ */
+class writer
+{
+public:
+  writer(std::string const& fname, std::string const& key) : fname_(fname), tmp_(fname + ".tmp")
+  {
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(fname).parent_path(), ec);
+    out_.open(tmp_, std::ios::binary | std::ios::trunc);
+    header h;
+    std::memcpy(h.magic, magic, sizeof(magic));
+    h.version   = format_version;
+    h.key_size  = key.size();
+    h.file_size = 0;
+    append(&h, 1);
+    append(key.data(), key.size());
+    align();
+  }
+
+  ~writer()
+  {
+    if (out_.is_open())
+    {
+      out_.close();
+      std::remove(tmp_.c_str());
+    }
+  }
+
+  template<class T>
+  void append(T const* p, std::size_t n)
+  {
+    out_.write(reinterpret_cast<const char*>(p), n * sizeof(T));
+    offset_ += n * sizeof(T);
+  }
+
+  // pads the current section to a page boundary
+  void align()
+  {
+    static const std::vector<char> zeros(page_size, 0);
+    std::size_t pad = page_align(offset_) - offset_;
+    out_.write(zeros.data(), pad);
+    offset_ += pad;
+  }
+
+  template<class T>
+  void write(T const* p, std::size_t n)
+  {
+    append(p, n);
+    align();
+  }
+
+  // descriptor, compacted row pointers, values and column indices, each in its own section
+  template<class CSR>
+  void write_csr(CSR const& A)
+  {
+    std::vector<std::size_t> desc{std::size_t(A.size(0)), std::size_t(A.size(1)), std::size_t(A.global_origin()[0]),
+                                  std::size_t(A.global_origin()[1])};
+    write(desc.data(), desc.size());
+    auto pb = to_address(A.pointers_begin());
+    auto pe = to_address(A.pointers_end());
+    std::vector<std::size_t> ptr(A.size(0) + 1, 0);
+    for (std::size_t i = 0; i < A.size(0); i++)
+      ptr[i + 1] = ptr[i] + (pe[i] - pb[i]);
+    write(ptr.data(), ptr.size());
+    for (std::size_t i = 0; i < A.size(0); i++)
+      append(to_address(A.non_zero_values_data()) + (pb[i] - pb[0]), pe[i] - pb[i]);
+    align();
+    for (std::size_t i = 0; i < A.size(0); i++)
+      append(to_address(A.non_zero_indices2_data()) + (pb[i] - pb[0]), pe[i] - pb[i]);
+    align();
+  }
+
+  // completes the header and moves the file into place, returns false if anything failed
+  bool close()
+  {
+    std::uint64_t file_size = offset_;
+    out_.seekp(offsetof(header, file_size));
+    out_.write(reinterpret_cast<const char*>(&file_size), sizeof(file_size));
+    out_.close();
+    if (out_.fail())
+    {
+      std::remove(tmp_.c_str());
+      return false;
+    }
+    return std::rename(tmp_.c_str(), fname_.c_str()) == 0;
+  }
+
+private:
+  std::string fname_;
+  std::string tmp_;
+  std::ofstream out_;
+  std::size_t offset_ = 0;
+};
+
+/*
+ * Maps a cache file and reads it section by section. Only used by the node root.
+ * valid() is false if the file does not exist, is truncated or was written for a different key.
+ */
+class reader
+{
+public:
+  reader(std::string const& fname, std::string const& key)
+  {
+    int fd = ::open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size >= static_cast<off_t>(sizeof(header)))
+    {
+      size_ = st.st_size;
+      void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED)
+      {
+        base_ = static_cast<const char*>(p);
+        ::madvise(p, size_, MADV_SEQUENTIAL);
+      }
+    }
+    ::close(fd);
+    if (base_ == nullptr)
+      return;
+    header h;
+    std::memcpy(&h, base_, sizeof(header));
+    valid_ = std::memcmp(h.magic, magic, sizeof(magic)) == 0 && h.version == format_version &&
+        h.file_size == size_ && h.key_size == key.size() && sizeof(header) + h.key_size <= size_ &&
+        key.compare(0, key.size(), base_ + sizeof(header), h.key_size) == 0;
+    offset_ = page_align(sizeof(header) + h.key_size);
+  }
+
+  ~reader()
+  {
+    if (base_ != nullptr)
+      ::munmap(const_cast<char*>(base_), size_);
+  }
+
+  reader(reader const& other) = delete;
+  reader& operator=(reader const& other) = delete;
+
+  bool valid() const { return valid_; }
+
+  template<class T>
+  void copy(T* p, std::size_t n)
+  {
+    if (offset_ + n * sizeof(T) > size_)
+      APP_ABORT(" Error in hamops_cache::reader: Cache file is corrupted. \n");
+    std::memcpy(reinterpret_cast<char*>(p), base_ + offset_, n * sizeof(T));
+    offset_ += n * sizeof(T);
+  }
+
+  void align() { offset_ = page_align(offset_); }
+
+  template<class T>
+  void read(T* p, std::size_t n)
+  {
+    copy(p, n);
+    align();
+  }
+
+private:
+  const char* base_   = nullptr;
+  std::size_t size_   = 0;
+  std::size_t offset_ = 0;
+  bool valid_         = false;
+};
+
+/// true if the cache files of all the nodes exist and match key. Collective on TG.Global()
+inline bool exists(std::string const& fname, std::string const& key, TaskGroup_& TG)
+{
+  int nbad = 0;
+  if (TG.Node().root())
+    nbad = reader(fname, key).valid() ? 0 : 1;
+  nbad = (TG.Global() += nbad);
+  return nbad == 0;
+}
+
+/// reads an array, root reads from the file and broadcasts to the node
+template<class T>
+inline void read_bcast(reader* r, boost::mpi3::shared_communicator& node, T* p, std::size_t n)
+{
+  if (node.root())
+    r->read(p, n);
+  node.broadcast_n(p, n);
+}
+
+/// constructs a node-shared csr matrix on node and fills it from the file read by the node root
+template<class CSR>
+inline CSR read_csr(reader* r, boost::mpi3::shared_communicator& node)
+{
+  std::vector<std::size_t> desc(4);
+  read_bcast(r, node, desc.data(), desc.size());
+  std::vector<std::size_t> ptr(desc[0] + 1);
+  read_bcast(r, node, ptr.data(), ptr.size());
+  std::vector<std::size_t> nnzpr(desc[0]);
+  for (std::size_t i = 0; i < desc[0]; i++)
+    nnzpr[i] = ptr[i + 1] - ptr[i];
+  CSR A({desc[0], desc[1]}, {desc[2], desc[3]}, nnzpr, typename CSR::alloc_type{node});
+  if (node.root())
+  {
+    r->read(to_address(A.non_zero_values_data()), ptr.back());
+    r->read(to_address(A.non_zero_indices2_data()), ptr.back());
+    auto pe = to_address(A.pointers_end());
+    for (std::size_t i = 0; i < desc[0]; i++)
+      pe[i] = ptr[i + 1];
+  }
+  node.barrier();
+  return A;
+}
+
+} // namespace hamops_cache
+} // namespace afqmc
+} // namespace qmcplusplus
+
+#endif
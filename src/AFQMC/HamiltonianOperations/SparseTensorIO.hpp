@@ -17,6 +17,7 @@
 #define QMCPLUSPLUS_AFQMC_SPARSETENSORIO_HPP
 
 #include <fstream>
+#include <memory>
 
 #include "hdf/hdf_multi.h"
 #include "hdf/hdf_archive.h"
@@ -25,6 +26,7 @@
 #include "AFQMC/Matrix/csr_hdf5_readers.hpp"
 
 #include "AFQMC/HamiltonianOperations/SparseTensor.hpp"
+#include "AFQMC/HamiltonianOperations/HamOpsCache.hpp"
 #include "AFQMC/Hamiltonians/rotateHamiltonian.hpp"
 
 namespace qmcplusplus
@@ -277,6 +279,129 @@ inline void writeSparseTensor(hdf_archive& dump,
   TGwfn.Global().barrier();
 }
 
+/*
+ * Writes the objects a SparseTensor is constructed from into the cache file of this node, see HamOpsCache.hpp.
+ * Only the node root writes, the objects are either node-shared or identical on all cores.
+ */
+template<class shm_mat1, class shm_mat2, class shm_mat3>
+inline void writeSparseTensorCache(std::string const& fname,
+                                   std::string const& key,
+                                   TaskGroup_& TGwfn,
+                                   boost::multi::array<ValueType, 2> const& H1,
+                                   std::vector<boost::multi::array<ComplexType, 1>> const& hij,
+                                   std::vector<shm_mat1> const& v2,
+                                   shm_mat2 const& Spvn,
+                                   boost::multi::array<ComplexType, 2> const& v0,
+                                   std::vector<shm_mat3> const& SpvnT,
+                                   ValueType E0,
+                                   int gncv)
+{
+  if (not TGwfn.Node().root())
+    return;
+  hamops_cache::writer w(fname, key);
+  std::vector<int> dims{int(std::get<0>(H1.sizes())), int(v2.size()), int(SpvnT.size()), int(hij.size()), gncv};
+  for (auto& h : hij)
+    dims.push_back(int(h.num_elements()));
+  int ndims = dims.size();
+  w.write(&ndims, 1);
+  w.write(dims.data(), dims.size());
+  w.write(&E0, 1);
+  w.write(to_address(H1.origin()), H1.num_elements());
+  w.write(to_address(v0.origin()), v0.num_elements());
+  for (auto& h : hij)
+    w.write(to_address(h.origin()), h.num_elements());
+  for (auto& v : v2)
+    w.write_csr(v);
+  w.write_csr(Spvn);
+  for (auto& v : SpvnT)
+    w.write_csr(v);
+  if (w.close())
+    app_log() << " Wrote HamiltonianOperations cache: " << fname << "\n";
+  else
+    app_warning() << " Failed to write HamiltonianOperations cache: " << fname << "\n";
+}
+
+/*
+ * Constructs a SparseTensor from the cache file of this node written by writeSparseTensorCache.
+ * The file must have been checked with hamops_cache::exists.
+ */
+template<typename T1, typename T2>
+SparseTensor<T1, T2> loadSparseTensorCache(std::string const& fname,
+                                           std::string const& key,
+                                           WALKER_TYPES type,
+                                           TaskGroup_& TGprop,
+                                           TaskGroup_& TGwfn)
+{
+#if defined(MIXED_PRECISION)
+  using SpT1 = typename to_single_precision<T1>::value_type;
+  using SpT2 = typename to_single_precision<T2>::value_type;
+#else
+  using SpT1 = T1;
+  using SpT2 = T2;
+#endif
+
+  using T1_shm_csr_matrix = ma::sparse::csr_matrix<SpT1, int, std::size_t, shared_allocator<SpT1>, ma::sparse::is_root>;
+  using T2_shm_csr_matrix = ma::sparse::csr_matrix<SpT2, int, std::size_t, shared_allocator<SpT2>, ma::sparse::is_root>;
+
+  auto& node = TGwfn.Node();
+  std::unique_ptr<hamops_cache::reader> r;
+  if (node.root())
+  {
+    r = std::make_unique<hamops_cache::reader>(fname, key);
+    if (not r->valid())
+      APP_ABORT(" Error in loadSparseTensorCache: Invalid cache file. \n");
+  }
+
+  int ndims = 0;
+  hamops_cache::read_bcast(r.get(), node, &ndims, 1);
+  std::vector<int> dims(ndims);
+  hamops_cache::read_bcast(r.get(), node, dims.data(), dims.size());
+  int NMO = dims[0], nv2 = dims[1], nvnT = dims[2], nhij = dims[3], gncv = dims[4];
+  ValueType E0;
+  hamops_cache::read_bcast(r.get(), node, &E0, 1);
+
+  boost::multi::array<ComplexType, 2> H1({NMO, NMO});
+  {
+    boost::multi::array<ValueType, 2> H1_({NMO, NMO});
+    hamops_cache::read_bcast(r.get(), node, to_address(H1_.origin()), H1_.num_elements());
+    copy_n_cast(H1_.origin(), NMO * NMO, to_address(H1.origin()));
+  }
+  boost::multi::array<ComplexType, 2> v0({NMO, NMO});
+  hamops_cache::read_bcast(r.get(), node, to_address(v0.origin()), v0.num_elements());
+  std::vector<boost::multi::array<ComplexType, 1>> hij;
+  hij.reserve(nhij);
+  for (int n = 0; n < nhij; n++)
+  {
+    hij.emplace_back(iextensions<1u>{dims[5 + n]});
+    hamops_cache::read_bcast(r.get(), node, to_address(hij.back().origin()), hij.back().num_elements());
+  }
+
+  std::vector<T1_shm_csr_matrix> V2;
+  V2.reserve(nv2);
+  for (int n = 0; n < nv2; n++)
+    V2.emplace_back(hamops_cache::read_csr<T1_shm_csr_matrix>(r.get(), node));
+  SpVType_shm_csr_matrix Spvn(hamops_cache::read_csr<SpVType_shm_csr_matrix>(r.get(), node));
+  std::vector<T2_shm_csr_matrix> SpvnT;
+  SpvnT.reserve(nvnT);
+  for (int n = 0; n < nvnT; n++)
+    SpvnT.emplace_back(hamops_cache::read_csr<T2_shm_csr_matrix>(r.get(), node));
+
+  // setup views
+  std::vector<typename T1_shm_csr_matrix::template matrix_view<int>> V2view;
+  V2view.reserve(nv2);
+  for (auto& v : V2)
+    V2view.emplace_back(csr::shm::local_balanced_partition(v, TGwfn));
+  auto Spvnview(csr::shm::local_balanced_partition(Spvn, TGprop));
+  std::vector<typename T2_shm_csr_matrix::template matrix_view<int>> SpvnTview;
+  SpvnTview.reserve(nvnT);
+  for (auto& v : SpvnT)
+    SpvnTview.emplace_back(csr::shm::local_balanced_partition(v, TGprop));
+
+  return SparseTensor<T1, T2>(TGwfn.TG_local(), type, std::move(H1), std::move(hij), std::move(V2), std::move(V2view),
+                              std::move(Spvn), std::move(Spvnview), std::move(v0), std::move(SpvnT),
+                              std::move(SpvnTview), E0, gncv);
+}
+
 } // namespace afqmc
 } // namespace qmcplusplus
 
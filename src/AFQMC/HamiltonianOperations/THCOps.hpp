@@ -293,13 +293,23 @@ public:
     int k0, kN;
     std::tie(k0, kN) = FairDivideBoundary(comm->rank(), nmo_, comm->size());
 
+    // interpolating points are processed in blocks of nblk rows of Guv,
+    // only Guv for a single block is stored when nblk < nu
+    int nblk     = (interp_block_size > 0 && interp_block_size < nu) ? interp_block_size : nu;
+    bool blocked = (nblk < nu);
+    // Guv also holds T[w][v][a] in the real build
+    int nrows = blocked ? std::max(nblk, nup) : nu;
+    // R[w][u][b] and T[w][b][k] live in Tav and Guv unless these are too small
+    long R_per_walker = blocked ? long(nu) * long(nup) : 0L;
+    long T_per_walker = (long(nrows) * long(nv) < long(nup) * long(nmo_)) ? long(nup) * long(nmo_) : 0L;
+
     // calculate how many walkers can be done concurrently
     long mem_needs(0);
     if (not std::is_same<GType, SPComplexType>::value)
       mem_needs += G.num_elements();
     long Bytes = default_buffer_size_in_MB * 1024L * 1024L;
     Bytes -= mem_needs * long(sizeof(SPComplexType));
-    Bytes /= long((nu * nv + nv + nv * nup) * sizeof(SPComplexType));
+    Bytes /= (long(nrows) * nv + nv + long(nv) * nup + R_per_walker + T_per_walker) * long(sizeof(SPComplexType));
     int nwmax = std::min(nwalk, std::max(1, int(Bytes)));
     ShmArray<SPComplexType, 1> Gbuff(iextensions<1u>{mem_needs},
                                      shm_buffer_manager.get_generator().template get_allocator<SPComplexType>());
@@ -320,7 +330,7 @@ public:
     Array_cref<SPComplexType, 2> Gsp(Gptr, G.extensions());
 
     // Guv[nspin][nu][nv]
-    ShmArray<SPComplexType, 3> Guv({nwmax, nu, nv},
+    ShmArray<SPComplexType, 3> Guv({nwmax, nrows, nv},
                                    shm_buffer_manager.get_generator().template get_allocator<SPComplexType>());
     // Guu[u]: summed over spin
     ShmArray<SPComplexType, 2> Guu({nwmax, nv},
@@ -329,6 +339,13 @@ public:
     ShmArray<SPComplexType, 3> Tav({nwmax, nup, nv},
                                    shm_buffer_manager.get_generator().template get_allocator<SPComplexType>());
 
+    ShmArray<SPComplexType, 1> RTbuff(iextensions<1u>{long(nwmax) * (R_per_walker + T_per_walker)},
+                                      shm_buffer_manager.get_generator().template get_allocator<SPComplexType>());
+    auto Rptr(blocked ? make_device_ptr(RTbuff.origin()) : make_device_ptr(Tav.origin()));
+    auto Tptr(T_per_walker > 0 ? make_device_ptr(RTbuff.origin()) + long(nwmax) * R_per_walker
+                               : make_device_ptr(Guv.origin()));
+    long Tcapacity = (T_per_walker > 0) ? long(nwmax) * T_per_walker : long(Guv.num_elements());
+
     SPRealType scl = (walker_type == CLOSED ? 2.0 : 1.0);
     int iw(0);
     while (iw < nwalk)
@@ -337,26 +354,47 @@ public:
       fill_n(Guu.origin(), Guu.num_elements(), SPComplexType(0.0));
       for (int ispin = 0; ispin < nspin; ++ispin)
       {
-        Guv_Guu(ispin, Gsp.sliced(iw, iw + nw), Guv, Guu, Tav, k);
+        Tav_Guu(ispin, Gsp.sliced(iw, iw + nw), Guv, Guu, Tav, k);
 
-        // Gwuv = Gwuv * rotMuv
-        using ma::inplace_product;
-        inplace_product(nw, nu, (vN - v0), make_device_ptr(rotMuv.origin()) + v0, nv,
-                        make_device_ptr(Guv.origin()) + v0, nv);
-        comm->barrier();
-
-        // R[w,u][b] = sum_v Guv[w,u][v] * cPua[v][b]
         long i0, iN;
-        std::tie(i0, iN) = FairDivideBoundary(long(comm->rank()), long(nw * nu), long(comm->size()));
-        Array_ref<SPComplexType, 2> Rwub(make_device_ptr(Tav.origin()), {nw * nu, nelec[ispin]});
-        Array_ref<SPComplexType, 2> Guv2D(make_device_ptr(Guv.origin()), {nw * nu, nv});
-        ma::product(Guv2D.sliced(i0, iN), rotcPua[k]({0, nv}, {ispin * nup, nup + ispin * ndown}), Rwub.sliced(i0, iN));
-        comm->barrier();
+        Array_ref<SPComplexType, 2> Rwub(Rptr, {nw * nu, nelec[ispin]});
+        for (int ub0 = 0; ub0 < nu; ub0 += nblk)
+        {
+          int nb = std::min(nblk, nu - ub0);
+          Array_ref<SPComplexType, 3> Gwuv(make_device_ptr(Guv.origin()), {nw, nb, nv});
+          Guv_Guu_block(ispin, Gwuv, Guu, Tav, ub0, ub0 + nb, k);
+
+          // Gwuv = Gwuv * rotMuv
+          using ma::inplace_product;
+          inplace_product(nw, nb, (vN - v0), make_device_ptr(rotMuv.origin()) + long(ub0) * nv + v0, nv,
+                          make_device_ptr(Gwuv.origin()) + v0, nv);
+          comm->barrier();
+
+          // R[w,u][b] = sum_v Guv[w,u][v] * cPua[v][b]
+          std::tie(i0, iN) = FairDivideBoundary(long(comm->rank()), long(nw * nb), long(comm->size()));
+          Array_ref<SPComplexType, 2> Guv2D(Gwuv.origin(), {nw * nb, nv});
+          if (nb == nu)
+            ma::product(Guv2D.sliced(i0, iN), rotcPua[k]({0, nv}, {ispin * nup, nup + ispin * ndown}),
+                        Rwub.sliced(i0, iN));
+          else
+          {
+            // rows of the block are scattered over the walkers in R
+            for (long r0 = i0, rN = i0; r0 < iN; r0 = rN)
+            {
+              long w = r0 / nb;
+              rN     = std::min(iN, (w + 1) * nb);
+              long o = w * nu + ub0 - w * nb;
+              ma::product(Guv2D.sliced(r0, rN), rotcPua[k]({0, nv}, {ispin * nup, nup + ispin * ndown}),
+                          Rwub.sliced(o + r0, o + rN));
+            }
+          }
+          comm->barrier();
+        }
 
         //T[w][b][k] = sum_u R[w][u][b] * Piu[k][u]
         // need batching in this case
         Array_ref<SPComplexType, 3> Rwub3D(Rwub.origin(), {nw, nu, nelec[ispin]});
-        Array_ref<SPComplexType, 3> Twbk(make_device_ptr(Guv.origin()), {nw, nelec[ispin], nmo_});
+        Array_ref<SPComplexType, 3> Twbk(Tptr, {nw, nelec[ispin], nmo_});
         Array_ref<SPComplexType, 2> Twbk2D(Twbk.origin(), {nw, nelec[ispin] * nmo_});
         std::vector<decltype(&(Rwub3D[0]))> vRwub;
         std::vector<decltype(&(rotPiu({0, 1}, {0, 1})))> vPku;
@@ -374,7 +412,7 @@ public:
         ma::BatchedProduct('T', 'T', vRwub, vPku, vTwbk);
 #else
         // need to keep vPku on the left hand side in real build
-        if (Guv.num_elements() >= 2 * Twbk.num_elements())
+        if (Tcapacity >= 2 * Twbk.num_elements())
         {
           Array_ref<SPComplexType, 3> Twkb(Twbk.origin() + Twbk.num_elements(), {nw, nmo_, nelec[ispin]});
           std::vector<decltype(&(Twkb[0].sliced(0, 1)))> vTwkb;
@@ -938,6 +976,19 @@ public:
     APP_ABORT(" Error: generalizedFockMatrix not implemented for this hamiltonian.\n");
   }
 
+  /** set the number of interpolating points processed at once in energy and vbias
+   * Bounds the size of the work space in the exchange energy from nu*nv to nblk*nv per walker,
+   * the results do not depend on the block size. 0 (default) processes all points at once.
+   */
+  void set_interp_block_size(int nblk) { interp_block_size = std::max(0, nblk); }
+
+  /// set the memory budget used to decide how many walkers are processed concurrently
+  void set_buffer_size_in_MB(long mb)
+  {
+    if (mb > 0)
+      default_buffer_size_in_MB = mb;
+  }
+
   bool distribution_over_cholesky_vectors() const { return false; }
   int number_of_ke_vectors() const { return std::get<0>(rotMuv.sizes()); }
 #if defined(QMC_COMPLEX)
@@ -975,30 +1026,37 @@ protected:
     assert(std::get<1>(G.sizes()) == nel_ * nmo_);
     assert(std::get<0>(Guu.sizes()) == nu);
 
+    // the local range of u is processed in blocks of nblk to bound the size of T1
+    int nblk = (interp_block_size > 0) ? std::min(interp_block_size, uN - u0) : (uN - u0);
+
     ComplexType a = (walker_type == CLOSED) ? ComplexType(2.0) : ComplexType(1.0);
-    Array<SPComplexType, 2> T1({(uN - u0), nw * nel_},
+    Array<SPComplexType, 2> T1({nblk, nw * nel_},
                                device_buffer_manager.get_generator().template get_allocator<SPComplexType>());
     Array_cref<SPComplexType, 2> Gw(make_device_ptr(G.origin()), {nw * nel_, nmo_});
     comm->barrier();
 
-    // transposing intermediary to make dot products faster in the next step
+#if !defined(QMC_COMPLEX)
+    int k0, kN;
+    std::tie(k0, kN) = FairDivideBoundary(comm->rank(), nmo_, comm->size());
+    ShmArray<SPComplexType, 2> TGw({nmo_, nw * nel_},
+                                   shm_buffer_manager.get_generator().template get_allocator<SPComplexType>());
+    ma::transpose(Gw(Gw.extension(0), {k0, kN}), TGw.sliced(k0, kN));
+    comm->barrier();
+#endif
+    using ma::Auwn_Bun_Cuw;
+    for (int ub0 = u0; ub0 < uN; ub0 += nblk)
+    {
+      int ubN = std::min(ub0 + nblk, uN);
+      // transposing intermediary to make dot products faster in the next step
 #if defined(QMC_COMPLEX)
-    ma::product(ma::T(Piu({0, nmo_}, {u0, uN})), ma::T(Gw), T1);
+      ma::product(ma::T(Piu({0, nmo_}, {ub0, ubN})), ma::T(Gw), T1.sliced(0, ubN - ub0));
 #else
-    {
-      int k0, kN;
-      std::tie(k0, kN) = FairDivideBoundary(comm->rank(), nmo_, comm->size());
-      ShmArray<SPComplexType, 2> TGw({nmo_, nw * nel_},
-                                     shm_buffer_manager.get_generator().template get_allocator<SPComplexType>());
-      ma::transpose(Gw(Gw.extension(0), {k0, kN}), TGw.sliced(k0, kN));
-      comm->barrier();
-      ma::product(ma::T(Piu({0, nmo_}, {u0, uN})), TGw, T1);
-    }
+      ma::product(ma::T(Piu({0, nmo_}, {ub0, ubN})), TGw, T1.sliced(0, ubN - ub0));
 #endif
-    // Guu[u][w] = a * sum_n T1[u][w][n] * cPua[u][n]
-    using ma::Auwn_Bun_Cuw;
-    Auwn_Bun_Cuw(uN - u0, nw, nel_, SPComplexType(a), T1.origin(), make_device_ptr(cPua[0][u0].origin()),
-                 make_device_ptr(Guu[u0].origin()));
+      // Guu[u][w] = a * sum_n T1[u][w][n] * cPua[u][n]
+      Auwn_Bun_Cuw(ubN - ub0, nw, nel_, SPComplexType(a), T1.origin(), make_device_ptr(cPua[0][ub0].origin()),
+                   make_device_ptr(Guu[ub0].origin()));
+    }
     comm->barrier();
   }
 
@@ -1045,14 +1103,15 @@ protected:
   }
 
   // since this is for energy, only compact is accepted
-  // Computes Guv and Guu for a set of walkers
+  // Computes Tav and the contributions to Guu from u outside the local range for a set of walkers,
+  // the local range of Guv and Guu is computed in blocks by Guv_Guu_block
   // rotMuv is partitioned along 'u'
   // G[w][nel*nmo]
-  // Guv[w][nu][nv]
+  // Guv[w][*][nv], only used as work space in the real build, needs at least nw*nv*nel elements
   // Guu[w][v], accumulated on this routine, sum over spin is outside
   // Tav[w][nup][nv]
   template<class MatA, class MatB, class MatC, class MatD>
-  void Guv_Guu(int ispin, MatA const& G, MatB&& Guv, MatC&& Guu, MatD&& Tav, int k)
+  void Tav_Guu(int ispin, MatA const& G, MatB&& Guv, MatC&& Guu, MatD&& Tav, int k)
   {
     static_assert(std::decay<MatA>::type::dimensionality == 2, "Wrong dimensionality");
     static_assert(std::decay<MatB>::type::dimensionality == 3, "Wrong dimensionality");
@@ -1068,39 +1127,32 @@ protected:
     int k0, kN;
     std::tie(k0, kN) = FairDivideBoundary(comm->rank(), nmo_, comm->size());
     int nu0          = rotnmu0;
-    SPComplexType zero(0.0, 0.0);
 
     // sync first
     comm->barrier();
 
     using const_array_ptr = boost::multi::array_ptr<SPComplexType, 2, const_sp_pointer>;
     using array_ptr       = boost::multi::array_ptr<SPComplexType, 2, sp_pointer>;
-    auto Pua_ptr(&(rotcPua[k]({nu0, nu0 + nu}, {ispin * nup, nup + ispin * ndown})));
 
     std::vector<const_array_ptr> Gwaj;
     std::vector<decltype(&(rotPiu({0, 1}, {0, 1})))> Pjv;
     std::vector<decltype(&(Tav[0]({0, 1}, {0, 1})))> Twav;
-    std::vector<decltype(Pua_ptr)> Pua;
-    std::vector<decltype(&(Guv[0]({0, 1}, {0, 1})))> Gwuv;
 
     Gwaj.reserve(nw);
     Pjv.reserve(nw);
     Twav.reserve(nw);
-    Pua.reserve(nw);
-    Gwuv.reserve(nw);
 
     for (int iw = 0; iw < nw; ++iw)
     {
       Gwaj.emplace_back(make_device_ptr(G[iw].origin()) + ispin * nup * nmo_, iextensions<2u>{nelec[ispin], nmo_});
       Pjv.emplace_back(&(rotPiu({0, nmo_}, {v0, vN})));
       Twav.emplace_back(&(Tav[iw]({0, nelec[ispin]}, {v0, vN})));
-      Pua.emplace_back(Pua_ptr);
-      Gwuv.emplace_back(&(Guv[iw]({0, nu}, {v0, vN})));
     }
     // T[w][a][v] = sum_v G[w][a][j] * rotcPua[j][v]
 #if defined(QMC_COMPLEX)
     ma::BatchedProduct('N', 'N', Gwaj, Pjv, Twav);
 #else
+    assert(Guv.num_elements() >= long(nw) * nv * nelec[ispin]);
     ShmArray<SPComplexType, 3> Gja({nw, nmo_, nelec[ispin]},
                                    shm_buffer_manager.get_generator().template get_allocator<SPComplexType>());
     Array_ref<SPComplexType, 3> Tva(make_device_ptr(Guv.origin()), {nw, nv, nelec[ispin]});
@@ -1120,17 +1172,11 @@ protected:
       ma::transpose(*Twva[iw], *Twav[iw]);
 #endif
     comm->barrier();
-    // G[w][u][v] = sum_a rotcPua[u][a] * T[w][a][v]
-    ma::BatchedProduct('N', 'N', Pua, Twav, Gwuv);
-    comm->barrier();
 
-    // Gwv = Gwvv, in range v={nu0,nu0+nu}
     using ma::Aijk_Bkj_Cik;
-    using ma::get_diagonal_strided;
     //  needs distribution
     if (comm->root())
     {
-      get_diagonal_strided(Guv({0, nw}, {0, nu}, {nu0, nu0 + nu}), Guu({0, nw}, {nu0, nu0 + nu}));
       // dispatch these through ma_blas_extensions!!!
       // Gwv = sum_a Twav Pva
       if (nu0 > 0) // calculate Guu from u={0,nu0}
@@ -1144,6 +1190,52 @@ protected:
     comm->barrier();
   }
 
+  // Computes the block u={ub0,ub1} of the local range of Guv and the corresponding diagonal of Guu,
+  // Tav from Tav_Guu
+  // Guv[w][ub1-ub0][nv]
+  // Guu[w][v], accumulated on this routine, sum over spin is outside
+  template<class MatB, class MatC, class MatD>
+  void Guv_Guu_block(int ispin, MatB&& Guv, MatC&& Guu, MatD&& Tav, int ub0, int ub1, int k)
+  {
+    static_assert(std::decay<MatB>::type::dimensionality == 3, "Wrong dimensionality");
+    static_assert(std::decay<MatC>::type::dimensionality == 2, "Wrong dimensionality");
+    static_assert(std::decay<MatD>::type::dimensionality == 3, "Wrong dimensionality");
+    int nv = int(std::get<1>(rotMuv.sizes()));
+    int nw = int(Guv.size());
+    int nb = ub1 - ub0;
+    assert(std::get<1>(Guv.sizes()) == nb);
+    int v0, vN;
+    std::tie(v0, vN) = FairDivideBoundary(comm->rank(), nv, comm->size());
+    int nu0          = rotnmu0;
+
+    auto Pua_ptr(&(rotcPua[k]({nu0 + ub0, nu0 + ub1}, {ispin * nup, nup + ispin * ndown})));
+
+    std::vector<decltype(&(Tav[0]({0, 1}, {0, 1})))> Twav;
+    std::vector<decltype(Pua_ptr)> Pua;
+    std::vector<decltype(&(Guv[0]({0, 1}, {0, 1})))> Gwuv;
+
+    Twav.reserve(nw);
+    Pua.reserve(nw);
+    Gwuv.reserve(nw);
+
+    for (int iw = 0; iw < nw; ++iw)
+    {
+      Twav.emplace_back(&(Tav[iw]({0, nelec[ispin]}, {v0, vN})));
+      Pua.emplace_back(Pua_ptr);
+      Gwuv.emplace_back(&(Guv[iw]({0, nb}, {v0, vN})));
+    }
+    // G[w][u][v] = sum_a rotcPua[u][a] * T[w][a][v]
+    ma::BatchedProduct('N', 'N', Pua, Twav, Gwuv);
+    comm->barrier();
+
+    // Gwv = Gwvv, in range v={nu0+ub0,nu0+ub1}
+    using ma::get_diagonal_strided;
+    //  needs distribution
+    if (comm->root())
+      get_diagonal_strided(Guv({0, nw}, {0, nb}, {nu0 + ub0, nu0 + ub1}), Guu({0, nw}, {nu0 + ub0, nu0 + ub1}));
+    comm->barrier();
+  }
+
   /*
     // since this is for energy, only compact is accepted
     // Computes Guv and Guu for a single walker
@@ -1204,6 +1296,9 @@ protected:
 
   long default_buffer_size_in_MB = 4L * 1024L;
 
+  // number of interpolating points per block in energy and vbias, 0 means no blocking
+  int interp_block_size = 0;
+
   int NMO, nup, ndown;
   int nelec[2];
 
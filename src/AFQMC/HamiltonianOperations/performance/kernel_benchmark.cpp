@@ -0,0 +1,649 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Benchmark of the AFQMC kernels over synthetic Hamiltonians.
+ * Every available HamiltonianOperations factorization is built from random integrals of the requested size,
+ * and vbias, vHS and the energy are timed for a set of random walkers. The walker kernels that do not depend
+ * on the factorization (apply_expM, orthogonalization and the mixed density matrix) are timed once.
+ * For THC, the energy and vbias are also timed for a list of interpolating point block sizes.
+ * Results are written in JSON, so they can be compared between builds, machines and versions.
+ *
+ * Usage: qmc-afqmc-kernel-benchmark [--name=value ...], see print_usage() for the list of parameters.
+ * All nodes run the same problem, the timings reported are those of the first node.
+ */
+
+#include "Configuration.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mpi3/environment.hpp"
+#include "mpi3/communicator.hpp"
+#include "mpi3/shared_communicator.hpp"
+
+#include "Utilities/Timer.h"
+
+#include "AFQMC/config.h"
+#include "AFQMC/Utilities/taskgroup.h"
+#include "AFQMC/Memory/buffer_managers.h"
+#include "AFQMC/Matrix/csr_matrix_construct.hpp"
+#include "AFQMC/HamiltonianOperations/HamiltonianOperations.hpp"
+#include "AFQMC/SlaterDeterminantOperations/SlaterDetOperations_shared.hpp"
+#include "AFQMC/SlaterDeterminantOperations/apply_expM.hpp"
+
+using namespace qmcplusplus;
+using namespace afqmc;
+
+template<typename T>
+using shmArray2D = boost::multi::array<T, 2, shared_allocator<T>>;
+template<typename T>
+using shmArray3D = boost::multi::array<T, 3, shared_allocator<T>>;
+
+struct BenchmarkParameters
+{
+  int nmo                = 64;
+  int nel                = 16;
+  int nchol              = 256;
+  int nmu                = 256;
+  int rotnmu             = 128;
+  int nkpts              = 1;
+  int nwalk              = 16;
+  int nrepeat            = 5;
+  int seed               = 11;
+  double sparse_fraction = 0.1;
+  std::vector<int> interp_block_sizes{0, 16, 32, 64, 128};
+  std::string output = "afqmc_kernels.json";
+};
+
+struct KernelTiming
+{
+  std::string name;
+  double min;
+  double mean;
+  double max;
+};
+
+struct HamOpsResult
+{
+  std::string name;
+  bool available;
+  std::string reason;
+  int ncholesky;
+  std::vector<KernelTiming> kernels;
+};
+
+struct BlockSizeResult
+{
+  int interp_block_size;
+  std::vector<KernelTiming> kernels;
+};
+
+void print_usage()
+{
+  BenchmarkParameters p;
+  std::cout << " Usage: qmc-afqmc-kernel-benchmark [--name=value ...] \n"
+            << "  --nmo=N                number of orbitals (" << p.nmo << ")\n"
+            << "  --nel=N                number of electrons per spin, closed shell (" << p.nel << ")\n"
+            << "  --nchol=N              number of Cholesky vectors (" << p.nchol << ")\n"
+            << "  --nmu=N                number of THC interpolating points (" << p.nmu << ")\n"
+            << "  --rotnmu=N             number of half-rotated THC interpolating points (" << p.rotnmu << ")\n"
+            << "  --nkpts=N              number of k-points of the KP3Index Hamiltonian (" << p.nkpts << ")\n"
+            << "  --nwalk=N              number of walkers (" << p.nwalk << ")\n"
+            << "  --nrepeat=N            number of timed calls of every kernel (" << p.nrepeat << ")\n"
+            << "  --seed=N               seed of the random integrals and walkers (" << p.seed << ")\n"
+            << "  --sparse_fraction=X    fraction of non-zero SparseTensor elements (" << p.sparse_fraction << ")\n"
+            << "  --interp_block_sizes=N,M,...  THC interpolating point block sizes, 0 for no blocking\n"
+            << "  --output=FILE          JSON output file (" << p.output << ")\n";
+}
+
+bool parse_arguments(int argc, char* argv[], BenchmarkParameters& p)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    std::string arg(argv[i]);
+    auto eq = arg.find('=');
+    if (arg.compare(0, 2, "--") != 0 || eq == std::string::npos)
+      return false;
+    std::string name  = arg.substr(2, eq - 2);
+    std::string value = arg.substr(eq + 1);
+    std::istringstream in(value);
+    if (name == "nmo")
+      in >> p.nmo;
+    else if (name == "nel")
+      in >> p.nel;
+    else if (name == "nchol")
+      in >> p.nchol;
+    else if (name == "nmu")
+      in >> p.nmu;
+    else if (name == "rotnmu")
+      in >> p.rotnmu;
+    else if (name == "nkpts")
+      in >> p.nkpts;
+    else if (name == "nwalk")
+      in >> p.nwalk;
+    else if (name == "nrepeat")
+      in >> p.nrepeat;
+    else if (name == "seed")
+      in >> p.seed;
+    else if (name == "sparse_fraction")
+      in >> p.sparse_fraction;
+    else if (name == "output")
+      p.output = value;
+    else if (name == "interp_block_sizes")
+    {
+      p.interp_block_sizes.clear();
+      std::replace(value.begin(), value.end(), ',', ' ');
+      std::istringstream list(value);
+      for (int nb; list >> nb;)
+        p.interp_block_sizes.push_back(nb);
+      continue;
+    }
+    else
+      return false;
+    if (in.fail())
+      return false;
+  }
+  return p.nmo > 0 && p.nel > 0 && p.nel <= p.nmo && p.nchol > 0 && p.nmu > 0 && p.rotnmu > 0 && p.nkpts > 0 &&
+      p.nwalk > 0 && p.nrepeat > 0 && p.sparse_fraction > 0.0;
+}
+
+// fills a node-shared array with uniform random numbers in [-scale,scale), root only
+template<class Array>
+void fill_random(Array& A, boost::mpi3::shared_communicator& node, int seed, double scale = 1.0)
+{
+  using T = typename Array::element;
+  if (node.root())
+  {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-scale, scale);
+    auto p = to_address(A.origin());
+    for (long i = 0; i < A.num_elements(); i++)
+      p[i] = static_cast<T>(dist(rng));
+  }
+  node.barrier();
+}
+
+// same on a local array, every rank generates the same values
+template<class Array>
+void fill_random(Array& A, int seed, double scale = 1.0)
+{
+  using T = typename Array::element;
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> dist(-scale, scale);
+  auto p = to_address(A.origin());
+  for (long i = 0; i < A.num_elements(); i++)
+    p[i] = static_cast<T>(dist(rng));
+}
+
+/*
+ * Node-shared csr matrix with a random sparsity pattern of the given fraction of non-zero elements.
+ * Every rank draws the same pattern, needed to allocate the matrix, only the root inserts the elements.
+ */
+template<class CSR>
+CSR make_random_csr(long nrows, long ncols, double fraction, int seed, boost::mpi3::shared_communicator& node)
+{
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> u01(0.0, 1.0);
+  std::vector<std::size_t> nnzpr(nrows, 0);
+  std::vector<int> cols;
+  cols.reserve(std::size_t(fraction * nrows * ncols) + nrows);
+  // skip sampling, the distance between consecutive non-zero elements is geometric
+  const double logq = (fraction < 1.0) ? std::log(1.0 - fraction) : 0.0;
+  for (long i = 0; i < nrows; i++)
+    for (long j = 0;; j++)
+    {
+      if (fraction < 1.0)
+        j += long(std::floor(std::log(1.0 - u01(rng)) / logq));
+      if (j >= ncols)
+        break;
+      cols.push_back(int(j));
+      nnzpr[i]++;
+    }
+  CSR A({nrows, ncols}, {0, 0}, nnzpr, typename CSR::alloc_type{node});
+  if (node.root())
+  {
+    std::mt19937 vrng(seed + 1);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (long i = 0, n = 0; i < nrows; i++)
+      for (std::size_t k = 0; k < nnzpr[i]; k++, n++)
+        A.emplace_back({i, cols[n]}, static_cast<typename CSR::value_type>(dist(vrng)));
+  }
+  node.barrier();
+  return A;
+}
+
+/*
+ * Times nrepeat calls of kernel, after an untimed call that sizes the work buffers.
+ * kernel is collective over node, the time of a call is that of the slowest rank.
+ */
+template<class F>
+KernelTiming time_kernel(std::string const& name, boost::mpi3::shared_communicator& node, int nrepeat, F&& kernel)
+{
+  kernel();
+  node.barrier();
+  update_memory_managers();
+  std::vector<double> t(nrepeat);
+  for (auto& ti : t)
+  {
+    node.barrier();
+    Timer timer;
+    kernel();
+    node.barrier();
+    ti = timer.elapsed();
+  }
+  return {name, *std::min_element(t.begin(), t.end()), std::accumulate(t.begin(), t.end(), 0.0) / nrepeat,
+          *std::max_element(t.begin(), t.end())};
+}
+
+THCOps make_thc(BenchmarkParameters const& p, TaskGroup_& TG)
+{
+  auto& node = TG.Node();
+  int nmo = p.nmo, nel = p.nel;
+  shmArray2D<ComplexType> hij({nmo, nmo}, shared_allocator<ComplexType>{node});
+  shmArray2D<ComplexType> haj({1, nel * nmo}, shared_allocator<ComplexType>{node});
+  shmArray2D<SPValueType> rotMuv({p.rotnmu, p.rotnmu}, shared_allocator<SPValueType>{node});
+  shmArray2D<SPValueType> rotPiu({nmo, p.rotnmu}, shared_allocator<SPValueType>{node});
+  std::vector<shmArray2D<SPComplexType>> rotcPua;
+  rotcPua.emplace_back(shmArray2D<SPComplexType>({p.rotnmu, nel}, shared_allocator<SPComplexType>{node}));
+  shmArray2D<SPValueType> Luv({p.nmu, p.nmu}, shared_allocator<SPValueType>{node});
+  shmArray2D<SPValueType> Piu({nmo, p.nmu}, shared_allocator<SPValueType>{node});
+  std::vector<shmArray2D<SPComplexType>> cPua;
+  cPua.emplace_back(shmArray2D<SPComplexType>({p.nmu, nel}, shared_allocator<SPComplexType>{node}));
+  shmArray2D<ComplexType> v0({nmo, nmo}, shared_allocator<ComplexType>{node});
+  fill_random(hij, node, p.seed);
+  fill_random(haj, node, p.seed + 1);
+  fill_random(rotMuv, node, p.seed + 2);
+  fill_random(rotPiu, node, p.seed + 3);
+  fill_random(rotcPua[0], node, p.seed + 4);
+  fill_random(Luv, node, p.seed + 5);
+  fill_random(Piu, node, p.seed + 6);
+  fill_random(cPua[0], node, p.seed + 7);
+  fill_random(v0, node, p.seed + 8);
+  return THCOps(TG.TG_local(), nmo, nel, nel, CLOSED, 0, 0, std::move(hij), std::move(haj), std::move(rotMuv),
+                std::move(rotPiu), std::move(rotcPua), std::move(Luv), std::move(Piu), std::move(cPua), std::move(v0),
+                ValueType(0.0));
+}
+
+SparseTensor<ComplexType, ComplexType> make_sparse_tensor(BenchmarkParameters const& p, TaskGroup_& TG)
+{
+  using T_csr = SpCType_shm_csr_matrix;
+  using V_csr = SpVType_shm_csr_matrix;
+  auto& node  = TG.Node();
+  int nmo = p.nmo, nel = p.nel;
+  boost::multi::array<ComplexType, 2> H1({nmo, nmo});
+  fill_random(H1, p.seed);
+  std::vector<boost::multi::array<ComplexType, 1>> hij;
+  hij.emplace_back(iextensions<1u>{nel * nmo});
+  fill_random(hij[0], p.seed + 1);
+  boost::multi::array<ComplexType, 2> v0({nmo, nmo});
+  fill_random(v0, p.seed + 2);
+
+  // closed shell NOMSD layout: half-rotated V2 and SpvnT, full Spvn
+  std::vector<T_csr> V2;
+  V2.emplace_back(make_random_csr<T_csr>(nel * nmo, nel * nmo, p.sparse_fraction, p.seed + 3, node));
+  V_csr Spvn(make_random_csr<V_csr>(nmo * nmo, p.nchol, p.sparse_fraction, p.seed + 5, node));
+  std::vector<T_csr> SpvnT;
+  SpvnT.emplace_back(make_random_csr<T_csr>(p.nchol, nel * nmo, p.sparse_fraction, p.seed + 7, node));
+
+  std::vector<typename T_csr::template matrix_view<int>> V2view;
+  V2view.emplace_back(csr::shm::local_balanced_partition(V2[0], TG));
+  auto Spvnview(csr::shm::local_balanced_partition(Spvn, TG));
+  std::vector<typename T_csr::template matrix_view<int>> SpvnTview;
+  SpvnTview.emplace_back(csr::shm::local_balanced_partition(SpvnT[0], TG));
+
+  return SparseTensor<ComplexType, ComplexType>(TG.TG_local(), CLOSED, std::move(H1), std::move(hij), std::move(V2),
+                                                std::move(V2view), std::move(Spvn), std::move(Spvnview), std::move(v0),
+                                                std::move(SpvnT), std::move(SpvnTview), ValueType(0.0), p.nchol);
+}
+
+#ifdef QMC_COMPLEX
+/*
+ * KP3Index Hamiltonian over a one dimensional grid of nkpts k-points, k_i + k_j = k_{(i+j)%nkpts},
+ * with the orbitals, electrons and Cholesky vectors evenly distributed over the k-points.
+ */
+KP3IndexFactorization make_kp3index(BenchmarkParameters const& p, TaskGroup_& TG)
+{
+  using IVector = boost::multi::array<int, 1>;
+  auto& node    = TG.Node();
+  int nk        = p.nkpts;
+  int nmo_k     = p.nmo / nk;
+  int nel_k     = p.nel / nk;
+  int nchol_k   = p.nchol / nk;
+  int ank_max   = nel_k * nchol_k * nmo_k;
+
+  IVector nopk(iextensions<1u>{nk});
+  IVector ncholpQ(iextensions<1u>{nk});
+  IVector kminus(iextensions<1u>{nk});
+  IVector Qmap(iextensions<1u>{nk});
+  int number_of_symmetric_Q = 0;
+  for (int Q = 0; Q < nk; Q++)
+  {
+    nopk[Q]    = nmo_k;
+    ncholpQ[Q] = nchol_k;
+    kminus[Q]  = (nk - Q) % nk;
+    Qmap[Q]    = (kminus[Q] == Q) ? 1 + (number_of_symmetric_Q++) : 0;
+  }
+  shmArray2D<int> nelpk({1, nk}, shared_allocator<int>{node});
+  shmArray2D<int> QKtoK2({nk, nk}, shared_allocator<int>{node});
+  if (node.root())
+    for (int Q = 0; Q < nk; Q++)
+    {
+      nelpk[0][Q] = nel_k;
+      for (int K = 0; K < nk; K++)
+        QKtoK2[Q][K] = (Q + K) % nk;
+    }
+  node.barrier();
+
+  shmArray3D<ComplexType> H1({nk, nmo_k, nmo_k}, shared_allocator<ComplexType>{node});
+  shmArray2D<ComplexType> haj({nk, nel_k * nmo_k}, shared_allocator<ComplexType>{node});
+  shmArray3D<ComplexType> vn0({nk, nmo_k, nmo_k}, shared_allocator<ComplexType>{node});
+  fill_random(H1, node, p.seed);
+  fill_random(haj, node, p.seed + 1);
+  fill_random(vn0, node, p.seed + 2);
+  std::vector<shmArray2D<SPComplexType>> LQKikn, LQKank, LQKbnl;
+  for (int Q = 0; Q < nk; Q++)
+  {
+    if (Q <= kminus[Q])
+      LQKikn.emplace_back(
+          shmArray2D<SPComplexType>({nk, nmo_k * nmo_k * nchol_k}, shared_allocator<SPComplexType>{node}));
+    else
+      LQKikn.emplace_back(shmArray2D<SPComplexType>({1, 1}, shared_allocator<SPComplexType>{node}));
+    fill_random(LQKikn.back(), node, p.seed + 3 + Q);
+    LQKank.emplace_back(shmArray2D<SPComplexType>({nk, ank_max}, shared_allocator<SPComplexType>{node}));
+    fill_random(LQKank.back(), node, p.seed + 3 + nk + Q);
+  }
+  for (int Q = 0; Q < number_of_symmetric_Q; Q++)
+  {
+    LQKbnl.emplace_back(shmArray2D<SPComplexType>({nk, ank_max}, shared_allocator<SPComplexType>{node}));
+    fill_random(LQKbnl.back(), node, p.seed + 3 + 2 * nk + Q);
+  }
+
+  return KP3IndexFactorization(TG.TG_local(), CLOSED, std::move(nopk), std::move(ncholpQ), std::move(kminus),
+                               std::move(nelpk), std::move(QKtoK2), std::move(H1), std::move(haj), std::move(LQKikn),
+                               std::move(LQKank), std::move(LQKbnl), std::move(Qmap), std::move(vn0),
+                               std::vector<RealType>(nk, 0.0), -1, ValueType(0.0), 0, 2 * nk * nchol_k);
+}
+#else
+Real3IndexFactorization make_real3index(BenchmarkParameters const& p, TaskGroup_& TG)
+{
+  auto& node = TG.Node();
+  int nmo = p.nmo, nel = p.nel;
+  shmArray2D<RealType> H1({nmo, nmo}, shared_allocator<RealType>{node});
+  shmArray2D<ComplexType> haj({1, nel * nmo}, shared_allocator<ComplexType>{node});
+  shmArray2D<SPRealType> Likn({nmo * nmo, p.nchol}, shared_allocator<SPRealType>{node});
+  shmArray2D<SPComplexType> Lakn({nel * nmo, p.nchol}, shared_allocator<SPComplexType>{node});
+  std::vector<shmArray3D<SPComplexType>> Lank;
+  Lank.emplace_back(shmArray3D<SPComplexType>({nel, p.nchol, nmo}, shared_allocator<SPComplexType>{node}));
+  shmArray2D<ComplexType> vn0({nmo, nmo}, shared_allocator<ComplexType>{node});
+  fill_random(H1, node, p.seed);
+  fill_random(haj, node, p.seed + 1);
+  fill_random(Likn, node, p.seed + 2);
+  fill_random(Lakn, node, p.seed + 3);
+  fill_random(Lank[0], node, p.seed + 4);
+  fill_random(vn0, node, p.seed + 5);
+  return Real3IndexFactorization(TG, CLOSED, std::move(H1), std::move(haj), std::move(Likn), std::move(Lakn),
+                                 std::move(Lank), std::move(vn0), ValueType(0.0), 0, p.nchol);
+}
+#endif
+
+/*
+ * Times vbias, vHS and the energy of a set of random walkers.
+ * The layout of the density matrices and of vHS follows the transposition flags of the factorization,
+ * as in the wavefunction and propagator classes.
+ */
+template<class HOps>
+std::vector<KernelTiming> time_hamiltonian_kernels(HOps& ops,
+                                                   BenchmarkParameters const& p,
+                                                   TaskGroup_& TG,
+                                                   bool vbias_and_energy_only = false)
+{
+  auto& node = TG.Node();
+  long nwalk = p.nwalk;
+  long gsize = long(p.nel) * p.nmo;
+  long nmo2  = long(p.nmo) * p.nmo;
+  long ncv   = ops.local_number_of_cholesky_vectors();
+
+  bool tv = ops.transposed_G_for_vbias();
+  bool tE = ops.transposed_G_for_E();
+  shmArray2D<ComplexType> Gv({tv ? nwalk : gsize, tv ? gsize : nwalk}, shared_allocator<ComplexType>{node});
+  shmArray2D<ComplexType> GE({tE ? nwalk : gsize, tE ? gsize : nwalk}, shared_allocator<ComplexType>{node});
+  shmArray2D<SPComplexType> vb({ncv, nwalk}, shared_allocator<SPComplexType>{node});
+  fill_random(Gv, node, p.seed + 100, 0.1);
+  fill_random(GE, node, p.seed + 101, 0.1);
+  // the wavefunctions pass the density matrices as array references to their buffers
+  boost::multi::array_ref<ComplexType, 2> Gv_ref(to_address(Gv.origin()), Gv.extensions());
+  boost::multi::array_ref<ComplexType, 2> GE_ref(to_address(GE.origin()), GE.extensions());
+  boost::multi::array<ComplexType, 2> E({nwalk, 3});
+
+  std::vector<KernelTiming> res;
+  res.push_back(time_kernel("vbias", node, p.nrepeat, [&]() { ops.vbias(Gv_ref, vb, 1.0, 0.0); }));
+  if (not vbias_and_energy_only)
+  {
+    shmArray2D<SPComplexType> X({ncv, nwalk}, shared_allocator<SPComplexType>{node});
+    bool tH = ops.transposed_vHS();
+    shmArray2D<SPComplexType> vHS({tH ? nwalk : nmo2, tH ? nmo2 : nwalk}, shared_allocator<SPComplexType>{node});
+    fill_random(X, node, p.seed + 102, 0.1);
+    res.push_back(time_kernel("vHS", node, p.nrepeat, [&]() { ops.vHS(X, vHS, 1.0); }));
+  }
+  res.push_back(time_kernel("energy", node, p.nrepeat, [&]() { ops.energy(E, GE_ref, 0, node.root()); }));
+  return res;
+}
+
+/*
+ * Times the walker kernels of a propagation step, which do not depend on the factorization:
+ * apply_expM with a random vHS, the QR orthogonalization and the mixed density matrix of the walkers.
+ * Walkers are distributed round robin over the ranks of the node.
+ */
+std::vector<KernelTiming> time_walker_kernels(BenchmarkParameters const& p, TaskGroup_& TG)
+{
+  using CMatrix = boost::multi::array<ComplexType, 2>;
+  auto& node    = TG.Node();
+  int nmo = p.nmo, nel = p.nel;
+  SlaterDetOperations_shared<ComplexType> SDet(nmo, nel);
+  CMatrix PsiT({nel, nmo});
+  CMatrix V({nmo, nmo});
+  CMatrix G({nel, nmo});
+  CMatrix T1({nmo, nel});
+  CMatrix T2({nmo, nel});
+  fill_random(PsiT, p.seed + 200);
+  fill_random(V, p.seed + 201, 0.01);
+  std::vector<CMatrix> W;
+  for (int iw = node.rank(); iw < p.nwalk; iw += node.size())
+  {
+    W.emplace_back(CMatrix({nmo, nel}));
+    fill_random(W.back(), p.seed + 300 + iw);
+  }
+
+  std::vector<KernelTiming> res;
+  res.push_back(time_kernel("apply_expM", node, p.nrepeat, [&]() {
+    for (auto& w : W)
+      SlaterDeterminantOperations::base::apply_expM(V, w, T1, T2, 6);
+  }));
+  res.push_back(time_kernel("orthogonalize", node, p.nrepeat, [&]() {
+    for (auto& w : W)
+      SDet.Orthogonalize(w, ComplexType(0.0));
+  }));
+  res.push_back(time_kernel("mixed_density_matrix", node, p.nrepeat, [&]() {
+    for (auto& w : W)
+      SDet.MixedDensityMatrix(PsiT, w, G, ComplexType(0.0), true);
+  }));
+  return res;
+}
+
+void write_timings(std::ostream& out, std::vector<KernelTiming> const& timings, std::string const& indent)
+{
+  for (int i = 0; i < timings.size(); i++)
+    out << indent << "{\"kernel\": \"" << timings[i].name << "\", \"min\": " << timings[i].min
+        << ", \"mean\": " << timings[i].mean << ", \"max\": " << timings[i].max << "}"
+        << (i + 1 < timings.size() ? "," : "") << "\n";
+}
+
+double total_mean(std::vector<KernelTiming> const& timings)
+{
+  double t = 0.0;
+  for (auto& k : timings)
+    t += k.mean;
+  return t;
+}
+
+void write_json(std::ostream& out,
+                BenchmarkParameters const& p,
+                TaskGroup_& TG,
+                std::vector<KernelTiming> const& walker_kernels,
+                std::vector<HamOpsResult> const& hamops,
+                std::vector<BlockSizeResult> const& thc_blocks)
+{
+  out << std::scientific << std::setprecision(6);
+  out << "{\n";
+  out << "  \"system\": {\"nmo\": " << p.nmo << ", \"nel\": " << p.nel << ", \"nchol\": " << p.nchol
+      << ", \"nmu\": " << p.nmu << ", \"rotnmu\": " << p.rotnmu << ", \"nkpts\": " << p.nkpts
+      << ", \"nwalk\": " << p.nwalk << ", \"sparse_fraction\": " << p.sparse_fraction << ", \"seed\": " << p.seed
+      << "},\n";
+  out << "  \"run\": {\"nrepeat\": " << p.nrepeat << ", \"nodes\": " << TG.getTotalNodes()
+      << ", \"cores_per_node\": " << TG.getTotalCores()
+#if defined(QMC_COMPLEX)
+      << ", \"complex\": true"
+#else
+      << ", \"complex\": false"
+#endif
+#if defined(MIXED_PRECISION)
+      << ", \"mixed_precision\": true},\n";
+#else
+      << ", \"mixed_precision\": false},\n";
+#endif
+  out << "  \"walker_kernels\": [\n";
+  write_timings(out, walker_kernels, "    ");
+  out << "  ],\n";
+  out << "  \"hamiltonian_operations\": [\n";
+  std::string fastest;
+  double tfastest = 0.0;
+  for (int i = 0; i < hamops.size(); i++)
+  {
+    auto& h = hamops[i];
+    out << "    {\"name\": \"" << h.name << "\", \"available\": " << (h.available ? "true" : "false");
+    if (h.available)
+    {
+      // time of a propagation step and energy evaluation, without the factorization independent kernels
+      double t = total_mean(h.kernels);
+      out << ", \"local_cholesky_vectors\": " << h.ncholesky << ", \"total_mean\": " << t << ", \"kernels\": [\n";
+      write_timings(out, h.kernels, "      ");
+      out << "    ]}";
+      if (fastest.empty() || t < tfastest)
+      {
+        fastest  = h.name;
+        tfastest = t;
+      }
+    }
+    else
+      out << ", \"reason\": \"" << h.reason << "\"}";
+    out << (i + 1 < hamops.size() ? "," : "") << "\n";
+  }
+  out << "  ],\n";
+  out << "  \"fastest\": \"" << fastest << "\",\n";
+  out << "  \"thc_interp_block_size\": [\n";
+  for (int i = 0; i < thc_blocks.size(); i++)
+  {
+    out << "    {\"interp_block_size\": " << thc_blocks[i].interp_block_size << ", \"kernels\": [\n";
+    write_timings(out, thc_blocks[i].kernels, "      ");
+    out << "    ]}" << (i + 1 < thc_blocks.size() ? "," : "") << "\n";
+  }
+  out << "  ]\n";
+  out << "}\n";
+}
+
+int main(int argc, char* argv[])
+{
+  boost::mpi3::environment env(argc, argv);
+  auto& world = boost::mpi3::environment::get_world_instance();
+  BenchmarkParameters p;
+  if (not parse_arguments(argc, argv, p))
+  {
+    if (world.root())
+      print_usage();
+    return 1;
+  }
+
+  GlobalTaskGroup gTG(world);
+  TaskGroup_ TG(gTG, std::string("BenchmarkTG"), 1, gTG.getTotalCores());
+  auto& node = TG.Node();
+  setup_memory_managers(node, 10uL * 1024uL * 1024uL);
+
+  std::vector<KernelTiming> walker_kernels;
+  std::vector<HamOpsResult> hamops;
+  std::vector<BlockSizeResult> thc_blocks;
+  {
+    if (world.root())
+      std::cout << " - walker kernels" << std::endl;
+    walker_kernels = time_walker_kernels(p, TG);
+
+    if (world.root())
+      std::cout << " - THC" << std::endl;
+    {
+      THCOps thc(make_thc(p, TG));
+      hamops.push_back({"THC", true, "", thc.local_number_of_cholesky_vectors(), time_hamiltonian_kernels(thc, p, TG)});
+      for (int nb : p.interp_block_sizes)
+      {
+        thc.set_interp_block_size(nb);
+        thc_blocks.push_back({nb, time_hamiltonian_kernels(thc, p, TG, true)});
+      }
+    }
+
+    if (world.root())
+      std::cout << " - SparseTensor" << std::endl;
+    {
+      auto st(make_sparse_tensor(p, TG));
+      hamops.push_back(
+          {"SparseTensor", true, "", st.local_number_of_cholesky_vectors(), time_hamiltonian_kernels(st, p, TG)});
+    }
+
+#ifdef QMC_COMPLEX
+    if (p.nmo % p.nkpts != 0 || p.nel % p.nkpts != 0 || p.nchol % p.nkpts != 0)
+      hamops.push_back({"KP3Index", false, "nmo, nel and nchol must be multiples of nkpts", 0, {}});
+    else
+    {
+      if (world.root())
+        std::cout << " - KP3Index" << std::endl;
+      auto kp3(make_kp3index(p, TG));
+      hamops.push_back(
+          {"KP3Index", true, "", kp3.local_number_of_cholesky_vectors(), time_hamiltonian_kernels(kp3, p, TG)});
+    }
+    hamops.push_back({"Real3Index", false, "requires a real build", 0, {}});
+#else
+    hamops.push_back({"KP3Index", false, "requires a complex build", 0, {}});
+    if (world.root())
+      std::cout << " - Real3Index" << std::endl;
+    {
+      auto r3(make_real3index(p, TG));
+      hamops.push_back(
+          {"Real3Index", true, "", r3.local_number_of_cholesky_vectors(), time_hamiltonian_kernels(r3, p, TG)});
+    }
+#endif
+  }
+
+  if (world.root())
+  {
+    std::ofstream out(p.output);
+    write_json(out, p, TG, walker_kernels, hamops, thc_blocks);
+    write_json(std::cout, p, TG, walker_kernels, hamops, thc_blocks);
+  }
+
+  release_memory_managers();
+  return 0;
+}
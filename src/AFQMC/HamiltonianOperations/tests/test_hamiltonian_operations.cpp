@@ -31,11 +31,14 @@
 #include <vector>
 #include <complex>
 #include <iomanip>
+#include <filesystem>
 
 #include "AFQMC/config.h"
 #include "AFQMC/Hamiltonians/HamiltonianFactory.h"
 #include "AFQMC/Hamiltonians/Hamiltonian.hpp"
 #include "AFQMC/Hamiltonians/THCHamiltonian.h"
+#include "AFQMC/Hamiltonians/FactorizedSparseHamiltonian.h"
+#include "AFQMC/HamiltonianOperations/HamOpsCache.hpp"
 #include "AFQMC/Matrix/csr_hdf5_readers.hpp"
 #include "AFQMC/Utilities/readWfn.h"
 #include "AFQMC/SlaterDeterminantOperations/SlaterDetOperations.hpp"
@@ -381,6 +384,320 @@ void ham_ops_basic_serial(boost::mpi3::communicator& world)
   }
 }
 
+/** THC energy and vbias with the interpolating points processed in blocks must agree with the unblocked path
+ */
+template<class Alloc>
+void thc_ops_interp_blocks(boost::mpi3::communicator& world)
+{
+  using pointer = device_ptr<ComplexType>;
+
+  if (not file_exists(UTEST_HAMIL))
+  {
+    app_log() << " Skipping thc_ops_interp_blocks. Hamiltonian file not found. \n";
+    app_log() << " Run unit test with --hamil /path/to/hamil.h5.\n";
+    return;
+  }
+
+  std::vector<int> dims(3);
+  {
+    hdf_archive dump;
+    if (!dump.open(UTEST_HAMIL, H5F_ACC_RDONLY))
+      APP_ABORT(" Error opening Hamiltonian file.\n");
+    dump.push("Hamiltonian", false);
+    if (!dump.is_group("THC"))
+    {
+      app_log() << " Skipping thc_ops_interp_blocks. Not a THC Hamiltonian. \n";
+      return;
+    }
+    dump.push("THC", false);
+    dump.readEntry(dims, "dims");
+  }
+  // number of interpolating points in Muv/Piu (vbias) and in the rotated factorization (energy)
+  const int nmu    = dims[1];
+  const int rotnmu = dims[2];
+
+  afqmc::GlobalTaskGroup gTG(world);
+  auto TG = TaskGroup_(gTG, std::string("DummyTG"), 1, gTG.getTotalCores());
+  Alloc alloc_(make_localTG_allocator<ComplexType>(TG));
+
+  int NMO, NAEA, NAEB;
+  std::tie(NMO, NAEA, NAEB) = read_info_from_hdf(UTEST_HAMIL);
+  REQUIRE(NAEA == NAEB);
+  std::map<std::string, AFQMCInfo> InfoMap;
+  InfoMap.insert(std::make_pair("info0", AFQMCInfo{"info0", NMO, NAEA, NAEB}));
+  HamiltonianFactory HamFac(InfoMap);
+
+  // a trial determinant and a density matrix that are not diagonal in the orbital basis
+  boost::multi::array<ComplexType, 2> A({NMO, NAEA});
+  boost::multi::array<ComplexType, 2> G_host({NAEA, NMO});
+  for (int i = 0; i < NMO; i++)
+    for (int a = 0; a < NAEA; a++)
+      A[i][a] = ComplexType((i == a ? 1.0 : 0.0) + 0.05 * std::cos(1.3 * i + 0.7 * a), 0.02 * std::sin(0.9 * i - a));
+  for (int a = 0; a < NAEA; a++)
+    for (int i = 0; i < NMO; i++)
+      G_host[a][i] =
+          ComplexType((i == a ? 1.0 : 0.0) + 0.1 * std::sin(0.4 * i + 1.1 * a), 0.05 * std::cos(0.3 * i * a));
+  std::vector<PsiT_Matrix> PsiT;
+  PsiT.emplace_back(csr::shm::construct_csr_matrix_single_input<PsiT_Matrix>(A, 0.0, 'T', gTG.Node()));
+
+  boost::multi::array<ComplexType, 2, Alloc> G(G_host, alloc_);
+  boost::multi::array_ref<ComplexType, 2, pointer> Gw(make_device_ptr(G.origin()), {1, NAEA * NMO});
+  const double sqrtdt = std::sqrt(0.01);
+
+  int num_hams  = 0;
+  auto evaluate = [&](int block_size, const std::string& buffer_size_mb) {
+    const std::string ham_name("ham" + std::to_string(num_hams++));
+    std::string hamil_xml = R"(<Hamiltonian name=")" + ham_name + R"(" info="info0">
+      <parameter name="filetype">hdf5</parameter>
+      <parameter name="filename">)" +
+        UTEST_HAMIL + R"(</parameter>
+      <parameter name="interp_block_size">)" +
+        std::to_string(block_size) + R"(</parameter>
+      <parameter name="buffer_size_mb">)" +
+        buffer_size_mb + R"(</parameter>
+    </Hamiltonian>
+    )";
+    Libxml2Document doc;
+    REQUIRE(doc.parseFromString(hamil_xml.c_str()));
+    HamFac.push(ham_name, doc.getRoot());
+    Hamiltonian& ham = HamFac.getHamiltonian(gTG, ham_name);
+    hdf_archive dummy;
+    auto HOps(ham.getHamiltonianOperations(false, false, CLOSED, PsiT, 1e-6, 1e-6, TG, TG, dummy));
+    REQUIRE(HOps.transposed_G_for_E());
+    REQUIRE(HOps.transposed_G_for_vbias());
+
+    boost::multi::array<ComplexType, 2, Alloc> Eloc({1, 3}, alloc_);
+    HOps.energy(Eloc, Gw, 0, TG.getCoreID() == 0);
+    boost::multi::array<ComplexType, 2, Alloc> X({HOps.local_number_of_cholesky_vectors(), 1}, alloc_);
+    HOps.vbias(Gw, X, sqrtdt);
+    TG.local_barrier();
+
+    std::vector<ComplexType> values;
+    for (int i = 0; i < 3; i++)
+      values.push_back(TG.Node() += ComplexType(Eloc[0][i]));
+    for (int i = 0; i < std::get<0>(X.sizes()); i++)
+      values.push_back(ComplexType(X[i][0]));
+    return values;
+  };
+
+  // the default buffer and no blocking
+  const std::vector<ComplexType> ref = evaluate(0, "0");
+
+  // block sizes of one point, one that divides neither nmu nor rotnmu, half of the points and more than all of them
+  int no_divisor = 2;
+  while (no_divisor < rotnmu && (nmu % no_divisor == 0 || rotnmu % no_divisor == 0))
+    no_divisor++;
+  for (int block_size : {1, no_divisor, std::max(1, rotnmu / 2), nmu + 1})
+  {
+    INFO("interp_block_size " << block_size);
+    const std::vector<ComplexType> blocked = evaluate(block_size, "1");
+    REQUIRE(blocked.size() == ref.size());
+    for (int i = 0; i < ref.size(); i++)
+    {
+      INFO("energy term or Cholesky vector " << i);
+      CHECK(real(blocked[i]) == Approx(real(ref[i])).epsilon(1e-10).margin(1e-12));
+      CHECK(imag(blocked[i]) == Approx(imag(ref[i])).epsilon(1e-10).margin(1e-12));
+    }
+  }
+}
+
+/** the cache files written by hamops_cache::writer must be read back exactly, including csr matrices with
+ *  unused capacity in their rows, and must be rejected for any other key
+ */
+template<class Alloc>
+void ham_ops_cache(boost::mpi3::communicator& world)
+{
+  using pointer = device_ptr<ComplexType>;
+  using CSR     = SpVType_shm_csr_matrix;
+
+  afqmc::GlobalTaskGroup gTG(world);
+  auto& node = gTG.Node();
+  auto TG    = TaskGroup_(gTG, std::string("DummyTG"), 1, gTG.getTotalCores());
+  const std::string cache_dir("hamops_cache_utest");
+  if (world.root())
+    std::filesystem::remove_all(cache_dir);
+  world.barrier();
+
+  // writer, reader and read_csr on a matrix with a global origin, empty rows and gaps between the rows
+  {
+    const std::string key("hamops_cache round trip");
+    const std::string fname = hamops_cache::file_name(cache_dir, key, TG.getNodeID());
+    const std::vector<std::size_t> nnzpr{3, 0, 5, 2};
+    CSR A({4, 7}, {3, 11}, nnzpr, shared_allocator<SPValueType>{node});
+    if (node.root())
+    {
+      A.emplace_back({0, 1}, SPValueType(1.5));
+      A.emplace_back({0, 6}, SPValueType(-2.0));
+      for (int j = 0; j < 4; j++)
+        A.emplace_back({2, 2 * j % 7}, SPValueType(0.25 * j - 1.0));
+      A.emplace_back({3, 0}, SPValueType(3.0));
+    }
+    node.barrier();
+    const std::vector<ComplexType> arr{ComplexType(1.0, -1.0), ComplexType(0.5, 2.0), ComplexType(-3.0, 0.0)};
+    const int n = 42;
+    if (node.root())
+    {
+      hamops_cache::writer w(fname, key);
+      w.write(&n, 1);
+      w.write(arr.data(), arr.size());
+      w.write_csr(A);
+      REQUIRE(w.close());
+    }
+    world.barrier();
+    REQUIRE(hamops_cache::exists(fname, key, TG));
+
+    std::unique_ptr<hamops_cache::reader> r;
+    if (node.root())
+    {
+      r = std::make_unique<hamops_cache::reader>(fname, key);
+      REQUIRE(r->valid());
+    }
+    int n_ = 0;
+    hamops_cache::read_bcast(r.get(), node, &n_, 1);
+    CHECK(n_ == n);
+    std::vector<ComplexType> arr_(arr.size());
+    hamops_cache::read_bcast(r.get(), node, arr_.data(), arr_.size());
+    CHECK(arr_ == arr);
+    CSR B(hamops_cache::read_csr<CSR>(r.get(), node));
+    CHECK(B.size(0) == A.size(0));
+    CHECK(B.size(1) == A.size(1));
+    CHECK(B.global_origin() == A.global_origin());
+    CHECK(B.num_non_zero_elements() == A.num_non_zero_elements());
+    for (int i = 0; i < A.size(0); i++)
+    {
+      auto pa = A.pointers_begin()[i];
+      auto pb = B.pointers_begin()[i];
+      const std::size_t nnz = A.pointers_end()[i] - pa;
+      REQUIRE(B.pointers_end()[i] - pb == nnz);
+      for (std::size_t k = 0; k < nnz; k++)
+      {
+        CHECK(B.non_zero_indices2_data()[pb + k] == A.non_zero_indices2_data()[pa + k]);
+        CHECK(B.non_zero_values_data()[pb + k] == A.non_zero_values_data()[pa + k]);
+      }
+    }
+
+    // a file written for another key or truncated is never read
+    if (node.root())
+    {
+      CHECK(not hamops_cache::reader(fname, key + " ").valid());
+      CHECK(not hamops_cache::reader(fname, "hamops_cache round trap").valid());
+      std::filesystem::resize_file(fname, std::filesystem::file_size(fname) - 1);
+      CHECK(not hamops_cache::reader(fname, key).valid());
+    }
+    world.barrier();
+    CHECK(not hamops_cache::exists(fname, key, TG));
+    world.barrier();
+    if (world.root())
+      std::filesystem::remove_all(cache_dir);
+  }
+
+  // HamiltonianOperations of a FactorizedSparseHamiltonian loaded from the cache
+  if (not file_exists(UTEST_HAMIL))
+  {
+    app_log() << " Skipping ham_ops_cache. Hamiltonian file not found. \n";
+    app_log() << " Run unit test with --hamil /path/to/hamil.h5.\n";
+    return;
+  }
+  Alloc alloc_(make_localTG_allocator<ComplexType>(TG));
+
+  int NMO, NAEA, NAEB;
+  std::tie(NMO, NAEA, NAEB) = read_info_from_hdf(UTEST_HAMIL);
+  std::map<std::string, AFQMCInfo> InfoMap;
+  InfoMap.insert(std::make_pair("info0", AFQMCInfo{"info0", NMO, NAEA, NAEA}));
+  HamiltonianFactory HamFac(InfoMap);
+  std::string hamil_xml = R"(<Hamiltonian name="ham0" info="info0">
+      <parameter name="filetype">hdf5</parameter>
+      <parameter name="filename">)" +
+      UTEST_HAMIL + R"(</parameter>
+      <parameter name="cache_dir">)" +
+      cache_dir + R"(</parameter>
+    </Hamiltonian>
+    )";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(hamil_xml.c_str()));
+  HamFac.push("ham0", doc.getRoot());
+  Hamiltonian& ham = HamFac.getHamiltonian(gTG, "ham0");
+  auto* fham       = boost::get<FactorizedSparseHamiltonian>(&ham);
+  if (fham == nullptr)
+  {
+    app_log() << " Skipping ham_ops_cache. Not a factorized Hamiltonian. \n";
+    return;
+  }
+
+  // a closed shell trial determinant and a density matrix that are not diagonal in the orbital basis
+  auto make_psiT = [&](double shift) {
+    boost::multi::array<ComplexType, 2> A({NMO, NAEA});
+    for (int i = 0; i < NMO; i++)
+      for (int a = 0; a < NAEA; a++)
+        A[i][a] = ComplexType((i == a ? 1.0 : 0.0) + shift * std::cos(1.3 * i + 0.7 * a), 0.02 * std::sin(0.9 * i - a));
+    std::vector<PsiT_Matrix> PsiT;
+    PsiT.emplace_back(csr::shm::construct_csr_matrix_single_input<PsiT_Matrix>(A, 0.0, 'T', gTG.Node()));
+    return PsiT;
+  };
+  std::vector<PsiT_Matrix> PsiT = make_psiT(0.05);
+  boost::multi::array<ComplexType, 2> G_host({NAEA, NMO});
+  for (int a = 0; a < NAEA; a++)
+    for (int i = 0; i < NMO; i++)
+      G_host[a][i] =
+          ComplexType((i == a ? 1.0 : 0.0) + 0.1 * std::sin(0.4 * i + 1.1 * a), 0.05 * std::cos(0.3 * i * a));
+  boost::multi::array<ComplexType, 2, Alloc> G(G_host, alloc_);
+  boost::multi::array<ComplexType, 2, Alloc> GT(G_host.transposed(), alloc_);
+
+  auto evaluate = [&]() {
+    hdf_archive dummy;
+    auto HOps(ham.getHamiltonianOperations(false, false, CLOSED, PsiT, 1e-6, 1e-6, TG, TG, dummy));
+    boost::multi::array_ref<ComplexType, 2, pointer> GE(make_device_ptr(G.origin()), {NAEA * NMO, 1});
+    if (HOps.transposed_G_for_E())
+      GE = boost::multi::array_ref<ComplexType, 2, pointer>(make_device_ptr(G.origin()), {1, NAEA * NMO});
+    boost::multi::array<ComplexType, 2, Alloc> Eloc({1, 3}, alloc_);
+    HOps.energy(Eloc, GE, 0, TG.getCoreID() == 0);
+    auto& Gv = HOps.transposed_G_for_vbias() ? G : GT;
+    boost::multi::array_ref<ComplexType, 2, pointer> GV(make_device_ptr(Gv.origin()),
+                                                        {HOps.transposed_G_for_vbias() ? 1 : NAEA * NMO,
+                                                         HOps.transposed_G_for_vbias() ? NAEA * NMO : 1});
+    boost::multi::array<ComplexType, 2, Alloc> X({HOps.local_number_of_cholesky_vectors(), 1}, alloc_);
+    HOps.vbias(GV, X, std::sqrt(0.01));
+    TG.local_barrier();
+    std::vector<ComplexType> values;
+    for (int i = 0; i < 3; i++)
+      values.push_back(TG.Node() += ComplexType(Eloc[0][i]));
+    for (int i = 0; i < std::get<0>(X.sizes()); i++)
+      values.push_back(ComplexType(X[i][0]));
+    return values;
+  };
+
+  // the first construction writes the cache, the second one loads it
+  const std::string key   = fham->getHamOpsCacheKey(22, CLOSED, PsiT, 1e-6, 1e-6, TG, TG);
+  const std::string fname = hamops_cache::file_name(cache_dir, key, TG.getNodeID());
+  CHECK(not hamops_cache::exists(fname, key, TG));
+  const std::vector<ComplexType> ref = evaluate();
+  REQUIRE(hamops_cache::exists(fname, key, TG));
+  const std::vector<ComplexType> cached = evaluate();
+  REQUIRE(cached.size() == ref.size());
+  for (int i = 0; i < ref.size(); i++)
+  {
+    INFO("energy term or Cholesky vector " << i);
+    CHECK(cached[i] == ref[i]);
+  }
+
+  // any change of the inputs or the parameters changes the key, the file written for key is rejected
+  std::vector<PsiT_Matrix> PsiT2 = make_psiT(0.06);
+  for (const std::string& other : {fham->getHamOpsCacheKey(22, CLOSED, PsiT2, 1e-6, 1e-6, TG, TG),
+                                   fham->getHamOpsCacheKey(22, CLOSED, PsiT, 1e-5, 1e-6, TG, TG),
+                                   fham->getHamOpsCacheKey(22, CLOSED, PsiT, 1e-6, 1e-7, TG, TG),
+                                   fham->getHamOpsCacheKey(12, CLOSED, PsiT, 1e-6, 1e-6, TG, TG)})
+  {
+    CHECK(other != key);
+    CHECK(hamops_cache::file_name(cache_dir, other, TG.getNodeID()) != fname);
+    CHECK(not hamops_cache::exists(fname, other, TG));
+  }
+  CHECK(hamops_cache::exists(fname, key, TG));
+
+  world.barrier();
+  if (world.root())
+    std::filesystem::remove_all(cache_dir);
+}
+
 TEST_CASE("ham_ops_basic_serial", "[hamiltonian_operations]")
 {
   auto world = boost::mpi3::environment::get_world_instance();
@@ -398,4 +715,38 @@ TEST_CASE("ham_ops_basic_serial", "[hamiltonian_operations]")
   release_memory_managers();
 }
 
+TEST_CASE("thc_ops_interp_blocks", "[hamiltonian_operations]")
+{
+  auto world = boost::mpi3::environment::get_world_instance();
+  auto node  = world.split_shared(world.rank());
+
+#if defined(ENABLE_CUDA) || defined(ENABLE_HIP)
+
+  arch::INIT(node);
+  using Alloc = device::device_allocator<ComplexType>;
+#else
+  using Alloc = shared_allocator<ComplexType>;
+#endif
+  setup_memory_managers(node, 10uL * 1024uL * 1024uL);
+  thc_ops_interp_blocks<Alloc>(world);
+  release_memory_managers();
+}
+
+TEST_CASE("ham_ops_cache", "[hamiltonian_operations]")
+{
+  auto world = boost::mpi3::environment::get_world_instance();
+  auto node  = world.split_shared(world.rank());
+
+#if defined(ENABLE_CUDA) || defined(ENABLE_HIP)
+
+  arch::INIT(node);
+  using Alloc = device::device_allocator<ComplexType>;
+#else
+  using Alloc = shared_allocator<ComplexType>;
+#endif
+  setup_memory_managers(node, 10uL * 1024uL * 1024uL);
+  ham_ops_cache<Alloc>(world);
+  release_memory_managers();
+}
+
 } // namespace qmcplusplus
@@ -8,6 +8,7 @@
 #include <vector>
 #include <numeric>
 #include <functional>
+#include <sstream>
 #if defined(USE_MPI)
 #include <mpi.h>
 #endif
@@ -227,6 +228,36 @@ SpVType_shm_csr_matrix FactorizedSparseHamiltonian::generateHijkl(
   }
 }
 
+std::string FactorizedSparseHamiltonian::getHamOpsCacheKey(int code,
+                                                           WALKER_TYPES type,
+                                                           std::vector<PsiT_Matrix>& PsiT,
+                                                           double cutvn,
+                                                           double cutv2,
+                                                           TaskGroup_& TGprop,
+                                                           TaskGroup_& TGwfn)
+{
+  // the integrals and the trial wavefunction are identical on all nodes, hash them once
+  std::uint64_t inputs = 0;
+  if (TG.Global().root())
+  {
+    auto H1 = getH1();
+    inputs  = hamops_cache::hash(H1.origin(), H1.num_elements() * sizeof(ValueType));
+    inputs  = hamops_cache::hash_csr(V2_fact, inputs);
+    for (auto& P : PsiT)
+      inputs = hamops_cache::hash_csr(P, inputs);
+  }
+  TG.Global().broadcast_value(inputs);
+
+  ValueType E0 = OneBodyHamiltonian::NuclearCoulombEnergy + OneBodyHamiltonian::FrozenCoreEnergy;
+  std::ostringstream key;
+  key << std::hexfloat;
+  key << "SparseTensor=" << code << ";walker_type=" << type << ";NMO=" << NMO << ";NAEA=" << NAEA << ";NAEB=" << NAEB
+      << ";npsi=" << PsiT.size() << ";E0=" << E0 << ";cutvn=" << cutvn << ";cutv2=" << cutv2
+      << ";cutoff_1bar=" << cutoff1bar << ";skip_V2=" << skip_V2 << ";rotation_type=" << factorizedHalfRotationType
+      << ";inputs=" << std::hex << inputs << ";" << hamops_cache::layout_key(TGprop, TGwfn);
+  return key.str();
+}
+
 HamiltonianOperations FactorizedSparseHamiltonian::getHamiltonianOperations(bool pureSD,
                                                                             bool addCoulomb,
                                                                             WALKER_TYPES type,
@@ -253,6 +284,33 @@ HamiltonianOperations FactorizedSparseHamiltonian::getHamiltonianOperations(bool
   //    if(TGwfn.Global().root()) write_hdf = (dump.file_id != hdf_archive::is_closed);
   TGwfn.Global().broadcast_value(write_hdf);
 
+  // several posibilities
+  int ndet = ((type != COLLINEAR) ? (PsiT.size()) : (PsiT.size() / 2));
+
+  // the SparseTensor<T1,T2> built below is identified by the same code as in writeSparseTensor
+  // multi determinant pureSD is not implemented and is never cached
+  int code = (ndet == 1) ? (pureSD ? 12 : 22) : (addCoulomb ? 21 : 22);
+  std::string cache_key, cache_file;
+  if (cache_dir != "" && not(ndet > 1 && pureSD))
+  {
+    cache_key  = getHamOpsCacheKey(code, type, PsiT, cutvn, cutv2, TGprop, TGwfn);
+    cache_file = hamops_cache::file_name(cache_dir, cache_key, TGwfn.getNodeID());
+    // the restart file is only written when constructing from scratch
+    if (not write_hdf && hamops_cache::exists(cache_file, cache_key, TGwfn))
+    {
+      app_log() << " Loading HamiltonianOperations from cache: " << cache_file << "\n";
+      if (code == 12)
+        return HamiltonianOperations(
+            loadSparseTensorCache<ValueType, ComplexType>(cache_file, cache_key, type, TGprop, TGwfn));
+      else if (code == 21)
+        return HamiltonianOperations(
+            loadSparseTensorCache<ComplexType, ValueType>(cache_file, cache_key, type, TGprop, TGwfn));
+      else
+        return HamiltonianOperations(
+            loadSparseTensorCache<ComplexType, ComplexType>(cache_file, cache_key, type, TGprop, TGwfn));
+    }
+  }
+
   boost::multi::array<ComplexType, 2> vn0({NMO, NMO});
   auto Spvn(calculateHSPotentials(cutvn, TGprop, vn0));
   auto Spvnview(csr::shm::local_balanced_partition(Spvn, TGprop));
@@ -268,8 +326,6 @@ HamiltonianOperations FactorizedSparseHamiltonian::getHamiltonianOperations(bool
   // dense one body hamiltonian
   auto H1 = getH1();
 
-  // several posibilities
-  int ndet = ((type != COLLINEAR) ? (PsiT.size()) : (PsiT.size() / 2));
   // SparseTensor<Integrals_Type, SpvnT_Type>
   if (ndet == 1)
   {
@@ -319,6 +375,8 @@ HamiltonianOperations FactorizedSparseHamiltonian::getHamiltonianOperations(bool
 
       if (write_hdf)
         writeSparseTensor(dump, type, NMO, NAEA, NAEB, TGprop, TGwfn, H1, V2, Spvn, vn0, E0, global_ncvecs, 12);
+      if (cache_file != "")
+        writeSparseTensorCache(cache_file, cache_key, TGwfn, H1, hij, V2, Spvn, vn0, SpvnT, E0, global_ncvecs);
 
       return HamiltonianOperations(sparse_ham(TGwfn.TG_local(), type, std::move(H1), std::move(hij), std::move(V2),
                                               std::move(V2view), std::move(Spvn), std::move(Spvnview), std::move(vn0),
@@ -339,6 +397,8 @@ HamiltonianOperations FactorizedSparseHamiltonian::getHamiltonianOperations(bool
 
       if (write_hdf)
         writeSparseTensor(dump, type, NMO, NAEA, NAEB, TGprop, TGwfn, H1, V2, Spvn, vn0, E0, global_ncvecs, 22);
+      if (cache_file != "")
+        writeSparseTensorCache(cache_file, cache_key, TGwfn, H1, hij, V2, Spvn, vn0, SpvnT, E0, global_ncvecs);
 
       return HamiltonianOperations(sparse_ham(TGwfn.TG_local(), type, std::move(H1), std::move(hij), std::move(V2),
                                               std::move(V2view), std::move(Spvn), std::move(Spvnview), std::move(vn0),
@@ -386,6 +446,8 @@ HamiltonianOperations FactorizedSparseHamiltonian::getHamiltonianOperations(bool
 
       if (write_hdf)
         writeSparseTensor(dump, type, NMO, NAEA, NAEB, TGprop, TGwfn, H1, V2, Spvn, vn0, E0, global_ncvecs, 21);
+      if (cache_file != "")
+        writeSparseTensorCache(cache_file, cache_key, TGwfn, H1, hij, V2, Spvn, vn0, SpvnT, E0, global_ncvecs);
 
       return HamiltonianOperations(sparse_ham(TGwfn.TG_local(), type, std::move(H1), std::move(hij), std::move(V2),
                                               std::move(V2view), std::move(Spvn), std::move(Spvnview), std::move(vn0),
@@ -437,6 +499,8 @@ HamiltonianOperations FactorizedSparseHamiltonian::getHamiltonianOperations(bool
 
       if (write_hdf)
         writeSparseTensor(dump, type, NMO, NAEA, NAEB, TGprop, TGwfn, H1, V2, Spvn, vn0, E0, global_ncvecs, 21);
+      if (cache_file != "")
+        writeSparseTensorCache(cache_file, cache_key, TGwfn, H1, hij, V2, Spvn, vn0, SpvnT, E0, global_ncvecs);
 
       return HamiltonianOperations(sparse_ham(TGwfn.TG_local(), type, std::move(H1), std::move(hij), std::move(V2),
                                               std::move(V2view), std::move(Spvn), std::move(Spvnview), std::move(vn0),
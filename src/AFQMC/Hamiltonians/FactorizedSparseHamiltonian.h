@@ -46,7 +46,8 @@ public:
         cutoff_cholesky(1e-6),
         skip_V2(false),
         factorizedHalfRotationType("DD"),
-        maximum_buffer_size(1024)
+        maximum_buffer_size(1024),
+        cache_dir("")
   {
     distribute_Ham = (TG.getNumberOfTGs() > 1);
 
@@ -69,6 +70,7 @@ public:
     m_param.add(str, "skip_V2");
     m_param.add(maximum_buffer_size, "buffer_size");
     m_param.add(factorizedHalfRotationType, "rotation_type");
+    m_param.add(cache_dir, "cache_dir");
     m_param.put(cur);
 
     std::transform(str.begin(), str.end(), str.begin(), (int (*)(int))tolower);
@@ -129,6 +131,15 @@ public:
                                                  TaskGroup_& TGwfn,
                                                  hdf_archive& dump);
 
+  // key of the HamiltonianOperations cache, see HamOpsCache.hpp
+  std::string getHamOpsCacheKey(int code,
+                                WALKER_TYPES type,
+                                std::vector<PsiT_Matrix>& PsiT,
+                                double cutvn,
+                                double cutv2,
+                                TaskGroup_& TGprop,
+                                TaskGroup_& TGwfn);
+
   ValueType H(IndexType I, IndexType J) const { return OneBodyHamiltonian::H(I, J); }
 
   // this should never be used outside initialization routines.
@@ -176,6 +187,9 @@ protected:
 
   std::string factorizedHalfRotationType;
   int maximum_buffer_size;
+
+  // directory of the HamiltonianOperations cache, no caching if empty
+  std::string cache_dir;
 };
 
 //#include "AFQMC/Hamiltonians/FactorizedSparseHamiltonian.icc"
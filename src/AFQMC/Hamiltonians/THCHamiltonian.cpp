@@ -379,9 +379,12 @@ HamiltonianOperations THCHamiltonian::getHamiltonianOperations(bool pureSD,
     dump.close();
   }
 
-  return HamiltonianOperations(THCOps(TGwfn.TG_local(), NMO, naea_, naeb_, type, nmu0, rotnmu0, std::move(H1_),
-                                      std::move(hij), std::move(rotMuv), std::move(rotPiu), std::move(rotcPua),
-                                      std::move(Luv), std::move(Piu), std::move(cPua), std::move(v0), E0));
+  THCOps thcops(TGwfn.TG_local(), NMO, naea_, naeb_, type, nmu0, rotnmu0, std::move(H1_), std::move(hij),
+                std::move(rotMuv), std::move(rotPiu), std::move(rotcPua), std::move(Luv), std::move(Piu),
+                std::move(cPua), std::move(v0), E0);
+  thcops.set_interp_block_size(interp_block_size);
+  thcops.set_buffer_size_in_MB(buffer_size_in_MB);
+  return HamiltonianOperations(std::move(thcops));
 }
 
 
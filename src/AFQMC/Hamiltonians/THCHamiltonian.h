@@ -43,12 +43,19 @@ public:
                  TaskGroup_& tg_,
                  ValueType nucE = 0,
                  ValueType fzcE = 0)
-      : OneBodyHamiltonian(info, std::move(h), nucE, fzcE), TG(tg_), cutoff_cholesky(1e-6), fileName("")
+      : OneBodyHamiltonian(info, std::move(h), nucE, fzcE),
+        TG(tg_),
+        cutoff_cholesky(1e-6),
+        fileName(""),
+        interp_block_size(0),
+        buffer_size_in_MB(0)
   {
     std::string str("yes");
     ParameterSet m_param;
     m_param.add(cutoff_cholesky, "cutoff_cholesky");
     m_param.add(fileName, "filename");
+    m_param.add(interp_block_size, "interp_block_size");
+    m_param.add(buffer_size_in_MB, "buffer_size_mb");
     m_param.put(cur);
   }
 
@@ -87,6 +94,12 @@ protected:
   RealType cutoff_cholesky;
 
   std::string fileName;
+
+  // number of interpolating points processed at once in THCOps, 0 means all
+  int interp_block_size;
+
+  // memory budget of THCOps in MB, 0 keeps the default
+  int buffer_size_in_MB;
 };
 
 } // namespace afqmc
@@ -0,0 +1,112 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AFQMC_NUMERICS_HALF_PRECISION_HPP
+#define AFQMC_NUMERICS_HALF_PRECISION_HPP
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+
+namespace ma
+{
+/*
+ * Conversions between float and IEEE 754 binary16 stored in a uint16_t.
+ * Used for compact storage only, arithmetic is always done in float or double.
+ * Rounding is to nearest even, values beyond the half range become +-inf.
+ */
+inline uint16_t float_to_half(float f)
+{
+  uint32_t x;
+  std::memcpy(&x, &f, sizeof(float));
+  const uint16_t sign = (x >> 16) & 0x8000;
+  x &= 0x7fffffff;
+  // inf and nan
+  if (x >= 0x7f800000)
+    return sign | 0x7c00 | (x > 0x7f800000 ? 0x200 : 0);
+  // overflow, values between 65504 and 2^16 are handled by the rounding below
+  if (x >= 0x47800000)
+    return sign | 0x7c00;
+  // normal half
+  if (x >= 0x38800000)
+  {
+    uint32_t h         = (x - 0x38000000) >> 13;
+    const uint32_t rem = x & 0x1fff;
+    if (rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+      h++;
+    return sign | h;
+  }
+  // below half of the smallest subnormal
+  if (x < 0x33000000)
+    return sign;
+  // subnormal half, value m * 2^-24
+  const uint32_t shift = 126 - (x >> 23);
+  const uint32_t m     = (x & 0x7fffff) | 0x800000;
+  uint32_t h           = m >> shift;
+  const uint32_t rem   = m & ((1u << shift) - 1);
+  const uint32_t mid   = 1u << (shift - 1);
+  if (rem > mid || (rem == mid && (h & 1)))
+    h++;
+  return sign | h;
+}
+
+inline float half_to_float(uint16_t h)
+{
+  const uint32_t sign = uint32_t(h & 0x8000) << 16;
+  const uint32_t e    = (h >> 10) & 0x1f;
+  const uint32_t m    = h & 0x3ff;
+  if (e == 0)
+  {
+    const float f = std::ldexp(float(m), -24);
+    return sign ? -f : f;
+  }
+  const uint32_t x = sign | ((e == 0x1f) ? (0x7f800000 | (m << 13)) : (((e + 112) << 23) | (m << 13)));
+  float f;
+  std::memcpy(&f, &x, sizeof(float));
+  return f;
+}
+
+/// complex number with binary16 real and imaginary parts
+struct half_complex
+{
+  uint16_t re;
+  uint16_t im;
+};
+
+template<class T>
+inline void narrow(const std::complex<T>& a, half_complex& b)
+{
+  b.re = float_to_half(float(a.real()));
+  b.im = float_to_half(float(a.imag()));
+}
+
+template<class T>
+inline void narrow(const std::complex<T>& a, std::complex<float>& b)
+{
+  b = std::complex<float>(float(a.real()), float(a.imag()));
+}
+
+template<class T>
+inline void widen(const half_complex& a, std::complex<T>& b)
+{
+  b = std::complex<T>(half_to_float(a.re), half_to_float(a.im));
+}
+
+template<class T>
+inline void widen(const std::complex<float>& a, std::complex<T>& b)
+{
+  b = std::complex<T>(a.real(), a.imag());
+}
+
+} // namespace ma
+
+#endif
@@ -43,5 +43,11 @@ enum BRANCHING_ALGORITHM
   MIN_BRANCH,
   SERIAL_COMB
 };
+enum BP_FIELDS_PRECISION
+{
+  BP_FIELDS_FULL,
+  BP_FIELDS_SINGLE,
+  BP_FIELDS_HALF
+};
 
 #endif
@@ -15,15 +15,18 @@
 #include <random>
 #include <type_traits>
 #include <memory>
+#include <cstring>
 
 #include "Configuration.h"
 #include "OhmmsData/libxmldefs.h"
 #include "Utilities/TimerManager.h"
 #include "Utilities/RandomGenerator.h"
+#include "Utilities/FairDivide.h"
 
 #include "AFQMC/config.h"
 #include "AFQMC/Utilities/taskgroup.h"
 #include "AFQMC/Numerics/ma_blas.hpp"
+#include "AFQMC/Numerics/half_precision.hpp"
 
 #include "AFQMC/Walkers/Walkers.hpp"
 #include "AFQMC/Walkers/WalkerControl.hpp"
@@ -107,6 +110,8 @@ public:
         Timers(getGlobalTimerManager(), WalkerSetBaseTimerNames, timer_level_coarse),
         walker_buffer({0, 1}, alloc_),
         bp_buffer({0, 0}, bpalloc_),
+        fields_stage({0, 0}, bpalloc_),
+        bp_fields_precision(BP_FIELDS_FULL),
         load_balance(UNDEFINED_LOAD_BALANCE),
         pop_control(UNDEFINED_BRANCHING),
         min_weight(0.05),
@@ -324,15 +329,18 @@ public:
         APP_ABORT("");
       }
     }
+    if (bp_fields_precision == BP_FIELDS_SINGLE && sizeof(bp_element) == sizeof(std::complex<float>))
+      bp_fields_precision = BP_FIELDS_FULL;
     // store nbpx3 history of weights and factors in circular buffer
     int cnt            = 0;
     data_displ[FIELDS] = cnt;
-    cnt += nbp * nCV;
+    cnt += nbp * fieldRowsPerStep();
     data_displ[WEIGHT_FAC] = cnt;
     cnt += wlk_desc[6];
     data_displ[WEIGHT_HISTORY] = cnt;
     cnt += wlk_desc[6];
-    bp_walker_size = cnt;
+    bp_walker_size         = cnt;
+    bp_walker_memory_usage = bp_walker_size * sizeof(bp_element);
     if (std::get<0>(bp_buffer.sizes()) != bp_walker_size)
     {
       bp_buffer.reextent({bp_walker_size, std::get<0>(walker_buffer.sizes())});
@@ -340,6 +348,19 @@ public:
       fill_n(bp_buffer.origin() + data_displ[WEIGHT_FAC] * std::get<1>(bp_buffer.sizes()),
              wlk_desc[6] * std::get<1>(bp_buffer.sizes()), bp_element(1.0));
     }
+    resize_fields_stage();
+    std::string precision = "full";
+    if (bp_fields_precision == BP_FIELDS_HALF)
+      precision = "half";
+    else if (bp_fields_precision == BP_FIELDS_SINGLE)
+      precision = "single";
+    app_log() << " Back propagation history: " << nbp << " steps of " << nCV << " fields stored in " << precision
+              << " precision.\n"
+              << "   Memory per walker: " << double(bp_walker_memory_usage) / 1024.0 / 1024.0 << " MB, fields "
+              << double(nbp * fieldRowsPerStep() * sizeof(bp_element)) / 1024.0 / 1024.0 << " MB \n"
+              << "   Memory for " << std::get<1>(bp_buffer.sizes()) << " walkers: "
+              << double(bp_buffer.num_elements() + fields_stage.num_elements()) * sizeof(bp_element) / 1024.0 / 1024.0
+              << " MB \n";
     if (nbp > 0 && (data_displ[SMN] < 0 || data_displ[SM_AUX] < 0))
     {
       auto sz(walker_size);
@@ -681,21 +702,69 @@ public:
     TG.TG_local().barrier();
   }
 
+  /*
+   * True if the fields history is stored in reduced precision.
+   * In this case the fields of a step are written to and read from a full precision staging matrix,
+   * see getFields(ip), packFields and unpackFields.
+   */
+  bool compactFields() const { return bp_fields_precision != BP_FIELDS_FULL; }
+
   // Careful!!! This matrix returns an array_ref, NOT a copy!!!
+  // With compact fields, this is the staging matrix and packFields(ip) must be called after writing it.
   stdCMatrix_ptr getFields(int ip)
   {
     if (ip < 0 || ip > wlk_desc[3])
       APP_ABORT(" Error: index out of bounds in getFields. \n");
+    if (compactFields())
+      return stdCMatrix_ptr(to_address(fields_stage.origin()), {wlk_desc[4], std::get<1>(fields_stage.sizes())});
     int skip = (data_displ[FIELDS] + ip * wlk_desc[4]) * std::get<1>(bp_buffer.sizes());
     return stdCMatrix_ptr(to_address(bp_buffer.origin()) + skip, {wlk_desc[4], std::get<1>(bp_buffer.sizes())});
   }
 
+  // Only available with full precision fields, use unpackFields(ip) otherwise.
   stdCTensor_ptr getFields()
   {
+    if (compactFields())
+      APP_ABORT(" Error: getFields() is not available with compact fields, use unpackFields(ip). \n");
     return stdCTensor_ptr(to_address(bp_buffer.origin()) + data_displ[FIELDS] * std::get<1>(bp_buffer.sizes()),
                           {wlk_desc[3], wlk_desc[4], std::get<1>(bp_buffer.sizes())});
   }
 
+  /*
+   * Stores the staging matrix returned by getFields(ip) into the history at step ip.
+   * Does nothing with full precision fields. Otherwise it must be called by all cores in TG_local.
+   */
+  void packFields(int ip)
+  {
+    if (!compactFields())
+      return;
+    TG.TG_local().barrier();
+    if (bp_fields_precision == BP_FIELDS_HALF)
+      packFieldsImpl<ma::half_complex>(ip);
+    else
+      packFieldsImpl<std::complex<float>>(ip);
+    TG.TG_local().barrier();
+  }
+
+  /*
+   * Returns the fields of step ip in full precision.
+   * With compact fields, the history is expanded into the staging matrix, which is only valid until
+   * the next call to getFields(ip) or unpackFields. Must then be called by all cores in TG_local.
+   */
+  stdCMatrix_ptr unpackFields(int ip)
+  {
+    if (ip < 0 || ip > wlk_desc[3])
+      APP_ABORT(" Error: index out of bounds in unpackFields. \n");
+    if (!compactFields())
+      return getFields(ip);
+    if (bp_fields_precision == BP_FIELDS_HALF)
+      unpackFieldsImpl<ma::half_complex>(ip);
+    else
+      unpackFieldsImpl<std::complex<float>>(ip);
+    TG.TG_local().barrier();
+    return getFields(ip);
+  }
+
   template<class Mat>
   void storeFields(int ip, Mat&& V)
   {
@@ -708,6 +777,7 @@ public:
     }
     else
       F = V;
+    packFields(ip);
   }
 
   stdCMatrix_ptr getWeightFactors()
@@ -779,6 +849,85 @@ protected:
   // Contains stack of fields and slater matrix references for back propagation
   BPCMatrix bp_buffer;
 
+  // Full precision fields of one step, only used with compact fields
+  BPCMatrix fields_stage;
+
+  // Precision of the fields stored in bp_buffer
+  BP_FIELDS_PRECISION bp_fields_precision;
+
+  // Number of fields packed into one element of bp_buffer
+  int fieldsPerElement() const
+  {
+    if (bp_fields_precision == BP_FIELDS_HALF)
+      return sizeof(bp_element) / sizeof(ma::half_complex);
+    if (bp_fields_precision == BP_FIELDS_SINGLE)
+      return sizeof(bp_element) / sizeof(std::complex<float>);
+    return 1;
+  }
+
+  // Number of rows of bp_buffer used by the fields of one step
+  int fieldRowsPerStep() const { return (wlk_desc[4] + fieldsPerElement() - 1) / fieldsPerElement(); }
+
+  void resize_fields_stage()
+  {
+    if (!compactFields() || wlk_desc[3] == 0)
+      return;
+    if (std::get<0>(fields_stage.sizes()) != wlk_desc[4] ||
+        std::get<1>(fields_stage.sizes()) != std::get<1>(bp_buffer.sizes()))
+      fields_stage.reextent({wlk_desc[4], std::get<1>(bp_buffer.sizes())});
+  }
+
+  /*
+   * The fields of a walker are packed along its column of bp_buffer,
+   * row r of step ip holds the fields r*npack to (r+1)*npack-1.
+   * Cores in TG_local work on disjoint sets of rows.
+   */
+  template<class Stored>
+  void packFieldsImpl(int ip)
+  {
+    constexpr int npack = sizeof(bp_element) / sizeof(Stored);
+    static_assert(npack * sizeof(Stored) == sizeof(bp_element), "Stored fields must tile bp_element");
+    const int nCV  = wlk_desc[4];
+    const int ncol = std::get<1>(bp_buffer.sizes());
+    const int nrow = fieldRowsPerStep();
+    int r0, rN;
+    std::tie(r0, rN) = FairDivideBoundary(TG.getLocalTGRank(), nrow, TG.getNCoresPerTG());
+    const bp_element* stage = to_address(fields_stage.origin());
+    bp_element* history     = to_address(bp_buffer.origin()) + (data_displ[FIELDS] + ip * nrow) * ncol;
+    Stored packed[npack];
+    for (int r = r0; r < rN; r++)
+      for (int iw = 0; iw < ncol; iw++)
+      {
+        for (int k = 0, cv = r * npack; k < npack; k++, cv++)
+          if (cv < nCV)
+            ma::narrow(stage[cv * ncol + iw], packed[k]);
+          else
+            packed[k] = Stored{};
+        std::memcpy(history + r * ncol + iw, packed, sizeof(bp_element));
+      }
+  }
+
+  template<class Stored>
+  void unpackFieldsImpl(int ip)
+  {
+    constexpr int npack = sizeof(bp_element) / sizeof(Stored);
+    const int nCV       = wlk_desc[4];
+    const int ncol      = std::get<1>(bp_buffer.sizes());
+    const int nrow      = fieldRowsPerStep();
+    int r0, rN;
+    std::tie(r0, rN) = FairDivideBoundary(TG.getLocalTGRank(), nrow, TG.getNCoresPerTG());
+    bp_element* stage         = to_address(fields_stage.origin());
+    const bp_element* history = to_address(bp_buffer.origin()) + (data_displ[FIELDS] + ip * nrow) * ncol;
+    Stored packed[npack];
+    for (int r = r0; r < rN; r++)
+      for (int iw = 0; iw < ncol; iw++)
+      {
+        std::memcpy(packed, history + r * ncol + iw, sizeof(bp_element));
+        for (int k = 0, cv = r * npack; k < npack && cv < nCV; k++, cv++)
+          ma::widen(packed[k], stage[cv * ncol + iw]);
+      }
+  }
+
   // reads xml and performs setup
   void parse(xmlNodePtr cur);
 
@@ -503,6 +503,85 @@ void test_walker_io(std::string wtype)
     remove("dummy_walkers.h5");
 }
 
+void test_bp_fields(std::string precision)
+{
+  auto world = boost::mpi3::environment::get_world_instance();
+  auto node  = world.split_shared(world.rank());
+
+#if defined(ENABLE_CUDA) || defined(ENABLE_HIP)
+  arch::INIT(node);
+#endif
+
+  using Type = std::complex<double>;
+
+  int NMO = 8, NAEA = 2, NAEB = 2, nwalkers = 5;
+  int nbp = 3, nCV = 7;
+
+  GlobalTaskGroup gTG(world);
+  TaskGroup_ TG(gTG, std::string("TaskGroup"), 1, gTG.getTotalCores());
+  AFQMCInfo info;
+  info.NMO  = NMO;
+  info.NAEA = NAEA;
+  info.NAEB = NAEB;
+  info.name = "walker";
+  boost::multi::array<Type, 2> initA({NMO, NAEA});
+  boost::multi::array<Type, 2> initB({NMO, NAEB});
+  for (int i = 0; i < NAEA; i++)
+    initA[i][i] = Type(0.22);
+  for (int i = 0; i < NAEB; i++)
+    initB[i][i] = Type(0.22);
+  RandomGenerator rng;
+
+  std::string xml_block;
+  xml_block = "<WalkerSet name=\"wset0\">  \
+  <parameter name=\"walker_type\">collinear</parameter>  \
+  <parameter name=\"bp_fields_precision\">" +
+      precision + "</parameter>  \
+</WalkerSet> \
+";
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(xml_block.c_str());
+  REQUIRE(okay);
+
+  WalkerSet wset(TG, doc.getRoot(), info, rng);
+  wset.resize(nwalkers, initA, initB);
+  wset.resize_bp(nbp, nCV, 1);
+  REQUIRE(wset.NumBackProp() == nbp);
+  REQUIRE(wset.NumCholVecs() == nCV);
+
+  // fields of one step per element of the history
+  int npack = 1;
+  if (precision == "half")
+    npack = sizeof(SPComplexType) / (2 * sizeof(uint16_t));
+  else if (precision == "single")
+    npack = sizeof(SPComplexType) / sizeof(std::complex<float>);
+  REQUIRE(wset.compactFields() == (npack > 1));
+  REQUIRE(wset.single_walker_bp_size() == nbp * ((nCV + npack - 1) / npack) + 2 * 3 * nbp);
+
+  auto field = [](int ip, int cv, int iw) { return Type(0.1 * (cv + 1) - 0.3 * ip, 0.05 * iw - 0.02 * cv); };
+  for (int ip = 0; ip < nbp; ip++)
+  {
+    auto&& V(*wset.getFields(ip));
+    for (int cv = 0; cv < nCV; cv++)
+      for (int iw = 0; iw < nwalkers; iw++)
+        V[cv][iw] = field(ip, cv, iw);
+    wset.packFields(ip);
+  }
+  const double eps = (precision == "half") ? 1e-3 : 1e-6;
+  for (int ip = 0; ip < nbp; ip++)
+  {
+    auto&& F(*wset.unpackFields(ip));
+    for (int cv = 0; cv < nCV; cv++)
+      for (int iw = 0; iw < nwalkers; iw++)
+      {
+        CHECK(std::real(F[cv][iw]) == Approx(std::real(field(ip, cv, iw))).epsilon(eps).margin(eps));
+        CHECK(std::imag(F[cv][iw]) == Approx(std::imag(field(ip, cv, iw))).epsilon(eps).margin(eps));
+      }
+    // the staging matrix is overwritten by the next unpackFields
+    TG.TG_local().barrier();
+  }
+}
+
 TEST_CASE("swset_test_serial", "[shared_wset]")
 {
   test_basic_walker_features(true, "closed");
@@ -512,6 +591,13 @@ TEST_CASE("swset_test_serial", "[shared_wset]")
   test_basic_walker_features(true, "noncollinear");
   test_basic_walker_features(false, "noncollinear");
 }
+TEST_CASE("bp_fields_precision", "[shared_wset]")
+{
+  test_bp_fields("full");
+  test_bp_fields("single");
+  test_bp_fields("half");
+}
+
 /*
 TEST_CASE("hyperslab_tests", "[shared_wset]")
 {
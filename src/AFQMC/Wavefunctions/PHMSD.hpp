@@ -172,6 +172,7 @@ public:
 
     excitedState = false;
     std::string excited_file("");
+    std::string group_excitations("no");
     int i_ = -1, a_ = -1;
     ParameterSet m_param;
     m_param.add(number_of_references, "number_of_references");
@@ -180,8 +181,18 @@ public:
     // generalize this to multi-particle excitations, how do I read a list of integers???
     m_param.add(i_, "i");
     m_param.add(a_, "a");
+    m_param.add(group_excitations, "group_excitations");
     m_param.put(cur);
 
+    std::transform(group_excitations.begin(), group_excitations.end(), group_excitations.begin(),
+                   (int (*)(int))tolower);
+    if (group_excitations == "yes" || group_excitations == "true")
+    {
+      excitation_groups = ph_excitation_groups(abij);
+      app_log() << " Grouping unique excitations of order >= " << ph_excitation_groups::min_order
+                << " by their leading sub-excitation: " << excitation_groups.number_of_groups() << " groups. \n";
+    }
+
     if (excited_file != "" && i_ >= 0 && a_ >= 0)
     {
       if (i_ < NMO && a_ < NMO)
@@ -563,6 +574,9 @@ protected:
 
   ph_excitations<int, ComplexType> abij;
 
+  // unique excitations grouped by leading sub-excitation, empty unless group_excitations=yes
+  ph_excitation_groups excitation_groups;
+
   // eventually switched from CMatrix to SMHSparseMatrix(node)
   std::vector<PsiT_Matrix> OrbMats;
   mpi3CMatrix RefOrbMats;
@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_AFQMC_PH_EXCITATION_GROUPS_HPP
+#define QMCPLUSPLUS_AFQMC_PH_EXCITATION_GROUPS_HPP
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <vector>
+
+namespace qmcplusplus
+{
+namespace afqmc
+{
+/*
+ * Groups the unique particle-hole excitations of a ph_excitations object by their
+ * leading sub-excitation. An excitation of order n, stored as {h_0..h_{n-1}, p_0..p_{n-1}},
+ * is placed in the group of {h_0..h_{n-2}, p_0..p_{n-2}} and only its last hole and particle
+ * are stored. Groups are sorted by their sub-excitation, members keep their original order.
+ *
+ * The determinant of all members of a group share the leading (n-1)x(n-1) block,
+ * which is inverted once per group. Each member then costs O(n^2) through the Schur complement
+ * of the block instead of O(n^3) for a full determinant or inverse.
+ * Only excitation orders >= min_order are grouped, lower orders use closed form expressions.
+ */
+class ph_excitation_groups
+{
+public:
+  static constexpr int min_order = 4;
+  // groups whose leading block has |det(A11)| below this fraction of its Hadamard bound are evaluated directly
+  static constexpr double min_relative_det = 1e-6;
+
+  struct order_groups
+  {
+    // leading sub-excitation of each group, 2*(n-1) entries per group
+    std::vector<int> prefix;
+    // members of group g are in [offsets[g],offsets[g+1])
+    std::vector<int> offsets;
+    // index of the member in the list of unique excitations of this spin
+    std::vector<int> index;
+    // last hole and particle of each member
+    std::vector<int> last;
+
+    int number_of_groups() const { return int(offsets.size()) - 1; }
+  };
+
+  ph_excitation_groups() = default;
+
+  template<class PH_EXCT>
+  ph_excitation_groups(PH_EXCT const& abij)
+  {
+    for (int spin = 0; spin < 2; spin++)
+    {
+      int nmax = abij.maximum_excitation_number()[spin];
+      groups[spin].resize(std::max(nmax, 0));
+      for (int n = min_order; n < nmax; n++)
+      {
+        std::map<std::vector<int>, std::vector<int>> prefix_to_members;
+        int nd = int(abij.number_of_unique_smaller_than(n)[spin]);
+        std::vector<int> key(2 * (n - 1));
+        for (auto it = abij.unique_begin(n)[spin]; it < abij.unique_end(n)[spin]; ++it, ++nd)
+        {
+          auto e = *it;
+          std::copy_n(e, n - 1, key.begin());
+          std::copy_n(e + n, n - 1, key.begin() + n - 1);
+          auto& members = prefix_to_members[key];
+          members.push_back(nd);
+          members.push_back(e[n - 1]);
+          members.push_back(e[2 * n - 1]);
+        }
+        auto& g = groups[spin][n];
+        g.offsets.reserve(prefix_to_members.size() + 1);
+        g.offsets.push_back(0);
+        for (auto& pm : prefix_to_members)
+        {
+          g.prefix.insert(g.prefix.end(), pm.first.begin(), pm.first.end());
+          for (int i = 0; i < pm.second.size(); i += 3)
+          {
+            g.index.push_back(pm.second[i]);
+            g.last.push_back(pm.second[i + 1]);
+            g.last.push_back(pm.second[i + 2]);
+          }
+          g.offsets.push_back(int(g.index.size()));
+        }
+        number_of_groups_ += g.number_of_groups();
+      }
+    }
+  }
+
+  bool empty() const { return number_of_groups_ == 0; }
+
+  size_t number_of_groups() const { return number_of_groups_; }
+
+  // groups of excitations of order n, nullptr if order n is not grouped
+  order_groups const* get(int spin, int n) const
+  {
+    if (n < min_order || n >= groups[spin].size() || groups[spin][n].offsets.empty())
+      return nullptr;
+    return &groups[spin][n];
+  }
+
+private:
+  std::array<std::vector<order_groups>, 2> groups;
+  size_t number_of_groups_ = 0;
+};
+
+} // namespace afqmc
+} // namespace qmcplusplus
+
+#endif
@@ -19,6 +19,7 @@
 #include "AFQMC/config.h"
 #include "AFQMC/Numerics/ma_operations.hpp"
 #include "AFQMC/Numerics/ma_small_mat_ops.hpp"
+#include "AFQMC/Wavefunctions/ph_excitation_groups.hpp"
 
 namespace qmcplusplus
 {
@@ -28,14 +29,181 @@ namespace afqmc
 // it is probably easier to have 2 types of kernels, one that loads the
 // appropriate terms in the matrices and a second one that just computes determinants
 
+// A[p][q] = T[particles[p]][holes[q]] for an excitation of order n
+template<class MatA, class MatQ>
+inline void ph_excitation_matrix(MatA const& T, int n, int const* holes, int const* particles, MatQ&& Q)
+{
+  for (int p = 0; p < n; p++)
+    for (int q = 0; q < n; q++)
+      Q[p][q] = T[particles[p]][holes[q]];
+}
+
+// determinant of A[p][q] = T[particles[p]][holes[q]], n >= 4
+template<class MatA, class MatQ, class Array1D>
+inline ComplexType ph_determinant(MatA const& T,
+                                  int n,
+                                  int const* h,
+                                  int const* p,
+                                  MatQ&& Q,
+                                  std::vector<int>& IWORK,
+                                  Array1D&& WORK)
+{
+  if (n == 4)
+    return ma::D4x4(T[p[0]][h[0]], T[p[0]][h[1]], T[p[0]][h[2]], T[p[0]][h[3]], T[p[1]][h[0]], T[p[1]][h[1]],
+                    T[p[1]][h[2]], T[p[1]][h[3]], T[p[2]][h[0]], T[p[2]][h[1]], T[p[2]][h[2]], T[p[2]][h[3]],
+                    T[p[3]][h[0]], T[p[3]][h[1]], T[p[3]][h[2]], T[p[3]][h[3]]);
+  else if (n == 5)
+    return ma::D5x5(T[p[0]][h[0]], T[p[0]][h[1]], T[p[0]][h[2]], T[p[0]][h[3]], T[p[0]][h[4]], T[p[1]][h[0]],
+                    T[p[1]][h[1]], T[p[1]][h[2]], T[p[1]][h[3]], T[p[1]][h[4]], T[p[2]][h[0]], T[p[2]][h[1]],
+                    T[p[2]][h[2]], T[p[2]][h[3]], T[p[2]][h[4]], T[p[3]][h[0]], T[p[3]][h[1]], T[p[3]][h[2]],
+                    T[p[3]][h[3]], T[p[3]][h[4]], T[p[4]][h[0]], T[p[4]][h[1]], T[p[4]][h[2]], T[p[4]][h[3]],
+                    T[p[4]][h[4]]);
+  ph_excitation_matrix(T, n, h, p, Q);
+  return ma::determinant<ComplexType>(Q, IWORK, WORK, 0.0);
+}
+
+// Q = A^{-1} with A[p][q] = T[particles[p]][holes[q]], returns det(A)
+template<class MatA, class MatQ>
+inline ComplexType ph_inverse(MatA const& T,
+                              int n,
+                              int const* h,
+                              int const* p,
+                              MatQ&& Q,
+                              std::vector<int>& IWORK,
+                              std::vector<ComplexType>& WORK)
+{
+  if (n == 1)
+  {
+    ComplexType ov_a = T[p[0]][h[0]];
+    Q[0][0]          = 1.0 / ov_a;
+    return ov_a;
+  }
+  else if (n == 2)
+    return ma::I2x2(T[p[0]][h[0]], T[p[0]][h[1]], T[p[1]][h[0]], T[p[1]][h[1]], Q);
+  else if (n == 3)
+    return ma::I3x3(T[p[0]][h[0]], T[p[0]][h[1]], T[p[0]][h[2]], T[p[1]][h[0]], T[p[1]][h[1]], T[p[1]][h[2]],
+                    T[p[2]][h[0]], T[p[2]][h[1]], T[p[2]][h[2]], Q);
+  ph_excitation_matrix(T, n, h, p, Q);
+  return ma::invert<ComplexType>(Q, IWORK, WORK, 0.0);
+}
+
+/*
+ * Inverse B of the leading block A11 shared by a group of excitations of order n, see ph_excitation_groups.
+ * Returns det(A11), or 0 if A11 is too close to singular for the Schur complement
+ * to be accurate, in which case the members of the group must be evaluated directly.
+ */
+template<class MatA, class MatQ>
+inline ComplexType ph_group_inverse(MatA const& T,
+                                    int n,
+                                    int const* prefix,
+                                    MatQ&& B,
+                                    std::vector<int>& IWORK,
+                                    std::vector<ComplexType>& WORK)
+{
+  int m = n - 1;
+  // Hadamard bound of det(A11)
+  double hadamard = 1.0;
+  for (int p = 0; p < m; p++)
+  {
+    double nrm = 0.0;
+    for (int q = 0; q < m; q++)
+      nrm += std::norm(T[prefix[m + p]][prefix[q]]);
+    hadamard *= std::sqrt(nrm);
+  }
+  ComplexType det = ph_inverse(T, m, prefix, prefix + m, B, IWORK, WORK);
+  if (std::abs(det) <= ph_excitation_groups::min_relative_det * hadamard)
+    return ComplexType(0.0);
+  return det;
+}
+
+/*
+ * Schur complement s = a22 - a21 B a12 of the member {hl,pl} of a group with leading block inverse B,
+ * the determinant of the member is det(A11) * s. Bu = B a12 on output.
+ */
+template<class MatA, class MatQ>
+inline ComplexType ph_group_schur(MatA const& T,
+                                  int m,
+                                  int const* prefix,
+                                  int hl,
+                                  int pl,
+                                  MatQ const& B,
+                                  ComplexType* Bu)
+{
+  ComplexType s = T[pl][hl];
+  for (int q = 0; q < m; q++)
+  {
+    ComplexType bu(0.0);
+    for (int p = 0; p < m; p++)
+      bu += B[q][p] * T[prefix[m + p]][hl];
+    Bu[q] = bu;
+    s -= T[pl][prefix[q]] * bu;
+  }
+  return s;
+}
+
 // using simple round-robin scheme for parallelization within TG_local
 // assumes that reference determinant is already on [0]
 template<class Array1D, class MatA, class MatB, class PH_EXCT>
 inline void calculate_overlaps(int rank, int ngrp, int spin, PH_EXCT const& abij, MatA&& T, MatB&& Qwork, Array1D&& ov)
 {
-  std::vector<int> IWORK(abij.maximum_excitation_number()[spin]);
-  for (int nex = 1, nd = 1; nex < abij.maximum_excitation_number()[spin]; nex++)
+  calculate_overlaps(rank, ngrp, spin, abij, ph_excitation_groups{}, T, Qwork, ov);
+}
+
+/*
+ * As above, excitation orders grouped in groups are evaluated group by group,
+ * using the inverse of the leading block shared by all the members of a group.
+ */
+template<class Array1D, class MatA, class MatB, class PH_EXCT>
+inline void calculate_overlaps(int rank,
+                               int ngrp,
+                               int spin,
+                               PH_EXCT const& abij,
+                               ph_excitation_groups const& groups,
+                               MatA&& T,
+                               MatB&& Qwork,
+                               Array1D&& ov)
+{
+  const int nmax = abij.maximum_excitation_number()[spin];
+  std::vector<int> IWORK(nmax + 1);
+  std::vector<int> ex(2 * nmax);
+  std::vector<ComplexType> WORK(nmax * nmax);
+  std::vector<ComplexType> Bbuff(nmax * nmax + nmax);
+  for (int nex = 1, nd = 1; nex < nmax; nex++)
   {
+    if (auto grp = groups.get(spin, nex))
+    {
+      int m = nex - 1;
+      boost::multi::array_ref<ComplexType, 2> B(Bbuff.data(), {m, m});
+      ComplexType* Bu = Bbuff.data() + m * m;
+      boost::multi::array_ref<ComplexType, 2> Qwork_(Qwork.origin(), {nex, nex});
+      boost::multi::array_ref<ComplexType, 1> Qwork2_(Qwork.origin() + Qwork_.num_elements(),
+                                                      iextensions<1u>{nex * nex});
+      for (int g = 0; g < grp->number_of_groups(); g++)
+        if (g % ngrp == rank)
+        {
+          int const* prefix = grp->prefix.data() + 2 * m * g;
+          ComplexType det11 = ph_group_inverse(T, nex, prefix, B, IWORK, WORK);
+          for (int i = grp->offsets[g]; i < grp->offsets[g + 1]; i++)
+          {
+            int hl = grp->last[2 * i], pl = grp->last[2 * i + 1];
+            ComplexType s(0.0);
+            if (det11 != ComplexType(0.0))
+              s = ph_group_schur(T, m, prefix, hl, pl, B, Bu);
+            if (s != ComplexType(0.0))
+              ov[grp->index[i]] = det11 * s;
+            else
+            {
+              std::copy_n(prefix, m, ex.begin());
+              std::copy_n(prefix + m, m, ex.begin() + nex);
+              ex[m]       = hl;
+              ex[nex + m] = pl;
+              ov[grp->index[i]] = ph_determinant(T, nex, ex.data(), ex.data() + nex, Qwork_, IWORK, Qwork2_);
+            }
+          }
+        }
+      nd += abij.number_of_unique_excitations(nex)[spin];
+      continue;
+    }
     // expanding some of them by hand for efficiency
     if (nex == 1)
     {
@@ -106,6 +274,53 @@ inline void calculate_overlaps(int rank, int ngrp, int spin, PH_EXCT const& abij
   }
 }
 
+// sum of the coefficients times the overlaps of the opposite spin of the configurations coupled to excitation nd
+template<class Array1D, class PH_EXCT, class index_aos>
+inline ComplexType ph_coupled_weight(int spin, PH_EXCT const& abij, index_aos& couplings, int nd, Array1D const& ov)
+{
+  using std::get;
+  auto confgs = abij.configurations_begin();
+  ComplexType w(0.0);
+  auto it  = to_address(couplings.values()) + (*couplings.pointers_begin(nd));
+  auto ite = to_address(couplings.values()) + (*couplings.pointers_end(nd));
+  if (spin == 0)
+    for (; it < ite; ++it)
+      w += ma::conj(get<2>(*(confgs + (*it)))) * ov[get<1>(*(confgs + (*it)))];
+  else
+    for (; it < ite; ++it)
+      w += ma::conj(get<2>(*(confgs + (*it)))) * ov[get<0>(*(confgs + (*it)))];
+  return w;
+}
+
+// adds the contribution of excitation e with weight w and inverse Q to R
+template<class MatA, class MatQ, class MatC>
+inline void add_ph_R(ComplexType w,
+                     int nex,
+                     int const* e,
+                     MatQ const& Q,
+                     MatA const& T,
+                     std::vector<int> const& orbs,
+                     MatC& R)
+{
+  int NEL = std::get<1>(T.sizes());
+  // add term coming from identity
+  for (int i = 0; i < NEL; ++i)
+    R[i][orbs[i]] += w;
+  for (int p = 0; p < nex; ++p)
+  {
+    auto Rp = R[e[p]];
+    auto Ip = Q[p];
+    for (int q = 0; q < nex; ++q)
+    {
+      auto Ipq = Ip[q];
+      auto Tq  = T[e[q + nex]];
+      for (int i = 0; i < NEL; ++i)
+        Rp[orbs[i]] -= w * Ipq * Tq[i];
+      Rp[orbs[e[q]]] += w * Ipq;
+    }
+  }
+}
+
 // using simple round-robin scheme for parallelization within TG_local
 // assumes that reference determinant is already on [0]
 template<class Array1D, class MatA, class MatB, class MatC, class PH_EXCT, class index_aos>
@@ -120,12 +335,32 @@ inline void calculate_R(int rank,
                         ComplexType ov0,
                         MatC& R)
 {
-  using ma::conj;
-  using std::get;
-  std::vector<int> IWORK(abij.maximum_excitation_number()[spin]);
-  std::vector<ComplexType> WORK(abij.maximum_excitation_number()[spin] * abij.maximum_excitation_number()[spin]);
-  auto confgs = abij.configurations_begin();
-  auto refc   = abij.reference_configuration(spin);
+  calculate_R(rank, ngrp, spin, abij, ph_excitation_groups{}, couplings, T, Qwork, ov, ov0, R);
+}
+
+/*
+ * As above, the inverses of the excitations of orders grouped in groups are obtained
+ * from the inverse of the leading block of their group by a rank one bordering.
+ */
+template<class Array1D, class MatA, class MatB, class MatC, class PH_EXCT, class index_aos>
+inline void calculate_R(int rank,
+                        int ngrp,
+                        int spin,
+                        PH_EXCT const& abij,
+                        ph_excitation_groups const& groups,
+                        index_aos& couplings,
+                        MatA&& T,
+                        MatB&& Qwork,
+                        Array1D&& ov,
+                        ComplexType ov0,
+                        MatC& R)
+{
+  const int nmax = abij.maximum_excitation_number()[spin];
+  std::vector<int> IWORK(nmax + 1);
+  std::vector<ComplexType> WORK(nmax * nmax);
+  std::vector<ComplexType> Bbuff(nmax * nmax + 2 * nmax);
+  std::vector<int> ex(2 * nmax);
+  auto refc = abij.reference_configuration(spin);
   for (int i = 0; i < std::get<0>(R.sizes()); i++)
     std::fill_n(R[i].origin(), std::get<1>(R.sizes()), ComplexType(0));
   int NEL = std::get<1>(T.sizes());
@@ -134,84 +369,98 @@ inline void calculate_R(int rank,
   // add reference contribution!!!
   if (rank == 0)
   {
-    ComplexType w(0.0);
-    auto it  = to_address(couplings.values()) + (*couplings.pointers_begin(0));
-    auto ite = to_address(couplings.values()) + (*couplings.pointers_end(0));
-    if (spin == 0)
-      for (; it < ite; ++it)
-        w += ma::conj(get<2>(*(confgs + (*it)))) * ov[get<1>(*(confgs + (*it)))];
-    else
-      for (; it < ite; ++it)
-        w += ma::conj(get<2>(*(confgs + (*it)))) * ov[get<0>(*(confgs + (*it)))];
+    ComplexType w = ph_coupled_weight(spin, abij, couplings, 0, ov);
     w *= ov0;
     // Wrong if NAEB < NAEA!!! FIX FIX FIX
     for (int i = 0; i < NEL; ++i)
       R[i][refc[i]] += w;
   }
-  for (int nex = 1, nd = 1; nex < abij.maximum_excitation_number()[spin]; nex++)
+  for (int nex = 1, nd = 1; nex < nmax; nex++)
   {
     boost::multi::array_ref<ComplexType, 2> Q(Qwork.origin(), {nex, nex});
+    if (auto grp = groups.get(spin, nex))
+    {
+      int m = nex - 1;
+      boost::multi::array_ref<ComplexType, 2> B(Bbuff.data(), {m, m});
+      ComplexType* Bu = Bbuff.data() + m * m;
+      ComplexType* vB = Bu + m;
+      for (int g = 0; g < grp->number_of_groups(); g++)
+        if (g % ngrp == rank)
+        {
+          int const* prefix = grp->prefix.data() + 2 * m * g;
+          ComplexType det11(0.0);
+          bool have_inverse = false;
+          for (int i = grp->offsets[g]; i < grp->offsets[g + 1]; i++)
+          {
+            ComplexType w = ph_coupled_weight(spin, abij, couplings, grp->index[i], ov);
+            if (w == ComplexType(0.0))
+              continue;
+            int hl = grp->last[2 * i], pl = grp->last[2 * i + 1];
+            std::copy_n(prefix, m, ex.begin());
+            std::copy_n(prefix + m, m, ex.begin() + nex);
+            ex[m]       = hl;
+            ex[nex + m] = pl;
+            if (not have_inverse)
+            {
+              det11        = ph_group_inverse(T, nex, prefix, B, IWORK, WORK);
+              have_inverse = true;
+            }
+            ComplexType s(0.0);
+            if (det11 != ComplexType(0.0))
+              s = ph_group_schur(T, m, prefix, hl, pl, B, Bu);
+            if (s != ComplexType(0.0))
+            {
+              // bordered inverse, Q = [[B + Bu vB / s, -Bu / s], [-vB / s, 1 / s]]
+              for (int p = 0; p < m; p++)
+              {
+                ComplexType vb(0.0);
+                for (int q = 0; q < m; q++)
+                  vb += T[pl][prefix[q]] * B[q][p];
+                vB[p] = vb;
+              }
+              ComplexType sinv = ComplexType(1.0) / s;
+              for (int q = 0; q < m; q++)
+              {
+                for (int p = 0; p < m; p++)
+                  Q[q][p] = B[q][p] + Bu[q] * vB[p] * sinv;
+                Q[q][m] = -Bu[q] * sinv;
+                Q[m][q] = -vB[q] * sinv;
+              }
+              Q[m][m] = sinv;
+              ov_a    = det11 * s;
+            }
+            else
+              ov_a = ph_inverse(T, nex, ex.data(), ex.data() + nex, Q, IWORK, WORK);
+            w *= ov_a * ov0;
+            if (std::abs(w) > 1e-10)
+            {
+              abij.get_configuration(spin, grp->index[i], orbs);
+              add_ph_R(w, nex, ex.data(), Q, T, orbs, R);
+            }
+          }
+        }
+      nd += abij.number_of_unique_excitations(nex)[spin];
+      continue;
+    }
     for (auto it = abij.unique_begin(nex)[spin]; it < abij.unique_end(nex)[spin]; ++it, ++nd)
     {
       if (nd % ngrp == rank)
       {
         auto e = *it;
-        abij.get_configuration(spin, nd, orbs);
-        if (nex == 1)
-        {
-          ov_a    = T[*((*it) + 1)][*(*it)];
-          Q[0][0] = 1.0 / ov_a;
-        }
-        else if (nex == 2)
-        {
-          ov_a = ma::I2x2(T[e[2]][e[0]], T[e[2]][e[1]], T[e[3]][e[0]], T[e[3]][e[1]], Q);
-        }
-        else if (nex == 3)
-        {
-          ov_a = ma::I3x3(T[e[3]][e[0]], T[e[3]][e[1]], T[e[3]][e[2]], T[e[4]][e[0]], T[e[4]][e[1]], T[e[4]][e[2]],
-                          T[e[5]][e[0]], T[e[5]][e[1]], T[e[5]][e[2]], Q);
-        }
-        else
-        {
-          for (int p = 0; p < nex; p++)
-            for (int q = 0; q < nex; q++)
-              Q[p][q] = T[e[p + nex]][e[q]];
-          ov_a = ma::invert<ComplexType>(Q, IWORK, WORK, 0.0);
-        }
-        ComplexType w(0.0);
-        auto it  = to_address(couplings.values()) + (*couplings.pointers_begin(nd));
-        auto ite = to_address(couplings.values()) + (*couplings.pointers_end(nd));
-        if (spin == 0)
-          for (; it < ite; ++it)
-            w += ma::conj(get<2>(*(confgs + (*it)))) * ov[get<1>(*(confgs + (*it)))];
-        else
-          for (; it < ite; ++it)
-            w += ma::conj(get<2>(*(confgs + (*it)))) * ov[get<0>(*(confgs + (*it)))];
+        ov_a   = ph_inverse(T, nex, e, e + nex, Q, IWORK, WORK);
+        ComplexType w = ph_coupled_weight(spin, abij, couplings, nd, ov);
         w *= ov_a * ov0;
         if (std::abs(w) > 1e-10)
         {
-          // add term coming from identity
-          for (int i = 0; i < NEL; ++i)
-            R[i][orbs[i]] += w;
-          for (int p = 0; p < nex; ++p)
-          {
-            auto Rp = R[e[p]];
-            auto Ip = Q[p];
-            for (int q = 0; q < nex; ++q)
-            {
-              auto Ipq = Ip[q];
-              auto Tq  = T[e[q + nex]];
-              for (int i = 0; i < NEL; ++i)
-                Rp[orbs[i]] -= w * Ipq * Tq[i];
-              Rp[orbs[e[q]]] += w * Ipq;
-            }
-          }
+          abij.get_configuration(spin, nd, orbs);
+          add_ph_R(w, nex, e, Q, T, orbs, R);
         }
       }
     }
   }
 }
 
+// disabled draft, its body and its only call in THCOps::fast_energy are commented out
 template<class MatE, class MatO, class MatQ, class MatB, class MatT, class MatP, class index_aos>
 void calculate_ph_energies_v1(int spin,
                               int rank,
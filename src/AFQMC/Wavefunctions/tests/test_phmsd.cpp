@@ -35,8 +35,12 @@
 #include <iomanip>
 #include <random>
 #include <algorithm>
+#include <fstream>
+#include <numeric>
 
 #include "AFQMC/Wavefunctions/Excitations.hpp"
+#include "AFQMC/Wavefunctions/ph_excitation_groups.hpp"
+#include "AFQMC/Wavefunctions/phmsd_helpers.hpp"
 #include "AFQMC/Wavefunctions/WavefunctionFactory.h"
 #include "AFQMC/Hamiltonians/HamiltonianFactory.h"
 #include "AFQMC/Hamiltonians/Hamiltonian.hpp"
@@ -300,6 +304,316 @@ void test_phmsd(boost::mpi3::communicator& world)
   }
 }
 
+// all subsets of k elements of {0..n-1} in lexicographic order
+std::vector<std::vector<int>> getCombinations(int n, int k)
+{
+  std::vector<std::vector<int>> combinations;
+  std::vector<int> c(k);
+  std::iota(c.begin(), c.end(), 0);
+  while (k <= n)
+  {
+    combinations.push_back(c);
+    int i = k - 1;
+    while (i >= 0 && c[i] == n - k + i)
+      i--;
+    if (i < 0)
+      break;
+    c[i]++;
+    for (int j = i + 1; j < k; j++)
+      c[j] = c[j - 1] + 1;
+  }
+  return combinations;
+}
+
+/*
+ * Occupations (0-based, beta shifted by NMO) and coefficients of a multi-determinant expansion
+ * with excitations of up to max_order electrons of each spin out of the aufbau reference.
+ * Only the first max_per_order and the last max_per_order/2 excitations of each order are kept,
+ * the first ones share all but their last particle-hole pair.
+ */
+void getExcitedDeterminants(int NMO,
+                            int NAEA,
+                            int NAEB,
+                            int max_order,
+                            int max_per_order,
+                            std::vector<int>& occs,
+                            std::vector<ComplexType>& coeffs)
+{
+  auto excited_configurations = [&](int nel, int shift) {
+    std::vector<std::vector<int>> configs;
+    for (int n = 1; n <= std::min({max_order, nel, NMO - nel}); n++)
+    {
+      std::vector<std::vector<int>> order_n;
+      for (auto& holes : getCombinations(nel, n))
+        for (auto& particles : getCombinations(NMO - nel, n))
+        {
+          std::vector<int> c;
+          for (int i = 0; i < nel; i++)
+            if (std::find(holes.begin(), holes.end(), i) == holes.end())
+              c.push_back(i + shift);
+          for (int a : particles)
+            c.push_back(nel + a + shift);
+          std::sort(c.begin(), c.end());
+          order_n.push_back(c);
+        }
+      for (int i = 0; i < order_n.size(); i++)
+        if (i < max_per_order || i >= int(order_n.size()) - max_per_order / 2)
+          configs.push_back(order_n[i]);
+    }
+    return configs;
+  };
+  std::vector<int> refa(NAEA), refb(NAEB);
+  std::iota(refa.begin(), refa.end(), 0);
+  std::iota(refb.begin(), refb.end(), NMO);
+  auto alpha = excited_configurations(NAEA, 0);
+  auto beta  = excited_configurations(NAEB, NMO);
+
+  occs.clear();
+  coeffs.clear();
+  auto add = [&](std::vector<int> const& a, std::vector<int> const& b) {
+    occs.insert(occs.end(), a.begin(), a.end());
+    occs.insert(occs.end(), b.begin(), b.end());
+    int nd = coeffs.size();
+    coeffs.push_back(nd == 0 ? ComplexType(1.0) : ComplexType(0.1 * std::cos(0.7 * nd), 0.05 * std::sin(0.3 * nd)));
+  };
+  add(refa, refb);
+  for (auto& a : alpha)
+    add(a, refb);
+  for (auto& b : beta)
+    add(refa, b);
+  for (int i = 0; i < std::min(alpha.size(), beta.size()); i += 5)
+    add(alpha[i], beta[beta.size() - 1 - i]);
+}
+
+/*
+ * Overlaps and R of the excitations grouped by leading sub-excitation against the
+ * ungrouped evaluation, for an expansion with excitations of up to 6 electrons of each spin.
+ */
+void test_phmsd_excitation_groups_kernels(boost::mpi3::communicator& world)
+{
+  auto node = world.split_shared(world.rank());
+  const int NMO = 12, NAEA = 6, NAEB = 6;
+  std::vector<int> buff;
+  std::vector<ComplexType> coeffs;
+  getExcitedDeterminants(NMO, NAEA, NAEB, NAEA, 60, buff, coeffs);
+  const int ndets = coeffs.size();
+  boost::multi::array_ref<int, 2> occs(buff.data(), {ndets, NAEA + NAEB});
+  ph_excitations<int, ComplexType> abij = build_ph_struct(coeffs, occs, ndets, node, NMO, NAEA, NAEB);
+  REQUIRE(abij.number_of_configurations() == ndets);
+
+  ph_excitation_groups groups(abij);
+  for (int spin = 0; spin < 2; spin++)
+    for (int n = ph_excitation_groups::min_order; n <= NAEA; n++)
+    {
+      auto grp = groups.get(spin, n);
+      REQUIRE(grp != nullptr);
+      // groups must have several members to test the bordered inverse, there is a single excitation of order NAEA
+      if (n < NAEA)
+        CHECK(grp->index.size() > grp->number_of_groups());
+    }
+
+  // couplings as in WavefunctionFactory
+  using index_aos = ma::sparse::array_of_sequences<int, int, shared_allocator<int>, ma::sparse::is_root>;
+  shared_allocator<int> alloc_{node};
+  std::vector<int> counts_alpha(abij.number_of_unique_excitations()[0]);
+  std::vector<int> counts_beta(abij.number_of_unique_excitations()[1]);
+  for (auto it = abij.configurations_begin(); it < abij.configurations_end(); ++it)
+  {
+    ++counts_alpha[std::get<0>(*it)];
+    ++counts_beta[std::get<1>(*it)];
+  }
+  std::array<index_aos, 2> couplings{index_aos(counts_alpha.size(), counts_alpha, alloc_),
+                                     index_aos(counts_beta.size(), counts_beta, alloc_)};
+  int ni = 0;
+  for (auto it = abij.configurations_begin(); it < abij.configurations_end(); ++it, ++ni)
+  {
+    couplings[0].emplace_back(std::get<0>(*it), ni);
+    couplings[1].emplace_back(std::get<1>(*it), ni);
+  }
+
+  // T[particle][hole] of both spins, particles of the beta spin are shifted by NMO
+  std::mt19937 rng(17);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  boost::multi::array<ComplexType, 3> T({2, 2 * NMO, NAEA});
+  for (auto it = T.origin(); it != T.origin() + T.num_elements(); ++it)
+    *it = ComplexType(dist(rng), dist(rng));
+
+  auto check = [](ComplexType const& ref, ComplexType const& test) {
+    CHECK(real(test) == Approx(real(ref)).epsilon(1e-8).margin(1e-10));
+    CHECK(imag(test) == Approx(imag(ref)).epsilon(1e-8).margin(1e-10));
+  };
+
+  const int nmax = std::max(abij.maximum_excitation_number()[0], abij.maximum_excitation_number()[1]);
+  boost::multi::array<ComplexType, 2> Qwork({2 * nmax, nmax});
+  std::array<std::vector<ComplexType>, 2> ov, ov_grouped;
+  for (int spin = 0; spin < 2; spin++)
+  {
+    INFO("overlaps of spin " << spin);
+    ov[spin].assign(abij.number_of_unique_excitations()[spin], ComplexType(0.0));
+    ov_grouped[spin].assign(abij.number_of_unique_excitations()[spin], ComplexType(0.0));
+    ov[spin][0] = ov_grouped[spin][0] = ComplexType(1.0);
+    calculate_overlaps(0, 1, spin, abij, T[spin], Qwork, ov[spin]);
+    calculate_overlaps(0, 1, spin, abij, groups, T[spin], Qwork, ov_grouped[spin]);
+    for (int i = 0; i < ov[spin].size(); i++)
+      check(ov[spin][i], ov_grouped[spin][i]);
+  }
+
+  const ComplexType ov0(0.8, -0.3);
+  boost::multi::array<ComplexType, 2> R({NAEA, 2 * NMO}), R_grouped({NAEA, 2 * NMO});
+  for (int spin = 0; spin < 2; spin++)
+  {
+    INFO("R of spin " << spin);
+    calculate_R(0, 1, spin, abij, couplings[spin], T[spin], Qwork, ov[1 - spin], ov0, R);
+    calculate_R(0, 1, spin, abij, groups, couplings[spin], T[spin], Qwork, ov[1 - spin], ov0, R_grouped);
+    for (int i = 0; i < NAEA; i++)
+      for (int j = 0; j < 2 * NMO; j++)
+        check(R[i][j], R_grouped[i][j]);
+  }
+}
+
+/*
+ * Overlaps and mixed density matrices of PHMSD with group_excitations="yes" and "no",
+ * for an expansion with excitations of up to 5 electrons of each spin written to an ASCII file.
+ */
+template<class Allocator>
+void test_phmsd_group_excitations(boost::mpi3::communicator& world)
+{
+  if (not file_exists(UTEST_HAMIL))
+  {
+    app_log() << " Skipping test_phmsd_group_excitations. Hamiltonian file not found. \n";
+    app_log() << " Run unit test with --hamil /path/to/hamil.h5.\n";
+    return;
+  }
+
+  GlobalTaskGroup gTG(world);
+  auto TG    = TaskGroup_(gTG, std::string("WfnTG"), 1, gTG.getTotalCores());
+  auto TGwfn = TaskGroup_(gTG, std::string("WfnTG"), 1, gTG.getTotalCores());
+  Allocator alloc_(make_localTG_allocator<ComplexType>(TG));
+
+  int NMO, NAEA, NAEB;
+  std::tie(NMO, NAEA, NAEB) = read_info_from_hdf(UTEST_HAMIL);
+  const int min_order = ph_excitation_groups::min_order;
+  if (std::min(NAEA, NAEB) < min_order || NMO - std::max(NAEA, NAEB) < min_order)
+  {
+    app_log() << " Skipping test_phmsd_group_excitations. Too few electrons or virtual orbitals. \n";
+    return;
+  }
+
+  std::vector<int> occs;
+  std::vector<ComplexType> coeffs;
+  getExcitedDeterminants(NMO, NAEA, NAEB, 5, 80, occs, coeffs);
+  const int ndets = coeffs.size();
+  const std::string wfn_file("phmsd_group_excitations.dat");
+  if (world.root())
+  {
+    std::ofstream out(wfn_file);
+    out << "&FCI\n UHF = 0\n NCI = " << ndets << "\n TYPE = occ\n&END\nConfigurations:\n" << std::setprecision(16);
+    for (int nd = 0; nd < ndets; nd++)
+    {
+      out << coeffs[nd];
+      for (int i = 0; i < NAEA + NAEB; i++)
+        out << " " << occs[nd * (NAEA + NAEB) + i] + 1;
+      out << "\n";
+    }
+  }
+  world.barrier();
+
+  std::map<std::string, AFQMCInfo> InfoMap;
+  InfoMap.insert(std::make_pair("info0", AFQMCInfo{"info0", NMO, NAEA, NAEB}));
+  HamiltonianFactory HamFac(InfoMap);
+  std::string hamil_xml = R"(<Hamiltonian name="ham0" info="info0">
+      <parameter name="filetype">hdf5</parameter>
+      <parameter name="filename">)" +
+      UTEST_HAMIL + R"(</parameter>
+      <parameter name="cutoff_decomposition">1e-12</parameter>
+      <parameter name="cutoff_1bar">1e-12</parameter>
+    </Hamiltonian>
+    )";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(hamil_xml.c_str()));
+  std::string ham_name("ham0");
+  HamFac.push(ham_name, doc.getRoot());
+  Hamiltonian& ham = HamFac.getHamiltonian(gTG, ham_name);
+
+  WavefunctionFactory WfnFac(InfoMap);
+  const int nwalk = 3;
+  auto make_wfn   = [&](const std::string& wfn_name, const std::string& group_excitations) -> Wavefunction& {
+    std::string wfn_xml = R"(<Wavefunction name=")" + wfn_name + R"(" info="info0" type="phmsd">
+      <parameter name="filetype">ascii</parameter>
+      <parameter name="filename">)" +
+        wfn_file + R"(</parameter>
+      <parameter name="cutoff">1e-6</parameter>
+      <parameter name="group_excitations">)" +
+        group_excitations + R"(</parameter>
+    </Wavefunction>
+    )";
+    Libxml2Document doc_wfn;
+    REQUIRE(doc_wfn.parseFromString(wfn_xml.c_str()));
+    WfnFac.push(wfn_name, doc_wfn.getRoot());
+    return WfnFac.getWavefunction(TGwfn, TGwfn, wfn_name, COLLINEAR, &ham, 1e-6, nwalk);
+  };
+  Wavefunction& wfn         = make_wfn("wfn_ungrouped", "no");
+  Wavefunction& wfn_grouped = make_wfn("wfn_grouped", "yes");
+
+  const char* wlk_xml_block = R"(<WalkerSet name="wset0">
+      <parameter name="walker_type">collinear</parameter>
+    </WalkerSet>
+    )";
+  Libxml2Document doc3;
+  REQUIRE(doc3.parseFromString(wlk_xml_block));
+  RandomGenerator rng;
+  WalkerSet wset(TG, doc3.getRoot(), InfoMap["info0"], rng);
+  // walkers close to the reference with a random admixture of all orbitals
+  std::mt19937 gen(23);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  boost::multi::array<ComplexType, 2> A({NMO, NAEA}), B({NMO, NAEB});
+  wset.resize(nwalk, A, B);
+  for (int iw = 0; iw < nwalk; iw++)
+  {
+    boost::multi::array<ComplexType, 2> Aw({NMO, NAEA}), Bw({NMO, NAEB});
+    for (int i = 0; i < NMO; i++)
+    {
+      for (int a = 0; a < NAEA; a++)
+        Aw[i][a] = ComplexType((i == a ? 1.0 : 0.0) + 0.3 * dist(gen), 0.1 * dist(gen));
+      for (int a = 0; a < NAEB; a++)
+        Bw[i][a] = ComplexType((i == a ? 1.0 : 0.0) + 0.3 * dist(gen), 0.1 * dist(gen));
+    }
+    ma::copy(Aw, *wset[iw].SlaterMatrix(Alpha));
+    ma::copy(Bw, *wset[iw].SlaterMatrix(Beta));
+  }
+
+  auto check = [](ComplexType const& ref, ComplexType const& test) {
+    CHECK(real(test) == Approx(real(ref)).epsilon(1e-8).margin(1e-12));
+    CHECK(imag(test) == Approx(imag(ref)).epsilon(1e-8).margin(1e-12));
+  };
+
+  boost::multi::array<ComplexType, 1, Allocator> Ov(iextensions<1u>{nwalk}, alloc_),
+      Ov_grouped(iextensions<1u>{nwalk}, alloc_);
+  wfn.Overlap(wset, Ov);
+  wfn_grouped.Overlap(wset, Ov_grouped);
+  for (int iw = 0; iw < nwalk; iw++)
+  {
+    INFO("overlap of walker " << iw);
+    check(Ov[iw], Ov_grouped[iw]);
+  }
+
+  // the compact density matrix is R contracted with the reference Green function
+  for (bool compact : {true, false})
+  {
+    INFO("compact density matrix " << compact);
+    const int dm_size = compact ? wfn.size_of_G_for_vbias() : 2 * NMO * NMO;
+    boost::multi::array<ComplexType, 2, Allocator> G({nwalk, dm_size}, alloc_), G_grouped({nwalk, dm_size}, alloc_);
+    wfn.MixedDensityMatrix(wset, G, Ov, compact, true);
+    wfn_grouped.MixedDensityMatrix(wset, G_grouped, Ov_grouped, compact, true);
+    for (int iw = 0; iw < nwalk; iw++)
+    {
+      check(Ov[iw], Ov_grouped[iw]);
+      for (int i = 0; i < dm_size; i++)
+        check(G[iw][i], G_grouped[iw][i]);
+    }
+  }
+}
+
 TEST_CASE("test_read_phmsd", "[test_read_phmsd]")
 {
   auto world = boost::mpi3::environment::get_world_instance();
@@ -341,4 +655,30 @@ TEST_CASE("test_phmsd", "[read_phmsd]")
   release_memory_managers();
 }
 
+TEST_CASE("test_phmsd_excitation_groups_kernels", "[read_phmsd]")
+{
+  auto world = boost::mpi3::environment::get_world_instance();
+  test_phmsd_excitation_groups_kernels(world);
+}
+
+TEST_CASE("test_phmsd_group_excitations", "[read_phmsd]")
+{
+  auto world = boost::mpi3::environment::get_world_instance();
+  if (not world.root())
+    infoLog.pause();
+  auto node = world.split_shared(world.rank());
+
+#if defined(ENABLE_CUDA) || defined(ENABLE_HIP)
+  arch::INIT(node);
+  using Alloc = device::device_allocator<ComplexType>;
+#else
+  using Alloc = shared_allocator<ComplexType>;
+#endif
+  setup_memory_managers(node, 10uL * 1024uL * 1024uL);
+
+  test_phmsd_group_excitations<Alloc>(world);
+
+  release_memory_managers();
+}
+
 } // namespace qmcplusplus
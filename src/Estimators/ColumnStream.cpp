@@ -0,0 +1,460 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "ColumnStream.h"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#include "Platforms/Host/OutputManager.h"
+
+namespace qmcplusplus
+{
+namespace
+{
+constexpr char column_stream_magic[8] = {'Q', 'M', 'C', 'C', 'O', 'L', '0', '1'};
+
+template<typename T>
+void writeValue(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+T readValue(std::istream& is)
+{
+  T value{};
+  is.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+
+/** group the k-th bytes of all the values together.
+ *  Neighboring values share their exponent and leading mantissa bytes, grouped they compress much better.
+ */
+void shuffleBytes(const unsigned char* in, std::size_t num_values, std::size_t value_size, unsigned char* out)
+{
+  for (std::size_t i = 0; i < num_values; ++i)
+    for (std::size_t k = 0; k < value_size; ++k)
+      out[k * num_values + i] = in[i * value_size + k];
+}
+
+void unshuffleBytes(const unsigned char* in, std::size_t num_values, std::size_t value_size, unsigned char* out)
+{
+  for (std::size_t k = 0; k < value_size; ++k)
+    for (std::size_t i = 0; i < num_values; ++i)
+      out[i * value_size + k] = in[k * num_values + i];
+}
+
+template<typename S, typename T>
+void convertValues(const std::vector<unsigned char>& raw, std::vector<T>& values)
+{
+  const std::size_t num_values = raw.size() / sizeof(S);
+  for (std::size_t i = 0; i < num_values; ++i)
+  {
+    S value;
+    std::memcpy(&value, raw.data() + i * sizeof(S), sizeof(S));
+    values.push_back(static_cast<T>(value));
+  }
+}
+} // namespace
+
+std::size_t ColumnSpec::valueSize() const
+{
+  switch (type)
+  {
+  case ColumnType::int64:
+    return sizeof(std::int64_t);
+  case ColumnType::float32:
+    return sizeof(float);
+  case ColumnType::float64:
+    return sizeof(double);
+  }
+  return 0;
+}
+
+ColumnChunk::ColumnChunk(const ColumnLayout& layout) : layout_(layout), columns_(layout.size()) {}
+
+std::size_t ColumnChunk::rows() const
+{
+  if (layout_.empty())
+    return 0;
+  std::size_t rows = columns_[0].size() / (layout_[0].width * layout_[0].valueSize());
+  for (int ic = 1; ic < layout_.size(); ++ic)
+    rows = std::min(rows, columns_[ic].size() / (layout_[ic].width * layout_[ic].valueSize()));
+  return rows;
+}
+
+std::size_t ColumnChunk::bytes() const
+{
+  std::size_t bytes = 0;
+  for (auto& column : columns_)
+    bytes += column.size();
+  return bytes;
+}
+
+void ColumnChunk::reserveRows(std::size_t rows)
+{
+  for (int ic = 0; ic < layout_.size(); ++ic)
+    columns_[ic].reserve(rows * layout_[ic].width * layout_[ic].valueSize());
+}
+
+void ColumnChunk::clear()
+{
+  for (auto& column : columns_)
+    column.clear();
+}
+
+ColumnRateLimiter::ColumnRateLimiter(double bytes_per_second)
+    : bytes_per_second_(bytes_per_second), next_free_(Clock::now())
+{
+  if (bytes_per_second_ <= 0)
+    throw std::runtime_error("ColumnRateLimiter bandwidth must be positive");
+}
+
+void ColumnRateLimiter::acquire(std::size_t bytes)
+{
+  const auto duration =
+      std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(bytes / bytes_per_second_));
+  Clock::time_point start;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    start      = std::max(Clock::now(), next_free_);
+    next_free_ = start + duration;
+  }
+  std::this_thread::sleep_until(start);
+}
+
+ColumnStreamWriter::ColumnStreamWriter(const std::string& file_name,
+                                       const ColumnLayout& layout,
+                                       int compression_level,
+                                       std::size_t max_queued_bytes,
+                                       std::shared_ptr<ColumnRateLimiter> rate_limiter)
+    : layout_(layout),
+      compression_level_(hasCompression() ? compression_level : 0),
+      max_queued_bytes_(max_queued_bytes),
+      rate_limiter_(std::move(rate_limiter))
+{
+  if (layout_.empty())
+    throw std::runtime_error("ColumnStreamWriter needs at least one column for " + file_name);
+  for (auto& spec : layout_)
+    if (spec.width == 0)
+      throw std::runtime_error("ColumnStreamWriter column " + spec.name + " has no values per row");
+  if (compression_level < 0 || compression_level > 9)
+    throw std::runtime_error("ColumnStreamWriter compression level must be in [0, 9]");
+
+  file_.open(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file_)
+    throw std::runtime_error("ColumnStreamWriter failed to open " + file_name);
+  file_.write(column_stream_magic, sizeof(column_stream_magic));
+  writeValue<std::uint64_t>(file_, layout_.size());
+  for (auto& spec : layout_)
+  {
+    writeValue<std::uint64_t>(file_, spec.name.size());
+    file_.write(spec.name.data(), spec.name.size());
+    writeValue<std::uint8_t>(file_, static_cast<std::uint8_t>(spec.type));
+    writeValue<std::uint64_t>(file_, spec.width);
+  }
+  if (!file_)
+    throw std::runtime_error("ColumnStreamWriter failed to write the header of " + file_name);
+
+  thread_ = std::thread(&ColumnStreamWriter::run, this);
+}
+
+ColumnStreamWriter::~ColumnStreamWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_ready_.notify_all();
+  thread_.join();
+  if (error_)
+    try
+    {
+      std::rethrow_exception(error_);
+    }
+    catch (const std::exception& e)
+    {
+      app_error() << "ColumnStreamWriter dropped data: " << e.what() << std::endl;
+    }
+}
+
+bool ColumnStreamWriter::hasCompression()
+{
+#ifdef HAVE_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+void ColumnStreamWriter::push(ColumnChunk& chunk)
+{
+  if (chunk.getLayout() != layout_)
+    throw std::runtime_error("ColumnStreamWriter::push the layout of the chunk differs from the layout of the file");
+  const std::size_t bytes = chunk.bytes();
+  if (bytes == 0)
+    return;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  work_done_.wait(lock, [this] { return error_ || queue_.empty() || queued_bytes_ < max_queued_bytes_; });
+  if (error_)
+    std::rethrow_exception(error_);
+  ColumnChunk empty_chunk;
+  if (spare_.empty())
+    empty_chunk = ColumnChunk(layout_);
+  else
+  {
+    empty_chunk = std::move(spare_.back());
+    spare_.pop_back();
+  }
+  queue_.push_back(std::move(chunk));
+  queued_bytes_ += bytes;
+  chunk = std::move(empty_chunk);
+  lock.unlock();
+  work_ready_.notify_one();
+}
+
+void ColumnStreamWriter::flush()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  work_done_.wait(lock, [this] { return queue_.empty() && !writing_; });
+  if (error_)
+    std::rethrow_exception(error_);
+}
+
+std::size_t ColumnStreamWriter::getRowsWritten() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return rows_written_;
+}
+
+std::size_t ColumnStreamWriter::getBytesWritten() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_written_;
+}
+
+void ColumnStreamWriter::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true)
+  {
+    work_ready_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+    if (queue_.empty())
+      break;
+    ColumnChunk chunk = std::move(queue_.front());
+    queue_.pop_front();
+    writing_         = true;
+    const bool write = !error_;
+    lock.unlock();
+
+    // once the file is broken the remaining chunks are only drained
+    std::exception_ptr error;
+    std::size_t written = 0;
+    if (write)
+      try
+      {
+        written = writeChunk(chunk);
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+      }
+    const std::size_t rows  = chunk.rows();
+    const std::size_t bytes = chunk.bytes();
+    chunk.clear();
+
+    lock.lock();
+    writing_ = false;
+    queued_bytes_ -= bytes;
+    if (error)
+      error_ = error;
+    else if (write)
+    {
+      rows_written_ += rows;
+      bytes_written_ += written;
+    }
+    if (spare_.size() < 2)
+      spare_.push_back(std::move(chunk));
+    work_done_.notify_all();
+  }
+  file_.close();
+}
+
+std::size_t ColumnStreamWriter::writeChunk(const ColumnChunk& chunk)
+{
+  const std::uint64_t rows = chunk.rows();
+  writeValue(file_, rows);
+  std::size_t written = sizeof(rows);
+  for (int ic = 0; ic < layout_.size(); ++ic)
+    written += writeColumn(layout_[ic], chunk.getColumn(ic).data(), rows * layout_[ic].width * layout_[ic].valueSize());
+  // a run that dies later still leaves all the chunks written so far readable
+  file_.flush();
+  if (!file_)
+    throw std::runtime_error("ColumnStreamWriter failed to write a chunk");
+  return written;
+}
+
+std::size_t ColumnStreamWriter::writeColumn(const ColumnSpec& spec, const unsigned char* raw, std::size_t size)
+{
+  std::uint8_t codec          = COLUMN_RAW;
+  const unsigned char* stored = raw;
+  std::size_t stored_size     = size;
+#ifdef HAVE_ZLIB
+  if (compression_level_ > 0 && size > 0)
+  {
+    const std::size_t value_size = spec.valueSize();
+    const unsigned char* source  = raw;
+    std::uint8_t shuffle         = COLUMN_RAW;
+    if (value_size > 1)
+    {
+      shuffled_.resize(size);
+      shuffleBytes(raw, size / value_size, value_size, shuffled_.data());
+      source  = shuffled_.data();
+      shuffle = COLUMN_SHUFFLE;
+    }
+    uLongf packed_size = compressBound(size);
+    packed_.resize(packed_size);
+    if (compress2(packed_.data(), &packed_size, source, size, compression_level_) != Z_OK)
+      throw std::runtime_error("ColumnStreamWriter failed to compress column " + spec.name);
+    // incompressible columns are stored as they are
+    if (packed_size < size)
+    {
+      codec       = COLUMN_ZLIB | shuffle;
+      stored      = packed_.data();
+      stored_size = packed_size;
+    }
+  }
+#endif
+  if (rate_limiter_)
+    rate_limiter_->acquire(stored_size);
+  writeValue<std::uint8_t>(file_, codec);
+  writeValue<std::uint64_t>(file_, stored_size);
+  file_.write(reinterpret_cast<const char*>(stored), stored_size);
+  return sizeof(std::uint8_t) + sizeof(std::uint64_t) + stored_size;
+}
+
+ColumnStreamReader::ColumnStreamReader(const std::string& file_name) : file_name_(file_name)
+{
+  std::ifstream file(file_name_, std::ios::binary);
+  if (!file)
+    throw std::runtime_error("ColumnStreamReader failed to open " + file_name_);
+  char magic[sizeof(column_stream_magic)];
+  file.read(magic, sizeof(magic));
+  if (!file || !std::equal(magic, magic + sizeof(magic), column_stream_magic))
+    throw std::runtime_error("ColumnStreamReader " + file_name_ + " is not a column stream file");
+  const auto num_columns = readValue<std::uint64_t>(file);
+  for (std::size_t ic = 0; ic < num_columns && file; ++ic)
+  {
+    ColumnSpec spec;
+    spec.name.resize(readValue<std::uint64_t>(file));
+    file.read(spec.name.data(), spec.name.size());
+    spec.type  = static_cast<ColumnType>(readValue<std::uint8_t>(file));
+    spec.width = readValue<std::uint64_t>(file);
+    layout_.push_back(spec);
+  }
+  if (!file)
+    throw std::runtime_error("ColumnStreamReader the header of " + file_name_ + " is truncated");
+  first_chunk_ = file.tellg();
+}
+
+int ColumnStreamReader::findColumn(const std::string& name) const
+{
+  for (int ic = 0; ic < layout_.size(); ++ic)
+    if (layout_[ic].name == name)
+      return ic;
+  return -1;
+}
+
+template<typename T>
+std::vector<T> ColumnStreamReader::readColumn(const std::string& name, std::size_t& rows)
+{
+  const int column = findColumn(name);
+  if (column < 0)
+    throw std::runtime_error("ColumnStreamReader there is no column " + name + " in " + file_name_);
+  const ColumnSpec& spec       = layout_[column];
+  const std::size_t value_size = spec.valueSize();
+
+  std::ifstream file(file_name_, std::ios::binary);
+  file.seekg(first_chunk_);
+  std::vector<T> values;
+  std::vector<unsigned char> stored;
+  std::vector<unsigned char> raw;
+  rows = 0;
+  while (true)
+  {
+    const auto chunk_rows = readValue<std::uint64_t>(file);
+    std::uint8_t codec    = COLUMN_RAW;
+    for (int ic = 0; ic < layout_.size() && file; ++ic)
+    {
+      const auto this_codec  = readValue<std::uint8_t>(file);
+      const auto stored_size = readValue<std::uint64_t>(file);
+      if (ic == column)
+      {
+        codec = this_codec;
+        stored.resize(stored_size);
+        file.read(reinterpret_cast<char*>(stored.data()), stored_size);
+      }
+      else
+        file.seekg(stored_size, std::ios::cur);
+    }
+    // the end of the file, or a chunk cut short by the end of a run that died
+    if (!file)
+      break;
+
+    const std::size_t raw_size = chunk_rows * spec.width * value_size;
+    if (codec & COLUMN_ZLIB)
+    {
+#ifdef HAVE_ZLIB
+      raw.resize(raw_size);
+      uLongf size = raw_size;
+      if (uncompress(raw.data(), &size, stored.data(), stored.size()) != Z_OK || size != raw_size)
+        throw std::runtime_error("ColumnStreamReader failed to decompress column " + name + " of " + file_name_);
+      std::swap(raw, stored);
+#else
+      throw std::runtime_error("ColumnStreamReader column " + name + " of " + file_name_ +
+                               " is compressed but this build has no zlib");
+#endif
+    }
+    if (stored.size() != raw_size)
+      throw std::runtime_error("ColumnStreamReader column " + name + " of " + file_name_ + " has a wrong size");
+    if (codec & COLUMN_SHUFFLE)
+    {
+      raw.resize(raw_size);
+      unshuffleBytes(stored.data(), raw_size / value_size, value_size, raw.data());
+      std::swap(raw, stored);
+    }
+
+    switch (spec.type)
+    {
+    case ColumnType::int64:
+      convertValues<std::int64_t>(stored, values);
+      break;
+    case ColumnType::float32:
+      convertValues<float>(stored, values);
+      break;
+    case ColumnType::float64:
+      convertValues<double>(stored, values);
+      break;
+    }
+    rows += chunk_rows;
+  }
+  return values;
+}
+
+template std::vector<float> ColumnStreamReader::readColumn<float>(const std::string& name, std::size_t& rows);
+template std::vector<double> ColumnStreamReader::readColumn<double>(const std::string& name, std::size_t& rows);
+template std::vector<std::int64_t> ColumnStreamReader::readColumn<std::int64_t>(const std::string& name,
+                                                                                std::size_t& rows);
+} // namespace qmcplusplus
@@ -0,0 +1,270 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_COLUMNSTREAM_H
+#define QMCPLUSPLUS_COLUMNSTREAM_H
+
+#include <chrono>
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \file
+ *  A columnar, chunked and optionally compressed stream of rows written by a background thread.
+ *
+ *  File layout, all integers are little endian as written by the host:
+ *    header  "QMCCOL01", uint64 number of columns,
+ *            per column: uint64 name length, name, uint8 ColumnType, uint64 width
+ *    chunks  uint64 number of rows,
+ *            per column: uint8 codec, uint64 stored bytes, stored bytes
+ *  A column holds width values per row. The codec is a bit set of ColumnCodec,
+ *  the decoded size of a column is rows * width * size of its type.
+ *  Since the stored size of every column is recorded, a reader can skip the columns it does not need.
+ *  The layout is also described in docs/methods.rst, utils/read_column_stream.py reads the files in python.
+ */
+
+namespace qmcplusplus
+{
+enum class ColumnType : std::uint8_t
+{
+  int64,
+  float32,
+  float64
+};
+
+/// bits of the codec of a stored column
+enum ColumnCodec : std::uint8_t
+{
+  COLUMN_RAW     = 0,
+  COLUMN_ZLIB    = 1,
+  /// bytes of the values were grouped by significance before compression
+  COLUMN_SHUFFLE = 2
+};
+
+struct ColumnSpec
+{
+  std::string name;
+  ColumnType type;
+  /// number of values per row
+  std::size_t width;
+
+  std::size_t valueSize() const;
+  bool operator==(const ColumnSpec& other) const
+  {
+    return name == other.name && type == other.type && width == other.width;
+  }
+};
+
+using ColumnLayout = std::vector<ColumnSpec>;
+
+/** Rows of all the columns of a layout, filled by one producer and handed to a ColumnStreamWriter as a unit.
+ *
+ *  A row is complete once every column has received width values,
+ *  values are converted to the type of the column as they are appended.
+ */
+class ColumnChunk
+{
+public:
+  ColumnChunk(const ColumnLayout& layout = {});
+
+  const ColumnLayout& getLayout() const { return layout_; }
+
+  template<typename T>
+  void append(int column, const T* values, std::size_t count);
+
+  template<typename T>
+  void append(int column, const std::complex<T>* values, std::size_t count)
+  {
+    append(column, reinterpret_cast<const T*>(values), 2 * count);
+  }
+
+  template<typename T>
+  void append(int column, T value)
+  {
+    append(column, &value, 1);
+  }
+
+  /// number of complete rows
+  std::size_t rows() const;
+  /// bytes held by the columns
+  std::size_t bytes() const;
+  void reserveRows(std::size_t rows);
+  /// drop the rows and keep the memory
+  void clear();
+
+  const std::vector<unsigned char>& getColumn(int column) const { return columns_[column]; }
+
+private:
+  template<typename S, typename T>
+  static void appendAs(std::vector<unsigned char>& bytes, const T* values, std::size_t count)
+  {
+    const std::size_t offset = bytes.size();
+    bytes.resize(offset + count * sizeof(S));
+    unsigned char* target = bytes.data() + offset;
+    for (std::size_t i = 0; i < count; ++i, target += sizeof(S))
+    {
+      const S value = static_cast<S>(values[i]);
+      std::memcpy(target, &value, sizeof(S));
+    }
+  }
+
+  ColumnLayout layout_;
+  std::vector<std::vector<unsigned char>> columns_;
+};
+
+template<typename T>
+void ColumnChunk::append(int column, const T* values, std::size_t count)
+{
+  auto& bytes = columns_[column];
+  switch (layout_[column].type)
+  {
+  case ColumnType::int64:
+    appendAs<std::int64_t>(bytes, values, count);
+    break;
+  case ColumnType::float32:
+    appendAs<float>(bytes, values, count);
+    break;
+  case ColumnType::float64:
+    appendAs<double>(bytes, values, count);
+    break;
+  }
+}
+
+/** Keeps the writes of one or more ColumnStreamWriters below a bandwidth.
+ *
+ *  Each write reserves the next free slot of the bandwidth and sleeps until it starts, so the writers sharing
+ *  a limiter together never exceed it on average. Idle time does not build up credit for later bursts.
+ *  Thread safe, the writers share it through a shared_ptr.
+ */
+class ColumnRateLimiter
+{
+public:
+  ColumnRateLimiter(double bytes_per_second);
+
+  /// block until bytes can be written without exceeding the bandwidth
+  void acquire(std::size_t bytes);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  const double bytes_per_second_;
+  std::mutex mutex_;
+  Clock::time_point next_free_;
+};
+
+/** Writes ColumnChunks to a file from a background thread.
+ *
+ *  push() is the only synchronization point with the producers, they fill their own chunks
+ *  without locks and take the queue lock once per chunk. Compression and file I/O happen on the writer thread.
+ *  When more than max_queued_bytes wait in the queue, push() blocks until the writer catches up,
+ *  which bounds the memory used when the disk cannot keep up.
+ *
+ *  File I/O does not go through HDF5 since the HDF5 library is not thread safe in general
+ *  and the rest of the application keeps using it from the main thread.
+ */
+class ColumnStreamWriter
+{
+public:
+  /** create file_name and write the header.
+   *  \param[in] compression_level  zlib level 1-9, 0 stores the columns raw. Without zlib columns are stored raw.
+   *  \param[in] rate_limiter       when given, bounds the bandwidth of the writes
+   */
+  ColumnStreamWriter(const std::string& file_name,
+                     const ColumnLayout& layout,
+                     int compression_level                           = 1,
+                     std::size_t max_queued_bytes                    = std::size_t(256) << 20,
+                     std::shared_ptr<ColumnRateLimiter> rate_limiter = nullptr);
+  ColumnStreamWriter(const ColumnStreamWriter&) = delete;
+  /// write everything pushed so far and close the file
+  ~ColumnStreamWriter();
+
+  /** queue the rows of chunk for writing and leave chunk empty, with the same layout.
+   *  Thread safe. Throws if the layout of chunk differs or if the writer thread has failed.
+   */
+  void push(ColumnChunk& chunk);
+
+  /// block until every pushed chunk is written, rethrows a failure of the writer thread
+  void flush();
+
+  const ColumnLayout& getLayout() const { return layout_; }
+  std::size_t getRowsWritten() const;
+  std::size_t getBytesWritten() const;
+
+  /// whether this build can compress columns
+  static bool hasCompression();
+
+private:
+  /// writer thread main loop
+  void run();
+  /// \return bytes written to the file
+  std::size_t writeChunk(const ColumnChunk& chunk);
+  std::size_t writeColumn(const ColumnSpec& spec, const unsigned char* raw, std::size_t size);
+
+  const ColumnLayout layout_;
+  const int compression_level_;
+  const std::size_t max_queued_bytes_;
+  const std::shared_ptr<ColumnRateLimiter> rate_limiter_;
+  std::ofstream file_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable work_ready_;
+  std::condition_variable work_done_;
+  std::deque<ColumnChunk> queue_;
+  /// emptied chunks kept to be handed back by push
+  std::vector<ColumnChunk> spare_;
+  std::size_t queued_bytes_ = 0;
+  bool writing_             = false;
+  bool stop_                = false;
+  std::exception_ptr error_;
+  std::size_t rows_written_  = 0;
+  std::size_t bytes_written_ = 0;
+
+  /// scratch of the writer thread
+  std::vector<unsigned char> shuffled_;
+  std::vector<unsigned char> packed_;
+
+  std::thread thread_;
+};
+
+/// Reads back the files of ColumnStreamWriter, mostly for testing and small post processing tools
+class ColumnStreamReader
+{
+public:
+  ColumnStreamReader(const std::string& file_name);
+
+  const ColumnLayout& getLayout() const { return layout_; }
+
+  /// index of the column called name, -1 if there is none
+  int findColumn(const std::string& name) const;
+
+  /** all the rows of a column converted to T, row major
+   *  \param[out] rows  number of rows read
+   */
+  template<typename T>
+  std::vector<T> readColumn(const std::string& name, std::size_t& rows);
+
+private:
+  std::string file_name_;
+  ColumnLayout layout_;
+  std::streamoff first_chunk_;
+};
+
+} // namespace qmcplusplus
+#endif
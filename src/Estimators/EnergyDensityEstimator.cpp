@@ -227,6 +227,9 @@ void NEEnergyDensityEstimator::accumulate(const RefVector<MCPWalker>& walkers,
     walkers_weight_ += walkers[iw].get().Weight;
     evaluate(psets[iw], walkers[iw], iw);
   }
+  // the grid values of all the walkers are added to the space grids at once
+  for (auto& space_grid : spacegrids_)
+    space_grid->applyDeferred();
 }
 
 void NEEnergyDensityEstimator::evaluate(ParticleSet& pset, const MCPWalker& walker, const int walker_index)
@@ -294,7 +297,7 @@ void NEEnergyDensityEstimator::evaluate(ParticleSet& pset, const MCPWalker& walk
   for (int i = 0; i < spacegrids_.size(); i++)
   {
     NESpaceGrid<Real>& sg = *(spacegrids_[i]);
-    sg.accumulate(r_work_, ed_values_, particles_outside_); //, dtab);
+    sg.accumulateDeferred(r_work_, ed_values_, particles_outside_); //, dtab);
   }
 
   //Accumulate energy density of particles outside any spacegrid
@@ -75,6 +75,9 @@ public:
                   const RefVector<QMCHamiltonian>& hams,
                   RandomBase<FullPrecReal>& rng) override;
 
+  /** energy density of one walker, its space grid values are only recorded.
+   *  accumulate adds them to the space grids once all the walkers are evaluated.
+   */
   void evaluate(ParticleSet& pset, const MCPWalker& walker, const int walker_index);
 
   /** this allows the EstimatorManagerNew to reduce without needing to know the details
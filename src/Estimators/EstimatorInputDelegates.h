@@ -21,6 +21,7 @@
 #include "SpinDensityInput.h"
 #include "MagnetizationDensityInput.h"
 #include "PerParticleHamiltonianLoggerInput.h"
+#include "PerParticleTraceInput.h"
 #include "SelfHealingOverlapInput.h"
 #include "EnergyDensityInput.h"
 
@@ -41,6 +41,37 @@ EstimatorManagerInput::EstimatorManagerInput(std::initializer_list<EstimatorMana
     std::copy(emi.scalar_estimator_inputs_.begin(), emi.scalar_estimator_inputs_.end(),
               scalar_estimator_inputs_.begin() + scalar_est_offset);
     scalar_est_offset += emi.scalar_estimator_inputs_.size();
+    if (emi.operator_reduction_)
+      operator_reduction_ = emi.operator_reduction_;
+    if (emi.operator_reduce_period_)
+      operator_reduce_period_ = emi.operator_reduce_period_;
+  }
+}
+
+void EstimatorManagerInput::readAttributes(xmlNodePtr cur)
+{
+  const std::string error_tag{"EstimatorManager input:"};
+  std::string reduction(lowerCase(getXMLAttributeValue(cur, "reduction")));
+  if (reduction == "blocking")
+    operator_reduction_ = OperatorReduction::blocking;
+  else if (reduction == "hierarchical")
+    operator_reduction_ = OperatorReduction::hierarchical;
+  else if (!reduction.empty())
+    throw UniformCommunicateError(error_tag + "reduction must be blocking or hierarchical, not " + reduction);
+
+  std::string period(getXMLAttributeValue(cur, "operator_reduce_period"));
+  if (!period.empty())
+  {
+    try
+    {
+      operator_reduce_period_ = string2Int<int>(period);
+    }
+    catch (const std::exception&)
+    {
+      operator_reduce_period_ = 0;
+    }
+    if (*operator_reduce_period_ < 1)
+      throw UniformCommunicateError(error_tag + "operator_reduce_period must be a positive integer, not " + period);
   }
 }
 
@@ -50,7 +81,10 @@ void EstimatorManagerInput::readXML(xmlNodePtr cur)
   std::string cur_name{lowerCase(castXMLCharToChar(cur->name))};
   xmlNodePtr child;
   if (cur_name == "estimators")
+  {
+    readAttributes(cur);
     child = cur->xmlChildrenNode;
+  }
   else
     child = cur; // the case when 'estimator's are not encapsulated by a 'estimators' node
   while (child != NULL)
@@ -86,6 +120,8 @@ void EstimatorManagerInput::readXML(xmlNodePtr cur)
         appendEstimatorInput<SelfHealingOverlapInput>(child);
       else if (atype == "perparticlehamiltonianlogger")
         appendEstimatorInput<PerParticleHamiltonianLoggerInput>(child);
+      else if (atype == "perparticletrace")
+        appendEstimatorInput<PerParticleTraceInput>(child);
       else if (atype == "magnetizationdensity")
         appendEstimatorInput<MagnetizationDensityInput>(child);
       else if (atype == "energydensity")
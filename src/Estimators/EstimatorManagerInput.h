@@ -19,6 +19,7 @@
 
 #include "type_traits/template_types.hpp"
 #include <functional>
+#include <optional>
 #include <vector>
 #include <variant>
 #include <libxml/tree.h>
@@ -44,6 +45,7 @@ class OneBodyDensityMatricesInput;
 class SelfHealingOverlapInput;
 class MagnetizationDensityInput;
 class PerParticleHamiltonianLoggerInput;
+class PerParticleTraceInput;
 using EstimatorInput  = std::variant<std::monostate,
                                      MomentumDistributionInput,
                                      SpinDensityInput,
@@ -51,6 +53,7 @@ using EstimatorInput  = std::variant<std::monostate,
                                      SelfHealingOverlapInput,
                                      MagnetizationDensityInput,
                                      PerParticleHamiltonianLoggerInput,
+                                     PerParticleTraceInput,
                                      EnergyDensityInput>;
 using EstimatorInputs = std::vector<EstimatorInput>;
 
@@ -70,6 +73,17 @@ using ScalarEstimatorInputs = std::vector<ScalarEstimatorInput>;
 class EstimatorManagerInput
 {
 public:
+  /** how operator estimator data is reduced over the ranks
+   *  blocking:     one blocking reduce to rank 0 of all the ranks
+   *  hierarchical: sum through shared memory within each node, then a non-blocking reduce over the node leaders
+   *                which completes during the following block
+   */
+  enum class OperatorReduction
+  {
+    blocking,
+    hierarchical
+  };
+
   EstimatorManagerInput()                                            = default;
   EstimatorManagerInput(const EstimatorManagerInput& emi)            = default;
   EstimatorManagerInput(EstimatorManagerInput&& emi)                 = default;
@@ -81,6 +95,8 @@ public:
   EstimatorManagerInput(xmlNodePtr cur);
   EstimatorInputs& get_estimator_inputs() { return estimator_inputs_; }
   ScalarEstimatorInputs& get_scalar_estimator_inputs() { return scalar_estimator_inputs_; }
+  OperatorReduction get_operator_reduction() const { return operator_reduction_.value_or(OperatorReduction::blocking); }
+  int get_operator_reduce_period() const { return operator_reduce_period_.value_or(1); }
 
   /** read <estimators> node or (<estimator> node for legacy support)
    *  This can be done multiple times with <estimators> nodes
@@ -98,6 +114,15 @@ private:
   /// this is a vector of variants for typesafe access to the estimator inputs
   EstimatorInputs estimator_inputs_;
   ScalarEstimatorInputs scalar_estimator_inputs_;
+  /// set by the reduction attribute of <estimators>, a later <estimators> node overrides an earlier one
+  std::optional<OperatorReduction> operator_reduction_;
+  /** set by the operator_reduce_period attribute of <estimators>.
+   *  Operator estimators are accumulated over this many blocks before they are reduced and written.
+   */
+  std::optional<int> operator_reduce_period_;
+
+  /// read the attributes of an <estimators> node
+  void readAttributes(xmlNodePtr cur);
 
   template<typename T>
   void appendEstimatorInput(xmlNodePtr node)
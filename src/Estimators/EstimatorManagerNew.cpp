@@ -24,7 +24,9 @@
 #include "SelfHealingOverlap.h"
 #include "MagnetizationDensity.h"
 #include "PerParticleHamiltonianLogger.h"
+#include "PerParticleTrace.h"
 #include "EnergyDensityEstimator.h"
+#include "HierarchicalReducer.h"
 #include "QMCHamiltonians/QMCHamiltonian.h"
 #include "Message/Communicate.h"
 #include "Message/CommOperators.h"
@@ -50,7 +52,13 @@ namespace qmcplusplus
 using SPOMap = SPOSet::SPOMap;
 
 EstimatorManagerNew::EstimatorManagerNew(const QMCHamiltonian& ham, Communicate* c)
-    : RecordCount(0), my_comm_(c), max4ascii(8), FieldWidth(20)
+    : RecordCount(0),
+      my_comm_(c),
+      operator_reduce_period_(1),
+      operator_blocks_accumulated_(0),
+      operator_reduction_(EstimatorManagerInput::OperatorReduction::blocking),
+      max4ascii(8),
+      FieldWidth(20)
 {
   app_log() << " Legacy constructor adding a default LocalEnergyEstimator for the MainEstimator " << std::endl;
   max4ascii = ham.sizeOfObservables() + 3;
@@ -100,6 +108,9 @@ void EstimatorManagerNew::constructEstimators(EstimatorManagerInput&& emi,
                                               const QMCHamiltonian& H,
                                               const PSPool& pset_pool)
 {
+  operator_reduction_     = emi.get_operator_reduction();
+  operator_reduce_period_ = emi.get_operator_reduce_period();
+
   for (auto& est_input : emi.get_estimator_inputs())
     if (!(createEstimator<SpinDensityInput>(est_input, pset.getLattice(), pset.getSpeciesSet()) ||
           createEstimator<MomentumDistributionInput>(est_input, pset.getTotalNum(), pset.getTwist(),
@@ -109,6 +120,7 @@ void EstimatorManagerNew::constructEstimators(EstimatorManagerInput&& emi,
                                                        twf.getSPOMap(), pset) ||
           createEstimator<MagnetizationDensityInput>(est_input, pset.getLattice()) ||
           createEstimator<PerParticleHamiltonianLoggerInput>(est_input, my_comm_->rank()) ||
+          createEstimator<PerParticleTraceInput>(est_input, *my_comm_) ||
           createEstimator<EnergyDensityInput>(est_input, pset_pool)))
       throw UniformCommunicateError(std::string(error_tag_) +
                                     "cannot construct an estimator from estimator input object.");
@@ -175,6 +187,10 @@ void EstimatorManagerNew::makeConfigReport(std::ostream& os) const
     os << "  General Estimators:\n";
     for (auto& est : operator_ests_)
       os << "    " << est->get_my_name() << '\n';
+    os << "  General Estimators reduction: "
+       << (operator_reduction_ == EstimatorManagerInput::OperatorReduction::hierarchical ? "hierarchical"
+                                                                                         : "blocking")
+       << ", every " << operator_reduce_period_ << " block(s)\n";
   }
 }
 
@@ -201,7 +217,15 @@ void EstimatorManagerNew::addHeader(std::ostream& o)
 void EstimatorManagerNew::startDriverRun()
 {
   reset();
-  RecordCount = 0;
+  RecordCount                  = 0;
+  operator_blocks_accumulated_ = 0;
+  if (operator_reduction_ == EstimatorManagerInput::OperatorReduction::hierarchical && operator_ests_.size() > 0 &&
+      !operator_reducer_)
+  {
+    operator_reducer_ = std::make_unique<HierarchicalReducer>(*my_comm_);
+    app_log() << "  General Estimators are reduced over " << operator_reducer_->getNumNodes() << " node(s)"
+              << std::endl;
+  }
   energyAccumulator.clear();
   varAccumulator.clear();
   BlockAverages.setValues(0.0);
@@ -241,7 +265,15 @@ void EstimatorManagerNew::startDriverRun()
   }
 }
 
-void EstimatorManagerNew::stopDriverRun() { h_file.reset(); }
+void EstimatorManagerNew::stopDriverRun()
+{
+  // a reduction period cut short by the end of the run is still written
+  if (operator_blocks_accumulated_ > 0)
+    endOperatorReducePeriod();
+  if (operator_reducer_)
+    completeOperatorEstimatorsReduction();
+  h_file.reset();
+}
 
 void EstimatorManagerNew::startBlock(int steps) { block_timer_.restart(); }
 
@@ -254,9 +286,8 @@ void EstimatorManagerNew::stopBlock(unsigned long accept, unsigned long reject,
   //take block averages and update properties per block
   PropertyCache[weightInd] = block_weight;
   makeBlockAverages(accept, reject);
-  reduceOperatorEstimators();
-  writeOperatorEstimators();
-  zeroOperatorEstimators();
+  if (++operator_blocks_accumulated_ == operator_reduce_period_)
+    endOperatorReducePeriod();
   // intentionally put after all the estimator I/O
   PropertyCache[cpuInd] = block_timer_.elapsed();
   writeScalarH5();
@@ -427,6 +458,57 @@ void EstimatorManagerNew::reduceOperatorEstimators()
   }
 }
 
+void EstimatorManagerNew::endOperatorReducePeriod()
+{
+  if (operator_reducer_)
+    startOperatorEstimatorsReduction();
+  else
+  {
+    reduceOperatorEstimators();
+    writeOperatorEstimators();
+    zeroOperatorEstimators();
+  }
+  operator_blocks_accumulated_ = 0;
+}
+
+void EstimatorManagerNew::startOperatorEstimatorsReduction()
+{
+  PooledData<RealType> operator_send_buffer;
+  size_t total_size = 0;
+  for (auto& op_est : operator_ests_)
+    total_size += op_est->getFullDataSize() + 1;
+  operator_send_buffer.reserve(total_size);
+  for (auto& op_est : operator_ests_)
+  {
+    op_est->packData(operator_send_buffer);
+    auto weight = static_cast<RealType>(op_est->get_walkers_weight());
+    operator_send_buffer.add(weight);
+  }
+  assert(operator_send_buffer.size() == total_size);
+  zeroOperatorEstimators();
+  completeOperatorEstimatorsReduction();
+  operator_reducer_->start(operator_send_buffer);
+}
+
+void EstimatorManagerNew::completeOperatorEstimatorsReduction()
+{
+  if (!operator_reducer_->wait())
+    return;
+  if (my_comm_->rank() == 0)
+  {
+    PooledData<RealType>& operator_recv_buffer = operator_reducer_->getResult();
+    for (auto& op_est : operator_ests_)
+    {
+      op_est->unpackData(operator_recv_buffer);
+      RealType reduced_walker_weights = 0.0;
+      operator_recv_buffer.get(reduced_walker_weights);
+      op_est->normalize(1.0 / reduced_walker_weights);
+    }
+    writeOperatorEstimators();
+    zeroOperatorEstimators();
+  }
+}
+
 void EstimatorManagerNew::writeOperatorEstimators()
 {
   if (my_comm_->rank() == 0)
@@ -31,6 +31,7 @@ namespace qmcplusplus
 {
 class QMCHamiltonian;
 class hdf_archive;
+class HierarchicalReducer;
 
 namespace testing
 {
@@ -93,7 +94,7 @@ public:
   void startDriverRun();
 
   /** Stop the manager at the end of a driver run().
-   * Flush/close files.
+   * Write operator estimator data still being accumulated or reduced. Flush/close files.
    */
   void stopDriverRun();
 
@@ -204,6 +205,22 @@ private:
    *  separately is the correct memory use vs. mpi message balance.
    */
   void reduceOperatorEstimators();
+  /** reduce, write and zero the OperatorEstimators at the end of a reduction period.
+   *
+   *  In the hierarchical mode the reduction is only started, its data is written once it completes.
+   */
+  void endOperatorReducePeriod();
+  /** start the hierarchical reduction of the OperatorEstimators
+   *
+   *  All the OperatorEstimators are packed into one buffer and zeroed so they can accumulate the next block
+   *  while the reduction is in flight. The previous reduction is completed and written first.
+   */
+  void startOperatorEstimatorsReduction();
+  /** complete a hierarchical reduction in flight, if any, and write its result.
+   *
+   *  The reduced data is unpacked into the OperatorEstimators of rank 0, which must not hold unreduced data.
+   */
+  void completeOperatorEstimatorsReduction();
   /** Write OperatorEstimator data to *.stat.h5
    *
    *  Note that OperatorEstimator owns its own observable_helpers
@@ -261,6 +278,14 @@ private:
    * them.
    */
   UPtrVector<OperatorEstBase> operator_ests_;
+  /// number of blocks OperatorEstimators accumulate before they are reduced and written
+  int operator_reduce_period_;
+  /// blocks accumulated by the OperatorEstimators since they were last reduced
+  int operator_blocks_accumulated_;
+  /// how the OperatorEstimators are reduced over ranks
+  EstimatorManagerInput::OperatorReduction operator_reduction_;
+  /// reducer of the hierarchical reduction, created by startDriverRun
+  std::unique_ptr<HierarchicalReducer> operator_reducer_;
 
   ///block timer
   Timer block_timer_;
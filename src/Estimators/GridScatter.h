@@ -0,0 +1,131 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_GRIDSCATTER_H
+#define QMCPLUSPLUS_GRIDSCATTER_H
+
+#include <cassert>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace qmcplusplus
+{
+/** Accumulates scattered (grid index, values) entries into a large grid in cache friendly order.
+ *
+ *  Entries are recorded by add() for a whole batch of walkers, then apply() bins them by blocks of
+ *  consecutive grid elements with a counting sort and adds them block by block.
+ *  The writes into a block stay in cache instead of jumping over the whole grid for every particle.
+ *  Since blocks are disjoint, apply() can hand whole blocks to threads, each thread then owns
+ *  a private sub-grid and no copy of the grid is needed per thread.
+ *
+ *  An entry adds values_per_entry consecutive values starting at its grid index.
+ */
+template<typename T>
+class GridScatter
+{
+public:
+  /// log2 of the number of grid elements in a block
+  static constexpr int block_bits = 12;
+
+  GridScatter(std::size_t grid_size = 0, int values_per_entry = 1) { resize(grid_size, values_per_entry); }
+
+  void resize(std::size_t grid_size, int values_per_entry = 1)
+  {
+    grid_size_        = grid_size;
+    values_per_entry_ = values_per_entry;
+    clear();
+  }
+
+  void reserve(std::size_t num_entries)
+  {
+    indexes_.reserve(num_entries);
+    values_.reserve(num_entries * values_per_entry_);
+  }
+
+  void clear()
+  {
+    indexes_.clear();
+    values_.clear();
+  }
+
+  std::size_t size() const { return indexes_.size(); }
+
+  void add(std::size_t index, T value)
+  {
+    assert(values_per_entry_ == 1);
+    assert(index < grid_size_);
+    indexes_.push_back(index);
+    values_.push_back(value);
+  }
+
+  /// add the values_per_entry_ values starting at values
+  template<typename IT>
+  void add(std::size_t index, IT values)
+  {
+    assert(index + values_per_entry_ <= grid_size_);
+    indexes_.push_back(index);
+    for (int v = 0; v < values_per_entry_; ++v, ++values)
+      values_.push_back(*values);
+  }
+
+  /** add all the recorded entries to grid and clear them.
+   *  \param[in] parallel  apply the blocks with OpenMP threads.
+   *                       Only honored for a single value per entry, otherwise an entry can straddle two blocks.
+   */
+  void apply(T* grid, bool parallel = false)
+  {
+    const std::size_t num_entries = indexes_.size();
+    if (num_entries == 0)
+      return;
+    const std::size_t num_blocks = (grid_size_ >> block_bits) + 1;
+    block_offsets_.assign(num_blocks + 1, 0);
+    for (std::size_t i = 0; i < num_entries; ++i)
+      ++block_offsets_[(indexes_[i] >> block_bits) + 1];
+    std::partial_sum(block_offsets_.begin(), block_offsets_.end(), block_offsets_.begin());
+    block_next_.assign(block_offsets_.begin(), block_offsets_.end() - 1);
+    order_.resize(num_entries);
+    for (std::size_t i = 0; i < num_entries; ++i)
+      order_[block_next_[indexes_[i] >> block_bits]++] = i;
+
+    const int nv = values_per_entry_;
+    if (parallel && nv == 1)
+    {
+#pragma omp parallel for schedule(dynamic)
+      for (std::size_t b = 0; b < num_blocks; ++b)
+        for (std::size_t k = block_offsets_[b]; k < block_offsets_[b + 1]; ++k)
+          grid[indexes_[order_[k]]] += values_[order_[k]];
+    }
+    else
+      for (std::size_t k = 0; k < num_entries; ++k)
+      {
+        const std::size_t i = order_[k];
+        T* restrict target  = grid + indexes_[i];
+        const T* source     = values_.data() + i * nv;
+        for (int v = 0; v < nv; ++v)
+          target[v] += source[v];
+      }
+    clear();
+  }
+
+private:
+  std::size_t grid_size_;
+  int values_per_entry_;
+  /// recorded entries
+  std::vector<std::size_t> indexes_;
+  std::vector<T> values_;
+  /// counting sort workspace
+  std::vector<std::size_t> block_offsets_;
+  std::vector<std::size_t> block_next_;
+  std::vector<std::size_t> order_;
+};
+} // namespace qmcplusplus
+#endif
@@ -0,0 +1,140 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "HierarchicalReducer.h"
+#include <algorithm>
+#include "mpi/mpi_datatype.h"
+
+namespace qmcplusplus
+{
+#ifdef HAVE_MPI
+HierarchicalReducer::HierarchicalReducer(Communicate& comm) : comm_(comm)
+{
+  // keyed by the parent rank so rank 0 of comm is the leader of its node and rank 0 of the leaders
+  MPI_Comm_split_type(comm_.getMPI(), MPI_COMM_TYPE_SHARED, comm_.rank(), MPI_INFO_NULL, &node_comm_);
+  MPI_Comm_rank(node_comm_, &node_rank_);
+  MPI_Comm_size(node_comm_, &node_size_);
+  MPI_Comm_split(comm_.getMPI(), node_rank_ == 0 ? 0 : MPI_UNDEFINED, comm_.rank(), &leader_comm_);
+  if (node_rank_ == 0)
+    MPI_Comm_size(leader_comm_, &num_nodes_);
+  MPI_Bcast(&num_nodes_, 1, MPI_INT, 0, node_comm_);
+}
+
+HierarchicalReducer::~HierarchicalReducer()
+{
+  wait();
+  if (window_ != MPI_WIN_NULL)
+  {
+    MPI_Win_unlock_all(window_);
+    MPI_Win_free(&window_);
+  }
+  if (leader_comm_ != MPI_COMM_NULL)
+    MPI_Comm_free(&leader_comm_);
+  MPI_Comm_free(&node_comm_);
+}
+
+void HierarchicalReducer::reserve(std::size_t n)
+{
+  if (n <= capacity_)
+    return;
+  if (window_ != MPI_WIN_NULL)
+  {
+    MPI_Win_unlock_all(window_);
+    MPI_Win_free(&window_);
+  }
+  Real* base = nullptr;
+  MPI_Win_allocate_shared(n * sizeof(Real), sizeof(Real), MPI_INFO_NULL, node_comm_, &base, &window_);
+  // a single passive epoch for the lifetime of the window, accesses are ordered by MPI_Win_sync and barriers
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, window_);
+  slots_.resize(node_size_);
+  for (int i = 0; i < node_size_; i++)
+  {
+    MPI_Aint size;
+    int disp_unit;
+    MPI_Win_shared_query(window_, i, &size, &disp_unit, &slots_[i]);
+  }
+  capacity_ = n;
+}
+
+void HierarchicalReducer::start(PooledData<Real>& local)
+{
+  const std::size_t n = local.size();
+  reserve(n);
+  std::copy_n(local.data(), n, slots_[node_rank_]);
+  MPI_Win_sync(window_);
+  MPI_Barrier(node_comm_);
+  MPI_Win_sync(window_);
+
+  // every rank of the node sums its own slice of the buffers into the slot of the leader
+  const std::size_t slice = (n + node_size_ - 1) / node_size_;
+  const std::size_t first = std::min(n, slice * node_rank_);
+  const std::size_t last  = std::min(n, first + slice);
+  Real* node_sum          = slots_[0];
+  for (int i = 1; i < node_size_; i++)
+  {
+    const Real* other = slots_[i];
+    for (std::size_t j = first; j < last; j++)
+      node_sum[j] += other[j];
+  }
+  MPI_Win_sync(window_);
+  MPI_Barrier(node_comm_);
+  MPI_Win_sync(window_);
+
+  if (node_rank_ == 0)
+  {
+    wait();
+    send_buffer_.assign(node_sum, node_sum + n);
+    Real* recv_buffer = nullptr;
+    if (comm_.rank() == 0)
+    {
+      result_.resize(n);
+      recv_buffer = result_.data();
+    }
+    MPI_Ireduce(send_buffer_.data(), recv_buffer, n, mpi::get_mpi_datatype(Real()), MPI_SUM, 0, leader_comm_,
+                &request_);
+  }
+  in_flight_ = true;
+}
+
+bool HierarchicalReducer::wait()
+{
+  if (!in_flight_)
+    return false;
+  if (request_ != MPI_REQUEST_NULL)
+    MPI_Wait(&request_, MPI_STATUS_IGNORE);
+  result_.rewind();
+  in_flight_ = false;
+  return true;
+}
+#else
+HierarchicalReducer::HierarchicalReducer(Communicate& comm) : comm_(comm) {}
+
+HierarchicalReducer::~HierarchicalReducer() = default;
+
+void HierarchicalReducer::reserve(std::size_t n) {}
+
+void HierarchicalReducer::start(PooledData<Real>& local)
+{
+  result_.resize(local.size());
+  std::copy_n(local.data(), local.size(), result_.data());
+  in_flight_ = true;
+}
+
+bool HierarchicalReducer::wait()
+{
+  if (!in_flight_)
+    return false;
+  result_.rewind();
+  in_flight_ = false;
+  return true;
+}
+#endif
+} // namespace qmcplusplus
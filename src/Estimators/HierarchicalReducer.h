@@ -0,0 +1,82 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_HIERARCHICAL_REDUCER_H
+#define QMCPLUSPLUS_HIERARCHICAL_REDUCER_H
+
+#include "Configuration.h"
+#include "Message/Communicate.h"
+#include "Pools/PooledData.h"
+
+namespace qmcplusplus
+{
+/** Sums a buffer over all the ranks of a communicator onto its rank 0 in two stages.
+ *
+ *  1. The ranks of a node copy their buffers into an MPI shared memory window and each rank
+ *     sums a slice of the buffers of the node into the slot of the node leader.
+ *  2. The node leaders reduce the node sums onto rank 0 with a non-blocking MPI_Ireduce.
+ *
+ *  The second stage is left in flight by start() so it can overlap with computation,
+ *  wait() completes it. Only one reduction can be in flight at a time.
+ *  Without MPI the buffer is copied to the result.
+ *  Construction, start() and destruction are collective over the communicator.
+ */
+class HierarchicalReducer
+{
+public:
+  using Real = QMCTraits::RealType;
+
+  HierarchicalReducer(Communicate& comm);
+  HierarchicalReducer(const HierarchicalReducer&) = delete;
+  ~HierarchicalReducer();
+
+  /** start the reduction of local, completing any reduction still in flight first.
+   *  local must have the same size on all the ranks.
+   */
+  void start(PooledData<Real>& local);
+
+  /** complete the reduction in flight.
+   *  \return true if a reduction was in flight, its sum is then in getResult() on rank 0
+   */
+  bool wait();
+
+  PooledData<Real>& getResult() { return result_; }
+
+  int getNumNodes() const { return num_nodes_; }
+
+private:
+  /// grow the shared memory window to hold n values per rank, collective over the node
+  void reserve(std::size_t n);
+
+  Communicate& comm_;
+  int num_nodes_  = 1;
+  bool in_flight_ = false;
+  /// sum over all the ranks, only meaningful on rank 0
+  PooledData<Real> result_;
+#ifdef HAVE_MPI
+  /// ranks sharing memory with this one
+  MPI_Comm node_comm_   = MPI_COMM_NULL;
+  /// rank 0 of every node, MPI_COMM_NULL on the other ranks
+  MPI_Comm leader_comm_ = MPI_COMM_NULL;
+  int node_rank_        = 0;
+  int node_size_        = 1;
+  MPI_Win window_       = MPI_WIN_NULL;
+  /// number of values per rank the window holds
+  std::size_t capacity_ = 0;
+  /// slot of every rank of the node in the window
+  std::vector<Real*> slots_;
+  /// node sum sent by the node leader, must stay untouched until the reduction completes
+  std::vector<Real> send_buffer_;
+  MPI_Request request_ = MPI_REQUEST_NULL;
+#endif
+};
+} // namespace qmcplusplus
+#endif
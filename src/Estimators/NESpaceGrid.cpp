@@ -178,6 +178,7 @@ void NESpaceGrid<REAL>::someMoreAxisGridStuff()
   ndomains_ = axis_grids[0].dimensions * axis_grids[1].dimensions * axis_grids[2].dimensions;
 
   data_.resize(ndomains_ * nvalues_per_domain_);
+  scatter_.resize(data_.size(), nvalues_per_domain_);
 
   volume_ = std::abs(det(axes_)) * 8.0; //axes span only one octant
   //compute domain volumes, centers, and widths
@@ -569,9 +570,25 @@ void NESpaceGrid<REAL>::accumulate(const ParticlePos& R,
                                    const Matrix<Real>& values,
                                    std::vector<bool>& particles_outside)
 {
-  int p, v;
+  accumulateDeferred(R, values, particles_outside);
+  applyDeferred();
+}
+
+template<typename REAL>
+void NESpaceGrid<REAL>::applyDeferred()
+{
+  scatter_.apply(data_.data());
+}
+
+template<typename REAL>
+void NESpaceGrid<REAL>::accumulateDeferred(const ParticlePos& R,
+                                           const Matrix<Real>& values,
+                                           std::vector<bool>& particles_outside)
+{
+  int p;
   int nparticles = values.size1();
   int nvalues    = values.size2();
+  assert(nvalues == nvalues_per_domain_);
   int iu[OHMMS_DIM];
   int buf_index;
   const Real o2pi = 1.0 / (2.0 * M_PI);
@@ -603,8 +620,7 @@ void NESpaceGrid<REAL>::accumulate(const ParticlePos& R,
         buf_index = buffer_offset_;
         for (int d = 0; d < OHMMS_DIM; ++d)
           buf_index += nvalues * dm_[d] * iu[d];
-        for (v = 0; v < nvalues; v++, buf_index++)
-          data_[buf_index] += values(p, v);
+        scatter_.add(buf_index, values[p]);
       }
     }
     else
@@ -620,8 +636,7 @@ void NESpaceGrid<REAL>::accumulate(const ParticlePos& R,
           iu[1]                = gmap_[1][floor((u[1] - umin_[1]) * odu_[1])];
           iu[2]                = gmap_[2][floor((u[2] - umin_[2]) * odu_[2])];
           buf_index            = buffer_offset_ + nvalues * (dm_[0] * iu[0] + dm_[1] * iu[1] + dm_[2] * iu[2]);
-          for (v = 0; v < nvalues; v++, buf_index++)
-            data_[buf_index] += values(p, v);
+          scatter_.add(buf_index, values[p]);
         }
       }
     }
@@ -639,8 +654,7 @@ void NESpaceGrid<REAL>::accumulate(const ParticlePos& R,
         iu[1]                = gmap_[1][floor((u[1] - umin_[1]) * odu_[1])];
         iu[2]                = gmap_[2][floor((u[2] - umin_[2]) * odu_[2])];
         buf_index            = buffer_offset_ + nvalues * (dm_[0] * iu[0] + dm_[1] * iu[1] + dm_[2] * iu[2]);
-        for (v = 0; v < nvalues; v++, buf_index++)
-          data_[buf_index] += values(p, v);
+        scatter_.add(buf_index, values[p]);
       }
     }
     break;
@@ -660,8 +674,7 @@ void NESpaceGrid<REAL>::accumulate(const ParticlePos& R,
         iu[1]                = gmap_[1][floor((u[1] - umin_[1]) * odu_[1])];
         iu[2]                = gmap_[2][floor((u[2] - umin_[2]) * odu_[2])];
         buf_index            = buffer_offset_ + nvalues * (dm_[0] * iu[0] + dm_[1] * iu[1] + dm_[2] * iu[2]);
-        for (v = 0; v < nvalues; v++, buf_index++)
-          data_[buf_index] += values(p, v);
+        scatter_.add(buf_index, values[p]);
       }
     }
     break;
@@ -701,7 +714,7 @@ void NESpaceGrid<REAL>::collect(NESpaceGrid& reduction_grid, RefVector<NESpaceGr
 template<typename REAL>
 void NESpaceGrid<REAL>::zero()
 {
-  data_.clear();
+  std::fill(data_.begin(), data_.end(), 0.0);
 }
 
 template<typename REAL>
@@ -28,6 +28,7 @@
 #include "QMCHamiltonians/ObservableHelper.h"
 #include "Particle/DistanceTable.h"
 #include "NEReferencePoints.h"
+#include "GridScatter.h"
 
 namespace qmcplusplus
 {
@@ -99,6 +100,16 @@ public:
 
   void accumulate(const ParticlePos& R, const Matrix<Real>& values, std::vector<bool>& particles_outside);
 
+  /** Like accumulate but the values are only recorded, they are added to the grid by applyDeferred.
+   *  This lets the owner batch all the walkers of a crowd, the recorded values are then
+   *  added to the grid binned by blocks of the grid, which keeps the writes in cache for large grids.
+   *  particles_outside is valid on return.
+   */
+  void accumulateDeferred(const ParticlePos& R, const Matrix<Real>& values, std::vector<bool>& particles_outside);
+
+  /// add the values recorded by accumulateDeferred to the grid
+  void applyDeferred();
+
   /** SpaceGridAccumulate not type erased and with its own particular interface.
    *  the composing class needs to provide the following to spave grid.
    *  \param[in]      R                    particle positions
@@ -243,6 +254,8 @@ private:
   int dm_[OHMMS_DIM];
   ReferenceEnergy reference_energy_;
   std::vector<Real> data_;
+  /// values recorded by accumulateDeferred not yet added to data_
+  GridScatter<Real> scatter_;
   std::shared_ptr<ObservableHelper> observable_helper_;
 
   struct IRPair
@@ -0,0 +1,234 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "PerParticleTrace.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include "Message/Communicate.h"
+
+namespace qmcplusplus
+{
+namespace
+{
+/// quantities taken from the particle set rather than from the listeners
+const std::unordered_set<std::string> particle_quantities{"R", "spin", "G", "L"};
+} // namespace
+
+PerParticleTrace::PerParticleTrace(PerParticleTraceInput&& input, const Communicate& comm)
+    : OperatorEstBase(DataLocality::crowd),
+      input_(std::move(input)),
+      comm_(comm),
+      selected_(input_.get_quantities().begin(), input_.get_quantities().end())
+{
+  my_name_ = input_.get_name();
+  // per-particle values of the hamiltonian are only evaluated when someone listens
+  requires_listener_ = selected_.empty() || std::any_of(selected_.begin(), selected_.end(), [](auto& quantity) {
+                         return particle_quantities.find(quantity) == particle_quantities.end();
+                       });
+}
+
+PerParticleTrace::PerParticleTrace(PerParticleTrace& rank_estimator, DataLocality dl)
+    : OperatorEstBase(dl),
+      input_(rank_estimator.input_),
+      comm_(rank_estimator.comm_),
+      rank_estimator_(makeOptionalRef(rank_estimator)),
+      selected_(rank_estimator.selected_)
+{
+  my_name_           = rank_estimator.my_name_;
+  requires_listener_ = rank_estimator.requires_listener_;
+}
+
+PerParticleTrace::~PerParticleTrace() = default;
+
+bool PerParticleTrace::isSelected(const std::string& quantity) const
+{
+  return selected_.empty() || selected_.find(quantity) != selected_.end();
+}
+
+ColumnLayout PerParticleTrace::makeLayout(const ParticleSet& pset)
+{
+  constexpr ColumnType real_type    = sizeof(Real) == sizeof(float) ? ColumnType::float32 : ColumnType::float64;
+  constexpr std::size_t value_width = sizeof(QMCTraits::ValueType) / sizeof(Real);
+  const std::size_t num_particles   = pset.getTotalNum();
+
+  ColumnLayout layout{{"block", ColumnType::int64, 1},
+                      {"step", ColumnType::int64, 1},
+                      {"walker_id", ColumnType::int64, 1},
+                      {"weight", ColumnType::float64, 1}};
+  trace_positions_  = isSelected("R");
+  trace_spins_      = isSelected("spin") && pset.isSpinor();
+  trace_gradients_  = isSelected("G");
+  trace_laplacians_ = isSelected("L");
+  if (trace_positions_)
+    layout.push_back({"R", real_type, num_particles * OHMMS_DIM});
+  if (trace_spins_)
+    layout.push_back({"spin", real_type, num_particles});
+  if (trace_gradients_)
+    layout.push_back({"G", real_type, num_particles * OHMMS_DIM * value_width});
+  if (trace_laplacians_)
+    layout.push_back({"L", real_type, num_particles * value_width});
+
+  // unordered_map order can differ between crowds, the layout cannot
+  auto addReported = [&](const CrowdValues& values, const std::string& suffix, std::vector<std::string>& columns) {
+    columns.clear();
+    for (auto& [name, walker_values] : values)
+      if (isSelected(name + suffix) && !walker_values.empty() && walker_values[0].size() > 0)
+        columns.push_back(name);
+    std::sort(columns.begin(), columns.end());
+    for (auto& name : columns)
+      layout.push_back({name + suffix, real_type, values.at(name)[0].size()});
+  };
+  addReported(electron_values_, "", electron_columns_);
+  addReported(ion_values_, "_ion", ion_columns_);
+
+  for (auto& quantity : selected_)
+    if (std::none_of(layout.begin(), layout.end(), [&quantity](auto& spec) { return spec.name == quantity; }))
+      throw std::runtime_error("PerParticleTrace::makeLayout " + quantity +
+                               " is not available. It is neither R, spin (spinor runs), G, L nor the name of a "
+                               "hamiltonian operator reporting per particle values, add _ion for per ion values.");
+  return layout;
+}
+
+void PerParticleTrace::accumulate(const RefVector<MCPWalker>& walkers,
+                                  const RefVector<ParticleSet>& psets,
+                                  const RefVector<TrialWaveFunction>& wfns,
+                                  const RefVector<QMCHamiltonian>& hams,
+                                  RandomBase<FullPrecRealType>& rng)
+{
+  const int step = step_++;
+  if (step % input_.get_step_period() != 0)
+    return;
+  if (!has_layout_)
+  {
+    chunk_      = ColumnChunk(makeLayout(psets[0]));
+    has_layout_ = true;
+  }
+
+  auto appendReported = [this](int column, const CrowdValues& values, const std::string& name, int iw) {
+    const auto& walker_values = values.at(name);
+    const std::size_t width   = chunk_.getLayout()[column].width;
+    if (iw >= walker_values.size() || walker_values[iw].size() != width)
+      throw std::runtime_error("PerParticleTrace::accumulate " + name + " was not reported with " +
+                               std::to_string(width) + " values for every walker");
+    chunk_.append(column, walker_values[iw].data(), width);
+  };
+
+  for (int iw = 0; iw < walkers.size(); ++iw)
+  {
+    const MCPWalker& walker = walkers[iw];
+    const ParticleSet& pset = psets[iw];
+    int column              = 0;
+    chunk_.append(column++, static_cast<std::int64_t>(block_));
+    chunk_.append(column++, static_cast<std::int64_t>(step));
+    chunk_.append(column++, static_cast<std::int64_t>(walker.getWalkerID()));
+    chunk_.append(column++, static_cast<double>(walker.Weight));
+    if (trace_positions_)
+      chunk_.append(column++, &pset.R[0][0], pset.R.size() * OHMMS_DIM);
+    if (trace_spins_)
+      chunk_.append(column++, pset.spins.data(), pset.spins.size());
+    if (trace_gradients_)
+      chunk_.append(column++, &pset.G[0][0], pset.G.size() * OHMMS_DIM);
+    if (trace_laplacians_)
+      chunk_.append(column++, pset.L.data(), pset.L.size());
+    for (auto& name : electron_columns_)
+      appendReported(column++, electron_values_, name, iw);
+    for (auto& name : ion_columns_)
+      appendReported(column++, ion_values_, name, iw);
+    walkers_weight_ += walker.Weight;
+  }
+
+  if (chunk_.bytes() >= static_cast<std::size_t>(input_.get_chunk_kb()) * 1024)
+    rank_estimator_->get().push(chunk_);
+}
+
+void PerParticleTrace::collect(const RefVector<OperatorEstBase>& type_erased_operator_estimators)
+{
+  for (OperatorEstBase& crowd_oeb : type_erased_operator_estimators)
+  {
+    auto& crowd_trace = dynamic_cast<PerParticleTrace&>(crowd_oeb);
+    if (crowd_trace.has_layout_)
+      push(crowd_trace.chunk_);
+  }
+  OperatorEstBase::collect(type_erased_operator_estimators);
+}
+
+void PerParticleTrace::push(ColumnChunk& chunk)
+{
+  if (chunk.rows() == 0)
+    return;
+  // the layout is only known once a crowd has seen the listeners report, crowds may get here concurrently
+  std::call_once(writer_created_, [this, &chunk] {
+    writer_ = std::make_unique<ColumnStreamWriter>(getFileName(), chunk.getLayout(), input_.get_compression());
+  });
+  writer_->push(chunk);
+}
+
+void PerParticleTrace::flush()
+{
+  if (writer_)
+    writer_->flush();
+}
+
+std::string PerParticleTrace::getFileName() const
+{
+  std::string file_name = comm_.getName().empty() ? input_.get_name() : comm_.getName() + "." + input_.get_name();
+  if (comm_.size() > 1)
+  {
+    std::array<char, 32> ptoken;
+    int length = std::snprintf(ptoken.data(), ptoken.size(), ".p%03d", comm_.rank());
+    if (length < 0)
+      throw std::runtime_error("Error generating filename");
+    file_name.append(ptoken.data(), length);
+  }
+  return file_name + ".col";
+}
+
+UPtr<OperatorEstBase> PerParticleTrace::spawnCrowdClone() const
+{
+  return std::make_unique<PerParticleTrace>(const_cast<PerParticleTrace&>(*this), data_locality_);
+}
+
+void PerParticleTrace::startBlock(int steps)
+{
+  ++block_;
+  step_ = 0;
+}
+
+ListenerVector<QMCTraits::RealType>::ReportingFunction PerParticleTrace::getElectronListener()
+{
+  auto& values = electron_values_;
+  return [&values](const int walker_index, const std::string& name, const Vector<Real>& input_values) {
+    auto& walker_values = values[name];
+    if (walker_index >= walker_values.size())
+      walker_values.resize(walker_index + 1);
+    walker_values[walker_index] = input_values;
+  };
+}
+
+ListenerVector<QMCTraits::RealType>::ReportingFunction PerParticleTrace::getIonListener()
+{
+  auto& values = ion_values_;
+  return [&values](const int walker_index, const std::string& name, const Vector<Real>& input_values) {
+    auto& walker_values = values[name];
+    if (walker_index >= walker_values.size())
+      walker_values.resize(walker_index + 1);
+    walker_values[walker_index] = input_values;
+  };
+}
+
+void PerParticleTrace::registerListeners(QMCHamiltonian& ham_leader)
+{
+  QMCHamiltonian::mw_registerLocalEnergyListener(ham_leader, ListenerVector<Real>(my_name_, getElectronListener()));
+  QMCHamiltonian::mw_registerLocalIonPotentialListener(ham_leader, ListenerVector<Real>(my_name_, getIonListener()));
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,117 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_PER_PARTICLE_TRACE_H
+#define QMCPLUSPLUS_PER_PARTICLE_TRACE_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include "OperatorEstBase.h"
+#include "PerParticleTraceInput.h"
+#include "ColumnStream.h"
+#include "QMCHamiltonians/Listener.hpp"
+#include "type_traits/OptionalRef.hpp"
+
+class Communicate;
+
+namespace qmcplusplus
+{
+/** Traces per-particle quantities of every walker to a columnar file for the batched drivers.
+ *
+ *  Each row of the trace is one walker at one sampled step. The columns are
+ *    block, step, walker_id, weight  always
+ *    R, spin, G, L                   positions, spins (spinor runs only), gradients and laplacians of log(psi)
+ *    <operator>                      per-electron values reported by the Hamiltonian operators to listeners
+ *    <operator>_ion                  per-ion values reported by the Hamiltonian operators to listeners
+ *  restricted to the quantities of the input when given.
+ *
+ *  The crowd clones append rows to their own ColumnChunk, nothing is shared while a block runs.
+ *  Whenever a chunk reaches chunk_kb, and at the end of each block, it is handed to the rank estimator's
+ *  ColumnStreamWriter which compresses and writes it on a background thread.
+ *  The file of a rank is <project>[.p<rank>].<name>.col, see ColumnStream.h for its layout.
+ *
+ *  There is nothing to reduce over ranks, data_ stays empty.
+ */
+class PerParticleTrace : public OperatorEstBase
+{
+public:
+  using Real        = QMCTraits::RealType;
+  using CrowdValues = CrowdEnergyValues<Real>;
+
+  PerParticleTrace(PerParticleTraceInput&& input, const Communicate& comm);
+  /// crowd clone constructor
+  PerParticleTrace(PerParticleTrace& rank_estimator, DataLocality dl);
+  ~PerParticleTrace() override;
+
+  void accumulate(const RefVector<MCPWalker>& walkers,
+                  const RefVector<ParticleSet>& psets,
+                  const RefVector<TrialWaveFunction>& wfns,
+                  const RefVector<QMCHamiltonian>& hams,
+                  RandomBase<FullPrecRealType>& rng) override;
+
+  /// hands the rows the crowd clones still hold to the writer
+  void collect(const RefVector<OperatorEstBase>& type_erased_operator_estimators) override;
+
+  UPtr<OperatorEstBase> spawnCrowdClone() const override;
+  void startBlock(int steps) override;
+
+  void registerListeners(QMCHamiltonian& ham_leader) override;
+  /** return lambdas to register as listeners
+   *  the purpose of these functions is to factor out the production of the lambda for unit testing
+   */
+  ListenerVector<Real>::ReportingFunction getElectronListener();
+  ListenerVector<Real>::ReportingFunction getIonListener();
+
+  /// on the rank estimator, block until everything handed to the writer is in the file
+  void flush();
+
+  /// name of the file of this rank
+  std::string getFileName() const;
+
+private:
+  /// hand chunk to the writer of the rank, creating the writer on first use
+  void push(ColumnChunk& chunk);
+  /// pick the columns from what the particle set and the listeners provide at the first sampled step
+  ColumnLayout makeLayout(const ParticleSet& pset);
+  bool isSelected(const std::string& quantity) const;
+
+  const PerParticleTraceInput input_;
+  const Communicate& comm_;
+  const OptionalRef<PerParticleTrace> rank_estimator_;
+  /// quantities requested in the input, all when empty
+  const std::unordered_set<std::string> selected_;
+
+  /// crowd scope
+  ///@{
+  CrowdValues electron_values_;
+  CrowdValues ion_values_;
+  ColumnChunk chunk_;
+  bool has_layout_       = false;
+  bool trace_positions_  = false;
+  bool trace_spins_      = false;
+  bool trace_gradients_  = false;
+  bool trace_laplacians_ = false;
+  std::vector<std::string> electron_columns_;
+  std::vector<std::string> ion_columns_;
+  int block_ = -1;
+  int step_  = 0;
+  ///@}
+
+  /// rank scope
+  ///@{
+  std::once_flag writer_created_;
+  std::unique_ptr<ColumnStreamWriter> writer_;
+  ///@}
+};
+
+} // namespace qmcplusplus
+#endif
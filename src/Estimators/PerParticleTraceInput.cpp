@@ -0,0 +1,38 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "PerParticleTraceInput.h"
+#include "EstimatorInput.h"
+
+namespace qmcplusplus
+{
+PerParticleTraceInput::PerParticleTraceInput(xmlNodePtr cur)
+{
+  input_section_.readXML(cur);
+  auto setIfInInput = LAMBDA_setIfInInput;
+  setIfInInput(name_, "name");
+  setIfInInput(quantities_, "quantities");
+  setIfInInput(step_period_, "step_period");
+  setIfInInput(chunk_kb_, "chunk_kb");
+  setIfInInput(compression_, "compression");
+}
+
+void PerParticleTraceInput::PerParticleTraceInputSection::checkParticularValidity()
+{
+  const std::string error_tag{"PerParticleTrace input: "};
+  if (has("step_period") && get<int>("step_period") < 1)
+    throw UniformCommunicateError(error_tag + "step_period must be at least 1");
+  if (has("chunk_kb") && get<int>("chunk_kb") < 1)
+    throw UniformCommunicateError(error_tag + "chunk_kb must be at least 1");
+  if (has("compression") && (get<int>("compression") < 0 || get<int>("compression") > 9))
+    throw UniformCommunicateError(error_tag + "compression must be a zlib level from 0 to 9");
+}
+} // namespace qmcplusplus
@@ -0,0 +1,69 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_PER_PARTICLE_TRACE_INPUT_H
+#define QMCPLUSPLUS_PER_PARTICLE_TRACE_INPUT_H
+
+#include "Configuration.h"
+#include "InputSection.h"
+
+namespace qmcplusplus
+{
+class PerParticleTrace;
+
+/** Native representation for PerParticleTrace inputs
+ */
+class PerParticleTraceInput
+{
+public:
+  using Consumer = PerParticleTrace;
+
+  class PerParticleTraceInputSection : public InputSection
+  {
+  public:
+    PerParticleTraceInputSection()
+    {
+      // clang-format off
+      section_name  = "PerParticleTrace";
+      attributes    = {"type", "name", "quantities", "step_period", "chunk_kb", "compression"};
+      strings       = {"type", "name"};
+      multi_strings = {"quantities"};
+      integers      = {"step_period", "chunk_kb", "compression"};
+      // clang-format on
+    }
+    PerParticleTraceInputSection(const PerParticleTraceInputSection& other) = default;
+    void checkParticularValidity() override;
+  };
+
+  PerParticleTraceInput(xmlNodePtr cur);
+  /** default copy constructor
+   *  This is required due to PPTI being part of a variant used as a vector element.
+   */
+  PerParticleTraceInput(const PerParticleTraceInput& other) = default;
+
+  const std::string& get_name() const { return name_; }
+  /// the selected columns, all the available ones when empty
+  const std::vector<std::string>& get_quantities() const { return quantities_; }
+  int get_step_period() const { return step_period_; }
+  /// size of the rows a crowd hands to the writer at once
+  int get_chunk_kb() const { return chunk_kb_; }
+  int get_compression() const { return compression_; }
+
+private:
+  PerParticleTraceInputSection input_section_;
+  std::string name_ = "particle_trace";
+  std::vector<std::string> quantities_;
+  int step_period_ = 1;
+  int chunk_kb_    = 4096;
+  int compression_ = 1;
+};
+} // namespace qmcplusplus
+#endif
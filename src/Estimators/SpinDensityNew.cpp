@@ -14,6 +14,8 @@
 
 #include "hdf5.h"
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <numeric>
 #include <SpeciesSet.h>
@@ -25,9 +27,7 @@ SpinDensityNew::SpinDensityNew(SpinDensityInput&& input, const SpeciesSet& speci
 {
   my_name_ = "SpinDensity";
 
-  data_locality_ = DataLocality::crowd;
-  if (input_.get_save_memory())
-    dl = DataLocality::rank;
+  data_locality_ = input_.get_save_memory() ? DataLocality::rank : dl;
 
   if (input_.get_cell().explicitly_defined == true)
     lattice_ = input_.get_cell();
@@ -38,6 +38,7 @@ SpinDensityNew::SpinDensityNew(SpinDensityInput&& input, const SpeciesSet& speci
   derived_parameters_ = input_.calculateDerivedParameters(lattice_);
 
   data_.resize(getFullDataSize(), 0.0);
+  scatter_.resize(getFullDataSize());
 
   if (input_.get_write_report())
     report("  ");
@@ -54,11 +55,12 @@ SpinDensityNew::SpinDensityNew(SpinDensityInput&& input,
       lattice_(lattice)
 {
   my_name_       = "SpinDensity";
-  data_locality_ = dl;
+  data_locality_ = input_.get_save_memory() ? DataLocality::rank : dl;
   if (input_.get_cell().explicitly_defined == true)
     lattice_ = input_.get_cell();
   derived_parameters_ = input_.calculateDerivedParameters(lattice_);
   data_.resize(getFullDataSize());
+  scatter_.resize(getFullDataSize());
   if (input_.get_write_report())
     report("  ");
 }
@@ -83,32 +85,32 @@ size_t SpinDensityNew::getFullDataSize() const { return species_.size() * derive
 
 std::unique_ptr<OperatorEstBase> SpinDensityNew::spawnCrowdClone() const
 {
-  std::size_t data_size    = data_.size();
-  auto spawn_data_locality = data_locality_;
-  if (data_locality_ == DataLocality::rank)
-  {
-    spawn_data_locality = DataLocality::queue;
-    // at construction we don't know what the data requirement is going to be
-    // since its steps per block  dependent. so start with 10 steps worth.
-    int num_particles = std::accumulate(species_size_.begin(), species_size_.end(), 0);
-    data_size         = num_particles * 20;
-  }
-  UPtr<SpinDensityNew> spawn(std::make_unique<SpinDensityNew>(*this, spawn_data_locality));
-  spawn->get_data().resize(data_size);
+  // crowd clones queue (point, weight) entries, they only get a copy of the density grid when the
+  // queue reaches the grid size, see flushQueue.
+  // at construction we don't know what the data requirement is going to be
+  // since its steps per block  dependent. so start with 10 steps worth.
+  int num_particles = std::accumulate(species_size_.begin(), species_size_.end(), 0);
+  UPtr<SpinDensityNew> spawn(std::make_unique<SpinDensityNew>(*this, DataLocality::queue));
+  spawn->scatter_.reserve(std::min<size_t>(num_particles * 10, getFullDataSize()));
   return spawn;
 }
 
 void SpinDensityNew::startBlock(int steps)
 {
-  if (data_locality_ == DataLocality::rank)
+  if (data_locality_ == DataLocality::queue)
   {
     int num_particles = std::accumulate(species_size_.begin(), species_size_.end(), 0);
-    size_t data_size  = num_particles * steps * 2;
-    data_.reserve(data_size);
-    data_.resize(0);
+    scatter_.reserve(std::min<size_t>(num_particles * steps, getFullDataSize()));
   }
 }
 
+void SpinDensityNew::flushQueue()
+{
+  if (data_.empty())
+    data_.resize(getFullDataSize(), 0.0);
+  scatter_.apply(data_.data());
+}
+
 /** Gets called every step and writes to thread local data.
  *
  *  I tried for readable and not doing the optimizers job.
@@ -129,6 +131,8 @@ void SpinDensityNew::accumulate(const RefVector<MCPWalker>& walkers,
     assert(weight >= 0);
     // for testing
     walkers_weight_ += weight;
+    // grid points of all the particles first, free of the writes into the grid
+    points_.resize(pset.getTotalNum());
     int p         = 0;
     size_t offset = 0;
     for (int s = 0; s < species_.size(); ++s, offset += dp_.npoints)
@@ -138,21 +142,22 @@ void SpinDensityNew::accumulate(const RefVector<MCPWalker>& walkers,
         size_t point    = offset;
         for (int d = 0; d < QMCT::DIM; ++d)
           point += dp_.gdims[d] * ((int)(dp_.grid[d] * (u[d] - std::floor(u[d])))); //periodic only
-        accumulateToData(point, weight);
+        points_[p] = point;
       }
+    for (int ip = 0; ip < p; ++ip)
+      accumulateToData(points_[ip], weight);
+    if (data_locality_ == DataLocality::queue && scatter_.size() >= getFullDataSize())
+      flushQueue();
   }
+  if (data_locality_ == DataLocality::crowd)
+    scatter_.apply(data_.data());
 }
 
 void SpinDensityNew::accumulateToData(size_t point, QMCT::RealType weight)
 {
-  if (data_locality_ == DataLocality::crowd)
-  {
-    data_[point] += weight;
-  }
-  else if (data_locality_ == DataLocality::queue)
+  if (data_locality_ == DataLocality::crowd || data_locality_ == DataLocality::queue)
   {
-    data_.push_back(point);
-    data_.push_back(weight);
+    scatter_.add(point, weight);
   }
   else
   {
@@ -162,7 +167,7 @@ void SpinDensityNew::accumulateToData(size_t point, QMCT::RealType weight)
 
 void SpinDensityNew::collect(const RefVector<OperatorEstBase>& type_erased_operator_estimators)
 {
-  if (data_locality_ == DataLocality::rank)
+  if (data_locality_ == DataLocality::rank || data_locality_ == DataLocality::crowd)
   {
     for (OperatorEstBase& crowd_oeb : type_erased_operator_estimators)
     {
@@ -174,22 +179,17 @@ void SpinDensityNew::collect(const RefVector<OperatorEstBase>& type_erased_opera
 #else
       auto& oeb = static_cast<SpinDensityNew&>(crowd_oeb);
 #endif
-      auto& data = oeb.get_data();
-      for (int id = 0; id < data.size(); id += 2)
+      oeb.scatter_.apply(data_.data(), true);
+      // the grid copy of a crowd whose queue was flushed is kept for the next block
+      if (!oeb.data_.empty())
       {
-        // This is a smell
-        size_t point{static_cast<size_t>(data[id])};
-        const QMCT::RealType weight{data[id + 1]};
-        data_[point] += weight;
-        walkers_weight_ += weight;
+        std::transform(data_.begin(), data_.end(), oeb.data_.begin(), data_.begin(), std::plus<>{});
+        std::fill(oeb.data_.begin(), oeb.data_.end(), 0.0);
       }
-      oeb.zero();
+      walkers_weight_ += oeb.walkers_weight_;
+      oeb.walkers_weight_ = 0;
     }
   }
-  else if (data_locality_ == DataLocality::crowd)
-  {
-    OperatorEstBase::collect(type_erased_operator_estimators);
-  }
   else
   {
     throw std::runtime_error("You cannot call collect on a SpinDensityNew with this DataLocality");
@@ -18,6 +18,7 @@
 
 #include "Configuration.h"
 #include "OperatorEstBase.h"
+#include "GridScatter.h"
 #include "Containers/OhmmsPETE/TinyVector.h"
 
 namespace qmcplusplus
@@ -81,6 +82,10 @@ public:
   std::unique_ptr<OperatorEstBase> spawnCrowdClone() const override;
 
   /** accumulate 1 or more walkers of SpinDensity samples
+   *
+   *  The grid points of all the particles of all the walkers are computed first,
+   *  with DataLocality::queue, i.e. crowd clones, they are queued until the collect or the queue reaches the grid size.
+   *  With DataLocality::crowd they are added to the grid binned by blocks of grid points.
    */
   void accumulate(const RefVector<MCPWalker>& walkers,
                   const RefVector<ParticleSet>& psets,
@@ -91,18 +96,12 @@ public:
   /** this allows the EstimatorManagerNew to reduce without needing to know the details
    *  of SpinDensityNew's data.
    *
-   *  can use base class default until crowd level SpinDensity
-   *  estimators don't have a copy of the density grid.
+   *  With DataLocality::rank or crowd the crowd clones queue (point, weight) pairs, the queue of each
+   *  crowd is binned by blocks of grid points and the blocks are added by OpenMP threads, each owning a
+   *  disjoint part of the grid. Only a crowd whose queue reached the grid size holds a copy of the density grid.
    */
   void collect(const RefVector<OperatorEstBase>& operator_estimators) override;
 
-  /** this allows the EstimatorManagerNew to reduce without needing to know the details
-   *  of SpinDensityNew's data.
-   *
-   *  can use base class default until crowd level SpinDensity estimators don't have a copy of the density grid.
-   */
-  //void collect(const OperatorEstBase&  oeb);
-
   /** this gets us into the hdf5 file
    *
    *  Just parroting for now don't fully understand.
@@ -119,6 +118,11 @@ private:
    */
   size_t getFullDataSize() const override;
   void accumulateToData(size_t point, QMCT::RealType weight);
+  /** add the queue of a crowd clone to its own copy of the grid, allocated at the first flush
+   *  The queue is flushed when it reaches the grid size, so it is bounded whatever the steps, walkers and particles
+   *  of a block, and a grid copy is only held by crowds accumulating more entries than grid points.
+   */
+  void flushQueue();
   void reset();
   void report(const std::string& pad);
 
@@ -140,6 +144,13 @@ private:
   SpinDensityInput::DerivedParameters derived_parameters_;
   /**}@*/
 
+  /// grid point of each particle of the walker being accumulated
+  std::vector<size_t> points_;
+  /** (point, weight) entries waiting to be added to a grid, those of a batch of walkers for DataLocality::crowd
+   *  or those since the last flushQueue or collect for the DataLocality::queue of a crowd clone
+   */
+  GridScatter<QMCT::RealType> scatter_;
+
   friend class testing::SpinDensityNewTests;
 };
 
@@ -0,0 +1,142 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+#include "ColumnStream.h"
+#include <atomic>
+#include <filesystem>
+#include <numeric>
+
+namespace qmcplusplus
+{
+
+TEST_CASE("ColumnStream_roundtrip", "[estimators]")
+{
+  const ColumnLayout layout{{"id", ColumnType::int64, 1},
+                            {"pos", ColumnType::float32, 3},
+                            {"val", ColumnType::float64, 2}};
+  const std::string file_name("test_column_stream.col");
+  constexpr int nthreads          = 4;
+  constexpr int chunks_per_thread = 5;
+  constexpr int rows_per_chunk    = 100;
+  constexpr int nrows             = nthreads * chunks_per_thread * rows_per_chunk;
+
+  for (int level : {0, 1})
+  {
+    {
+      // a small queue limit makes the producers wait on the writer
+      ColumnStreamWriter writer(file_name, layout, level, 4096);
+      // catch assertions are not thread safe, the producers only count
+      std::atomic<int> bad_chunks{0};
+      std::vector<std::thread> producers;
+      for (int it = 0; it < nthreads; ++it)
+        producers.emplace_back([&, it] {
+          ColumnChunk chunk(layout);
+          for (int ic = 0; ic < chunks_per_thread; ++ic)
+          {
+            for (int ir = 0; ir < rows_per_chunk; ++ir)
+            {
+              const int id = (it * chunks_per_thread + ic) * rows_per_chunk + ir;
+              const double pos[3]{id + 0.25, id + 0.5, id + 0.75};
+              const double val[2]{-id / 3.0, id / 7.0};
+              chunk.append(0, id);
+              chunk.append(1, pos, 3);
+              chunk.append(2, val, 2);
+            }
+            if (chunk.rows() != rows_per_chunk)
+              ++bad_chunks;
+            writer.push(chunk);
+            if (chunk.rows() != 0 || !(chunk.getLayout() == layout))
+              ++bad_chunks;
+          }
+        });
+      for (auto& producer : producers)
+        producer.join();
+      CHECK(bad_chunks == 0);
+      writer.flush();
+      CHECK(writer.getRowsWritten() == nrows);
+    }
+
+    ColumnStreamReader reader(file_name);
+    CHECK(reader.getLayout() == layout);
+    CHECK(reader.findColumn("pos") == 1);
+    CHECK(reader.findColumn("nothing") == -1);
+
+    std::size_t rows = 0;
+    auto ids         = reader.readColumn<std::int64_t>("id", rows);
+    REQUIRE(rows == nrows);
+    auto pos = reader.readColumn<float>("pos", rows);
+    REQUIRE(pos.size() == nrows * 3);
+    auto val = reader.readColumn<double>("val", rows);
+    REQUIRE(val.size() == nrows * 2);
+
+    // chunks arrive in any order, rows within a chunk stay together
+    std::vector<int> seen(nrows, 0);
+    for (int ir = 0; ir < nrows; ++ir)
+    {
+      const auto id = ids[ir];
+      REQUIRE(id >= 0);
+      REQUIRE(id < nrows);
+      ++seen[id];
+      CHECK(pos[3 * ir] == Approx(id + 0.25));
+      CHECK(pos[3 * ir + 2] == Approx(id + 0.75));
+      CHECK(val[2 * ir] == -id / 3.0);
+      CHECK(val[2 * ir + 1] == id / 7.0);
+    }
+    CHECK(std::accumulate(seen.begin(), seen.end(), 0) == nrows);
+    CHECK(*std::min_element(seen.begin(), seen.end()) == 1);
+  }
+  std::filesystem::remove(file_name);
+}
+
+TEST_CASE("ColumnStream_rate_limit", "[estimators]")
+{
+  const std::string file_name("test_column_stream_rate.col");
+  const ColumnLayout layout{{"x", ColumnType::float64, 1024}};
+  // 10 chunks of 80 kB at 4 MB/s take at least 0.18 s, the first write starts right away
+  auto limiter     = std::make_shared<ColumnRateLimiter>(4.0e6);
+  const auto start = std::chrono::steady_clock::now();
+  {
+    ColumnStreamWriter writer(file_name, layout, 0, std::size_t(256) << 20, limiter);
+    ColumnChunk chunk(layout);
+    std::vector<double> x(1024, 1.0);
+    for (int ic = 0; ic < 10; ++ic)
+    {
+      for (int ir = 0; ir < 10; ++ir)
+        chunk.append(0, x.data(), x.size());
+      writer.push(chunk);
+    }
+    writer.flush();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  CHECK(elapsed.count() > 0.18);
+  std::filesystem::remove(file_name);
+  CHECK_THROWS_AS(ColumnRateLimiter(0), std::runtime_error);
+}
+
+TEST_CASE("ColumnStream_layout_mismatch", "[estimators]")
+{
+  const std::string file_name("test_column_stream_mismatch.col");
+  {
+    ColumnStreamWriter writer(file_name, {{"a", ColumnType::float64, 1}});
+    ColumnChunk chunk({{"b", ColumnType::float64, 1}});
+    chunk.append(0, 1.0);
+    CHECK_THROWS_AS(writer.push(chunk), std::runtime_error);
+  }
+  ColumnStreamReader reader(file_name);
+  std::size_t rows = 1;
+  CHECK(reader.readColumn<double>("a", rows).empty());
+  CHECK(rows == 0);
+  CHECK_THROWS_AS(reader.readColumn<double>("b", rows), std::runtime_error);
+  std::filesystem::remove(file_name);
+}
+
+} // namespace qmcplusplus
@@ -85,6 +85,37 @@ TEST_CASE("EstimatorManagerInput::readXML", "[estimators]")
   CHECK_THROWS_AS(EstimatorManagerInput(estimators_doc.getRoot()), UniformCommunicateError);
 }
 
+TEST_CASE("EstimatorManagerInput::readXML reduction attributes", "[estimators]")
+{
+  using Reduction = EstimatorManagerInput::OperatorReduction;
+  {
+    EstimatorManagerInput emi;
+    CHECK(emi.get_operator_reduction() == Reduction::blocking);
+    CHECK(emi.get_operator_reduce_period() == 1);
+  }
+
+  Libxml2Document global_doc;
+  REQUIRE(global_doc.parseFromString(R"XML(<estimators reduction="Hierarchical" operator_reduce_period="4"/>)XML"));
+  EstimatorManagerInput global_emi(global_doc.getRoot());
+  CHECK(global_emi.get_operator_reduction() == Reduction::hierarchical);
+  CHECK(global_emi.get_operator_reduce_period() == 4);
+
+  // attributes set by a later input override earlier ones, unset attributes are kept
+  Libxml2Document local_doc;
+  REQUIRE(local_doc.parseFromString(R"XML(<estimators operator_reduce_period="2"/>)XML"));
+  EstimatorManagerInput local_emi(local_doc.getRoot());
+  EstimatorManagerInput merged_emi({global_emi, local_emi});
+  CHECK(merged_emi.get_operator_reduction() == Reduction::hierarchical);
+  CHECK(merged_emi.get_operator_reduce_period() == 2);
+
+  Libxml2Document bad_reduction;
+  REQUIRE(bad_reduction.parseFromString(R"XML(<estimators reduction="eventually"/>)XML"));
+  CHECK_THROWS_AS(EstimatorManagerInput(bad_reduction.getRoot()), UniformCommunicateError);
+  Libxml2Document bad_period;
+  REQUIRE(bad_period.parseFromString(R"XML(<estimators operator_reduce_period="0"/>)XML"));
+  CHECK_THROWS_AS(EstimatorManagerInput(bad_period.getRoot()), UniformCommunicateError);
+}
+
 template<class INPUT>
 class TakesAMovedInput
 {
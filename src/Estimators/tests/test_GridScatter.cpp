@@ -0,0 +1,63 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+#include "GridScatter.h"
+#include <random>
+
+namespace qmcplusplus
+{
+
+TEST_CASE("GridScatter", "[estimators]")
+{
+  // several blocks with a partial last block
+  const std::size_t grid_size = 5 * (std::size_t(1) << GridScatter<double>::block_bits) + 17;
+  std::mt19937 engine(7);
+
+  for (int nv : {1, 3})
+    for (bool parallel : {false, true})
+    {
+      std::uniform_int_distribution<std::size_t> index_dist(0, grid_size / nv - 1);
+      std::uniform_real_distribution<double> value_dist(-1.0, 1.0);
+      GridScatter<double> scatter(grid_size, nv);
+      std::vector<double> grid(grid_size, 1.0);
+      std::vector<double> reference(grid_size, 1.0);
+      std::vector<double> values(nv);
+      for (int i = 0; i < 10000; ++i)
+      {
+        // entries aligned to nv like the grids of NESpaceGrid, with repeats
+        const std::size_t index = index_dist(engine) * nv;
+        for (int v = 0; v < nv; ++v)
+        {
+          values[v] = value_dist(engine);
+          reference[index + v] += values[v];
+        }
+        if (nv == 1)
+          scatter.add(index, values[0]);
+        else
+          scatter.add(index, values.data());
+      }
+      CHECK(scatter.size() == 10000);
+      scatter.apply(grid.data(), parallel);
+      CHECK(scatter.size() == 0);
+      for (std::size_t i = 0; i < grid_size; ++i)
+        if (grid[i] != Approx(reference[i]))
+        {
+          FAIL_CHECK("grid " << grid[i] << " != reference " << reference[i] << " at index " << i);
+          break;
+        }
+      // nothing recorded, nothing changes
+      scatter.apply(grid.data(), parallel);
+      CHECK(grid[0] == Approx(reference[0]));
+    }
+}
+
+} // namespace qmcplusplus
@@ -311,6 +311,90 @@ TEST_CASE("SpaceGrid::Basic", "[estimators]")
   CHECK(tensorAccessor(grid_data, 17, 12, 9, 2) == Approx(5.2));
 }
 
+TEST_CASE("SpaceGrid::collect", "[estimators]")
+{
+  using Input = testing::ValidSpaceGridInput;
+  Communicate* comm;
+  comm = OHMMS::Controller;
+  testing::SpaceGridEnv<Input::valid::ORIGIN> sge(comm);
+  int num_values = 3;
+  NESpaceGrid<Real> rank_grid(*(sge.sgi_), sge.ref_points_->get_points(), num_values, true);
+  NESpaceGrid<Real> crowd_grid(*(sge.sgi_), sge.ref_points_->get_points(), num_values, true);
+  using NES = testing::NESpaceGridTests<double>;
+
+  Matrix<Real> values;
+  values.resize(sge.pset_elec_.getTotalNum(), num_values);
+  for (int ip = 0; ip < sge.pset_elec_.getTotalNum(); ++ip)
+    for (int iv = 0; iv < num_values; ++iv)
+      values(ip, iv) = ip + 0.1 * iv;
+
+  const int ei_tid = sge.pset_elec_.addTable(sge.pset_ions_);
+  sge.pset_elec_.update();
+  sge.pset_ions_.update();
+
+  std::vector<bool> p_outside(8, false);
+  crowd_grid.accumulate(sge.pset_elec_.R, values, p_outside, sge.pset_elec_.getDistTableAB(ei_tid));
+  const auto accumulated = NES::getData(crowd_grid);
+
+  // the crowd grid keeps its size and is zeroed by the collect, so it can accumulate the next block
+  NESpaceGrid<Real>::collect(rank_grid, {crowd_grid});
+  CHECK(NES::getData(crowd_grid).size() == accumulated.size());
+  CHECK(std::all_of(NES::getData(crowd_grid).begin(), NES::getData(crowd_grid).end(),
+                    [](Real value) { return value == 0.0; }));
+
+  crowd_grid.accumulate(sge.pset_elec_.R, values, p_outside, sge.pset_elec_.getDistTableAB(ei_tid));
+  NESpaceGrid<Real>::collect(rank_grid, {crowd_grid});
+  const auto& rank_data = NES::getData(rank_grid);
+  REQUIRE(rank_data.size() == accumulated.size());
+  for (int i = 0; i < rank_data.size(); ++i)
+    CHECK(rank_data[i] == Approx(2 * accumulated[i]));
+}
+
+TEST_CASE("SpaceGrid::accumulateDeferred", "[estimators]")
+{
+  using Input = testing::ValidSpaceGridInput;
+  Communicate* comm;
+  comm = OHMMS::Controller;
+  testing::SpaceGridEnv<Input::valid::ORIGIN> sge(comm);
+  int num_values = 3;
+  NESpaceGrid<Real> space_grid(*(sge.sgi_), sge.ref_points_->get_points(), num_values, true);
+  NESpaceGrid<Real> deferred_grid(*(sge.sgi_), sge.ref_points_->get_points(), num_values, true);
+  using NES = testing::NESpaceGridTests<double>;
+
+  Matrix<Real> values;
+  values.resize(sge.pset_elec_.getTotalNum(), num_values);
+  for (int ip = 0; ip < sge.pset_elec_.getTotalNum(); ++ip)
+    for (int iv = 0; iv < num_values; ++iv)
+      values(ip, iv) = ip + 0.1 * iv;
+
+  // two walkers, the second with two particles moved
+  auto walker_R = sge.pset_elec_.R;
+  walker_R[1]   = {0.09710352868, -0.76751858, -1.89306891};
+  walker_R[4]   = {-0.5605484247, -0.9578875303, 1.476860642};
+  std::vector<bool> p_outside(8, false), p_outside_deferred(8, false);
+  for (const auto& R : {sge.pset_elec_.R, walker_R})
+  {
+    space_grid.accumulate(R, values, p_outside);
+    deferred_grid.accumulateDeferred(R, values, p_outside_deferred);
+    CHECK(p_outside_deferred == p_outside);
+  }
+
+  // nothing is added to the grid until applyDeferred
+  const auto& deferred_data = NES::getData(deferred_grid);
+  CHECK(std::all_of(deferred_data.begin(), deferred_data.end(), [](Real value) { return value == 0.0; }));
+  deferred_grid.applyDeferred();
+  const auto& data = NES::getData(space_grid);
+  CHECK(std::any_of(data.begin(), data.end(), [](Real value) { return value != 0.0; }));
+  REQUIRE(deferred_data.size() == data.size());
+  for (int i = 0; i < data.size(); ++i)
+    CHECK(deferred_data[i] == Approx(data[i]));
+
+  // the recorded values were consumed
+  deferred_grid.applyDeferred();
+  for (int i = 0; i < data.size(); ++i)
+    CHECK(deferred_data[i] == Approx(data[i]));
+}
+
 TEST_CASE("SpaceGrid::Accumulate::outside", "[estimators]")
 {
   using Input = testing::ValidSpaceGridInput;
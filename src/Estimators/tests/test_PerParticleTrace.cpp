@@ -0,0 +1,209 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "PerParticleTrace.h"
+
+#include <filesystem>
+
+#include "Message/Communicate.h"
+#include "Utilities/StdRandom.h"
+
+namespace qmcplusplus
+{
+
+namespace
+{
+using Real = QMCTraits::RealType;
+
+/// reports per particle values like the hamiltonian operators do, values encode walker and particle
+class TraceTalker
+{
+public:
+  TraceTalker(const std::string& name, int walkers, int size) : name_(name), walkers_(walkers), size_(size) {}
+  void registerVector(const ListenerVector<Real>& listener_vector) { listener_vectors_.push_back(listener_vector); }
+  void reportVector()
+  {
+    Vector<Real> values(size_);
+    for (auto& listener : listener_vectors_)
+      for (int iw = 0; iw < walkers_; ++iw)
+      {
+        std::iota(values.begin(), values.end(), iw * 10);
+        listener.report(iw, name_, values);
+      }
+  }
+
+private:
+  std::vector<ListenerVector<Real>> listener_vectors_;
+  const std::string name_;
+  const int walkers_;
+  const int size_;
+};
+
+PerParticleTraceInput makeInput(std::string_view xml)
+{
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(xml);
+  REQUIRE(okay);
+  return PerParticleTraceInput(doc.getRoot());
+}
+
+/** run nblocks blocks of nsteps steps with ncrowds crowds of nwalkers walkers each
+ *  \return the name of the trace file
+ */
+std::string runTrace(PerParticleTraceInput&& input, int ncrowds, int nwalkers, int nblocks, int nsteps)
+{
+  Communicate* comm = OHMMS::Controller;
+  PerParticleTrace rank_trace(std::move(input), *comm);
+  const std::string file_name = rank_trace.getFileName();
+
+  UPtrVector<OperatorEstBase> crowd_traces;
+  for (int ic = 0; ic < ncrowds; ++ic)
+    crowd_traces.emplace_back(rank_trace.spawnCrowdClone());
+
+  const SimulationCell simulation_cell;
+  std::vector<OperatorEstBase::MCPWalker> walkers;
+  std::vector<ParticleSet> psets;
+  for (int iw = 0; iw < nwalkers; ++iw)
+  {
+    walkers.emplace_back(iw, iw, 2);
+    psets.emplace_back(simulation_cell);
+    ParticleSet& pset = psets.back();
+    pset.create({2});
+    pset.R[0] = ParticleSet::PosType(iw, 0.0, 0.0);
+    pset.R[1] = ParticleSet::PosType(iw, 1.0, 2.0);
+    pset.G    = 0.0;
+    pset.L    = 0.0;
+  }
+  std::vector<TrialWaveFunction> wfns;
+  std::vector<QMCHamiltonian> hams;
+  auto ref_walkers = makeRefVector<OperatorEstBase::MCPWalker>(walkers);
+  auto ref_psets   = makeRefVector<ParticleSet>(psets);
+  auto ref_wfns    = makeRefVector<TrialWaveFunction>(wfns);
+  auto ref_hams    = makeRefVector<QMCHamiltonian>(hams);
+
+  std::vector<TraceTalker> electron_talkers{{"Kinetic", nwalkers, 2}, {"ElecElec", nwalkers, 2}};
+  TraceTalker ion_talker("ElecIon", nwalkers, 1);
+  for (auto& crowd_oeb : crowd_traces)
+  {
+    auto& crowd_trace = dynamic_cast<PerParticleTrace&>(*crowd_oeb);
+    for (auto& talker : electron_talkers)
+      talker.registerVector(ListenerVector<Real>("trace", crowd_trace.getElectronListener()));
+    ion_talker.registerVector(ListenerVector<Real>("trace", crowd_trace.getIonListener()));
+  }
+
+  FakeRandom<OHMMS_PRECISION_FULL> rng;
+  RefVector<OperatorEstBase> crowd_traces_refs = convertUPtrToRefVector(crowd_traces);
+  long walker_id = 0;
+  for (int ib = 0; ib < nblocks; ++ib)
+  {
+    for (auto& crowd_oeb : crowd_traces)
+      crowd_oeb->startBlock(nsteps);
+    for (int is = 0; is < nsteps; ++is)
+    {
+      for (auto& talker : electron_talkers)
+        talker.reportVector();
+      ion_talker.reportVector();
+      for (auto& crowd_oeb : crowd_traces)
+      {
+        for (OperatorEstBase::MCPWalker& walker : ref_walkers)
+          walker.setWalkerID(walker_id++);
+        crowd_oeb->accumulate(ref_walkers, ref_psets, ref_wfns, ref_hams, rng);
+      }
+    }
+    rank_trace.collect(crowd_traces_refs);
+  }
+  rank_trace.flush();
+  return file_name;
+}
+} // namespace
+
+TEST_CASE("PerParticleTrace_all", "[estimators]")
+{
+  const int ncrowds = 3, nwalkers = 2, nblocks = 2, nsteps = 3;
+  std::string file_name =
+      runTrace(makeInput(R"XML(<estimator type="PerParticleTrace" name="trace_all"/>)XML"), ncrowds, nwalkers,
+               nblocks, nsteps);
+
+  ColumnStreamReader reader(file_name);
+  std::vector<std::string> names;
+  for (auto& spec : reader.getLayout())
+    names.push_back(spec.name);
+  // the reported columns are sorted, the spins are only traced for spinor particle sets
+  CHECK(names ==
+        std::vector<std::string>{"block", "step", "walker_id", "weight", "R", "G", "L", "ElecElec", "Kinetic",
+                                 "ElecIon_ion"});
+
+  const int nrows  = ncrowds * nwalkers * nblocks * nsteps;
+  std::size_t rows = 0;
+  auto blocks      = reader.readColumn<std::int64_t>("block", rows);
+  REQUIRE(rows == nrows);
+  auto steps      = reader.readColumn<std::int64_t>("step", rows);
+  auto walker_ids = reader.readColumn<std::int64_t>("walker_id", rows);
+  auto positions  = reader.readColumn<double>("R", rows);
+  auto kinetic    = reader.readColumn<double>("Kinetic", rows);
+  auto elec_ion   = reader.readColumn<double>("ElecIon_ion", rows);
+  REQUIRE(positions.size() == nrows * 2 * OHMMS_DIM);
+  REQUIRE(kinetic.size() == nrows * 2);
+  REQUIRE(elec_ion.size() == nrows);
+
+  // walker ids were handed out in order, walker iw of a crowd has id % nwalkers == iw
+  std::vector<int> seen(nrows, 0);
+  for (int ir = 0; ir < nrows; ++ir)
+  {
+    const int iw = walker_ids[ir] % nwalkers;
+    ++seen[walker_ids[ir]];
+    CHECK(blocks[ir] == walker_ids[ir] / (ncrowds * nwalkers * nsteps));
+    CHECK(steps[ir] == (walker_ids[ir] / (ncrowds * nwalkers)) % nsteps);
+    CHECK(positions[ir * 2 * OHMMS_DIM] == Approx(iw));
+    CHECK(positions[ir * 2 * OHMMS_DIM + 5] == Approx(2.0));
+    CHECK(kinetic[2 * ir] == Approx(iw * 10));
+    CHECK(kinetic[2 * ir + 1] == Approx(iw * 10 + 1));
+    CHECK(elec_ion[ir] == Approx(iw * 10));
+  }
+  CHECK(std::count(seen.begin(), seen.end(), 1) == nrows);
+  std::filesystem::remove(file_name);
+}
+
+TEST_CASE("PerParticleTrace_selected", "[estimators]")
+{
+  const int ncrowds = 2, nwalkers = 3, nblocks = 1, nsteps = 5;
+  std::string file_name = runTrace(makeInput(R"XML(
+<estimator type="PerParticleTrace" name="trace_selected" quantities="Kinetic R" step_period="2" chunk_kb="1"/>
+)XML"),
+                                   ncrowds, nwalkers, nblocks, nsteps);
+
+  ColumnStreamReader reader(file_name);
+  std::vector<std::string> names;
+  for (auto& spec : reader.getLayout())
+    names.push_back(spec.name);
+  CHECK(names == std::vector<std::string>{"block", "step", "walker_id", "weight", "R", "Kinetic"});
+
+  // steps 0, 2 and 4 are traced
+  std::size_t rows = 0;
+  auto steps       = reader.readColumn<std::int64_t>("step", rows);
+  CHECK(rows == ncrowds * nwalkers * 3);
+  for (auto step : steps)
+    CHECK(step % 2 == 0);
+  std::filesystem::remove(file_name);
+}
+
+TEST_CASE("PerParticleTrace_unavailable", "[estimators]")
+{
+  CHECK_THROWS_AS(runTrace(makeInput(R"XML(<estimator type="PerParticleTrace" quantities="Kinetic Bogus"/>)XML"), 1,
+                           1, 1, 1),
+                  std::runtime_error);
+  CHECK_THROWS_AS(makeInput(R"XML(<estimator type="PerParticleTrace" step_period="0"/>)XML"),
+                  UniformCommunicateError);
+}
+
+} // namespace qmcplusplus
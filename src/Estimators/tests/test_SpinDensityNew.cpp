@@ -44,11 +44,13 @@ public:
     CHECK(sdn.species_size_ == sdn2.species_size_);
     CHECK(sdn.data_ != sdn2.data_);
   }
+
+  static size_t getQueueSize(const SpinDensityNew& sdn) { return sdn.scatter_.size(); }
 };
 } // namespace testing
 
 
-void accumulateFromPsets(int ncrowds, SpinDensityNew& sdn, UPtrVector<OperatorEstBase>& crowd_sdns)
+void accumulateFromPsets(int ncrowds, SpinDensityNew& sdn, UPtrVector<OperatorEstBase>& crowd_sdns, int nsteps = 1)
 {
   const SimulationCell simulation_cell;
   for (int iops = 0; iops < ncrowds; ++iops)
@@ -82,7 +84,8 @@ void accumulateFromPsets(int ncrowds, SpinDensityNew& sdn, UPtrVector<OperatorEs
 
     FakeRandom<OHMMS_PRECISION_FULL> rng;
 
-    crowd_sdn.accumulate(ref_walkers, ref_psets, ref_wfns, ref_hams, rng);
+    for (int istep = 0; istep < nsteps; ++istep)
+      crowd_sdn.accumulate(ref_walkers, ref_psets, ref_wfns, ref_hams, rng);
   }
 }
 
@@ -266,6 +269,12 @@ TEST_CASE("SpinDensityNew::collect(DataLocality::crowd)", "[estimators]")
     int ncrowds = 2;
 
     accumulateFromPsets(ncrowds, sdn, crowd_sdns);
+    // the crowds only queue their entries, they have no copy of the grid
+    for (auto& crowd_sdn : crowd_sdns)
+    {
+      CHECK(crowd_sdn->get_data_locality() == DataLocality::queue);
+      CHECK(crowd_sdn->get_data().empty());
+    }
 
     RefVector<OperatorEstBase> crowd_oeb_refs = convertUPtrToRefVector(crowd_sdns);
     sdn.collect(crowd_oeb_refs);
@@ -275,6 +284,11 @@ TEST_CASE("SpinDensityNew::collect(DataLocality::crowd)", "[estimators]")
     // is correct.  This just checks it hasn't changed from how it was in SpinDensity which lacked testing.
     CHECK(data_ref[555] == 4 * ncrowds);
     CHECK(data_ref[1666] == 4 * ncrowds);
+    CHECK(sdn.get_walkers_weight() == 4 * ncrowds);
+
+    // the queues were emptied by the collect
+    sdn.collect(crowd_oeb_refs);
+    CHECK(data_ref[555] == 4 * ncrowds);
   }
 }
 
@@ -315,9 +329,96 @@ TEST_CASE("SpinDensityNew::collect(DataLocality::rank)", "[estimators]")
     // is correct.  This just checks it hasn't changed from how it was in SpinDensity which lacked testing.
     CHECK(data_ref[555] == 4 * ncrowds);
     CHECK(data_ref[1666] == 4 * ncrowds);
+    // one weight per walker, not per (point, weight) entry of the queue
+    CHECK(sdn.get_walkers_weight() == 4 * ncrowds);
   }
 }
 
+TEST_CASE("SpinDensityNew queue bounded by the grid size", "[estimators]")
+{
+  Libxml2Document doc;
+  using input = testing::ValidSpinDensityInput;
+  bool okay   = doc.parseFromString(input::xml[input::GRID]);
+  REQUIRE(okay);
+  xmlNodePtr node = doc.getRoot();
+  SpinDensityInput sdi(node);
+  SpeciesSet species_set;
+  species_set.addSpecies("u");
+  species_set.addSpecies("d");
+  int iattribute             = species_set.addAttribute("membersize");
+  species_set(iattribute, 0) = 1;
+  species_set(iattribute, 1) = 1;
+
+  SpinDensityNew sdn(std::move(sdi), species_set, DataLocality::rank);
+  const size_t grid_size = sdn.get_data().size();
+
+  // 4 walkers of 2 particles, 8 entries per step, the queue reaches the grid size during the 250th step
+  UPtrVector<OperatorEstBase> crowd_sdns;
+  int ncrowds = 2;
+  int nsteps  = 300;
+  accumulateFromPsets(ncrowds, sdn, crowd_sdns, nsteps);
+  for (auto& crowd_sdn : crowd_sdns)
+  {
+    CHECK(testing::SpinDensityNewTests::getQueueSize(dynamic_cast<SpinDensityNew&>(*crowd_sdn)) == 8 * 50);
+    CHECK(crowd_sdn->get_data().size() == grid_size);
+  }
+
+  RefVector<OperatorEstBase> crowd_oeb_refs = convertUPtrToRefVector(crowd_sdns);
+  sdn.collect(crowd_oeb_refs);
+  std::vector<QMCT::RealType>& data_ref = sdn.get_data();
+  CHECK(data_ref[555] == 4 * ncrowds * nsteps);
+  CHECK(data_ref[1666] == 4 * ncrowds * nsteps);
+  CHECK(sdn.get_walkers_weight() == 4 * ncrowds * nsteps);
+
+  // the grid copies are emptied but kept by the collect
+  for (auto& crowd_sdn : crowd_sdns)
+  {
+    CHECK(testing::SpinDensityNewTests::getQueueSize(dynamic_cast<SpinDensityNew&>(*crowd_sdn)) == 0);
+    CHECK(crowd_sdn->get_data()[555] == 0);
+  }
+  sdn.collect(crowd_oeb_refs);
+  CHECK(data_ref[555] == 4 * ncrowds * nsteps);
+  CHECK(sdn.get_walkers_weight() == 4 * ncrowds * nsteps);
+}
+
+TEST_CASE("SpinDensityNew save_memory", "[estimators]")
+{
+  Libxml2Document doc;
+  using input     = testing::ValidSpinDensityInput;
+  std::string xml = std::string(input::xml[input::GRID]);
+  xml.replace(xml.find("report="), 0, "save_memory=\"yes\" ");
+  bool okay = doc.parseFromString(xml);
+  REQUIRE(okay);
+  xmlNodePtr node = doc.getRoot();
+  SpinDensityInput sdi(node);
+  CHECK(sdi.get_save_memory());
+  SpeciesSet species_set;
+  species_set.addSpecies("u");
+  species_set.addSpecies("d");
+  int iattribute             = species_set.addAttribute("membersize");
+  species_set(iattribute, 0) = 1;
+  species_set(iattribute, 1) = 1;
+
+  SpinDensityInput sdi_copy = sdi;
+  SpinDensityNew sdn(std::move(sdi), species_set, DataLocality::crowd);
+  CHECK(sdn.get_data_locality() == DataLocality::rank);
+  auto lattice = testing::makeTestLattice();
+  SpinDensityNew sdn_lattice(std::move(sdi_copy), lattice, species_set, DataLocality::crowd);
+  CHECK(sdn_lattice.get_data_locality() == DataLocality::rank);
+
+  UPtrVector<OperatorEstBase> crowd_sdns;
+  int ncrowds = 2;
+  accumulateFromPsets(ncrowds, sdn, crowd_sdns);
+  for (auto& crowd_sdn : crowd_sdns)
+    CHECK(crowd_sdn->get_data_locality() == DataLocality::queue);
+
+  RefVector<OperatorEstBase> crowd_oeb_refs = convertUPtrToRefVector(crowd_sdns);
+  sdn.collect(crowd_oeb_refs);
+  std::vector<QMCT::RealType>& data_ref = sdn.get_data();
+  CHECK(data_ref[555] == 4 * ncrowds);
+  CHECK(data_ref[1666] == 4 * ncrowds);
+}
+
 TEST_CASE("SpinDensityNew algorithm comparison", "[estimators]")
 {
   using MCPWalker = OperatorEstBase::MCPWalker;
@@ -352,7 +453,7 @@ TEST_CASE("SpinDensityNew algorithm comparison", "[estimators]")
   sdn_rank.collect(crowd_oeb_refs_rank);
   std::vector<QMCT::RealType>& data_ref_rank = sdn_rank.get_data();
 
-  SpinDensityNew sdn_crowd(std::move(sdi), species_set, DataLocality::crowd);
+  SpinDensityNew sdn_crowd(std::move(sdi_copy), species_set, DataLocality::crowd);
   UPtrVector<OperatorEstBase> crowd_sdns_crowd;
   accumulateFromPsets(ncrowds, sdn_crowd, crowd_sdns_crowd);
   testing::RandomForTest<QMCT::RealType> rng_for_test_crowd;
@@ -365,8 +466,10 @@ TEST_CASE("SpinDensityNew algorithm comparison", "[estimators]")
   for (size_t i = 0; i < data_ref_rank.size(); ++i)
   {
     if (data_ref_crowd[i] != data_ref_rank[i])
+    {
       FAIL_CHECK("crowd local " << data_ref_crowd[i] << " != rank local " << data_ref_rank[i] << " at index " << i);
-    break;
+      break;
+    }
   }
 }
 
@@ -15,6 +15,7 @@
 #include "Platforms/Host/OutputManager.h"
 #include "QMCHamiltonians/QMCHamiltonian.h"
 #include "Estimators/EstimatorManagerNew.h"
+#include "Estimators/HierarchicalReducer.h"
 #include "Estimators/tests/EstimatorManagerNewTest.h"
 
 namespace qmcplusplus
@@ -117,4 +118,40 @@ TEST_CASE("EstimatorManagerNew::reduceOperatorestimators()", "[estimators]")
   }
 }
 
+TEST_CASE("HierarchicalReducer", "[estimators]")
+{
+  using Real     = HierarchicalReducer::Real;
+  Communicate* c = OHMMS::Controller;
+  int num_ranks  = c->size();
+  HierarchicalReducer reducer(*c);
+  CHECK(reducer.getNumNodes() >= 1);
+  CHECK(reducer.getNumNodes() <= num_ranks);
+  CHECK(!reducer.wait());
+
+  // the second reduction is larger than the first to exercise growing the shared memory window
+  for (int n : {7, 1000})
+  {
+    PooledData<Real> local(n);
+    for (int i = 0; i < n; i++)
+      local[i] = (c->rank() + 1) * i;
+    reducer.start(local);
+    // the local buffer can be reused as soon as the reduction has started
+    std::fill(local.begin(), local.end(), -1.0);
+    REQUIRE(reducer.wait());
+    CHECK(!reducer.wait());
+    if (c->rank() == 0)
+    {
+      auto& result = reducer.getResult();
+      REQUIRE(result.size() == n);
+      const Real rank_sum = num_ranks * (num_ranks + 1) / 2;
+      for (int i = 0; i < n; i++)
+        if (result[i] != Approx(rank_sum * i))
+        {
+          FAIL_CHECK("result " << result[i] << " != " << rank_sum * i << " at index " << i);
+          break;
+        }
+    }
+  }
+}
+
 } // namespace qmcplusplus
@@ -185,6 +185,48 @@ public:
     }
   }
 
+  /**
+   * @brief evaluate V for a block of positions on the host
+   *
+   * Provides the block interface of SoaSphericalTensor, the positions are evaluated one by one through cXYZ.
+   * @param [in] x,y,z coordinates of the positions [n]
+   * @param [in] n number of positions
+   * @param [out] XYZ Cartesian tensor elements [Nlm, ldy]
+   * @param [in] ldy leading dimension of XYZ, at least n
+  */
+  inline void block_evaluateV(const T* x, const T* y, const T* z, size_t n, T* XYZ, size_t ldy)
+  {
+    const size_t Nlm = cXYZ.size();
+    for (size_t ip = 0; ip < n; ip++)
+    {
+      evaluateV(x[ip], y[ip], z[ip]);
+      for (size_t i = 0; i < Nlm; i++)
+        XYZ[i * ldy + ip] = cXYZ.data(0)[i];
+    }
+  }
+
+  /**
+   * @brief evaluate VGL for a block of positions on the host
+   *
+   * Provides the block interface of SoaSphericalTensor, the positions are evaluated one by one through cXYZ.
+   * @param [in] x,y,z coordinates of the positions [n]
+   * @param [in] n number of positions
+   * @param [out] XYZ_vgl Cartesian tensor elements [5(v, gx, gy, gz, lapl), Nlm, ldy]
+   * @param [in] ldy leading dimension of XYZ_vgl, at least n
+  */
+  inline void block_evaluateVGL(const T* x, const T* y, const T* z, size_t n, T* XYZ_vgl, size_t ldy)
+  {
+    const size_t Nlm    = cXYZ.size();
+    const size_t offset = Nlm * ldy;
+    for (size_t ip = 0; ip < n; ip++)
+    {
+      evaluateVGL(x[ip], y[ip], z[ip]);
+      for (int icomp = 0; icomp < 5; icomp++)
+        for (size_t i = 0; i < Nlm; i++)
+          XYZ_vgl[icomp * offset + i * ldy + ip] = cXYZ.data(icomp)[i];
+    }
+  }
+
   ///makes a table of \f$ r^l S_l^m \f$ and their gradients up to Lmax.
   void evaluateVGL(T x, T y, T z);
 
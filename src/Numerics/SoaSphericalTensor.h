@@ -15,7 +15,9 @@
 
 #include <stdexcept>
 #include <limits>
+#include <algorithm>
 #include "OhmmsSoA/VectorSoaContainer.h"
+#include "CPU/SIMD/aligned_allocator.hpp"
 #include "OhmmsPETE/Tensor.h"
 #include "OhmmsPETE/OhmmsArray.h"
 #include "OMPTarget/OffloadAlignedAllocators.hpp"
@@ -44,6 +46,8 @@ private:
   using OffloadArray2D = Array<T, 2, OffloadPinnedAllocator<T>>;
   using OffloadArray3D = Array<T, 3, OffloadPinnedAllocator<T>>;
   using OffloadArray4D = Array<T, 4, OffloadPinnedAllocator<T>>;
+  ///number of points evaluated together by the block functions, the per point temporaries live on the stack
+  static constexpr int block_size_ = 32;
   ///maximum angular momentum for the center
   int Lmax;
   /// Normalization factors
@@ -83,6 +87,16 @@ public:
                                const T* factor2L,
                                const T* normfactor,
                                size_t offset);
+  ///compute Ylm for at most block_size_ points, the points are the SIMD lanes
+  static void evaluate_bare_block(const T* x,
+                                  const T* y,
+                                  const T* z,
+                                  int nb,
+                                  T* Ylm,
+                                  size_t ldy,
+                                  int lmax,
+                                  const T* factorL,
+                                  const T* factorLM);
 
   ///compute Ylm
   inline void evaluateV(T x, T y, T z, T* Ylm) const
@@ -112,6 +126,25 @@ public:
 
     auto* xyz_ptr          = xyz.data();
     auto* Ylm_ptr          = Ylm.data();
+#if !defined(ENABLE_OFFLOAD)
+    // on the host the positions are evaluated in blocks and transposed to [position][lm]
+    alignas(QMC_SIMD_ALIGNMENT) T x[block_size_], y[block_size_], z[block_size_];
+    aligned_vector<T> Ylm_block(Nlm * block_size_);
+    for (size_t first = 0; first < nR; first += block_size_)
+    {
+      const int nb = std::min(nR - first, static_cast<size_t>(block_size_));
+      for (int ip = 0; ip < nb; ip++)
+      {
+        x[ip] = xyz_ptr[0 + 3 * (first + ip)];
+        y[ip] = xyz_ptr[1 + 3 * (first + ip)];
+        z[ip] = xyz_ptr[2 + 3 * (first + ip)];
+      }
+      block_evaluateV(x, y, z, nb, Ylm_block.data(), block_size_);
+      for (int ip = 0; ip < nb; ip++)
+        for (size_t i = 0; i < Nlm; i++)
+          Ylm_ptr[(first + ip) * Nlm + i] = Ylm_block[i * block_size_ + ip];
+    }
+#else
     auto* factorLM__ptr    = factorLM_.data();
     auto* factorL__ptr     = factorL_.data();
     auto* norm_factor__ptr = norm_factor_.data();
@@ -126,6 +159,7 @@ public:
       for (int i = 0; i < Nlm; i++)
         Ylm_ptr[ir * Nlm + i] *= norm_factor__ptr[i];
     }
+#endif
   }
 
   /**
@@ -154,6 +188,26 @@ public:
 
     auto* xyz_ptr          = xyz.data();
     auto* Ylm_vgl_ptr      = Ylm_vgl.data();
+#if !defined(ENABLE_OFFLOAD)
+    // on the host the positions are evaluated in blocks and transposed to [position][lm]
+    alignas(QMC_SIMD_ALIGNMENT) T x[block_size_], y[block_size_], z[block_size_];
+    aligned_vector<T> Ylm_vgl_block(5 * Nlm * block_size_);
+    for (size_t first = 0; first < nR; first += block_size_)
+    {
+      const int nb = std::min(nR - first, static_cast<size_t>(block_size_));
+      for (int ip = 0; ip < nb; ip++)
+      {
+        x[ip] = xyz_ptr[0 + 3 * (first + ip)];
+        y[ip] = xyz_ptr[1 + 3 * (first + ip)];
+        z[ip] = xyz_ptr[2 + 3 * (first + ip)];
+      }
+      block_evaluateVGL(x, y, z, nb, Ylm_vgl_block.data(), block_size_);
+      for (int icomp = 0; icomp < 5; icomp++)
+        for (int ip = 0; ip < nb; ip++)
+          for (size_t i = 0; i < Nlm; i++)
+            Ylm_vgl_ptr[icomp * offset + (first + ip) * Nlm + i] = Ylm_vgl_block[(icomp * Nlm + i) * block_size_ + ip];
+    }
+#else
     auto* factorLM__ptr    = factorLM_.data();
     auto* factorL__ptr     = factorL_.data();
     auto* factor2L__ptr    = factor2L_.data();
@@ -165,8 +219,29 @@ public:
     for (uint32_t ir = 0; ir < nR; ir++)
       evaluateVGL_impl(xyz_ptr[0 + 3 * ir], xyz_ptr[1 + 3 * ir], xyz_ptr[2 + 3 * ir], Ylm_vgl_ptr + (ir * Nlm), Lmax,
                        factorL__ptr, factorLM__ptr, factor2L__ptr, norm_factor__ptr, offset);
+#endif
   }
 
+  /**
+   * @brief evaluate V for a block of positions on the host with the positions as the SIMD lanes
+   *
+   * @param [in] x,y,z coordinates of the positions [n]
+   * @param [in] n number of positions
+   * @param [out] Ylm Spherical tensor elements [Nlm, ldy], Ylm[lm * ldy + ip] for position ip
+   * @param [in] ldy leading dimension of Ylm, at least n
+  */
+  void block_evaluateV(const T* x, const T* y, const T* z, size_t n, T* Ylm, size_t ldy) const;
+
+  /**
+   * @brief evaluate VGL for a block of positions on the host with the positions as the SIMD lanes
+   *
+   * @param [in] x,y,z coordinates of the positions [n]
+   * @param [in] n number of positions
+   * @param [out] Ylm_vgl Spherical tensor elements [5(v, gx, gy, gz, lapl), Nlm, ldy]
+   * @param [in] ldy leading dimension of Ylm_vgl, at least n
+  */
+  void block_evaluateVGL(const T* x, const T* y, const T* z, size_t n, T* Ylm_vgl, size_t ldy) const;
+
   ///compute Ylm
   inline void evaluateV(T x, T y, T z)
   {
@@ -499,6 +574,283 @@ inline void SoaSphericalTensor<T>::evaluateVGL_impl(const T x,
 }
 PRAGMA_OFFLOAD("omp end declare target")
 
+/** evaluate_bare for a block of points
+ *
+ * The same recursion as evaluate_bare with every step a SIMD loop over the points.
+ * The coordinate singularity is resolved per point by selects instead of branches.
+ */
+template<typename T>
+inline void SoaSphericalTensor<T>::evaluate_bare_block(const T* restrict x,
+                                                       const T* restrict y,
+                                                       const T* restrict z,
+                                                       int nb,
+                                                       T* restrict Ylm,
+                                                       size_t ldy,
+                                                       int lmax,
+                                                       const T* factorL,
+                                                       const T* factorLM)
+{
+  assert(nb <= block_size_);
+  constexpr T czero(0);
+  constexpr T cone(1);
+  const T pi       = 4.0 * std::atan(1.0);
+  const T omega    = 1.0 / std::sqrt(4.0 * pi);
+  constexpr T eps2 = std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon();
+
+  alignas(QMC_SIMD_ALIGNMENT) T r[block_size_], cphi[block_size_], sphi[block_size_], ctheta[block_size_],
+      stheta[block_size_], fac[block_size_];
+
+#pragma omp simd aligned(r, cphi, sphi, ctheta, stheta, fac : QMC_SIMD_ALIGNMENT)
+  for (int ip = 0; ip < nb; ip++)
+  {
+    const T r2xy    = x[ip] * x[ip] + y[ip] * y[ip];
+    r[ip]           = std::sqrt(r2xy + z[ip] * z[ip]);
+    const bool axis = r2xy < eps2;
+    const T rxyi    = cone / std::sqrt(axis ? cone : r2xy);
+    const T ct      = axis ? ((z[ip] < czero) ? -cone : cone) : z[ip] / (axis ? cone : r[ip]);
+    ctheta[ip]      = std::min(cone, std::max(-cone, ct));
+    cphi[ip]        = axis ? czero : x[ip] * rxyi;
+    sphi[ip]        = axis ? cone : y[ip] * rxyi;
+    stheta[ip]      = std::sqrt(cone - ctheta[ip] * ctheta[ip]);
+    fac[ip]         = cone;
+    Ylm[ip]         = cone;
+  }
+  // calculate P_ll and P_l,l-1
+  int j = -1;
+  for (int l = 1; l <= lmax; l++)
+  {
+    j += 2;
+    T* restrict Y_ll       = Ylm + index(l, l) * ldy;
+    T* restrict Y_l1       = Ylm + index(l, l - 1) * ldy;
+    const T* restrict Y_l2 = Ylm + index(l - 1, l - 1) * ldy;
+#pragma omp simd aligned(stheta, ctheta, fac : QMC_SIMD_ALIGNMENT)
+    for (int ip = 0; ip < nb; ip++)
+    {
+      fac[ip] *= -j * stheta[ip];
+      Y_ll[ip] = fac[ip];
+      Y_l1[ip] = j * ctheta[ip] * Y_l2[ip];
+    }
+  }
+  // Use recurence to get other plm's //
+  for (int m = 0; m < lmax - 1; m++)
+  {
+    int j = 2 * m + 1;
+    for (int l = m + 2; l <= lmax; l++)
+    {
+      j += 2;
+      T* restrict Y_lm       = Ylm + index(l, m) * ldy;
+      const T* restrict Y_l1 = Ylm + index(l - 1, m) * ldy;
+      const T* restrict Y_l2 = Ylm + index(l - 2, m) * ldy;
+#pragma omp simd aligned(ctheta : QMC_SIMD_ALIGNMENT)
+      for (int ip = 0; ip < nb; ip++)
+        Y_lm[ip] = (ctheta[ip] * j * Y_l1[ip] - (l + m - 1) * Y_l2[ip]) / (l - m);
+    }
+  }
+  // Now to calculate r^l Y_lm. //
+  alignas(QMC_SIMD_ALIGNMENT) T rpow[block_size_], cphim[block_size_], sphim[block_size_];
+  for (int ip = 0; ip < nb; ip++)
+  {
+    Ylm[ip]  = omega;
+    rpow[ip] = cone;
+  }
+  for (int l = 1; l <= lmax; l++)
+  {
+    T* restrict Y_l0 = Ylm + index(l, 0) * ldy;
+#pragma omp simd aligned(r, rpow, fac, cphim, sphim : QMC_SIMD_ALIGNMENT)
+    for (int ip = 0; ip < nb; ip++)
+    {
+      rpow[ip] *= r[ip];
+      fac[ip] = rpow[ip] * factorL[l];
+      Y_l0[ip] *= fac[ip];
+      cphim[ip] = cone;
+      sphim[ip] = czero;
+    }
+    for (int m = 1; m <= l; m++)
+    {
+      T* restrict Y_lp  = Ylm + index(l, m) * ldy;
+      T* restrict Y_lm  = Ylm + index(l, -m) * ldy;
+      const T factor_lm = factorLM[index(l, m)];
+#pragma omp simd aligned(cphi, sphi, fac, cphim, sphim : QMC_SIMD_ALIGNMENT)
+      for (int ip = 0; ip < nb; ip++)
+      {
+        const T temp = cphim[ip] * cphi[ip] - sphim[ip] * sphi[ip];
+        sphim[ip]    = sphim[ip] * cphi[ip] + cphim[ip] * sphi[ip];
+        cphim[ip]    = temp;
+        fac[ip] *= factor_lm;
+        const T val = fac[ip] * Y_lp[ip];
+        Y_lp[ip]    = val * cphim[ip];
+        Y_lm[ip]    = val * sphim[ip];
+      }
+    }
+  }
+}
+
+template<typename T>
+inline void SoaSphericalTensor<T>::block_evaluateV(const T* restrict x,
+                                                   const T* restrict y,
+                                                   const T* restrict z,
+                                                   size_t n,
+                                                   T* restrict Ylm,
+                                                   size_t ldy) const
+{
+  assert(ldy >= n);
+  const int Nlm             = cYlm.size();
+  const T* restrict norm_lm = norm_factor_.data();
+  for (size_t first = 0; first < n; first += block_size_)
+  {
+    const int nb = std::min(n - first, static_cast<size_t>(block_size_));
+    evaluate_bare_block(x + first, y + first, z + first, nb, Ylm + first, ldy, Lmax, factorL_.data(),
+                        factorLM_.data());
+    for (int lm = 0; lm < Nlm; lm++)
+    {
+      T* restrict Y_lm = Ylm + lm * ldy + first;
+#pragma omp simd
+      for (int ip = 0; ip < nb; ip++)
+        Y_lm[ip] *= norm_lm[lm];
+    }
+  }
+}
+
+/** block version of evaluateVGL_impl
+ *
+ * The choice of the terms of the gradient recursion only depends on (l,m) and is made once per block.
+ * Terms which evaluateVGL_impl sets to zero get a zero coefficient on the l=0 row.
+ */
+template<typename T>
+inline void SoaSphericalTensor<T>::block_evaluateVGL(const T* restrict x,
+                                                     const T* restrict y,
+                                                     const T* restrict z,
+                                                     size_t n,
+                                                     T* restrict Ylm_vgl,
+                                                     size_t ldy) const
+{
+  assert(ldy >= n);
+  constexpr T czero(0);
+  constexpr T cone(1);
+  constexpr T ahalf(0.5);
+  const int Nlm                = cYlm.size();
+  const size_t offset          = Nlm * ldy;
+  const T* restrict normfactor = norm_factor_.data();
+  const T* restrict factor2L   = factor2L_.data();
+
+  for (size_t first = 0; first < n; first += block_size_)
+  {
+    const int nb    = std::min(n - first, static_cast<size_t>(block_size_));
+    T* restrict Ylm = Ylm_vgl + first;
+    evaluate_bare_block(x + first, y + first, z + first, nb, Ylm, ldy, Lmax, factorL_.data(), factorLM_.data());
+    T* restrict gYlmX = Ylm + offset * 1;
+    T* restrict gYlmY = Ylm + offset * 2;
+    T* restrict gYlmZ = Ylm + offset * 3;
+    T* restrict lYlm  = Ylm + offset * 4;
+
+    for (int ip = 0; ip < nb; ip++)
+    {
+      gYlmX[ip] = czero;
+      gYlmY[ip] = czero;
+      gYlmZ[ip] = czero;
+    }
+
+    // Calculating Gradient now//
+    for (int l = 1; l <= Lmax; l++)
+    {
+      const T fac = factor2L[l];
+      for (int m = -l; m <= l; m++)
+      {
+        const int lm0 = index(l - 1, 0);
+        const int ma  = std::abs(m);
+        const T cp    = std::sqrt(fac * (l - ma - 1) * (l - ma));
+        const T cm    = std::sqrt(fac * (l + ma - 1) * (l + ma));
+        const T c0    = std::sqrt(fac * (l - ma) * (l + ma));
+
+        // coefficients and rows of gz, dpr, dpi, dmr and dmi
+        T cz = czero, cpr = czero, cpi = czero, cmr = czero, cmi = czero;
+        int z_row = 0, pr_row = 0, pi_row = 0, mr_row = 0, mi_row = 0;
+        if (l > ma)
+        {
+          cz    = c0;
+          z_row = lm0 + m;
+        }
+        if (l > ma + 1)
+        {
+          cpr    = cp;
+          pr_row = lm0 + ma + 1;
+          cpi    = cp;
+          pi_row = lm0 - ma - 1;
+        }
+        if (l > 1)
+        {
+          switch (ma)
+          {
+          case 0:
+            cmr    = -cm;
+            mr_row = lm0 + 1;
+            cmi    = cm;
+            mi_row = lm0 - 1;
+            break;
+          case 1:
+            cmr    = cm;
+            mr_row = lm0;
+            break;
+          default:
+            cmr    = cm;
+            mr_row = lm0 + ma - 1;
+            cmi    = cm;
+            mi_row = lm0 - ma + 1;
+          }
+        }
+        else
+        {
+          cmr    = cm;
+          mr_row = lm0;
+        }
+
+        const int lm           = index(l, m);
+        const T norm           = ma ? normfactor[lm] : cone;
+        const T* restrict Y_z  = Ylm + z_row * ldy;
+        const T* restrict Y_pr = Ylm + pr_row * ldy;
+        const T* restrict Y_pi = Ylm + pi_row * ldy;
+        const T* restrict Y_mr = Ylm + mr_row * ldy;
+        const T* restrict Y_mi = Ylm + mi_row * ldy;
+        T* restrict gX         = gYlmX + lm * ldy;
+        T* restrict gY         = gYlmY + lm * ldy;
+        T* restrict gZ         = gYlmZ + lm * ldy;
+        if (m < 0)
+        {
+#pragma omp simd
+          for (int ip = 0; ip < nb; ip++)
+          {
+            gX[ip] = norm * ahalf * (cpi * Y_pi[ip] - cmi * Y_mi[ip]);
+            gY[ip] = -norm * ahalf * (cpr * Y_pr[ip] + cmr * Y_mr[ip]);
+            gZ[ip] = norm * cz * Y_z[ip];
+          }
+        }
+        else
+        {
+#pragma omp simd
+          for (int ip = 0; ip < nb; ip++)
+          {
+            gX[ip] = norm * ahalf * (cpr * Y_pr[ip] - cmr * Y_mr[ip]);
+            gY[ip] = norm * ahalf * (cpi * Y_pi[ip] + cmi * Y_mi[ip]);
+            gZ[ip] = norm * cz * Y_z[ip];
+          }
+        }
+      }
+    }
+
+    for (int lm = 0; lm < Nlm; lm++)
+    {
+      T* restrict Y_lm = Ylm + lm * ldy;
+      T* restrict L_lm = lYlm + lm * ldy;
+#pragma omp simd
+      for (int ip = 0; ip < nb; ip++)
+      {
+        Y_lm[ip] *= normfactor[lm];
+        L_lm[ip] = czero;
+      }
+    }
+  }
+}
+
 template<typename T>
 inline void SoaSphericalTensor<T>::evaluateVGL(T x, T y, T z)
 {
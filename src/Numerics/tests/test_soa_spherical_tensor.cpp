@@ -0,0 +1,121 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+#include "Numerics/SoaSphericalTensor.h"
+#include "Numerics/SoaCartesianTensor.h"
+
+namespace qmcplusplus
+{
+namespace
+{
+/// points across more than one block, including the z axis and the origin
+template<typename T>
+void makePoints(std::vector<T>& x, std::vector<T>& y, std::vector<T>& z)
+{
+  const int n = 37;
+  for (int ip = 0; ip < n - 3; ip++)
+  {
+    x.push_back(std::sin(1.3 * ip) * (0.2 + 0.1 * ip));
+    y.push_back(std::cos(0.7 * ip) * (0.5 - 0.05 * ip));
+    z.push_back(std::sin(2.1 * ip + 0.4) * 1.7);
+  }
+  x.insert(x.end(), {0, 0, 0});
+  y.insert(y.end(), {0, 0, 0});
+  z.insert(z.end(), {1.5, -0.8, 0});
+}
+
+/// compare the block evaluation of each point against the single point evaluation
+template<typename SH>
+void checkBlock(SH& sh)
+{
+  using T = double;
+  std::vector<T> x, y, z;
+  makePoints(x, y, z);
+  const size_t n   = x.size();
+  const size_t ldy = n + 3;
+  const size_t nlm = sh.size();
+
+  std::vector<T> ylm_v(nlm * ldy), ylm_vgl(5 * nlm * ldy);
+  sh.block_evaluateV(x.data(), y.data(), z.data(), n, ylm_v.data(), ldy);
+  sh.block_evaluateVGL(x.data(), y.data(), z.data(), n, ylm_vgl.data(), ldy);
+  for (size_t ip = 0; ip < n; ip++)
+  {
+    sh.evaluateVGL(x[ip], y[ip], z[ip]);
+    for (size_t lm = 0; lm < nlm; lm++)
+    {
+      CHECK(ylm_v[lm * ldy + ip] == Approx(sh[0][lm]));
+      for (int icomp = 0; icomp < 5; icomp++)
+        CHECK(ylm_vgl[(icomp * nlm + lm) * ldy + ip] == Approx(sh[icomp][lm]));
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("SoaSphericalTensor block evaluation", "[numerics]")
+{
+  for (bool addsign : {false, true})
+  {
+    SoaSphericalTensor<double> sh(5, addsign);
+    checkBlock(sh);
+  }
+  SoaSphericalTensor<double> sh_s(0);
+  checkBlock(sh_s);
+}
+
+TEST_CASE("SoaCartesianTensor block evaluation", "[numerics]")
+{
+  SoaCartesianTensor<double> ct(3);
+  checkBlock(ct);
+}
+
+TEST_CASE("SoaSphericalTensor batched evaluation", "[numerics]")
+{
+  using T            = double;
+  using OffloadArray = Array<T, 3, OffloadPinnedAllocator<T>>;
+  SoaSphericalTensor<T> sh(4, true);
+  std::vector<T> x, y, z;
+  makePoints(x, y, z);
+  const size_t nelec = 2;
+  const size_t npbc  = x.size() / nelec;
+  const size_t nlm   = sh.size();
+
+  OffloadArray xyz(nelec, npbc, 3);
+  for (size_t ie = 0; ie < nelec; ie++)
+    for (size_t ip = 0; ip < npbc; ip++)
+    {
+      xyz(ie, ip, 0) = x[ie * npbc + ip];
+      xyz(ie, ip, 1) = y[ie * npbc + ip];
+      xyz(ie, ip, 2) = z[ie * npbc + ip];
+    }
+  xyz.updateTo();
+
+  OffloadArray ylm_v(nelec, npbc, nlm);
+  Array<T, 4, OffloadPinnedAllocator<T>> ylm_vgl(5, nelec, npbc, nlm);
+  sh.batched_evaluateV(xyz, ylm_v);
+  sh.batched_evaluateVGL(xyz, ylm_vgl);
+  ylm_v.updateFrom();
+  ylm_vgl.updateFrom();
+  for (size_t ie = 0; ie < nelec; ie++)
+    for (size_t ip = 0; ip < npbc; ip++)
+    {
+      sh.evaluateVGL(xyz(ie, ip, 0), xyz(ie, ip, 1), xyz(ie, ip, 2));
+      for (size_t lm = 0; lm < nlm; lm++)
+      {
+        CHECK(ylm_v(ie, ip, lm) == Approx(sh[0][lm]));
+        for (int icomp = 0; icomp < 5; icomp++)
+          CHECK(ylm_vgl(icomp, ie, ip, lm) == Approx(sh[icomp][lm]));
+      }
+    }
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,155 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "LRBreakupCache.h"
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include "Message/Communicate.h"
+#include "Message/CommOperators.h"
+#include "hdf/hdf_archive.h"
+
+namespace qmcplusplus
+{
+namespace
+{
+/// 64 bit FNV-1a hash of a string, stable across platforms and compilers unlike std::hash
+std::uint64_t fnv1aHash(const std::string& str)
+{
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (const unsigned char c : str)
+  {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+template<typename T>
+void bcastVector(Communicate& comm, std::vector<T>& vec)
+{
+  int size = vec.size();
+  comm.bcast(size);
+  vec.resize(size);
+  if (size > 0)
+    comm.bcast(vec);
+}
+} // namespace
+
+LRBreakupCache::LRBreakupCache(const std::filesystem::path& cache_dir, Communicate& comm)
+    : cache_dir_(cache_dir), comm_(comm)
+{}
+
+std::string LRBreakupCache::makeKey(const std::string& handler_name, const ParticleLayout& lattice, mRealType kc)
+{
+  std::ostringstream key;
+  // hexfloat keeps the key exact, a cell differing in the last bit is a different breakup
+  key << std::hexfloat;
+  key << "version=" << format_version_ << ";handler=" << handler_name << ";precision=" << sizeof(OHMMS_PRECISION)
+      << "," << sizeof(mRealType) << ";lattice=";
+  for (int i = 0; i < OHMMS_DIM; ++i)
+    for (int j = 0; j < OHMMS_DIM; ++j)
+      key << lattice.R(i, j) << ",";
+  key << ";rc=" << lattice.LR_rc << ";kc=" << (kc < 0 ? lattice.LR_kc : kc);
+  return key.str();
+}
+
+std::filesystem::path LRBreakupCache::getFileName(const std::string& key) const
+{
+  std::ostringstream fname;
+  fname << "lrbreakup_" << std::hex << std::setw(16) << std::setfill('0') << fnv1aHash(key) << ".h5";
+  return cache_dir_ / fname.str();
+}
+
+bool LRBreakupCache::load(const std::string& key, LRHandlerBase& handler) const
+{
+  bool found     = false;
+  int max_kshell = 0;
+  mRealType kc   = 0;
+  std::string stored_key;
+  std::vector<mRealType> coefs;
+  std::vector<mRealType> gcoefs;
+  if (comm_.rank() == 0)
+  {
+    const auto fname = getFileName(key);
+    hdf_archive hin;
+    if (std::filesystem::exists(fname) && hin.open(fname, H5F_ACC_RDONLY))
+    {
+      found = hin.readEntry(stored_key, "key") && hin.readEntry(max_kshell, "max_kshell") && hin.readEntry(kc, "kc");
+      // either may be absent depending on the handler
+      hin.readEntry(coefs, "coefs");
+      hin.readEntry(gcoefs, "gcoefs");
+    }
+  }
+  comm_.bcast(found);
+  if (!found)
+    return false;
+
+  comm_.bcast(stored_key);
+  comm_.bcast(max_kshell);
+  comm_.bcast(kc);
+  bcastVector(comm_, coefs);
+  bcastVector(comm_, gcoefs);
+  // every rank checks against its own key, a rank whose cell or cutoffs differ recomputes the breakup
+  if (stored_key != key)
+  {
+    app_warning() << "LRBreakupCache::load " << getFileName(key)
+                  << " does not match the current breakup and is ignored." << std::endl;
+    return false;
+  }
+  handler.MaxKshell = max_kshell;
+  handler.LR_kc     = kc;
+  handler.coefs     = std::move(coefs);
+  handler.gcoefs    = std::move(gcoefs);
+  app_log() << "  Long-range breakup loaded from " << getFileName(key) << std::endl;
+  return true;
+}
+
+void LRBreakupCache::save(const std::string& key, const LRHandlerBase& handler) const
+{
+  if (comm_.rank() != 0)
+    return;
+
+  const auto fname = getFileName(key);
+  std::error_code ec;
+  std::filesystem::create_directories(cache_dir_, ec);
+  auto tmp_name = fname;
+  tmp_name += "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+  {
+    hdf_archive hout;
+    if (ec || !hout.create(tmp_name))
+    {
+      app_warning() << "LRBreakupCache::save cannot create " << tmp_name << ". The breakup is not cached." << std::endl;
+      return;
+    }
+    const int max_kshell = handler.MaxKshell;
+    const mRealType kc   = handler.LR_kc;
+    hout.write(key, "key");
+    hout.write(max_kshell, "max_kshell");
+    hout.write(kc, "kc");
+    if (!handler.coefs.empty())
+      hout.write(handler.coefs, "coefs");
+    if (!handler.gcoefs.empty())
+      hout.write(handler.gcoefs, "gcoefs");
+  }
+  std::filesystem::rename(tmp_name, fname, ec);
+  if (ec)
+  {
+    std::filesystem::remove(tmp_name, ec);
+    app_warning() << "LRBreakupCache::save cannot write " << fname << ". The breakup is not cached." << std::endl;
+  }
+  else
+    app_log() << "  Long-range breakup saved to " << fname << std::endl;
+}
+
+} // namespace qmcplusplus
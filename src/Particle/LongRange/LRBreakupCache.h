@@ -0,0 +1,79 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file LRBreakupCache.h
+ * @brief On-disk cache of the optimized long-range breakup
+ */
+#ifndef QMCPLUSPLUS_LRBREAKUPCACHE_H
+#define QMCPLUSPLUS_LRBREAKUPCACHE_H
+
+#include <filesystem>
+#include <string>
+#include "LongRange/LRHandlerBase.h"
+
+class Communicate;
+
+namespace qmcplusplus
+{
+/** content addressed store of the breakup coefficients of LRHandlerTemp and LRHandlerSRCoulomb
+ *
+ * The fit performed by initBreakup only depends on the handler type, the long-range box and the cutoffs.
+ * These are collected in a key whose hash names an hdf5 file in the cache directory.
+ * The file stores the key itself, which every rank compares on load with its own key to rule out hash collisions.
+ * Only rank 0 touches the file system. The key and the coefficients are broadcast to the other ranks.
+ */
+class LRBreakupCache
+{
+public:
+  using ParticleLayout = ParticleSet::ParticleLayout;
+  using mRealType      = LRHandlerBase::mRealType;
+
+  /** constructor
+   * @param cache_dir directory of the cache files, created on first save if missing
+   * @param comm communicator over which load is collective
+   */
+  LRBreakupCache(const std::filesystem::path& cache_dir, Communicate& comm);
+
+  /** make the key of a breakup
+   * @param handler_name name of the breakup method
+   * @param lattice long-range box providing the cell and the cutoffs
+   * @param kc k-space cutoff requested by the handler, negative to use the one of the lattice
+   */
+  static std::string makeKey(const std::string& handler_name, const ParticleLayout& lattice, mRealType kc);
+
+  /// file of the cache entry of key
+  std::filesystem::path getFileName(const std::string& key) const;
+
+  /** load MaxKshell, LR_kc, coefs and gcoefs of handler from the cache entry of key
+   * Collective over comm.
+   * @return true if rank 0 found an entry whose stored key matches the key of this rank,
+   *         false and handler untouched otherwise
+   */
+  bool load(const std::string& key, LRHandlerBase& handler) const;
+
+  /** store the breakup of handler as the cache entry of key
+   * Only rank 0 writes. The file is written under a temporary name and renamed
+   * so that concurrent jobs sharing the cache never see a partial entry.
+   */
+  void save(const std::string& key, const LRHandlerBase& handler) const;
+
+private:
+  /// cache directory
+  const std::filesystem::path cache_dir_;
+  /// communicator
+  Communicate& comm_;
+  /// bump whenever the handlers change in a way that invalidates stored coefficients
+  static constexpr int format_version_ = 1;
+};
+
+} // namespace qmcplusplus
+#endif
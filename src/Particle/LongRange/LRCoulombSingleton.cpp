@@ -23,6 +23,8 @@
 #include "LongRange/EwaldHandlerQuasi2D.h"
 #include "LongRange/EwaldHandler3D.h"
 #include "LongRange/EwaldHandler2D.h"
+#include "LongRange/LRBreakupCache.h"
+#include "Message/Communicate.h"
 #include <numeric>
 namespace qmcplusplus
 {
@@ -30,6 +32,8 @@ namespace qmcplusplus
 std::unique_ptr<LRCoulombSingleton::LRHandlerType> LRCoulombSingleton::CoulombHandler;
 std::unique_ptr<LRCoulombSingleton::LRHandlerType> LRCoulombSingleton::CoulombDerivHandler;
 LRCoulombSingleton::lr_type LRCoulombSingleton::this_lr_type = ESLER;
+std::string LRCoulombSingleton::breakup_cache_dir;
+Communicate* LRCoulombSingleton::breakup_cache_comm = nullptr;
 /** CoulombFunctor
  *
  * An example for a Func for LRHandlerTemp. Four member functions have to be provided
@@ -90,7 +94,12 @@ std::unique_ptr<LRCoulombSingleton::LRHandlerType> LRCoulombSingleton::getHandle
     {
       APP_ABORT("\n  Long range breakup method not recognized.\n");
     }
-    CoulombHandler->initBreakup(ref);
+    if (this_lr_type == ESLER)
+      initCachedBreakup(*CoulombHandler, ref, "opt_breakup");
+    else if (this_lr_type == NATOLI)
+      initCachedBreakup(*CoulombHandler, ref, "opt_breakup_original");
+    else
+      CoulombHandler->initBreakup(ref);
     return std::unique_ptr<LRHandlerType>(CoulombHandler->makeClone(ref));
   }
   else
@@ -123,7 +132,10 @@ std::unique_ptr<LRCoulombSingleton::LRHandlerType> LRCoulombSingleton::getDerivH
     {
       APP_ABORT("\n  Long range breakup method for derivatives not recognized.\n");
     }
-    CoulombDerivHandler->initBreakup(ref);
+    if (this_lr_type == NATOLI)
+      initCachedBreakup(*CoulombDerivHandler, ref, "opt_breakup_original");
+    else
+      CoulombDerivHandler->initBreakup(ref);
     return std::unique_ptr<LRHandlerType>(CoulombDerivHandler->makeClone(ref));
   }
   else
@@ -133,6 +145,26 @@ std::unique_ptr<LRCoulombSingleton::LRHandlerType> LRCoulombSingleton::getDerivH
   }
 }
 
+void LRCoulombSingleton::initCachedBreakup(LRHandlerType& handler, ParticleSet& ref, const std::string& handler_name)
+{
+  if (breakup_cache_dir.empty())
+  {
+    handler.initBreakup(ref);
+    return;
+  }
+  if (!breakup_cache_comm)
+    throw std::runtime_error("LRCoulombSingleton::initCachedBreakup the communicator of the breakup cache is not set.");
+  const LRBreakupCache cache(breakup_cache_dir, *breakup_cache_comm);
+  const std::string key = LRBreakupCache::makeKey(handler_name, ref.getLRBox(), handler.get_kc());
+  if (cache.load(key, handler))
+    handler.restoreBreakup(ref);
+  else
+  {
+    handler.initBreakup(ref);
+    cache.save(key, handler);
+  }
+}
+
 template<typename T>
 std::unique_ptr<OneDimCubicSpline<T>> createSpline4RbyVs_temp(const LRHandlerBase* aLR,
                                                               T rcut,
@@ -20,6 +20,7 @@
 #define QMCPLUSPLUS_LRCOULOMBSINGLETON_H
 
 #include <memory>
+#include <string>
 #include <config.h>
 #include "LongRange/LRHandlerBase.h"
 #include "Numerics/OneDimGridBase.h"
@@ -27,6 +28,8 @@
 #include "Numerics/OneDimCubicSpline.h"
 #include "Numerics/OneDimLinearSpline.h"
 
+class Communicate;
+
 namespace qmcplusplus
 {
 struct LRCoulombSingleton
@@ -46,6 +49,10 @@ struct LRCoulombSingleton
     STRICT2D
   };
   static lr_type this_lr_type;
+  ///directory of the on-disk cache of optimized breakups, the cache is off if empty. See LRBreakupCache.
+  static std::string breakup_cache_dir;
+  ///communicator of the group sharing the breakup cache, set by ParticleSetPool along with the simulation cell
+  static Communicate* breakup_cache_comm;
   ///Stores the energ optimized LR handler.
   static std::unique_ptr<LRHandlerType> CoulombHandler;
   ///Stores the force/stress optimized LR handler.
@@ -85,6 +92,14 @@ struct LRCoulombSingleton
   static std::unique_ptr<RadFunctorType> createSpline4RbyVsDeriv(const LRHandlerType* aLR,
                                                                  mRealType rcut,
                                                                  const GridType& agrid);
+
+private:
+  /** initBreakup of an optimized breakup handler going through the on-disk cache if enabled
+   * @param handler handler to be initialized
+   * @param ref particleset providing the cell
+   * @param handler_name name of the breakup method, part of the cache key
+   */
+  static void initCachedBreakup(LRHandlerType& handler, ParticleSet& ref, const std::string& handler_name);
 };
 
 } // namespace qmcplusplus
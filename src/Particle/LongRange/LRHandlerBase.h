@@ -187,6 +187,12 @@ struct LRHandlerBase
   virtual void Breakup(ParticleSet& ref, mRealType rs_in) = 0;
   virtual void resetTargetParticleSet(ParticleSet& ref)   = 0;
 
+  /** complete the setup of a handler whose MaxKshell, LR_kc and breakup coefficients were
+   * restored from a previous initBreakup on the same cell, skipping the fit. See LRBreakupCache.
+   * Handlers without a fitted breakup simply redo initBreakup.
+   */
+  virtual void restoreBreakup(ParticleSet& ref) { initBreakup(ref); }
+
   virtual mRealType evaluate(mRealType r, mRealType rinv) const = 0;
   virtual mRealType evaluateLR(mRealType r) const               = 0;
   virtual mRealType srDf(mRealType r, mRealType rinv) const     = 0;
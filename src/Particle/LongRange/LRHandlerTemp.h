@@ -87,6 +87,13 @@ public:
     LR_rc = Basis.get_rc();
   }
 
+  void restoreBreakup(ParticleSet& ref) override
+  {
+    initBasis(ref.getLRBox());
+    fillFk(ref.getSimulationCell().getKLists());
+    LR_rc = Basis.get_rc();
+  }
+
   void Breakup(ParticleSet& ref, mRealType rs_ext) override
   {
     //ref.getLRBox().Volume=ref.getTotalNum()*4.0*M_PI/3.0*rs*rs*rs;
@@ -196,6 +203,18 @@ private:
     return myFunc.Xk(k, Basis.get_rc());
   }
 
+  /// set up the basis for the lattice, shared by InitBreakup and restoreBreakup
+  void initBasis(const ParticleLayout& ref)
+  {
+    //First we send the new Lattice to the Basis, in case it has been updated.
+    Basis.set_Lattice(ref);
+    //Compute RC from box-size - in constructor?
+    //No here...need update if box changes
+    int NumKnots(15);
+    Basis.set_NumKnots(NumKnots);
+    Basis.set_rc(ref.LR_rc);
+  }
+
   /** Initialise the basis and coefficients for the long-range beakup.
    *
    * We loocally create a breakup handler and pass in the basis
@@ -205,13 +224,7 @@ private:
    */
   void InitBreakup(const ParticleLayout& ref, int NumFunctions)
   {
-    //First we send the new Lattice to the Basis, in case it has been updated.
-    Basis.set_Lattice(ref);
-    //Compute RC from box-size - in constructor?
-    //No here...need update if box changes
-    int NumKnots(15);
-    Basis.set_NumKnots(NumKnots);
-    Basis.set_rc(ref.LR_rc);
+    initBasis(ref);
     //Initialise the breakup - pass in basis.
     LRBreakup<BreakupBasis> breakuphandler(Basis);
     //Find size of basis from cutoffs
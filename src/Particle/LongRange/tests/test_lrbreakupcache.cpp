@@ -0,0 +1,100 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <filesystem>
+#include "Configuration.h"
+#include "Lattice/CrystalLattice.h"
+#include "Particle/ParticleSet.h"
+#include "LongRange/LRHandlerTemp.h"
+#include "LongRange/LRBreakupCache.h"
+#include "Message/Communicate.h"
+
+namespace qmcplusplus
+{
+namespace
+{
+struct CachedCoulomb3D
+{
+  double norm;
+  inline double operator()(double r, double rinv) const { return rinv; }
+  void reset(ParticleSet& ref) { norm = 4.0 * M_PI / ref.getLRBox().Volume; }
+  inline double Xk(double k, double rc) const { return -norm / (k * k) * std::cos(k * rc); }
+  inline double Fk(double k, double rc) const { return -Xk(k, rc); }
+  inline double integrate_r2(double r) const { return 0.5 * r * r; }
+  inline double df(double r) const { return 0; }
+  void reset(ParticleSet& ref, double rs) { reset(ref); }
+};
+} // namespace
+
+TEST_CASE("LRBreakupCache", "[lrhandler]")
+{
+  using mRealType = LRHandlerBase::mRealType;
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> Lattice;
+  Lattice.BoxBConds     = true;
+  Lattice.LR_dim_cutoff = 30.;
+  Lattice.R.diagonal(5.0);
+  Lattice.reset();
+  Lattice.SetLRCutoffs(Lattice.Rv);
+
+  const SimulationCell simulation_cell(Lattice);
+  ParticleSet ref(simulation_cell);
+  ref.createSK();
+
+  const std::filesystem::path cache_dir("lrbreakup_cache_test");
+  std::filesystem::remove_all(cache_dir);
+  const LRBreakupCache cache(cache_dir, *OHMMS::Controller);
+
+  LRHandlerTemp<CachedCoulomb3D, LPQHIBasis> handler(ref);
+  const std::string key = LRBreakupCache::makeKey("opt_breakup", ref.getLRBox(), handler.get_kc());
+  CHECK(!cache.load(key, handler));
+  handler.initBreakup(ref);
+  cache.save(key, handler);
+  CHECK(std::filesystem::exists(cache.getFileName(key)));
+
+  // a different cell or handler is a different entry
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> other_lattice(Lattice);
+  other_lattice.R(0, 0) = 5.5;
+  CHECK(LRBreakupCache::makeKey("opt_breakup", other_lattice, -1) != key);
+  CHECK(LRBreakupCache::makeKey("opt_breakup_original", ref.getLRBox(), -1) != key);
+
+  LRHandlerTemp<CachedCoulomb3D, LPQHIBasis> cached_handler(ref);
+  REQUIRE(cache.load(key, cached_handler));
+  cached_handler.restoreBreakup(ref);
+
+  CHECK(cached_handler.MaxKshell == handler.MaxKshell);
+  CHECK(cached_handler.LR_kc == Approx(handler.LR_kc));
+  CHECK(cached_handler.LR_rc == Approx(handler.LR_rc));
+  REQUIRE(cached_handler.Fk_symm.size() == handler.Fk_symm.size());
+  for (int ks = 0; ks < handler.Fk_symm.size(); ks++)
+    CHECK(cached_handler.Fk_symm[ks] == Approx(handler.Fk_symm[ks]));
+  for (int ir = 1; ir < 50; ir++)
+  {
+    const mRealType r = ir * 0.05;
+    CHECK(cached_handler.evaluate(r, 1. / r) == Approx(handler.evaluate(r, 1. / r)));
+    CHECK(cached_handler.evaluateLR(r) == Approx(handler.evaluateLR(r)));
+  }
+  CHECK(cached_handler.evaluateSR_k0() == Approx(handler.evaluateSR_k0()));
+
+  // an entry whose stored key differs, as after a hash collision, is not used
+  const std::string other_key = LRBreakupCache::makeKey("opt_breakup", other_lattice, -1);
+  std::filesystem::copy_file(cache.getFileName(key), cache.getFileName(other_key));
+  LRHandlerTemp<CachedCoulomb3D, LPQHIBasis> other_handler(ref);
+  const int max_kshell = other_handler.MaxKshell;
+  CHECK(!cache.load(other_key, other_handler));
+  CHECK(other_handler.MaxKshell == max_kshell);
+  CHECK(other_handler.coefs.empty());
+
+  std::filesystem::remove_all(cache_dir);
+}
+
+} // namespace qmcplusplus
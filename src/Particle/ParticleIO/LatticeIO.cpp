@@ -142,6 +142,12 @@ bool LatticeParser::put(xmlNodePtr cur)
         else
           throw UniformCommunicateError("LatticeParser::put. Long range breakup handler not recognized.");
       }
+      else if (aname == "LR_cache_dir")
+      {
+        std::string cache_dir;
+        putContent(cache_dir, cur);
+        LRCoulombSingleton::breakup_cache_dir = cache_dir;
+      }
       else if (aname == "LR_tol")
       {
         putContent(ref_.LR_tol, cur);
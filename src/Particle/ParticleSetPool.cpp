@@ -89,6 +89,8 @@ bool ParticleSetPool::readSimulationCellXML(xmlNodePtr cur)
   {
     LatticeParser a(simulation_cell_->lattice_);
     lattice_defined = a.put(cur);
+    // the breakup cache is shared by the ranks of this group
+    LRCoulombSingleton::breakup_cache_comm = myComm;
   }
   catch (const UniformCommunicateError& ue)
   {
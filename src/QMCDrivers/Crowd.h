@@ -108,8 +108,8 @@ public:
 
   int size() const { return mcp_walkers_.size(); }
 
-  void incReject() { ++n_reject_; }
-  void incAccept() { ++n_accept_; }
+  void incReject(int n = 1) { n_reject_ += n; }
+  void incAccept(int n = 1) { n_accept_ += n; }
   void incNonlocalAccept(int n = 1) { n_nonlocal_accept_ += n; }
   unsigned long get_nonlocal_accept() { return n_nonlocal_accept_; }
   unsigned long get_accept() { return n_accept_; }
@@ -0,0 +1,228 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_CROWD_STEP_WORKSPACE_HPP
+#define QMCPLUSPLUS_CROWD_STEP_WORKSPACE_HPP
+
+#include <optional>
+#include <vector>
+#include "Configuration.h"
+#include "Particle/MCCoords.hpp"
+#include "Particle/ParticleSet.h"
+#include "Particle/Walker.h"
+#include "QMCWaveFunctions/TrialWaveFunction.h"
+#include "QMCWaveFunctions/TWFGrads.hpp"
+#include "QMCHamiltonians/QMCHamiltonian.h"
+
+namespace qmcplusplus
+{
+/** Per crowd scratch buffers used by the batched drivers within one step.
+ *
+ *  Buffers are sized by resize(num_walkers, num_particles) at the beginning of each step.
+ *  std::vector::resize never releases capacity, so once a crowd has reached its largest
+ *  walker count the driver code of the step loop runs without touching the heap even if the
+ *  crowd population fluctuates as it does in DMC. All the per particle temporaries, i.e. rr,
+ *  rejects, ratios, ..., the local energies and the walker lists of the crowd, of the T-moves
+ *  and of the all-electron moves live here instead of on the stack of the step. Allocations inside the
+ *  wavefunction and Hamiltonian components are not covered.
+ */
+template<CoordsType CT>
+struct CrowdStepWorkspace
+{
+  using RealType         = QMCTraits::RealType;
+  using FullPrecRealType = QMCTraits::FullPrecRealType;
+  using PsiValue         = QMCTraits::QTFull::ValueType;
+  using PosType          = QMCTraits::PosType;
+  using MCPWalker        = Walker<QMCTraits, PtclOnLatticeTraits>;
+
+  CrowdStepWorkspace()
+      : drifts(0), drifts_reverse(0), walker_deltas(0), deltas(0), grads_now(0), grads_new(0)
+  {}
+
+  /** size all buffers for a crowd of num_walkers walkers with num_particles particles each
+   *  only allocates if the crowd is larger than any previously seen.
+   */
+  void resize(const std::size_t num_walkers, const std::size_t num_particles)
+  {
+    resizeCoords(drifts, num_walkers);
+    resizeCoords(drifts_reverse, num_walkers);
+    resizeCoords(deltas, num_walkers);
+    resizeCoords(walker_deltas, num_walkers * num_particles);
+    resizeGrads(grads_now, num_walkers);
+    resizeGrads(grads_new, num_walkers);
+
+    ratios.resize(num_walkers);
+    log_gf.resize(num_walkers);
+    log_gb.resize(num_walkers);
+    prob.resize(num_walkers);
+    rr.resize(num_walkers);
+    rr_proposed.resize(num_walkers);
+    rr_accepted.resize(num_walkers);
+    old_energies.resize(num_walkers);
+    local_energies.resize(num_walkers);
+    rejects.resize(num_walkers);
+    nonlocal_moves_accepted.resize(num_walkers);
+    is_accepted.resize(num_walkers);
+    recompute_mask.resize(num_walkers);
+  }
+
+  /** size the additional buffers of all-electron moves
+   *  to be called after resize(num_walkers, num_particles)
+   */
+  void resizeAllElectron(const std::size_t num_walkers, const std::size_t num_particles)
+  {
+    saved_positions.resize(num_walkers * num_particles);
+    ae_drifts.resize(num_walkers * num_particles);
+    ae_drifts_new.resize(num_walkers * num_particles);
+    log_psi_old.resize(num_walkers);
+    phase_old.resize(num_walkers);
+  }
+
+  /** fill the walker lists of the crowd, led by the first walker
+   *  Same storage policy as resetNonLocalMoved, no copy of the crowd lists is allocated per step.
+   */
+  void setCrowdLists(const RefVector<ParticleSet>& elecs,
+                     const RefVector<TrialWaveFunction>& twfs,
+                     const RefVector<QMCHamiltonian>& hamiltonians)
+  {
+    fillList(walker_elecs, elecs);
+    fillList(walker_twfs, twfs);
+    fillList(walker_hamiltonians, hamiltonians);
+  }
+
+  /** empty the lists of walkers moved by T-moves
+   *  The lists keep their capacity and are only rebuilt when the crowd leader changes.
+   */
+  void resetNonLocalMoved(ParticleSet& elec_leader, TrialWaveFunction& twf_leader, const std::size_t num_walkers)
+  {
+    resetList(moved_nonlocal_elecs, elec_leader, num_walkers);
+    resetList(moved_nonlocal_twfs, twf_leader, num_walkers);
+    moved_nonlocal_walkers.clear();
+    moved_nonlocal_walkers.reserve(num_walkers);
+  }
+
+  /** empty the lists of walkers rejected by all-electron moves
+   *  same storage policy as resetNonLocalMoved
+   */
+  void resetRejected(ParticleSet& elec_leader, TrialWaveFunction& twf_leader, const std::size_t num_walkers)
+  {
+    resetList(rejected_elecs, elec_leader, num_walkers);
+    resetList(rejected_twfs, twf_leader, num_walkers);
+  }
+
+  /// capacity in walkers of the per walker buffers
+  std::size_t capacity() const { return ratios.capacity(); }
+
+  /// new positions (and spins) proposed for all walkers of the current particle
+  MCCoords<CT> drifts;
+  /// reverse move displacements for all walkers of the current particle
+  MCCoords<CT> drifts_reverse;
+  /// gaussian displacements for all particles of all walkers, particle major
+  MCCoords<CT> walker_deltas;
+  /// gaussian displacements for the current particle
+  MCCoords<CT> deltas;
+  /// gradients at the old positions
+  TWFGrads<CT> grads_now;
+  /// gradients at the proposed positions
+  TWFGrads<CT> grads_new;
+
+  std::vector<PsiValue> ratios;
+  std::vector<RealType> log_gf;
+  std::vector<RealType> log_gb;
+  std::vector<RealType> prob;
+  /// squared proposed displacement of the current particle
+  std::vector<RealType> rr;
+  /// accumulated squared displacements proposed in the step
+  std::vector<RealType> rr_proposed;
+  /// accumulated squared displacements accepted in the step
+  std::vector<RealType> rr_accepted;
+  /// local energies before the step, needed for branching
+  std::vector<FullPrecRealType> old_energies;
+  /// local energies after the step
+  std::vector<FullPrecRealType> local_energies;
+  /// int instead of bool to keep element access cheap
+  std::vector<int> rejects;
+  /// number of accepted T-moves per walker
+  std::vector<int> nonlocal_moves_accepted;
+  std::vector<bool> is_accepted;
+  std::vector<bool> recompute_mask;
+
+  /** @name walkers of the crowd, see setCrowdLists
+   *  @{
+   */
+  std::optional<RefVectorWithLeader<ParticleSet>> walker_elecs;
+  std::optional<RefVectorWithLeader<TrialWaveFunction>> walker_twfs;
+  std::optional<RefVectorWithLeader<QMCHamiltonian>> walker_hamiltonians;
+  /** @} */
+
+  /** @name walkers moved by T-moves, see resetNonLocalMoved
+   *  @{
+   */
+  RefVector<MCPWalker> moved_nonlocal_walkers;
+  std::optional<RefVectorWithLeader<ParticleSet>> moved_nonlocal_elecs;
+  std::optional<RefVectorWithLeader<TrialWaveFunction>> moved_nonlocal_twfs;
+  /** @} */
+
+  /** @name all-electron moves
+   *  walker major, num_walkers x num_particles
+   *  @{
+   */
+  /// positions of the last accepted configurations
+  std::vector<PosType> saved_positions;
+  /// drifts at the last accepted configurations
+  std::vector<PosType> ae_drifts;
+  /// drifts at the proposed configurations
+  std::vector<PosType> ae_drifts_new;
+  /// log|psi| of the last accepted configurations
+  std::vector<RealType> log_psi_old;
+  /// phase of the last accepted configurations
+  std::vector<RealType> phase_old;
+  /// walkers whose last proposal got rejected, see resetRejected
+  std::optional<RefVectorWithLeader<ParticleSet>> rejected_elecs;
+  std::optional<RefVectorWithLeader<TrialWaveFunction>> rejected_twfs;
+  /** @} */
+
+private:
+  template<typename T>
+  static void resetList(std::optional<RefVectorWithLeader<T>>& list, T& leader, const std::size_t num_walkers)
+  {
+    if (!list || &list->getLeader() != &leader)
+      list.emplace(leader);
+    list->clear();
+    list->reserve(num_walkers);
+  }
+
+  template<typename T>
+  static void fillList(std::optional<RefVectorWithLeader<T>>& list, const RefVector<T>& source)
+  {
+    resetList(list, source[0].get(), source.size());
+    for (T& element : source)
+      list->push_back(element);
+  }
+
+  static void resizeCoords(MCCoords<CT>& coords, const std::size_t size)
+  {
+    coords.positions.resize(size);
+    if constexpr (CT == CoordsType::POS_SPIN)
+      coords.spins.resize(size);
+  }
+
+  static void resizeGrads(TWFGrads<CT>& grads, const std::size_t size)
+  {
+    grads.grads_positions.resize(size);
+    if constexpr (CT == CoordsType::POS_SPIN)
+      grads.grads_spins.resize(size);
+  }
+};
+
+} // namespace qmcplusplus
+#endif
@@ -31,6 +31,7 @@
 #include "MemoryUsage.h"
 #include "QMCWaveFunctions/TWFGrads.hpp"
 #include "TauParams.hpp"
+#include "DriftDiffusionMoves.hpp"
 #include "WalkerLogManager.h"
 #include "CPU/math.hpp"
 #include "QMCHamiltonians/NonLocalTOperator.h"
@@ -92,11 +93,14 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
   const TWFdispatcher twf_dispatcher(!sft.serializing_crowd_walkers);
   const Hdispatcher ham_dispatcher(!sft.serializing_crowd_walkers);
 
-  auto& walkers = crowd.get_walkers();
-  const RefVectorWithLeader<ParticleSet> walker_elecs(crowd.get_walker_elecs()[0], crowd.get_walker_elecs());
-  const RefVectorWithLeader<TrialWaveFunction> walker_twfs(crowd.get_walker_twfs()[0], crowd.get_walker_twfs());
-  const RefVectorWithLeader<QMCHamiltonian> walker_hamiltonians(crowd.get_walker_hamiltonians()[0],
-                                                                crowd.get_walker_hamiltonians());
+  // all step temporaries come from the crowd workspace, no heap allocation in steady state.
+  auto& ws = step_context.template getWorkspace<CT>();
+  ws.setCrowdLists(crowd.get_walker_elecs(), crowd.get_walker_twfs(), crowd.get_walker_hamiltonians());
+
+  auto& walkers                   = crowd.get_walkers();
+  const auto& walker_elecs        = *ws.walker_elecs;
+  const auto& walker_twfs         = *ws.walker_twfs;
+  const auto& walker_hamiltonians = *ws.walker_hamiltonians;
 
   timers.resource_timer.start();
   ResourceCollectionTeamLock<ParticleSet> pset_res_lock(crowd.getSharedResource().pset_res, walker_elecs);
@@ -104,52 +108,63 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
   ResourceCollectionTeamLock<QMCHamiltonian> hams_res_lock(crowd.getSharedResource().ham_res, walker_hamiltonians);
   timers.resource_timer.stop();
 
-  {
-    ScopedTimer recompute_timer(dmc_timers.step_begin_recompute_timer);
-    std::vector<bool> recompute_mask;
-    recompute_mask.reserve(walkers.size());
-    for (MCPWalker& awalker : walkers)
-      if (awalker.wasTouched)
-      {
-        recompute_mask.push_back(true);
-        awalker.wasTouched = false;
-      }
-      else
-        recompute_mask.push_back(false);
-    ps_dispatcher.flex_loadWalker(walker_elecs, walkers, recompute_mask, true);
-    twf_dispatcher.flex_recompute(walker_twfs, walker_elecs, recompute_mask);
-  }
-
   const int num_walkers   = crowd.size();
   auto& pset_leader       = walker_elecs.getLeader();
   const int num_particles = pset_leader.getTotalNum();
 
-  MCCoords<CT> drifts(num_walkers), drifts_reverse(num_walkers);
-  MCCoords<CT> walker_deltas(num_walkers * num_particles), deltas(num_walkers);
-  TWFGrads<CT> grads_now(num_walkers), grads_new(num_walkers);
-
-  //This generates an entire steps worth of deltas.
-  makeGaussRandomWithEngine(walker_deltas, step_context.get_random_gen());
+  ws.resize(num_walkers, num_particles);
 
-  std::vector<PsiValue> ratios(num_walkers, PsiValue(0.0));
-  std::vector<RealType> log_gf(num_walkers, 0.0);
-  std::vector<RealType> log_gb(num_walkers, 0.0);
-  std::vector<RealType> prob(num_walkers, 0.0);
+  {
+    ScopedTimer recompute_timer(dmc_timers.step_begin_recompute_timer);
+    auto& recompute_mask = ws.recompute_mask;
+    for (int iw = 0; iw < num_walkers; ++iw)
+    {
+      MCPWalker& awalker = walkers[iw];
+      recompute_mask[iw] = awalker.wasTouched;
+      awalker.wasTouched = false;
+    }
+    ps_dispatcher.flex_loadWalker(walker_elecs, walkers, recompute_mask, true);
+    twf_dispatcher.flex_recompute(walker_twfs, walker_elecs, recompute_mask);
+  }
 
-  // local list to handle accept/reject
-  std::vector<bool> isAccepted;
-  isAccepted.reserve(num_walkers);
+  auto& drifts        = ws.drifts;
+  auto& walker_deltas = ws.walker_deltas;
+  auto& deltas        = ws.deltas;
+  auto& grads_now     = ws.grads_now;
+  auto& grads_new     = ws.grads_new;
 
   //save the old energies for branching needs.
-  std::vector<FullPrecRealType> old_energies(num_walkers);
+  auto& old_energies = ws.old_energies;
   for (int iw = 0; iw < num_walkers; ++iw)
     old_energies[iw] = walkers[iw].get().Properties(WP::LOCALENERGY);
 
-  std::vector<RealType> rr_proposed(num_walkers, 0.0);
-  std::vector<RealType> rr_accepted(num_walkers, 0.0);
+  auto& rr_proposed = ws.rr_proposed;
+  auto& rr_accepted = ws.rr_accepted;
+  std::fill(rr_proposed.begin(), rr_proposed.end(), 0.0);
+  std::fill(rr_accepted.begin(), rr_accepted.end(), 0.0);
+
+  auto phaseChanged = [&sft](RealType phase) { return sft.branch_engine.phaseChanged(phase); };
+
+  if constexpr (CT == CoordsType::POS)
+    if (sft.qmcdrv_input.isAllElectronMove())
+    {
+      ScopedTimer moveall_local_timer(timers.moveall_timer);
+      const int num_accepted =
+          advanceAllElectronMoves<MetropolisRule::DMC>(ps_dispatcher, twf_dispatcher, walker_elecs, walker_twfs,
+                                                       sft.drift_modifier, sft.qmcdrv_input.get_tau(),
+                                                       sft.population.get_ptclgrp_inv_mass(), true, 1,
+                                                       step_context.get_random_gen(), phaseChanged, ws);
+      crowd.incAccept(num_accepted);
+      crowd.incReject(num_walkers - num_accepted);
+    }
 
+  if (!sft.qmcdrv_input.isAllElectronMove())
   {
     ScopedTimer pbyp_local_timer(timers.movepbyp_timer);
+
+    //This generates an entire steps worth of deltas.
+    makeGaussRandomWithEngine(walker_deltas, step_context.get_random_gen());
+
     for (int ig = 0; ig < pset_leader.groups(); ++ig)
     {
       TauParams<RealType, CT> taus(sft.qmcdrv_input.get_tau(), sft.population.get_ptclgrp_inv_mass()[ig],
@@ -159,30 +174,11 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
 
       for (int iat = pset_leader.first(ig); iat < pset_leader.last(ig); ++iat)
       {
-        //This is very useful thing to be able to look at in the debugger
-#ifndef NDEBUG
-        std::vector<int> walkers_who_have_been_on_wire(num_walkers, 0);
-        for (int iw = 0; iw < walkers.size(); ++iw)
-        {
-          walkers[iw].get().get_has_been_on_wire() ? walkers_who_have_been_on_wire[iw] = 1
-                                                   : walkers_who_have_been_on_wire[iw] = 0;
-        }
-#endif
         //get deltas for this particle for all walkers
         walker_deltas.getSubset(iat * num_walkers, num_walkers, deltas);
 
-        // only DMC does this
-        // TODO: rr needs a real name
-        std::vector<RealType> rr(num_walkers, 0.0);
-        assert(rr.size() == deltas.positions.size());
-        std::transform(deltas.positions.begin(), deltas.positions.end(), rr.begin(),
-                       [t = taus.tauovermass](auto& delta_r) { return t * dot(delta_r, delta_r); });
-
         twf_dispatcher.flex_evalGrad(walker_twfs, walker_elecs, iat, grads_now);
-        sft.drift_modifier.getDrifts(taus, grads_now, drifts);
-
-        scaleBySqrtTau(taus, deltas);
-        drifts += deltas;
+        proposeDriftDiffusionMoves(sft.drift_modifier, taus, true, ws);
 
 // in DMC this was done here, changed to match VMCBatched pending factoring to common source
 // if (rr > m_r2max)
@@ -191,60 +187,24 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
 //   continue;
 // }
 #ifndef NDEBUG
-        for (int i = 0; i < rr.size(); ++i)
-          assert(qmcplusplus::isfinite(rr[i]));
+        for (int i = 0; i < ws.rr.size(); ++i)
+          assert(qmcplusplus::isfinite(ws.rr[i]));
 #endif
 
         ps_dispatcher.flex_makeMove(walker_elecs, iat, drifts);
 
-        twf_dispatcher.flex_calcRatioGrad(walker_twfs, walker_elecs, iat, ratios, grads_new);
-
-        computeLogGreensFunction(deltas, taus, log_gf);
-
-        sft.drift_modifier.getDrifts(taus, grads_new, drifts_reverse);
-
-        drifts_reverse += drifts;
-
-        computeLogGreensFunction(drifts_reverse, taus, log_gb);
-
-        auto checkPhaseChanged = [&sft](const PsiValue& ratio, int& is_reject) {
-          if (ratio == PsiValue(0) || sft.branch_engine.phaseChanged(std::arg(ratio)))
-            is_reject = 1;
-          else
-            is_reject = 0;
-        };
+        twf_dispatcher.flex_calcRatioGrad(walker_twfs, walker_elecs, iat, ws.ratios, grads_new);
 
         // Hopefully a phase change doesn't make any of these transformations fail.
-        std::vector<int> rejects(num_walkers); // instead of std::vector<bool>
-        for (int iw = 0; iw < num_walkers; ++iw)
-        {
-          checkPhaseChanged(ratios[iw], rejects[iw]);
-          //This is just convenient to do here
-          rr_proposed[iw] += rr[iw];
-        }
-
-        for (int iw = 0; iw < num_walkers; ++iw)
-          prob[iw] = std::norm(ratios[iw]) * std::exp(log_gb[iw] - log_gf[iw]);
+        const int num_accepted = acceptDriftDiffusionMoves<MetropolisRule::DMC>(sft.drift_modifier, taus, true,
+                                                                                step_context.get_random_gen(),
+                                                                                phaseChanged, ws);
+        crowd.incAccept(num_accepted);
+        crowd.incReject(num_walkers - num_accepted);
 
-        isAccepted.clear();
+        twf_dispatcher.flex_accept_rejectMove(walker_twfs, walker_elecs, iat, ws.is_accepted, true);
 
-        for (int iw = 0; iw < num_walkers; ++iw)
-          if ((!rejects[iw]) && prob[iw] >= std::numeric_limits<RealType>::epsilon() &&
-              step_context.get_random_gen()() < prob[iw])
-          {
-            crowd.incAccept();
-            isAccepted.push_back(true);
-            rr_accepted[iw] += rr[iw];
-          }
-          else
-          {
-            crowd.incReject();
-            isAccepted.push_back(false);
-          }
-
-        twf_dispatcher.flex_accept_rejectMove(walker_twfs, walker_elecs, iat, isAccepted, true);
-
-        ps_dispatcher.flex_accept_rejectMove<CT>(walker_elecs, iat, isAccepted);
+        ps_dispatcher.flex_accept_rejectMove<CT>(walker_elecs, iat, ws.is_accepted);
       }
     }
 
@@ -263,10 +223,11 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
   { // hamiltonian
     ScopedTimer ham_local(timers.hamiltonian_timer);
 
-    std::vector<QMCHamiltonian::FullPrecRealType> new_energies(
-        step_context.non_local_ops.getMoveKind() == TmoveKind::OFF
-            ? ham_dispatcher.flex_evaluate(walker_hamiltonians, walker_twfs, walker_elecs)
-            : ham_dispatcher.flex_evaluateWithToperator(walker_hamiltonians, walker_twfs, walker_elecs));
+    auto& new_energies = ws.local_energies;
+    if (step_context.non_local_ops.getMoveKind() == TmoveKind::OFF)
+      ham_dispatcher.flex_evaluate(walker_hamiltonians, walker_twfs, walker_elecs, new_energies);
+    else
+      ham_dispatcher.flex_evaluateWithToperator(walker_hamiltonians, walker_twfs, walker_elecs, new_energies);
 
     auto resetSigNLocalEnergy = [](MCPWalker& walker, TrialWaveFunction& twf, auto local_energy, auto rr_acc,
                                    auto rr_prop) {
@@ -289,8 +250,7 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
     ScopedTimer collectable_local(timers.collectables_timer);
 
     // evaluate non-physical hamiltonian elements
-    for (int iw = 0; iw < walkers.size(); ++iw)
-      walker_hamiltonians[iw].auxHevaluate(walker_elecs[iw], walkers[iw]);
+    ham_dispatcher.flex_auxHevaluate(walker_hamiltonians, walker_twfs, walker_elecs, walkers);
 
     // save properties into walker
     for (int iw = 0; iw < walkers.size(); ++iw)
@@ -309,14 +269,12 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
   { // T-moves
     ScopedTimer tmove_timer(dmc_timers.tmove_timer);
 
-    const auto num_walkers = walkers.size();
-    std::vector<int> walker_non_local_moves_accepted(num_walkers, 0);
-    RefVector<MCPWalker> moved_nonlocal_walkers;
-    RefVectorWithLeader<ParticleSet> moved_nonlocal_walker_elecs(crowd.get_walker_elecs()[0]);
-    RefVectorWithLeader<TrialWaveFunction> moved_nonlocal_walker_twfs(crowd.get_walker_twfs()[0]);
-    moved_nonlocal_walkers.reserve(num_walkers);
-    moved_nonlocal_walker_elecs.reserve(num_walkers);
-    moved_nonlocal_walker_twfs.reserve(num_walkers);
+    const auto num_walkers               = walkers.size();
+    auto& walker_non_local_moves_accepted = ws.nonlocal_moves_accepted;
+    ws.resetNonLocalMoved(crowd.get_walker_elecs()[0], crowd.get_walker_twfs()[0], num_walkers);
+    auto& moved_nonlocal_walkers      = ws.moved_nonlocal_walkers;
+    auto& moved_nonlocal_walker_elecs = *ws.moved_nonlocal_elecs;
+    auto& moved_nonlocal_walker_twfs  = *ws.moved_nonlocal_twfs;
 
     for (int iw = 0; iw < walkers.size(); ++iw)
     {
@@ -404,6 +362,9 @@ void DMCBatched::process(xmlNodePtr node)
 
     initPopulationAndCrowds(awc);
     createStepContexts(crowds_.size());
+
+    if (qmcdriver_input_.isAllElectronMove() && population_.get_golden_electrons().isSpinor())
+      throw UniformCommunicateError("DMCBatched doesn't support all-electron moves with spinors. Use move=\"pbyp\".");
   }
   catch (const UniformCommunicateError& ue)
   {
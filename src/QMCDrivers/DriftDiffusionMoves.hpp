@@ -0,0 +1,344 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_DRIFT_DIFFUSION_MOVES_HPP
+#define QMCPLUSPLUS_DRIFT_DIFFUSION_MOVES_HPP
+
+#include <cmath>
+#include <limits>
+#include "QMCDrivers/CrowdStepWorkspace.hpp"
+#include "QMCDrivers/GreenFunctionModifiers/DriftModifierBase.h"
+#include "TauParams.hpp"
+#include "ParticleBase/RandomSeqGenerator.h"
+#include <PSdispatcher.h>
+#include <TWFdispatcher.h>
+
+/**@file DriftDiffusionMoves.hpp
+ * Crowd wide kernels for the particle-by-particle drift-diffusion moves of VMCBatched and DMCBatched.
+ *
+ * Per particle the drivers used to chain getDrifts, scaleBySqrtTau, operator+=, computeLogGreensFunction (twice),
+ * the node crossing checks and the acceptance probabilities, each one a separate pass over the crowd.
+ * Here the proposal and the acceptance are one pass each over the walkers of the crowd.
+ * The only remaining per crowd dispatch is the drift limiting by the DriftModifierBase.
+ * Operations and the random number consumption are kept identical to the unfused sequences.
+ *
+ * advanceAllElectronMoves moves all the electrons of every walker at once and evaluates the proposed
+ * configurations with a single batched evaluateLog for the whole crowd.
+ */
+namespace qmcplusplus
+{
+/** Metropolis acceptance conventions of the batched drivers
+ *
+ *  with p = |ratio|^2 G(old<-new) / G(new<-old)
+ *  - VMC: accept if |ratio|^2 >= eps and u < p
+ *  - DMC: reject a node crossing (ratio 0 or phase change), otherwise accept if p >= eps and u < p.
+ *         The squared displacements rr are accumulated in rr_proposed and rr_accepted for the effective time step.
+ *  A uniform random number u is drawn only when the eps test passes.
+ */
+enum class MetropolisRule
+{
+  VMC,
+  DMC
+};
+
+/** propose the move of the current particle for all the walkers of the crowd
+ *
+ *  on entry ws.deltas holds unit gaussian displacements and ws.grads_now the gradients at the current positions
+ *  (only if use_drift). On exit ws.deltas is scaled by sqrt(tau/m), ws.drifts holds the full displacement
+ *  drift(grads_now) + ws.deltas and ws.rr the squared diffusive displacement tau/m |delta|^2.
+ */
+template<typename RT, CoordsType CT>
+void proposeDriftDiffusionMoves(const DriftModifierBase& drift_modifier,
+                                const TauParams<RT, CT>& taus,
+                                const bool use_drift,
+                                CrowdStepWorkspace<CT>& ws)
+{
+  // drift limiting, one dispatch for the whole crowd
+  if (use_drift)
+    drift_modifier.getDrifts(taus, ws.grads_now, ws.drifts);
+
+  const size_t num_walkers = ws.deltas.positions.size();
+  auto* restrict deltas    = ws.deltas.positions.data();
+  auto* restrict drifts    = ws.drifts.positions.data();
+  auto* restrict rr        = ws.rr.data();
+#pragma omp simd
+  for (size_t iw = 0; iw < num_walkers; ++iw)
+  {
+    rr[iw] = taus.tauovermass * dot(deltas[iw], deltas[iw]);
+    deltas[iw] *= taus.sqrttau;
+    drifts[iw] = use_drift ? drifts[iw] + deltas[iw] : deltas[iw];
+  }
+
+  if constexpr (CT == CoordsType::POS_SPIN)
+  {
+    auto* restrict spin_deltas = ws.deltas.spins.data();
+    auto* restrict spin_drifts = ws.drifts.spins.data();
+#pragma omp simd
+    for (size_t iw = 0; iw < num_walkers; ++iw)
+    {
+      spin_deltas[iw] *= taus.spin_sqrttau;
+      spin_drifts[iw] = use_drift ? spin_drifts[iw] + spin_deltas[iw] : spin_deltas[iw];
+    }
+  }
+}
+
+/** compute the acceptance probabilities of the proposed moves and make the Metropolis decisions
+ *
+ *  on entry ws.ratios and, if use_drift, ws.grads_new are evaluated at the proposed positions.
+ *  ws.drifts_reverse, ws.log_gf, ws.log_gb, ws.prob, ws.rejects and ws.is_accepted are overwritten.
+ *  @param phase_changed DMC only, predicate on arg(ratio) flagging a fixed-node/fixed-phase violation
+ *  @return number of accepted moves
+ */
+template<MetropolisRule RULE, typename RT, CoordsType CT, class RNG, class PHASE_CHANGED>
+int acceptDriftDiffusionMoves(const DriftModifierBase& drift_modifier,
+                              const TauParams<RT, CT>& taus,
+                              const bool use_drift,
+                              RNG& rng,
+                              PHASE_CHANGED&& phase_changed,
+                              CrowdStepWorkspace<CT>& ws)
+{
+  if (use_drift)
+    drift_modifier.getDrifts(taus, ws.grads_new, ws.drifts_reverse);
+
+  const size_t num_walkers = ws.ratios.size();
+  const auto* restrict deltas = ws.deltas.positions.data();
+  const auto* restrict drifts = ws.drifts.positions.data();
+  auto* restrict reverse      = ws.drifts_reverse.positions.data();
+  auto* restrict log_gf       = ws.log_gf.data();
+  auto* restrict log_gb       = ws.log_gb.data();
+
+  // Green's functions of the forward and reverse moves
+  if (use_drift)
+  {
+#pragma omp simd
+    for (size_t iw = 0; iw < num_walkers; ++iw)
+    {
+      reverse[iw] = reverse[iw] + drifts[iw];
+      log_gf[iw]  = -taus.oneover2tau * dot(deltas[iw], deltas[iw]);
+      log_gb[iw]  = -taus.oneover2tau * dot(reverse[iw], reverse[iw]);
+    }
+    if constexpr (CT == CoordsType::POS_SPIN)
+    {
+      const auto* restrict spin_deltas = ws.deltas.spins.data();
+      const auto* restrict spin_drifts = ws.drifts.spins.data();
+      auto* restrict spin_reverse      = ws.drifts_reverse.spins.data();
+#pragma omp simd
+      for (size_t iw = 0; iw < num_walkers; ++iw)
+      {
+        spin_reverse[iw] = spin_reverse[iw] + spin_drifts[iw];
+        log_gf[iw]       = log_gf[iw] - taus.spin_oneover2tau * spin_deltas[iw] * spin_deltas[iw];
+        log_gb[iw]       = log_gb[iw] - taus.spin_oneover2tau * spin_reverse[iw] * spin_reverse[iw];
+      }
+    }
+  }
+  else
+  {
+#pragma omp simd
+    for (size_t iw = 0; iw < num_walkers; ++iw)
+      log_gf[iw] = log_gb[iw] = RT(0);
+  }
+
+  // acceptance probabilities and Metropolis decisions
+  using PsiValue    = typename CrowdStepWorkspace<CT>::PsiValue;
+  constexpr RT eps = std::numeric_limits<RT>::epsilon();
+  int num_accepted = 0;
+  for (size_t iw = 0; iw < num_walkers; ++iw)
+  {
+    const auto& ratio = ws.ratios[iw];
+    bool accepted;
+    if constexpr (RULE == MetropolisRule::DMC)
+    {
+      ws.prob[iw]    = std::norm(ratio) * std::exp(log_gb[iw] - log_gf[iw]);
+      ws.rejects[iw] = (ratio == PsiValue(0) || phase_changed(std::arg(ratio))) ? 1 : 0;
+      ws.rr_proposed[iw] += ws.rr[iw];
+      accepted = !ws.rejects[iw] && ws.prob[iw] >= eps && rng() < ws.prob[iw];
+      if (accepted)
+        ws.rr_accepted[iw] += ws.rr[iw];
+    }
+    else
+    {
+      const RT ratio2 = std::norm(ratio);
+      ws.prob[iw]     = ratio2 * std::exp(log_gb[iw] - log_gf[iw]);
+      ws.rejects[iw]  = 0;
+      accepted        = ratio2 >= eps && rng() < ws.prob[iw];
+    }
+    ws.is_accepted[iw] = accepted;
+    num_accepted += accepted;
+  }
+  return num_accepted;
+}
+
+/** all-electron drift-diffusion moves of every walker in the crowd
+ *
+ *  The batched counterpart of VMCUpdateAll/DMCUpdateAll. Each sub step proposes new positions for all the electrons
+ *  of all the walkers, updates the distance tables and evaluates log(psi), G and L of the whole crowd in one
+ *  mw_evaluateLog so the wavefunction components can use large batched kernels instead of rank-1 updates.
+ *  Walkers whose last proposal got rejected are restored and re-evaluated at the end.
+ *  On exit, the particle sets and wavefunctions of all walkers are consistent with the accepted configurations.
+ *
+ *  ws must have been sized by ws.resize(num_walkers, num_particles).
+ *  For DMC, rr_proposed and rr_accepted accumulate the squared diffusive displacements of all the electrons.
+ *  @param grp_inv_mass inverse mass per particle group
+ *  @param phase_changed DMC only, predicate on the phase difference flagging a fixed-node/fixed-phase violation
+ *  @return number of accepted moves summed over walkers and sub steps
+ */
+template<MetropolisRule RULE, typename RT, class RNG, class PHASE_CHANGED>
+int advanceAllElectronMoves(const PSdispatcher& ps_dispatcher,
+                            const TWFdispatcher& twf_dispatcher,
+                            const RefVectorWithLeader<ParticleSet>& walker_elecs,
+                            const RefVectorWithLeader<TrialWaveFunction>& walker_twfs,
+                            const DriftModifierBase& drift_modifier,
+                            const RT tau,
+                            const std::vector<RT>& grp_inv_mass,
+                            const bool use_drift,
+                            const int num_sub_steps,
+                            RNG& rng,
+                            PHASE_CHANGED&& phase_changed,
+                            CrowdStepWorkspace<CoordsType::POS>& ws)
+{
+  using PosType            = QMCTraits::PosType;
+  auto& pset_leader        = walker_elecs.getLeader();
+  const int num_walkers    = walker_elecs.size();
+  const int num_particles  = pset_leader.getTotalNum();
+  const int num_groups     = pset_leader.groups();
+  ws.resizeAllElectron(num_walkers, num_particles);
+  if (num_sub_steps <= 0)
+    return 0;
+
+  auto computeDrifts = [&](const ParticleSet& elecs, PosType* restrict drifts) {
+    for (int ig = 0; ig < num_groups; ++ig)
+    {
+      const RT tauovermass = tau * grp_inv_mass[ig];
+      for (int iat = pset_leader.first(ig); iat < pset_leader.last(ig); ++iat)
+        drift_modifier.getDrift(tauovermass, elecs.G[iat], drifts[iat]);
+    }
+  };
+
+  // the current configurations are the last accepted ones
+  for (int iw = 0; iw < num_walkers; ++iw)
+  {
+    const ParticleSet& elecs = walker_elecs[iw];
+    std::copy_n(elecs.R.begin(), num_particles, ws.saved_positions.begin() + iw * num_particles);
+    ws.log_psi_old[iw] = walker_twfs[iw].getLogPsi();
+    ws.phase_old[iw]   = walker_twfs[iw].getPhase();
+    if (use_drift)
+      computeDrifts(elecs, ws.ae_drifts.data() + iw * num_particles);
+  }
+
+  constexpr RT eps = std::numeric_limits<RT>::epsilon();
+  int num_accepted = 0;
+  for (int sub_step = 0; sub_step < num_sub_steps; ++sub_step)
+  {
+    // walker major here, all the electrons of a walker are contiguous
+    makeGaussRandomWithEngine(ws.walker_deltas, rng);
+
+    // propose
+    for (int iw = 0; iw < num_walkers; ++iw)
+    {
+      ParticleSet& elecs                  = walker_elecs[iw];
+      PosType* restrict deltas            = ws.walker_deltas.positions.data() + iw * num_particles;
+      const PosType* restrict saved       = ws.saved_positions.data() + iw * num_particles;
+      const PosType* restrict drifts_old  = ws.ae_drifts.data() + iw * num_particles;
+      RT rr = 0;
+      for (int ig = 0; ig < num_groups; ++ig)
+      {
+        const RT tauovermass = tau * grp_inv_mass[ig];
+        const RT sqrttau     = std::sqrt(tauovermass);
+        for (int iat = pset_leader.first(ig); iat < pset_leader.last(ig); ++iat)
+        {
+          rr += tauovermass * dot(deltas[iat], deltas[iat]);
+          deltas[iat] *= sqrttau;
+          elecs.R[iat] = use_drift ? saved[iat] + drifts_old[iat] + deltas[iat] : saved[iat] + deltas[iat];
+        }
+      }
+      ws.rr[iw] = rr;
+    }
+
+    ps_dispatcher.flex_update(walker_elecs);
+    twf_dispatcher.flex_evaluateLog(walker_twfs, walker_elecs);
+
+    // accept or reject
+    for (int iw = 0; iw < num_walkers; ++iw)
+    {
+      const ParticleSet& elecs          = walker_elecs[iw];
+      const PosType* restrict deltas    = ws.walker_deltas.positions.data() + iw * num_particles;
+      PosType* restrict saved           = ws.saved_positions.data() + iw * num_particles;
+      PosType* restrict drifts_new      = ws.ae_drifts_new.data() + iw * num_particles;
+      RT log_gf = 0, log_gb = 0;
+      if (use_drift)
+      {
+        computeDrifts(elecs, drifts_new);
+        for (int ig = 0; ig < num_groups; ++ig)
+        {
+          const RT oneover2tau = 0.5 / (tau * grp_inv_mass[ig]);
+          for (int iat = pset_leader.first(ig); iat < pset_leader.last(ig); ++iat)
+          {
+            const PosType reverse = saved[iat] - elecs.R[iat] - drifts_new[iat];
+            log_gf -= oneover2tau * dot(deltas[iat], deltas[iat]);
+            log_gb -= oneover2tau * dot(reverse, reverse);
+          }
+        }
+      }
+
+      TrialWaveFunction& twf = walker_twfs[iw];
+      ws.prob[iw]            = std::exp(log_gb - log_gf + 2 * (twf.getLogPsi() - ws.log_psi_old[iw]));
+      bool accepted;
+      if constexpr (RULE == MetropolisRule::DMC)
+      {
+        ws.rejects[iw] = phase_changed(twf.getPhase() - ws.phase_old[iw]) ? 1 : 0;
+        ws.rr_proposed[iw] += ws.rr[iw];
+        accepted = !ws.rejects[iw] && ws.prob[iw] >= eps && rng() < ws.prob[iw];
+        if (accepted)
+          ws.rr_accepted[iw] += ws.rr[iw];
+      }
+      else
+      {
+        ws.rejects[iw] = 0;
+        accepted       = rng() < ws.prob[iw];
+      }
+
+      if (accepted)
+      {
+        std::copy_n(elecs.R.begin(), num_particles, saved);
+        if (use_drift)
+          std::copy_n(drifts_new, num_particles, ws.ae_drifts.data() + iw * num_particles);
+        ws.log_psi_old[iw] = twf.getLogPsi();
+        ws.phase_old[iw]   = twf.getPhase();
+      }
+      ws.is_accepted[iw] = accepted;
+      num_accepted += accepted;
+    }
+  }
+
+  // put walkers rejected in the last sub step back to their accepted configurations
+  ws.resetRejected(pset_leader, walker_twfs.getLeader(), num_walkers);
+  auto& rejected_elecs = *ws.rejected_elecs;
+  auto& rejected_twfs  = *ws.rejected_twfs;
+  for (int iw = 0; iw < num_walkers; ++iw)
+    if (!ws.is_accepted[iw])
+    {
+      ParticleSet& elecs = walker_elecs[iw];
+      std::copy_n(ws.saved_positions.begin() + iw * num_particles, num_particles, elecs.R.begin());
+      rejected_elecs.push_back(elecs);
+      rejected_twfs.push_back(walker_twfs[iw]);
+    }
+  if (rejected_elecs.size())
+  {
+    ps_dispatcher.flex_update(rejected_elecs);
+    twf_dispatcher.flex_evaluateLog(rejected_twfs, rejected_elecs);
+  }
+
+  return num_accepted;
+}
+
+} // namespace qmcplusplus
+#endif
@@ -77,7 +77,7 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   OhmmsAttributeSet aAttrib;
   // first stage in from QMCDriverFactory
   aAttrib.add(qmc_method_, "method");
-  aAttrib.add(update_mode_, "move");
+  aAttrib.add(update_mode_, "move", {"pbyp", "alle"});
   aAttrib.add(scoped_profiling_, "profiling");
   aAttrib.add(Period4CheckPoint, "checkpoint");
   aAttrib.add(k_delay_, "kdelay");
@@ -140,6 +140,8 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
     app_summary() << "  Batched operations are serialized over walkers." << std::endl;
   if (scoped_profiling_)
     app_summary() << "  Profiler data collection is enabled in this driver scope." << std::endl;
+  if (isAllElectronMove())
+    app_summary() << "  All-electron moves are used instead of particle-by-particle moves." << std::endl;
 
   if (debug_checks_str == "no")
     debug_checks_ = DriverDebugChecks::ALL_OFF;
@@ -130,6 +130,8 @@ public:
 
   const std::string& get_qmc_method() const { return qmc_method_; }
   const std::string& get_update_mode() const { return update_mode_; }
+  /// "alle" moves all the particles of a walker at once, like the legacy drivers
+  bool isAllElectronMove() const { return update_mode_ == "alle"; }
   DriverDebugChecks get_debug_checks() const { return debug_checks_; }
   bool get_scoped_profiling() const { return scoped_profiling_; }
   bool areWalkersSerialized() const { return crowd_serialize_walkers_; }
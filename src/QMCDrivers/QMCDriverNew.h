@@ -41,6 +41,7 @@
 #include "DriverWalkerTypes.h"
 #include "TauParams.hpp"
 #include "Particle/MCCoords.hpp"
+#include "CrowdStepWorkspace.hpp"
 #include "WalkerLogInput.h"
 #include <algorithm>
 
@@ -118,8 +119,20 @@ protected:
     ContextForSteps(RandomBase<FullPrecRealType>& random_gen) : random_gen_(random_gen) {}
     RandomBase<FullPrecRealType>& get_random_gen() { return random_gen_; }
 
+    /// scratch buffers reused across the steps of this crowd
+    template<CoordsType CT>
+    CrowdStepWorkspace<CT>& getWorkspace()
+    {
+      if constexpr (CT == CoordsType::POS_SPIN)
+        return workspace_pos_spin_;
+      else
+        return workspace_pos_;
+    }
+
   protected:
     RandomBase<FullPrecRealType>& random_gen_;
+    CrowdStepWorkspace<CoordsType::POS> workspace_pos_;
+    CrowdStepWorkspace<CoordsType::POS_SPIN> workspace_pos_spin_;
   };
 
   /** This is a data structure strictly for QMCDriver and its derived classes
@@ -364,6 +377,7 @@ protected:
     NewTimer& init_walkers_timer;
     NewTimer& buffer_timer;
     NewTimer& movepbyp_timer;
+    NewTimer& moveall_timer;
     NewTimer& hamiltonian_timer;
     NewTimer& collectables_timer;
     NewTimer& estimators_timer;
@@ -379,6 +393,7 @@ protected:
           init_walkers_timer(createGlobalTimer(prefix + "InitWalkers", timer_level_medium)),
           buffer_timer(createGlobalTimer(prefix + "Buffer", timer_level_medium)),
           movepbyp_timer(createGlobalTimer(prefix + "MovePbyP", timer_level_medium)),
+          moveall_timer(createGlobalTimer(prefix + "MoveAll", timer_level_medium)),
           hamiltonian_timer(createGlobalTimer(prefix + "Hamiltonian", timer_level_medium)),
           collectables_timer(createGlobalTimer(prefix + "Collectables", timer_level_medium)),
           estimators_timer(createGlobalTimer(prefix + "Estimators", timer_level_medium)),
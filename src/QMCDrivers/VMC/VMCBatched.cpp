@@ -24,6 +24,7 @@
 #include <TWFdispatcher.h>
 #include <Hdispatcher.h>
 #include "TauParams.hpp"
+#include "DriftDiffusionMoves.hpp"
 #include "WalkerLogManager.h"
 
 namespace qmcplusplus
@@ -66,9 +67,13 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
   const PSdispatcher ps_dispatcher(!sft.serializing_crowd_walkers);
   const TWFdispatcher twf_dispatcher(!sft.serializing_crowd_walkers);
   const Hdispatcher ham_dispatcher(!sft.serializing_crowd_walkers);
-  auto& walkers = crowd.get_walkers();
-  const RefVectorWithLeader<ParticleSet> walker_elecs(crowd.get_walker_elecs()[0], crowd.get_walker_elecs());
-  const RefVectorWithLeader<TrialWaveFunction> walker_twfs(crowd.get_walker_twfs()[0], crowd.get_walker_twfs());
+  // all step temporaries come from the crowd workspace, no heap allocation in steady state.
+  auto& ws = step_context.template getWorkspace<CT>();
+  ws.setCrowdLists(crowd.get_walker_elecs(), crowd.get_walker_twfs(), crowd.get_walker_hamiltonians());
+
+  auto& walkers            = crowd.get_walkers();
+  const auto& walker_elecs = *ws.walker_elecs;
+  const auto& walker_twfs  = *ws.walker_twfs;
 
   // This is really a waste the resources can be acquired outside of the run steps loop in VMCD!
   // I don't see an  easy way to measure the release without putting the weight of tons of timer_manager calls in
@@ -80,29 +85,37 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
   if (sft.qmcdrv_input.get_debug_checks() & DriverDebugChecks::CHECKGL_AFTER_LOAD)
     checkLogAndGL(crowd, "checkGL_after_load", sft.serializing_crowd_walkers);
 
+  if constexpr (CT == CoordsType::POS)
+    if (sft.qmcdrv_input.isAllElectronMove())
+    {
+      ScopedTimer moveall_local_timer(timers.moveall_timer);
+      const int num_walkers = crowd.size();
+      const int num_steps   = sft.qmcdrv_input.get_sub_steps();
+      ws.resize(num_walkers, walker_elecs.getLeader().getTotalNum());
+      const int num_accepted =
+          advanceAllElectronMoves<MetropolisRule::VMC>(ps_dispatcher, twf_dispatcher, walker_elecs, walker_twfs,
+                                                       sft.drift_modifier, sft.qmcdrv_input.get_tau(),
+                                                       sft.population.get_ptclgrp_inv_mass(),
+                                                       sft.vmcdrv_input.get_use_drift(), num_steps,
+                                                       step_context.get_random_gen(), [](RealType) { return false; },
+                                                       ws);
+      crowd.incAccept(num_accepted);
+      crowd.incReject(num_walkers * num_steps - num_accepted);
+    }
+
+  if (!sft.qmcdrv_input.isAllElectronMove())
   {
     ScopedTimer pbyp_local_timer(timers.movepbyp_timer);
     const int num_walkers   = crowd.size();
     auto& walker_leader     = walker_elecs.getLeader();
     const int num_particles = walker_leader.getTotalNum();
-    // Note std::vector<bool> is not like the rest of stl.
-    std::vector<bool> moved(num_walkers, false);
-    constexpr RealType mhalf(-0.5);
-    const bool use_drift = sft.vmcdrv_input.get_use_drift();
-
-    std::vector<TrialWaveFunction::PsiValue> ratios(num_walkers);
-    std::vector<RealType> log_gf(num_walkers);
-    std::vector<RealType> log_gb(num_walkers);
-    std::vector<RealType> prob(num_walkers);
+    const bool use_drift    = sft.vmcdrv_input.get_use_drift();
 
-    // local list to handle accept/reject
-    std::vector<bool> isAccepted;
-    std::vector<std::reference_wrapper<TrialWaveFunction>> twf_accept_list, twf_reject_list;
-    isAccepted.reserve(num_walkers);
+    ws.resize(num_walkers, num_particles);
 
-    MCCoords<CT> drifts(num_walkers), drifts_reverse(num_walkers);
-    MCCoords<CT> walker_deltas(num_walkers * num_particles), deltas(num_walkers);
-    TWFGrads<CT> grads_now(num_walkers), grads_new(num_walkers);
+    auto& drifts        = ws.drifts;
+    auto& walker_deltas = ws.walker_deltas;
+    auto& deltas        = ws.deltas;
 
     for (int sub_step = 0; sub_step < sft.qmcdrv_input.get_sub_steps(); sub_step++)
     {
@@ -121,55 +134,29 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
         {
           //get deltas for this particle (iat) for all walkers
           walker_deltas.getSubset(iat * num_walkers, num_walkers, deltas);
-          scaleBySqrtTau(taus, deltas);
 
           if (use_drift)
-          {
-            twf_dispatcher.flex_evalGrad(walker_twfs, walker_elecs, iat, grads_now);
-            sft.drift_modifier.getDrifts(taus, grads_now, drifts);
-            drifts += deltas;
-          }
-          else
-            drifts = deltas;
+            twf_dispatcher.flex_evalGrad(walker_twfs, walker_elecs, iat, ws.grads_now);
+          proposeDriftDiffusionMoves(sft.drift_modifier, taus, use_drift, ws);
 
           ps_dispatcher.flex_makeMove(walker_elecs, iat, drifts);
 
           // This is inelegant
           if (use_drift)
-          {
-            twf_dispatcher.flex_calcRatioGrad(walker_twfs, walker_elecs, iat, ratios, grads_new);
-
-            computeLogGreensFunction(deltas, taus, log_gf);
-
-            sft.drift_modifier.getDrifts(taus, grads_new, drifts_reverse);
-
-            drifts_reverse += drifts;
-
-            computeLogGreensFunction(drifts_reverse, taus, log_gb);
-          }
+            twf_dispatcher.flex_calcRatioGrad(walker_twfs, walker_elecs, iat, ws.ratios, ws.grads_new);
           else
-            twf_dispatcher.flex_calcRatio(walker_twfs, walker_elecs, iat, ratios);
-
-          std::transform(ratios.begin(), ratios.end(), prob.begin(), [](auto ratio) { return std::norm(ratio); });
+            twf_dispatcher.flex_calcRatio(walker_twfs, walker_elecs, iat, ws.ratios);
 
-          isAccepted.clear();
+          const int num_accepted =
+              acceptDriftDiffusionMoves<MetropolisRule::VMC>(sft.drift_modifier, taus, use_drift,
+                                                             step_context.get_random_gen(),
+                                                             [](RealType) { return false; }, ws);
+          crowd.incAccept(num_accepted);
+          crowd.incReject(num_walkers - num_accepted);
 
-          for (int i_accept = 0; i_accept < num_walkers; ++i_accept)
-            if (prob[i_accept] >= std::numeric_limits<RealType>::epsilon() &&
-                step_context.get_random_gen()() < prob[i_accept] * std::exp(log_gb[i_accept] - log_gf[i_accept]))
-            {
-              crowd.incAccept();
-              isAccepted.push_back(true);
-            }
-            else
-            {
-              crowd.incReject();
-              isAccepted.push_back(false);
-            }
+          twf_dispatcher.flex_accept_rejectMove(walker_twfs, walker_elecs, iat, ws.is_accepted, true);
 
-          twf_dispatcher.flex_accept_rejectMove(walker_twfs, walker_elecs, iat, isAccepted, true);
-
-          ps_dispatcher.flex_accept_rejectMove<CT>(walker_elecs, iat, isAccepted);
+          ps_dispatcher.flex_accept_rejectMove<CT>(walker_elecs, iat, ws.is_accepted);
         }
       }
       twf_dispatcher.flex_completeUpdates(walker_twfs);
@@ -186,13 +173,12 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
     ps_dispatcher.flex_saveWalker(walker_elecs, walkers);
   }
 
-  const RefVectorWithLeader<QMCHamiltonian> walker_hamiltonians(crowd.get_walker_hamiltonians()[0],
-                                                                crowd.get_walker_hamiltonians());
+  const auto& walker_hamiltonians = *ws.walker_hamiltonians;
+  ResourceCollectionTeamLock<QMCHamiltonian> hams_res_lock(crowd.getSharedResource().ham_res, walker_hamiltonians);
   {
     ScopedTimer hamiltonian_local_timer(timers.hamiltonian_timer);
-    ResourceCollectionTeamLock<QMCHamiltonian> hams_res_lock(crowd.getSharedResource().ham_res, walker_hamiltonians);
-    std::vector<QMCHamiltonian::FullPrecRealType> local_energies(
-        ham_dispatcher.flex_evaluate(walker_hamiltonians, walker_twfs, walker_elecs));
+    auto& local_energies = ws.local_energies;
+    ham_dispatcher.flex_evaluate(walker_hamiltonians, walker_twfs, walker_elecs, local_energies);
 
     auto resetSigNLocalEnergy = [](MCPWalker& walker, TrialWaveFunction& twf, auto& local_energy) {
       walker.resetProperty(twf.getLogPsi(), twf.getPhase(), local_energy);
@@ -203,11 +189,7 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
 
   {
     ScopedTimer collectables_local_timer(timers.collectables_timer);
-    auto evaluateNonPhysicalHamiltonianElements = [](QMCHamiltonian& ham, ParticleSet& pset, MCPWalker& walker) {
-      ham.auxHevaluate(pset, walker);
-    };
-    for (int iw = 0; iw < crowd.size(); ++iw)
-      evaluateNonPhysicalHamiltonianElements(walker_hamiltonians[iw], walker_elecs[iw], walkers[iw]);
+    ham_dispatcher.flex_auxHevaluate(walker_hamiltonians, walker_twfs, walker_elecs, walkers);
 
     auto savePropertiesIntoWalker = [](QMCHamiltonian& ham, MCPWalker& walker) {
       ham.saveProperty(walker.getPropertyBase());
@@ -286,6 +268,9 @@ void VMCBatched::process(xmlNodePtr node)
 
     initPopulationAndCrowds(awc);
     createStepContexts(crowds_.size());
+
+    if (qmcdriver_input_.isAllElectronMove() && population_.get_golden_electrons().isSpinor())
+      throw UniformCommunicateError("VMCBatched doesn't support all-electron moves with spinors. Use move=\"pbyp\".");
   }
   catch (const UniformCommunicateError& ue)
   {
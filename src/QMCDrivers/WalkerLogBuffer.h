@@ -17,6 +17,7 @@
 #include <Configuration.h>
 #include "OhmmsPETE/OhmmsArray.h"
 #include "hdf/hdf_archive.h"
+#include "Estimators/ColumnStream.h"
 
 #include <unordered_set>
 
@@ -141,10 +142,10 @@ public:
   }
 
   /// current number of rows in the data buffer
-  inline size_t nrows() { return buffer.size(0); }
+  inline size_t nrows() const { return buffer.size(0); }
 
   /// current number of columns in the data buffer (row size)
-  inline size_t ncols() { return buffer.size(1); }
+  inline size_t ncols() const { return buffer.size(1); }
 
   /// resize the buffer to zero
   inline void resetBuffer() { buffer.resize(0, buffer.size(1)); }
@@ -269,7 +270,7 @@ public:
 
 
   /// add a data row from another buffer to this one
-  inline void addRow(WalkerLogBuffer<T> other, size_t i)
+  inline void addRow(const WalkerLogBuffer<T>& other, size_t i)
   {
     auto& other_buffer = other.buffer;
     if (first_collect)
@@ -335,11 +336,14 @@ public:
 
 
   /// write the buffer data into the HDF file
-  inline void writeHDF(hdf_archive& f) { writeHDF(f, hdf_file_pointer); }
+  inline void writeHDF(hdf_archive& f, unsigned deflate_level) { writeHDF(f, hdf_file_pointer, deflate_level); }
 
 
-  /// write the buffer data into the HDF file
-  inline void writeHDF(hdf_archive& f, hsize_t& file_pointer)
+  /** write the buffer data into the HDF file
+   *    The dataset is stored in chunks of about 1MB, compressed when deflate_level > 0.
+   *    The file is not flushed, see WalkerLogManager::writeBuffersHDF()
+   */
+  inline void writeHDF(hdf_archive& f, hsize_t& file_pointer, unsigned deflate_level)
   {
     auto& top = label;
     hsize_t dims[2];
@@ -347,11 +351,37 @@ public:
     dims[1] = buffer.size(1);
     if (dims[0] > 0)
     {
+      const hsize_t chunk_rows = std::max<hsize_t>(1, (hsize_t(1) << 20) / (dims[1] * sizeof(T)));
       f.push(top);
-      h5d_append(f.top(), "data", file_pointer, buffer.dim(), dims, buffer.data());
+      h5d_append(f.top(), "data", file_pointer, buffer.dim(), dims, buffer.data(), chunk_rows, H5P_DEFAULT,
+                 deflate_level);
       f.pop();
     }
-    f.flush();
+  }
+
+
+  /// one column per walker quantity, for writing the buffer with ColumnStreamWriter
+  inline ColumnLayout makeColumnLayout() const
+  {
+    ColumnType type = ColumnType::int64;
+    if (!std::is_integral<T>::value)
+      type = sizeof(T) == sizeof(float) ? ColumnType::float32 : ColumnType::float64;
+    ColumnLayout layout;
+    for (auto& wqi : quantity_info)
+      layout.push_back({wqi.name, type, wqi.buffer_end - wqi.buffer_start});
+    return layout;
+  }
+
+
+  /// append all the rows of the buffer to a chunk with the layout of makeColumnLayout()
+  inline void appendColumns(ColumnChunk& chunk) const
+  {
+    for (size_t i = 0; i < buffer.size(0); ++i)
+      for (size_t n = 0; n < quantity_info.size(); ++n)
+      {
+        auto& wqi = quantity_info[n];
+        chunk.append(n, &buffer(i, wqi.buffer_start), wqi.buffer_end - wqi.buffer_start);
+      }
   }
 
 private:
@@ -11,6 +11,7 @@
 #define QMCPLUSPLUS_WALKERLOGINPUT_H
 
 #include "InputSection.h"
+#include "Message/UniformCommunicateError.h"
 
 namespace qmcplusplus
 {
@@ -26,15 +27,32 @@ struct WalkerLogInput : public InputSection
   WalkerLogInput(xmlNodePtr cur)
   {
     section_name   = "walkerlogs";
-    attributes     = {"step_period", "particle", "min", "max", "median", "quantiles", "verbose"};
-    integers       = {"step_period"};
+    attributes     = {"step_period", "particle", "min",    "max",         "median",
+                      "quantiles",   "verbose",  "format", "compression", "max_mb_per_s"};
+    strings        = {"format"};
+    integers       = {"step_period", "compression"};
+    reals          = {"max_mb_per_s"};
     bools          = {"particle", "min", "max", "median", "quantiles", "verbose"};
-    default_values = {{"step_period", int(1)}, {"particle", bool(false)}, {"min", bool(true)},     {"max", bool(true)},
-                      {"median", bool(true)},  {"quantiles", bool(true)}, {"verbose", bool(false)}};
+    default_values = {{"step_period", int(1)},  {"particle", bool(false)},        {"min", bool(true)},
+                      {"max", bool(true)},      {"median", bool(true)},           {"quantiles", bool(true)},
+                      {"verbose", bool(false)}, {"format", std::string("hdf5")}, {"compression", int(1)},
+                      {"max_mb_per_s", Real(0)}};
     present        = cur != NULL;
     if (present)
       readXML(cur);
   };
+
+  void checkParticularValidity() override
+  {
+    const std::string error_tag{"walkerlogs input: "};
+    const auto& format = get<std::string>("format");
+    if (format != "hdf5" && format != "columnar")
+      throw UniformCommunicateError(error_tag + "format must be hdf5 or columnar, not " + format);
+    if (get<int>("compression") < 0 || get<int>("compression") > 9)
+      throw UniformCommunicateError(error_tag + "compression must be a deflate level from 0 to 9");
+    if (get<Real>("max_mb_per_s") < 0)
+      throw UniformCommunicateError(error_tag + "max_mb_per_s must not be negative");
+  }
 };
 
 } // namespace qmcplusplus
@@ -10,6 +10,9 @@
 //////////////////////////////////////////////////////////////////////////////////////
 
 #include "WalkerLogManager.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
 #include "WalkerLogInput.h"
 #include "Concurrency/Info.hpp"
 
@@ -46,6 +49,18 @@ WalkerLogManager::WalkerLogManager(WalkerLogInput& inp, bool allow_logs, std::st
     write_min_data      = inp.get<bool>("min") && quantiles;
     write_max_data      = inp.get<bool>("max") && quantiles;
     write_med_data      = inp.get<bool>("median") && quantiles;
+    format              = inp.get<std::string>("format");
+    compression_level   = inp.get<int>("compression");
+    // bandwidth of the rank, shared by the background writers
+    const auto max_mb_per_s = inp.get<WalkerLogInput::Real>("max_mb_per_s");
+    if (max_mb_per_s > 0)
+    {
+      if (format == "columnar")
+        rate_limiter = std::make_shared<ColumnRateLimiter>(max_mb_per_s * 1.0e6);
+      else
+        app_warning() << "WalkerLogManager max_mb_per_s is ignored, it only applies to format=\"columnar\""
+                      << std::endl;
+    }
   }
 
   // label min energy walker buffers for HDF file write
@@ -135,77 +150,70 @@ void WalkerLogManager::writeBuffers()
   if (write_min_data || write_max_data || write_med_data)
   {
     // gather per energy and step data for all walker throughout the MC block
+    size_t first_step = std::numeric_limits<size_t>::max();
+    size_t last_step  = 0;
     for (size_t c = 0; c < collectors.size(); ++c)
     {
       WalkerLogCollector& tc = collectors[c];
       tc.checkBuffers();
       for (size_t r = 0; r < tc.energies.size(); ++r)
+      {
         energy_order.push_back(std::make_tuple(tc.steps[r], tc.energies[r], c, r));
+        first_step = std::min(first_step, tc.steps[r]);
+        last_step  = std::max(last_step, tc.steps[r]);
+      }
+    }
+    // group the data by step with a counting sort, a block only spans a few steps
+    if (!energy_order.empty())
+    {
+      step_offsets.assign(last_step - first_step + 2, 0);
+      for (auto& v : energy_order)
+        step_offsets[std::get<0>(v) - first_step + 1]++;
+      std::partial_sum(step_offsets.begin(), step_offsets.end(), step_offsets.begin());
+      step_order.resize(energy_order.size());
+      for (auto& v : energy_order)
+        step_order[step_offsets[std::get<0>(v) - first_step]++] = v;
+      // the scatter advanced each offset to the start of the next step
+      std::rotate(step_offsets.rbegin(), step_offsets.rbegin() + 1, step_offsets.rend());
+      step_offsets[0] = 0;
     }
-    // sort the data by step and energy to enable selection of min/max/median energy walker data
-    std::sort(energy_order.begin(), energy_order.end());
     // select out the min/max/median energy walker data and store in rank-level buffers
-    size_t n = 0;
-    size_t n1, n2;
-    size_t prev_step;
-    for (auto& v : energy_order)
+    //   ties in energy are broken by collector and row as a full sort of energy_order would
+    auto addRows = [&collectors](const auto& v, auto& property_int, auto& property_real, auto& particle_real) {
+      WalkerLogCollector& tc = collectors[std::get<2>(v)];
+      const size_t r         = std::get<3>(v);
+      property_int.addRow(tc.walker_property_int_buffer, r);
+      property_real.addRow(tc.walker_property_real_buffer, r);
+      particle_real.addRow(tc.walker_particle_real_buffer, r);
+    };
+    for (size_t s = 0; s + 1 < step_offsets.size(); ++s)
     {
-      auto step = std::get<0>(v);
-      if (n == 0)
-      {
-        n1        = n;
-        prev_step = step;
-      }
-      if (step != prev_step || n == energy_order.size() - 1)
+      auto first = step_order.begin() + step_offsets[s];
+      auto last  = step_order.begin() + step_offsets[s + 1];
+      if (first == last)
+        continue; // step not sampled
+      if (write_min_data)
+        addRows(*std::min_element(first, last), wmin_property_int_buffer, wmin_property_real_buffer,
+                wmin_particle_real_buffer);
+      if (write_max_data)
+        addRows(*std::max_element(first, last), wmax_property_int_buffer, wmax_property_real_buffer,
+                wmax_particle_real_buffer);
+      if (write_med_data)
       {
-        // for a given step, find data for min/max/median energy walkers
-        //   n1/n2 are indices of the first/last data in energy_order for this step
-        if (step != prev_step)
-          n2 = n - 1;
-        if (n == energy_order.size() - 1)
-          n2 = n;
-        auto nmin = n1;            // index of minimum energy walker for this step
-        auto nmax = n2;            // index of maximum energy walker for this step
-        auto nmed = (n1 + n2) / 2; // index of median  energy walker for this step
-        size_t c, r;
-        if (write_min_data)
-        { //  cache data for minimum energy walker
-          c                      = std::get<2>(energy_order[nmin]);
-          r                      = std::get<3>(energy_order[nmin]);
-          WalkerLogCollector& tc = collectors[c];
-          wmin_property_int_buffer.addRow(tc.walker_property_int_buffer, r);
-          wmin_property_real_buffer.addRow(tc.walker_property_real_buffer, r);
-          wmin_particle_real_buffer.addRow(tc.walker_particle_real_buffer, r);
-        }
-        if (write_max_data)
-        { //  cache data for maximum energy walker
-          c                      = std::get<2>(energy_order[nmax]);
-          r                      = std::get<3>(energy_order[nmax]);
-          WalkerLogCollector& tc = collectors[c];
-          wmax_property_int_buffer.addRow(tc.walker_property_int_buffer, r);
-          wmax_property_real_buffer.addRow(tc.walker_property_real_buffer, r);
-          wmax_particle_real_buffer.addRow(tc.walker_particle_real_buffer, r);
-        }
-        if (write_med_data)
-        { //  cache data for median energy walker
-          c                      = std::get<2>(energy_order[nmed]);
-          r                      = std::get<3>(energy_order[nmed]);
-          WalkerLogCollector& tc = collectors[c];
-          wmed_property_int_buffer.addRow(tc.walker_property_int_buffer, r);
-          wmed_property_real_buffer.addRow(tc.walker_property_real_buffer, r);
-          wmed_particle_real_buffer.addRow(tc.walker_particle_real_buffer, r);
-        }
-        // reset pointers
-        n1        = n;
-        prev_step = step;
+        auto med = first + (last - first - 1) / 2;
+        std::nth_element(first, med, last);
+        addRows(*med, wmed_property_int_buffer, wmed_property_real_buffer, wmed_particle_real_buffer);
       }
-      n++;
     }
     energy_order.resize(0);
+    step_offsets.resize(0);
   }
 
   // write buffer data to file
-  writeBuffersHDF();
+  if (format == "columnar")
+    writeBuffersColumnar();
+  else
+    writeBuffersHDF();
 }
 
 
@@ -240,7 +248,9 @@ void WalkerLogManager::openFile(const RefVector<WalkerLogCollector>& collectors)
 {
   if (state.verbose)
     app_log() << "WalkerLogManager::openFile " << std::endl;
-  openHDFFile(collectors);
+  // columnar files are created as the first data of each buffer arrives
+  if (format != "columnar")
+    openHDFFile(collectors);
 }
 
 
@@ -248,7 +258,10 @@ void WalkerLogManager::closeFile()
 {
   if (state.verbose)
     app_log() << "WalkerLogManager::closeFile " << std::endl;
-  closeHDFFile();
+  if (format == "columnar")
+    closeColumnFiles();
+  else
+    closeHDFFile();
 }
 
 
@@ -259,6 +272,20 @@ void WalkerLogManager::openHDFFile(const RefVector<WalkerLogCollector>& collecto
   if (collectors.size() == 0)
     throw std::runtime_error("WalkerLogManager::openHDFFile  no log collectors exist, cannot open file");
   // each rank opens a wlogs.h5 file
+  std::string file_name = getRankFileRoot() + ".wlogs.h5";
+  if (state.verbose)
+    app_log() << "WalkerLogManager::openHDFFile  opening logs hdf file " << file_name << std::endl;
+  // create the hdf archive
+  hdf_file = std::make_unique<hdf_archive>();
+  // open the file
+  bool successful = hdf_file->create(file_name);
+  if (!successful)
+    throw std::runtime_error("WalkerLogManager::openHDFFile  failed to open hdf file " + file_name);
+}
+
+
+std::string WalkerLogManager::getRankFileRoot() const
+{
   int nprocs = communicator->size();
   int rank   = communicator->rank();
   std::array<char, 32> ptoken;
@@ -276,15 +303,7 @@ void WalkerLogManager::openHDFFile(const RefVector<WalkerLogCollector>& collecto
       throw std::runtime_error("Error generating filename");
     file_name.append(ptoken.data(), length);
   }
-  file_name += ".wlogs.h5";
-  if (state.verbose)
-    app_log() << "WalkerLogManager::openHDFFile  opening logs hdf file " << file_name << std::endl;
-  // create the hdf archive
-  hdf_file = std::make_unique<hdf_archive>();
-  // open the file
-  bool successful = hdf_file->create(file_name);
-  if (!successful)
-    throw std::runtime_error("WalkerLogManager::openHDFFile  failed to open hdf file " + file_name);
+  return file_name;
 }
 
 
@@ -326,29 +345,99 @@ void WalkerLogManager::writeBuffersHDF()
   for (int ip = 0; ip < collectors.size(); ++ip)
   {
     WalkerLogCollector& tc = collectors[ip];
-    tc.walker_property_int_buffer.writeHDF(*hdf_file, tc_lead.walker_property_int_buffer.hdf_file_pointer);
-    tc.walker_property_real_buffer.writeHDF(*hdf_file, tc_lead.walker_property_real_buffer.hdf_file_pointer);
+    tc.walker_property_int_buffer.writeHDF(*hdf_file, tc_lead.walker_property_int_buffer.hdf_file_pointer,
+                                             compression_level);
+    tc.walker_property_real_buffer.writeHDF(*hdf_file, tc_lead.walker_property_real_buffer.hdf_file_pointer,
+                                              compression_level);
     if (write_particle_data)
-      tc.walker_particle_real_buffer.writeHDF(*hdf_file, tc_lead.walker_particle_real_buffer.hdf_file_pointer);
+      tc.walker_particle_real_buffer.writeHDF(*hdf_file, tc_lead.walker_particle_real_buffer.hdf_file_pointer,
+                                              compression_level);
   }
   if (write_min_data)
   { // write data for min energy walker buffers to HDF
-    wmin_property_int_buffer.writeHDF(*hdf_file);
-    wmin_property_real_buffer.writeHDF(*hdf_file);
-    wmin_particle_real_buffer.writeHDF(*hdf_file);
+    wmin_property_int_buffer.writeHDF(*hdf_file, compression_level);
+    wmin_property_real_buffer.writeHDF(*hdf_file, compression_level);
+    wmin_particle_real_buffer.writeHDF(*hdf_file, compression_level);
   }
   if (write_max_data)
   { // write data for max energy walker buffers to HDF
-    wmax_property_int_buffer.writeHDF(*hdf_file);
-    wmax_property_real_buffer.writeHDF(*hdf_file);
-    wmax_particle_real_buffer.writeHDF(*hdf_file);
+    wmax_property_int_buffer.writeHDF(*hdf_file, compression_level);
+    wmax_property_real_buffer.writeHDF(*hdf_file, compression_level);
+    wmax_particle_real_buffer.writeHDF(*hdf_file, compression_level);
   }
   if (write_med_data)
   { // write data for median energy walker buffers to HDF
-    wmed_property_int_buffer.writeHDF(*hdf_file);
-    wmed_property_real_buffer.writeHDF(*hdf_file);
-    wmed_particle_real_buffer.writeHDF(*hdf_file);
+    wmed_property_int_buffer.writeHDF(*hdf_file, compression_level);
+    wmed_property_real_buffer.writeHDF(*hdf_file, compression_level);
+    wmed_particle_real_buffer.writeHDF(*hdf_file, compression_level);
   }
+  // one flush per block, the data of a block is complete in the file or not at all
+  hdf_file->flush();
+}
+
+
+template<typename T>
+void WalkerLogManager::writeColumns(const WalkerLogBuffer<T>& buffer)
+{
+  if (buffer.nrows() == 0)
+    return;
+  auto& output = column_outputs[buffer.label];
+  if (!output.writer)
+  {
+    const std::string file_name = getRankFileRoot() + ".wlogs." + buffer.label + ".col";
+    if (state.verbose)
+      app_log() << "WalkerLogManager::writeColumns  opening logs column file " << file_name << std::endl;
+    output.chunk  = ColumnChunk(buffer.makeColumnLayout());
+    output.writer = std::make_unique<ColumnStreamWriter>(file_name, output.chunk.getLayout(), compression_level,
+                                                         std::size_t(256) << 20, rate_limiter);
+  }
+  buffer.appendColumns(output.chunk);
+  // hands the rows over and leaves an empty chunk to fill next time
+  output.writer->push(output.chunk);
+}
+
+
+void WalkerLogManager::writeBuffersColumnar()
+{
+  const RefVector<WalkerLogCollector>& collectors = collectors_in_run_;
+  if (state.verbose)
+    app_log() << "WalkerLogManager::writeBuffersColumnar " << std::endl;
+  for (WalkerLogCollector& tc : collectors)
+  {
+    writeColumns(tc.walker_property_int_buffer);
+    writeColumns(tc.walker_property_real_buffer);
+    if (write_particle_data)
+      writeColumns(tc.walker_particle_real_buffer);
+  }
+  if (write_min_data)
+  {
+    writeColumns(wmin_property_int_buffer);
+    writeColumns(wmin_property_real_buffer);
+    writeColumns(wmin_particle_real_buffer);
+  }
+  if (write_max_data)
+  {
+    writeColumns(wmax_property_int_buffer);
+    writeColumns(wmax_property_real_buffer);
+    writeColumns(wmax_particle_real_buffer);
+  }
+  if (write_med_data)
+  {
+    writeColumns(wmed_property_int_buffer);
+    writeColumns(wmed_property_real_buffer);
+    writeColumns(wmed_particle_real_buffer);
+  }
+}
+
+
+void WalkerLogManager::closeColumnFiles()
+{
+  if (state.verbose)
+    app_log() << "WalkerLogManager::closeColumnFiles " << std::endl;
+  // surface a failure of the writers before their destructors can only log it
+  for (auto& [label, output] : column_outputs)
+    output.writer->flush();
+  column_outputs.clear();
 }
 
 
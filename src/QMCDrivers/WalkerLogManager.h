@@ -13,6 +13,7 @@
 #ifndef QMCPLUSPLUS_WALKERLOGMANAGER_H
 #define QMCPLUSPLUS_WALKERLOGMANAGER_H
 
+#include <unordered_map>
 #include "WalkerLogCollector.h"
 #include "type_traits/template_types.hpp"
 
@@ -29,6 +30,11 @@ struct WalkerLogInput;
  *    Walker buffer data from all crowd-level WalkerLogCollectors are written
  *    to the HDF file at the end of each MC block.
  *
+ *    With format="columnar" each buffer is instead written to its own
+ *    ColumnStreamWriter file. The block end then only copies the buffers,
+ *    compression and file I/O happen on background threads,
+ *    optionally limited to a bandwidth per rank.
+ *
  *    Just prior to the write, this class examines the distribution of walker
  *    energies on its rank for each MC step in the MC block, identifies the 
  *    minimum/maximum/median energy walkers and buffers their full data 
@@ -63,8 +69,17 @@ private:
   /// whether to write full data for the median energy walker at each step
   bool write_med_data;
 
-  /// used to sort energy information for identifying walkers by energy quantile
+  /// output format, "hdf5" or "columnar"
+  std::string format;
+  /// deflate level of the HDF datasets or zlib level of the columnar files, 0 for uncompressed
+  int compression_level;
+
+  /// (step, energy, collector, row) of each walker, used to identify walkers by energy quantile
   std::vector<std::tuple<size_t, WLog::Real, size_t, size_t>> energy_order;
+  /// energy_order grouped by step
+  std::vector<std::tuple<size_t, WLog::Real, size_t, size_t>> step_order;
+  /// start of the data of each step of the block in step_order
+  std::vector<size_t> step_offsets;
 
   /// buffer containing integer properties for the minimum energy walkers
   WalkerLogBuffer<WLog::Int> wmin_property_int_buffer;
@@ -89,6 +104,17 @@ private:
 
   RefVector<WalkerLogCollector> collectors_in_run_;
 
+  /// background writer of one buffer label and the chunk handed to it (columnar format)
+  struct ColumnOutput
+  {
+    std::unique_ptr<ColumnStreamWriter> writer;
+    ColumnChunk chunk;
+  };
+  /// columnar outputs by buffer label
+  std::unordered_map<std::string, ColumnOutput> column_outputs;
+  /// shared by the columnar outputs to bound the bandwidth of the rank, null when unlimited
+  std::shared_ptr<ColumnRateLimiter> rate_limiter;
+
 public:
   WalkerLogManager(WalkerLogInput& inp, bool allow_logs, std::string series_root, Communicate* comm = 0);
 
@@ -122,6 +148,19 @@ private:
 
   /// close the logs file (HDF format)
   void closeHDFFile();
+
+  /// file name root including the rank for runs with more than one rank
+  std::string getRankFileRoot() const;
+
+  /// hand data buffers to the background writers (columnar format)
+  void writeBuffersColumnar();
+
+  /// hand one data buffer to the background writer of its label, creating it on first use
+  template<typename T>
+  void writeColumns(const WalkerLogBuffer<T>& buffer);
+
+  /// wait for the background writers and close their files (columnar format)
+  void closeColumnFiles();
 };
 
 
@@ -0,0 +1,118 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "QMCDrivers/CrowdStepWorkspace.hpp"
+#include "Utilities/RuntimeOptions.h"
+
+namespace qmcplusplus
+{
+namespace
+{
+/// data pointers of the per walker and per particle buffers, they change only if a buffer is reallocated
+template<CoordsType CT>
+std::vector<const void*> bufferAddresses(const CrowdStepWorkspace<CT>& ws)
+{
+  std::vector<const void*> addresses{ws.drifts.positions.data(),
+                                     ws.drifts_reverse.positions.data(),
+                                     ws.deltas.positions.data(),
+                                     ws.walker_deltas.positions.data(),
+                                     ws.grads_now.grads_positions.data(),
+                                     ws.grads_new.grads_positions.data(),
+                                     ws.ratios.data(),
+                                     ws.log_gf.data(),
+                                     ws.log_gb.data(),
+                                     ws.prob.data(),
+                                     ws.rr.data(),
+                                     ws.rr_proposed.data(),
+                                     ws.rr_accepted.data(),
+                                     ws.old_energies.data(),
+                                     ws.local_energies.data(),
+                                     ws.rejects.data(),
+                                     ws.nonlocal_moves_accepted.data()};
+  if constexpr (CT == CoordsType::POS_SPIN)
+  {
+    addresses.push_back(ws.walker_deltas.spins.data());
+    addresses.push_back(ws.grads_now.grads_spins.data());
+  }
+  return addresses;
+}
+} // namespace
+
+template<CoordsType CT>
+void testWorkspaceSteadyState()
+{
+  constexpr int num_particles = 8;
+  CrowdStepWorkspace<CT> ws;
+
+  // the first step sizes the workspace for the largest crowd
+  ws.resize(6, num_particles);
+  CHECK(ws.capacity() >= 6);
+  CHECK(ws.walker_deltas.positions.size() == 6 * num_particles);
+  const auto addresses = bufferAddresses(ws);
+
+  // steady state with the DMC population fluctuating below the maximum
+  for (int num_walkers : {4, 5, 6, 3, 6})
+  {
+    ws.resize(num_walkers, num_particles);
+    CHECK(ws.ratios.size() == num_walkers);
+    CHECK(ws.local_energies.size() == num_walkers);
+    CHECK(ws.walker_deltas.positions.size() == num_walkers * num_particles);
+    CHECK(bufferAddresses(ws) == addresses);
+  }
+  if constexpr (CT == CoordsType::POS_SPIN)
+    CHECK(ws.walker_deltas.spins.size() == 6 * num_particles);
+
+  // growing beyond the previous maximum reallocates
+  ws.resize(7, num_particles);
+  CHECK(ws.capacity() >= 7);
+  CHECK(bufferAddresses(ws) != addresses);
+}
+
+TEST_CASE("CrowdStepWorkspace steady state", "[drivers]")
+{
+  testWorkspaceSteadyState<CoordsType::POS>();
+  testWorkspaceSteadyState<CoordsType::POS_SPIN>();
+}
+
+TEST_CASE("CrowdStepWorkspace T-move lists", "[drivers]")
+{
+  const SimulationCell simulation_cell;
+  ParticleSet elec_a(simulation_cell), elec_b(simulation_cell);
+  RuntimeOptions runtime_options;
+  TrialWaveFunction twf_a(runtime_options), twf_b(runtime_options);
+  CrowdStepWorkspace<CoordsType::POS> ws;
+
+  ws.resetNonLocalMoved(elec_a, twf_a, 4);
+  REQUIRE(ws.moved_nonlocal_elecs);
+  REQUIRE(ws.moved_nonlocal_twfs);
+  ws.moved_nonlocal_elecs->push_back(elec_b);
+  ws.moved_nonlocal_twfs->push_back(twf_b);
+  const auto* elecs_data = ws.moved_nonlocal_elecs->data();
+
+  // same leader, the lists are emptied and keep their storage
+  ws.resetNonLocalMoved(elec_a, twf_a, 4);
+  CHECK(ws.moved_nonlocal_elecs->empty());
+  CHECK(ws.moved_nonlocal_twfs->empty());
+  CHECK(ws.moved_nonlocal_walkers.empty());
+  CHECK(ws.moved_nonlocal_elecs->data() == elecs_data);
+  CHECK(&ws.moved_nonlocal_elecs->getLeader() == &elec_a);
+
+  // the crowd got a new leader after load balancing
+  ws.resetNonLocalMoved(elec_b, twf_b, 4);
+  CHECK(ws.moved_nonlocal_elecs->empty());
+  CHECK(&ws.moved_nonlocal_elecs->getLeader() == &elec_b);
+  CHECK(&ws.moved_nonlocal_twfs->getLeader() == &twf_b);
+  CHECK(ws.moved_nonlocal_elecs->capacity() >= 4);
+}
+
+} // namespace qmcplusplus
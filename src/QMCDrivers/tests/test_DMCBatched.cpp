@@ -11,6 +11,9 @@
 
 #include <catch.hpp>
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
 #include "Message/Communicate.h"
 #include "QMCDrivers/DMC/DMCDriverInput.h"
 #include "QMCDrivers/DMC/DMCBatched.h"
@@ -22,6 +25,25 @@
 #include "Platforms/Host/OutputManager.h"
 #include "SetupPools.h"
 
+namespace
+{
+/// count of global operator new calls while counting is on
+std::atomic<long> allocation_count{0};
+std::atomic<bool> count_allocations{false};
+} // namespace
+
+void* operator new(std::size_t size)
+{
+  if (count_allocations)
+    ++allocation_count;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
 namespace qmcplusplus
 {
 namespace testing
@@ -39,6 +61,34 @@ public:
 
   SetupDMCTest& get_dtest() { return *up_dtest_; }
 
+  /** number of heap allocations of a DMC step of the first crowd after num_warmup_steps steps
+   *  the walkers are initialized as in DMCBatched::run, dmcdriver.process must have been called.
+   */
+  static long countStepAllocations(DMCBatched& dmcdriver, const int num_warmup_steps)
+  {
+    auto step_contexts_refs = dmcdriver.getContextForStepsRefs();
+    for (int crowd_id = 0; crowd_id < dmcdriver.crowds_.size(); ++crowd_id)
+      QMCDriverNew::initialLogEvaluation(crowd_id, dmcdriver.crowds_, step_contexts_refs,
+                                         dmcdriver.serializing_crowd_walkers_);
+    DMCBatched::StateForThread dmc_state(dmcdriver.qmcdriver_input_, *dmcdriver.drift_modifier_,
+                                         *dmcdriver.branch_engine_, dmcdriver.population_, dmcdriver.steps_per_block_,
+                                         dmcdriver.serializing_crowd_walkers_);
+    Crowd& crowd = *dmcdriver.crowds_[0];
+    auto step    = [&](int step) {
+      dmc_state.step = dmc_state.global_step = step;
+      DMCBatched::advanceWalkers<CoordsType::POS>(dmc_state, crowd, dmcdriver.timers_, dmcdriver.dmc_timers_,
+                                                  *dmcdriver.step_contexts_[0], false, false);
+    };
+    for (int i = 0; i < num_warmup_steps; ++i)
+      step(i);
+
+    allocation_count  = 0;
+    count_allocations = true;
+    step(num_warmup_steps);
+    count_allocations = false;
+    return allocation_count;
+  }
+
 private:
   UPtr<SetupDMCTest> up_dtest_;
 };
@@ -95,6 +145,49 @@ TEST_CASE("DMCDriver+QMCDriverNew integration", "[drivers]")
   CHECK(reserved_walkers == 10);
   // What else should we expect after process
 }
+
+TEST_CASE("DMCBatched::advanceWalkers no allocation in steady state", "[drivers]")
+{
+  using namespace testing;
+  Concurrency::OverrideMaxCapacity<> override(8);
+  ProjectData test_project;
+  Communicate* comm = OHMMS::Controller;
+  outputManager.pause();
+
+  auto particle_pool = MinimalParticlePool::make_diamondC_1x1x1(comm);
+  auto wavefunction_pool =
+      MinimalWaveFunctionPool::make_diamondC_1x1x1(test_project.getRuntimeOptions(), comm, particle_pool);
+  auto hamiltonian_pool = MinimalHamiltonianPool::make_hamWithEE(comm, particle_pool, wavefunction_pool);
+
+  for (const char* move : {"pbyp", "alle"})
+  {
+    INFO("move " << move);
+    Libxml2Document doc;
+    REQUIRE(doc.parseFromString(valid_dmc_input_sections[valid_dmc_input_dmc_batch_index]));
+    xmlNodePtr node = doc.getRoot();
+    xmlSetProp(node, castCharToXMLChar("move"), castCharToXMLChar(move));
+    // the batched APIs of the wavefunction and Hamiltonian components still allocate their walker lists,
+    // serializing the walkers leaves the allocations of the driver alone in the count.
+    xmlNodePtr serialize = xmlNewTextChild(node, nullptr, castCharToXMLChar("parameter"), castCharToXMLChar("yes"));
+    xmlNewProp(serialize, castCharToXMLChar("name"), castCharToXMLChar("crowd_serialize_walkers"));
+    QMCDriverInput qmcdriver_input;
+    qmcdriver_input.readXML(node);
+    DMCDriverInput dmcdriver_input;
+    dmcdriver_input.readXML(node);
+    RandomNumberGeneratorPool rng_pool(8);
+    SampleStack samples;
+    WalkerConfigurations walker_confs;
+    DMCBatched dmcdriver(test_project, std::move(qmcdriver_input), nullptr, std::move(dmcdriver_input), walker_confs,
+                         MCPopulation(comm->size(), comm->rank(), particle_pool.getParticleSet("e"),
+                                      wavefunction_pool.getPrimary(), hamiltonian_pool.getPrimary()),
+                         rng_pool.getRngRefs(), comm);
+    dmcdriver.setStatus("Test", "", false);
+    dmcdriver.process(node);
+
+    CHECK(DMCBatchedTest::countStepAllocations(dmcdriver, 3) == 0);
+  }
+  outputManager.resume();
+}
 #endif
 
 } // namespace qmcplusplus
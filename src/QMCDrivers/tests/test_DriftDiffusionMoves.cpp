@@ -0,0 +1,414 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "QMCDrivers/DriftDiffusionMoves.hpp"
+#include "QMCDrivers/GreenFunctionModifiers/DriftModifierUNR.h"
+#include "QMCDrivers/QMCDriverNew.h"
+#include "EstimatorInputDelegates.h"
+#include "Particle/PSdispatcher.h"
+#include "ParticleBase/RandomSeqGenerator.h"
+#include "QMCWaveFunctions/TWFdispatcher.h"
+#include "QMCWaveFunctions/WaveFunctionComponent.h"
+#include "Utilities/RuntimeOptions.h"
+#include "Utilities/StdRandom.h"
+
+namespace qmcplusplus
+{
+namespace
+{
+template<CoordsType CT>
+void fillWorkspace(CrowdStepWorkspace<CT>& ws, StdRandom<double>& rng)
+{
+  using RealType = QMCTraits::RealType;
+  makeGaussRandomWithEngine(ws.deltas, rng);
+  for (auto& grad : ws.grads_now.grads_positions)
+    for (int idim = 0; idim < OHMMS_DIM; ++idim)
+      grad[idim] = rng() - 0.5;
+  for (auto& grad : ws.grads_new.grads_positions)
+    for (int idim = 0; idim < OHMMS_DIM; ++idim)
+      grad[idim] = 2.0 * (rng() - 0.5);
+  if constexpr (CT == CoordsType::POS_SPIN)
+  {
+    for (auto& grad : ws.grads_now.grads_spins)
+      grad = rng() - 0.5;
+    for (auto& grad : ws.grads_new.grads_spins)
+      grad = rng() - 0.5;
+  }
+  for (auto& ratio : ws.ratios)
+    ratio = RealType(1.5) * rng();
+  // a node crossing for DMC
+  ws.ratios[1] = -ws.ratios[1];
+}
+
+template<CoordsType CT, MetropolisRule RULE>
+void testFusedAgainstReference()
+{
+  using RealType              = QMCTraits::RealType;
+  constexpr int num_walkers   = 7;
+  constexpr int num_particles = 1;
+  DriftModifierUNR drift_unr;
+  const DriftModifierBase& drift_modifier = drift_unr;
+  TauParams<RealType, CT> taus(0.3, 1.0 / 1.2, 0.5);
+
+  CrowdStepWorkspace<CT> ws;
+  ws.resize(num_walkers, num_particles);
+  std::fill(ws.rr_proposed.begin(), ws.rr_proposed.end(), 0.0);
+  std::fill(ws.rr_accepted.begin(), ws.rr_accepted.end(), 0.0);
+  StdRandom<double> rng_fill(11);
+  fillWorkspace(ws, rng_fill);
+
+  // the unfused sequence previously in the drivers
+  MCCoords<CT> deltas(ws.deltas), drifts(num_walkers), drifts_reverse(num_walkers);
+  std::vector<RealType> rr(num_walkers), log_gf(num_walkers), log_gb(num_walkers);
+  std::transform(deltas.positions.begin(), deltas.positions.end(), rr.begin(),
+                 [t = taus.tauovermass](auto& delta_r) { return t * dot(delta_r, delta_r); });
+  drift_modifier.getDrifts(taus, ws.grads_now, drifts);
+  QMCDriverNew::scaleBySqrtTau(taus, deltas);
+  drifts += deltas;
+  QMCDriverNew::computeLogGreensFunction(deltas, taus, log_gf);
+  drift_modifier.getDrifts(taus, ws.grads_new, drifts_reverse);
+  drifts_reverse += drifts;
+  QMCDriverNew::computeLogGreensFunction(drifts_reverse, taus, log_gb);
+
+  proposeDriftDiffusionMoves(drift_modifier, taus, true, ws);
+  StdRandom<double> rng(7), rng_ref(7);
+  auto phase_changed     = [](RealType phase) { return std::cos(phase) < std::numeric_limits<RealType>::epsilon(); };
+  const int num_accepted = acceptDriftDiffusionMoves<RULE>(drift_modifier, taus, true, rng, phase_changed, ws);
+
+  int num_accepted_ref = 0;
+  for (int iw = 0; iw < num_walkers; ++iw)
+  {
+    CHECK(ws.rr[iw] == Approx(rr[iw]));
+    CHECK(ws.log_gf[iw] == Approx(log_gf[iw]));
+    CHECK(ws.log_gb[iw] == Approx(log_gb[iw]));
+    for (int idim = 0; idim < OHMMS_DIM; ++idim)
+    {
+      CHECK(ws.drifts.positions[iw][idim] == Approx(drifts.positions[iw][idim]));
+      CHECK(ws.drifts_reverse.positions[iw][idim] == Approx(drifts_reverse.positions[iw][idim]));
+    }
+    if constexpr (CT == CoordsType::POS_SPIN)
+      CHECK(ws.drifts.spins[iw] == Approx(drifts.spins[iw]));
+
+    const RealType ratio2 = std::norm(ws.ratios[iw]);
+    const RealType prob   = ratio2 * std::exp(log_gb[iw] - log_gf[iw]);
+    CHECK(ws.prob[iw] == Approx(prob));
+    bool accepted;
+    if constexpr (RULE == MetropolisRule::DMC)
+    {
+      const bool reject = phase_changed(std::arg(ws.ratios[iw]));
+      CHECK(ws.rejects[iw] == reject);
+      accepted = !reject && prob >= std::numeric_limits<RealType>::epsilon() && rng_ref() < prob;
+      CHECK(ws.rr_proposed[iw] == Approx(rr[iw]));
+      CHECK(ws.rr_accepted[iw] == Approx(accepted ? rr[iw] : 0.0));
+    }
+    else
+      accepted = ratio2 >= std::numeric_limits<RealType>::epsilon() && rng_ref() < prob;
+    CHECK(ws.is_accepted[iw] == accepted);
+    num_accepted_ref += accepted;
+  }
+  CHECK(num_accepted == num_accepted_ref);
+  // the random number streams must stay in sync
+  CHECK(rng() == rng_ref());
+}
+
+/// psi = exp(-alpha sum_i r_i^2), |psi|^2 is a product of Gaussians with <r_i^2> = 3/(4 alpha)
+class GaussianOrbital : public WaveFunctionComponent
+{
+public:
+  GaussianOrbital(RealType alpha) : alpha_(alpha) {}
+
+  std::string getClassName() const override { return "GaussianOrbital"; }
+
+  LogValue evaluateLog(const ParticleSet& P,
+                       ParticleSet::ParticleGradient& G,
+                       ParticleSet::ParticleLaplacian& L) override
+  {
+    RealType logpsi = 0;
+    for (int iat = 0; iat < P.getTotalNum(); ++iat)
+    {
+      logpsi -= alpha_ * dot(P.R[iat], P.R[iat]);
+      G[iat] -= 2 * alpha_ * P.R[iat];
+      L[iat] -= 2 * alpha_ * OHMMS_DIM;
+    }
+    return log_value_ = logpsi;
+  }
+
+  void acceptMove(ParticleSet& P, int iat, bool safe_to_delay = false) override {}
+  void restore(int iat) override {}
+  PsiValue ratio(ParticleSet& P, int iat) override { throw std::runtime_error("GaussianOrbital::ratio not used"); }
+  void registerData(ParticleSet& P, WFBufferType& buf) override {}
+  LogValue updateBuffer(ParticleSet& P, WFBufferType& buf, bool fromscratch = false) override { return log_value_; }
+  void copyFromBuffer(ParticleSet& P, WFBufferType& buf) override {}
+
+  std::unique_ptr<WaveFunctionComponent> makeClone(ParticleSet& tpq) const override
+  {
+    return std::make_unique<GaussianOrbital>(alpha_);
+  }
+
+  void evaluateDerivatives(ParticleSet& P,
+                           const opt_variables_type& optvars,
+                           Vector<ValueType>& dlogpsi,
+                           Vector<ValueType>& dhpsioverpsi) override
+  {}
+
+private:
+  const RealType alpha_;
+};
+
+/// a crowd of walkers with two electron groups of different masses in a Gaussian wavefunction
+struct GaussianCrowd
+{
+  using RealType = QMCTraits::RealType;
+  static constexpr RealType alpha = 0.5;
+
+  GaussianCrowd(int num_walkers) : elec_template(simulation_cell)
+  {
+    elec_template.setName("e");
+    elec_template.create({2, 1});
+    SpeciesSet& species        = elec_template.getSpeciesSet();
+    const int mass_index       = species.addAttribute("mass");
+    species(mass_index, species.addSpecies("u")) = 1.0;
+    species(mass_index, species.addSpecies("d")) = 2.0;
+    grp_inv_mass = {1.0, 0.5};
+
+    StdRandom<double> rng_init(23);
+    for (int iw = 0; iw < num_walkers; ++iw)
+    {
+      auto& elecs = elecs_owner.emplace_back(std::make_unique<ParticleSet>(elec_template));
+      for (int iat = 0; iat < elecs->getTotalNum(); ++iat)
+        for (int idim = 0; idim < OHMMS_DIM; ++idim)
+          elecs->R[iat][idim] = rng_init() - 0.5;
+      elecs->update();
+      auto& twf = twfs_owner.emplace_back(std::make_unique<TrialWaveFunction>(runtime_options));
+      twf->addComponent(std::make_unique<GaussianOrbital>(alpha));
+      twf->evaluateLog(*elecs);
+    }
+  }
+
+  RefVectorWithLeader<ParticleSet> getElecs()
+  {
+    RefVectorWithLeader<ParticleSet> elecs(*elecs_owner[0]);
+    for (auto& elec : elecs_owner)
+      elecs.push_back(*elec);
+    return elecs;
+  }
+
+  RefVectorWithLeader<TrialWaveFunction> getTWFs()
+  {
+    RefVectorWithLeader<TrialWaveFunction> twfs(*twfs_owner[0]);
+    for (auto& twf : twfs_owner)
+      twfs.push_back(*twf);
+    return twfs;
+  }
+
+  const SimulationCell simulation_cell;
+  const RuntimeOptions runtime_options;
+  ParticleSet elec_template;
+  std::vector<RealType> grp_inv_mass;
+  std::vector<std::unique_ptr<ParticleSet>> elecs_owner;
+  std::vector<std::unique_ptr<TrialWaveFunction>> twfs_owner;
+};
+
+void testAllElectronMetropolis(bool use_batch)
+{
+  using RealType              = QMCTraits::RealType;
+  using PosType               = QMCTraits::PosType;
+  constexpr int num_walkers   = 5;
+  constexpr int num_particles = 3;
+  constexpr RealType tau      = 0.4;
+  const RealType alpha        = GaussianCrowd::alpha;
+  GaussianCrowd crowd(num_walkers);
+  auto walker_elecs = crowd.getElecs();
+  auto walker_twfs  = crowd.getTWFs();
+  const PSdispatcher ps_dispatcher(use_batch);
+  const TWFdispatcher twf_dispatcher(use_batch);
+  DriftModifierUNR drift_modifier;
+  CrowdStepWorkspace<CoordsType::POS> ws;
+  ws.resize(num_walkers, num_particles);
+
+  std::vector<PosType> old_positions;
+  for (ParticleSet& elecs : walker_elecs)
+    old_positions.insert(old_positions.end(), elecs.R.begin(), elecs.R.end());
+
+  StdRandom<double> rng(41);
+  StdRandom<double> rng_ref(rng);
+  const int num_accepted =
+      advanceAllElectronMoves<MetropolisRule::VMC>(ps_dispatcher, twf_dispatcher, walker_elecs, walker_twfs,
+                                                   drift_modifier, tau, crowd.grp_inv_mass, true, 1, rng,
+                                                   [](RealType) { return false; }, ws);
+
+  // Metropolis-Hastings with the drift-diffusion Green's function written out for the Gaussian wavefunction
+  MCCoords<CoordsType::POS> deltas(num_walkers * num_particles);
+  makeGaussRandomWithEngine(deltas, rng_ref);
+  auto drift = [&](const PosType& r, RealType tauovermass) {
+    PosType drift_r;
+    drift_modifier.getDrift(tauovermass, PosType(-2 * alpha * r), drift_r);
+    return drift_r;
+  };
+  int num_accepted_ref = 0;
+  for (int iw = 0; iw < num_walkers; ++iw)
+  {
+    RealType log_ratio = 0, log_gf = 0, log_gb = 0;
+    std::vector<PosType> proposed(num_particles);
+    for (int iat = 0; iat < num_particles; ++iat)
+    {
+      const RealType tauovermass = tau * crowd.grp_inv_mass[iat < 2 ? 0 : 1];
+      const PosType& r_old       = old_positions[iw * num_particles + iat];
+      const PosType delta        = std::sqrt(tauovermass) * deltas.positions[iw * num_particles + iat];
+      proposed[iat]              = r_old + drift(r_old, tauovermass) + delta;
+      const PosType reverse      = r_old - proposed[iat] - drift(proposed[iat], tauovermass);
+      log_ratio -= alpha * (dot(proposed[iat], proposed[iat]) - dot(r_old, r_old));
+      log_gf -= dot(delta, delta) / (2 * tauovermass);
+      log_gb -= dot(reverse, reverse) / (2 * tauovermass);
+    }
+    const RealType prob = std::exp(2 * log_ratio + log_gb - log_gf);
+    CHECK(ws.prob[iw] == Approx(prob));
+    const bool accepted = rng_ref() < prob;
+    CHECK(ws.is_accepted[iw] == accepted);
+    num_accepted_ref += accepted;
+
+    // the walker ends up at the accepted configuration with a consistent wavefunction
+    const ParticleSet& elecs = walker_elecs[iw];
+    RealType logpsi          = 0;
+    for (int iat = 0; iat < num_particles; ++iat)
+    {
+      const PosType& expected = accepted ? proposed[iat] : old_positions[iw * num_particles + iat];
+      for (int idim = 0; idim < OHMMS_DIM; ++idim)
+      {
+        CHECK(elecs.R[iat][idim] == Approx(expected[idim]));
+        CHECK(elecs.G[iat][idim] == ValueApprox(-2 * alpha * expected[idim]));
+      }
+      logpsi -= alpha * dot(expected, expected);
+    }
+    CHECK(walker_twfs[iw].getLogPsi() == Approx(logpsi));
+  }
+  CHECK(num_accepted == num_accepted_ref);
+  CHECK(rng() == rng_ref());
+}
+} // namespace
+
+TEST_CASE("DriftDiffusionMoves fused kernels", "[drivers]")
+{
+  testFusedAgainstReference<CoordsType::POS, MetropolisRule::VMC>();
+  testFusedAgainstReference<CoordsType::POS, MetropolisRule::DMC>();
+  testFusedAgainstReference<CoordsType::POS_SPIN, MetropolisRule::VMC>();
+  testFusedAgainstReference<CoordsType::POS_SPIN, MetropolisRule::DMC>();
+}
+
+TEST_CASE("DriftDiffusionMoves no drift", "[drivers]")
+{
+  using RealType = QMCTraits::RealType;
+  DriftModifierUNR drift_modifier;
+  TauParams<RealType, CoordsType::POS> taus(0.3, 1.0, 1.0);
+  CrowdStepWorkspace<CoordsType::POS> ws;
+  ws.resize(3, 1);
+  StdRandom<double> rng(3);
+  fillWorkspace(ws, rng);
+  const auto deltas = ws.deltas.positions;
+
+  proposeDriftDiffusionMoves(drift_modifier, taus, false, ws);
+  acceptDriftDiffusionMoves<MetropolisRule::VMC>(drift_modifier, taus, false, rng, [](RealType) { return false; },
+                                                 ws);
+  for (int iw = 0; iw < 3; ++iw)
+  {
+    CHECK(ws.drifts.positions[iw][0] == Approx(deltas[iw][0] * taus.sqrttau));
+    CHECK(ws.log_gf[iw] == 0.0);
+    CHECK(ws.log_gb[iw] == 0.0);
+    CHECK(ws.prob[iw] == Approx(std::norm(ws.ratios[iw])));
+  }
+}
+
+TEST_CASE("DriftDiffusionMoves all-electron acceptance", "[drivers]")
+{
+  testAllElectronMetropolis(false);
+  testAllElectronMetropolis(true);
+}
+
+TEST_CASE("DriftDiffusionMoves all-electron node crossing", "[drivers]")
+{
+  using RealType            = QMCTraits::RealType;
+  constexpr int num_walkers = 3;
+  GaussianCrowd crowd(num_walkers);
+  auto walker_elecs = crowd.getElecs();
+  auto walker_twfs  = crowd.getTWFs();
+  const PSdispatcher ps_dispatcher(true);
+  const TWFdispatcher twf_dispatcher(true);
+  DriftModifierUNR drift_modifier;
+  CrowdStepWorkspace<CoordsType::POS> ws;
+  ws.resize(num_walkers, 3);
+  std::fill(ws.rr_proposed.begin(), ws.rr_proposed.end(), 0.0);
+  std::fill(ws.rr_accepted.begin(), ws.rr_accepted.end(), 0.0);
+
+  std::vector<ParticleSet::ParticlePos> old_positions;
+  std::vector<RealType> old_log_psi;
+  for (int iw = 0; iw < num_walkers; ++iw)
+  {
+    old_positions.push_back(walker_elecs[iw].R);
+    old_log_psi.push_back(walker_twfs[iw].getLogPsi());
+  }
+
+  // every proposal crosses a node, DMC rejects all of them and restores the walkers
+  StdRandom<double> rng(5);
+  const int num_accepted =
+      advanceAllElectronMoves<MetropolisRule::DMC>(ps_dispatcher, twf_dispatcher, walker_elecs, walker_twfs,
+                                                   drift_modifier, RealType(0.2), crowd.grp_inv_mass, true, 2, rng,
+                                                   [](RealType) { return true; }, ws);
+  CHECK(num_accepted == 0);
+  for (int iw = 0; iw < num_walkers; ++iw)
+  {
+    CHECK(ws.rejects[iw] == 1);
+    CHECK(ws.rr_proposed[iw] > 0.0);
+    CHECK(ws.rr_accepted[iw] == 0.0);
+    for (int iat = 0; iat < 3; ++iat)
+      for (int idim = 0; idim < OHMMS_DIM; ++idim)
+        CHECK(walker_elecs[iw].R[iat][idim] == Approx(old_positions[iw][iat][idim]));
+    CHECK(walker_twfs[iw].getLogPsi() == Approx(old_log_psi[iw]));
+  }
+}
+
+TEST_CASE("DriftDiffusionMoves all-electron sampling", "[drivers]")
+{
+  using RealType            = QMCTraits::RealType;
+  constexpr int num_walkers = 8;
+  constexpr int num_steps   = 2000;
+  GaussianCrowd crowd(num_walkers);
+  auto walker_elecs = crowd.getElecs();
+  auto walker_twfs  = crowd.getTWFs();
+  const PSdispatcher ps_dispatcher(true);
+  const TWFdispatcher twf_dispatcher(true);
+  DriftModifierUNR drift_modifier;
+  CrowdStepWorkspace<CoordsType::POS> ws;
+  ws.resize(num_walkers, 3);
+
+  // detailed balance makes |psi|^2 stationary, <r^2> = 3/(4 alpha) for every electron whatever its mass
+  StdRandom<double> rng(17);
+  std::vector<double> r2_sum(3, 0.0);
+  int num_accepted = 0;
+  for (int step = 0; step < num_steps; ++step)
+  {
+    num_accepted += advanceAllElectronMoves<MetropolisRule::VMC>(ps_dispatcher, twf_dispatcher, walker_elecs,
+                                                                 walker_twfs, drift_modifier, RealType(0.3),
+                                                                 crowd.grp_inv_mass, true, 1, rng,
+                                                                 [](RealType) { return false; }, ws);
+    for (ParticleSet& elecs : walker_elecs)
+      for (int iat = 0; iat < 3; ++iat)
+        r2_sum[iat] += dot(elecs.R[iat], elecs.R[iat]);
+  }
+  const double acceptance = static_cast<double>(num_accepted) / (num_steps * num_walkers);
+  CHECK(acceptance > 0.5);
+  CHECK(acceptance < 1.0);
+  for (int iat = 0; iat < 3; ++iat)
+    CHECK(r2_sum[iat] / (num_steps * num_walkers) == Approx(0.75 / GaussianCrowd::alpha).epsilon(0.05));
+}
+
+} // namespace qmcplusplus
@@ -39,4 +39,22 @@ TEST_CASE("QMCDriverInput readXML", "[drivers]")
   std::for_each(testing::valid_dmc_input_sections.begin() + testing::valid_dmc_input_dmc_batch_index,
                 testing::valid_dmc_input_sections.end(), xml_test);
 }
+
+TEST_CASE("QMCDriverInput move", "[drivers]")
+{
+  auto read_move = [](const char* driver_xml) {
+    Libxml2Document doc;
+    bool okay = doc.parseFromString(driver_xml);
+    REQUIRE(okay);
+    QMCDriverInput qmcdriver_input;
+    qmcdriver_input.readXML(doc.getRoot());
+    return qmcdriver_input.isAllElectronMove();
+  };
+
+  CHECK(!read_move(R"(<qmc method="vmc"><parameter name="steps">1</parameter></qmc>)"));
+  CHECK(!read_move(R"(<qmc method="vmc" move="pbyp"><parameter name="steps">1</parameter></qmc>)"));
+  CHECK(read_move(R"(<qmc method="dmc" move="alle"><parameter name="steps">1</parameter></qmc>)"));
+  CHECK_THROWS_AS(read_move(R"(<qmc method="vmc" move="walker"><parameter name="steps">1</parameter></qmc>)"),
+                  std::runtime_error);
+}
 } // namespace qmcplusplus
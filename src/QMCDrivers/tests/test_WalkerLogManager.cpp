@@ -0,0 +1,188 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include <filesystem>
+#include "Message/Communicate.h"
+#include "OhmmsData/Libxml2Doc.h"
+#include "QMCDrivers/WalkerLogInput.h"
+#include "QMCDrivers/WalkerLogManager.h"
+
+
+namespace qmcplusplus
+{
+
+namespace
+{
+constexpr int num_collectors = 3;
+constexpr int num_walkers    = 5;
+constexpr int num_steps      = 4;
+constexpr int num_particles  = 2;
+
+/// energy of walker iw of collector c at step s, distinct to make the selected walkers unique
+WLog::Real testEnergy(int c, int iw, int s) { return std::cos(1.0 + c * 7.0 + iw * 3.0 + s * 11.0); }
+
+/// fill the collector buffers like WalkerLogCollector::collect does
+void fillCollector(WalkerLogCollector& tc, int c)
+{
+  Array<WLog::Real, 2> R(num_particles, OHMMS_DIM);
+  for (int s = 0; s < num_steps; ++s)
+    for (int iw = 0; iw < num_walkers; ++iw)
+    {
+      const WLog::Real energy = testEnergy(c, iw, s);
+      R                       = energy;
+      tc.walker_particle_real_buffer.collect("R", R);
+      tc.walker_particle_real_buffer.resetCollect();
+      tc.walker_property_int_buffer.collect("step", WLog::Int(s));
+      tc.walker_property_int_buffer.collect("id", WLog::Int(c * num_walkers + iw));
+      tc.walker_property_int_buffer.resetCollect();
+      tc.walker_property_real_buffer.collect("weight", WLog::Real(1));
+      tc.walker_property_real_buffer.collect("LocalEnergy", energy);
+      tc.walker_property_real_buffer.resetCollect();
+      tc.steps.push_back(s);
+      tc.energies.push_back(energy);
+    }
+}
+
+/// min, max and median energy over all walkers of each step
+std::array<std::vector<WLog::Real>, 3> referenceQuantiles()
+{
+  std::array<std::vector<WLog::Real>, 3> quantiles;
+  for (int s = 0; s < num_steps; ++s)
+  {
+    std::vector<WLog::Real> energies;
+    for (int c = 0; c < num_collectors; ++c)
+      for (int iw = 0; iw < num_walkers; ++iw)
+        energies.push_back(testEnergy(c, iw, s));
+    std::sort(energies.begin(), energies.end());
+    quantiles[0].push_back(energies.front());
+    quantiles[1].push_back(energies.back());
+    quantiles[2].push_back(energies[(energies.size() - 1) / 2]);
+  }
+  return quantiles;
+}
+
+void writeLogs(const std::string& xml, const std::string& file_root)
+{
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(xml));
+  WalkerLogInput input(doc.getRoot());
+
+  Communicate* comm = OHMMS::Controller;
+  WalkerLogManager wlm(input, true, file_root, comm);
+  UPtrVector<WalkerLogCollector> collectors;
+  for (int c = 0; c < num_collectors; ++c)
+    collectors.emplace_back(wlm.makeCollector());
+  wlm.startRun(convertUPtrToRefVector(collectors));
+  for (int block = 0; block < 2; ++block)
+  {
+    for (int c = 0; c < num_collectors; ++c)
+    {
+      collectors[c]->startBlock();
+      fillCollector(*collectors[c], c);
+    }
+    wlm.writeBuffers();
+  }
+  wlm.stopRun();
+}
+} // namespace
+
+
+TEST_CASE("WalkerLogManager::hdf5", "[drivers]")
+{
+  const std::string file_root("test_walker_logs_hdf5");
+  writeLogs(R"(<walkerlogs particle="yes" compression="4"/>)", file_root);
+
+  const auto quantiles = referenceQuantiles();
+  hdf_archive hin;
+  REQUIRE(hin.open(file_root + ".wlogs.h5", H5F_ACC_RDONLY));
+  const std::array<std::string, 3> labels{"wmin_property_real", "wmax_property_real", "wmed_property_real"};
+  for (int q = 0; q < 3; ++q)
+  {
+    Array<WLog::Real, 2> data;
+    hin.push(labels[q]);
+    hin.read(data, "data");
+    hin.pop();
+    // one row per step and block, LocalEnergy is the second column
+    REQUIRE(data.size(0) == 2 * num_steps);
+    REQUIRE(data.size(1) == 2);
+    for (int row = 0; row < data.size(0); ++row)
+      CHECK(data(row, 1) == Approx(quantiles[q][row % num_steps]));
+  }
+  Array<WLog::Real, 2> particles;
+  hin.push("walker_particle_real");
+  hin.read(particles, "data");
+  // the dataset is stored deflated when the library has the filter
+  hid_t dataset = H5Dopen(hin.top(), "data", H5P_DEFAULT);
+  hid_t plist   = H5Dget_create_plist(dataset);
+  CHECK(H5Pget_nfilters(plist) == (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0 ? 1 : 0));
+  H5Pclose(plist);
+  H5Dclose(dataset);
+  hin.pop();
+  CHECK(particles.size(0) == 2 * num_steps * num_walkers * num_collectors);
+  CHECK(particles.size(1) == num_particles * OHMMS_DIM);
+  hin.close();
+  std::filesystem::remove(file_root + ".wlogs.h5");
+}
+
+
+TEST_CASE("WalkerLogManager::columnar", "[drivers]")
+{
+  const std::string file_root("test_walker_logs_columnar");
+  writeLogs(R"(<walkerlogs format="columnar" particle="yes" max_mb_per_s="100"/>)", file_root);
+
+  const auto quantiles = referenceQuantiles();
+  const std::array<std::string, 3> labels{"wmin", "wmax", "wmed"};
+  for (int q = 0; q < 3; ++q)
+  {
+    ColumnStreamReader reader(file_root + ".wlogs." + labels[q] + "_property_real.col");
+    std::size_t rows = 0;
+    auto energies    = reader.readColumn<WLog::Real>("LocalEnergy", rows);
+    REQUIRE(rows == 2 * num_steps);
+    for (int row = 0; row < rows; ++row)
+      CHECK(energies[row] == Approx(quantiles[q][row % num_steps]));
+    // the per-particle data of the selected walkers is written with them
+    ColumnStreamReader particle_reader(file_root + ".wlogs." + labels[q] + "_particle_real.col");
+    auto positions = particle_reader.readColumn<WLog::Real>("R", rows);
+    REQUIRE(rows == 2 * num_steps);
+    for (int row = 0; row < rows; ++row)
+      CHECK(positions[row * num_particles * OHMMS_DIM] == Approx(quantiles[q][row % num_steps]));
+  }
+
+  // the chunks of the collectors are interleaved, every walker of every step is there once per block
+  ColumnStreamReader reader(file_root + ".wlogs.walker_property_int.col");
+  std::size_t rows = 0;
+  auto ids         = reader.readColumn<WLog::Int>("id", rows);
+  CHECK(rows == 2 * num_steps * num_walkers * num_collectors);
+  for (int id = 0; id < num_walkers * num_collectors; ++id)
+    CHECK(std::count(ids.begin(), ids.end(), id) == 2 * num_steps);
+
+  for (auto& entry : std::filesystem::directory_iterator("."))
+    if (entry.path().filename().string().rfind(file_root, 0) == 0)
+      std::filesystem::remove(entry.path());
+}
+
+
+TEST_CASE("WalkerLogInput::validity", "[drivers]")
+{
+  for (auto xml : {R"(<walkerlogs format="csv"/>)", R"(<walkerlogs compression="10"/>)",
+                   R"(<walkerlogs max_mb_per_s="-1"/>)"})
+  {
+    Libxml2Document doc;
+    REQUIRE(doc.parseFromString(xml));
+    CHECK_THROWS_AS(WalkerLogInput(doc.getRoot()), UniformCommunicateError);
+  }
+}
+
+
+} // namespace qmcplusplus
@@ -115,14 +115,7 @@ ACForce::Return_t ACForce::evaluate(ParticleSet& P)
     ham_.evaluateIonDerivs(P, ions_, psi_, hf_force_, pulay_force_, wf_grad_);
 
   if (useSpaceWarp_)
-  {
-    Forces el_grad;
-    el_grad.resize(P.getTotalNum());
-    el_grad = 0;
-
-    ham_.evaluateElecGrad(P, psi_, el_grad, delta_);
-    swt_.computeSWT(P, ions_, el_grad, P.G, sw_pulay_, sw_grad_);
-  }
+    evaluateSpaceWarp(P);
 
   //Now we compute the regularizer.
   //WE ASSUME THAT psi_.evaluateLog(P) HAS ALREADY BEEN CALLED AND Grad(logPsi)
@@ -133,6 +126,61 @@ ACForce::Return_t ACForce::evaluate(ParticleSet& P)
   return 0.0;
 };
 
+void ACForce::mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                          const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                          const RefVectorWithLeader<ParticleSet>& p_list) const
+{
+  auto& o_leader = o_list.getCastedLeader<ACForce>();
+  if (o_leader.fastDerivatives_)
+  {
+    for (int iw = 0; iw < o_list.size(); iw++)
+      o_list[iw].evaluate(p_list[iw]);
+    return;
+  }
+
+  const int nw = o_list.size();
+  RefVector<QMCHamiltonian> ham_refs;
+  RefVector<Forces> hf_forces, pulay_forces, wf_grads;
+  ham_refs.reserve(nw);
+  hf_forces.reserve(nw);
+  pulay_forces.reserve(nw);
+  wf_grads.reserve(nw);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    auto& force        = o_list.getCastedElement<ACForce>(iw);
+    force.hf_force_    = 0;
+    force.pulay_force_ = 0;
+    force.wf_grad_     = 0;
+    force.sw_pulay_    = 0;
+    force.sw_grad_     = 0;
+    ham_refs.push_back(force.ham_);
+    hf_forces.push_back(force.hf_force_);
+    pulay_forces.push_back(force.pulay_force_);
+    wf_grads.push_back(force.wf_grad_);
+  }
+
+  const RefVectorWithLeader<QMCHamiltonian> ham_list(o_leader.ham_, ham_refs);
+  QMCHamiltonian::mw_evaluateIonDerivs(ham_list, wf_list, p_list, o_leader.ions_, hf_forces, pulay_forces, wf_grads);
+
+  for (int iw = 0; iw < nw; iw++)
+  {
+    auto& force = o_list.getCastedElement<ACForce>(iw);
+    if (force.useSpaceWarp_)
+      force.evaluateSpaceWarp(p_list[iw]);
+    force.f_epsilon_ = compute_regularizer_f(force.psi_.G, force.reg_epsilon_);
+  }
+}
+
+void ACForce::evaluateSpaceWarp(ParticleSet& P)
+{
+  Forces el_grad;
+  el_grad.resize(P.getTotalNum());
+  el_grad = 0;
+
+  ham_.evaluateElecGrad(P, psi_, el_grad, delta_);
+  swt_.computeSWT(P, ions_, el_grad, P.G, sw_pulay_, sw_grad_);
+}
+
 void ACForce::resetTargetParticleSet(ParticleSet& P) {}
 
 void ACForce::addObservables(PropertySetType& plist, BufferType& collectables)
@@ -73,7 +73,19 @@ public:
   /** Evaluate **/
   Return_t evaluate(ParticleSet& P) final;
 
+  /** batched evaluate.
+   *  The ion derivatives of the whole walker batch are computed by QMCHamiltonian::mw_evaluateIonDerivs.
+   *  The space warp terms use finite differences of each walker's local energy on top of them.
+   *  The fast derivative algorithm has no batched counterpart and falls back to per walker evaluation.
+   */
+  void mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                   const RefVectorWithLeader<ParticleSet>& p_list) const final;
+
 private:
+  /// space warp Pulay and wavefunction gradient terms of configuration P
+  void evaluateSpaceWarp(ParticleSet& P);
+
   ///Finite difference timestep
   RealType delta_;
 
@@ -53,7 +53,29 @@ void BareForce::setParticlePropertyList(PropertySetType& plist, int offset) { se
 
 BareForce::Return_t BareForce::evaluate(ParticleSet& P)
 {
-  forces_                                   = forces_ion_ion_;
+  forces_ = forces_ion_ion_;
+  addElecIonForces(P, forces_);
+  tries_++;
+  return 0.0;
+}
+
+void BareForce::mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                            const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                            const RefVectorWithLeader<ParticleSet>& p_list) const
+{
+  auto& o_leader = o_list.getCastedLeader<BareForce>();
+  for (int iw = 0; iw < o_list.size(); iw++)
+  {
+    auto& force   = o_list.getCastedElement<BareForce>(iw);
+    force.forces_ = force.forces_ion_ion_;
+    // all the walkers share the ion charges and the table layout of the leader
+    o_leader.addElecIonForces(p_list[iw], force.forces_);
+    force.tries_++;
+  }
+}
+
+void BareForce::addElecIonForces(const ParticleSet& P, ParticleSet::ParticlePos& forces) const
+{
   const auto& d_ab                          = P.getDistTableAB(d_ei_id_);
   const ParticleSet::Scalar_t* restrict Zat = ions_.Z.first_address();
   const ParticleSet::Scalar_t* restrict Qat = P.Z.first_address();
@@ -66,11 +88,9 @@ BareForce::Return_t BareForce::evaluate(ParticleSet& P)
     {
       Real rinv = 1.0 / ab_dist[iat];
       Real r3zz = Qat[jat] * Zat[iat] * rinv * rinv * rinv;
-      forces_[iat] += r3zz * ab_displ[iat];
+      forces[iat] += r3zz * ab_displ[iat];
     }
   }
-  tries_++;
-  return 0.0;
 }
 
 bool BareForce::put(xmlNodePtr cur)
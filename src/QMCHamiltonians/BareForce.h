@@ -31,6 +31,10 @@ public:
 
   Return_t evaluate(ParticleSet& P) override;
 
+  void mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                   const RefVectorWithLeader<ParticleSet>& p_list) const override;
+
   void registerObservables(std::vector<ObservableHelper>& h5list, hdf_archive& file) const override;
 
   /** default implementation to add named values to  the property list
@@ -51,6 +55,9 @@ public:
   std::unique_ptr<OperatorBase> makeClone(ParticleSet& qp, TrialWaveFunction& psi) final;
 
 private:
+  /// add the electron-ion forces of the configuration in P to forces
+  void addElecIonForces(const ParticleSet& P, ParticleSet::ParticlePos& forces) const;
+
   const int d_ei_id_;
 };
 
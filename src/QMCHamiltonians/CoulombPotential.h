@@ -22,6 +22,9 @@
 #include "QMCHamiltonians/ForceBase.h"
 #include "QMCHamiltonians/OperatorBase.h"
 #include "QMCHamiltonians/OperatorBase.h"
+#include <ResourceCollection.h>
+#include <ResourceHandle.h>
+#include <algorithm>
 #include <numeric>
 
 namespace qmcplusplus
@@ -56,6 +59,25 @@ struct CoulombPotential : public OperatorBase, public ForceBase
 
   /// Flag for whether to compute forces or not
   bool ComputeForces;
+  /// true if all particles of the AA set carry the same charge
+  bool uniform_charge_;
+
+  /// a crowd's worth of per particle scratch for mw_evaluatePerParticle
+  struct CoulombPotentialMultiWalkerResource : public Resource
+  {
+    CoulombPotentialMultiWalkerResource() : Resource("CoulombPotential") {}
+
+    std::unique_ptr<Resource> makeClone() const override
+    {
+      return std::make_unique<CoulombPotentialMultiWalkerResource>(*this);
+    }
+
+    /// a walker's worth of per particle values of the target particle set
+    Vector<RealType> v_sample;
+    /// a walker's worth of per particle values of the source particle set, AB only
+    Vector<RealType> vi_sample;
+  };
+  ResourceHandle<CoulombPotentialMultiWalkerResource> mw_res_handle_;
 
   /** constructor for AA
    * @param s source particleset
@@ -73,8 +95,9 @@ struct CoulombPotential : public OperatorBase, public ForceBase
   {
     setEnergyDomain(POTENTIAL);
     twoBodyQuantumDomain(s, s);
-    nCenters = s.getTotalNum();
-    prefix_  = "F_AA";
+    nCenters        = s.getTotalNum();
+    prefix_         = "F_AA";
+    uniform_charge_ = std::all_of(s.Z.begin(), s.Z.end(), [&s](auto z) { return z == s.Z[0]; });
 
     if (!is_active) //precompute the value
     {
@@ -99,7 +122,8 @@ struct CoulombPotential : public OperatorBase, public ForceBase
         myTableIndex(t.addTable(s)),
         is_AA(false),
         is_active(active),
-        ComputeForces(false)
+        ComputeForces(false),
+        uniform_charge_(false)
   {
     setEnergyDomain(POTENTIAL);
     twoBodyQuantumDomain(s, t);
@@ -153,14 +177,117 @@ struct CoulombPotential : public OperatorBase, public ForceBase
       res = evaluate_spAA(d, Z);
     else
 #endif
-      for (size_t iat = 1; iat < nCenters; ++iat)
+      res = uniform_charge_ ? sumAAUniform(d, Z, nCenters) : sumAA(d, Z, nCenters);
+    return res;
+  }
+
+  /** sum of Z[i]Z[j]/r_ij over the pairs i>j of the AA table */
+  static T sumAA(const DistanceTableAA& d, const ParticleScalar* restrict Z, size_t n)
+  {
+    T res = 0.0;
+    for (size_t iat = 1; iat < n; ++iat)
+    {
+      const RealType* restrict dist = d.getDistRow(iat).data();
+      T e                           = 0.0;
+#pragma omp simd reduction(+ : e)
+      for (size_t j = 0; j < iat; ++j)
+        e += T(Z[j]) / dist[j];
+      res += Z[iat] * e;
+    }
+    return res;
+  }
+
+  /** sumAA when all the charges are Z[0], only the inverse distances are summed */
+  static T sumAAUniform(const DistanceTableAA& d, const ParticleScalar* restrict Z, size_t n)
+  {
+    T res = 0.0;
+    for (size_t iat = 1; iat < n; ++iat)
+    {
+      const RealType* restrict dist = d.getDistRow(iat).data();
+      T e                           = 0.0;
+#pragma omp simd reduction(+ : e)
+      for (size_t j = 0; j < iat; ++j)
+        e += T(1) / dist[j];
+      res += e;
+    }
+    return n > 0 ? res * Z[0] * Z[0] : res;
+  }
+
+  /** sum of Za[a]Zb[b]/r_ab over the AB table */
+  static T sumAB(const DistanceTableAB& d,
+                 const ParticleScalar* restrict Za,
+                 const ParticleScalar* restrict Zb,
+                 size_t n_sources)
+  {
+    T res                 = 0.0;
+    const size_t nTargets = d.targets();
+    for (size_t b = 0; b < nTargets; ++b)
+    {
+      const RealType* restrict dist = d.getDistRow(b).data();
+      T e                           = 0.0;
+#pragma omp simd reduction(+ : e)
+      for (size_t a = 0; a < n_sources; ++a)
+        e += Za[a] / dist[a];
+      res += e * Zb[b];
+    }
+    return res;
+  }
+
+  /** sumAA and its share per particle, half of every pair goes to each particle
+   * @param v per particle values, overwritten
+   */
+  static T sumAAPerParticle(const DistanceTableAA& d, const ParticleScalar* restrict Z, size_t n, RealType* restrict v)
+  {
+    T res = 0.0;
+    std::fill(v, v + n, 0.0);
+    for (size_t iat = 1; iat < n; ++iat)
+    {
+      const RealType* restrict dist = d.getDistRow(iat).data();
+      const T z                     = 0.5 * Z[iat];
+      T vi                          = 0.0;
+#pragma omp simd reduction(+ : vi)
+      for (size_t j = 0; j < iat; ++j)
       {
-        const auto& dist = d.getDistRow(iat);
-        T q              = Z[iat];
-        for (size_t j = 0; j < iat; ++j)
-          res += q * Z[j] / dist[j];
+        const T pairpot = z * Z[j] / dist[j];
+        v[j] += pairpot;
+        vi += pairpot;
       }
-    return res;
+      v[iat] += vi;
+      res += vi;
+    }
+    return 2 * res;
+  }
+
+  /** sumAB and its share per particle, half of every pair goes to each particle
+   * @param va per particle values of the sources, overwritten
+   * @param vb per particle values of the targets, overwritten
+   */
+  static T sumABPerParticle(const DistanceTableAB& d,
+                            const ParticleScalar* restrict Za,
+                            const ParticleScalar* restrict Zb,
+                            size_t n_sources,
+                            RealType* restrict va,
+                            RealType* restrict vb)
+  {
+    T res                 = 0.0;
+    const size_t nTargets = d.targets();
+    std::fill(va, va + n_sources, 0.0);
+    for (size_t b = 0; b < nTargets; ++b)
+    {
+      const RealType* restrict dist = d.getDistRow(b).data();
+      const T z                     = 0.5 * Zb[b];
+      T e                           = 0.0;
+#pragma omp simd reduction(+ : e)
+      for (size_t a = 0; a < n_sources; ++a)
+      {
+        const T pairpot = z * Za[a] / dist[a];
+        va[a] += pairpot;
+        e += pairpot;
+      }
+      vb[b] = e;
+      res += e;
+    }
+    return 2 * res;
   }
 
 
@@ -192,17 +319,7 @@ struct CoulombPotential : public OperatorBase, public ForceBase
       res = evaluate_spAB(d, Za, Zb);
     else
 #endif
-    {
-      const size_t nTargets = d.targets();
-      for (size_t b = 0; b < nTargets; ++b)
-      {
-        const auto& dist = d.getDistRow(b);
-        T e              = czero;
-        for (size_t a = 0; a < nCenters; ++a)
-          e += Za[a] / dist[a];
-        res += e * Zb[b];
-      }
-    }
+      res = sumAB(d, Za, Zb, nCenters);
     return res;
   }
 
@@ -340,6 +457,92 @@ struct CoulombPotential : public OperatorBase, public ForceBase
     return value_;
   }
 
+  void mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                   const RefVectorWithLeader<ParticleSet>& p_list) const override
+  {
+    auto& o_leader = o_list.getCastedLeader<CoulombPotential>();
+    assert(this == &o_list.getLeader());
+    if (!o_leader.is_active)
+      return;
+#if !defined(REMOVE_TRACEMANAGER)
+    if (o_leader.streaming_particles_)
+    {
+      OperatorBase::mw_evaluate(o_list, wf_list, p_list);
+      return;
+    }
+#endif
+    for (int iw = 0; iw < o_list.size(); iw++)
+    {
+      auto& coulomb = o_list.getCastedElement<CoulombPotential>(iw);
+      ParticleSet& P(p_list[iw]);
+      if (is_AA)
+        coulomb.value_ = uniform_charge_ ? sumAAUniform(P.getDistTableAA(myTableIndex), P.Z.first_address(), nCenters)
+                                         : sumAA(P.getDistTableAA(myTableIndex), P.Z.first_address(), nCenters);
+      else
+        coulomb.value_ =
+            sumAB(P.getDistTableAB(myTableIndex), coulomb.Pa.Z.first_address(), P.Z.first_address(), nCenters);
+    }
+  }
+
+  /** Evaluate the potential and report its per particle values to the listeners.
+   *  AA reports the target particles to listeners, AB reports the targets to listeners and the
+   *  sources to ion_listeners.
+   */
+  void mw_evaluatePerParticle(const RefVectorWithLeader<OperatorBase>& o_list,
+                              const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                              const RefVectorWithLeader<ParticleSet>& p_list,
+                              const std::vector<ListenerVector<RealType>>& listeners,
+                              const std::vector<ListenerVector<RealType>>& ion_listeners) const override
+  {
+    auto& o_leader = o_list.getCastedLeader<CoulombPotential>();
+    assert(this == &o_list.getLeader());
+    if (!o_leader.is_active)
+      return;
+
+    auto& mw_res                = o_leader.mw_res_handle_.getResource();
+    Vector<RealType>& v_sample  = mw_res.v_sample;
+    Vector<RealType>& vi_sample = mw_res.vi_sample;
+    const auto& name            = o_leader.getName();
+    for (int iw = 0; iw < o_list.size(); iw++)
+    {
+      auto& coulomb = o_list.getCastedElement<CoulombPotential>(iw);
+      ParticleSet& P(p_list[iw]);
+      v_sample.resize(P.getTotalNum());
+      if (is_AA)
+        coulomb.value_ =
+            sumAAPerParticle(P.getDistTableAA(myTableIndex), P.Z.first_address(), nCenters, v_sample.data());
+      else
+      {
+        vi_sample.resize(nCenters);
+        coulomb.value_ = sumABPerParticle(P.getDistTableAB(myTableIndex), coulomb.Pa.Z.first_address(),
+                                          P.Z.first_address(), nCenters, vi_sample.data(), v_sample.data());
+        for (const ListenerVector<RealType>& listener : ion_listeners)
+          listener.report(iw, name, vi_sample);
+      }
+      for (const ListenerVector<RealType>& listener : listeners)
+        listener.report(iw, name, v_sample);
+    }
+  }
+
+  void createResource(ResourceCollection& collection) const override
+  {
+    auto new_res        = std::make_unique<CoulombPotentialMultiWalkerResource>();
+    auto resource_index = collection.addResource(std::move(new_res));
+  }
+
+  void acquireResource(ResourceCollection& collection, const RefVectorWithLeader<OperatorBase>& o_list) const override
+  {
+    auto& o_leader          = o_list.getCastedLeader<CoulombPotential>();
+    o_leader.mw_res_handle_ = collection.lendResource<CoulombPotentialMultiWalkerResource>();
+  }
+
+  void releaseResource(ResourceCollection& collection, const RefVectorWithLeader<OperatorBase>& o_list) const override
+  {
+    auto& o_leader = o_list.getCastedLeader<CoulombPotential>();
+    collection.takebackResource(o_leader.mw_res_handle_);
+  }
+
   inline void evaluateIonDerivs(ParticleSet& P,
                                 ParticleSet& ions,
                                 TrialWaveFunction& psi,
@@ -41,13 +41,14 @@ namespace qmcplusplus
 void HamiltonianFactory::addMPCPotential(xmlNodePtr cur, bool isphysical)
 {
 #if OHMMS_DIM == 3 && defined(HAVE_LIBFFTW)
-  std::string a("e"), title("MPC"), physical("no");
+  std::string a("e"), title("MPC"), physical("no"), precision;
   OhmmsAttributeSet hAttrib;
   double cutoff = 30.0;
   hAttrib.add(title, "id");
   hAttrib.add(title, "name");
   hAttrib.add(cutoff, "cutoff");
   hAttrib.add(physical, "physical");
+  hAttrib.add(precision, "precision", {"double", "single", "float"});
   hAttrib.put(cur);
   renameProperty(a);
   isphysical = (physical == "yes" || physical == "true");
@@ -56,6 +57,7 @@ void HamiltonianFactory::addMPCPotential(xmlNodePtr cur, bool isphysical)
   app_summary() << "   MPC Potential" << std::endl;
   app_summary() << "   -------------" << std::endl;
   app_summary() << "    Name: " << title << "   Physical : " << physical << std::endl;
+  app_summary() << "    Spline precision: " << precision << std::endl;
   app_summary() << std::endl;
 
   if (targetPtcl.Density_G.size() == 0)
@@ -66,7 +68,7 @@ void HamiltonianFactory::addMPCPotential(xmlNodePtr cur, bool isphysical)
                               "    The electron density was not setup by the "
                               "wave function builder.\n");
 
-  auto mpc = std::make_unique<MPC>(targetPtcl, cutoff);
+  auto mpc = std::make_unique<MPC>(targetPtcl, cutoff, precision != "double");
   targetH->addOperator(std::move(mpc), "MPC", isphysical);
 #else
   APP_ABORT(
@@ -180,6 +180,73 @@ ForceChiesaPBCAA::Return_t ForceChiesaPBCAA::evaluate(ParticleSet& P)
   return 0.0;
 }
 
+void ForceChiesaPBCAA::mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                   const RefVectorWithLeader<ParticleSet>& p_list) const
+{
+  for (int iw = 0; iw < o_list.size(); iw++)
+    o_list.getCastedElement<ForceChiesaPBCAA>(iw).forces_ = 0.0;
+  mw_evaluateLR(o_list, p_list);
+  for (int iw = 0; iw < o_list.size(); iw++)
+  {
+    auto& force = o_list.getCastedElement<ForceChiesaPBCAA>(iw);
+    force.evaluateSR(p_list[iw]);
+    if (force.add_ion_ion_ == true)
+      force.forces_ = force.forces_ + force.forces_ion_ion_;
+  }
+}
+
+void ForceChiesaPBCAA::mw_evaluateLR(const RefVectorWithLeader<OperatorBase>& o_list,
+                                     const RefVectorWithLeader<ParticleSet>& p_list)
+{
+  auto& o_leader     = o_list.getCastedLeader<ForceChiesaPBCAA>();
+  const size_t nw    = o_list.size();
+  const auto& Fkg    = o_leader.dAB->Fkg;
+  const size_t nk    = Fkg.size();
+  const auto& kpts   = o_leader.PtclA.getSimulationCell().getKLists().kpts_cart;
+  const auto& eikr_r = o_leader.PtclA.getSK().eikr_r;
+  const auto& eikr_i = o_leader.PtclA.getSK().eikr_i;
+
+  // sum_j Qspec[j] rho_k^j, the species loop of evaluateLR is linear in rho_k
+  auto& rhok_r = o_leader.mw_rhok_r_;
+  auto& rhok_i = o_leader.mw_rhok_i_;
+  rhok_r.resize(nw, nk);
+  rhok_i.resize(nw, nk);
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    const auto& sk        = p_list[iw].getSK();
+    RealType* restrict rr = rhok_r[iw];
+    RealType* restrict ri = rhok_i[iw];
+    std::fill_n(rr, nk, RealType(0));
+    std::fill_n(ri, nk, RealType(0));
+    for (int j = 0; j < o_leader.NumSpeciesB; j++)
+    {
+      const RealType q        = o_leader.Qspec[j];
+      const auto* restrict br = sk.rhok_r[j];
+      const auto* restrict bi = sk.rhok_i[j];
+      for (size_t ki = 0; ki < nk; ki++)
+      {
+        rr[ki] += q * br[ki];
+        ri[ki] += q * bi[ki];
+      }
+    }
+  }
+
+  for (int iat = 0; iat < o_leader.NptclA; iat++)
+  {
+    const RealType z = o_leader.Zat[iat];
+    for (size_t ki = 0; ki < nk; ki++)
+    {
+      const PosType zk  = z * Fkg[ki] * kpts[ki];
+      const RealType er = eikr_r(iat, ki);
+      const RealType ei = eikr_i(iat, ki);
+      for (size_t iw = 0; iw < nw; iw++)
+        o_list.getCastedElement<ForceChiesaPBCAA>(iw).forces_[iat] -=
+            zk * (er * rhok_i(iw, ki) - ei * rhok_r(iw, ki));
+    }
+  }
+}
+
 ForceChiesaPBCAA::Return_t ForceChiesaPBCAA::g_filter(RealType r)
 {
   if (r >= Rcut)
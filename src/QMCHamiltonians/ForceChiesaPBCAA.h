@@ -66,10 +66,20 @@ struct ForceChiesaPBCAA : public OperatorBase, public ForceBase
 
   Return_t evaluate(ParticleSet& P) override;
 
+  void mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                   const RefVectorWithLeader<ParticleSet>& p_list) const override;
+
   void InitMatrix();
   void initBreakup(ParticleSet& P);
 
   void evaluateLR(ParticleSet&);
+  /** batched long-range part.
+   *  The electron structure factors of each walker are first contracted with the species charges,
+   *  then the ion structure factor is streamed once for all the walkers.
+   */
+  static void mw_evaluateLR(const RefVectorWithLeader<OperatorBase>& o_list,
+                            const RefVectorWithLeader<ParticleSet>& p_list);
   void evaluateSR(ParticleSet&);
   void evaluateSR_AA();
   void evaluateLR_AA();
@@ -114,6 +124,9 @@ struct ForceChiesaPBCAA : public OperatorBase, public ForceBase
   int getDistanceTableAAID() const { return d_aa_ID; }
 
 private:
+  ///charge weighted electron structure factors of a walker batch, num_walkers x num_kpoints
+  Matrix<RealType> mw_rhok_r_;
+  Matrix<RealType> mw_rhok_i_;
   // AA table ID
   const int d_aa_ID;
   const int d_ei_ID;
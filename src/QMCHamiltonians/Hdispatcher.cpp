@@ -53,6 +53,38 @@ std::vector<QMCHamiltonian::FullPrecRealType> Hdispatcher::flex_evaluateWithTope
   }
 }
 
+void Hdispatcher::flex_evaluate(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                const RefVectorWithLeader<ParticleSet>& p_list,
+                                std::vector<FullPrecRealType>& local_energies) const
+{
+  assert(ham_list.size() == p_list.size());
+  if (use_batch_)
+    QMCHamiltonian::mw_evaluate(ham_list, wf_list, p_list, local_energies);
+  else
+  {
+    local_energies.resize(ham_list.size());
+    for (size_t iw = 0; iw < ham_list.size(); iw++)
+      local_energies[iw] = ham_list[iw].evaluate(p_list[iw]);
+  }
+}
+
+void Hdispatcher::flex_evaluateWithToperator(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                             const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                             const RefVectorWithLeader<ParticleSet>& p_list,
+                                             std::vector<FullPrecRealType>& local_energies) const
+{
+  assert(ham_list.size() == p_list.size());
+  if (use_batch_)
+    QMCHamiltonian::mw_evaluateWithToperator(ham_list, wf_list, p_list, local_energies);
+  else
+  {
+    local_energies.resize(ham_list.size());
+    for (size_t iw = 0; iw < ham_list.size(); iw++)
+      local_energies[iw] = ham_list[iw].evaluateWithToperator(p_list[iw]);
+  }
+}
+
 std::vector<int> Hdispatcher::flex_makeNonLocalMoves(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
                                                      const RefVectorWithLeader<TrialWaveFunction>& wf_list,
                                                      const RefVectorWithLeader<ParticleSet>& p_list,
@@ -70,4 +102,34 @@ std::vector<int> Hdispatcher::flex_makeNonLocalMoves(const RefVectorWithLeader<Q
   }
 }
 
+void Hdispatcher::flex_auxHevaluate(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                    const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                    const RefVectorWithLeader<ParticleSet>& p_list,
+                                    const RefVector<QMCHamiltonian::Walker_t>& walkers) const
+{
+  assert(ham_list.size() == p_list.size());
+  assert(ham_list.size() == walkers.size());
+  if (use_batch_)
+    QMCHamiltonian::mw_auxHevaluate(ham_list, wf_list, p_list, walkers);
+  else
+    for (size_t iw = 0; iw < ham_list.size(); iw++)
+      ham_list[iw].auxHevaluate(p_list[iw], walkers[iw]);
+}
+
+void Hdispatcher::flex_evaluateIonDerivs(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                         const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                         const RefVectorWithLeader<ParticleSet>& p_list,
+                                         ParticleSet& ions,
+                                         const RefVector<ParticleSet::ParticlePos>& hf_terms,
+                                         const RefVector<ParticleSet::ParticlePos>& pulay_terms,
+                                         const RefVector<ParticleSet::ParticlePos>& wf_grads) const
+{
+  assert(ham_list.size() == p_list.size());
+  if (use_batch_)
+    QMCHamiltonian::mw_evaluateIonDerivs(ham_list, wf_list, p_list, ions, hf_terms, pulay_terms, wf_grads);
+  else
+    for (size_t iw = 0; iw < ham_list.size(); iw++)
+      ham_list[iw].evaluateIonDerivs(p_list[iw], ions, wf_list[iw], hf_terms[iw], pulay_terms[iw], wf_grads[iw]);
+}
+
 } // namespace qmcplusplus
@@ -36,11 +36,36 @@ public:
                                                            const RefVectorWithLeader<TrialWaveFunction>& wf_list,
                                                            const RefVectorWithLeader<ParticleSet>& p_list) const;
 
+  /// flex_evaluate writing the local energies into a caller owned vector
+  void flex_evaluate(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                     const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                     const RefVectorWithLeader<ParticleSet>& p_list,
+                     std::vector<FullPrecRealType>& local_energies) const;
+
+  /// flex_evaluateWithToperator writing the local energies into a caller owned vector
+  void flex_evaluateWithToperator(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                  const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                  const RefVectorWithLeader<ParticleSet>& p_list,
+                                  std::vector<FullPrecRealType>& local_energies) const;
+
   std::vector<int> flex_makeNonLocalMoves(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
                                           const RefVectorWithLeader<TrialWaveFunction>& wf_list,
                                           const RefVectorWithLeader<ParticleSet>& p_list,
                                           NonLocalTOperator& move_op) const;
 
+  void flex_auxHevaluate(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                         const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                         const RefVectorWithLeader<ParticleSet>& p_list,
+                         const RefVector<QMCHamiltonian::Walker_t>& walkers) const;
+
+  void flex_evaluateIonDerivs(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                              const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                              const RefVectorWithLeader<ParticleSet>& p_list,
+                              ParticleSet& ions,
+                              const RefVector<ParticleSet::ParticlePos>& hf_terms,
+                              const RefVector<ParticleSet::ParticlePos>& pulay_terms,
+                              const RefVector<ParticleSet::ParticlePos>& wf_grads) const;
+
 private:
   bool use_batch_;
 };
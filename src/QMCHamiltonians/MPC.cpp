@@ -20,6 +20,8 @@
 #include "Particle/DistanceTable.h"
 #include "Particle/MCWalkerConfiguration.h"
 #include "Utilities/IteratorUtility.h"
+#include "spline2/MultiBsplineEval.hpp"
+#include <ResourceCollection.h>
 
 #if defined(HAVE_LIBFFTW)
 #include <fftw3.h>
@@ -30,10 +32,56 @@
 
 namespace qmcplusplus
 {
+struct MPC::MPCMultiWalkerResource : public Resource
+{
+  MPCMultiWalkerResource() : Resource("MPC") {}
+
+  std::unique_ptr<Resource> makeClone() const override { return std::make_unique<MPCMultiWalkerResource>(*this); }
+
+  /// reduced coordinates of the electrons of all the walkers, in the precision of the table
+  std::vector<TinyVector<double, OHMMS_DIM>> upos;
+  std::vector<TinyVector<float, OHMMS_DIM>> upos_single;
+  /// long range part per walker
+  std::vector<MPC::Return_t> lr;
+};
+
+namespace
+{
+/// append the reduced coordinates of the particles of P, wrapped into [0,1)
+template<typename T>
+void appendUnitPositions(const ParticleSet& P, std::vector<TinyVector<T, OHMMS_DIM>>& upos)
+{
+  for (int i = 0; i < P.getTotalNum(); i++)
+  {
+    const auto u = P.getLattice().toUnit(P.R[i]);
+    TinyVector<T, OHMMS_DIM> uw;
+    for (int j = 0; j < OHMMS_DIM; j++)
+      uw[j] = u[j] - std::floor(u[j]);
+    upos.push_back(uw);
+  }
+}
+
+/** add the spline values at upos to lr, np consecutive positions belong to the same walker
+ * All the positions go through the multi-position evaluation of spline2 back to back.
+ */
+template<typename T>
+void accumulateLR(const typename bspline_traits<T, 3>::SingleSplineType* spline,
+                  const std::vector<TinyVector<T, OHMMS_DIM>>& upos,
+                  int np,
+                  MPC::Return_t* lr)
+{
+  std::array<T, 1> val;
+  spline2::evaluate3d_multi(spline, upos, val, 0, 1, [&](int ip) { lr[ip / np] += val[0]; });
+}
+} // namespace
+
 void MPC::resetTargetParticleSet(ParticleSet& ptcl) {}
 
-MPC::MPC(ParticleSet& ptcl, double cutoff)
-    : Ecut(cutoff), d_aa_ID(ptcl.addTable(ptcl, DTModes::NEED_FULL_TABLE_ON_HOST_AFTER_DONEPBYP)), FirstTime(true)
+MPC::MPC(ParticleSet& ptcl, double cutoff, bool use_single)
+    : Ecut(cutoff),
+      d_aa_ID(ptcl.addTable(ptcl, DTModes::NEED_FULL_TABLE_ON_HOST_AFTER_DONEPBYP)),
+      UseSingle(use_single),
+      FirstTime(true)
 {
   initBreakup(ptcl);
 }
@@ -281,6 +329,23 @@ void MPC::init_spline(const ParticleSet& ptcl)
   VlongSpline =
       std::shared_ptr<UBspline_3d_d>(create_UBspline_3d_d(grid0, grid1, grid2, bc0, bc1, bc2, splineData.data()),
                                      destroy_Bspline);
+  if (UseSingle)
+  {
+    // same layout as the double precision table, the coefficients solved in double precision are rounded
+    BCtype_s bc0_s, bc1_s, bc2_s;
+    bc0_s.lCode = bc0_s.rCode = PERIODIC;
+    bc1_s.lCode = bc1_s.rCode = PERIODIC;
+    bc2_s.lCode = bc2_s.rCode = PERIODIC;
+    Array<float, 3> splineDataSingle(SplineDim);
+    std::copy(splineData.begin(), splineData.end(), splineDataSingle.begin());
+    VlongSplineSingle = std::shared_ptr<UBspline_3d_s>(create_UBspline_3d_s(grid0, grid1, grid2, bc0_s, bc1_s, bc2_s,
+                                                                            splineDataSingle.data()),
+                                                       destroy_Bspline);
+    std::copy_n(VlongSpline->coefs, VlongSpline->coefs_size, VlongSplineSingle->coefs);
+    // only the single precision table is evaluated from here on
+    VlongSpline.reset();
+    app_log() << "  Using single precision MPC spline.\n";
+  }
   //     grid0.num = ptcl.Density_r.size(0);
   //     grid1.num = ptcl.Density_r.size(1);
   //     grid2.num = ptcl.Density_r.size(2);
@@ -328,6 +393,7 @@ MPC::Return_t MPC::evalSR(ParticleSet& P) const
   {
     RealType esum(0);
     const auto& dist = d_aa.getDistRow(ipart);
+#pragma omp simd reduction(+ : esum)
     for (size_t j = 0; j < ipart; ++j)
       esum += cone / dist[j];
     SR += esum;
@@ -335,8 +401,16 @@ MPC::Return_t MPC::evalSR(ParticleSet& P) const
   return SR;
 }
 
-MPC::Return_t MPC::evalLR(ParticleSet& P) const
+MPC::Return_t MPC::evalLR(ParticleSet& P)
 {
+  if (UseSingle)
+  {
+    UposSingle.clear();
+    appendUnitPositions(P, UposSingle);
+    Return_t LR = 0.0;
+    accumulateLR<float>(VlongSplineSingle.get(), UposSingle, NParticles, &LR);
+    return LR;
+  }
   RealType LR = 0.0;
   double val;
   for (int i = 0; i < NParticles; i++)
@@ -358,6 +432,56 @@ MPC::Return_t MPC::evaluate(ParticleSet& P)
   return value_;
 }
 
+void MPC::mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                      const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                      const RefVectorWithLeader<ParticleSet>& p_list) const
+{
+  auto& o_leader = o_list.getCastedLeader<MPC>();
+  assert(this == &o_list.getLeader());
+  auto& mw_res = o_leader.mw_res_handle_.getResource();
+  const int nw = o_list.size();
+
+  mw_res.lr.assign(nw, 0.0);
+  if (UseSingle)
+  {
+    mw_res.upos_single.clear();
+    for (int iw = 0; iw < nw; iw++)
+      appendUnitPositions(p_list[iw], mw_res.upos_single);
+    accumulateLR<float>(VlongSplineSingle.get(), mw_res.upos_single, NParticles, mw_res.lr.data());
+  }
+  else
+  {
+    mw_res.upos.clear();
+    for (int iw = 0; iw < nw; iw++)
+      appendUnitPositions(p_list[iw], mw_res.upos);
+    accumulateLR<double>(VlongSpline.get(), mw_res.upos, NParticles, mw_res.lr.data());
+  }
+
+  for (int iw = 0; iw < nw; iw++)
+  {
+    auto& mpc  = o_list.getCastedElement<MPC>(iw);
+    mpc.value_ = mpc.evalSR(p_list[iw]) + mw_res.lr[iw] + mpc.Vconst;
+  }
+}
+
+void MPC::createResource(ResourceCollection& collection) const
+{
+  auto new_res        = std::make_unique<MPCMultiWalkerResource>();
+  auto resource_index = collection.addResource(std::move(new_res));
+}
+
+void MPC::acquireResource(ResourceCollection& collection, const RefVectorWithLeader<OperatorBase>& o_list) const
+{
+  auto& o_leader          = o_list.getCastedLeader<MPC>();
+  o_leader.mw_res_handle_ = collection.lendResource<MPCMultiWalkerResource>();
+}
+
+void MPC::releaseResource(ResourceCollection& collection, const RefVectorWithLeader<OperatorBase>& o_list) const
+{
+  auto& o_leader = o_list.getCastedLeader<MPC>();
+  collection.takebackResource(o_leader.mw_res_handle_);
+}
+
 bool MPC::put(xmlNodePtr cur)
 {
   Ecut = -1.0;
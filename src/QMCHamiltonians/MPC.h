@@ -18,11 +18,13 @@
 
 #include "QMCHamiltonians/OperatorBase.h"
 #include "LongRange/LRCoulombSingleton.h"
+#include <ResourceHandle.h>
 
 #if defined(HAVE_EINSPLINE)
 #include "einspline/bspline.h"
 #else
 class UBspline_3d_d;
+class UBspline_3d_s;
 #endif
 namespace qmcplusplus
 {
@@ -33,7 +35,10 @@ namespace qmcplusplus
 class MPC : public OperatorBase
 {
 protected:
+  /// long range table, released after its coefficients are copied to VlongSplineSingle if UseSingle
   std::shared_ptr<UBspline_3d_d> VlongSpline;
+  /// single precision copy of VlongSpline, only created if UseSingle
+  std::shared_ptr<UBspline_3d_s> VlongSplineSingle;
   //std::shared_ptr<UBspline_3d_d> DensitySpline;
   double Vconst;
   double Ecut;
@@ -44,6 +49,14 @@ protected:
   int MaxDim;
   // AA table ID
   const int d_aa_ID;
+  /// if true, the long range part is evaluated from VlongSplineSingle
+  const bool UseSingle;
+  /// reduced coordinates of the electrons for evalLR, reused between the calls if UseSingle
+  std::vector<TinyVector<float, OHMMS_DIM>> UposSingle;
+
+  /// multiwalker shared resource
+  struct MPCMultiWalkerResource;
+  ResourceHandle<MPCMultiWalkerResource> mw_res_handle_;
 
   void initBreakup(const ParticleSet& ptcl);
   void compute_g_G(const ParticleSet& ptcl, double& g_0_N, std::vector<double>& g_G_N, int N);
@@ -51,7 +64,7 @@ protected:
   void init_f_G(const ParticleSet& ptcl);
   void init_spline(const ParticleSet& ptcl);
   Return_t evalSR(ParticleSet& P) const;
-  Return_t evalLR(ParticleSet& P) const;
+  Return_t evalLR(ParticleSet& P);
 
 public:
   // Store the average electron charge density in reciprocal space
@@ -70,7 +83,12 @@ public:
   std::vector<RealType> Zat, Zspec;
   std::vector<int> NofSpecies;
 
-  MPC(ParticleSet& ref, double cutoff);
+  /** constructor
+   * @param ref the electrons, Density_G must be set up by the wave function builder
+   * @param cutoff kinetic energy cutoff of the G-vectors
+   * @param use_single evaluate the long range part from a single precision table
+   */
+  MPC(ParticleSet& ref, double cutoff, bool use_single = false);
 
   /// copy constructor
   // MPC(const MPC& c);
@@ -82,6 +100,26 @@ public:
 
   Return_t evaluate(ParticleSet& P) override;
 
+  /** evaluate the walkers of a crowd
+   * The reduced coordinates of all the electrons of all the walkers are gathered and
+   * evaluated in one pass over the spline table.
+   */
+  void mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                   const RefVectorWithLeader<ParticleSet>& p_list) const override;
+
+  /** initialize a shared resource and hand it to a collection
+   */
+  void createResource(ResourceCollection& collection) const override;
+
+  /** acquire a shared resource from a collection
+   */
+  void acquireResource(ResourceCollection& collection, const RefVectorWithLeader<OperatorBase>& o_list) const override;
+
+  /** return a shared resource to a collection
+   */
+  void releaseResource(ResourceCollection& collection, const RefVectorWithLeader<OperatorBase>& o_list) const override;
+
   /** Do nothing */
   bool put(xmlNodePtr cur) override;
 
@@ -484,43 +484,7 @@ NonLocalECPComponent::RealType NonLocalECPComponent::evaluateOneWithForces(Parti
                                                                            PosType& force_iat,
                                                                            ParticleSet::ParticlePos& pulay_terms)
 {
-  constexpr RealType czero(0);
-  constexpr RealType cone(1);
-
-  //We check that our quadrature grid is valid.  Namely, that all points lie on the unit sphere.
-  //We check this by seeing if |r|^2 = 1 to machine precision.
-  for (int j = 0; j < nknot; j++)
-    assert(std::abs(std::sqrt(dot(rrotsgrid_m[j], rrotsgrid_m[j])) - 1) <
-           100 * std::numeric_limits<RealType>::epsilon());
-
-  for (int j = 0; j < nknot; j++)
-    deltaV[j] = r * rrotsgrid_m[j] - dr;
-
-  GradType gradtmp_(0);
-  PosType realgradtmp_(0);
-
-  //Pseudopotential derivative w.r.t. ions can be split up into 3 contributions:
-  // term coming from the gradient of the radial potential
-  PosType gradpotterm_(0);
-  // term coming from gradient of legendre polynomial
-  PosType gradlpolyterm_(0);
-  // term coming from dependence of quadrature grid on ion position.
-  PosType gradwfnterm_(0);
-
-  //Now for the Pulay specific stuff...
-  // $\nabla_I \Psi(...r...)/\Psi(...r...)$
-  ParticleSet::ParticlePos pulay_ref;
-  ParticleSet::ParticlePos pulaytmp_;
-  // $\nabla_I \Psi(...q...)/\Psi(...r...)$ for each quadrature point.
-  std::vector<ParticleSet::ParticlePos> pulay_quad(nknot);
-
-  //A working array for pulay stuff.
-  GradType iongradtmp_(0);
-  //resize everything.
-  pulay_ref.resize(ions.getTotalNum());
-  pulaytmp_.resize(ions.getTotalNum());
-  for (size_t j = 0; j < nknot; j++)
-    pulay_quad[j].resize(ions.getTotalNum());
+  prepareOneWithForces(ions.getTotalNum(), r, dr);
 
   if (VP)
   {
@@ -532,22 +496,12 @@ NonLocalECPComponent::RealType NonLocalECPComponent::evaluateOneWithForces(Parti
   else
   {
     // Compute ratio of wave functions
+    GradType gradtmp_(0);
     for (int j = 0; j < nknot; j++)
     {
       W.makeMove(iel, deltaV[j], false);
       psiratio[j] = psi.calcRatioGrad(W, iel, gradtmp_);
-      //QMCPACK spits out $\nabla\Psi(q)/\Psi(q)$.
-      //Multiply times $\Psi(q)/\Psi(r)$ to get
-      // $\nabla\Psi(q)/\Psi(r)
-      gradtmp_ *= psiratio[j];
-#if defined(QMC_COMPLEX)
-      //And now we take the real part and save it.
-      convertToReal(gradtmp_, gradpsiratio[j]);
-#else
-      //Real nonlocalpp forces seem to differ from those in the complex build.  Since
-      //complex build has been validated against QE, that indicates there's a bug for the real build.
-      gradpsiratio[j] = gradtmp_;
-#endif
+      storeGradPsiRatio(j, gradtmp_);
       W.rejectMove(iel);
       psi.resetPhaseDiff();
       //psi.rejectMove(iel);
@@ -557,25 +511,12 @@ NonLocalECPComponent::RealType NonLocalECPComponent::evaluateOneWithForces(Parti
   for (int j = 0; j < nknot; j++)
     psiratio[j] *= sgridweight_m[j];
 
-  // This is just a temporary variable to dump d2/dr2 into for spline evaluation.
-  RealType secondderiv(0);
-
-  const RealType rinv = cone / r;
-
-  // Compute radial potential and its derivative times (2l+1)
-  for (int ip = 0; ip < nchannel; ip++)
-  {
-    //fun fact.  NLPComponent stores v(r) as v(r), and not as r*v(r) like in other places.
-    vrad[ip]  = nlpp_m[ip]->splint(r, dvrad[ip], secondderiv) * wgt_angpp_m[ip];
-    vgrad[ip] = dvrad[ip] * dr * wgt_angpp_m[ip] * rinv;
-  }
-
   //Now to construct the 3N dimensional ionic wfn derivatives for pulay terms.
   //This is going to be slow an painful for now.
+  GradType iongradtmp_(0);
   for (size_t jat = 0; jat < ions.getTotalNum(); jat++)
   {
     convertToReal(psi.evalGradSource(W, ions, jat), pulay_ref[jat]);
-    gradpotterm_ = 0;
     for (size_t j = 0; j < nknot; j++)
     {
       deltaV[j] = r * rrotsgrid_m[j] - dr;
@@ -602,6 +543,178 @@ NonLocalECPComponent::RealType NonLocalECPComponent::evaluateOneWithForces(Parti
     }
   }
 
+  return assembleOneWithForces(r, dr, force_iat, pulay_terms);
+}
+
+void NonLocalECPComponent::mw_evaluateOneWithForces(
+    const RefVectorWithLeader<NonLocalECPComponent>& ecp_component_list,
+    const RefVectorWithLeader<ParticleSet>& p_list,
+    const RefVectorWithLeader<TrialWaveFunction>& psi_list,
+    ParticleSet& ions,
+    const RefVector<const NLPPJob<RealType>>& joblist,
+    std::vector<RealType>& pairpots,
+    const RefVector<PosType>& force_list,
+    const RefVector<ParticleSet::ParticlePos>& pulay_list)
+{
+  const size_t nw = p_list.size();
+  if (nw == 0)
+    return;
+  const int iel = joblist[0].get().electron_id;
+
+  // walkers out of range keep their electron in place and contribute nothing
+  std::vector<bool> in_range(nw);
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    NonLocalECPComponent& component(ecp_component_list[iw]);
+    const NLPPJob<RealType>& job = joblist[iw];
+    // the moves of the batch are made on the same electron of each walker
+    assert(job.electron_id == iel);
+    if (component.VP)
+      APP_ABORT("NonLocalECPComponent::mw_evaluateOneWithForces(...): Forces not implemented with virtual particle "
+                "moves\n");
+    in_range[iw] = job.ion_elec_dist < component.getRmax();
+    component.prepareOneWithForces(ions.getTotalNum(), job.ion_elec_dist, job.ion_elec_displ);
+  }
+
+  // the knots of all the components have the same count, each walker moves to its own quadrature points
+  const int nknot = ecp_component_list.getLeader().getNknot();
+  std::vector<PosType> displs(nw);
+  std::vector<ValueType> ratios(nw);
+  std::vector<GradType> ion_grads(nw);
+  TWFGrads<CoordsType::POS> grads_new(nw);
+  const std::vector<bool> rejected(nw, false);
+
+  // Compute ratio of wave functions
+  for (int j = 0; j < nknot; j++)
+  {
+    for (size_t iw = 0; iw < nw; iw++)
+      displs[iw] = in_range[iw] ? ecp_component_list[iw].deltaV[j] : PosType();
+    ParticleSet::mw_makeMove(p_list, iel, displs);
+    TrialWaveFunction::mw_calcRatioGrad(psi_list, p_list, iel, ratios, grads_new);
+    for (size_t iw = 0; iw < nw; iw++)
+    {
+      NonLocalECPComponent& component(ecp_component_list[iw]);
+      component.psiratio[j] = ratios[iw];
+      component.storeGradPsiRatio(j, grads_new.grads_positions[iw]);
+    }
+    TrialWaveFunction::mw_accept_rejectMove(psi_list, p_list, iel, rejected);
+    ParticleSet::mw_accept_rejectMove(p_list, iel, rejected);
+    for (TrialWaveFunction& psi : psi_list)
+      psi.resetPhaseDiff();
+  }
+
+  for (NonLocalECPComponent& component : ecp_component_list)
+    for (int j = 0; j < nknot; j++)
+      component.psiratio[j] *= component.sgridweight_m[j];
+
+  // ionic wfn derivatives for pulay terms, the same move sequence as evaluateOneWithForces for the whole batch.
+  // The batched accept only has the forward mode which leaves the e-e table column of iel in the later rows untouched,
+  // those entries are right again once the electron is moved back.
+  for (size_t jat = 0; jat < ions.getTotalNum(); jat++)
+  {
+    TrialWaveFunction::mw_evalGradSource(psi_list, p_list, ions, jat, ion_grads);
+    for (size_t iw = 0; iw < nw; iw++)
+      convertToReal(ion_grads[iw], ecp_component_list[iw].pulay_ref[jat]);
+    for (int j = 0; j < nknot; j++)
+    {
+      for (size_t iw = 0; iw < nw; iw++)
+        displs[iw] = in_range[iw] ? ecp_component_list[iw].deltaV[j] : PosType();
+      ParticleSet::mw_makeMove(p_list, iel, displs);
+      TrialWaveFunction::mw_calcRatio(psi_list, p_list, iel, ratios);
+      TrialWaveFunction::mw_accept_rejectMove(psi_list, p_list, iel, in_range);
+      ParticleSet::mw_accept_rejectMove(p_list, iel, in_range);
+
+      TrialWaveFunction::mw_evalGradSource(psi_list, p_list, ions, jat, ion_grads);
+      for (size_t iw = 0; iw < nw; iw++)
+      {
+        NonLocalECPComponent& component(ecp_component_list[iw]);
+        ion_grads[iw] *= component.psiratio[j];
+        convertToReal(ion_grads[iw], component.pulay_quad[j][jat]);
+        //And move the particle back.
+        displs[iw] = -displs[iw];
+      }
+
+      ParticleSet::mw_makeMove(p_list, iel, displs);
+      TrialWaveFunction::mw_calcRatio(psi_list, p_list, iel, ratios);
+      TrialWaveFunction::mw_accept_rejectMove(psi_list, p_list, iel, in_range);
+      ParticleSet::mw_accept_rejectMove(p_list, iel, in_range);
+    }
+  }
+
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    const NLPPJob<RealType>& job = joblist[iw];
+    if (in_range[iw])
+      pairpots[iw] = ecp_component_list[iw].assembleOneWithForces(job.ion_elec_dist, job.ion_elec_displ,
+                                                                  force_list[iw], pulay_list[iw]);
+    else
+      pairpots[iw] = 0;
+  }
+}
+
+void NonLocalECPComponent::prepareOneWithForces(int num_ions, RealType r, const PosType& dr)
+{
+  //We check that our quadrature grid is valid.  Namely, that all points lie on the unit sphere.
+  //We check this by seeing if |r|^2 = 1 to machine precision.
+  for (int j = 0; j < nknot; j++)
+    assert(std::abs(std::sqrt(dot(rrotsgrid_m[j], rrotsgrid_m[j])) - 1) <
+           100 * std::numeric_limits<RealType>::epsilon());
+
+  buildQuadraturePointDeltaPositions(r, dr, deltaV);
+
+  //resize everything. The scratch arrays are members so they are allocated once and not for every pair.
+  pulay_ref.resize(num_ions);
+  pulay_tmp.resize(num_ions);
+  pulay_quad.resize(nknot);
+  for (size_t j = 0; j < nknot; j++)
+    pulay_quad[j].resize(num_ions);
+}
+
+void NonLocalECPComponent::storeGradPsiRatio(int j, GradType grad)
+{
+  //QMCPACK spits out $\nabla\Psi(q)/\Psi(q)$.
+  //Multiply times $\Psi(q)/\Psi(r)$ to get
+  // $\nabla\Psi(q)/\Psi(r)
+  grad *= psiratio[j];
+#if defined(QMC_COMPLEX)
+  //And now we take the real part and save it.
+  convertToReal(grad, gradpsiratio[j]);
+#else
+  //Real nonlocalpp forces seem to differ from those in the complex build.  Since
+  //complex build has been validated against QE, that indicates there's a bug for the real build.
+  gradpsiratio[j] = grad;
+#endif
+}
+
+NonLocalECPComponent::RealType NonLocalECPComponent::assembleOneWithForces(RealType r,
+                                                                           const PosType& dr,
+                                                                           PosType& force_iat,
+                                                                           ParticleSet::ParticlePos& pulay_terms)
+{
+  constexpr RealType czero(0);
+  constexpr RealType cone(1);
+
+  //Pseudopotential derivative w.r.t. ions can be split up into 3 contributions:
+  // term coming from the gradient of the radial potential
+  PosType gradpotterm_(0);
+  // term coming from gradient of legendre polynomial
+  PosType gradlpolyterm_(0);
+  // term coming from dependence of quadrature grid on ion position.
+  PosType gradwfnterm_(0);
+
+  // This is just a temporary variable to dump d2/dr2 into for spline evaluation.
+  RealType secondderiv(0);
+
+  const RealType rinv = cone / r;
+
+  // Compute radial potential and its derivative times (2l+1)
+  for (int ip = 0; ip < nchannel; ip++)
+  {
+    //fun fact.  NLPComponent stores v(r) as v(r), and not as r*v(r) like in other places.
+    vrad[ip]  = nlpp_m[ip]->splint(r, dvrad[ip], secondderiv) * wgt_angpp_m[ip];
+    vgrad[ip] = dvrad[ip] * dr * wgt_angpp_m[ip] * rinv;
+  }
+
   RealType pairpot = 0;
   // Compute spherical harmonics on grid
   for (int j = 0; j < nknot; j++)
@@ -640,7 +753,7 @@ NonLocalECPComponent::RealType NonLocalECPComponent::evaluateOneWithForces(Parti
     gradpotterm_   = 0;
     gradlpolyterm_ = 0;
     gradwfnterm_   = 0;
-    pulaytmp_      = 0;
+    pulay_tmp      = 0;
 
     for (int l = 0; l < nchannel; l++)
     {
@@ -650,13 +763,13 @@ NonLocalECPComponent::RealType NonLocalECPComponent::evaluateOneWithForces(Parti
       gradpotterm_ += vgrad[l] * lpol[angpp_m[l]] * std::real(psiratio[j]);
       gradlpolyterm_ += vrad[l] * dlpol[angpp_m[l]] * cosgrad[j] * std::real(psiratio[j]);
       gradwfnterm_ += vrad[l] * lpol[angpp_m[l]] * wfngrad[j];
-      pulaytmp_ -= vrad[l] * lpol[angpp_m[l]] * pulay_quad[j];
+      pulay_tmp -= vrad[l] * lpol[angpp_m[l]] * pulay_quad[j];
     }
     knot_pots[j] = lsum * std::real(psiratio[j]);
-    pulaytmp_ += knot_pots[j] * pulay_ref;
+    pulay_tmp += knot_pots[j] * pulay_ref;
     pairpot += knot_pots[j];
     force_iat += gradpotterm_ + gradlpolyterm_ - gradwfnterm_;
-    pulay_terms += pulaytmp_;
+    pulay_terms += pulay_tmp;
   }
 
   return pairpot;
@@ -101,6 +101,12 @@ private:
   std::vector<PosType> wfngrad;
   //This stores potential contribution per knot:
   std::vector<RealType> knot_pots;
+  //$\nabla_I \Psi(...r...)/\Psi(...r...)$ for all the ions, scratch of evaluateOneWithForces
+  ParticleSet::ParticlePos pulay_ref;
+  //Pulay contribution of a quadrature point, scratch of evaluateOneWithForces
+  ParticleSet::ParticlePos pulay_tmp;
+  //$\nabla_I \Psi(...q...)/\Psi(...r...)$ for each quadrature point, scratch of evaluateOneWithForces
+  std::vector<ParticleSet::ParticlePos> pulay_quad;
 
   /// scratch spaces used by evaluateValueAndDerivatives
   Matrix<ValueType> dratio;
@@ -136,6 +142,20 @@ private:
    */
   void contributeTxy(int iel, std::vector<NonLocalData>& Txy) const;
 
+  /// set the quadrature point deltas and size the pulay scratch of evaluateOneWithForces for num_ions ions
+  void prepareOneWithForces(int num_ions, RealType r, const PosType& dr);
+
+  /// store $\nabla\Psi(q)/\Psi(r)$ of knot j from the gradient $\nabla\Psi(q)/\Psi(q)$ and psiratio[j]
+  void storeGradPsiRatio(int j, GradType grad);
+
+  /** finalize evaluateOneWithForces from the ratios and gradients of all the knots
+   * @return RealType Contribution to $\frac{V\Psi_T}{\Psi_T}$
+   */
+  RealType assembleOneWithForces(RealType r,
+                                 const PosType& dr,
+                                 PosType& force_iat,
+                                 ParticleSet::ParticlePos& pulay_terms);
+
 public:
   NonLocalECPComponent();
 
@@ -254,6 +274,30 @@ public:
                                  PosType& force_iat,
                                  ParticleSet::ParticlePos& pulay_terms);
 
+  /** @brief Evaluate the nonlocal pp energy, Hellman-Feynman force, and "Pulay" force contribution
+   * via randomized quadrature grid for a batch of walkers.
+   *
+   * @param ecp_component_list a list of ECP components
+   * @param p_list a list of electron particle set.
+   * @param psi_list a list of trial wave function object
+   * @param ions ion particle set.
+   * @param joblist a list of ion-electron pairs, all of them on the same electron
+   * @param pairpots a list of contribution to $\frac{V\Psi_T}{\Psi_T}$ from ion iat and electron iel.
+   * @param force_list a list of Hellman-Feynman contributions.  They get modified.
+   * @param pulay_list a list of Nion x 3 objects holding the contributions from \Psi_T.  They get modified.
+   *
+   * Note: the lists cover all the walkers holding the multi walker resources because the moves are accepted.
+   * The walkers with the electron beyond rmax keep it in place, get a zero pairpot and leave their forces unchanged.
+   */
+  static void mw_evaluateOneWithForces(const RefVectorWithLeader<NonLocalECPComponent>& ecp_component_list,
+                                       const RefVectorWithLeader<ParticleSet>& p_list,
+                                       const RefVectorWithLeader<TrialWaveFunction>& psi_list,
+                                       ParticleSet& ions,
+                                       const RefVector<const NLPPJob<RealType>>& joblist,
+                                       std::vector<RealType>& pairpots,
+                                       const RefVector<PosType>& force_list,
+                                       const RefVector<ParticleSet::ParticlePos>& pulay_list);
+
   // This function needs to be updated to SoA. myTableIndex is introduced temporarily.
   RealType evaluateValueAndDerivatives(ParticleSet& P,
                                        int iat,
@@ -465,6 +465,97 @@ void NonLocalECPotential::evaluateIonDerivs(ParticleSet& P,
   pulay_terms -= PulayTerm;
 }
 
+void NonLocalECPotential::mw_evaluateIonDerivs(const RefVectorWithLeader<OperatorBase>& o_list,
+                                               const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                               const RefVectorWithLeader<ParticleSet>& p_list,
+                                               ParticleSet& ions,
+                                               const RefVector<ParticleSet::ParticlePos>& hf_terms,
+                                               const RefVector<ParticleSet::ParticlePos>& pulay_terms) const
+{
+  auto& O_leader           = o_list.getCastedLeader<NonLocalECPotential>();
+  ParticleSet& pset_leader = p_list.getLeader();
+  const size_t nw          = o_list.size();
+
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    auto& O = o_list.getCastedElement<NonLocalECPotential>(iw);
+    // clear all the electron and ion neighbor lists
+    for (int iat = 0; iat < O.NumIons; iat++)
+      O.IonNeighborElecs.getNeighborList(iat).clear();
+    for (int jel = 0; jel < p_list[iw].getTotalNum(); jel++)
+      O.ElecNeighborIons.getNeighborList(jel).clear();
+    O.value_    = 0.0;
+    O.forces_   = 0;
+    O.PulayTerm = 0;
+  }
+
+  RefVector<const NLPPJob<Real>> batch_list;
+  RefVector<PosType> force_list;
+  RefVector<ParticleSet::ParticlePos> pulay_list;
+  std::vector<NLPPJob<Real>> jobs;
+  std::vector<Real> pairpots(nw);
+
+  batch_list.reserve(nw);
+  force_list.reserve(nw);
+  pulay_list.reserve(nw);
+  jobs.reserve(nw);
+
+  for (int ig = 0; ig < pset_leader.groups(); ++ig) //loop over species
+  {
+    TrialWaveFunction::mw_prepareGroup(wf_list, p_list, ig);
+    // the walkers of a batch move the same electron, the wavefunction updates are made electron by electron.
+    // The accepted moves need the whole crowd in the lists, out of range walkers just stay in place.
+    for (int jel = pset_leader.first(ig); jel < pset_leader.last(ig); ++jel)
+      for (int iat = 0; iat < O_leader.NumIons; iat++)
+      {
+        if (O_leader.PP[iat] == nullptr)
+          continue;
+        RefVectorWithLeader<NonLocalECPComponent> ecp_component_list(*O_leader.PP[iat]);
+        ecp_component_list.reserve(nw);
+        batch_list.clear();
+        force_list.clear();
+        pulay_list.clear();
+        jobs.clear();
+        bool any_in_range = false;
+        for (size_t iw = 0; iw < nw; iw++)
+        {
+          auto& O             = o_list.getCastedElement<NonLocalECPotential>(iw);
+          const auto& myTable = p_list[iw].getDistTableAB(O.myTableIndex);
+          const Real dist     = myTable.getDistRow(jel)[iat];
+          any_in_range        = any_in_range || dist < O.PP[iat]->getRmax();
+          ecp_component_list.push_back(*O.PP[iat]);
+          jobs.emplace_back(iat, jel, dist, -myTable.getDisplRow(jel)[iat]);
+          force_list.push_back(O.forces_[iat]);
+          pulay_list.push_back(O.PulayTerm);
+        }
+        if (!any_in_range)
+          continue;
+        // jobs no longer grows, the references stay valid
+        for (const auto& job : jobs)
+          batch_list.push_back(job);
+
+        NonLocalECPComponent::mw_evaluateOneWithForces(ecp_component_list, p_list, wf_list, ions, batch_list, pairpots,
+                                                       force_list, pulay_list);
+
+        for (size_t iw = 0; iw < nw; iw++)
+          if (jobs[iw].ion_elec_dist < ecp_component_list[iw].getRmax())
+          {
+            auto& O = o_list.getCastedElement<NonLocalECPotential>(iw);
+            O.value_ += pairpots[iw];
+            O.ElecNeighborIons.getNeighborList(jel).push_back(iat);
+            O.IonNeighborElecs.getNeighborList(iat).push_back(jel);
+          }
+      }
+  }
+
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    const auto& O = o_list.getCastedElement<NonLocalECPotential>(iw);
+    hf_terms[iw].get() -= O.forces_;
+    pulay_terms[iw].get() -= O.PulayTerm;
+  }
+}
+
 void NonLocalECPotential::computeOneElectronTxy(ParticleSet& P, const int ref_elec, std::vector<NonLocalData>& tmove_xy)
 {
   tmove_xy.clear();
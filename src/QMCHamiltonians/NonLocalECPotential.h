@@ -87,6 +87,15 @@ public:
                          ParticleSet::ParticlePos& hf_terms,
                          ParticleSet::ParticlePos& pulay_terms) override;
 
+  /** batched evaluateIonDerivs, the ion-electron pairs of all the walkers are evaluated together
+   */
+  void mw_evaluateIonDerivs(const RefVectorWithLeader<OperatorBase>& o_list,
+                            const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                            const RefVectorWithLeader<ParticleSet>& p_list,
+                            ParticleSet& ions,
+                            const RefVector<ParticleSet::ParticlePos>& hf_terms,
+                            const RefVector<ParticleSet::ParticlePos>& pulay_terms) const override;
+
   void evaluateOneBodyOpMatrix(ParticleSet& P, const TWFFastDerivWrapper& psi, std::vector<ValueMatrix>& B) override;
 
   void evaluateOneBodyOpMatrixForceDeriv(ParticleSet& P,
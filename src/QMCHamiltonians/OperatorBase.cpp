@@ -185,6 +185,18 @@ void OperatorBase::evaluateIonDerivs(ParticleSet& P,
                                      ParticleSet::ParticlePos& pulay_term)
 {}
 
+void OperatorBase::mw_evaluateIonDerivs(const RefVectorWithLeader<OperatorBase>& o_list,
+                                        const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                        const RefVectorWithLeader<ParticleSet>& p_list,
+                                        ParticleSet& ions,
+                                        const RefVector<ParticleSet::ParticlePos>& hf_terms,
+                                        const RefVector<ParticleSet::ParticlePos>& pulay_terms) const
+{
+  assert(this == &o_list.getLeader());
+  for (int iw = 0; iw < o_list.size(); iw++)
+    o_list[iw].evaluateIonDerivs(p_list[iw], ions, wf_list[iw], hf_terms[iw], pulay_terms[iw]);
+}
+
 void OperatorBase::updateSource(ParticleSet& s) {}
 
 OperatorBase::Return_t OperatorBase::getEnsembleAverage() { return 0.0; }
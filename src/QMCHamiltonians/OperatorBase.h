@@ -360,6 +360,24 @@ public:
                                  ParticleSet::ParticlePos& hf_term,
                                  ParticleSet::ParticlePos& pulay_term);
 
+  /** 
+   * @brief batched version of evaluateIonDerivs.
+   * The default implementation loops over the walkers.
+
+   * @param o_list the list of the same OperatorBase component of a walker batch
+   * @param wf_list the list of TrialWaveFunction of a walker batch
+   * @param p_list the list of target particle sets (electrons)
+   * @param ions source particle set (ions)
+   * @param hf_terms  Adds OperatorBase's contribution to Re [(dH)Psi]/Psi of each walker
+   * @param pulay_terms Adds OperatorBase's contribution to Re [(H-E_L)dPsi]/Psi of each walker
+   */
+  virtual void mw_evaluateIonDerivs(const RefVectorWithLeader<OperatorBase>& o_list,
+                                    const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                    const RefVectorWithLeader<ParticleSet>& p_list,
+                                    ParticleSet& ions,
+                                    const RefVector<ParticleSet::ParticlePos>& hf_terms,
+                                    const RefVector<ParticleSet::ParticlePos>& pulay_terms) const;
+
   /** 
    * @brief Evaluate "B" matrix for observable.  Filippi scheme for computing fast derivatives.
 
@@ -585,6 +585,16 @@ std::vector<QMCHamiltonian::FullPrecRealType> QMCHamiltonian::mw_evaluate(
     const RefVectorWithLeader<QMCHamiltonian>& ham_list,
     const RefVectorWithLeader<TrialWaveFunction>& wf_list,
     const RefVectorWithLeader<ParticleSet>& p_list)
+{
+  std::vector<FullPrecRealType> local_energies;
+  mw_evaluate(ham_list, wf_list, p_list, local_energies);
+  return local_energies;
+}
+
+void QMCHamiltonian::mw_evaluate(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                 const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                 const RefVectorWithLeader<ParticleSet>& p_list,
+                                 std::vector<FullPrecRealType>& local_energies)
 {
   auto& ham_leader = ham_list.getLeader();
   ScopedTimer local_timer(ham_leader.ham_timer_);
@@ -627,11 +637,9 @@ std::vector<QMCHamiltonian::FullPrecRealType> QMCHamiltonian::mw_evaluate(
   for (int iw = 0; iw < ham_list.size(); iw++)
     updateKinetic(ham_list[iw], p_list[iw]);
 
-  std::vector<FullPrecRealType> local_energies(ham_list.size(), 0.0);
+  local_energies.resize(ham_list.size());
   for (int iw = 0; iw < ham_list.size(); ++iw)
     local_energies[iw] = ham_list[iw].getLocalEnergy();
-
-  return local_energies;
 }
 
 QMCHamiltonian::FullPrecRealType QMCHamiltonian::evaluateValueAndDerivatives(ParticleSet& P,
@@ -739,6 +747,34 @@ void QMCHamiltonian::auxHevaluate(ParticleSet& P, Walker_t& ThisWalker)
     auxH[i]->setParticlePropertyList(P.PropertyList, myIndex);
   }
 }
+
+void QMCHamiltonian::mw_auxHevaluate(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                     const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                     const RefVectorWithLeader<ParticleSet>& p_list,
+                                     const RefVector<Walker_t>& walkers)
+{
+  auto& ham_leader = ham_list.getLeader();
+#if !defined(REMOVE_TRACEMANAGER)
+  for (int iw = 0; iw < ham_list.size(); iw++)
+    ham_list[iw].collect_walker_traces(walkers[iw], p_list[iw].current_step);
+#endif
+  for (int i_aux = 0; i_aux < ham_leader.auxH.size(); ++i_aux)
+  {
+    const auto auxHC_list(extract_auxHC_list(ham_list, i_aux));
+    for (int iw = 0; iw < ham_list.size(); iw++)
+      auxHC_list[iw].setHistories(walkers[iw]);
+    ham_leader.auxH[i_aux]->mw_evaluate(auxHC_list, wf_list, p_list);
+    for (int iw = 0; iw < ham_list.size(); iw++)
+    {
+      QMCHamiltonian& ham = ham_list[iw];
+      auxHC_list[iw].setObservables(ham.Observables);
+#if !defined(REMOVE_TRACEMANAGER)
+      auxHC_list[iw].collectScalarTraces();
+#endif
+      auxHC_list[iw].setParticlePropertyList(p_list[iw].PropertyList, ham.myIndex);
+    }
+  }
+}
 ///Evaluate properties only.
 void QMCHamiltonian::auxHevaluate(ParticleSet& P, Walker_t& ThisWalker, bool do_properties, bool do_collectables)
 {
@@ -802,6 +838,16 @@ std::vector<QMCHamiltonian::FullPrecRealType> QMCHamiltonian::mw_evaluateWithTop
     const RefVectorWithLeader<QMCHamiltonian>& ham_list,
     const RefVectorWithLeader<TrialWaveFunction>& wf_list,
     const RefVectorWithLeader<ParticleSet>& p_list)
+{
+  std::vector<FullPrecRealType> local_energies;
+  mw_evaluateWithToperator(ham_list, wf_list, p_list, local_energies);
+  return local_energies;
+}
+
+void QMCHamiltonian::mw_evaluateWithToperator(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                              const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                              const RefVectorWithLeader<ParticleSet>& p_list,
+                                              std::vector<FullPrecRealType>& local_energies)
 {
   for (QMCHamiltonian& ham : ham_list)
     ham.LocalEnergy = 0.0;
@@ -842,11 +888,9 @@ std::vector<QMCHamiltonian::FullPrecRealType> QMCHamiltonian::mw_evaluateWithTop
   for (int iw = 0; iw < ham_list.size(); iw++)
     updateKinetic(ham_list[iw], p_list[iw]);
 
-  std::vector<FullPrecRealType> local_energies(ham_list.size());
+  local_energies.resize(ham_list.size());
   for (int iw = 0; iw < ham_list.size(); ++iw)
     local_energies[iw] = ham_list[iw].getLocalEnergy();
-
-  return local_energies;
 }
 void QMCHamiltonian::evaluateElecGrad(ParticleSet& P,
                                       TrialWaveFunction& psi,
@@ -906,6 +950,30 @@ void QMCHamiltonian::evaluateIonDerivs(ParticleSet& P,
   }
 }
 
+void QMCHamiltonian::mw_evaluateIonDerivs(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                          const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                          const RefVectorWithLeader<ParticleSet>& p_list,
+                                          ParticleSet& ions,
+                                          const RefVector<ParticleSet::ParticlePos>& hf_terms,
+                                          const RefVector<ParticleSet::ParticlePos>& pulay_terms,
+                                          const RefVector<ParticleSet::ParticlePos>& wf_grads)
+{
+  auto& ham_leader = ham_list.getLeader();
+  for (int i_ham_op = 0; i_ham_op < ham_leader.H.size(); ++i_ham_op)
+  {
+    const auto HC_list(extract_HC_list(ham_list, i_ham_op));
+    ham_leader.H[i_ham_op]->mw_evaluateIonDerivs(HC_list, wf_list, p_list, ions, hf_terms, pulay_terms);
+  }
+
+  std::vector<TrialWaveFunction::GradType> wfgradraw(ham_list.size());
+  for (int iat = 0; iat < ions.getTotalNum(); iat++)
+  {
+    TrialWaveFunction::mw_evalGradSource(wf_list, p_list, ions, iat, wfgradraw);
+    for (int iw = 0; iw < ham_list.size(); iw++)
+      convertToReal(wfgradraw[iw], wf_grads[iw].get()[iat]);
+  }
+}
+
 QMCHamiltonian::FullPrecRealType QMCHamiltonian::getEnsembleAverage()
 {
   FullPrecRealType sum = 0.0;
@@ -981,6 +1049,8 @@ void QMCHamiltonian::createResource(ResourceCollection& collection) const
   auto resource_index = collection.addResource(std::make_unique<QMCHamiltonianMultiWalkerResource>());
   for (int i = 0; i < H.size(); ++i)
     H[i]->createResource(collection);
+  for (int i = 0; i < auxH.size(); ++i)
+    auxH[i]->createResource(collection);
 }
 
 void QMCHamiltonian::acquireResource(ResourceCollection& collection,
@@ -993,6 +1063,11 @@ void QMCHamiltonian::acquireResource(ResourceCollection& collection,
     const auto HC_list(extract_HC_list(ham_list, i_ham_op));
     ham_leader.H[i_ham_op]->acquireResource(collection, HC_list);
   }
+  for (int i_aux = 0; i_aux < ham_leader.auxH.size(); ++i_aux)
+  {
+    const auto auxHC_list(extract_auxHC_list(ham_list, i_aux));
+    ham_leader.auxH[i_aux]->acquireResource(collection, auxHC_list);
+  }
 }
 
 void QMCHamiltonian::releaseResource(ResourceCollection& collection,
@@ -1005,6 +1080,11 @@ void QMCHamiltonian::releaseResource(ResourceCollection& collection,
     const auto HC_list(extract_HC_list(ham_list, i_ham_op));
     ham_leader.H[i_ham_op]->releaseResource(collection, HC_list);
   }
+  for (int i_aux = 0; i_aux < ham_leader.auxH.size(); ++i_aux)
+  {
+    const auto auxHC_list(extract_auxHC_list(ham_list, i_aux));
+    ham_leader.auxH[i_aux]->releaseResource(collection, auxHC_list);
+  }
 }
 
 std::unique_ptr<QMCHamiltonian> QMCHamiltonian::makeClone(ParticleSet& qp, TrialWaveFunction& psi) const
@@ -1038,6 +1118,17 @@ RefVectorWithLeader<OperatorBase> QMCHamiltonian::extract_HC_list(const RefVecto
   return HC_list;
 }
 
+RefVectorWithLeader<OperatorBase> QMCHamiltonian::extract_auxHC_list(
+    const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+    int id)
+{
+  RefVectorWithLeader<OperatorBase> auxHC_list(*ham_list.getLeader().auxH[id]);
+  auxHC_list.reserve(ham_list.size());
+  for (QMCHamiltonian& H : ham_list)
+    auxHC_list.push_back(*(H.auxH[id]));
+  return auxHC_list;
+}
+
 void QMCHamiltonian::evaluateIonDerivsFast(ParticleSet& P,
                                            ParticleSet& ions,
                                            TrialWaveFunction& psi_in,
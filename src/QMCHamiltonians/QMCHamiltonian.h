@@ -218,6 +218,13 @@ public:
   void auxHevaluate(ParticleSet& P);
   void auxHevaluate(ParticleSet& P, Walker_t& ThisWalker);
   void auxHevaluate(ParticleSet& P, Walker_t& ThisWalker, bool do_properties, bool do_collectables);
+  /** batched version of auxHevaluate(P, ThisWalker)
+   *  each auxiliary operator is evaluated for the whole walker batch by its mw_evaluate.
+   */
+  static void mw_auxHevaluate(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                              const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                              const RefVectorWithLeader<ParticleSet>& p_list,
+                              const RefVector<Walker_t>& walkers);
   void rejectedMove(ParticleSet& P, Walker_t& ThisWalker);
 
   /** set PRIMARY bit of all the components
@@ -254,6 +261,14 @@ public:
       const RefVectorWithLeader<TrialWaveFunction>& wf_list,
       const RefVectorWithLeader<ParticleSet>& p_list);
 
+  /** batched evaluate writing the local energies into a caller owned vector
+   * @param local_energies resized to the number of walkers
+   */
+  static void mw_evaluate(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                          const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                          const RefVectorWithLeader<ParticleSet>& p_list,
+                          std::vector<FullPrecRealType>& local_energies);
+
   /** evaluate Local energy with Toperators updated.
    * @param P ParticleSEt
    * @return Local energy
@@ -267,6 +282,14 @@ public:
       const RefVectorWithLeader<TrialWaveFunction>& wf_list,
       const RefVectorWithLeader<ParticleSet>& p_list);
 
+  /** batched evaluateWithToperator writing the local energies into a caller owned vector
+   * @param local_energies resized to the number of walkers
+   */
+  static void mw_evaluateWithToperator(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                       const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                       const RefVectorWithLeader<ParticleSet>& p_list,
+                                       std::vector<FullPrecRealType>& local_energies);
+
 
   /** evaluate energy and derivatives wrt to the variables
    * @param P ParticleSet
@@ -328,6 +351,21 @@ public:
                          ParticleSet::ParticlePos& pulay_terms,
                          ParticleSet::ParticlePos& wf_grad);
 
+  /** batched version of evaluateIonDerivs.
+  * The ion derivatives of every physical operator and the ion gradients of the wavefunction
+  * are evaluated for the whole walker batch.
+  * @param hf_terms  Re [(dH)Psi]/Psi of each walker
+  * @param pulay_terms Re [(H-E_L)dPsi]/Psi of each walker
+  * @param wf_grads  Re (dPsi/Psi) of each walker
+  */
+  static void mw_evaluateIonDerivs(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                   const RefVectorWithLeader<ParticleSet>& p_list,
+                                   ParticleSet& ions,
+                                   const RefVector<ParticleSet::ParticlePos>& hf_terms,
+                                   const RefVector<ParticleSet::ParticlePos>& pulay_terms,
+                                   const RefVector<ParticleSet::ParticlePos>& wf_grads);
+
   /** make non local moves
    * @param P particle set
    * @return the number of accepted moves
@@ -449,6 +487,9 @@ private:
   void reportToListeners();
   // helper function for extracting a list of Hamiltonian components from a list of QMCHamiltonian::H.
   static RefVectorWithLeader<OperatorBase> extract_HC_list(const RefVectorWithLeader<QMCHamiltonian>& ham_list, int id);
+  // helper function for extracting a list of Hamiltonian components from a list of QMCHamiltonian::auxH.
+  static RefVectorWithLeader<OperatorBase> extract_auxHC_list(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
+                                                              int id);
 
 #if !defined(REMOVE_TRACEMANAGER)
   ///traces variables
@@ -0,0 +1,112 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <ResourceCollection.h>
+#include "Particle/ParticleSet.h"
+#include "QMCHamiltonians/MPC.h"
+#include "QMCWaveFunctions/TrialWaveFunction.h"
+#include "Utilities/RuntimeOptions.h"
+
+namespace qmcplusplus
+{
+namespace
+{
+/// four electrons in a periodic cubic cell with a density made of a few G-vectors
+void makeElectrons(ParticleSet& elec)
+{
+  elec.setName("e");
+  elec.create({2, 2});
+  elec.R[0]                  = {0.5, 0.1, 0.2};
+  elec.R[1]                  = {2.3, 1.4, 3.1};
+  elec.R[2]                  = {4.1, 3.6, 0.7};
+  elec.R[3]                  = {1.2, 4.3, 2.9};
+  SpeciesSet& elec_species   = elec.getSpeciesSet();
+  const int up               = elec_species.addSpecies("u");
+  const int down             = elec_species.addSpecies("d");
+  const int charge           = elec_species.addAttribute("charge");
+  elec_species(charge, up)   = -1;
+  elec_species(charge, down) = -1;
+  elec.resetGroups();
+
+  // rho(-G) is the conjugate of rho(G) to have a real density
+  using Gvec = TinyVector<int, OHMMS_DIM>;
+  const std::vector<std::pair<Gvec, ParticleSet::ComplexType>> rho{{Gvec(1, 0, 0), {0.004, 0.002}},
+                                                                   {Gvec(0, 1, 0), {-0.003, 0.001}},
+                                                                   {Gvec(0, 0, 1), {0.002, -0.004}},
+                                                                   {Gvec(1, 1, 0), {0.001, 0.003}}};
+  elec.DensityReducedGvecs.push_back(Gvec(0));
+  elec.Density_G.push_back(elec.getTotalNum() / elec.getLattice().Volume);
+  for (const auto& [g, rho_g] : rho)
+  {
+    elec.DensityReducedGvecs.push_back(g);
+    elec.Density_G.push_back(rho_g);
+    elec.DensityReducedGvecs.push_back(-g);
+    elec.Density_G.push_back(std::conj(rho_g));
+  }
+}
+
+/** the batched evaluation of two walkers matches the single walker evaluation
+ * @return the values of both walkers
+ */
+std::array<double, 2> testMWEvaluate(ParticleSet& elec, bool use_single, double tol)
+{
+  MPC mpc(elec, 30.0, use_single);
+  // copied after the construction of MPC to have its AA table
+  ParticleSet elec2(elec);
+  elec2.R[1] = {3.7, 0.2, 4.4};
+  elec2.R[2] = {-0.6, 2.5, 1.8};
+  elec.update();
+  elec2.update();
+
+  RuntimeOptions runtime_options;
+  TrialWaveFunction psi(runtime_options);
+  TrialWaveFunction psi2(runtime_options);
+  auto mpc2 = mpc.makeClone(elec2, psi2);
+
+  std::array<double, 2> ref{mpc.evaluate(elec), mpc2->evaluate(elec2)};
+  // the single walker evaluation gives the same value on repeated calls
+  CHECK(mpc.evaluate(elec) == ref[0]);
+
+  RefVectorWithLeader<OperatorBase> o_list(mpc, {mpc, *mpc2});
+  RefVectorWithLeader<TrialWaveFunction> twf_list(psi, {psi, psi2});
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec2});
+  ResourceCollection op_res("test_op_res");
+  mpc.createResource(op_res);
+  ResourceCollectionTeamLock<OperatorBase> mpc_lock(op_res, o_list);
+
+  mpc.mw_evaluate(o_list, twf_list, p_list);
+  for (int iw = 0; iw < 2; iw++)
+    CHECK(o_list[iw].getValue() == Approx(ref[iw]).epsilon(tol));
+  CHECK(ref[0] != Approx(ref[1]));
+  return ref;
+}
+} // namespace
+
+TEST_CASE("MPC::mw_evaluate", "[hamiltonian]")
+{
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> lattice;
+  lattice.BoxBConds = true; // periodic
+  lattice.R.diagonal(5.0);
+  lattice.reset();
+  const SimulationCell simulation_cell(lattice);
+  ParticleSet elec(simulation_cell);
+  makeElectrons(elec);
+
+  const auto ref_double = testMWEvaluate(elec, false, 1e-12);
+  const auto ref_single = testMWEvaluate(elec, true, 1e-7);
+  // the single precision table is rounded from the double precision one, about 4e-7 relative here
+  for (int iw = 0; iw < 2; iw++)
+    CHECK(ref_single[iw] == Approx(ref_double[iw]).epsilon(1e-6));
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,153 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+#include <ResourceCollection.h>
+#include "OhmmsPETE/OhmmsMatrix.h"
+#include "Particle/ParticleSet.h"
+#include "QMCHamiltonians/CoulombPotential.h"
+#include "QMCWaveFunctions/TrialWaveFunction.h"
+#include "TestListenerFunction.h"
+#include "Utilities/RuntimeOptions.h"
+#include <numeric>
+
+namespace qmcplusplus
+{
+using Real = QMCTraits::RealType;
+
+namespace
+{
+/// reference pair sum over distinct pairs
+double pairSum(const ParticleSet& a, const ParticleSet& b, bool same)
+{
+  double res = 0.0;
+  for (int i = 0; i < b.getTotalNum(); i++)
+    for (int j = 0; j < (same ? i : a.getTotalNum()); j++)
+      res += a.Z[j] * b.Z[i] / std::sqrt(dot(a.R[j] - b.R[i], a.R[j] - b.R[i]));
+  return res;
+}
+
+void makeMolecule(ParticleSet& ions, ParticleSet& elec)
+{
+  ions.setName("ion0");
+  ions.create({1, 1});
+  ions.R[0]                   = {0.0, 0.0, 0.0};
+  ions.R[1]                   = {0.0, 0.0, 1.4};
+  SpeciesSet& ion_species     = ions.getSpeciesSet();
+  const int li                = ion_species.addSpecies("Li");
+  const int h                 = ion_species.addSpecies("H");
+  const int ion_charge        = ion_species.addAttribute("charge");
+  ion_species(ion_charge, li) = 3;
+  ion_species(ion_charge, h)  = 1;
+  ions.resetGroups();
+
+  elec.setName("e");
+  elec.create({2, 2});
+  elec.R[0]                  = {0.5, 0.1, 0.2};
+  elec.R[1]                  = {-0.3, 0.4, 1.1};
+  elec.R[2]                  = {0.1, -0.6, 0.7};
+  elec.R[3]                  = {0.2, 0.3, 1.9};
+  SpeciesSet& elec_species   = elec.getSpeciesSet();
+  const int up               = elec_species.addSpecies("u");
+  const int down             = elec_species.addSpecies("d");
+  const int charge           = elec_species.addAttribute("charge");
+  const int mass             = elec_species.addAttribute("mass");
+  elec_species(charge, up)   = -1;
+  elec_species(charge, down) = -1;
+  elec_species(mass, up)     = 1;
+  elec_species(mass, down)   = 1;
+  elec.resetGroups();
+}
+} // namespace
+
+TEST_CASE("CoulombPotential::mw_evaluatePerParticle", "[hamiltonian]")
+{
+  using testing::getParticularListener;
+  const SimulationCell simulation_cell;
+  ParticleSet ions(simulation_cell);
+  ParticleSet elec(simulation_cell);
+  makeMolecule(ions, elec);
+
+  RuntimeOptions runtime_options;
+  TrialWaveFunction psi(runtime_options);
+  TrialWaveFunction psi2(runtime_options);
+
+  CoulombPotential<OperatorBase::Return_t> caa(elec, true, false);
+  CoulombPotential<OperatorBase::Return_t> cab(ions, elec, true);
+  CoulombPotential<OperatorBase::Return_t> cii(ions, false, false);
+  CHECK(caa.uniform_charge_);
+  CHECK(!cii.uniform_charge_);
+  CHECK(cii.getValue() == Approx(pairSum(ions, ions, true)));
+
+  ParticleSet elec2(elec);
+  elec2.R[1] = {0.7, -0.2, 0.9};
+  elec2.R[3] = {-0.4, 0.1, 2.3};
+  CoulombPotential<OperatorBase::Return_t> caa2(elec2, true, false);
+  CoulombPotential<OperatorBase::Return_t> cab2(ions, elec2, true);
+
+  RefVector<ParticleSet> ptcls{elec, elec2};
+  RefVectorWithLeader<ParticleSet> p_list(elec, ptcls);
+  RefVectorWithLeader<TrialWaveFunction> twf_list(psi, {psi, psi2});
+  ResourceCollection pset_res("test_pset_res");
+  elec.createResource(pset_res);
+  ResourceCollectionTeamLock<ParticleSet> pset_lock(pset_res, p_list);
+  ParticleSet::mw_update(p_list);
+
+  const double ref_aa[2] = {pairSum(elec, elec, true), pairSum(elec2, elec2, true)};
+  const double ref_ab[2] = {pairSum(ions, elec, false), pairSum(ions, elec2, false)};
+
+  RefVectorWithLeader<OperatorBase> aa_list(caa, {caa, caa2});
+  RefVectorWithLeader<OperatorBase> ab_list(cab, {cab, cab2});
+  ResourceCollection op_res("test_op_res");
+  caa.createResource(op_res);
+  cab.createResource(op_res);
+  ResourceCollectionTeamLock<OperatorBase> aa_lock(op_res, aa_list);
+  ResourceCollectionTeamLock<OperatorBase> ab_lock(op_res, ab_list);
+
+  caa.mw_evaluate(aa_list, twf_list, p_list);
+  cab.mw_evaluate(ab_list, twf_list, p_list);
+  CHECK(caa.getValue() == Approx(ref_aa[0]));
+  CHECK(caa2.getValue() == Approx(ref_aa[1]));
+  CHECK(cab.getValue() == Approx(ref_ab[0]));
+  CHECK(cab2.getValue() == Approx(ref_ab[1]));
+  // the batched values match the single walker evaluation
+  CHECK(caa2.evaluate(elec2) == Approx(ref_aa[1]));
+  CHECK(cab2.evaluate(elec2) == Approx(ref_ab[1]));
+
+  Matrix<Real> elec_pots(2, elec.getTotalNum());
+  Matrix<Real> ion_pots(2, ions.getTotalNum());
+  std::fill(ion_pots.begin(), ion_pots.end(), 0.0);
+  std::vector<ListenerVector<Real>> listeners;
+  listeners.emplace_back("potential", getParticularListener(elec_pots));
+  std::vector<ListenerVector<Real>> ion_listeners;
+  ion_listeners.emplace_back("potential", getParticularListener(ion_pots));
+
+  caa.mw_evaluatePerParticle(aa_list, twf_list, p_list, listeners, ion_listeners);
+  for (int iw = 0; iw < 2; iw++)
+  {
+    CHECK(aa_list[iw].getValue() == Approx(ref_aa[iw]));
+    CHECK(std::accumulate(elec_pots[iw], elec_pots[iw] + elec_pots.cols(), 0.0) == Approx(ref_aa[iw]));
+  }
+  // the AA potential is not reported to the ions
+  CHECK(std::all_of(ion_pots.begin(), ion_pots.end(), [](Real v) { return v == 0; }));
+
+  cab.mw_evaluatePerParticle(ab_list, twf_list, p_list, listeners, ion_listeners);
+  for (int iw = 0; iw < 2; iw++)
+  {
+    CHECK(ab_list[iw].getValue() == Approx(ref_ab[iw]));
+    // each side holds half of every pair
+    CHECK(std::accumulate(elec_pots[iw], elec_pots[iw] + elec_pots.cols(), 0.0) == Approx(0.5 * ref_ab[iw]));
+    CHECK(std::accumulate(ion_pots[iw], ion_pots[iw] + ion_pots.cols(), 0.0) == Approx(0.5 * ref_ab[iw]));
+  }
+}
+
+} // namespace qmcplusplus
@@ -83,6 +83,62 @@ TEST_CASE("Bare Force", "[hamiltonian]")
   CHECK(force.getForces()[0][2] == Approx(0.0));
 }
 
+TEST_CASE("Bare Force batched", "[hamiltonian]")
+{
+  const SimulationCell simulation_cell;
+  ParticleSet ions(simulation_cell);
+  ParticleSet elec(simulation_cell);
+
+  ions.setName("ion");
+  ions.create({1});
+  ions.R[0] = {0.0, 0.0, 0.0};
+  elec.setName("elec");
+  elec.create({2});
+  elec.R[0]                   = {0.0, 1.0, 0.0};
+  elec.R[1]                   = {0.4, 0.3, 0.0};
+  SpeciesSet& tspecies        = elec.getSpeciesSet();
+  int upIdx                   = tspecies.addSpecies("u");
+  int massIdx                 = tspecies.addAttribute("mass");
+  int eChargeIdx              = tspecies.addAttribute("charge");
+  tspecies(eChargeIdx, upIdx) = -1.0;
+  tspecies(massIdx, upIdx)    = 1.0;
+  elec.resetGroups();
+
+  SpeciesSet& ion_species       = ions.getSpeciesSet();
+  int pIdx                      = ion_species.addSpecies("H");
+  int pChargeIdx                = ion_species.addAttribute("charge");
+  ion_species(pChargeIdx, pIdx) = 1;
+  ions.resetGroups();
+  ions.update();
+
+  elec.addTable(ions);
+  ParticleSet elec2(elec);
+  elec2.R[1] = {0.2, -0.5, 0.1};
+  elec.update();
+  elec2.update();
+
+  RuntimeOptions runtime_options;
+  TrialWaveFunction psi(runtime_options);
+  BareForce force(ions, elec);
+  force.setAddIonIon(false);
+  std::unique_ptr<OperatorBase> force2_ptr = force.makeClone(elec2, psi);
+  BareForce& force2                        = dynamic_cast<BareForce&>(*force2_ptr);
+
+  RefVectorWithLeader<OperatorBase> o_list(force, {force, force2});
+  RefVectorWithLeader<TrialWaveFunction> wf_list(psi, {psi, psi});
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec2});
+  force.mw_evaluate(o_list, wf_list, p_list);
+  const auto mw_forces  = force.getForces();
+  const auto mw_forces2 = force2.getForces();
+
+  CHECK(mw_forces[0][0] == Approx(3.2));
+  CHECK(mw_forces[0][1] == Approx(3.4));
+  CHECK(mw_forces[0][2] == Approx(0.0));
+  force2.evaluate(elec2);
+  for (int idim = 0; idim < OHMMS_DIM; idim++)
+    CHECK(mw_forces2[0][idim] == Approx(force2.getForces()[0][idim]));
+}
+
 void check_force_copy(ForceChiesaPBCAA& force, ForceChiesaPBCAA& force2)
 {
   CHECK(force2.Rcut == Approx(force.Rcut));
@@ -251,6 +307,79 @@ TEST_CASE("Chiesa Force", "[hamiltonian]")
   check_force_copy(*force2, force);
 }
 
+TEST_CASE("Chiesa Force batched", "[hamiltonian]")
+{
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> lattice;
+  lattice.BoxBConds = true; // periodic
+  lattice.R.diagonal(5.0);
+  lattice.LR_dim_cutoff = 25;
+  lattice.reset();
+  LRCoulombSingleton::this_lr_type = LRCoulombSingleton::EWALD;
+
+  const SimulationCell simulation_cell(lattice);
+  ParticleSet ions(simulation_cell);
+  ParticleSet elec(simulation_cell);
+
+  ions.setName("ion");
+  ions.create({2});
+  ions.R[0] = {0.0, 0.0, 0.0};
+  ions.R[1] = {2.0, 0.0, 0.0};
+  elec.setName("elec");
+  elec.create({1, 1});
+  elec.R[0]                     = {0.0, 1.0, 0.0};
+  elec.R[1]                     = {0.4, 0.3, 0.0};
+  SpeciesSet& tspecies          = elec.getSpeciesSet();
+  int upIdx                     = tspecies.addSpecies("u");
+  int downIdx                   = tspecies.addSpecies("d");
+  int massIdx                   = tspecies.addAttribute("mass");
+  int eChargeIdx                = tspecies.addAttribute("charge");
+  tspecies(eChargeIdx, upIdx)   = -1.0;
+  tspecies(eChargeIdx, downIdx) = -1.0;
+  tspecies(massIdx, upIdx)      = 1.0;
+  tspecies(massIdx, downIdx)    = 1.0;
+
+  elec.createSK();
+
+  SpeciesSet& ion_species       = ions.getSpeciesSet();
+  int pIdx                      = ion_species.addSpecies("H");
+  int pChargeIdx                = ion_species.addAttribute("charge");
+  ion_species(pChargeIdx, pIdx) = 1;
+  ions.createSK();
+
+  ions.resetGroups();
+  elec.resetGroups();
+
+  RuntimeOptions runtime_options;
+  TrialWaveFunction psi(runtime_options);
+  ForceChiesaPBCAA force(ions, elec);
+  force.setAddIonIon(true);
+  force.InitMatrix();
+
+  ParticleSet elec2(elec);
+  std::unique_ptr<OperatorBase> force2_ptr = force.makeClone(elec2, psi);
+  ForceChiesaPBCAA& force2                 = dynamic_cast<ForceChiesaPBCAA&>(*force2_ptr);
+  elec2.R[0] = {1.2, -0.3, 0.5};
+  elec2.R[1] = {3.1, 2.2, 4.0};
+  elec.update();
+  elec2.update();
+
+  RefVectorWithLeader<OperatorBase> o_list(force, {force, force2});
+  RefVectorWithLeader<TrialWaveFunction> wf_list(psi, {psi, psi});
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec2});
+  force.mw_evaluate(o_list, wf_list, p_list);
+  const auto mw_forces  = force.getForces();
+  const auto mw_forces2 = force2.getForces();
+
+  force.evaluate(elec);
+  force2.evaluate(elec2);
+  for (int iat = 0; iat < ions.getTotalNum(); iat++)
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+    {
+      CHECK(mw_forces[iat][idim] == Approx(force.getForces()[iat][idim]));
+      CHECK(mw_forces2[iat][idim] == Approx(force2.getForces()[iat][idim]));
+    }
+}
+
 // Open BC case
 TEST_CASE("Ceperley Force", "[hamiltonian]")
 {
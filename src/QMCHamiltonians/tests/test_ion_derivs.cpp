@@ -12,9 +12,15 @@
 
 #include "catch.hpp"
 
+#include <fstream>
+#include <sstream>
+#include <ResourceCollection.h>
 #include "type_traits/template_types.hpp"
 #include "type_traits/ConvertToReal.h"
 #include "QMCHamiltonians/QMCHamiltonian.h"
+#include "QMCHamiltonians/ACForce.h"
+#include "QMCHamiltonians/Hdispatcher.h"
+#include "QMCWaveFunctions/TWFdispatcher.h"
 #include "Particle/tests/MinimalParticlePool.h"
 #include "QMCWaveFunctions/tests/MinimalWaveFunctionPool.h"
 #include "QMCHamiltonians/tests/MinimalHamiltonianPool.h"
@@ -319,6 +325,269 @@ TEST_CASE("Eloc_Derivatives:slater_noj", "[hamiltonian]")
   CHECK(dot(wf_grad[1], wf_grad[1]) != Approx(0));
 }
 
+TEST_CASE("ACForce batched", "[hamiltonian]")
+{
+  using RealType = QMCTraits::RealType;
+
+  Communicate* c = OHMMS::Controller;
+
+  const SimulationCell simulation_cell;
+  auto ions_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto elec_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto &ions(*ions_ptr), elec(*elec_ptr);
+
+  create_CN_particlesets(elec, ions);
+
+  HamiltonianFactory::PSetMap particle_set_map;
+  particle_set_map.emplace("e", std::move(elec_ptr));
+  particle_set_map.emplace("ion0", std::move(ions_ptr));
+
+  WaveFunctionFactory wff(elec, particle_set_map, c);
+
+  Libxml2Document wfdoc;
+  bool wfokay = wfdoc.parse("cn.wfnoj.xml");
+  REQUIRE(wfokay);
+
+  RuntimeOptions runtime_options;
+  HamiltonianFactory::PsiPoolType psi_map;
+  psi_map.emplace("psi0", wff.buildTWF(wfdoc.getRoot(), runtime_options));
+  TrialWaveFunction& psi = *psi_map["psi0"];
+
+  HamiltonianFactory hf("h0", elec, particle_set_map, psi_map, c);
+  QMCHamiltonian& ham = create_CN_Hamiltonian(hf);
+
+  // a second walker with displaced electrons
+  ParticleSet elec2(elec);
+  for (int iel = 0; iel < elec2.getTotalNum(); iel++)
+    elec2.R[iel] += ParticleSet::SingleParticlePos(0.1 * (iel % 3), -0.05 * iel, 0.07);
+  elec2.update();
+  auto psi2_ptr           = psi.makeClone(elec2);
+  TrialWaveFunction& psi2 = *psi2_ptr;
+  auto ham2_ptr           = ham.makeClone(elec2, psi2);
+  QMCHamiltonian& ham2    = *ham2_ptr;
+
+  for (const bool use_space_warp : {false, true})
+  {
+    psi.evaluateLog(elec);
+    psi2.evaluateLog(elec2);
+    ham.evaluateDeterministic(elec);
+    ham2.evaluateDeterministic(elec2);
+
+    ACForce force(ions, elec, psi, ham);
+    const std::string acforce_xml = std::string(R"(<acforce spacewarp=")") + (use_space_warp ? "yes" : "no") +
+        R"(" swpow="2." delta="1.e-3" epsilon="0.01"/>)";
+    Libxml2Document doc;
+    REQUIRE(doc.parseFromString(acforce_xml));
+    force.put(doc.getRoot());
+    OperatorBase::PropertySetType plist;
+    OperatorBase::BufferType collectables;
+    force.addObservables(plist, collectables);
+    auto force2_ptr = force.makeClone(elec2, psi2, ham2);
+    ACForce& force2 = dynamic_cast<ACForce&>(*force2_ptr);
+
+    auto getObservables = [&plist](ACForce& acforce) {
+      acforce.setObservables(plist);
+      return plist.Values;
+    };
+
+    force.evaluate(elec);
+    force2.evaluate(elec2);
+    const auto ref  = getObservables(force);
+    const auto ref2 = getObservables(force2);
+
+    RefVectorWithLeader<OperatorBase> o_list(force, {force, force2});
+    RefVectorWithLeader<TrialWaveFunction> wf_list(psi, {psi, psi2});
+    RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec2});
+    ResourceCollection twf_res("test_twf_res");
+    psi.createResource(twf_res);
+    ResourceCollectionTeamLock<TrialWaveFunction> mw_twf_lock(twf_res, wf_list);
+    force.mw_evaluate(o_list, wf_list, p_list);
+    const auto mw  = getObservables(force);
+    const auto mw2 = getObservables(force2);
+
+    REQUIRE(mw.size() == ref.size());
+    CHECK(ref != ref2);
+    for (int i = 0; i < ref.size(); i++)
+    {
+      CHECK(mw[i] == Approx(ref[i]));
+      CHECK(mw2[i] == Approx(ref2[i]));
+    }
+  }
+}
+
+TEST_CASE("Eloc_Derivatives:batched_slater_wj", "[hamiltonian]")
+{
+  using RealType = QMCTraits::RealType;
+  using GradType = TrialWaveFunction::GradType;
+  enum observ_id
+  {
+    KINETIC = 0,
+    LOCALECP,
+    NONLOCALECP,
+    ELECELEC,
+    IONION
+  };
+
+  Communicate* c = OHMMS::Controller;
+
+  std::ifstream wf_file("cn.wfj.xml");
+  REQUIRE(wf_file);
+  std::stringstream wf_stream;
+  wf_stream << wf_file.rdbuf();
+  const std::string wf_xml = wf_stream.str();
+
+  for (const bool use_batched_det : {false, true})
+  {
+    const SimulationCell simulation_cell;
+    auto ions_ptr = std::make_unique<ParticleSet>(simulation_cell);
+    auto elec_ptr = std::make_unique<ParticleSet>(simulation_cell);
+    auto &ions(*ions_ptr), elec(*elec_ptr);
+
+    create_CN_particlesets(elec, ions);
+    const int Nions = ions.getTotalNum();
+
+    HamiltonianFactory::PSetMap particle_set_map;
+    particle_set_map.emplace("e", std::move(elec_ptr));
+    particle_set_map.emplace("ion0", std::move(ions_ptr));
+
+    WaveFunctionFactory wff(elec, particle_set_map, c);
+
+    // DiracDeterminant or DiracDeterminantBatched
+    std::string xml = wf_xml;
+    if (use_batched_det)
+    {
+      const std::string det_tag("<slaterdeterminant>");
+      const auto pos = xml.find(det_tag);
+      REQUIRE(pos != std::string::npos);
+      xml.replace(pos, det_tag.size(), R"(<slaterdeterminant batch="yes">)");
+    }
+    Libxml2Document wfdoc;
+    REQUIRE(wfdoc.parseFromString(xml));
+
+    RuntimeOptions runtime_options;
+    HamiltonianFactory::PsiPoolType psi_map;
+    psi_map.emplace("psi0", wff.buildTWF(wfdoc.getRoot(), runtime_options));
+    TrialWaveFunction& psi = *psi_map["psi0"];
+
+    HamiltonianFactory hf("h0", elec, particle_set_map, psi_map, c);
+    QMCHamiltonian& ham = create_CN_Hamiltonian(hf);
+
+    // a second walker with displaced electrons
+    ParticleSet elec2(elec);
+    for (int iel = 0; iel < elec2.getTotalNum(); iel++)
+      elec2.R[iel] += ParticleSet::SingleParticlePos(0.1 * (iel % 3), -0.05 * iel, 0.07);
+    elec2.update();
+    auto psi2_ptr           = psi.makeClone(elec2);
+    TrialWaveFunction& psi2 = *psi2_ptr;
+    auto ham2_ptr           = ham.makeClone(elec2, psi2);
+    QMCHamiltonian& ham2    = *ham2_ptr;
+
+    const RefVector<ParticleSet> elecs{elec, elec2};
+    const RefVector<TrialWaveFunction> psis{psi, psi2};
+    const RefVector<QMCHamiltonian> hams{ham, ham2};
+
+    // per walker references
+    std::vector<std::vector<GradType>> ref_wfgrads(2, std::vector<GradType>(Nions));
+    std::vector<ParticleSet::ParticlePos> ref_nlpp_hf(2, ParticleSet::ParticlePos(Nions));
+    std::vector<ParticleSet::ParticlePos> ref_nlpp_pulay(2, ParticleSet::ParticlePos(Nions));
+    std::vector<RealType> ref_nlpp_values(2);
+    std::vector<ParticleSet::ParticlePos> ref_hf(2, ParticleSet::ParticlePos(Nions));
+    std::vector<ParticleSet::ParticlePos> ref_pulay(2, ParticleSet::ParticlePos(Nions));
+    std::vector<ParticleSet::ParticlePos> ref_wf_grad(2, ParticleSet::ParticlePos(Nions));
+    for (int iw = 0; iw < 2; iw++)
+    {
+      psis[iw].get().evaluateLog(elecs[iw]);
+      hams[iw].get().evaluateDeterministic(elecs[iw]);
+      for (int iat = 0; iat < Nions; iat++)
+        ref_wfgrads[iw][iat] = psis[iw].get().evalGradSource(elecs[iw], ions, iat);
+      ref_nlpp_hf[iw]    = 0;
+      ref_nlpp_pulay[iw] = 0;
+      auto& nlpp         = *hams[iw].get().getHamiltonian(NONLOCALECP);
+      nlpp.evaluateIonDerivs(elecs[iw], ions, psis[iw], ref_nlpp_hf[iw], ref_nlpp_pulay[iw]);
+      ref_nlpp_values[iw] = nlpp.getValue();
+      ref_hf[iw]          = 0;
+      ref_pulay[iw]       = 0;
+      hams[iw].get().evaluateIonDerivs(elecs[iw], ions, psis[iw], ref_hf[iw], ref_pulay[iw], ref_wf_grad[iw]);
+    }
+    CHECK(ref_nlpp_values[0] != Approx(ref_nlpp_values[1]));
+
+    RefVectorWithLeader<ParticleSet> p_list(elec, elecs);
+    RefVectorWithLeader<TrialWaveFunction> wf_list(psi, psis);
+    RefVectorWithLeader<QMCHamiltonian> ham_list(ham, hams);
+    ResourceCollection pset_res("test_pset_res");
+    ResourceCollection twf_res("test_twf_res");
+    ResourceCollection ham_res("test_ham_res");
+    elec.createResource(pset_res);
+    psi.createResource(twf_res);
+    ham.createResource(ham_res);
+    ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, p_list);
+    ResourceCollectionTeamLock<TrialWaveFunction> mw_twf_lock(twf_res, wf_list);
+    ResourceCollectionTeamLock<QMCHamiltonian> mw_ham_lock(ham_res, ham_list);
+    ParticleSet::mw_update(p_list);
+    TrialWaveFunction::mw_evaluateLog(wf_list, p_list);
+
+    for (const bool use_batch : {false, true})
+    {
+      const TWFdispatcher twf_disp(use_batch);
+      std::vector<GradType> grads(2);
+      for (int iat = 0; iat < Nions; iat++)
+      {
+        twf_disp.flex_evalGradSource(wf_list, p_list, ions, iat, grads);
+        for (int iw = 0; iw < 2; iw++)
+          for (int idim = 0; idim < OHMMS_DIM; idim++)
+            CHECK(grads[iw][idim] == ValueApprox(ref_wfgrads[iw][iat][idim]));
+      }
+    }
+
+    std::vector<ParticleSet::ParticlePos> hf_terms(2, ParticleSet::ParticlePos(Nions));
+    std::vector<ParticleSet::ParticlePos> pulay_terms(2, ParticleSet::ParticlePos(Nions));
+    std::vector<ParticleSet::ParticlePos> wf_grad(2, ParticleSet::ParticlePos(Nions));
+    const RefVector<ParticleSet::ParticlePos> hf_list{hf_terms[0], hf_terms[1]};
+    const RefVector<ParticleSet::ParticlePos> pulay_list{pulay_terms[0], pulay_terms[1]};
+    const RefVector<ParticleSet::ParticlePos> wf_grad_list{wf_grad[0], wf_grad[1]};
+    auto checkForces = [&](const std::vector<ParticleSet::ParticlePos>& ref_hf_terms,
+                           const std::vector<ParticleSet::ParticlePos>& ref_pulay_terms) {
+      for (int iw = 0; iw < 2; iw++)
+        for (int iat = 0; iat < Nions; iat++)
+          for (int idim = 0; idim < OHMMS_DIM; idim++)
+          {
+            CHECK(hf_terms[iw][iat][idim] == Approx(ref_hf_terms[iw][iat][idim]));
+            CHECK(pulay_terms[iw][iat][idim] == Approx(ref_pulay_terms[iw][iat][idim]));
+          }
+    };
+
+    RefVectorWithLeader<OperatorBase> nlpp_list(*ham.getHamiltonian(NONLOCALECP),
+                                                {*ham.getHamiltonian(NONLOCALECP),
+                                                 *ham2.getHamiltonian(NONLOCALECP)});
+    for (int iw = 0; iw < 2; iw++)
+    {
+      hf_terms[iw]    = 0;
+      pulay_terms[iw] = 0;
+    }
+    nlpp_list.getLeader().mw_evaluateIonDerivs(nlpp_list, wf_list, p_list, ions, hf_list, pulay_list);
+    checkForces(ref_nlpp_hf, ref_nlpp_pulay);
+    for (int iw = 0; iw < 2; iw++)
+      CHECK(nlpp_list[iw].getValue() == Approx(ref_nlpp_values[iw]));
+
+    for (const bool use_batch : {false, true})
+    {
+      const Hdispatcher ham_disp(use_batch);
+      for (int iw = 0; iw < 2; iw++)
+      {
+        hf_terms[iw]    = 0;
+        pulay_terms[iw] = 0;
+      }
+      ham_disp.flex_evaluateIonDerivs(ham_list, wf_list, p_list, ions, hf_list, pulay_list, wf_grad_list);
+      checkForces(ref_hf, ref_pulay);
+      INFO("batched det " << use_batched_det << " batch " << use_batch);
+      for (int iw = 0; iw < 2; iw++)
+        for (int iat = 0; iat < Nions; iat++)
+          for (int idim = 0; idim < OHMMS_DIM; idim++)
+            CHECK(wf_grad[iw][iat][idim] == Approx(ref_wf_grad[iw][iat][idim]));
+    }
+  }
+}
+
 TEST_CASE("Eloc_Derivatives:slater_wj", "[hamiltonian]")
 {
   app_log() << "====Ion Derivative Test: Single Slater+Jastrow====\n";
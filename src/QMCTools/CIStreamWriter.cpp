@@ -0,0 +1,213 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CIStreamWriter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <queue>
+#include "hdf/hdf_wrapper_functions.h"
+
+using namespace qmcplusplus;
+
+CIStreamWriter::CIStreamWriter(const std::string& scratch_file, int nstates, double cutoff, std::size_t chunk_size)
+    : scratch_file_(scratch_file),
+      nstates_(nstates),
+      nwords_(getNumWords(nstates)),
+      cutoff_(cutoff),
+      chunk_size_(std::max<std::size_t>(chunk_size, 1))
+{
+  coeffs_.reserve(chunk_size_);
+  words_.reserve(chunk_size_ * 2 * nwords_);
+}
+
+CIStreamWriter::~CIStreamWriter()
+{
+  if (scratch_.is_open())
+  {
+    scratch_.close();
+    std::remove(scratch_file_.c_str());
+  }
+}
+
+void CIStreamWriter::packOccupation(const std::string& occ, int nstates, uint64_t* words)
+{
+  std::fill(words, words + getNumWords(nstates), 0);
+  const int n = std::min(static_cast<int>(occ.size()), nstates);
+  for (int i = 0; i < n; i++)
+    if (occ[i] == '1')
+      words[i / 64] |= uint64_t(1) << (i % 64);
+}
+
+bool CIStreamWriter::add(double coeff, const std::string& alpha, const std::string& beta)
+{
+  if (std::abs(coeff) <= cutoff_)
+    return false;
+  coeffs_.push_back(coeff);
+  const std::size_t first = words_.size();
+  words_.resize(first + 2 * nwords_);
+  uint64_t* det = words_.data() + first;
+  packOccupation(alpha, nstates_, det);
+  packOccupation(beta, nstates_, det + nwords_);
+  for (int l = nwords_ - 1; l >= 0; l--)
+    if (uint64_t w = det[l] | det[nwords_ + l]; w != 0)
+    {
+      int nbits = 0;
+      for (; w != 0; w >>= 1)
+        nbits++;
+      max_occupied_ = std::max(max_occupied_, 64 * l + nbits);
+      break;
+    }
+  ndets_++;
+  if (coeffs_.size() == chunk_size_)
+    spill();
+  return true;
+}
+
+void CIStreamWriter::spill()
+{
+  if (coeffs_.empty())
+    return;
+  if (!scratch_.is_open())
+  {
+    scratch_.open(scratch_file_, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!scratch_)
+    {
+      std::cerr << "Could not open CI scratch file " << scratch_file_ << std::endl;
+      abort();
+    }
+  }
+  std::vector<std::size_t> order(coeffs_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [this](std::size_t a, std::size_t b) { return std::abs(coeffs_[a]) > std::abs(coeffs_[b]); });
+
+  scratch_.seekp(0, std::ios::end);
+  runs_.push_back({scratch_.tellp(), coeffs_.size()});
+  for (auto i : order)
+  {
+    scratch_.write(reinterpret_cast<const char*>(&coeffs_[i]), sizeof(double));
+    scratch_.write(reinterpret_cast<const char*>(words_.data() + i * 2 * nwords_), 2 * nwords_ * sizeof(uint64_t));
+  }
+  if (!scratch_)
+  {
+    std::cerr << "Failed writing CI scratch file " << scratch_file_ << std::endl;
+    abort();
+  }
+  coeffs_.clear();
+  words_.clear();
+}
+
+void CIStreamWriter::write(hdf_archive& hout, int nstates_out, bool write_beta)
+{
+  const int nwords_out = getNumWords(nstates_out);
+  if (nwords_out > nwords_)
+  {
+    std::cerr << "CIStreamWriter cannot write " << nstates_out << " orbitals, determinants were packed with "
+              << nstates_ << std::endl;
+    abort();
+  }
+  spill();
+
+  // every run reads back its share of the memory budget at a time
+  struct Cursor
+  {
+    std::vector<char> buffer;
+    std::streamoff offset;
+    std::size_t left;
+    std::size_t next      = 0;
+    std::size_t nbuffered = 0;
+  };
+  const std::size_t record = recordBytes();
+  const std::size_t nread  = std::max<std::size_t>(chunk_size_ / std::max<std::size_t>(runs_.size(), 1), 1);
+  std::vector<Cursor> cursors(runs_.size());
+  auto refill = [&](Cursor& c) {
+    c.nbuffered = std::min(nread, c.left);
+    c.next      = 0;
+    c.buffer.resize(c.nbuffered * record);
+    scratch_.seekg(c.offset);
+    scratch_.read(c.buffer.data(), c.buffer.size());
+    if (!scratch_)
+    {
+      std::cerr << "Failed reading CI scratch file " << scratch_file_ << std::endl;
+      abort();
+    }
+    c.offset += c.buffer.size();
+    c.left -= c.nbuffered;
+  };
+  auto coeffOf = [&](const Cursor& c) {
+    double coeff;
+    std::memcpy(&coeff, c.buffer.data() + c.next * record, sizeof(double));
+    return coeff;
+  };
+
+  // largest |coefficient| first, the earlier run on ties keeps the input order
+  using Head = std::pair<double, std::size_t>;
+  auto later = [](const Head& a, const Head& b) {
+    return a.first < b.first || (a.first == b.first && a.second > b.second);
+  };
+  std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(later);
+  for (std::size_t ir = 0; ir < runs_.size(); ir++)
+  {
+    cursors[ir].offset = runs_[ir].offset;
+    cursors[ir].left   = runs_[ir].size;
+    refill(cursors[ir]);
+    heads.push({std::abs(coeffOf(cursors[ir])), ir});
+  }
+
+  // HDF5 chunks are capped to keep them well below the library limit
+  const hsize_t h5_chunk = std::min<std::size_t>(chunk_size_, 65536);
+  hsize_t current_coeff  = 0, current_alpha = 0, current_beta = 0;
+  std::vector<double> out_coeff;
+  std::vector<uint64_t> out_alpha, out_beta;
+  auto flush = [&]() {
+    if (out_coeff.empty())
+      return;
+    const hsize_t dims[2] = {out_coeff.size(), static_cast<hsize_t>(nwords_out)};
+    h5d_append(hout.top(), "Coeff", current_coeff, 1, dims, out_coeff.data(), h5_chunk);
+    h5d_append(hout.top(), "CI_Alpha", current_alpha, 2, dims, out_alpha.data(), h5_chunk);
+    if (write_beta)
+      h5d_append(hout.top(), "CI_Beta", current_beta, 2, dims, out_beta.data(), h5_chunk);
+    out_coeff.clear();
+    out_alpha.clear();
+    out_beta.clear();
+  };
+
+  while (!heads.empty())
+  {
+    const std::size_t ir = heads.top().second;
+    Cursor& c            = cursors[ir];
+    heads.pop();
+    const char* rec = c.buffer.data() + c.next * record;
+    const auto* det = reinterpret_cast<const uint64_t*>(rec + sizeof(double));
+    out_coeff.push_back(coeffOf(c));
+    out_alpha.insert(out_alpha.end(), det, det + nwords_out);
+    out_beta.insert(out_beta.end(), det + nwords_, det + nwords_ + nwords_out);
+    if (out_coeff.size() == chunk_size_)
+      flush();
+    if (++c.next == c.nbuffered)
+    {
+      if (c.left == 0)
+      {
+        std::vector<char>().swap(c.buffer);
+        continue;
+      }
+      refill(c);
+    }
+    heads.push({std::abs(coeffOf(c)), ir});
+  }
+  flush();
+}
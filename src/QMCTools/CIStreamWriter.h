@@ -0,0 +1,94 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_TOOLS_CISTREAMWRITER_H
+#define QMCPLUSPLUS_TOOLS_CISTREAMWRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "hdf/hdf_archive.h"
+
+/** Bounded memory writer of a determinant expansion into the MultiDet group of a QMCPACK HDF5 file
+ *
+ * Determinants are added one at a time as occupation strings. Those below the cutoff are dropped and
+ * the others are bit-packed right away. Every chunk_size determinants the buffer is sorted by decreasing
+ * |coefficient| and spilled as a run to a scratch file. write() merges the runs and appends Coeff,
+ * CI_Alpha and CI_Beta to the archive chunk by chunk, so neither the strings nor the packed expansion
+ * are ever held in memory as a whole. Determinants with equal |coefficient| keep their input order.
+ */
+class CIStreamWriter
+{
+public:
+  /** constructor
+   * @param scratch_file file holding the sorted runs, removed by the destructor
+   * @param nstates number of orbitals in the occupation strings, longer strings are truncated
+   * @param cutoff determinants with |coefficient| <= cutoff are dropped
+   * @param chunk_size number of determinants kept in memory
+   */
+  CIStreamWriter(const std::string& scratch_file, int nstates, double cutoff, std::size_t chunk_size);
+  ~CIStreamWriter();
+
+  CIStreamWriter(const CIStreamWriter&)            = delete;
+  CIStreamWriter& operator=(const CIStreamWriter&) = delete;
+
+  /** add a determinant
+   * @return false if the determinant falls below the cutoff
+   */
+  bool add(double coeff, const std::string& alpha, const std::string& beta);
+
+  /** write the sorted expansion into the current group of hout
+   * @param nstates_out number of orbitals written, the bit strings are trimmed to ceil(nstates_out/64) words
+   * @param write_beta write CI_Beta as well as CI_Alpha
+   */
+  void write(qmcplusplus::hdf_archive& hout, int nstates_out, bool write_beta = true);
+
+  /// number of determinants kept
+  std::size_t size() const { return ndets_; }
+  /// one past the highest occupied orbital over all kept determinants
+  int getMaxOccupied() const { return max_occupied_; }
+
+  /// number of 64 bit words needed for nstates orbitals
+  static int getNumWords(int nstates) { return (nstates + 63) / 64; }
+  /// set bit b of word l if orbital 64*l+b is occupied, the layout of CI_Alpha and CI_Beta
+  static void packOccupation(const std::string& occ, int nstates, uint64_t* words);
+
+private:
+  /// a sorted run in the scratch file
+  struct Run
+  {
+    std::streamoff offset;
+    std::size_t size;
+  };
+
+  const std::string scratch_file_;
+  const int nstates_;
+  const int nwords_;
+  const double cutoff_;
+  const std::size_t chunk_size_;
+  std::size_t ndets_ = 0;
+  int max_occupied_  = 0;
+
+  /// coefficients of the buffered determinants
+  std::vector<double> coeffs_;
+  /// alpha then beta words of the buffered determinants
+  std::vector<uint64_t> words_;
+  std::vector<Run> runs_;
+  std::fstream scratch_;
+
+  std::size_t recordBytes() const { return sizeof(double) + 2 * nwords_ * sizeof(uint64_t); }
+  /// sort the buffer and append it to the scratch file as a run
+  void spill();
+};
+
+#endif
@@ -1383,12 +1383,19 @@ void GamesAsciiParser::getCI(std::istream& is)
   CIcoeff.clear();
   CIalpha.clear();
   CIbeta.clear();
+  ci_stream.reset();
 
   // set a count to check if we arrive our target state or not
   int state_num = -1;
 
   std::cout << "Target State Number is " << target_state << std::endl;
 
+  int ds  = SpinMultiplicity - 1;
+  int neb = (NumberOfEls - ds) / 2;
+  int nea = NumberOfEls - NumberOfBeta;
+  // core orbitals prepended to the streamed occupation strings
+  std::string core_alpha, core_beta;
+
 
   do
   {
@@ -1418,13 +1425,43 @@ void GamesAsciiParser::getCI(std::istream& is)
         if (currentWords[0] == "....." || currentWords[1] == "DONE")
           break;
         ci_size++;
-        CIcoeff.push_back(atof(currentWords[4].c_str()));
-        CIalpha.push_back(currentWords[0]);
-        CIbeta.push_back(currentWords[2]);
+        if (ci_chunk_size > 0)
+        {
+          if (!ci_stream)
+          {
+            if (currentWords[0].size() != currentWords[2].size())
+            {
+              std::cerr << "QMCPACK can't handle different number of active orbitals in alpha and beta channels right "
+                           "now. Contact developers for help (Miguel).\n";
+              abort();
+            }
+            core_alpha.assign(nea - std::count(currentWords[0].begin(), currentWords[0].end(), '1'), '1');
+            core_beta.assign(neb - std::count(currentWords[2].begin(), currentWords[2].end(), '1'), '1');
+            ci_nstates = core_alpha.size() + currentWords[0].size();
+            ci_stream  = std::make_unique<CIStreamWriter>(h5file + ".ci_scratch", ci_nstates, ci_threshold,
+                                                          ci_chunk_size);
+          }
+          ci_stream->add(atof(currentWords[4].c_str()), core_alpha + currentWords[0], core_beta + currentWords[2]);
+        }
+        else
+        {
+          CIcoeff.push_back(atof(currentWords[4].c_str()));
+          CIalpha.push_back(currentWords[0]);
+          CIbeta.push_back(currentWords[2]);
+        }
         getwords(currentWords, is);
       }
     }
   } while (notfound);
+  if (ci_stream)
+  {
+    std::cout << "Streamed " << ci_stream->size() << " of " << ci_size << " determinants above the cutoff "
+              << ci_threshold << std::endl;
+    ci_size = ci_stream->size();
+    ci_nea  = nea;
+    ci_neb  = neb;
+    return;
+  }
   ci_nea = ci_neb = 0;
   for (int i = 0; i < CIalpha[0].size(); i++)
     if (CIalpha[0].at(i) == '1')
@@ -1438,9 +1475,6 @@ void GamesAsciiParser::getCI(std::istream& is)
                  "Contact developers for help (Miguel).\n";
     abort();
   }
-  int ds  = SpinMultiplicity - 1;
-  int neb = (NumberOfEls - ds) / 2;
-  int nea = NumberOfEls - NumberOfBeta;
 
   for (int i = 0; i < CIalpha.size(); i++)
     CIalpha[i].insert(0, std::string(nea - ci_nea, '1'));
@@ -1462,6 +1496,7 @@ void GamesAsciiParser::getORMAS(std::istream& is)
   CIcoeff.clear();
   CIalpha.clear();
   CIbeta.clear();
+  ci_stream.reset();
   std::string aline;
   if (!lookFor(is, "NUMBER OF CORE ORBITALS", aline))
   {
@@ -1510,6 +1545,10 @@ void GamesAsciiParser::getORMAS(std::istream& is)
   std::string dummy_alpha(nactive, '0');
   std::string dummy_beta(nactive, '0');
   int nskip = ci_nea + ci_neb + 2;
+  // occupation strings of the streamed determinant
+  std::string occ_alpha, occ_beta;
+  if (ci_chunk_size > 0)
+    ci_stream = std::make_unique<CIStreamWriter>(h5file + ".ci_scratch", nactive, ci_threshold, ci_chunk_size);
   do
   {
     if (is.eof())
@@ -1531,7 +1570,18 @@ void GamesAsciiParser::getORMAS(std::istream& is)
         if (currentWords[0] == "....." || currentWords[1] == "DONE")
           break;
         double cof = atof(currentWords[nskip].c_str());
-        if (std::abs(cof) > ci_threshold)
+        if (ci_stream && std::abs(cof) > ci_threshold)
+        {
+          ci_size++;
+          occ_alpha = dummy_alpha;
+          occ_beta  = dummy_beta;
+          for (int i = 0; i < ci_nea; i++)
+            occ_alpha[atoi(currentWords[i].c_str()) - 1] = '1';
+          for (int i = 0; i < ci_neb; i++)
+            occ_beta[atoi(currentWords[ci_nea + 1 + i].c_str()) - 1] = '1';
+          ci_stream->add(cof, occ_alpha, occ_beta);
+        }
+        else if (std::abs(cof) > ci_threshold)
         {
           ci_size++;
           CIcoeff.push_back(cof);
@@ -1547,6 +1597,11 @@ void GamesAsciiParser::getORMAS(std::istream& is)
     }
   } while (notfound);
   ci_nstates = 0;
+  if (ci_stream)
+  {
+    ci_nstates = ci_stream->getMaxOccupied();
+    return;
+  }
   for (int i = 0; i < ci_size; i++)
   {
     int max = 0; //=nactive;
@@ -165,12 +165,8 @@ void LCAOHDFParser::parse(const std::string& fname)
     hin.read(ci_size, "NbDet");
     hin.read(ci_nstates, "nstate");
     hin.read(nbexcitedstates, "nexcitedstate");
-    CIcoeff.clear();
-    CIalpha.clear();
-    CIbeta.clear();
-    CIcoeff.resize(ci_size);
-    CIalpha.resize(ci_size);
-    CIbeta.resize(ci_size);
+    // the expansion stays in the MultiDet group of this file and is referenced from the detlist node,
+    // only its metadata is read
 
     int ds  = SpinMultiplicity - 1;
     int neb = (NumberOfEls - ds) / 2;
@@ -179,7 +175,7 @@ void LCAOHDFParser::parse(const std::string& fname)
     ci_neb  = NumberOfBeta;
     ci_nca  = nea - ci_nea;
     ci_ncb  = neb - ci_neb;
-    std::cout << " Done reading CIs!!" << std::endl;
+    std::cout << " Done reading the CI metadata!!" << std::endl;
     hin.close();
   }
 }
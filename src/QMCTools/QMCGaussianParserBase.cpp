@@ -92,6 +92,7 @@ QMCGaussianParserBase::QMCGaussianParserBase()
       NbKpts(0),
       nbexcitedstates(0),
       ci_threshold(1e-20),
+      ci_chunk_size(0),
       Title("sample"),
       basisType("Gaussian"),
       basisName("generic"),
@@ -157,6 +158,7 @@ QMCGaussianParserBase::QMCGaussianParserBase(int argc, char** argv)
       NbKpts(0),
       nbexcitedstates(0),
       ci_threshold(1e-20),
+      ci_chunk_size(0),
       Title("sample"),
       basisType("Gaussian"),
       basisName("generic"),
@@ -1078,17 +1080,17 @@ xmlNodePtr QMCGaussianParserBase::createMultiDeterminantSetCIHDF5()
   xmlNewProp(detlist, (const xmlChar*)"nstates", (const xmlChar*)nstates.str().c_str());
   xmlNewProp(detlist, (const xmlChar*)"cutoff", (const xmlChar*)ci_thr.str().c_str());
   xmlNewProp(detlist, (const xmlChar*)"href", (const xmlChar*)h5file.c_str());
-  if (CIcoeff.size() == 0)
+  if (ci_stream ? ci_stream->size() == 0 : CIcoeff.size() == 0)
   {
     std::cerr << " CI configuration list is empty. \n";
     exit(101);
   }
-  if (CIcoeff.size() != CIalpha.size())
+  if (!ci_stream && CIcoeff.size() != CIalpha.size())
   {
     std::cerr << " Problem with CI configuration lists. \n";
     exit(102);
   }
-  if (!isSpinor && CIcoeff.size() != CIbeta.size())
+  if (!ci_stream && !isSpinor && CIcoeff.size() != CIbeta.size())
   {
     std::cerr << " Problem with CI configuration lists. \n";
     exit(102);
@@ -1108,9 +1110,20 @@ xmlNodePtr QMCGaussianParserBase::createMultiDeterminantSetCIHDF5()
   hout.push("MultiDet", true);
   hout.write(ci_size, "NbDet");
   hout.write(ci_nstates, "nstate");
-  hout.write(CIcoeff, "Coeff");
+  if (!ci_stream)
+    hout.write(CIcoeff, "Coeff");
   hout.write(N_int, "Nbits");
   hout.write(nbexcitedstates, "nexcitedstate");
+  if (ci_stream)
+  {
+    // sorted by decreasing |coefficient| and appended chunk by chunk, the scratch file goes with the writer
+    ci_stream->write(hout, ci_nstates, !isSpinor);
+    ci_stream.reset();
+    hout.pop();
+    xmlAddChild(multislaterdet, detlist);
+    hout.close();
+    return multislaterdet;
+  }
 
   Matrix<uint64_t> tempAlpha(ci_size, N_int);
   Matrix<uint64_t> tempBeta(ci_size, N_int);
@@ -2637,17 +2650,11 @@ xmlNodePtr QMCGaussianParserBase::createMultiDeterminantSetFromH5()
   }
   if (!debug)
     xmlNewProp(detlist, (const xmlChar*)"href", (const xmlChar*)multih5file.c_str());
-  if (CIcoeff.size() == 0)
+  if (ci_size == 0)
   {
     std::cerr << " CI configuration list is empty. \n";
     exit(101);
   }
-  if (CIcoeff.size() != CIalpha.size() || CIcoeff.size() != CIbeta.size())
-  {
-    std::cerr << " Problem with CI configuration lists. \n";
-    exit(102);
-  }
-  int iv = 0;
   xmlAddChild(multislaterdet, detlist);
   return multislaterdet;
 }
@@ -23,10 +23,12 @@
 #include <iomanip>
 #include <vector>
 #include <map>
+#include <memory>
 #include "OhmmsData/OhmmsElementBase.h"
 #include "Utilities/SimpleParser.h"
 #include "Particle/ParticleSet.h"
 #include "hdf/hdf_archive.h"
+#include "CIStreamWriter.h"
 
 using namespace qmcplusplus;
 
@@ -73,6 +75,8 @@ struct QMCGaussianParserBase
   int NbKpts;
   int nbexcitedstates;
   double ci_threshold;
+  // determinants held in memory when streaming the CI expansion, 0 reads it as a whole
+  int ci_chunk_size;
 
 
   std::vector<double> STwist_Coord; //Super Twist Coordinates
@@ -112,6 +116,8 @@ struct QMCGaussianParserBase
   std::vector<std::vector<std::string>> CSFalpha, CSFbeta;
   std::vector<std::vector<double>> CSFexpansion;
   std::vector<double> CIcoeff;
+  // streamed CI expansion, replaces CIcoeff, CIalpha and CIbeta when ci_chunk_size > 0
+  std::unique_ptr<CIStreamWriter> ci_stream;
   std::vector<double> X, Y, Z; //LAttice vectors for PBC
   std::vector<int> Image;
 
@@ -42,6 +42,9 @@ int main(int argc, char** argv)
     std::cout << "[-size npts -multidet multidet.h5 -ci file.out -threshold cimin -TargetState state_number "
                  "-NaturalOrbitals NumToRead -optDetCoeffs]"
               << std::endl;
+    std::cout << "[-ciChunk ndets] stream the gamess CI expansion to -hdf5 holding at most ndets determinants in "
+                 "memory"
+              << std::endl;
     std::cout << "Defaults : -gridtype log -first 1e-6 -last 100 -size 1001 -ci required -threshold 0.01 -TargetState "
                  "0 -prefix sample"
               << std::endl;
@@ -84,6 +87,7 @@ int main(int argc, char** argv)
       bool ci = false, zeroCI = false, orderByExcitation = false, addCusp = false, multidet = false,
            optDetCoeffs = false;
       double thres      = 1e-20;
+      int ciChunk       = 0; // if > 0, stream the CI expansion in chunks of ciChunk determinants
       int readNO        = 0; // if > 0, read Natural Orbitals from gamess output
       int readGuess     = 0; // if > 0, read Initial Guess from gamess output
       std::vector<int> Image;
@@ -170,6 +174,10 @@ int main(int argc, char** argv)
         {
           thres = atof(argv[++iargc]);
         }
+        else if (a == "-ciChunk")
+        {
+          ciChunk = atoi(argv[++iargc]);
+        }
         else if (a == "-optDetCoeffs")
         {
           optDetCoeffs = true;
@@ -274,6 +282,11 @@ int main(int argc, char** argv)
         parser->UseHDF5 = false;
         parser->h5file  = "";
       }
+      if (ciChunk > 0 && !parser->UseHDF5)
+      {
+        std::cerr << "-ciChunk writes the CI expansion directly to HDF5 and requires -hdf5. \n";
+        abort();
+      }
       parser->multideterminant = false;
       if (ci)
         parser->multideterminant = ci;
@@ -285,6 +298,7 @@ int main(int argc, char** argv)
       parser->multih5file       = punch_file;
       parser->production        = prod;
       parser->ci_threshold      = thres;
+      parser->ci_chunk_size     = ciChunk;
       parser->optDetCoeffs      = optDetCoeffs;
       parser->target_state      = TargetState;
       parser->readNO            = readNO;
@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <numeric>
+#include "OhmmsPETE/OhmmsMatrix.h"
+#include "QMCTools/CIStreamWriter.h"
+
+namespace qmcplusplus
+{
+TEST_CASE("CIStreamWriter pack", "[tools]")
+{
+  std::string occ(70, '0');
+  occ[0] = occ[3] = occ[65] = '1';
+  uint64_t words[2];
+  CIStreamWriter::packOccupation(occ, 70, words);
+  CHECK(words[0] == 9);
+  CHECK(words[1] == 2);
+  // strings are truncated to the number of orbitals
+  CIStreamWriter::packOccupation(occ, 64, words);
+  CHECK(words[0] == 9);
+}
+
+TEST_CASE("CIStreamWriter sorted runs", "[tools]")
+{
+  const int nstates   = 70;
+  const int ndets     = 50;
+  const double cutoff = 1e-3;
+  const std::string h5_name("test_ci_stream.h5");
+  const std::string scratch_name("test_ci_stream.scratch");
+
+  std::vector<double> coeffs;
+  std::vector<std::string> alphas, betas;
+  for (int i = 0; i < ndets; i++)
+  {
+    // repeated magnitudes of both signs test the order of ties, every fifth one is below the cutoff
+    coeffs.push_back(i % 5 == 4 ? 1e-4 : (i % 2 ? -1.0 : 1.0) / (1 + (i * 7) % 11));
+    std::string alpha(nstates, '0'), beta(nstates, '0');
+    alpha[i % 3] = alpha[(i * 13) % 60] = '1';
+    beta[i % 4]  = beta[(i * 17) % 66] = '1';
+    alphas.push_back(alpha);
+    betas.push_back(beta);
+  }
+
+  std::vector<int> kept;
+  for (int i = 0; i < ndets; i++)
+    if (std::abs(coeffs[i]) > cutoff)
+      kept.push_back(i);
+  std::stable_sort(kept.begin(), kept.end(), [&](int a, int b) { return std::abs(coeffs[a]) > std::abs(coeffs[b]); });
+  int max_occupied = 0;
+  for (auto i : kept)
+    for (int k = 0; k < nstates; k++)
+      if (alphas[i][k] == '1' || betas[i][k] == '1')
+        max_occupied = std::max(max_occupied, k + 1);
+
+  for (std::size_t chunk_size : {7, 1000})
+  {
+    {
+      CIStreamWriter writer(scratch_name, nstates, cutoff, chunk_size);
+      for (int i = 0; i < ndets; i++)
+        CHECK(writer.add(coeffs[i], alphas[i], betas[i]) == (std::abs(coeffs[i]) > cutoff));
+      CHECK(writer.size() == kept.size());
+      CHECK(writer.getMaxOccupied() == max_occupied);
+      hdf_archive hout;
+      REQUIRE(hout.create(h5_name));
+      hout.push("MultiDet", true);
+      writer.write(hout, nstates);
+      hout.close();
+    }
+    CHECK(!std::filesystem::exists(scratch_name));
+
+    hdf_archive hin;
+    REQUIRE(hin.open(h5_name, H5F_ACC_RDONLY));
+    hin.push("MultiDet", false);
+    std::vector<double> coeffs_read;
+    Matrix<uint64_t> alpha_read, beta_read;
+    hin.read(coeffs_read, "Coeff");
+    hin.read(alpha_read, "CI_Alpha");
+    hin.read(beta_read, "CI_Beta");
+    hin.close();
+    REQUIRE(coeffs_read.size() == kept.size());
+    REQUIRE(alpha_read.rows() == kept.size());
+    REQUIRE(alpha_read.cols() == 2);
+    REQUIRE(beta_read.rows() == kept.size());
+    for (int j = 0; j < kept.size(); j++)
+    {
+      uint64_t words[2];
+      CHECK(coeffs_read[j] == coeffs[kept[j]]);
+      CIStreamWriter::packOccupation(alphas[kept[j]], nstates, words);
+      CHECK(alpha_read[j][0] == words[0]);
+      CHECK(alpha_read[j][1] == words[1]);
+      CIStreamWriter::packOccupation(betas[kept[j]], nstates, words);
+      CHECK(beta_read[j][0] == words[0]);
+      CHECK(beta_read[j][1] == words[1]);
+    }
+    std::filesystem::remove(h5_name);
+  }
+}
+} // namespace qmcplusplus
@@ -28,7 +28,7 @@
 namespace qmcplusplus
 {
 BsplineReader::BsplineReader(EinsplineSetBuilder* e)
-    : mybuilder(e), checkNorm(true), saveSplineCoefs(false), rotate(true)
+    : mybuilder(e), checkNorm(true), saveSplineCoefs(false), compressSplineCoefs(false), useSymmetry(false), rotate(true)
 {
   myComm = mybuilder->getCommunicator();
 }
@@ -70,9 +70,13 @@ void BsplineReader::setCommon(xmlNodePtr cur)
   // check orbital normalization by default
   std::string checkOrbNorm("yes");
   std::string saveCoefs("no");
+  std::string coefsStorage("native");
+  std::string useSymm("no");
   OhmmsAttributeSet a;
   a.add(checkOrbNorm, "check_orb_norm");
   a.add(saveCoefs, "save_coefs");
+  a.add(coefsStorage, "coefs_storage", {"native", "int16"});
+  a.add(useSymm, "use_symmetry", {"no", "yes"});
   a.put(cur);
 
   // allow user to turn off norm check with a warning
@@ -81,7 +85,9 @@ void BsplineReader::setCommon(xmlNodePtr cur)
     app_log() << "WARNING: disable orbital normalization check!" << std::endl;
     checkNorm = false;
   }
-  saveSplineCoefs = saveCoefs == "yes";
+  saveSplineCoefs     = saveCoefs == "yes";
+  compressSplineCoefs = coefsStorage == "int16";
+  useSymmetry         = useSymm == "yes";
 }
 
 std::unique_ptr<SPOSet> BsplineReader::create_spline_set(int spin, xmlNodePtr cur)
@@ -24,6 +24,8 @@
 #include <einspline/bspline_base.h>
 #include <BandInfo.h>
 #include "EinsplineSetBuilder.h"
+#include "SplineSymmetryImages.h"
+#include "CPU/SIMD/aligned_allocator.hpp"
 
 namespace qmcplusplus
 {
@@ -47,6 +49,10 @@ struct BsplineReader
   bool checkNorm;
   ///save spline coefficients to storage
   bool saveSplineCoefs;
+  ///store spline coefficients as scaled 16 bit integers
+  bool compressSplineCoefs;
+  ///store only the orbitals of the symmetry irreducible twists
+  bool useSymmetry;
   ///apply orbital rotations
   bool rotate;
   ///map from spo index to band index
@@ -60,7 +66,10 @@ struct BsplineReader
   {
     auto& MeshSize = mybuilder->MeshSize;
     std::ostringstream oo;
-    oo << bandgroup.myName << ".g" << MeshSize[0] << "x" << MeshSize[1] << "x" << MeshSize[2] << ".h5";
+    oo << bandgroup.myName << ".g" << MeshSize[0] << "x" << MeshSize[1] << "x" << MeshSize[2];
+    if (useSymmetry)
+      oo << ".symm";
+    oo << ".h5";
     return oo.str();
   }
 
@@ -142,6 +151,54 @@ struct BsplineReader
     app_log().flush();
   }
 
+  /** store only the orbitals of the symmetry irreducible twists in bspline and evaluate the others from them
+   * must be called after check_twists and before the spline table is created
+   */
+  template<typename SPE>
+  inline void check_symmetry(SPE& bspline, const BandInfoGroup& bandgroup) const
+  {
+    if (!useSymmetry)
+      return;
+    std::vector<TinyVector<double, 3>> ion_frac;
+    for (const auto& pos : mybuilder->IonPos)
+      ion_frac.push_back(mybuilder->PrimCell.toUnit(pos));
+    const std::vector<int> ion_types(mybuilder->IonTypes.begin(), mybuilder->IonTypes.end());
+    const auto ops = findSpaceGroupOperations(mybuilder->Lattice, ion_frac, ion_types);
+
+    const int N                            = bandgroup.getNumDistinctOrbitals();
+    const std::vector<BandInfo>& cur_bands = bandgroup.myBands;
+    std::vector<TinyVector<double, 3>> twists(N);
+    std::vector<int> bands(N);
+    for (int iorb = 0; iorb < N; iorb++)
+    {
+      twists[iorb] = mybuilder->primcell_kpoints[cur_bands[iorb].TwistIndex];
+      bands[iorb]  = cur_bands[iorb].BandIndex;
+    }
+    const int slot_alignment = std::max<int>(1, getAlignment<typename SPE::DataType>() / 2);
+    auto images = std::make_shared<SplineSymmetryImages>(findSymmetryImages(ops, twists, bands, slot_alignment));
+    app_log() << "  Found " << ops.size() << " space group operations. Storing the orbitals of "
+              << images->num_stored_twists << " out of " << images->blocks.size() << " twists." << std::endl;
+    // the image twists may differ from the input ones by reciprocal lattice vectors
+    for (int iorb = 0; iorb < N; iorb++)
+      twists[iorb] = images->twists[iorb];
+    bspline.set_symmetry_images(std::move(images));
+    for (int iorb = 0; iorb < N; iorb++)
+      bspline.kPoints[iorb] = mybuilder->PrimCell.k_cart(-twists[iorb]);
+  }
+
+  /** replace the spline table of bspline by its 16 bit compressed copy if requested and report the accuracy
+   */
+  template<typename SPE>
+  inline void compress_tables(SPE& bspline) const
+  {
+    if (!compressSplineCoefs)
+      return;
+    const auto error = bspline.compress_tables();
+    app_log() << "  Compressed spline coefficients to 16 bit integers. Orbital values at 64 points differ by at most "
+              << error.max_abs_error << " (rms " << error.rms_error << ") for orbitals bounded by "
+              << error.max_abs_value << std::endl;
+  }
+
   /** return the path name in hdf5
    * @param ti twist index
    * @param spin spin index
@@ -187,6 +244,8 @@ struct BsplineReader
 
   /** Set the orbital rotation flag. Rotations are applied to balance the real/imaginary components. */
   inline void setRotate(bool new_rotate) { rotate = new_rotate; };
+  /** Set the flag to store only the orbitals of the symmetry irreducible twists. */
+  inline void setUseSymmetry(bool new_use_symmetry) { useSymmetry = new_use_symmetry; };
 
   void initialize_spo2band(int spin,
                            const std::vector<BandInfo>& bigspace,
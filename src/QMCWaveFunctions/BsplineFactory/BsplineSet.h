@@ -54,6 +54,55 @@ protected:
   aligned_vector<int> BandIndexMap;
   ///band offsets used for communication
   std::vector<int> offset;
+  /** number of splines evaluated for all the positions of a crowd before moving to the next block in the CPU mw_ APIs
+   * The coefficients touched by one position in a block and the result block stay in the L2 cache.
+   */
+  static constexpr int mw_spline_block_size = 256;
+
+  /// positions of a crowd in the CPU mw_evaluateDetRatios and mw_evaluateVGL, only those of the crowd leader are used
+  template<typename ST>
+  struct MultiWalkerPositionScratch
+  {
+    MultiWalkerPositionScratch() = default;
+    /// clones start empty, the scratch only grows on the crowd leader
+    MultiWalkerPositionScratch(const MultiWalkerPositionScratch&) {}
+
+    /// walker of each position
+    std::vector<int> walker_ids;
+    /// boundary condition signs of real splines
+    std::vector<int> bc_signs;
+    /// Cartesian positions
+    std::vector<TinyVector<ST, 3>> rs;
+    /// positions in the unit cell
+    std::vector<TinyVector<ST, 3>> rus;
+
+    /// empty the lists keeping their capacity
+    void clear()
+    {
+      walker_ids.clear();
+      bc_signs.clear();
+      rs.clear();
+      rus.clear();
+    }
+  };
+
+private:
+  /// per walker vectors of the CPU mw_evaluateVGLandDetRatioGrads, only those of the crowd leader are used
+  struct MultiWalkerVGLScratch
+  {
+    MultiWalkerVGLScratch() = default;
+    /// clones start empty, the views of the original may refer to released memory
+    MultiWalkerVGLScratch(const MultiWalkerVGLScratch&) {}
+
+    /// views of the values and laplacians in phi_vgl_v
+    std::vector<ValueVector> psi_v;
+    std::vector<ValueVector> d2psi_v;
+    /// gradients before they are split into the components of phi_vgl_v
+    std::vector<GradVector> dpsi_v;
+    RefVector<ValueVector> psi_v_list;
+    RefVector<GradVector> dpsi_v_list;
+    RefVector<ValueVector> d2psi_v_list;
+  } mw_vgl_scratch_;
 
 public:
   BsplineSet(const std::string& my_name) : SPOSet(my_name), MyIndex(0), first_spo(0), last_spo(0) {}
@@ -185,6 +234,75 @@ public:
     }
   }
 
+  /** CPU implementation on top of mw_evaluateVGL
+   * The VGL of all the walkers are evaluated by one mw_evaluateVGL call. The ratio and the gradient are then
+   * contracted with the inverse row in the same pass that moves the gradients into phi_vgl_v.
+   */
+  void mw_evaluateVGLandDetRatioGrads(const RefVectorWithLeader<SPOSet>& spo_list,
+                                      const RefVectorWithLeader<ParticleSet>& P_list,
+                                      int iat,
+                                      const std::vector<const ValueType*>& invRow_ptr_list,
+                                      OffloadMWVGLArray& phi_vgl_v,
+                                      std::vector<ValueType>& ratios,
+                                      std::vector<GradType>& grads) const override
+  {
+    assert(this == &spo_list.getLeader());
+    assert(phi_vgl_v.size(0) == DIM_VGL);
+    assert(phi_vgl_v.size(1) == spo_list.size());
+    const size_t nw             = spo_list.size();
+    const size_t norb_requested = phi_vgl_v.size(2);
+
+    // the scratch of the leader only grows with the crowd and the number of orbitals
+    auto& scratch      = spo_list.getCastedLeader<BsplineSet>().mw_vgl_scratch_;
+    auto& mw_psi_v     = scratch.psi_v;
+    auto& mw_dpsi_v    = scratch.dpsi_v;
+    auto& mw_d2psi_v   = scratch.d2psi_v;
+    auto& psi_v_list   = scratch.psi_v_list;
+    auto& dpsi_v_list  = scratch.dpsi_v_list;
+    auto& d2psi_v_list = scratch.d2psi_v_list;
+    mw_psi_v.resize(nw);
+    mw_dpsi_v.resize(nw);
+    mw_d2psi_v.resize(nw);
+    psi_v_list.clear();
+    dpsi_v_list.clear();
+    d2psi_v_list.clear();
+    for (int iw = 0; iw < nw; iw++)
+    {
+      mw_psi_v[iw].attachReference(phi_vgl_v.data_at(0, iw, 0), norb_requested);
+      mw_dpsi_v[iw].resize(norb_requested);
+      mw_d2psi_v[iw].attachReference(phi_vgl_v.data_at(4, iw, 0), norb_requested);
+      psi_v_list.push_back(mw_psi_v[iw]);
+      dpsi_v_list.push_back(mw_dpsi_v[iw]);
+      d2psi_v_list.push_back(mw_d2psi_v[iw]);
+    }
+
+    mw_evaluateVGL(spo_list, P_list, iat, psi_v_list, dpsi_v_list, d2psi_v_list);
+
+    for (int iw = 0; iw < nw; iw++)
+    {
+      const ValueType* restrict invrow = invRow_ptr_list[iw];
+      const ValueType* restrict phi    = mw_psi_v[iw].data();
+      const GradType* restrict dphi    = mw_dpsi_v[iw].data();
+      ValueType* restrict phi_gx       = phi_vgl_v.data_at(1, iw, 0);
+      ValueType* restrict phi_gy       = phi_vgl_v.data_at(2, iw, 0);
+      ValueType* restrict phi_gz       = phi_vgl_v.data_at(3, iw, 0);
+      ValueType ratio(0), grad_x(0), grad_y(0), grad_z(0);
+      for (size_t iorb = 0; iorb < norb_requested; iorb++)
+      {
+        ratio += invrow[iorb] * phi[iorb];
+        grad_x += invrow[iorb] * dphi[iorb][0];
+        grad_y += invrow[iorb] * dphi[iorb][1];
+        grad_z += invrow[iorb] * dphi[iorb][2];
+        phi_gx[iorb] = dphi[iorb][0];
+        phi_gy[iorb] = dphi[iorb][1];
+        phi_gz[iorb] = dphi[iorb][2];
+      }
+      ratios[iw] = ratio;
+      grads[iw]  = GradType(grad_x, grad_y, grad_z) / ratio;
+    }
+    phi_vgl_v.updateTo();
+  }
+
   void evaluate_notranspose(const ParticleSet& P,
                             int first,
                             int last,
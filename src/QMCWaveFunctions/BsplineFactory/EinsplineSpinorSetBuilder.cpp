@@ -191,6 +191,9 @@ std::unique_ptr<SPOSet> EinsplineSpinorSetBuilder::createSPOSetFromXML(xmlNodePt
   MixedSplineReader->setCheckNorm(false);
   //Set no rotation to the orbitals
   MixedSplineReader->setRotate(false);
+  //Space group operations and time reversal also act on the spin, which symmetry reduced tables do not handle
+  if (MixedSplineReader->useSymmetry)
+    myComm->barrier_and_abort("EinsplineSpinorSetBuilder does not support use_symmetry=\"yes\".");
 
   //Make the up spin set.
   auto bspline_zd_u = MixedSplineReader->create_spline_set(spinSet, spo_cur);
@@ -23,12 +23,18 @@
 #include "spline2/MultiBspline1D.hpp"
 #include "Numerics/SmoothFunctions.hpp"
 #include "hdf/hdf_archive.h"
+#include "QMCWaveFunctions/SPOSet.h"
 
 namespace qmcplusplus
 {
 template<class BSPLINESPO>
 class HybridRepSetReader;
 
+namespace testing
+{
+class HybridRepTests;
+}
+
 template<typename ST>
 class AtomicOrbitals
 {
@@ -61,6 +67,87 @@ private:
   std::shared_ptr<std::vector<ST>> coef_copy_;
 
   vContainer_type localV, localG, localL;
+  ///directions of the virtual particles and their Ylm, [lm_tot][virtual particle], in evaluateValues
+  VectorSoaContainer<ST, 3> multi_xyz_;
+  vContainer_type multi_Ylm_v_;
+  ///radial functions at the distances of a group of walkers, [distance][lm_tot * Npad], in the mw_ functions
+  vContainer_type multi_localV_, multi_localG_, multi_localL_;
+
+  /** accumulate the VGL far from the core of one position
+   * @param Ylm_v,Ylm_gx,Ylm_gy,Ylm_gz Ylm and its gradient, element lm at lm * ldy
+   * @param local_val,local_grad,local_lapl radial functions at r
+   */
+  template<typename VV, typename GV>
+  inline void accumulate_vgl_far(const ST& r,
+                                 const PointType& dr,
+                                 const ST* restrict Ylm_v,
+                                 const ST* restrict Ylm_gx,
+                                 const ST* restrict Ylm_gy,
+                                 const ST* restrict Ylm_gz,
+                                 const size_t ldy,
+                                 const ST* restrict local_val,
+                                 const ST* restrict local_grad,
+                                 const ST* restrict local_lapl,
+                                 VV& myV,
+                                 GV& myG,
+                                 VV& myL)
+  {
+    constexpr ST cone(1);
+    const ST rinv  = cone / r;
+    const ST rhatx = dr[0] * rinv;
+    const ST rhaty = dr[1] * rinv;
+    const ST rhatz = dr[2] * rinv;
+
+    ST* restrict val  = myV.data();
+    ST* restrict g0   = myG.data(0);
+    ST* restrict g1   = myG.data(1);
+    ST* restrict g2   = myG.data(2);
+    ST* restrict lapl = myL.data();
+
+    r_power_minus_l[0] = cone;
+    ST r_power_temp    = cone;
+    for (int l = 1; l <= lmax; l++)
+    {
+      r_power_temp *= rinv;
+      for (int m = -l, lm = l * l; m <= l; m++, lm++)
+        r_power_minus_l[lm] = r_power_temp;
+    }
+
+    for (size_t lm = 0; lm < lm_tot; lm++)
+    {
+      const ST& l_val      = l_vals[lm];
+      const ST& r_power    = r_power_minus_l[lm];
+      const ST Ylm_gx_lm   = Ylm_gx[lm * ldy];
+      const ST Ylm_gy_lm   = Ylm_gy[lm * ldy];
+      const ST Ylm_gz_lm   = Ylm_gz[lm * ldy];
+      const ST Ylm_rescale = Ylm_v[lm * ldy] * r_power;
+      const ST rhat_dot_G  = (rhatx * Ylm_gx_lm + rhaty * Ylm_gy_lm + rhatz * Ylm_gz_lm) * r_power;
+#pragma omp simd aligned(val, g0, g1, g2, lapl, local_val, local_grad, local_lapl : QMC_SIMD_ALIGNMENT)
+      for (size_t ib = 0; ib < myV.size(); ib++)
+      {
+        const ST local_v = local_val[ib];
+        const ST local_g = local_grad[ib];
+        const ST local_l = local_lapl[ib];
+        // value
+        const ST Vpart = l_val * rinv * local_v;
+        val[ib] += Ylm_rescale * local_v;
+
+        // grad
+        const ST factor1 = local_g * Ylm_rescale;
+        const ST factor2 = local_v * r_power;
+        const ST factor3 = -Vpart * Ylm_rescale;
+        g0[ib] += factor1 * rhatx + factor2 * Ylm_gx_lm + factor3 * rhatx;
+        g1[ib] += factor1 * rhaty + factor2 * Ylm_gy_lm + factor3 * rhaty;
+        g2[ib] += factor1 * rhatz + factor2 * Ylm_gz_lm + factor3 * rhatz;
+
+        // laplacian
+        lapl[ib] += (local_l + (local_g * (2 - l_val) - Vpart) * rinv) * Ylm_rescale + (local_g - Vpart) * rhat_dot_G;
+      }
+      local_val += Npad;
+      local_grad += Npad;
+      local_lapl += Npad;
+    }
+  }
 
 public:
   AtomicOrbitals(int Lmax) : lmax(Lmax), lm_tot((Lmax + 1) * (Lmax + 1)), Ylm(Lmax)
@@ -197,33 +284,119 @@ public:
   template<typename DISPL, typename VM>
   inline void evaluateValues(const DISPL& Displacements, const int center_idx, const ST& r, VM& multi_myV)
   {
-    if (r <= std::numeric_limits<ST>::epsilon())
-      Ylm.evaluateV(0, 0, 1);
-    const ST* restrict Ylm_v = Ylm[0];
+    // the virtual particles are at the same distance, their Ylm are evaluated together
+    const size_t nvp = Displacements.size();
+    multi_xyz_.resize(nvp);
+    ST* restrict x = multi_xyz_.data(0);
+    ST* restrict y = multi_xyz_.data(1);
+    ST* restrict z = multi_xyz_.data(2);
+    for (int ivp = 0; ivp < nvp; ivp++)
+      if (r > std::numeric_limits<ST>::epsilon())
+      {
+        PointType dr = Displacements[ivp][center_idx];
+        x[ivp]       = -dr[0] / r;
+        y[ivp]       = -dr[1] / r;
+        z[ivp]       = -dr[2] / r;
+      }
+      else
+      {
+        x[ivp] = 0;
+        y[ivp] = 0;
+        z[ivp] = 1;
+      }
+    const size_t ldy = multi_xyz_.capacity();
+    multi_Ylm_v_.resize(lm_tot * ldy);
+    Ylm.block_evaluateV(x, y, z, nvp, multi_Ylm_v_.data(), ldy);
+    const ST* restrict Ylm_v = multi_Ylm_v_.data();
 
     const size_t m = multi_myV.cols();
     constexpr ST czero(0);
     std::fill(multi_myV.begin(), multi_myV.end(), czero);
     SplineInst->evaluate(r, localV);
 
-    for (int ivp = 0; ivp < Displacements.size(); ivp++)
+    for (int ivp = 0; ivp < nvp; ivp++)
     {
-      PointType dr = Displacements[ivp][center_idx];
-      if (r > std::numeric_limits<ST>::epsilon())
-        Ylm.evaluateV(-dr[0] / r, -dr[1] / r, -dr[2] / r);
-
       ST* restrict val       = multi_myV[ivp];
       ST* restrict local_val = localV.data();
       for (size_t lm = 0; lm < lm_tot; lm++)
       {
+        const ST Ylm_lm = Ylm_v[lm * ldy + ivp];
 #pragma omp simd aligned(val, local_val : QMC_SIMD_ALIGNMENT)
         for (size_t ib = 0; ib < m; ib++)
-          val[ib] += Ylm_v[lm] * local_val[ib];
+          val[ib] += Ylm_lm * local_val[ib];
         local_val += Npad;
       }
     }
   }
 
+  /** evaluateValues of a group of walkers, the Ylm of all their virtual particles are evaluated together
+   * @param displ_list displacements of the virtual particles of each walker
+   * @param center_idx_list index of this center in the displacements of each walker
+   * @param r_list distance of the virtual particles of each walker, one radial evaluation each
+   * @param multi_myV values, the virtual particles of the walkers one after the other
+   */
+  template<typename DISPL, typename VM>
+  inline void mw_evaluateValues(const RefVector<const DISPL>& displ_list,
+                                const std::vector<int>& center_idx_list,
+                                const std::vector<ST>& r_list,
+                                VM& multi_myV)
+  {
+    const size_t nw = displ_list.size();
+    size_t nvp_tot  = 0;
+    for (const DISPL& displ : displ_list)
+      nvp_tot += displ.size();
+    multi_xyz_.resize(nvp_tot);
+    ST* restrict x = multi_xyz_.data(0);
+    ST* restrict y = multi_xyz_.data(1);
+    ST* restrict z = multi_xyz_.data(2);
+    for (size_t iw = 0, ivp_tot = 0; iw < nw; iw++)
+    {
+      const DISPL& displ = displ_list[iw];
+      const ST r         = r_list[iw];
+      for (int ivp = 0; ivp < displ.size(); ivp++, ivp_tot++)
+        if (r > std::numeric_limits<ST>::epsilon())
+        {
+          PointType dr = displ[ivp][center_idx_list[iw]];
+          x[ivp_tot]   = -dr[0] / r;
+          y[ivp_tot]   = -dr[1] / r;
+          z[ivp_tot]   = -dr[2] / r;
+        }
+        else
+        {
+          x[ivp_tot] = 0;
+          y[ivp_tot] = 0;
+          z[ivp_tot] = 1;
+        }
+    }
+    const size_t ldy = multi_xyz_.capacity();
+    multi_Ylm_v_.resize(lm_tot * ldy);
+    Ylm.block_evaluateV(x, y, z, nvp_tot, multi_Ylm_v_.data(), ldy);
+    const ST* restrict Ylm_v = multi_Ylm_v_.data();
+
+    const size_t ld_local = lm_tot * Npad;
+    multi_localV_.resize(nw * ld_local);
+    for (size_t iw = 0; iw < nw; iw++)
+      SplineInst->evaluate_v_impl(r_list[iw], multi_localV_.data() + iw * ld_local);
+
+    const size_t m = multi_myV.cols();
+    constexpr ST czero(0);
+    std::fill(multi_myV.begin(), multi_myV.end(), czero);
+    for (size_t iw = 0, ivp_tot = 0; iw < nw; iw++)
+      for (int ivp = 0; ivp < displ_list[iw].get().size(); ivp++, ivp_tot++)
+      {
+        ST* restrict val       = multi_myV[ivp_tot];
+        ST* restrict local_val = multi_localV_.data() + iw * ld_local;
+        for (size_t lm = 0; lm < lm_tot; lm++)
+        {
+          const ST Ylm_lm = Ylm_v[lm * ldy + ivp_tot];
+#pragma omp simd aligned(val, local_val : QMC_SIMD_ALIGNMENT)
+          for (size_t ib = 0; ib < m; ib++)
+            val[ib] += Ylm_lm * local_val[ib];
+          local_val += Npad;
+        }
+      }
+  }
+
   //evaluate VGL
   template<typename VV, typename GV>
   inline void evaluate_vgl(const ST& r, const PointType& dr, VV& myV, GV& myG, VV& myL)
@@ -270,46 +443,7 @@ public:
     if (r > rmin_sqrt)
     {
       // far from core
-      r_power_minus_l[0] = cone;
-      ST r_power_temp    = cone;
-      for (int l = 1; l <= lmax; l++)
-      {
-        r_power_temp *= rinv;
-        for (int m = -l, lm = l * l; m <= l; m++, lm++)
-          r_power_minus_l[lm] = r_power_temp;
-      }
-
-      for (size_t lm = 0; lm < lm_tot; lm++)
-      {
-        const ST& l_val      = l_vals[lm];
-        const ST& r_power    = r_power_minus_l[lm];
-        const ST Ylm_rescale = Ylm_v[lm] * r_power;
-        const ST rhat_dot_G  = (rhatx * Ylm_gx[lm] + rhaty * Ylm_gy[lm] + rhatz * Ylm_gz[lm]) * r_power;
-#pragma omp simd aligned(val, g0, g1, g2, lapl, local_val, local_grad, local_lapl : QMC_SIMD_ALIGNMENT)
-        for (size_t ib = 0; ib < myV.size(); ib++)
-        {
-          const ST local_v = local_val[ib];
-          const ST local_g = local_grad[ib];
-          const ST local_l = local_lapl[ib];
-          // value
-          const ST Vpart = l_val * rinv * local_v;
-          val[ib] += Ylm_rescale * local_v;
-
-          // grad
-          const ST factor1 = local_g * Ylm_rescale;
-          const ST factor2 = local_v * r_power;
-          const ST factor3 = -Vpart * Ylm_rescale;
-          g0[ib] += factor1 * rhatx + factor2 * Ylm_gx[lm] + factor3 * rhatx;
-          g1[ib] += factor1 * rhaty + factor2 * Ylm_gy[lm] + factor3 * rhaty;
-          g2[ib] += factor1 * rhatz + factor2 * Ylm_gz[lm] + factor3 * rhatz;
-
-          // laplacian
-          lapl[ib] += (local_l + (local_g * (2 - l_val) - Vpart) * rinv) * Ylm_rescale + (local_g - Vpart) * rhat_dot_G;
-        }
-        local_val += Npad;
-        local_grad += Npad;
-        local_lapl += Npad;
-      }
+      accumulate_vgl_far(r, dr, Ylm_v, Ylm_gx, Ylm_gy, Ylm_gz, 1, local_val, local_grad, local_lapl, myV, myG, myL);
     }
     else if (r > rmin)
     {
@@ -394,6 +528,65 @@ public:
     }
   }
 
+  /** evaluate_vgl of a group of walkers, the Ylm of all their positions are evaluated together
+   * @param r_list,dr_list distances and displacements from this center
+   *
+   * Positions near the core are rare and go through evaluate_vgl.
+   */
+  template<typename VV, typename GV>
+  inline void mw_evaluate_vgl(const std::vector<ST>& r_list,
+                              const std::vector<PointType>& dr_list,
+                              const RefVector<VV>& myV_list,
+                              const RefVector<GV>& myG_list,
+                              const RefVector<VV>& myL_list)
+  {
+    const size_t nw = r_list.size();
+    multi_xyz_.resize(nw);
+    ST* restrict x = multi_xyz_.data(0);
+    ST* restrict y = multi_xyz_.data(1);
+    ST* restrict z = multi_xyz_.data(2);
+    for (size_t iw = 0; iw < nw; iw++)
+    {
+      x[iw] = dr_list[iw][0];
+      y[iw] = dr_list[iw][1];
+      z[iw] = dr_list[iw][2];
+    }
+    const size_t ldy    = multi_xyz_.capacity();
+    const size_t offset = lm_tot * ldy;
+    multi_Ylm_v_.resize(5 * offset);
+    Ylm.block_evaluateVGL(x, y, z, nw, multi_Ylm_v_.data(), ldy);
+
+    const size_t ld_local = lm_tot * Npad;
+    multi_localV_.resize(nw * ld_local);
+    multi_localG_.resize(nw * ld_local);
+    multi_localL_.resize(nw * ld_local);
+    constexpr ST czero(0);
+    for (size_t iw = 0; iw < nw; iw++)
+    {
+      if (r_list[iw] <= rmin_sqrt)
+      {
+        evaluate_vgl(r_list[iw], dr_list[iw], myV_list[iw].get(), myG_list[iw].get(), myL_list[iw].get());
+        continue;
+      }
+      ST* restrict local_val  = multi_localV_.data() + iw * ld_local;
+      ST* restrict local_grad = multi_localG_.data() + iw * ld_local;
+      ST* restrict local_lapl = multi_localL_.data() + iw * ld_local;
+      SplineInst->evaluate_vgl_impl(r_list[iw], local_val, local_grad, local_lapl);
+
+      VV& myV = myV_list[iw];
+      GV& myG = myG_list[iw];
+      VV& myL = myL_list[iw];
+      std::fill(myV.begin(), myV.end(), czero);
+      std::fill(myG.data(0), myG.data(0) + Npad, czero);
+      std::fill(myG.data(1), myG.data(1) + Npad, czero);
+      std::fill(myG.data(2), myG.data(2) + Npad, czero);
+      std::fill(myL.begin(), myL.end(), czero);
+      const ST* Ylm_vgl = multi_Ylm_v_.data() + iw;
+      accumulate_vgl_far(r_list[iw], dr_list[iw], Ylm_vgl, Ylm_vgl + offset, Ylm_vgl + 2 * offset,
+                         Ylm_vgl + 3 * offset, ldy, local_val, local_grad, local_lapl, myV, myG, myL);
+    }
+  }
+
   template<typename VV, typename GV, typename HT>
   void evaluate_vgh(const ST& r, const PointType& dr, VV& myV, GV& myG, HT& myH)
   {
@@ -501,6 +694,48 @@ public:
     RealType d2f_dr2;
   };
 
+  /// crowd partition in the mw_ functions of HybridRepReal and HybridRepCplx, only that of the crowd leader is used
+  struct MultiWalkerScratch
+  {
+    MultiWalkerScratch() = default;
+    /// clones start empty, the scratch only grows on the crowd leader
+    MultiWalkerScratch(const MultiWalkerScratch&) {}
+
+    /// walkers evaluated by the B-spline orbitals, by the atomic centered orbitals and walker by walker
+    std::vector<int> spline_walkers, atomic_walkers, other_walkers;
+    /// atomic center of each walker
+    std::vector<int> centers;
+    /// B-spline orbital arguments of the spline walkers, a list with a leader is recreated when the leader changes
+    std::unique_ptr<RefVectorWithLeader<SPOSet>> spline_spo_list;
+    std::unique_ptr<RefVectorWithLeader<const VirtualParticleSet>> spline_vp_list;
+    std::unique_ptr<RefVectorWithLeader<ParticleSet>> spline_P_list;
+    RefVector<SPOSet::ValueVector> spline_psi_list, spline_d2psi_list;
+    RefVector<SPOSet::GradVector> spline_dpsi_list;
+    std::vector<const SPOSet::ValueType*> spline_invRow_ptr_list;
+    /// ratios of the spline walkers, swapped with their ratios_list entries around the B-spline evaluation
+    std::vector<std::vector<SPOSet::ValueType>> spline_ratios_list;
+    /// walkers of one atomic center, their virtual particles or their locations and atomic centered orbitals
+    RefVector<const VirtualParticleSet> group_vps;
+    RefVector<const LocationSmoothingInfo> group_infos;
+    RefVector<Vector<ST, aligned_allocator<ST>>> group_v, group_l;
+    RefVector<VectorSoaContainer<ST, 3>> group_g;
+    /// AtomicOrbitals arguments of one atomic center
+    RefVector<const std::vector<DistanceTable::DisplRow>> group_displs;
+    std::vector<int> group_center_idx;
+    std::vector<ST> group_r;
+    std::vector<PointType> group_dr;
+
+    /// empty a list keeping its capacity
+    template<typename T>
+    static RefVectorWithLeader<T>& resetList(std::unique_ptr<RefVectorWithLeader<T>>& list, T& leader)
+    {
+      if (!list || &list->getLeader() != &leader)
+        list = std::make_unique<RefVectorWithLeader<T>>(leader);
+      list->clear();
+      return *list;
+    }
+  };
+
 private:
   ///atomic centers
   std::vector<AtomicOrbitals<ST>> AtomicCenters;
@@ -540,6 +775,24 @@ private:
       info.region = Region::INTER;
   }
 
+  /** collect the AtomicOrbitals arguments of the walkers in scratch.group_vps
+   * @return the reference center of their virtual particles
+   */
+  int collectVPGroup(MultiWalkerScratch& scratch) const
+  {
+    scratch.group_displs.clear();
+    scratch.group_center_idx.clear();
+    scratch.group_r.clear();
+    for (const VirtualParticleSet& VP : scratch.group_vps)
+    {
+      const int center_idx = VP.refSourcePtcl;
+      scratch.group_displs.push_back(VP.getDistTableAB(myTableID).getDisplacements());
+      scratch.group_center_idx.push_back(center_idx);
+      scratch.group_r.push_back(VP.getRefPS().getDistTableAB(myTableID).getDistRow(VP.refPtcl)[center_idx]);
+    }
+    return Super2Prim[scratch.group_center_idx[0]];
+  }
+
 public:
   HybridRepCenterOrbitals() {}
 
@@ -716,14 +969,27 @@ public:
         myCenter.getNonOverlappingRadius();
   }
 
+  /** select the region of the quadrature points of VP from the reference electron and the reference center
+   * It is the region used by evaluateValuesC2X and evaluateValuesR2R, VP must be batching safe.
+   * @return the reference center
+   */
+  inline int locateVP(const VirtualParticleSet& VP, LocationSmoothingInfo& info) const
+  {
+    const int center_idx = VP.refSourcePtcl;
+    const int center     = Super2Prim[center_idx];
+    info.dist_r          = VP.getRefPS().getDistTableAB(myTableID).getDistRow(VP.refPtcl)[center_idx];
+    auto& myCenter       = AtomicCenters[center];
+    selectRegionAndComputeSmoothing(myCenter.getCutoffBuffer(), myCenter.getCutoff(), info);
+    return center;
+  }
+
   // C2C, C2R cases
   template<typename VM>
   inline void evaluateValuesC2X(const VirtualParticleSet& VP, VM& multi_myV, LocationSmoothingInfo& info)
   {
     const int center_idx = VP.refSourcePtcl;
-    info.dist_r          = VP.getRefPS().getDistTableAB(myTableID).getDistRow(VP.refPtcl)[center_idx];
     auto& myCenter       = AtomicCenters[Super2Prim[center_idx]];
-    selectRegionAndComputeSmoothing(myCenter.getCutoffBuffer(), myCenter.getCutoff(), info);
+    locateVP(VP, info);
     if (info.region != Region::INTER)
       myCenter.evaluateValues(VP.getDistTableAB(myTableID).getDisplacements(), center_idx, info.dist_r, multi_myV);
   }
@@ -738,9 +1004,8 @@ public:
                                 LocationSmoothingInfo& info)
   {
     const int center_idx = VP.refSourcePtcl;
-    info.dist_r          = VP.getRefPS().getDistTableAB(myTableID).getDistRow(VP.refPtcl)[center_idx];
     auto& myCenter       = AtomicCenters[Super2Prim[center_idx]];
-    selectRegionAndComputeSmoothing(myCenter.getCutoffBuffer(), myCenter.getCutoff(), info);
+    locateVP(VP, info);
     if (info.region != Region::INTER)
     {
       const auto& displ = VP.getDistTableAB(myTableID).getDisplacements();
@@ -750,20 +1015,87 @@ public:
     }
   }
 
-  //evaluate only VGL
-  template<typename VV, typename GV>
-  inline void evaluate_vgl(const ParticleSet& P, const int iat, VV& myV, GV& myG, VV& myL, LocationSmoothingInfo& info)
+  /** evaluateValuesC2X of the walkers in scratch.group_vps, one block Ylm evaluation for all their virtual particles
+   * The VPs must be batching safe, share the reference center and be in the atomic regions.
+   * @param multi_myV values, the virtual particles of the walkers one after the other
+   */
+  template<typename VM>
+  inline void mw_evaluateValuesC2X(MultiWalkerScratch& scratch, VM& multi_myV)
+  {
+    const int center = collectVPGroup(scratch);
+    AtomicCenters[center].mw_evaluateValues(scratch.group_displs, scratch.group_center_idx, scratch.group_r,
+                                            multi_myV);
+  }
+
+  /// evaluateValuesR2R of the walkers in scratch.group_vps, see mw_evaluateValuesC2X
+  template<typename VM, typename Cell, typename SV>
+  inline void mw_evaluateValuesR2R(MultiWalkerScratch& scratch,
+                                   const Cell& PrimLattice,
+                                   TinyVector<int, D>& HalfG,
+                                   VM& multi_myV,
+                                   SV& bc_signs)
+  {
+    const int center = collectVPGroup(scratch);
+    auto& myCenter   = AtomicCenters[center];
+    for (size_t iw = 0, ivp_tot = 0; iw < scratch.group_vps.size(); iw++)
+    {
+      const VirtualParticleSet& VP = scratch.group_vps[iw];
+      const auto& displ            = scratch.group_displs[iw].get();
+      for (int ivp = 0; ivp < VP.getTotalNum(); ivp++, ivp_tot++)
+        bc_signs[ivp_tot] = get_bc_sign(VP.R[ivp], myCenter.getCenterPos() - displ[ivp][VP.refSourcePtcl],
+                                        PrimLattice, HalfG);
+    }
+    myCenter.mw_evaluateValues(scratch.group_displs, scratch.group_center_idx, scratch.group_r, multi_myV);
+  }
+
+  /** find the nearest center of electron iat and select its region
+   * @return the center to be passed to evaluate_vgl_at
+   *
+   * evaluate_vgl split in two steps so that a crowd of walkers can be partitioned by region before any evaluation.
+   */
+  inline int locate(const ParticleSet& P, const int iat, LocationSmoothingInfo& info) const
   {
     const auto& ei_dist  = P.getDistTableAB(myTableID);
     const int center_idx = ei_dist.get_first_neighbor(iat, info.dist_r, info.dist_dr, P.getActivePtcl() == iat);
-    auto& myCenter       = AtomicCenters[Super2Prim[center_idx]];
+    const int center     = Super2Prim[center_idx];
+    const auto& myCenter = AtomicCenters[center];
     selectRegionAndComputeSmoothing(myCenter.getCutoffBuffer(), myCenter.getCutoff(), info);
     if (info.region != Region::INTER)
+      info.r_image = myCenter.getCenterPos() - PointType(info.dist_dr[0], info.dist_dr[1], info.dist_dr[2]);
+    return center;
+  }
+
+  /// evaluate VGL of the atomic centered orbitals of the center and location found by locate
+  template<typename VV, typename GV>
+  inline void evaluate_vgl_at(int center, const LocationSmoothingInfo& info, VV& myV, GV& myG, VV& myL)
+  {
+    const PointType dr(-info.dist_dr[0], -info.dist_dr[1], -info.dist_dr[2]);
+    AtomicCenters[center].evaluate_vgl(info.dist_r, dr, myV, myG, myL);
+  }
+
+  /** evaluate_vgl_at of the walkers located at the same center
+   * The locations found by locate are scratch.group_infos and the results go to scratch.group_v, group_g and group_l.
+   */
+  inline void mw_evaluate_vgl_at(int center, MultiWalkerScratch& scratch)
+  {
+    scratch.group_r.clear();
+    scratch.group_dr.clear();
+    for (const LocationSmoothingInfo& info : scratch.group_infos)
     {
-      const PointType dr(-info.dist_dr[0], -info.dist_dr[1], -info.dist_dr[2]);
-      info.r_image = myCenter.getCenterPos() + dr;
-      myCenter.evaluate_vgl(info.dist_r, dr, myV, myG, myL);
+      scratch.group_r.push_back(info.dist_r);
+      scratch.group_dr.push_back(PointType(-info.dist_dr[0], -info.dist_dr[1], -info.dist_dr[2]));
     }
+    AtomicCenters[center].mw_evaluate_vgl(scratch.group_r, scratch.group_dr, scratch.group_v, scratch.group_g,
+                                          scratch.group_l);
+  }
+
+  //evaluate only VGL
+  template<typename VV, typename GV>
+  inline void evaluate_vgl(const ParticleSet& P, const int iat, VV& myV, GV& myG, VV& myL, LocationSmoothingInfo& info)
+  {
+    const int center = locate(P, iat, info);
+    if (info.region != Region::INTER)
+      evaluate_vgl_at(center, info, myV, myG, myL);
   }
 
   //evaluate only VGH
@@ -835,6 +1167,7 @@ public:
 
   template<class BSPLINESPO>
   friend class qmcplusplus::HybridRepSetReader;
+  friend class testing::HybridRepTests;
 };
 
 extern template class AtomicOrbitals<float>;
@@ -57,7 +57,10 @@ private:
   ValueVector psi_AO, d2psi_AO;
   GradVector dpsi_AO;
   Matrix<ST, aligned_allocator<ST>> multi_myV;
+  ///boundary condition signs of the virtual particles evaluated by the atomic centered orbitals
+  std::vector<int> bc_signs;
   typename HYBRIDBASE::LocationSmoothingInfo info;
+  typename HYBRIDBASE::MultiWalkerScratch mw_scratch_;
 
   using SPLINEBASE::HalfG;
   using SPLINEBASE::myG;
@@ -134,7 +137,7 @@ public:
       psi_AO.resize(psi.size());
       if (multi_myV.rows() < VP.getTotalNum())
         multi_myV.resize(VP.getTotalNum(), myV.size());
-      std::vector<int> bc_signs(VP.getTotalNum());
+      bc_signs.resize(VP.getTotalNum());
       HYBRIDBASE::evaluateValuesR2R(VP, PrimLattice, HalfG, multi_myV, bc_signs, info);
       for (int iat = 0; iat < VP.getTotalNum(); ++iat)
       {
@@ -163,13 +166,105 @@ public:
       }
   }
 
+  /** crowd-batched ratios, the walkers are partitioned by the region of their quadrature points
+   * Interstitial walkers go through one SPLINEBASE::mw_evaluateDetRatios call and atomic region walkers sharing a
+   * reference center through one group evaluation. Walkers in the buffer region or not safe for batching fall back to
+   * evaluateDetRatios.
+   */
   void mw_evaluateDetRatios(const RefVectorWithLeader<SPOSet>& spo_list,
                             const RefVectorWithLeader<const VirtualParticleSet>& vp_list,
                             const RefVector<ValueVector>& psi_list,
                             const std::vector<const ValueType*>& invRow_ptr_list,
                             std::vector<std::vector<ValueType>>& ratios_list) const final
   {
-    BsplineSet::mw_evaluateDetRatios(spo_list, vp_list, psi_list, invRow_ptr_list, ratios_list);
+    assert(this == &spo_list.getLeader());
+    auto& leader    = spo_list.template getCastedLeader<HybridRepReal>();
+    auto& scratch   = leader.mw_scratch_;
+    const size_t nw = spo_list.size();
+
+    // partition the walkers by the region of their quadrature points
+    auto& spline_spo_list = scratch.resetList(scratch.spline_spo_list, spo_list.getLeader());
+    auto& spline_vp_list  = scratch.resetList(scratch.spline_vp_list, vp_list.getLeader());
+    scratch.spline_psi_list.clear();
+    scratch.spline_invRow_ptr_list.clear();
+    scratch.spline_walkers.clear();
+    scratch.atomic_walkers.clear();
+    scratch.other_walkers.clear();
+    scratch.centers.resize(nw);
+    for (int iw = 0; iw < nw; iw++)
+    {
+      auto& hybrid                 = spo_list.template getCastedElement<HybridRepReal>(iw);
+      const VirtualParticleSet& VP = vp_list[iw];
+      if (!VP.isOnSphere() || !hybrid.HYBRIDBASE::is_VP_batching_safe(VP))
+      {
+        scratch.other_walkers.push_back(iw);
+        continue;
+      }
+      scratch.centers[iw] = hybrid.HYBRIDBASE::locateVP(VP, hybrid.info);
+      if (hybrid.info.region == Region::INTER)
+      {
+        scratch.spline_walkers.push_back(iw);
+        spline_spo_list.push_back(spo_list[iw]);
+        spline_vp_list.push_back(VP);
+        scratch.spline_psi_list.push_back(psi_list[iw]);
+        scratch.spline_invRow_ptr_list.push_back(invRow_ptr_list[iw]);
+      }
+      else if (hybrid.info.region == Region::INSIDE)
+        scratch.atomic_walkers.push_back(iw);
+      else
+        scratch.other_walkers.push_back(iw);
+    }
+
+    // atomic region, the walkers grouped by reference center, one radial evaluation per walker for all the groups
+    auto& atomic_walkers = scratch.atomic_walkers;
+    std::stable_sort(atomic_walkers.begin(), atomic_walkers.end(),
+                     [&centers = scratch.centers](int iw, int jw) { return centers[iw] < centers[jw]; });
+    for (size_t first = 0, last = 0; first < atomic_walkers.size(); first = last)
+    {
+      const int center = scratch.centers[atomic_walkers[first]];
+      size_t nvp_tot   = 0;
+      scratch.group_vps.clear();
+      for (last = first; last < atomic_walkers.size() && scratch.centers[atomic_walkers[last]] == center; last++)
+      {
+        scratch.group_vps.push_back(vp_list[atomic_walkers[last]]);
+        nvp_tot += vp_list[atomic_walkers[last]].getTotalNum();
+      }
+      if (leader.multi_myV.rows() < nvp_tot)
+        leader.multi_myV.resize(nvp_tot, myV.size());
+      leader.bc_signs.resize(nvp_tot);
+      leader.HYBRIDBASE::mw_evaluateValuesR2R(scratch, PrimLattice, leader.HalfG, leader.multi_myV, leader.bc_signs);
+      for (size_t i = first, ivp_tot = 0; i < last; i++)
+      {
+        const int iw     = atomic_walkers[i];
+        ValueVector& psi = psi_list[iw];
+        for (int iat = 0; iat < vp_list[iw].getTotalNum(); ++iat, ++ivp_tot)
+        {
+          Vector<ST, aligned_allocator<ST>> myV_one(leader.multi_myV[ivp_tot], myV.size());
+          SPLINEBASE::assign_v(leader.bc_signs[ivp_tot], myV_one, psi, 0, myV.size());
+          ratios_list[iw][iat] = simd::dot(psi.data(), invRow_ptr_list[iw], psi.size());
+        }
+      }
+    }
+
+    // interstitial region, one batched B-spline evaluation writing to the ratios of the walkers swapped in
+    if (!scratch.spline_walkers.empty())
+    {
+      auto& spline_ratios_list = scratch.spline_ratios_list;
+      spline_ratios_list.resize(scratch.spline_walkers.size());
+      for (int i = 0; i < scratch.spline_walkers.size(); i++)
+        spline_ratios_list[i].swap(ratios_list[scratch.spline_walkers[i]]);
+      SPLINEBASE::mw_evaluateDetRatios(spline_spo_list, spline_vp_list, scratch.spline_psi_list,
+                                       scratch.spline_invRow_ptr_list, spline_ratios_list);
+      for (int i = 0; i < scratch.spline_walkers.size(); i++)
+        spline_ratios_list[i].swap(ratios_list[scratch.spline_walkers[i]]);
+    }
+
+    // buffer region or unsafe batching, walker by walker
+    for (const int iw : scratch.other_walkers)
+    {
+      const ValueVector invRow(const_cast<ValueType*>(invRow_ptr_list[iw]), psi_list[iw].get().size());
+      spo_list[iw].evaluateDetRatios(vp_list[iw], psi_list[iw], invRow, ratios_list[iw]);
+    }
   }
 
   void evaluateVGL(const ParticleSet& P, const int iat, ValueVector& psi, GradVector& dpsi, ValueVector& d2psi) override
@@ -192,6 +287,11 @@ public:
     }
   }
 
+  /** crowd-batched VGL, the walkers are partitioned by the region of electron iat
+   * The atomic centered orbitals of the atomic and buffer region walkers are evaluated by one group evaluation per
+   * center and the B-spline orbitals of the buffer and interstitial region walkers by one SPLINEBASE::mw_evaluateVGL
+   * call.
+   */
   void mw_evaluateVGL(const RefVectorWithLeader<SPOSet>& sa_list,
                       const RefVectorWithLeader<ParticleSet>& P_list,
                       int iat,
@@ -199,18 +299,85 @@ public:
                       const RefVector<GradVector>& dpsi_v_list,
                       const RefVector<ValueVector>& d2psi_v_list) const final
   {
-    BsplineSet::mw_evaluateVGL(sa_list, P_list, iat, psi_v_list, dpsi_v_list, d2psi_v_list);
-  }
+    assert(this == &sa_list.getLeader());
+    auto& leader    = sa_list.template getCastedLeader<HybridRepReal>();
+    auto& scratch   = leader.mw_scratch_;
+    const size_t nw = sa_list.size();
 
-  void mw_evaluateVGLandDetRatioGrads(const RefVectorWithLeader<SPOSet>& spo_list,
-                                      const RefVectorWithLeader<ParticleSet>& P_list,
-                                      int iat,
-                                      const std::vector<const ValueType*>& invRow_ptr_list,
-                                      OffloadMWVGLArray& phi_vgl_v,
-                                      std::vector<ValueType>& ratios,
-                                      std::vector<GradType>& grads) const final
-  {
-    BsplineSet::mw_evaluateVGLandDetRatioGrads(spo_list, P_list, iat, invRow_ptr_list, phi_vgl_v, ratios, grads);
+    // partition the walkers by the region of electron iat
+    auto& spline_sa_list = scratch.resetList(scratch.spline_spo_list, sa_list.getLeader());
+    auto& spline_P_list  = scratch.resetList(scratch.spline_P_list, P_list.getLeader());
+    scratch.spline_psi_list.clear();
+    scratch.spline_dpsi_list.clear();
+    scratch.spline_d2psi_list.clear();
+    scratch.atomic_walkers.clear();
+    scratch.centers.resize(nw);
+    for (int iw = 0; iw < nw; iw++)
+    {
+      auto& hybrid        = sa_list.template getCastedElement<HybridRepReal>(iw);
+      scratch.centers[iw] = hybrid.HYBRIDBASE::locate(P_list[iw], iat, hybrid.info);
+      if (hybrid.info.region != Region::INTER)
+        scratch.atomic_walkers.push_back(iw);
+      if (hybrid.info.region != Region::INSIDE)
+      {
+        spline_sa_list.push_back(sa_list[iw]);
+        spline_P_list.push_back(P_list[iw]);
+        scratch.spline_psi_list.push_back(psi_v_list[iw]);
+        scratch.spline_dpsi_list.push_back(dpsi_v_list[iw]);
+        scratch.spline_d2psi_list.push_back(d2psi_v_list[iw]);
+      }
+    }
+
+    // atomic and buffer regions, the walkers grouped by center
+    auto& atomic_walkers = scratch.atomic_walkers;
+    std::stable_sort(atomic_walkers.begin(), atomic_walkers.end(),
+                     [&centers = scratch.centers](int iw, int jw) { return centers[iw] < centers[jw]; });
+    for (size_t first = 0, last = 0; first < atomic_walkers.size(); first = last)
+    {
+      const int center = scratch.centers[atomic_walkers[first]];
+      scratch.group_infos.clear();
+      scratch.group_v.clear();
+      scratch.group_g.clear();
+      scratch.group_l.clear();
+      for (last = first; last < atomic_walkers.size() && scratch.centers[atomic_walkers[last]] == center; last++)
+      {
+        auto& hybrid = sa_list.template getCastedElement<HybridRepReal>(atomic_walkers[last]);
+        scratch.group_infos.push_back(hybrid.info);
+        scratch.group_v.push_back(hybrid.myV);
+        scratch.group_g.push_back(hybrid.myG);
+        scratch.group_l.push_back(hybrid.myL);
+      }
+      leader.HYBRIDBASE::mw_evaluate_vgl_at(center, scratch);
+    }
+    for (const int iw : atomic_walkers)
+    {
+      auto& hybrid = sa_list.template getCastedElement<HybridRepReal>(iw);
+      const int bc_sign =
+          hybrid.HYBRIDBASE::get_bc_sign(P_list[iw].activeR(iat), hybrid.info.r_image, PrimLattice, hybrid.HalfG);
+      if (hybrid.info.region == Region::INSIDE)
+        hybrid.SPLINEBASE::assign_vgl_from_l(bc_sign, psi_v_list[iw], dpsi_v_list[iw], d2psi_v_list[iw]);
+      else
+      {
+        const size_t norb = psi_v_list[iw].get().size();
+        hybrid.psi_AO.resize(norb);
+        hybrid.dpsi_AO.resize(norb);
+        hybrid.d2psi_AO.resize(norb);
+        hybrid.SPLINEBASE::assign_vgl_from_l(bc_sign, hybrid.psi_AO, hybrid.dpsi_AO, hybrid.d2psi_AO);
+      }
+    }
+
+    // buffer and interstitial regions, one batched B-spline evaluation
+    if (!spline_sa_list.empty())
+      SPLINEBASE::mw_evaluateVGL(spline_sa_list, spline_P_list, iat, scratch.spline_psi_list, scratch.spline_dpsi_list,
+                                 scratch.spline_d2psi_list);
+
+    for (const int iw : atomic_walkers)
+    {
+      auto& hybrid = sa_list.template getCastedElement<HybridRepReal>(iw);
+      if (hybrid.info.region == Region::BUFFER)
+        hybrid.HYBRIDBASE::interpolate_buffer_vgl(psi_v_list[iw].get(), dpsi_v_list[iw].get(), d2psi_v_list[iw].get(),
+                                                  hybrid.psi_AO, hybrid.dpsi_AO, hybrid.d2psi_AO, hybrid.info);
+    }
   }
 
   void evaluateVGH(const ParticleSet& P,
@@ -254,6 +421,7 @@ public:
   template<class BSPLINESPO>
   friend class SplineSetReader;
   friend struct BsplineReader;
+  friend class testing::HybridRepTests;
 };
 
 } // namespace qmcplusplus
@@ -140,6 +140,8 @@ std::unique_ptr<SPOSet> HybridRepSetReader<SA>::create_spline_set(const std::str
                                                                   int spin,
                                                                   const BandInfoGroup& bandgroup)
 {
+  if (useSymmetry)
+    myComm->barrier_and_abort("HybridRepSetReader does not support use_symmetry=\"yes\".");
   auto bspline = std::make_unique<SA>(my_name);
   app_log() << "  ClassName = " << bspline->getClassName() << std::endl;
   // set info for Hybrid
@@ -186,6 +188,7 @@ std::unique_ptr<SPOSet> HybridRepSetReader<SA>::create_spline_set(const std::str
     bspline->bcast_tables(myComm);
     app_log() << "  Time to bcast the table = " << now.elapsed() << std::endl;
   }
+  compress_tables(*bspline);
   return bspline;
 }
 
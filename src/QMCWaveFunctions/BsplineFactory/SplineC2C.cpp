@@ -32,8 +32,8 @@ inline void SplineC2C<ST>::set_spline(SingleSplineType* spline_r,
                                       int ispline,
                                       int level)
 {
-  SplineInst->copy_spline(spline_r, 2 * ispline);
-  SplineInst->copy_spline(spline_i, 2 * ispline + 1);
+  getFullTable("set_spline").copy_spline(spline_r, 2 * ispline);
+  getFullTable("set_spline").copy_spline(spline_i, 2 * ispline + 1);
 }
 
 template<typename ST>
@@ -41,7 +41,7 @@ bool SplineC2C<ST>::read_splines(hdf_archive& h5f)
 {
   std::ostringstream o;
   o << "spline_" << MyIndex;
-  einspline_engine<SplineType> bigtable(SplineInst->getSplinePtr());
+  einspline_engine<SplineType> bigtable(getFullTable("read_splines").getSplinePtr());
   return h5f.readEntry(bigtable, o.str().c_str()); //"spline_0");
 }
 
@@ -50,14 +50,158 @@ bool SplineC2C<ST>::write_splines(hdf_archive& h5f)
 {
   std::ostringstream o;
   o << "spline_" << MyIndex;
-  einspline_engine<SplineType> bigtable(SplineInst->getSplinePtr());
+  einspline_engine<SplineType> bigtable(getFullTable("write_splines").getSplinePtr());
   return h5f.writeEntry(bigtable, o.str().c_str()); //"spline_0");
 }
 
+template<typename ST>
+SplineCompressionError SplineC2C<ST>::compress_tables()
+{
+  CompressedInst = std::make_shared<MultiBsplineCompressed<ST>>(*getFullTable("compress_tables").getSplinePtr());
+  app_log() << "MEMORY " << CompressedInst->sizeInByte() / (1 << 20) << " MB allocated "
+            << "for the 16 bit compressed coefficients in 3D spline orbital representation, replacing "
+            << SplineInst->sizeInByte() / (1 << 20) << " MB" << std::endl;
+  const auto error = spline2::compressionError(SplineInst->getSplinePtr(), CompressedInst->getSplinePtr(), 64);
+  SplineInst.reset();
+  return error;
+}
+
+template<typename ST>
+void SplineC2C<ST>::set_symmetry_images(std::shared_ptr<const SplineSymmetryImages> images)
+{
+  SymmetryImages = std::move(images);
+  BandIndexMap.resize(SymmetryImages->slot_orbitals.size());
+  std::copy(SymmetryImages->slot_orbitals.begin(), SymmetryImages->slot_orbitals.end(), BandIndexMap.begin());
+  const size_t npad = getAlignedSize<ST>(2 * SymmetryImages->num_image_slots);
+  imageV.resize(npad);
+  imageG.resize(npad);
+  imageH.resize(npad);
+  imagegH.resize(npad);
+}
+
+template<typename ST>
+void SplineC2C<ST>::evaluate_v_images(const PointType& ru)
+{
+  const auto& blocks   = SymmetryImages->blocks;
+  const int num_blocks = blocks.size();
+#pragma omp for
+  for (int ib = 0; ib < num_blocks; ib++)
+  {
+    const auto& block        = blocks[ib];
+    const int num_splines    = 2 * block.orbitals.size();
+    const PointType ru_image = SplineSymmetryImages::mapPosition(block, ru);
+    ST* restrict vals        = imageV.data() + 2 * block.image_slot;
+    applyToSpline([&](const auto* spline) {
+      spline2::evaluate_v_impl(spline, ru_image[0], ru_image[1], ru_image[2], vals, 2 * block.first_slot,
+                               2 * block.first_slot + num_splines);
+    });
+    for (int is = 0; is < num_splines; is++)
+    {
+      const int j   = 2 * block.orbitals[is / 2] + is % 2;
+      const ST sign = block.conjugate && is % 2 ? -1 : 1;
+      myV[j]        = sign * vals[is];
+    }
+  }
+}
+
+template<typename ST>
+void SplineC2C<ST>::evaluate_vgh_images(const PointType& ru)
+{
+  const auto& blocks   = SymmetryImages->blocks;
+  const int num_blocks = blocks.size();
+#pragma omp for
+  for (int ib = 0; ib < num_blocks; ib++)
+  {
+    const auto& block        = blocks[ib];
+    const int num_splines    = 2 * block.orbitals.size();
+    const int offset         = 2 * block.image_slot;
+    const PointType ru_image = SplineSymmetryImages::mapPosition(block, ru);
+    applyToSpline([&](const auto* spline) {
+      spline2::evaluate_vgh_impl(spline, ru_image[0], ru_image[1], ru_image[2], imageV.data() + offset,
+                                 imageG.data() + offset, imageH.data() + offset, imageV.size(), 2 * block.first_slot,
+                                 2 * block.first_slot + num_splines);
+    });
+    for (int is = offset; is < offset + num_splines; is++)
+    {
+      const int j   = 2 * block.orbitals[(is - offset) / 2] + is % 2;
+      const ST sign = block.conjugate && is % 2 ? -1 : 1;
+      const auto g  = imageGradient(block.rot_inv, TinyVector<ST, 3>(imageG.data(0)[is], imageG.data(1)[is],
+                                                                    imageG.data(2)[is]));
+      const auto h  = imageHessian(block.rot_inv,
+                                   Tensor<ST, 3>(imageH.data(0)[is], imageH.data(1)[is], imageH.data(2)[is],
+                                                 imageH.data(1)[is], imageH.data(3)[is], imageH.data(4)[is],
+                                                 imageH.data(2)[is], imageH.data(4)[is], imageH.data(5)[is]));
+      myV[j] = sign * imageV[is];
+      for (int i = 0; i < 3; i++)
+        myG.data(i)[j] = sign * g[i];
+      myH.data(0)[j] = sign * h(0, 0);
+      myH.data(1)[j] = sign * h(0, 1);
+      myH.data(2)[j] = sign * h(0, 2);
+      myH.data(3)[j] = sign * h(1, 1);
+      myH.data(4)[j] = sign * h(1, 2);
+      myH.data(5)[j] = sign * h(2, 2);
+    }
+  }
+}
+
+template<typename ST>
+void SplineC2C<ST>::evaluate_vghgh_images(const PointType& ru)
+{
+  // component of the packed third derivatives for each index triple
+  constexpr int gh_index[3][3][3] = {{{0, 1, 2}, {1, 3, 4}, {2, 4, 5}},
+                                     {{1, 3, 4}, {3, 6, 7}, {4, 7, 8}},
+                                     {{2, 4, 5}, {4, 7, 8}, {5, 8, 9}}};
+  const auto& blocks   = SymmetryImages->blocks;
+  const int num_blocks = blocks.size();
+#pragma omp for
+  for (int ib = 0; ib < num_blocks; ib++)
+  {
+    const auto& block        = blocks[ib];
+    const int num_splines    = 2 * block.orbitals.size();
+    const int offset         = 2 * block.image_slot;
+    const PointType ru_image = SplineSymmetryImages::mapPosition(block, ru);
+    applyToSpline([&](const auto* spline) {
+      spline2::evaluate_vghgh_impl(spline, ru_image[0], ru_image[1], ru_image[2], imageV.data() + offset,
+                                   imageG.data() + offset, imageH.data() + offset, imagegH.data() + offset,
+                                   imageV.size(), 2 * block.first_slot, 2 * block.first_slot + num_splines);
+    });
+    for (int is = offset; is < offset + num_splines; is++)
+    {
+      const int j   = 2 * block.orbitals[(is - offset) / 2] + is % 2;
+      const ST sign = block.conjugate && is % 2 ? -1 : 1;
+      const auto g  = imageGradient(block.rot_inv, TinyVector<ST, 3>(imageG.data(0)[is], imageG.data(1)[is],
+                                                                    imageG.data(2)[is]));
+      const auto h  = imageHessian(block.rot_inv,
+                                   Tensor<ST, 3>(imageH.data(0)[is], imageH.data(1)[is], imageH.data(2)[is],
+                                                 imageH.data(1)[is], imageH.data(3)[is], imageH.data(4)[is],
+                                                 imageH.data(2)[is], imageH.data(4)[is], imageH.data(5)[is]));
+      TinyVector<Tensor<ST, 3>, 3> gh;
+      for (int a = 0; a < 3; a++)
+        for (int b = 0; b < 3; b++)
+          for (int c = 0; c < 3; c++)
+            gh[a](b, c) = imagegH.data(gh_index[a][b][c])[is];
+      gh = imageGradHessian(block.rot_inv, gh);
+      myV[j] = sign * imageV[is];
+      for (int i = 0; i < 3; i++)
+        myG.data(i)[j] = sign * g[i];
+      myH.data(0)[j] = sign * h(0, 0);
+      myH.data(1)[j] = sign * h(0, 1);
+      myH.data(2)[j] = sign * h(0, 2);
+      myH.data(3)[j] = sign * h(1, 1);
+      myH.data(4)[j] = sign * h(1, 2);
+      myH.data(5)[j] = sign * h(2, 2);
+      for (int a = 0; a < 3; a++)
+        for (int b = a; b < 3; b++)
+          for (int c = b; c < 3; c++)
+            mygH.data(gh_index[a][b][c])[j] = sign * gh[a](b, c);
+    }
+  }
+}
+
 template<typename ST>
 void SplineC2C<ST>::storeParamsBeforeRotation()
 {
-  const auto spline_ptr     = SplineInst->getSplinePtr();
+  const auto spline_ptr     = getFullTable("storeParamsBeforeRotation").getSplinePtr();
   const auto coefs_tot_size = spline_ptr->coefs_size;
   coef_copy_                = std::make_shared<std::vector<ST>>(coefs_tot_size);
 
@@ -107,7 +251,7 @@ template<typename ST>
 void SplineC2C<ST>::applyRotation(const ValueMatrix& rot_mat, bool use_stored_copy)
 {
   // SplineInst is a MultiBspline. See src/spline2/MultiBspline.hpp
-  const auto spline_ptr = SplineInst->getSplinePtr();
+  const auto spline_ptr = getFullTable("applyRotation").getSplinePtr();
   assert(spline_ptr != nullptr);
   const auto spl_coefs      = spline_ptr->coefs;
   const auto Nsplines       = spline_ptr->num_splines; // May include padding
@@ -185,6 +329,42 @@ inline void SplineC2C<ST>::assign_v(const PointType& r,
   }
 }
 
+template<typename ST>
+inline typename SplineC2C<ST>::ComplexT SplineC2C<ST>::contract_v(const PointType& r,
+                                                                  const ST* vals,
+                                                                  const ComplexT* invrow,
+                                                                  size_t requested_orb_size,
+                                                                  int first,
+                                                                  int last) const
+{
+  using RealT = typename ComplexT::value_type;
+  // protect last
+  const size_t last_cplx = std::min(kPoints.size(), requested_orb_size);
+  last                   = last > last_cplx ? last_cplx : last;
+
+  const ST x = r[0], y = r[1], z = r[2];
+  const ST* restrict kx = myKcart.data(0);
+  const ST* restrict ky = myKcart.data(1);
+  const ST* restrict kz = myKcart.data(2);
+
+  // complex reductions are not supported by omp simd, accumulate the real and imaginary parts
+  const RealT* restrict inv_s = reinterpret_cast<const RealT*>(invrow + first_spo);
+  RealT sum_r(0), sum_i(0);
+#pragma omp simd reduction(+ : sum_r, sum_i)
+  for (size_t j = first; j < last; ++j)
+  {
+    ST s, c;
+    const ST val_r = vals[2 * (j - first)];
+    const ST val_i = vals[2 * (j - first) + 1];
+    qmcplusplus::sincos(-(x * kx[j] + y * ky[j] + z * kz[j]), &s, &c);
+    const RealT psi_r = val_r * c - val_i * s;
+    const RealT psi_i = val_i * c + val_r * s;
+    sum_r += inv_s[2 * j] * psi_r - inv_s[2 * j + 1] * psi_i;
+    sum_i += inv_s[2 * j] * psi_i + inv_s[2 * j + 1] * psi_r;
+  }
+  return ComplexT(sum_r, sum_i);
+}
+
 template<typename ST>
 void SplineC2C<ST>::evaluateValue(const ParticleSet& P, const int iat, ValueVector& psi)
 {
@@ -197,7 +377,10 @@ void SplineC2C<ST>::evaluateValue(const ParticleSet& P, const int iat, ValueVect
     // Factor of 2 because psi is complex and the spline storage and evaluation uses a real type
     FairDivideAligned(2 * psi.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
+    if (SymmetryImages)
+      evaluate_v_images(ru);
+    else
+      applyToSpline([&](const auto* spline) { spline2::evaluate3d(spline, ru, myV, first, last); });
     assign_v(r, myV, psi, first / 2, last / 2);
   }
 }
@@ -231,9 +414,25 @@ void SplineC2C<ST>::evaluateDetRatios(const VirtualParticleSet& VP,
       const PointType& r = VP.activeR(iat);
       PointType ru(PrimLattice.toUnit_floor(r));
 
-      spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
-      assign_v(r, myV, psi, first_cplx, last_cplx);
-      ratios_private[iat][tid] = simd::dot(psi.data() + first_cplx, psiinv.data() + first_cplx, last_cplx - first_cplx);
+      if (SymmetryImages)
+      {
+        // the blocks write into the ranges of all the threads, wait for the previous position to be consumed
+#pragma omp barrier
+        evaluate_v_images(ru);
+        assign_v(r, myV, psi, first_cplx, last_cplx);
+        ratios_private[iat][tid] =
+            simd::dot(psi.data() + first_cplx, psiinv.data() + first_cplx, last_cplx - first_cplx);
+        continue;
+      }
+
+      // psi is only a scratch space, the ratio is contracted from the spline values directly
+      ComplexT ratio(0);
+      applyToSpline([&](const auto* spline) {
+        spline2::evaluate3d_contract(spline, ru, first, last, [&](const ST* vals, int tile_first, int tile_last) {
+          ratio += contract_v(r, vals, psiinv.data(), psi.size(), tile_first / 2, tile_last / 2);
+        });
+      });
+      ratios_private[iat][tid] = ratio;
     }
   }
 
@@ -246,6 +445,80 @@ void SplineC2C<ST>::evaluateDetRatios(const VirtualParticleSet& VP,
   }
 }
 
+template<typename ST>
+void SplineC2C<ST>::mw_evaluateDetRatios(const RefVectorWithLeader<SPOSet>& spo_list,
+                                         const RefVectorWithLeader<const VirtualParticleSet>& vp_list,
+                                         const RefVector<ValueVector>& psi_list,
+                                         const std::vector<const ValueType*>& invRow_ptr_list,
+                                         std::vector<std::vector<ValueType>>& ratios_list) const
+{
+  assert(this == &spo_list.getLeader());
+  if (SymmetryImages)
+  {
+    // a block of splines does not hold a contiguous range of orbitals, evaluate walker by walker
+    BsplineSet::mw_evaluateDetRatios(spo_list, vp_list, psi_list, invRow_ptr_list, ratios_list);
+    return;
+  }
+  auto& spo_leader = spo_list.getCastedLeader<SplineC2C<ST>>();
+  const size_t nw  = spo_list.size();
+
+  // positions of all the quadrature points of all the walkers
+  auto& pos_scratch = spo_leader.mw_pos_scratch_;
+  auto& walker_ids  = pos_scratch.walker_ids;
+  auto& rs          = pos_scratch.rs;
+  auto& rus         = pos_scratch.rus;
+  pos_scratch.clear();
+  for (int iw = 0; iw < nw; iw++)
+    for (int iat = 0; iat < vp_list[iw].getTotalNum(); ++iat)
+    {
+      const PointType& r = vp_list[iw].activeR(iat);
+      rs.push_back(r);
+      rus.push_back(PrimLattice.toUnit_floor(r));
+      walker_ids.push_back(iw);
+    }
+  const int num_points = rus.size();
+
+  auto& ratios_private   = spo_leader.ratios_private;
+  const bool need_resize = ratios_private.rows() < num_points;
+#pragma omp parallel
+  {
+    int tid = omp_get_thread_num();
+    if (need_resize)
+    {
+      if (tid == 0)
+        ratios_private.resize(num_points, omp_get_num_threads());
+#pragma omp barrier
+    }
+    for (int ip = 0; ip < num_points; ++ip)
+      ratios_private[ip][tid] = ComplexT(0);
+
+    int first, last;
+    // Factor of 2 because psi is complex and the spline storage and evaluation uses a real type
+    FairDivideAligned(2 * psi_list[0].get().size(), getAlignment<ST>(), omp_get_num_threads(), tid, first, last);
+    // all the points are evaluated on one block of splines before moving to the next one
+    for (int first_block = first; first_block < last; first_block += mw_spline_block_size)
+    {
+      const int last_block = std::min(first_block + mw_spline_block_size, last);
+      const auto contract  = [&](int ip, const ST* vals, int tile_first, int tile_last) {
+        const int iw = walker_ids[ip];
+        ratios_private[ip][tid] += contract_v(rs[ip], vals, invRow_ptr_list[iw], psi_list[iw].get().size(),
+                                              tile_first / 2, tile_last / 2);
+      };
+      applyToSpline([&](const auto* spline) {
+        spline2::evaluate3d_contract_multi(spline, rus, first_block, last_block, contract);
+      });
+    }
+  }
+
+  for (int ip = 0, iw = 0; iw < nw; iw++)
+    for (int iat = 0; iat < vp_list[iw].getTotalNum(); ++iat, ++ip)
+    {
+      ratios_list[iw][iat] = ComplexT(0);
+      for (int tid = 0; tid < ratios_private.cols(); tid++)
+        ratios_list[iw][iat] += ratios_private[ip][tid];
+    }
+}
+
 /** assign_vgl
    */
 template<typename ST>
@@ -407,11 +680,59 @@ void SplineC2C<ST>::evaluateVGL(const ParticleSet& P,
     // Factor of 2 because psi is complex and the spline storage and evaluation uses a real type
     FairDivideAligned(2 * psi.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+    if (SymmetryImages)
+      evaluate_vgh_images(ru);
+    else
+      applyToSpline([&](const auto* spline) { spline2::evaluate3d_vgh(spline, ru, myV, myG, myH, first, last); });
     assign_vgl(r, psi, dpsi, d2psi, first / 2, last / 2);
   }
 }
 
+template<typename ST>
+void SplineC2C<ST>::mw_evaluateVGL(const RefVectorWithLeader<SPOSet>& spo_list,
+                                   const RefVectorWithLeader<ParticleSet>& P_list,
+                                   int iat,
+                                   const RefVector<ValueVector>& psi_v_list,
+                                   const RefVector<GradVector>& dpsi_v_list,
+                                   const RefVector<ValueVector>& d2psi_v_list) const
+{
+  assert(this == &spo_list.getLeader());
+  if (SymmetryImages)
+  {
+    // a block of splines does not hold a contiguous range of orbitals, evaluate walker by walker
+    BsplineSet::mw_evaluateVGL(spo_list, P_list, iat, psi_v_list, dpsi_v_list, d2psi_v_list);
+    return;
+  }
+  auto& spo_leader = spo_list.getCastedLeader<SplineC2C<ST>>();
+  const size_t nw  = spo_list.size();
+
+  auto& rus = spo_leader.mw_pos_scratch_.rus;
+  rus.resize(nw);
+  for (int iw = 0; iw < nw; iw++)
+    rus[iw] = PrimLattice.toUnit_floor(P_list[iw].activeR(iat));
+
+#pragma omp parallel
+  {
+    int first, last;
+    // Factor of 2 because psi is complex and the spline storage and evaluation uses a real type
+    FairDivideAligned(2 * psi_v_list[0].get().size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(),
+                      first, last);
+    // all the walkers are evaluated on one block of splines before moving to the next one
+    for (int first_block = first; first_block < last; first_block += mw_spline_block_size)
+    {
+      const int last_block = std::min(first_block + mw_spline_block_size, last);
+      const auto consume = [&](int iw) {
+        assign_vgl(P_list[iw].activeR(iat), psi_v_list[iw], dpsi_v_list[iw], d2psi_v_list[iw], first_block / 2,
+                   last_block / 2);
+      };
+      applyToSpline([&](const auto* spline) {
+        spline2::evaluate3d_vgh_multi(spline, rus, spo_leader.myV, spo_leader.myG, spo_leader.myH, first_block,
+                                      last_block, consume);
+      });
+    }
+  }
+}
+
 template<typename ST>
 void SplineC2C<ST>::assign_vgh(const PointType& r,
                                ValueVector& psi,
@@ -548,7 +869,10 @@ void SplineC2C<ST>::evaluateVGH(const ParticleSet& P,
     // Factor of 2 because psi is complex and the spline storage and evaluation uses a real type
     FairDivideAligned(2 * psi.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+    if (SymmetryImages)
+      evaluate_vgh_images(ru);
+    else
+      applyToSpline([&](const auto* spline) { spline2::evaluate3d_vgh(spline, ru, myV, myG, myH, first, last); });
     assign_vgh(r, psi, dpsi, grad_grad_psi, first / 2, last / 2);
   }
 }
@@ -805,7 +1129,11 @@ void SplineC2C<ST>::evaluateVGHGH(const ParticleSet& P,
     // Factor of 2 because psi is complex and the spline storage and evaluation uses a real type
     FairDivideAligned(2 * psi.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d_vghgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, mygH, first, last);
+    if (SymmetryImages)
+      evaluate_vghgh_images(ru);
+    else
+      applyToSpline(
+          [&](const auto* spline) { spline2::evaluate3d_vghgh(spline, ru, myV, myG, myH, mygH, first, last); });
     assign_vghgh(r, psi, dpsi, grad_grad_psi, grad_grad_grad_psi, first / 2, last / 2);
   }
 }
@@ -22,10 +22,18 @@
 #include "QMCWaveFunctions/BsplineFactory/BsplineSet.h"
 #include "OhmmsSoA/VectorSoaContainer.h"
 #include "spline2/MultiBspline.hpp"
+#include "spline2/MultiBsplineCompressed.hpp"
+#include "QMCWaveFunctions/BsplineFactory/SplineSymmetryImages.h"
 #include "Utilities/FairDivide.h"
 
 namespace qmcplusplus
 {
+namespace testing
+{
+class SplineC2CSymmetryTests;
+class RandomSplineSet;
+} // namespace testing
+
 /** class to match std::complex<ST> spline with BsplineSet::ValueType (complex) SPOs
  * @tparam ST precision of spline
  *
@@ -62,6 +70,10 @@ private:
   Tensor<ST, 3> GGt;
   ///multi bspline set
   std::shared_ptr<MultiBspline<ST>> SplineInst;
+  ///multi bspline set with 16 bit coefficients, replaces SplineInst after compress_tables
+  std::shared_ptr<MultiBsplineCompressed<ST>> CompressedInst;
+  ///orbitals evaluated from the stored ones of the symmetry irreducible twists, nullptr if all the orbitals are stored
+  std::shared_ptr<const SplineSymmetryImages> SymmetryImages;
 
   ///Copy of original splines for orbital rotation
   std::shared_ptr<std::vector<ST>> coef_copy_;
@@ -71,6 +83,37 @@ private:
 
   ///thread private ratios for reduction when using nested threading, numVP x numThread
   Matrix<ComplexT> ratios_private;
+  ///positions of the crowd in the mw_ APIs, scratch of the crowd leader
+  MultiWalkerPositionScratch<ST> mw_pos_scratch_;
+
+  /// call f with the spline table in use, the compressed one after compress_tables
+  template<typename F>
+  inline void applyToSpline(F&& f) const
+  {
+    if (CompressedInst)
+      f(CompressedInst->getSplinePtr());
+    else
+      f(SplineInst->getSplinePtr());
+  }
+
+  /// the full precision table, which compress_tables releases
+  MultiBspline<ST>& getFullTable(const std::string& caller) const
+  {
+    if (!SplineInst)
+      throw std::runtime_error(getClassName() + "::" + caller +
+                               " needs the full precision spline table, which is released by compress_tables.");
+    return *SplineInst;
+  }
+
+  /** evaluate all the orbitals at ru into myV through the blocks of SymmetryImages
+   *
+   * The blocks are shared by the threads of the enclosing parallel region, which are synchronized on return.
+   */
+  void evaluate_v_images(const PointType& ru);
+  /// evaluate all the orbitals at ru into myV, myG and myH through the blocks of SymmetryImages
+  void evaluate_vgh_images(const PointType& ru);
+  /// evaluate all the orbitals at ru into myV, myG, myH and mygH through the blocks of SymmetryImages
+  void evaluate_vghgh_images(const PointType& ru);
 
 protected:
   /// intermediate result vectors
@@ -79,6 +122,11 @@ protected:
   gContainer_type myG;
   hContainer_type myH;
   ghContainer_type mygH;
+  /// intermediate result vectors of the symmetry image blocks
+  vContainer_type imageV;
+  gContainer_type imageG;
+  hContainer_type imageH;
+  ghContainer_type imagegH;
 
 public:
   SplineC2C(const std::string& my_name) : BsplineSet(my_name) {}
@@ -91,7 +139,7 @@ public:
 
   std::unique_ptr<SPOSet> makeClone() const override { return std::make_unique<SplineC2C>(*this); }
 
-  bool isRotationSupported() const override { return true; }
+  bool isRotationSupported() const override { return !CompressedInst && !SymmetryImages; }
 
   /// Store an original copy of the spline coefficients for orbital rotation
   void storeParamsBeforeRotation() override;
@@ -119,19 +167,20 @@ public:
     mygH.resize(npad);
   }
 
-  void bcast_tables(Communicate* comm) { chunked_bcast(comm, SplineInst->getSplinePtr()); }
+  void bcast_tables(Communicate* comm) { chunked_bcast(comm, getFullTable("bcast_tables").getSplinePtr()); }
 
   void gather_tables(Communicate* comm)
   {
     if (comm->size() == 1)
       return;
-    const int Nbands      = kPoints.size();
+    const int Nbands      = BandIndexMap.size();
     const int Nbandgroups = comm->size();
     offset.resize(Nbandgroups + 1, 0);
     FairDivideLow(Nbands, Nbandgroups, offset);
     for (size_t ib = 0; ib < offset.size(); ib++)
       offset[ib] *= 2;
-    gatherv(comm, SplineInst->getSplinePtr(), SplineInst->getSplinePtr()->z_stride, offset);
+    auto spline_ptr = getFullTable("gather_tables").getSplinePtr();
+    gatherv(comm, spline_ptr, spline_ptr->z_stride, offset);
   }
 
   template<typename GT, typename BCT>
@@ -139,12 +188,22 @@ public:
   {
     resize_kpoints();
     SplineInst = std::make_shared<MultiBspline<ST>>();
-    SplineInst->create(xyz_g, xyz_bc, myV.size());
+    SplineInst->create(xyz_g, xyz_bc, SymmetryImages ? 2 * BandIndexMap.size() : myV.size());
     app_log() << "MEMORY " << SplineInst->sizeInByte() / (1 << 20) << " MB allocated "
               << "for the coefficients in 3D spline orbital representation" << std::endl;
   }
 
-  inline void flush_zero() { SplineInst->flush_zero(); }
+  inline void flush_zero() { getFullTable("flush_zero").flush_zero(); }
+
+  /** replace the spline table by its copy with coefficients stored as scaled 16 bit integers
+   * @return errors of the orbital values with respect to the replaced table
+   */
+  SplineCompressionError compress_tables();
+
+  /** store only the orbitals of the symmetry irreducible twists, must be called before create_spline
+   * @param images map of the orbitals, slots are aligned to getAlignment<ST>()/2
+   */
+  void set_symmetry_images(std::shared_ptr<const SplineSymmetryImages> images);
 
   /** remap kPoints to pack the double copy */
   inline void resize_kpoints()
@@ -167,6 +226,18 @@ public:
 
   void assign_v(const PointType& r, const vContainer_type& myV, ValueVector& psi, int first, int last) const;
 
+  /** contract the orbitals of the complex splines [first, last) with a row of the inverse without storing them
+   * @param vals values of the real splines [2*first, 2*last) at the position
+   * @param invrow row of the inverse, requested_orb_size long
+   * @return sum of invrow * psi over the orbitals of the complex splines [first, last)
+   */
+  ComplexT contract_v(const PointType& r,
+                      const ST* vals,
+                      const ComplexT* invrow,
+                      size_t requested_orb_size,
+                      int first,
+                      int last) const;
+
   void evaluateValue(const ParticleSet& P, const int iat, ValueVector& psi) override;
 
   void evaluateDetRatios(const VirtualParticleSet& VP,
@@ -174,6 +245,12 @@ public:
                          const ValueVector& psiinv,
                          std::vector<ValueType>& ratios) override;
 
+  void mw_evaluateDetRatios(const RefVectorWithLeader<SPOSet>& spo_list,
+                            const RefVectorWithLeader<const VirtualParticleSet>& vp_list,
+                            const RefVector<ValueVector>& psi_list,
+                            const std::vector<const ValueType*>& invRow_ptr_list,
+                            std::vector<std::vector<ValueType>>& ratios_list) const override;
+
   /** assign_vgl
    */
   void assign_vgl(const PointType& r, ValueVector& psi, GradVector& dpsi, ValueVector& d2psi, int first, int last)
@@ -189,6 +266,13 @@ public:
                    GradVector& dpsi,
                    ValueVector& d2psi) override;
 
+  void mw_evaluateVGL(const RefVectorWithLeader<SPOSet>& spo_list,
+                      const RefVectorWithLeader<ParticleSet>& P_list,
+                      int iat,
+                      const RefVector<ValueVector>& psi_v_list,
+                      const RefVector<GradVector>& dpsi_v_list,
+                      const RefVector<ValueVector>& d2psi_v_list) const override;
+
   void assign_vgh(const PointType& r,
                   ValueVector& psi,
                   GradVector& dpsi,
@@ -220,6 +304,8 @@ public:
   template<class BSPLINESPO>
   friend class SplineSetReader;
   friend struct BsplineReader;
+  friend class testing::SplineC2CSymmetryTests;
+  friend class testing::RandomSplineSet;
 };
 
 extern template class SplineC2C<float>;
@@ -33,8 +33,8 @@ inline void SplineC2R<ST>::set_spline(SingleSplineType* spline_r,
                                       int ispline,
                                       int level)
 {
-  SplineInst->copy_spline(spline_r, 2 * ispline);
-  SplineInst->copy_spline(spline_i, 2 * ispline + 1);
+  getFullTable("set_spline").copy_spline(spline_r, 2 * ispline);
+  getFullTable("set_spline").copy_spline(spline_i, 2 * ispline + 1);
 }
 
 template<typename ST>
@@ -42,7 +42,7 @@ bool SplineC2R<ST>::read_splines(hdf_archive& h5f)
 {
   std::ostringstream o;
   o << "spline_" << MyIndex;
-  einspline_engine<SplineType> bigtable(SplineInst->getSplinePtr());
+  einspline_engine<SplineType> bigtable(getFullTable("read_splines").getSplinePtr());
   return h5f.readEntry(bigtable, o.str().c_str()); //"spline_0");
 }
 
@@ -51,10 +51,22 @@ bool SplineC2R<ST>::write_splines(hdf_archive& h5f)
 {
   std::ostringstream o;
   o << "spline_" << MyIndex;
-  einspline_engine<SplineType> bigtable(SplineInst->getSplinePtr());
+  einspline_engine<SplineType> bigtable(getFullTable("write_splines").getSplinePtr());
   return h5f.writeEntry(bigtable, o.str().c_str()); //"spline_0");
 }
 
+template<typename ST>
+SplineCompressionError SplineC2R<ST>::compress_tables()
+{
+  CompressedInst = std::make_shared<MultiBsplineCompressed<ST>>(*getFullTable("compress_tables").getSplinePtr());
+  app_log() << "MEMORY " << CompressedInst->sizeInByte() / (1 << 20) << " MB allocated "
+            << "for the 16 bit compressed coefficients in 3D spline orbital representation, replacing "
+            << SplineInst->sizeInByte() / (1 << 20) << " MB" << std::endl;
+  const auto error = spline2::compressionError(SplineInst->getSplinePtr(), CompressedInst->getSplinePtr(), 64);
+  SplineInst.reset();
+  return error;
+}
+
 template<typename ST>
 inline void SplineC2R<ST>::assign_v(const PointType& r,
                                     const vContainer_type& myV,
@@ -100,6 +112,53 @@ inline void SplineC2R<ST>::assign_v(const PointType& r,
   }
 }
 
+template<typename ST>
+inline typename SplineC2R<ST>::TT SplineC2R<ST>::contract_v(const PointType& r,
+                                                            const ST* vals,
+                                                            const TT* invrow,
+                                                            size_t requested_orb_size,
+                                                            int first,
+                                                            int last) const
+{
+  // protect last
+  last = last > kPoints.size() ? kPoints.size() : last;
+
+  const ST x = r[0], y = r[1], z = r[2];
+  const ST* restrict kx = myKcart.data(0);
+  const ST* restrict ky = myKcart.data(1);
+  const ST* restrict kz = myKcart.data(2);
+
+  const TT* restrict inv_s = invrow + first_spo;
+  TT sum(0);
+#pragma omp simd reduction(+ : sum)
+  for (size_t j = first; j < std::min(nComplexBands, last); j++)
+  {
+    ST s, c;
+    const size_t jr = j << 1;
+    const size_t ji = jr + 1;
+    const ST val_r  = vals[jr - 2 * first];
+    const ST val_i  = vals[ji - 2 * first];
+    qmcplusplus::sincos(-(x * kx[j] + y * ky[j] + z * kz[j]), &s, &c);
+    if (jr < requested_orb_size)
+      sum += inv_s[jr] * (val_r * c - val_i * s);
+    if (ji < requested_orb_size)
+      sum += inv_s[ji] * (val_i * c + val_r * s);
+  }
+
+  inv_s += nComplexBands;
+#pragma omp simd reduction(+ : sum)
+  for (size_t j = std::max(nComplexBands, first); j < last; j++)
+  {
+    ST s, c;
+    const ST val_r = vals[2 * (j - first)];
+    const ST val_i = vals[2 * (j - first) + 1];
+    qmcplusplus::sincos(-(x * kx[j] + y * ky[j] + z * kz[j]), &s, &c);
+    if (j + nComplexBands < requested_orb_size)
+      sum += inv_s[j] * (val_r * c - val_i * s);
+  }
+  return sum;
+}
+
 template<typename ST>
 void SplineC2R<ST>::evaluateValue(const ParticleSet& P, const int iat, ValueVector& psi)
 {
@@ -111,7 +170,7 @@ void SplineC2R<ST>::evaluateValue(const ParticleSet& P, const int iat, ValueVect
     int first, last;
     FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
+    applyToSpline([&](const auto* spline) { spline2::evaluate3d(spline, ru, myV, first, last); });
     assign_v(r, myV, psi, first / 2, last / 2);
   }
 }
@@ -136,20 +195,20 @@ void SplineC2R<ST>::evaluateDetRatios(const VirtualParticleSet& VP,
     }
     int first, last;
     FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), tid, first, last);
-    const int first_cplx = first / 2;
-    const int last_cplx  = kPoints.size() < last / 2 ? kPoints.size() : last / 2;
 
     for (int iat = 0; iat < VP.getTotalNum(); ++iat)
     {
       const PointType& r = VP.activeR(iat);
       PointType ru(PrimLattice.toUnit_floor(r));
 
-      spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
-      assign_v(r, myV, psi, first_cplx, last_cplx);
-
-      const int first_real     = first_cplx + std::min(nComplexBands, first_cplx);
-      const int last_real      = last_cplx + std::min(nComplexBands, last_cplx);
-      ratios_private[iat][tid] = simd::dot(psi.data() + first_real, psiinv.data() + first_real, last_real - first_real);
+      // psi is only a scratch space, the ratio is contracted from the spline values directly
+      TT ratio(0);
+      applyToSpline([&](const auto* spline) {
+        spline2::evaluate3d_contract(spline, ru, first, last, [&](const ST* vals, int tile_first, int tile_last) {
+          ratio += contract_v(r, vals, psiinv.data(), psi.size(), tile_first / 2, tile_last / 2);
+        });
+      });
+      ratios_private[iat][tid] = ratio;
     }
   }
 
@@ -162,6 +221,73 @@ void SplineC2R<ST>::evaluateDetRatios(const VirtualParticleSet& VP,
   }
 }
 
+template<typename ST>
+void SplineC2R<ST>::mw_evaluateDetRatios(const RefVectorWithLeader<SPOSet>& spo_list,
+                                         const RefVectorWithLeader<const VirtualParticleSet>& vp_list,
+                                         const RefVector<ValueVector>& psi_list,
+                                         const std::vector<const ValueType*>& invRow_ptr_list,
+                                         std::vector<std::vector<ValueType>>& ratios_list) const
+{
+  assert(this == &spo_list.getLeader());
+  auto& spo_leader = spo_list.getCastedLeader<SplineC2R<ST>>();
+  const size_t nw  = spo_list.size();
+
+  // positions of all the quadrature points of all the walkers
+  auto& pos_scratch = spo_leader.mw_pos_scratch_;
+  auto& walker_ids  = pos_scratch.walker_ids;
+  auto& rs          = pos_scratch.rs;
+  auto& rus         = pos_scratch.rus;
+  pos_scratch.clear();
+  for (int iw = 0; iw < nw; iw++)
+    for (int iat = 0; iat < vp_list[iw].getTotalNum(); ++iat)
+    {
+      const PointType& r = vp_list[iw].activeR(iat);
+      rs.push_back(r);
+      rus.push_back(PrimLattice.toUnit_floor(r));
+      walker_ids.push_back(iw);
+    }
+  const int num_points = rus.size();
+
+  auto& ratios_private   = spo_leader.ratios_private;
+  const bool need_resize = ratios_private.rows() < num_points;
+#pragma omp parallel
+  {
+    int tid = omp_get_thread_num();
+    if (need_resize)
+    {
+      if (tid == 0)
+        ratios_private.resize(num_points, omp_get_num_threads());
+#pragma omp barrier
+    }
+    for (int ip = 0; ip < num_points; ++ip)
+      ratios_private[ip][tid] = TT(0);
+
+    int first, last;
+    FairDivideAligned(spo_leader.myV.size(), getAlignment<ST>(), omp_get_num_threads(), tid, first, last);
+    // all the points are evaluated on one block of splines before moving to the next one
+    for (int first_block = first; first_block < last; first_block += mw_spline_block_size)
+    {
+      const int last_block = std::min(first_block + mw_spline_block_size, last);
+      const auto contract  = [&](int ip, const ST* vals, int tile_first, int tile_last) {
+        const int iw = walker_ids[ip];
+        ratios_private[ip][tid] += contract_v(rs[ip], vals, invRow_ptr_list[iw], psi_list[iw].get().size(),
+                                              tile_first / 2, tile_last / 2);
+      };
+      applyToSpline([&](const auto* spline) {
+        spline2::evaluate3d_contract_multi(spline, rus, first_block, last_block, contract);
+      });
+    }
+  }
+
+  for (int ip = 0, iw = 0; iw < nw; iw++)
+    for (int iat = 0; iat < vp_list[iw].getTotalNum(); ++iat, ++ip)
+    {
+      ratios_list[iw][iat] = TT(0);
+      for (int tid = 0; tid < ratios_private.cols(); tid++)
+        ratios_list[iw][iat] += ratios_private[ip][tid];
+    }
+}
+
 /** assign_vgl
    */
 template<typename ST>
@@ -456,11 +582,49 @@ void SplineC2R<ST>::evaluateVGL(const ParticleSet& P,
     int first, last;
     FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+    applyToSpline([&](const auto* spline) { spline2::evaluate3d_vgh(spline, ru, myV, myG, myH, first, last); });
     assign_vgl(r, psi, dpsi, d2psi, first / 2, last / 2);
   }
 }
 
+template<typename ST>
+void SplineC2R<ST>::mw_evaluateVGL(const RefVectorWithLeader<SPOSet>& spo_list,
+                                   const RefVectorWithLeader<ParticleSet>& P_list,
+                                   int iat,
+                                   const RefVector<ValueVector>& psi_v_list,
+                                   const RefVector<GradVector>& dpsi_v_list,
+                                   const RefVector<ValueVector>& d2psi_v_list) const
+{
+  assert(this == &spo_list.getLeader());
+  auto& spo_leader = spo_list.getCastedLeader<SplineC2R<ST>>();
+  const size_t nw  = spo_list.size();
+
+  auto& rus = spo_leader.mw_pos_scratch_.rus;
+  rus.resize(nw);
+  for (int iw = 0; iw < nw; iw++)
+    rus[iw] = PrimLattice.toUnit_floor(P_list[iw].activeR(iat));
+
+#pragma omp parallel
+  {
+    int first, last;
+    FairDivideAligned(spo_leader.myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first,
+                      last);
+    // all the walkers are evaluated on one block of splines before moving to the next one
+    for (int first_block = first; first_block < last; first_block += mw_spline_block_size)
+    {
+      const int last_block = std::min(first_block + mw_spline_block_size, last);
+      const auto consume = [&](int iw) {
+        assign_vgl(P_list[iw].activeR(iat), psi_v_list[iw], dpsi_v_list[iw], d2psi_v_list[iw], first_block / 2,
+                   last_block / 2);
+      };
+      applyToSpline([&](const auto* spline) {
+        spline2::evaluate3d_vgh_multi(spline, rus, spo_leader.myV, spo_leader.myG, spo_leader.myH, first_block,
+                                      last_block, consume);
+      });
+    }
+  }
+}
+
 template<typename ST>
 void SplineC2R<ST>::assign_vgh(const PointType& r,
                                ValueVector& psi,
@@ -710,7 +874,7 @@ void SplineC2R<ST>::evaluateVGH(const ParticleSet& P,
     int first, last;
     FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+    applyToSpline([&](const auto* spline) { spline2::evaluate3d_vgh(spline, ru, myV, myG, myH, first, last); });
     assign_vgh(r, psi, dpsi, grad_grad_psi, first / 2, last / 2);
   }
 }
@@ -1218,7 +1382,7 @@ void SplineC2R<ST>::evaluateVGHGH(const ParticleSet& P,
     int first, last;
     FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d_vghgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, mygH, first, last);
+    applyToSpline([&](const auto* spline) { spline2::evaluate3d_vghgh(spline, ru, myV, myG, myH, mygH, first, last); });
     assign_vghgh(r, psi, dpsi, grad_grad_psi, grad_grad_grad_psi, first / 2, last / 2);
   }
 }
@@ -25,10 +25,17 @@
 #include "QMCWaveFunctions/BsplineFactory/BsplineSet.h"
 #include "OhmmsSoA/VectorSoaContainer.h"
 #include "spline2/MultiBspline.hpp"
+#include "spline2/MultiBsplineCompressed.hpp"
+#include "QMCWaveFunctions/BsplineFactory/SplineSymmetryImages.h"
 #include "Utilities/FairDivide.h"
 
 namespace qmcplusplus
 {
+namespace testing
+{
+class RandomSplineSet;
+}
+
 /** class to match std::complex<ST> spline with BsplineSet::ValueType (real) SPOs
  * @tparam ST precision of spline
  *
@@ -68,12 +75,35 @@ private:
   int nComplexBands;
   ///multi bspline set
   std::shared_ptr<MultiBspline<ST>> SplineInst;
+  ///multi bspline set with 16 bit coefficients, replaces SplineInst after compress_tables
+  std::shared_ptr<MultiBsplineCompressed<ST>> CompressedInst;
 
   vContainer_type mKK;
   VectorSoaContainer<ST, 3> myKcart;
 
   ///thread private ratios for reduction when using nested threading, numVP x numThread
   Matrix<TT> ratios_private;
+  ///positions of the crowd in the mw_ APIs, scratch of the crowd leader
+  MultiWalkerPositionScratch<ST> mw_pos_scratch_;
+
+  /// call f with the spline table in use, the compressed one after compress_tables
+  template<typename F>
+  inline void applyToSpline(F&& f) const
+  {
+    if (CompressedInst)
+      f(CompressedInst->getSplinePtr());
+    else
+      f(SplineInst->getSplinePtr());
+  }
+
+  /// the full precision table, which compress_tables releases
+  MultiBspline<ST>& getFullTable(const std::string& caller) const
+  {
+    if (!SplineInst)
+      throw std::runtime_error(getClassName() + "::" + caller +
+                               " needs the full precision spline table, which is released by compress_tables.");
+    return *SplineInst;
+  }
 
 protected:
   /// intermediate result vectors
@@ -104,7 +134,7 @@ public:
     mygH.resize(npad);
   }
 
-  void bcast_tables(Communicate* comm) { chunked_bcast(comm, SplineInst->getSplinePtr()); }
+  void bcast_tables(Communicate* comm) { chunked_bcast(comm, getFullTable("bcast_tables").getSplinePtr()); }
 
   void gather_tables(Communicate* comm)
   {
@@ -117,7 +147,8 @@ public:
 
     for (size_t ib = 0; ib < offset.size(); ib++)
       offset[ib] = offset[ib] * 2;
-    gatherv(comm, SplineInst->getSplinePtr(), SplineInst->getSplinePtr()->z_stride, offset);
+    auto spline_ptr = getFullTable("gather_tables").getSplinePtr();
+    gatherv(comm, spline_ptr, spline_ptr->z_stride, offset);
   }
 
   template<typename GT, typename BCT>
@@ -131,7 +162,19 @@ public:
               << "for the coefficients in 3D spline orbital representation" << std::endl;
   }
 
-  inline void flush_zero() { SplineInst->flush_zero(); }
+  inline void flush_zero() { getFullTable("flush_zero").flush_zero(); }
+
+  /** replace the spline table by its copy with coefficients stored as scaled 16 bit integers
+   * @return errors of the orbital values with respect to the replaced table
+   */
+  SplineCompressionError compress_tables();
+
+  /// only SplineC2C evaluates orbitals from symmetry reduced tables
+  void set_symmetry_images(std::shared_ptr<const SplineSymmetryImages> images)
+  {
+    throw std::runtime_error(
+        "SplineC2R does not support symmetry reduced spline tables. Use use_symmetry=\"no\".");
+  }
 
   /** remap kPoints to pack the double copy */
   inline void resize_kpoints()
@@ -155,6 +198,18 @@ public:
 
   void assign_v(const PointType& r, const vContainer_type& myV, ValueVector& psi, int first, int last) const;
 
+  /** contract the orbitals of the complex splines [first, last) with a row of the inverse without storing them
+   * @param vals values of the real splines [2*first, 2*last) at the position
+   * @param invrow row of the inverse, requested_orb_size long
+   * @return sum of invrow * psi over the orbitals of the complex splines [first, last)
+   */
+  TT contract_v(const PointType& r,
+                const ST* vals,
+                const TT* invrow,
+                size_t requested_orb_size,
+                int first,
+                int last) const;
+
   void evaluateValue(const ParticleSet& P, const int iat, ValueVector& psi) override;
 
   void evaluateDetRatios(const VirtualParticleSet& VP,
@@ -162,6 +217,12 @@ public:
                          const ValueVector& psiinv,
                          std::vector<TT>& ratios) override;
 
+  void mw_evaluateDetRatios(const RefVectorWithLeader<SPOSet>& spo_list,
+                            const RefVectorWithLeader<const VirtualParticleSet>& vp_list,
+                            const RefVector<ValueVector>& psi_list,
+                            const std::vector<const ValueType*>& invRow_ptr_list,
+                            std::vector<std::vector<ValueType>>& ratios_list) const override;
+
   /** assign_vgl
    */
   void assign_vgl(const PointType& r, ValueVector& psi, GradVector& dpsi, ValueVector& d2psi, int first, int last)
@@ -177,6 +238,13 @@ public:
                    GradVector& dpsi,
                    ValueVector& d2psi) override;
 
+  void mw_evaluateVGL(const RefVectorWithLeader<SPOSet>& spo_list,
+                      const RefVectorWithLeader<ParticleSet>& P_list,
+                      int iat,
+                      const RefVector<ValueVector>& psi_v_list,
+                      const RefVector<GradVector>& dpsi_v_list,
+                      const RefVector<ValueVector>& d2psi_v_list) const override;
+
   void assign_vgh(const PointType& r,
                   ValueVector& psi,
                   GradVector& dpsi,
@@ -208,6 +276,7 @@ public:
   template<class BSPLINESPO>
   friend class SplineSetReader;
   friend struct BsplineReader;
+  friend class testing::RandomSplineSet;
 };
 
 extern template class SplineC2R<float>;
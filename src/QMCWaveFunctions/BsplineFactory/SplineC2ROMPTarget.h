@@ -22,6 +22,8 @@
 #include "QMCWaveFunctions/BsplineFactory/BsplineSet.h"
 #include "OhmmsSoA/VectorSoaContainer.h"
 #include "spline2/MultiBspline.hpp"
+#include "spline2/MultiBsplineCompressed.hpp"
+#include "QMCWaveFunctions/BsplineFactory/SplineSymmetryImages.h"
 #include "OMPTarget/OffloadAlignedAllocators.hpp"
 #include "Utilities/FairDivide.h"
 #include "Utilities/TimerManager.h"
@@ -216,6 +218,20 @@ public:
 
   inline void flush_zero() { SplineInst->flush_zero(); }
 
+  /// the offload kernels only support the full precision table
+  SplineCompressionError compress_tables()
+  {
+    throw std::runtime_error(
+        "SplineC2ROMPTarget does not support compressed spline coefficients. Use coefs_storage=\"native\".");
+  }
+
+  /// the offload kernels evaluate all the orbitals from one table
+  void set_symmetry_images(std::shared_ptr<const SplineSymmetryImages> images)
+  {
+    throw std::runtime_error(
+        "SplineC2ROMPTarget does not support symmetry reduced spline tables. Use use_symmetry=\"no\".");
+  }
+
   /** remap kPoints to pack the double copy */
   inline void resize_kpoints()
   {
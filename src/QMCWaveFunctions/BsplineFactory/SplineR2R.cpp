@@ -32,7 +32,7 @@ inline void SplineR2R<ST>::set_spline(SingleSplineType* spline_r,
                                       int ispline,
                                       int level)
 {
-  SplineInst->copy_spline(spline_r, ispline);
+  getFullTable("set_spline").copy_spline(spline_r, ispline);
 }
 
 template<typename ST>
@@ -40,7 +40,7 @@ bool SplineR2R<ST>::read_splines(hdf_archive& h5f)
 {
   std::ostringstream o;
   o << "spline_" << MyIndex;
-  einspline_engine<SplineType> bigtable(SplineInst->getSplinePtr());
+  einspline_engine<SplineType> bigtable(getFullTable("read_splines").getSplinePtr());
   return h5f.readEntry(bigtable, o.str().c_str()); //"spline_0");
 }
 
@@ -49,14 +49,26 @@ bool SplineR2R<ST>::write_splines(hdf_archive& h5f)
 {
   std::ostringstream o;
   o << "spline_" << MyIndex;
-  einspline_engine<SplineType> bigtable(SplineInst->getSplinePtr());
+  einspline_engine<SplineType> bigtable(getFullTable("write_splines").getSplinePtr());
   return h5f.writeEntry(bigtable, o.str().c_str()); //"spline_0");
 }
 
+template<typename ST>
+SplineCompressionError SplineR2R<ST>::compress_tables()
+{
+  CompressedInst = std::make_shared<MultiBsplineCompressed<ST>>(*getFullTable("compress_tables").getSplinePtr());
+  app_log() << "MEMORY " << CompressedInst->sizeInByte() / (1 << 20) << " MB allocated "
+            << "for the 16 bit compressed coefficients in 3D spline orbital representation, replacing "
+            << SplineInst->sizeInByte() / (1 << 20) << " MB" << std::endl;
+  const auto error = spline2::compressionError(SplineInst->getSplinePtr(), CompressedInst->getSplinePtr(), 64);
+  SplineInst.reset();
+  return error;
+}
+
 template<typename ST>
 void SplineR2R<ST>::storeParamsBeforeRotation()
 {
-  const auto spline_ptr     = SplineInst->getSplinePtr();
+  const auto spline_ptr     = getFullTable("storeParamsBeforeRotation").getSplinePtr();
   const auto coefs_tot_size = spline_ptr->coefs_size;
   coef_copy_                = std::make_shared<std::vector<ST>>(coefs_tot_size);
 
@@ -106,7 +118,7 @@ template<typename ST>
 void SplineR2R<ST>::applyRotation(const ValueMatrix& rot_mat, bool use_stored_copy)
 {
   // SplineInst is a MultiBspline. See src/spline2/MultiBspline.hpp
-  const auto spline_ptr = SplineInst->getSplinePtr();
+  const auto spline_ptr = getFullTable("applyRotation").getSplinePtr();
   assert(spline_ptr != nullptr);
   const auto spl_coefs      = spline_ptr->coefs;
   const auto Nsplines       = spline_ptr->num_splines; // May include padding
@@ -162,6 +174,26 @@ inline void SplineR2R<ST>::assign_v(int bc_sign, const vContainer_type& myV, Val
     psi[first_spo + j] = signed_one * myV[j];
 }
 
+template<typename ST>
+inline typename SplineR2R<ST>::TT SplineR2R<ST>::contract_v(int bc_sign,
+                                                            const ST* vals,
+                                                            const TT* invrow,
+                                                            size_t requested_orb_size,
+                                                            int first,
+                                                            int last) const
+{
+  // protect last against kPoints.size() and psi.size()
+  const int last_real = std::min(kPoints.size(), requested_orb_size);
+  last                = last > last_real ? last_real : last;
+
+  const TT* restrict inv_s = invrow + first_spo;
+  TT sum(0);
+#pragma omp simd reduction(+ : sum)
+  for (int j = first; j < last; ++j)
+    sum += inv_s[j] * vals[j - first];
+  return (bc_sign & 1) ? -sum : sum;
+}
+
 template<typename ST>
 void SplineR2R<ST>::evaluateValue(const ParticleSet& P, const int iat, ValueVector& psi)
 {
@@ -174,7 +206,7 @@ void SplineR2R<ST>::evaluateValue(const ParticleSet& P, const int iat, ValueVect
     int first, last;
     FairDivideAligned(psi.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
+    applyToSpline([&](const auto* spline) { spline2::evaluate3d(spline, ru, myV, first, last); });
     assign_v(bc_sign, myV, psi, first, last);
   }
 }
@@ -199,7 +231,6 @@ void SplineR2R<ST>::evaluateDetRatios(const VirtualParticleSet& VP,
     }
     int first, last;
     FairDivideAligned(psi.size(), getAlignment<ST>(), omp_get_num_threads(), tid, first, last);
-    const int last_real = kPoints.size() < last ? kPoints.size() : last;
 
     for (int iat = 0; iat < VP.getTotalNum(); ++iat)
     {
@@ -207,9 +238,14 @@ void SplineR2R<ST>::evaluateDetRatios(const VirtualParticleSet& VP,
       PointType ru;
       int bc_sign = convertPos(r, ru);
 
-      spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
-      assign_v(bc_sign, myV, psi, first, last_real);
-      ratios_private[iat][tid] = simd::dot(psi.data() + first, psiinv.data() + first, last_real - first);
+      // psi is only a scratch space, the ratio is contracted from the spline values directly
+      TT ratio(0);
+      applyToSpline([&](const auto* spline) {
+        spline2::evaluate3d_contract(spline, ru, first, last, [&](const ST* vals, int tile_first, int tile_last) {
+          ratio += contract_v(bc_sign, vals, psiinv.data(), psi.size(), tile_first, tile_last);
+        });
+      });
+      ratios_private[iat][tid] = ratio;
     }
   }
 
@@ -222,6 +258,73 @@ void SplineR2R<ST>::evaluateDetRatios(const VirtualParticleSet& VP,
   }
 }
 
+template<typename ST>
+void SplineR2R<ST>::mw_evaluateDetRatios(const RefVectorWithLeader<SPOSet>& spo_list,
+                                         const RefVectorWithLeader<const VirtualParticleSet>& vp_list,
+                                         const RefVector<ValueVector>& psi_list,
+                                         const std::vector<const ValueType*>& invRow_ptr_list,
+                                         std::vector<std::vector<ValueType>>& ratios_list) const
+{
+  assert(this == &spo_list.getLeader());
+  auto& spo_leader = spo_list.getCastedLeader<SplineR2R<ST>>();
+  const size_t nw  = spo_list.size();
+
+  // positions of all the quadrature points of all the walkers
+  auto& pos_scratch = spo_leader.mw_pos_scratch_;
+  auto& walker_ids  = pos_scratch.walker_ids;
+  auto& bc_signs    = pos_scratch.bc_signs;
+  auto& rus         = pos_scratch.rus;
+  pos_scratch.clear();
+  for (int iw = 0; iw < nw; iw++)
+    for (int iat = 0; iat < vp_list[iw].getTotalNum(); ++iat)
+    {
+      PointType ru;
+      bc_signs.push_back(spo_leader.convertPos(vp_list[iw].activeR(iat), ru));
+      rus.push_back(ru);
+      walker_ids.push_back(iw);
+    }
+  const int num_points = rus.size();
+
+  auto& ratios_private   = spo_leader.ratios_private;
+  const bool need_resize = ratios_private.rows() < num_points;
+#pragma omp parallel
+  {
+    int tid = omp_get_thread_num();
+    if (need_resize)
+    {
+      if (tid == 0)
+        ratios_private.resize(num_points, omp_get_num_threads());
+#pragma omp barrier
+    }
+    for (int ip = 0; ip < num_points; ++ip)
+      ratios_private[ip][tid] = TT(0);
+
+    int first, last;
+    FairDivideAligned(psi_list[0].get().size(), getAlignment<ST>(), omp_get_num_threads(), tid, first, last);
+    // all the points are evaluated on one block of splines before moving to the next one
+    for (int first_block = first; first_block < last; first_block += mw_spline_block_size)
+    {
+      const int last_block = std::min(first_block + mw_spline_block_size, last);
+      const auto contract  = [&](int ip, const ST* vals, int tile_first, int tile_last) {
+        const int iw = walker_ids[ip];
+        ratios_private[ip][tid] +=
+            contract_v(bc_signs[ip], vals, invRow_ptr_list[iw], psi_list[iw].get().size(), tile_first, tile_last);
+      };
+      applyToSpline([&](const auto* spline) {
+        spline2::evaluate3d_contract_multi(spline, rus, first_block, last_block, contract);
+      });
+    }
+  }
+
+  for (int ip = 0, iw = 0; iw < nw; iw++)
+    for (int iat = 0; iat < vp_list[iw].getTotalNum(); ++iat, ++ip)
+    {
+      ratios_list[iw][iat] = TT(0);
+      for (int tid = 0; tid < ratios_private.cols(); tid++)
+        ratios_list[iw][iat] += ratios_private[ip][tid];
+    }
+}
+
 template<typename ST>
 inline void SplineR2R<ST>::assign_vgl(int bc_sign,
                                       ValueVector& psi,
@@ -301,11 +404,50 @@ void SplineR2R<ST>::evaluateVGL(const ParticleSet& P,
     int first, last;
     FairDivideAligned(psi.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+    applyToSpline([&](const auto* spline) { spline2::evaluate3d_vgh(spline, ru, myV, myG, myH, first, last); });
     assign_vgl(bc_sign, psi, dpsi, d2psi, first, last);
   }
 }
 
+template<typename ST>
+void SplineR2R<ST>::mw_evaluateVGL(const RefVectorWithLeader<SPOSet>& spo_list,
+                                   const RefVectorWithLeader<ParticleSet>& P_list,
+                                   int iat,
+                                   const RefVector<ValueVector>& psi_v_list,
+                                   const RefVector<GradVector>& dpsi_v_list,
+                                   const RefVector<ValueVector>& d2psi_v_list) const
+{
+  assert(this == &spo_list.getLeader());
+  auto& spo_leader = spo_list.getCastedLeader<SplineR2R<ST>>();
+  const size_t nw  = spo_list.size();
+
+  auto& bc_signs = spo_leader.mw_pos_scratch_.bc_signs;
+  auto& rus      = spo_leader.mw_pos_scratch_.rus;
+  bc_signs.resize(nw);
+  rus.resize(nw);
+  for (int iw = 0; iw < nw; iw++)
+    bc_signs[iw] = spo_leader.convertPos(P_list[iw].activeR(iat), rus[iw]);
+
+#pragma omp parallel
+  {
+    int first, last;
+    FairDivideAligned(psi_v_list[0].get().size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(),
+                      first, last);
+    // all the walkers are evaluated on one block of splines before moving to the next one
+    for (int first_block = first; first_block < last; first_block += mw_spline_block_size)
+    {
+      const int last_block = std::min(first_block + mw_spline_block_size, last);
+      const auto consume = [&](int iw) {
+        assign_vgl(bc_signs[iw], psi_v_list[iw], dpsi_v_list[iw], d2psi_v_list[iw], first_block, last_block);
+      };
+      applyToSpline([&](const auto* spline) {
+        spline2::evaluate3d_vgh_multi(spline, rus, spo_leader.myV, spo_leader.myG, spo_leader.myH, first_block,
+                                      last_block, consume);
+      });
+    }
+  }
+}
+
 template<typename ST>
 void SplineR2R<ST>::assign_vgh(int bc_sign,
                                ValueVector& psi,
@@ -385,7 +527,7 @@ void SplineR2R<ST>::evaluateVGH(const ParticleSet& P,
     int first, last;
     FairDivideAligned(psi.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+    applyToSpline([&](const auto* spline) { spline2::evaluate3d_vgh(spline, ru, myV, myG, myH, first, last); });
     assign_vgh(bc_sign, psi, dpsi, grad_grad_psi, first, last);
   }
 }
@@ -564,7 +706,7 @@ void SplineR2R<ST>::evaluateVGHGH(const ParticleSet& P,
     int first, last;
     FairDivideAligned(psi.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d_vghgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, mygH, first, last);
+    applyToSpline([&](const auto* spline) { spline2::evaluate3d_vghgh(spline, ru, myV, myG, myH, mygH, first, last); });
     assign_vghgh(bc_sign, psi, dpsi, grad_grad_psi, grad_grad_grad_psi, first, last);
   }
 }
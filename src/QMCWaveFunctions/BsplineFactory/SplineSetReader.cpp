@@ -84,6 +84,7 @@ std::unique_ptr<SPOSet> SplineSetReader<SA>::create_spline_set(const std::string
     bspline->bcast_tables(myComm);
     app_log() << "  Time to bcast the table = " << now.elapsed() << std::endl;
   }
+  compress_tables(*bspline);
 
   return bspline;
 }
@@ -98,6 +99,7 @@ bool SplineSetReader<SA>::createSplineDataSpaceLookforDumpFile(const BandInfoGro
 
   //baseclass handles twists
   check_twists(bspline, bandgroup);
+  check_symmetry(bspline, bandgroup);
 
   Ugrid xyz_grid[3];
 
@@ -162,7 +164,8 @@ void SplineSetReader<SA>::initialize_spline_pio_gather(const int spin,
                                                        SA& bspline) const
 {
   //distribute bands over processor groups
-  int Nbands            = bandgroup.getNumDistinctOrbitals();
+  // slots of the spline table, only the orbitals of the irreducible twists and padding if reduced by symmetry
+  int Nbands            = bspline.BandIndexMap.size();
   const int Nprocs      = myComm->size();
   const int Nbandgroups = std::min(Nbands, Nprocs);
   Communicate band_group_comm(*myComm, Nbandgroups);
@@ -181,6 +184,9 @@ void SplineSetReader<SA>::initialize_spline_pio_gather(const int spin,
     h5f.open(mybuilder->H5FileName, H5F_ACC_RDONLY);
     for (int iorb = iorb_first; iorb < iorb_last; iorb++)
     {
+      // padding slot of a symmetry reduced table
+      if (bspline.BandIndexMap[iorb] < 0)
+        continue;
       const auto& cur_band = cur_bands[bspline.BandIndexMap[iorb]];
       const int ti         = cur_band.TwistIndex;
       readOneOrbitalCoefs(psi_g_path(ti, spin, cur_band.BandIndex), h5f, cG);
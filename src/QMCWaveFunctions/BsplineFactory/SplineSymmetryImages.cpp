@@ -0,0 +1,231 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "SplineSymmetryImages.h"
+#include <algorithm>
+#include <map>
+
+namespace qmcplusplus
+{
+namespace
+{
+using Frac = TinyVector<double, 3>;
+
+/// difference of fractional coordinates wrapped into [-0.5, 0.5)
+inline Frac wrapDiff(const Frac& a, const Frac& b)
+{
+  Frac d = a - b;
+  for (int i = 0; i < 3; i++)
+    d[i] -= std::floor(d[i] + 0.5);
+  return d;
+}
+
+inline bool sameFrac(const Frac& a, const Frac& b, double tol)
+{
+  const Frac d = wrapDiff(a, b);
+  return std::abs(d[0]) < tol && std::abs(d[1]) < tol && std::abs(d[2]) < tol;
+}
+
+inline Frac apply(const Tensor<int, 3>& m, const Frac& x)
+{
+  Frac res;
+  for (int i = 0; i < 3; i++)
+    res[i] = m(i, 0) * x[0] + m(i, 1) * x[1] + m(i, 2) * x[2];
+  return res;
+}
+
+/// inverse of an integer matrix with determinant +-1
+Tensor<int, 3> inverseUnimodular(const Tensor<int, 3>& m)
+{
+  Tensor<int, 3> adj;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+    {
+      const int i1 = (j + 1) % 3, i2 = (j + 2) % 3, j1 = (i + 1) % 3, j2 = (i + 2) % 3;
+      adj(i, j)    = m(i1, j1) * m(i2, j2) - m(i1, j2) * m(i2, j1);
+    }
+  const int det = m(0, 0) * adj(0, 0) + m(0, 1) * adj(1, 0) + m(0, 2) * adj(2, 0);
+  return adj * det;
+}
+
+inline int alignUp(int n, int alignment) { return (n + alignment - 1) / alignment * alignment; }
+} // namespace
+
+std::vector<SpaceGroupOperation> findSpaceGroupOperations(const Tensor<double, 3>& lattice,
+                                                          const std::vector<TinyVector<double, 3>>& ion_frac,
+                                                          const std::vector<int>& ion_types,
+                                                          double tol)
+{
+  const Tensor<double, 3> metric = dot(lattice, transpose(lattice));
+  double metric_scale            = 0;
+  for (int i = 0; i < 9; i++)
+    metric_scale = std::max(metric_scale, std::abs(metric[i]));
+
+  std::vector<Frac> ions(ion_frac);
+  for (auto& x : ions)
+    for (int i = 0; i < 3; i++)
+      x[i] -= std::floor(x[i]);
+
+  const auto maps_ions = [&](const Tensor<int, 3>& rot, const Frac& trans) {
+    for (int i = 0; i < ions.size(); i++)
+    {
+      const Frac image = apply(rot, ions[i]) + trans;
+      bool found       = false;
+      for (int j = 0; j < ions.size() && !found; j++)
+        found = ion_types[j] == ion_types[i] && sameFrac(image, ions[j], tol);
+      if (!found)
+        return false;
+    }
+    return true;
+  };
+
+  std::vector<SpaceGroupOperation> ops;
+  ops.push_back({Tensor<int, 3>(1, 0, 0, 0, 1, 0, 0, 0, 1), Frac(0.0)});
+  Tensor<int, 3> rot;
+  for (int code = 0; code < 19683; code++)
+  {
+    for (int i = 0, c = code; i < 9; i++, c /= 3)
+      rot[i] = c % 3 - 1;
+    // rotations keep the metric
+    Tensor<double, 3> rot_d;
+    for (int i = 0; i < 9; i++)
+      rot_d[i] = rot[i];
+    const Tensor<double, 3> rotated = dot(transpose(rot_d), dot(metric, rot_d));
+    bool is_rotation                = true;
+    for (int i = 0; i < 9 && is_rotation; i++)
+      is_rotation = std::abs(rotated[i] - metric[i]) < 1e-6 * metric_scale;
+    const bool is_identity = rot == Tensor<int, 3>(1, 0, 0, 0, 1, 0, 0, 0, 1);
+    if (!is_rotation || is_identity)
+      continue;
+
+    // the first ion determines the candidate translations
+    std::vector<Frac> translations;
+    if (ions.empty())
+      translations.push_back(Frac(0.0));
+    for (int j = 0; j < ions.size(); j++)
+      if (ion_types[j] == ion_types[0])
+      {
+        Frac trans = wrapDiff(ions[j], apply(rot, ions[0]));
+        for (int i = 0; i < 3; i++)
+          if (trans[i] < 0)
+            trans[i] += 1.0;
+        if (std::none_of(translations.begin(), translations.end(),
+                         [&](const Frac& t) { return sameFrac(t, trans, tol); }))
+          translations.push_back(trans);
+      }
+    // only one translation per rotation is needed, others differ by a pure translation of the cell content
+    for (const auto& trans : translations)
+      if (maps_ions(rot, trans))
+      {
+        ops.push_back({rot, trans});
+        break;
+      }
+  }
+  return ops;
+}
+
+SplineSymmetryImages findSymmetryImages(const std::vector<SpaceGroupOperation>& ops,
+                                        const std::vector<TinyVector<double, 3>>& twists,
+                                        const std::vector<int>& bands,
+                                        int slot_alignment,
+                                        bool time_reversal)
+{
+  constexpr double twist_tol = 1e-6;
+  // orbitals of each distinct twist in the order of appearance
+  std::vector<Frac> distinct_twists;
+  std::vector<std::vector<int>> twist_orbitals;
+  for (int iorb = 0; iorb < twists.size(); iorb++)
+  {
+    int it = 0;
+    while (it < distinct_twists.size() && !sameFrac(distinct_twists[it], twists[iorb], twist_tol))
+      it++;
+    if (it == distinct_twists.size())
+    {
+      distinct_twists.push_back(twists[iorb]);
+      twist_orbitals.emplace_back();
+    }
+    twist_orbitals[it].push_back(iorb);
+  }
+  const auto sorted_bands = [&](int it) {
+    std::vector<int> res;
+    for (const int iorb : twist_orbitals[it])
+      res.push_back(bands[iorb]);
+    std::sort(res.begin(), res.end());
+    return res;
+  };
+
+  SplineSymmetryImages images;
+  images.twists = twists;
+  int num_slots = 0;
+  std::vector<int> stored_first_slot(distinct_twists.size(), -1);
+  for (int it = 0; it < distinct_twists.size(); it++)
+  {
+    SplineSymmetryImages::Block block;
+    int source = -1;
+    for (int is = 0; is < it && source < 0; is++)
+    {
+      if (stored_first_slot[is] < 0 || sorted_bands(is) != sorted_bands(it))
+        continue;
+      for (const auto& op : ops)
+      {
+        const Tensor<int, 3> rot_inv = inverseUnimodular(op.rot);
+        const Frac rotated           = apply(transpose(rot_inv), distinct_twists[is]);
+        for (const bool conjugate : {false, true})
+        {
+          if (conjugate && !time_reversal)
+            continue;
+          const Frac image = conjugate ? -1.0 * rotated : rotated;
+          if (sameFrac(image, distinct_twists[it], twist_tol))
+          {
+            source          = is;
+            block.rot_inv   = rot_inv;
+            block.trans     = op.trans;
+            block.conjugate = conjugate;
+            for (const int iorb : twist_orbitals[it])
+              images.twists[iorb] = image;
+            break;
+          }
+        }
+        if (source >= 0)
+          break;
+      }
+    }
+
+    if (source < 0)
+    {
+      // a new stored twist
+      source                = it;
+      block.rot_inv         = Tensor<int, 3>(1, 0, 0, 0, 1, 0, 0, 0, 1);
+      block.trans           = Frac(0.0);
+      stored_first_slot[it] = num_slots;
+      num_slots += alignUp(twist_orbitals[it].size(), slot_alignment);
+      images.slot_orbitals.resize(num_slots, -1);
+      for (int m = 0; m < twist_orbitals[it].size(); m++)
+        images.slot_orbitals[stored_first_slot[it] + m] = twist_orbitals[it][m];
+      images.num_stored_twists++;
+    }
+
+    // orbitals of this twist in the order of the stored ones
+    std::map<int, int> band_to_orbital;
+    for (const int iorb : twist_orbitals[it])
+      band_to_orbital[bands[iorb]] = iorb;
+    for (const int iorb : twist_orbitals[source])
+      block.orbitals.push_back(band_to_orbital[bands[iorb]]);
+    block.first_slot = stored_first_slot[source];
+    block.image_slot = images.num_image_slots;
+    images.num_image_slots += alignUp(block.orbitals.size(), slot_alignment);
+    images.blocks.push_back(std::move(block));
+  }
+  return images;
+}
+
+} // namespace qmcplusplus
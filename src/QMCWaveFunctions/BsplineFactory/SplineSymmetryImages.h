@@ -0,0 +1,154 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file SplineSymmetryImages.h
+ *
+ * space group operations of a crystal and the map of spline orbitals onto those of the symmetry irreducible twists
+ */
+#ifndef QMCPLUSPLUS_SPLINE_SYMMETRY_IMAGES_H
+#define QMCPLUSPLUS_SPLINE_SYMMETRY_IMAGES_H
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "OhmmsPETE/TinyVector.h"
+#include "OhmmsPETE/Tensor.h"
+
+namespace qmcplusplus
+{
+/// space group operation x -> rot x + trans acting on the fractional coordinates of the primitive cell
+struct SpaceGroupOperation
+{
+  Tensor<int, 3> rot;
+  TinyVector<double, 3> trans;
+};
+
+/** find the space group operations of a crystal
+ * @param lattice primitive cell, rows are the lattice vectors
+ * @param ion_frac fractional coordinates of the ions, periodic images may be repeated
+ * @param ion_types species index of each ion
+ * @param tol tolerance on the fractional coordinates
+ * @return the operations, identity first and pure lattice translations excluded
+ *
+ * Rotations are searched among the matrices with entries -1, 0 and 1 which is complete for reduced cells.
+ */
+std::vector<SpaceGroupOperation> findSpaceGroupOperations(const Tensor<double, 3>& lattice,
+                                                          const std::vector<TinyVector<double, 3>>& ion_frac,
+                                                          const std::vector<int>& ion_types,
+                                                          double tol = 1e-5);
+
+/** orbitals of a spline set evaluated from the orbitals of the symmetry irreducible twists stored in the table
+ *
+ * With u(x) the periodic part of a stored orbital at twist k, the operation {S|f} gives the orbital at twist S^{-T}k
+ * with the periodic part u(S^{-1}(x - f)), up to a constant phase. Time reversal additionally conjugates u and
+ * negates the twist. All the orbitals, including those of the irreducible twists, are organized in blocks
+ * sharing one stored twist and one operation so that a block is a single spline evaluation.
+ */
+struct SplineSymmetryImages
+{
+  /// orbitals sharing a stored twist and an operation
+  struct Block
+  {
+    /// S^{-1}, maps the electron position onto the stored orbitals
+    Tensor<int, 3> rot_inv;
+    /// f, the fractional translation of the operation
+    TinyVector<double, 3> trans;
+    /// conjugate the stored orbitals, time reversal
+    bool conjugate = false;
+    /// first slot of the stored orbitals in the spline table
+    int first_slot = 0;
+    /// first slot of the block in the intermediate result buffers
+    int image_slot = 0;
+    /// orbital index of each stored orbital of the block
+    std::vector<int> orbitals;
+  };
+
+  std::vector<Block> blocks;
+  /// orbital index of each slot in the spline table, -1 for padding
+  std::vector<int> slot_orbitals;
+  /// number of slots of the intermediate result buffers
+  int num_image_slots = 0;
+  /// number of stored twists
+  int num_stored_twists = 0;
+  /// twist of each orbital generated by the operations, equal to the input one up to reciprocal lattice vectors
+  std::vector<TinyVector<double, 3>> twists;
+
+  /// map a position in fractional coordinates onto the stored orbitals of a block
+  template<typename T>
+  static TinyVector<T, 3> mapPosition(const Block& block, const TinyVector<T, 3>& ru)
+  {
+    const TinyVector<T, 3> shifted(ru[0] - block.trans[0], ru[1] - block.trans[1], ru[2] - block.trans[2]);
+    TinyVector<T, 3> mapped;
+    for (int i = 0; i < 3; i++)
+    {
+      mapped[i] = block.rot_inv(i, 0) * shifted[0] + block.rot_inv(i, 1) * shifted[1] + block.rot_inv(i, 2) * shifted[2];
+      if (-std::numeric_limits<T>::epsilon() < mapped[i] && mapped[i] < 0)
+        mapped[i] = T(0);
+      else
+        mapped[i] -= std::floor(mapped[i]);
+    }
+    return mapped;
+  }
+};
+
+/** find the symmetry irreducible twists of a spline set and map the orbitals of the other twists onto them
+ * @param ops space group operations
+ * @param twists fractional twist of each orbital
+ * @param bands band index of each orbital
+ * @param slot_alignment the stored twists and the blocks start at multiples of slot_alignment slots
+ * @param time_reversal also relate k and -k
+ *
+ * A twist is an image of a stored one only if both hold the same bands.
+ */
+SplineSymmetryImages findSymmetryImages(const std::vector<SpaceGroupOperation>& ops,
+                                        const std::vector<TinyVector<double, 3>>& twists,
+                                        const std::vector<int>& bands,
+                                        int slot_alignment,
+                                        bool time_reversal = true);
+
+/// gradient of u(A x) with respect to x from the gradient g of u at A x
+template<typename T>
+inline TinyVector<T, 3> imageGradient(const Tensor<int, 3>& a, const TinyVector<T, 3>& g)
+{
+  TinyVector<T, 3> res;
+  for (int i = 0; i < 3; i++)
+    res[i] = a(0, i) * g[0] + a(1, i) * g[1] + a(2, i) * g[2];
+  return res;
+}
+
+/// hessian of u(A x) with respect to x from the hessian h of u at A x
+template<typename T>
+inline Tensor<T, 3> imageHessian(const Tensor<int, 3>& a, const Tensor<T, 3>& h)
+{
+  Tensor<T, 3> ha, res;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      ha(i, j) = h(i, 0) * a(0, j) + h(i, 1) * a(1, j) + h(i, 2) * a(2, j);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      res(i, j) = a(0, i) * ha(0, j) + a(1, i) * ha(1, j) + a(2, i) * ha(2, j);
+  return res;
+}
+
+/// third derivatives of u(A x) with respect to x from those of u at A x, gh[i](j, k) = d^3 u / dx_i dx_j dx_k
+template<typename T>
+inline TinyVector<Tensor<T, 3>, 3> imageGradHessian(const Tensor<int, 3>& a, const TinyVector<Tensor<T, 3>, 3>& gh)
+{
+  const TinyVector<Tensor<T, 3>, 3> h(imageHessian(a, gh[0]), imageHessian(a, gh[1]), imageHessian(a, gh[2]));
+  TinyVector<Tensor<T, 3>, 3> res;
+  for (int i = 0; i < 3; i++)
+    res[i] = T(a(0, i)) * h[0] + T(a(1, i)) * h[1] + T(a(2, i)) * h[2];
+  return res;
+}
+
+} // namespace qmcplusplus
+#endif
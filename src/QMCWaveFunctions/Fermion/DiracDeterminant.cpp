@@ -574,6 +574,37 @@ typename DiracDeterminant<DU_TYPE>::GradType DiracDeterminant<DU_TYPE>::evalGrad
   return g;
 }
 
+template<typename DU_TYPE>
+void DiracDeterminant<DU_TYPE>::mw_evalGradSource(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                                  const RefVectorWithLeader<ParticleSet>& p_list,
+                                                  ParticleSet& source,
+                                                  int iat,
+                                                  std::vector<GradType>& grads) const
+{
+  if (!Phi->hasIonDerivs())
+    return;
+
+  RefVectorWithLeader<SPOSet> phi_list(*Phi);
+  phi_list.reserve(wfc_list.size());
+  RefVector<GradMatrix> grad_source_list;
+  grad_source_list.reserve(wfc_list.size());
+  for (WaveFunctionComponent& wfc : wfc_list)
+  {
+    auto& det = static_cast<DiracDeterminant<DU_TYPE>&>(wfc);
+    det.resizeScratchObjectsForIonDerivs();
+    phi_list.push_back(*det.Phi);
+    grad_source_list.push_back(det.grad_source_psiM);
+  }
+
+  Phi->mw_evaluateGradSource(phi_list, p_list, FirstIndex, LastIndex, source, iat, grad_source_list);
+
+  for (int iw = 0; iw < wfc_list.size(); iw++)
+  {
+    auto& det = wfc_list.getCastedElement<DiracDeterminant<DU_TYPE>>(iw);
+    grads[iw] += simd::dot(det.psiM.data(), det.grad_source_psiM.data(), det.psiM.size());
+  }
+}
+
 template<typename DU_TYPE>
 void DiracDeterminant<DU_TYPE>::evaluateHessian(ParticleSet& P, HessVector& grad_grad_psi)
 {
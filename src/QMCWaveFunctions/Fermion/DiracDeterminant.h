@@ -141,6 +141,12 @@ public:
 
   GradType evalGradSource(ParticleSet& P, ParticleSet& source, int iat) override;
 
+  void mw_evalGradSource(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                         const RefVectorWithLeader<ParticleSet>& p_list,
+                         ParticleSet& source,
+                         int iat,
+                         std::vector<GradType>& grads) const override;
+
   GradType evalGradSource(ParticleSet& P,
                           ParticleSet& source,
                           int iat,
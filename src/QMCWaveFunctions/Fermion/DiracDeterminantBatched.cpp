@@ -927,6 +927,40 @@ typename DiracDeterminantBatched<PL, VT, FPVT>::Grad DiracDeterminantBatched<PL,
   return g;
 }
 
+template<PlatformKind PL, typename VT, typename FPVT>
+void DiracDeterminantBatched<PL, VT, FPVT>::mw_evalGradSource(
+    const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+    const RefVectorWithLeader<ParticleSet>& p_list,
+    ParticleSet& source,
+    int iat,
+    std::vector<Grad>& grads) const
+{
+  if (!Phi->hasIonDerivs())
+    return;
+
+  RefVectorWithLeader<SPOSet> phi_list(*Phi);
+  phi_list.reserve(wfc_list.size());
+  RefVector<Matrix<Grad>> grad_source_list;
+  grad_source_list.reserve(wfc_list.size());
+  for (WaveFunctionComponent& wfc : wfc_list)
+  {
+    auto& det = static_cast<DiracDeterminantBatched<PL, VT, FPVT>&>(wfc);
+    det.resizeScratchObjectsForIonDerivs();
+    phi_list.push_back(*det.Phi);
+    grad_source_list.push_back(det.grad_source_psiM);
+  }
+
+  Phi->mw_evaluateGradSource(phi_list, p_list, FirstIndex, LastIndex, source, iat, grad_source_list);
+
+  for (int iw = 0; iw < wfc_list.size(); iw++)
+  {
+    auto& det = wfc_list.getCastedElement<DiracDeterminantBatched<PL, VT, FPVT>>(iw);
+    // psiMinv columns have padding but grad_source_psiM ones don't
+    for (int i = 0; i < det.psiMinv_.rows(); i++)
+      grads[iw] += simd::dot(det.psiMinv_[i], det.grad_source_psiM[i], NumOrbitals);
+  }
+}
+
 template<PlatformKind PL, typename VT, typename FPVT>
 void DiracDeterminantBatched<PL, VT, FPVT>::evaluateHessian(ParticleSet& P, HessVector& grad_grad_psi)
 {
@@ -183,6 +183,12 @@ public:
    */
   Grad evalGradSource(ParticleSet& P, ParticleSet& source, int iat) override;
 
+  void mw_evalGradSource(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                         const RefVectorWithLeader<ParticleSet>& p_list,
+                         ParticleSet& source,
+                         int iat,
+                         std::vector<Grad>& grads) const override;
+
   Grad evalGradSource(ParticleSet& P,
                       ParticleSet& source,
                       int iat,
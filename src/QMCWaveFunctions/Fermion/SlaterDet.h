@@ -180,6 +180,16 @@ public:
     return G;
   }
 
+  void mw_evalGradSource(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                         const RefVectorWithLeader<ParticleSet>& p_list,
+                         ParticleSet& src,
+                         int iat,
+                         std::vector<GradType>& grads) const override
+  {
+    for (int iz = 0; iz < size(); iz++)
+      Dets[iz]->mw_evalGradSource(extract_DetRef_list(wfc_list, iz), p_list, src, iat, grads);
+  }
+
   GradType evalGradSource(ParticleSet& P,
                           ParticleSet& src,
                           int iat,
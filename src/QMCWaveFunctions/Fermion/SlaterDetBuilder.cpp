@@ -18,10 +18,12 @@
 
 #include "SlaterDetBuilder.h"
 #include <type_traits>
+#include <algorithm>
 #include <bitset>
 #include <unordered_map>
 #include "QMCWaveFunctions/SPOSetBuilderFactory.h"
 #include "Utilities/ProgressReportEngine.h"
+#include "Message/CommOperators.h"
 #include "OhmmsData/AttributeSet.h"
 #include "PlatformSelector.hpp"
 
@@ -1015,6 +1017,42 @@ bool SlaterDetBuilder::readDetList(xmlNodePtr cur,
   return success;
 }
 
+namespace
+{
+/// hash of a row of packed occupation words, rows are identified by their index in the matrix
+struct PackedConfigurationHash
+{
+  const Matrix<uint64_t>& words;
+  size_t operator()(size_t row) const
+  {
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t k = 0; k < words.cols(); k++)
+    {
+      h ^= words[row][k];
+      h *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(h ^ (h >> 32));
+  }
+};
+
+struct PackedConfigurationEqual
+{
+  const Matrix<uint64_t>& words;
+  bool operator()(size_t a, size_t b) const { return std::equal(words[a], words[a] + words.cols(), words[b]); }
+};
+
+/// broadcasts n trivially copyable elements from the master, in chunks small enough for the int count of MPI
+template<typename T>
+void bcast_trivial(Communicate& comm, T* data, size_t n)
+{
+  static_assert(std::is_trivially_copyable<T>::value, "bcast_trivial requires a trivially copyable type");
+  constexpr size_t chunk = size_t(1) << 30;
+  char* bytes            = reinterpret_cast<char*>(data);
+  for (size_t i = 0; i < n * sizeof(T); i += chunk)
+    comm.bcast(bytes + i, static_cast<int>(std::min(chunk, n * sizeof(T) - i)));
+}
+} // namespace
+
 bool SlaterDetBuilder::readDetListH5(xmlNodePtr cur,
                                      std::vector<std::vector<ci_configuration>>& uniqueConfgs,
                                      std::vector<std::vector<size_t>>& C2nodes,
@@ -1034,9 +1072,7 @@ bool SlaterDetBuilder::readDetListH5(xmlNodePtr cur,
   CItags.clear();
   coeff.clear();
   std::string CICoeffH5path("");
-  std::vector<std::vector<ci_configuration>> confgLists(nGroups);
   std::vector<ValueType> CIcoeff;
-  std::vector<std::string> ConfigTag;
   std::string optCI = "no";
   RealType cutoff   = 0.0;
   OhmmsAttributeSet ciAttrib;
@@ -1068,9 +1104,8 @@ bool SlaterDetBuilder::readDetListH5(xmlNodePtr cur,
   const unsigned bit_kind = 64;
   static_assert(bit_kind == sizeof(uint64_t) * 8, "Must be 64 bit fixed width integer");
   /// the number of 64 bit integers which represent the binary string for occupation
-  int N_int;
+  int N_int = 0;
   std::string Dettype = "DETS";
-  ValueType sumsq     = 0.0;
   OhmmsAttributeSet spoAttrib;
   spoAttrib.add(ndets, "size");
   spoAttrib.add(Dettype, "type");
@@ -1089,169 +1124,174 @@ bool SlaterDetBuilder::readDetListH5(xmlNodePtr cur,
               "(type=\"Determinants\") .\n");
   app_log() << "Reading CI expansion from HDF5:" << multidetH5path << std::endl;
 
-  hdf_archive hin;
-  if (!hin.open(multidetH5path.c_str(), H5F_ACC_RDONLY))
+  // Only the master reads the file and finds the unique configurations, by hashing the packed occupation words.
+  // The unique configurations, the map of every determinant to them and the coefficients are then broadcast.
+  std::vector<std::vector<uint64_t>> uniqueWords(nGroups);
+  std::vector<size_t> detIndex;
+  if (myComm->rank() == 0)
   {
-    std::cerr << "Could not open H5 file" << std::endl;
-    abort();
-  }
-
-
-  hin.push("MultiDet", false);
-
-  hin.read(H5_ndets, "NbDet");
-  if (ndets != H5_ndets)
-  {
-    std::cerr << "Number of determinants in H5 file (" << H5_ndets << ") different from number of dets in XML ("
-              << ndets << ")" << std::endl;
-    abort();
-  }
-
-  hin.read(H5_nstates, "nstate");
-  if (nstates == 0)
-    nstates = H5_nstates;
-  else if (nstates != H5_nstates)
-  {
-    std::cerr << "Number of states/orbitals in H5 file (" << H5_nstates
-              << ") different from number of states/orbitals in XML (" << nstates << ")" << std::endl;
-    abort();
-  }
+    hdf_archive hin;
+    if (!hin.open(multidetH5path.c_str(), H5F_ACC_RDONLY))
+    {
+      std::cerr << "Could not open H5 file" << std::endl;
+      abort();
+    }
 
-  hin.read(N_int, "Nbits");
-  CIcoeff.resize(ndets);
-  ConfigTag.resize(ndets);
+    hin.push("MultiDet", false);
 
-  readCoeffs(hin, CIcoeff, ndets, extlevel);
+    hin.read(H5_ndets, "NbDet");
+    if (ndets != H5_ndets)
+    {
+      std::cerr << "Number of determinants in H5 file (" << H5_ndets << ") different from number of dets in XML ("
+                << ndets << ")" << std::endl;
+      abort();
+    }
 
-  ///IF OPTIMIZED COEFFICIENTS ARE PRESENT IN opt_coeffs Path
-  ///THEY ARE READ FROM DIFFERENT HDF5 the replace the previous coeff
-  ///It is important to still read all old coeffs and only replace the optimized ones
-  ///in order to keep coherence with the cutoff on the number of determinants
-  ///REMEMBER!! FIRST COEFF IS FIXED. THEREFORE WE DO NOT REPLACE IT!!!
-  if (CICoeffH5path != "")
-  {
-    int OptCiSize = 0;
-    std::vector<ValueType> CIcoeffopt;
-    hdf_archive coeffin;
-    if (!coeffin.open(CICoeffH5path.c_str(), H5F_ACC_RDONLY))
+    hin.read(H5_nstates, "nstate");
+    if (nstates == 0)
+      nstates = H5_nstates;
+    else if (nstates != H5_nstates)
     {
-      std::cerr << "Could not open H5 file containing Optimized Coefficients" << std::endl;
+      std::cerr << "Number of states/orbitals in H5 file (" << H5_nstates
+                << ") different from number of states/orbitals in XML (" << nstates << ")" << std::endl;
       abort();
     }
 
-    coeffin.push("MultiDet", false);
+    hin.read(N_int, "Nbits");
+    CIcoeff.resize(ndets);
 
-    coeffin.read(OptCiSize, "NbDet");
-    CIcoeffopt.resize(OptCiSize);
+    readCoeffs(hin, CIcoeff, ndets, extlevel);
 
-    readCoeffs(coeffin, CIcoeffopt, ndets, extlevel);
+    ///IF OPTIMIZED COEFFICIENTS ARE PRESENT IN opt_coeffs Path
+    ///THEY ARE READ FROM DIFFERENT HDF5 the replace the previous coeff
+    ///It is important to still read all old coeffs and only replace the optimized ones
+    ///in order to keep coherence with the cutoff on the number of determinants
+    ///REMEMBER!! FIRST COEFF IS FIXED. THEREFORE WE DO NOT REPLACE IT!!!
+    if (CICoeffH5path != "")
+    {
+      int OptCiSize = 0;
+      std::vector<ValueType> CIcoeffopt;
+      hdf_archive coeffin;
+      if (!coeffin.open(CICoeffH5path.c_str(), H5F_ACC_RDONLY))
+      {
+        std::cerr << "Could not open H5 file containing Optimized Coefficients" << std::endl;
+        abort();
+      }
 
-    coeffin.close();
+      coeffin.push("MultiDet", false);
 
-    for (int i = 0; i < OptCiSize; i++)
-      CIcoeff[i + 1] = CIcoeffopt[i];
+      coeffin.read(OptCiSize, "NbDet");
+      CIcoeffopt.resize(OptCiSize);
 
-    app_log() << "The first " << OptCiSize
-              << " Optimized coefficients were substituted to the original set of coefficients." << std::endl;
-  }
+      readCoeffs(coeffin, CIcoeffopt, ndets, extlevel);
 
-  std::vector<Matrix<uint64_t>> temps;
-  for (int grp = 0; grp < nGroups; grp++)
-  {
-    Matrix<uint64_t> tmp(ndets, N_int);
-    temps.push_back(tmp);
-    std::string ci_str;
+      coeffin.close();
 
-    std::string ds_tag = "CI_" + std::to_string(grp);
-    if (!hin.is_dataset(ds_tag))
-    {
-      //for backwards compatibility
-      if (grp == 0)
-        ds_tag = "CI_Alpha";
-      else if (grp == 1)
-        ds_tag = "CI_Beta";
-    }
+      for (int i = 0; i < OptCiSize; i++)
+        CIcoeff[i + 1] = CIcoeffopt[i];
 
-    if (!hin.is_dataset_of_type<uint64_t>(ds_tag))
-    {
-      if (hin.is_dataset_of_type<int64_t>(ds_tag))
-        APP_ABORT(
-            "QMCPACK expects the HDF5 CI vectors to be stored as unsigned 64 bit integers. This HDF5 uses signed 64 "
-            "bit integers. The determinants_tools.py script can transform this file using the 'transform' flag.");
-      APP_ABORT("Unknown HDF5 CI format");
+      app_log() << "The first " << OptCiSize
+                << " Optimized coefficients were substituted to the original set of coefficients." << std::endl;
     }
 
-    if (!hin.readEntry(temps[grp], ds_tag))
-      throw std::runtime_error("Unknown HDF5 CI format");
-  }
+    std::vector<Matrix<uint64_t>> temps;
+    for (int grp = 0; grp < nGroups; grp++)
+    {
+      temps.emplace_back(ndets, N_int);
 
-  std::vector<std::string> MyCIs(nGroups);
-  std::vector<ci_configuration> dummyCs(nGroups);
-  for (int grp = 0; grp < nGroups; grp++)
-  {
-    MyCIs[grp].resize(nstates);
-    dummyCs[grp].occup.resize(nstates, false);
-    for (size_t i = 0; i < nstates; i++)
-      dummyCs[grp].occup[i] = true;
-  }
+      std::string ds_tag = "CI_" + std::to_string(grp);
+      if (!hin.is_dataset(ds_tag))
+      {
+        //for backwards compatibility
+        if (grp == 0)
+          ds_tag = "CI_Alpha";
+        else if (grp == 1)
+          ds_tag = "CI_Beta";
+      }
 
-  hin.close();
-  app_log() << " Done reading " << ndets << " CIs from H5!" << std::endl;
+      if (!hin.is_dataset_of_type<uint64_t>(ds_tag))
+      {
+        if (hin.is_dataset_of_type<int64_t>(ds_tag))
+          APP_ABORT(
+              "QMCPACK expects the HDF5 CI vectors to be stored as unsigned 64 bit integers. This HDF5 uses signed 64 "
+              "bit integers. The determinants_tools.py script can transform this file using the 'transform' flag.");
+        APP_ABORT("Unknown HDF5 CI format");
+      }
 
-  std::vector<int> cnts(nGroups, 0);
-  std::vector<std::unordered_map<std::string, int>> MyMaps(nGroups);
+      if (!hin.readEntry(temps[grp], ds_tag))
+        throw std::runtime_error("Unknown HDF5 CI format");
+    }
 
-  app_log() << " Sorting unique CIs" << std::endl;
-  ///This loop will find all unique Determinants in and store them "unsorted" in a new container uniqueConfg_up
-  ///and uniqueConfg_dn. The sorting is not done here
-  for (int ni = 0; ni < ndets; ni++)
-  {
-    if (std::abs(CIcoeff[ni]) < cutoff)
-      continue;
+    hin.close();
+    app_log() << " Done reading " << ndets << " CIs from H5!" << std::endl;
 
-    int j = 0;
-    for (int k = 0; k < N_int; k++)
+    app_log() << " Sorting unique CIs" << std::endl;
+    ///This loop will find all unique Determinants in and store them "unsorted" in uniqueWords,
+    ///keyed by the row of their first occurrence. The sorting is not done here
+    std::vector<std::vector<size_t>> uniqueRows(nGroups);
+    std::vector<std::unordered_map<size_t, size_t, PackedConfigurationHash, PackedConfigurationEqual>> MyMaps;
+    for (int grp = 0; grp < nGroups; grp++)
+      MyMaps.emplace_back(0, PackedConfigurationHash{temps[grp]}, PackedConfigurationEqual{temps[grp]});
+    for (size_t ni = 0; ni < ndets; ni++)
     {
-      std::vector<std::bitset<bit_kind>> a2s(nGroups);
+      if (std::abs(CIcoeff[ni]) < cutoff)
+        continue;
+      coeff.push_back(CIcoeff[ni]);
+      detIndex.push_back(ni);
       for (int grp = 0; grp < nGroups; grp++)
       {
-        uint64_t a = temps[grp][ni][k];
-        a2s[grp]   = a;
-      }
-
-      for (int i = 0; i < bit_kind; i++)
-      {
-        if (j < nstates)
-        {
-          for (int grp = 0; grp < nGroups; grp++)
-            MyCIs[grp][j] = a2s[grp][i] ? '1' : '0';
-          j++;
-        }
+        auto got = MyMaps[grp].try_emplace(ni, uniqueRows[grp].size());
+        if (got.second)
+          uniqueRows[grp].push_back(ni);
+        C2nodes[grp].push_back(got.first->second);
       }
     }
-    coeff.push_back(CIcoeff[ni]);
-    std::ostringstream h5tag;
-    h5tag << "CIcoeff_" << ni;
-    CItags.push_back(h5tag.str());
 
     for (int grp = 0; grp < nGroups; grp++)
     {
-      std::unordered_map<std::string, int>::const_iterator got = MyMaps[grp].find(MyCIs[grp]);
+      uniqueWords[grp].resize(uniqueRows[grp].size() * N_int);
+      for (size_t i = 0; i < uniqueRows[grp].size(); i++)
+        std::copy_n(temps[grp][uniqueRows[grp][i]], N_int, uniqueWords[grp].data() + i * N_int);
+    }
+  }
 
-      if (got == MyMaps[grp].end())
-      {
-        uniqueConfgs[grp].push_back(dummyCs[grp]);
-        uniqueConfgs[grp].back().add_occupation(MyCIs[grp]);
-        C2nodes[grp].push_back(cnts[grp]);
-        MyMaps[grp].insert(std::pair<std::string, int>(MyCIs[grp], cnts[grp]));
-        cnts[grp]++;
-      }
-      else
-      {
-        C2nodes[grp].push_back(got->second);
-      }
+  std::vector<int> sizes{static_cast<int>(nstates), N_int, static_cast<int>(coeff.size())};
+  for (int grp = 0; grp < nGroups; grp++)
+    sizes.push_back(static_cast<int>(uniqueWords[grp].size() / std::max(N_int, 1)));
+  myComm->bcast(sizes);
+  nstates = sizes[0];
+  N_int   = sizes[1];
+  coeff.resize(sizes[2]);
+  bcast_trivial(*myComm, coeff.data(), coeff.size());
+  // every rank has the coefficients kept after the cutoff from here on
+  ValueType sumsq = 0.0;
+  for (const auto& ci : coeff)
+    sumsq += ci * ci;
+  // the original index of every determinant is only needed for the names of the optimizable coefficients
+  if (optimizeCI)
+  {
+    detIndex.resize(coeff.size());
+    bcast_trivial(*myComm, detIndex.data(), detIndex.size());
+    CItags.reserve(coeff.size());
+    for (size_t i = 0; i < detIndex.size(); i++)
+      CItags.push_back("CIcoeff_" + std::to_string(detIndex[i]));
+  }
+  for (int grp = 0; grp < nGroups; grp++)
+  {
+    C2nodes[grp].resize(coeff.size());
+    bcast_trivial(*myComm, C2nodes[grp].data(), C2nodes[grp].size());
+    uniqueWords[grp].resize(size_t(sizes[3 + grp]) * N_int);
+    bcast_trivial(*myComm, uniqueWords[grp].data(), uniqueWords[grp].size());
+
+    uniqueConfgs[grp].resize(sizes[3 + grp]);
+    for (size_t i = 0; i < uniqueConfgs[grp].size(); i++)
+    {
+      const uint64_t* words = uniqueWords[grp].data() + i * N_int;
+      auto& occup           = uniqueConfgs[grp][i].occup;
+      occup.resize(nstates);
+      for (size_t j = 0; j < nstates; j++)
+        occup[j] = (words[j / bit_kind] >> (j % bit_kind)) & 1;
     }
-    sumsq += CIcoeff[ni] * CIcoeff[ni];
   }
 
   app_log() << " Done Sorting unique CIs" << std::endl;
@@ -27,6 +27,9 @@ struct J1OrbitalSoAMultiWalkerMem : public Resource
   Vector<T, OffloadPinnedAllocator<T>> mw_vals;
   // multi walker -1
   Vector<int, OffloadPinnedAllocator<int>> mw_minus_one;
+  // distances of all the walkers and electrons to one ion and the functor values at them, see mw_evalGradSource
+  aligned_vector<T> mw_ion_dists, mw_u, mw_du, mw_d2u, mw_dist_compressed;
+  aligned_vector<int> mw_dist_indices;
 
   void resize_minus_one(size_t size)
   {
@@ -106,6 +109,51 @@ void J1OrbitalSoA<FT>::releaseResource(ResourceCollection& collection,
   collection.takebackResource(wfc_leader.mw_mem_handle_);
 }
 
+template<typename FT>
+void J1OrbitalSoA<FT>::mw_evalGradSource(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                         const RefVectorWithLeader<ParticleSet>& p_list,
+                                         ParticleSet& source,
+                                         int isrc,
+                                         std::vector<GradType>& grads) const
+{
+  const int gid = source.getGroupID(isrc);
+  if (J1UniqueFunctors[gid] == nullptr)
+    return;
+
+  auto& wfc_leader = wfc_list.getCastedLeader<J1OrbitalSoA<FT>>();
+  auto& mw_mem     = wfc_leader.mw_mem_handle_.getResource();
+  const size_t nw  = wfc_list.size();
+  const size_t n   = nw * Nelec;
+  mw_mem.mw_ion_dists.resize(n);
+  mw_mem.mw_u.resize(n);
+  mw_mem.mw_du.resize(n);
+  mw_mem.mw_d2u.resize(n);
+  mw_mem.mw_dist_compressed.resize(n);
+  mw_mem.mw_dist_indices.resize(n);
+
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    const auto& d_ie = p_list[iw].getDistTableAB(myTableID);
+    for (int iel = 0; iel < Nelec; ++iel)
+      mw_mem.mw_ion_dists[iw * Nelec + iel] = d_ie.getDistRow(iel)[isrc];
+  }
+
+  // the functor only writes the pairs within its cutoff
+  std::fill(mw_mem.mw_du.begin(), mw_mem.mw_du.end(), valT(0));
+  // one functor call for the electrons of all the walkers
+  J1UniqueFunctors[gid]->evaluateVGL(-1, 0, n, mw_mem.mw_ion_dists.data(), mw_mem.mw_u.data(), mw_mem.mw_du.data(),
+                                     mw_mem.mw_d2u.data(), mw_mem.mw_dist_compressed.data(),
+                                     mw_mem.mw_dist_indices.data());
+
+  // evaluateVGL returns du/r
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    const auto& d_ie = p_list[iw].getDistTableAB(myTableID);
+    for (int iel = 0; iel < Nelec; ++iel)
+      grads[iw] -= mw_mem.mw_du[iw * Nelec + iel] * d_ie.getDisplRow(iel)[isrc];
+  }
+}
+
 template<typename FT>
 void J1OrbitalSoA<FT>::mw_evaluateRatios(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
                                          const RefVectorWithLeader<const VirtualParticleSet>& vp_list,
@@ -645,6 +645,15 @@ public:
     return g_return;
   }
 
+  /** batched version of evalGradSource
+   *  The functor of the source group is evaluated once for the electrons of all the walkers.
+   */
+  void mw_evalGradSource(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                         const RefVectorWithLeader<ParticleSet>& p_list,
+                         ParticleSet& source,
+                         int isrc,
+                         std::vector<GradType>& grads) const override;
+
   inline GradType evalGradSource(ParticleSet& P,
                                  ParticleSet& source,
                                  int isrc,
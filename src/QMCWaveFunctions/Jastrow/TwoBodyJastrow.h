@@ -209,6 +209,14 @@ public:
 
   GradType evalGrad(ParticleSet& P, int iat) override;
 
+  /// electron-electron correlation does not depend on the source particles, nothing to add
+  void mw_evalGradSource(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                         const RefVectorWithLeader<ParticleSet>& p_list,
+                         ParticleSet& source,
+                         int iat,
+                         std::vector<GradType>& grads) const override
+  {}
+
   PsiValue ratioGrad(ParticleSet& P, int iat, GradType& grad_iat) override;
   void mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
                     const RefVectorWithLeader<ParticleSet>& p_list,
@@ -39,6 +39,8 @@ struct LCAOrbitalSet::LCAOMultiWalkerMem : public Resource
   OffloadVector<const ValueType*> invRow_deviceptr_list; // [NVPs]
   OffloadMatrix<ValueType> rg_buffer;                    // [4][NVPs]
   OffloadVector<size_t> nVP_index_list;                  // [NVPs]
+  Matrix<ValueType> basis_grad_source_mw;                // [NW*NumPtcls*DIM][NumAO]
+  Matrix<ValueType> phi_grad_source_mw;                  // [NW*NumPtcls*DIM][NumMO]
 
 #if defined(ENABLE_CUDA) && defined(ENABLE_OFFLOAD)
   compute::Queue<PlatformKind::CUDA> queue;
@@ -1129,6 +1131,66 @@ void LCAOrbitalSet::evaluateGradSource(const ParticleSet& P,
   }
 }
 
+void LCAOrbitalSet::mw_evaluateGradSource(const RefVectorWithLeader<SPOSet>& spo_list,
+                                          const RefVectorWithLeader<ParticleSet>& P_list,
+                                          int first,
+                                          int last,
+                                          const ParticleSet& source,
+                                          int iat_src,
+                                          const RefVector<GradMatrix>& gradphi_list) const
+{
+  assert(this == &spo_list.getLeader());
+  auto& spo_leader = spo_list.getCastedLeader<LCAOrbitalSet>();
+  auto& mw_res     = spo_leader.mw_mem_handle_.getResource();
+  auto& basis_mw   = mw_res.basis_grad_source_mw;
+  auto& phi_mw     = mw_res.phi_grad_source_mw;
+
+  const size_t nw          = spo_list.size();
+  const size_t nel         = last - first;
+  const size_t output_size = gradphi_list[0].get().cols();
+  // one row per walker, electron and direction
+  const size_t nrows = nw * nel * DIM;
+  basis_mw.resize(nrows, BasisSetSize);
+
+  {
+    ScopedTimer local(basis_timer_);
+    for (size_t iw = 0; iw < nw; iw++)
+    {
+      auto& spo = spo_list.getCastedElement<LCAOrbitalSet>(iw);
+      for (size_t i = 0, iat = first; iat < last; i++, iat++)
+      {
+        spo.myBasisSet->evaluateGradSourceV(P_list[iw], iat, source, iat_src, spo.Temp);
+        for (size_t idim = 0; idim < DIM; idim++)
+          std::copy_n(spo.Temp.data(idim + 1), BasisSetSize, basis_mw[(iw * nel + i) * DIM + idim]);
+      }
+    }
+  }
+
+  const Matrix<ValueType>* phi_source = &basis_mw;
+  if (!Identity)
+  {
+    ScopedTimer local(mo_timer_);
+    assert(output_size <= OrbitalSetSize);
+    phi_mw.resize(nrows, output_size);
+    BLAS::gemm('T', 'N', output_size, nrows, BasisSetSize, 1, C->data(), BasisSetSize, basis_mw.data(), BasisSetSize, 0,
+               phi_mw.data(), output_size);
+    phi_source = &phi_mw;
+  }
+
+  // As in evaluate_ionderiv_v_impl, the ion gradient of an atomic basis function is minus its electron gradient.
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    GradMatrix& gradphi = gradphi_list[iw];
+    for (size_t i = 0; i < nel; i++)
+      for (size_t idim = 0; idim < DIM; idim++)
+      {
+        const ValueType* restrict g = (*phi_source)[(iw * nel + i) * DIM + idim];
+        for (size_t j = 0; j < output_size; j++)
+          gradphi[i][j][idim] = -g[j];
+      }
+  }
+}
+
 void LCAOrbitalSet::evaluateGradSource(const ParticleSet& P,
                                        int first,
                                        int last,
@@ -198,6 +198,17 @@ public:
                           int iat_src,
                           GradMatrix& grad_phi) final;
 
+  /** batched version of evaluateGradSource
+   *  The basis function ion gradients of all the walkers are multiplied by the MO coefficients in one GEMM.
+   */
+  void mw_evaluateGradSource(const RefVectorWithLeader<SPOSet>& spo_list,
+                             const RefVectorWithLeader<ParticleSet>& P_list,
+                             int first,
+                             int last,
+                             const ParticleSet& source,
+                             int iat_src,
+                             const RefVector<GradMatrix>& gradphi_list) const final;
+
   /**
  * \brief Calculate ion derivatives of SPO's, their gradients, and their laplacians.
  *  
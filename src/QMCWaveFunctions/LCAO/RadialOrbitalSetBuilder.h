@@ -144,6 +144,9 @@ private:
   ///safe common cutoff radius
   RealType m_rcut_safe;
 
+  ///largest radius at which any radial orbital is above the cutoff threshold of find_cutoff
+  RealType m_rsupport;
+
   /** radial functors to be finalized
    */
   std::vector<std::unique_ptr<TransformerBase<RealType>>> radTemp;
@@ -170,6 +173,7 @@ bool RadialOrbitalSetBuilder<COT>::addGrid(xmlNodePtr cur, const std::string& ra
 
   //set zero to use std::max
   m_rcut_safe = 0;
+  m_rsupport  = 0;
 
   return true;
 }
@@ -223,6 +227,7 @@ bool RadialOrbitalSetBuilder<COT>::addGridH5(hdf_archive& hin)
 
   //set zero to use std::max
   m_rcut_safe = 0;
+  m_rsupport  = 0;
 
   return true;
 }
@@ -290,6 +295,7 @@ void RadialOrbitalSetBuilder<COT>::addGaussian(xmlNodePtr cur)
   //Warning::Magic Number for max rmax of gaussians
   RealType r0 = find_cutoff(*gset, 100.);
   m_rcut_safe = std::max(m_rcut_safe, r0);
+  m_rsupport  = std::max(m_rsupport, r0);
   radTemp.push_back(std::make_unique<A2NTransformer<RealType, gto_type>>(std::move(gset)));
   m_orbitals.RnlID.push_back(m_nlms);
 }
@@ -309,6 +315,7 @@ void RadialOrbitalSetBuilder<COT>::addGaussianH5(hdf_archive& hin)
   //similar locations on a function by function basis.
   RealType r0 = find_cutoff(*gset, 100.);
   m_rcut_safe = 6 * std::max(m_rcut_safe, r0);
+  m_rsupport  = std::max(m_rsupport, r0);
   radTemp.push_back(std::make_unique<A2NTransformer<RealType, gto_type>>(std::move(gset)));
   m_orbitals.RnlID.push_back(m_nlms);
 }
@@ -346,6 +353,9 @@ void RadialOrbitalSetBuilder<COT>::finalize()
 
   app_log() << "  Setting cutoff radius " << m_rcut_safe << std::endl << std::endl;
   m_orbitals.setRmax(static_cast<RealType>(m_rcut_safe));
+  // the grid may extend well beyond the radial orbitals, the periodic images are screened by their support
+  app_log() << "  Support radius of the radial orbitals " << m_rsupport << std::endl << std::endl;
+  m_orbitals.setSupportRadius(static_cast<RealType>(m_rsupport));
 }
 
 template<typename COT>
@@ -358,6 +368,7 @@ void RadialOrbitalSetBuilder<COT>::addSlater(xmlNodePtr cur)
 
   //need a find_cutoff for STO's, but this was previously in finalize and wiping out GTO's m_rcut_safe
   m_rcut_safe = std::max(m_rcut_safe, static_cast<RealType>(100));
+  m_rsupport  = std::max(m_rsupport, static_cast<RealType>(100));
   radTemp.push_back(std::make_unique<A2NTransformer<RealType, sto_type>>(std::move(gset)));
   m_orbitals.RnlID.push_back(m_nlms);
 }
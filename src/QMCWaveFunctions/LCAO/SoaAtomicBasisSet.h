@@ -15,6 +15,7 @@
 #define QMCPLUSPLUS_SOA_SPHERICALORBITAL_BASISSET_H
 
 #include "CPU/math.hpp"
+#include "CPU/SIMD/aligned_allocator.hpp"
 #include "OptimizableObject.h"
 #include <ResourceCollection.h>
 
@@ -43,11 +44,16 @@ public:
 
   ///the constructor
   explicit SoaAtomicBasisSet(int lmax, bool addsignforM = false)
-      : Ylm(lmax, addsignforM),
+      : Rsupport(0),
+        cell_radius_(-1),
+        Ylm(lmax, addsignforM),
         periodic_image_phase_factors_ptr_(std::make_shared<OffloadVector>()),
         periodic_image_displacements_ptr_(std::make_shared<OffloadArray2D>()),
         periodic_image_phase_factors_(*periodic_image_phase_factors_ptr_),
         periodic_image_displacements_(*periodic_image_displacements_ptr_),
+        screened_images_ptr_(std::make_shared<OffloadIntVector>()),
+        screened_images_(*screened_images_ptr_),
+        lattice_phases_(1),
         NL_ptr_(std::make_shared<OffloadIntVector>()),
         LM_ptr_(std::make_shared<OffloadIntVector>()),
         NL(*NL_ptr_),
@@ -88,8 +94,15 @@ public:
 
   /** Set the number of periodic image for the evaluation of the orbitals and the phase factor.
    * In the case of Non-PBC, PBCImages=(1,1,1), SuperTwist(0,0,0) and the PhaseFactor=1.
+   *
+   * Images which cannot be within the support radius of this center for any electron are screened out.
+   * In a periodic cell the displacements from the distance table are reduced to the cell and are never
+   * longer than half the sum of the lengths of the lattice vectors, which bounds the distance to every image.
+   * The phases of the lattice vectors are stored to compose the correction phase of the distance table without sincos.
    */
-  void setPBCParams(const TinyVector<int, 3>& pbc_images,
+  template<typename LAT>
+  void setPBCParams(const LAT& lattice,
+                    const TinyVector<int, 3>& pbc_images,
                     const TinyVector<double, 3> supertwist,
                     const OffloadVector& PeriodicImagePhaseFactors,
                     const OffloadArray2D& PeriodicImageDisplacements)
@@ -99,8 +112,24 @@ public:
     periodic_image_displacements_ = PeriodicImageDisplacements;
     SuperTwist                    = supertwist;
 
+    const bool bulk = lattice.BoxBConds[0] && lattice.BoxBConds[1] && lattice.BoxBConds[2];
+    cell_radius_    = bulk ? 0.5 * (lattice.Length[0] + lattice.Length[1] + lattice.Length[2]) : -1;
+
+#if defined(QMC_COMPLEX)
+    for (size_t i_dim = 0; i_dim < 3; i_dim++)
+    {
+      RealType phasearg = 0;
+      for (size_t j_dim = 0; j_dim < 3; j_dim++)
+        phasearg += SuperTwist[j_dim] * lattice.R(i_dim, j_dim);
+      RealType s, c;
+      qmcplusplus::sincos(-phasearg, &s, &c);
+      lattice_phases_[i_dim] = ValueType(c, s);
+    }
+#endif
+
     periodic_image_phase_factors_.updateTo();
     periodic_image_displacements_.updateTo();
+    screenImages();
   }
 
 
@@ -124,9 +153,73 @@ public:
     Rmax = (rmax > 0) ? rmax : MultiRnl.rmax();
   }
 
+  /** Set the radius beyond which all the radial orbitals are negligible, only used to screen the periodic images.
+   * Rmax is used if it is not set.
+   */
+  template<typename T>
+  inline void setSupportRadius(T rsupport)
+  {
+    Rsupport = rsupport;
+    screenImages();
+  }
+
+  /// number of periodic images evaluated for every electron
+  int getNumScreenedImages() const { return screened_images_.size(); }
+
   ///set the current offset
   inline void setCenter(int c, int offset) {}
 
+  PRAGMA_OFFLOAD("omp declare target")
+  /** phase correction exp(-i k.Tv) for the lattice translation Tv applied by the distance table
+   *
+   * Tv is an integer combination of the lattice vectors, mostly zero, so the phase is composed from the phases
+   * of the lattice vectors set by setPBCParams. Falls back to sincos if Tv is not a lattice translation.
+   * @param tv translation [3]
+   * @param G inverse of the lattice vectors [3][3]
+   * @param lattice_phases phase of each lattice vector [3]
+   * @param twist SuperTwist [3]
+   */
+  template<typename TV, typename TG>
+  static inline ValueType latticeTranslationPhase(const TV* tv,
+                                                  const TG* G,
+                                                  const ValueType* lattice_phases,
+                                                  const double* twist)
+  {
+#if not defined(QMC_COMPLEX)
+    return ValueType(1);
+#else
+    ValueType phase(1);
+    bool is_translation = true;
+    for (int i_dim = 0; i_dim < 3; i_dim++)
+    {
+      RealType u = 0;
+      for (int j_dim = 0; j_dim < 3; j_dim++)
+        u += tv[j_dim] * G[i_dim + 3 * j_dim];
+      const int n    = static_cast<int>(u < 0 ? u - 0.5 : u + 0.5);
+      is_translation = is_translation && std::abs(u - n) < 1e-4;
+      for (int m = 0; m < n; m++)
+        phase *= lattice_phases[i_dim];
+      for (int m = 0; m > n; m--)
+        phase *= std::conj(lattice_phases[i_dim]);
+    }
+    if (is_translation)
+      return phase;
+
+    RealType phasearg = twist[0] * tv[0] + twist[1] * tv[1] + twist[2] * tv[2];
+    RealType s, c;
+    qmcplusplus::sincos(-phasearg, &s, &c);
+    return ValueType(c, s);
+#endif
+  }
+  PRAGMA_OFFLOAD("omp end declare target")
+
+  /// phase correction for the lattice translation Tv applied by the distance table
+  template<typename LAT, typename PosType>
+  inline ValueType correctionPhase(const LAT& lattice, const PosType& Tv) const
+  {
+    return latticeTranslationPhase(Tv.data(), lattice.G.data(), lattice_phases_.data(), SuperTwist.data());
+  }
+
   /// Sets a boolean vector for S-type orbitals.  Used for cusp correction.
   void queryOrbitalsForSType(std::vector<bool>& s_orbitals) const
   {
@@ -136,26 +229,52 @@ public:
     }
   }
 
+  /** collect the periodic images within Rmax for the block evaluation of Ylm
+   *
+   * Only the images which were not screened out by setPBCParams are considered.
+   * @param dr displacement from the center to the electron
+   * @return the number of images stored in image_xyzr_ and image_ids_
+   */
+  template<typename PosType>
+  inline size_t gatherImages(const PosType& dr)
+  {
+    const size_t Nxyz = screened_images_.size();
+    image_xyzr_.resize(Nxyz);
+    image_ids_.resize(Nxyz);
+    RealType* restrict x = image_xyzr_.data(0);
+    RealType* restrict y = image_xyzr_.data(1);
+    RealType* restrict z = image_xyzr_.data(2);
+    RealType* restrict r = image_xyzr_.data(3);
+    size_t n_img         = 0;
+    for (size_t i_img = 0; i_img < Nxyz; i_img++)
+    {
+      const int iter = screened_images_[i_img];
+      //SIGN Change!!
+      const RealType x_img = -(dr[0] + periodic_image_displacements_(iter, 0));
+      const RealType y_img = -(dr[1] + periodic_image_displacements_(iter, 1));
+      const RealType z_img = -(dr[2] + periodic_image_displacements_(iter, 2));
+      const RealType r_img = std::sqrt(x_img * x_img + y_img * y_img + z_img * z_img);
+      if (r_img >= Rmax)
+        continue;
+      x[n_img]          = x_img;
+      y[n_img]          = y_img;
+      z[n_img]          = z_img;
+      r[n_img]          = r_img;
+      image_ids_[n_img] = iter;
+      n_img++;
+    }
+    return n_img;
+  }
+
   /** evaluate VGL
    */
   template<typename LAT, typename T, typename PosType, typename VGL>
   inline void evaluateVGL(const LAT& lattice, const T r, const PosType& dr, const size_t offset, VGL& vgl, PosType Tv)
   {
-    int TransX, TransY, TransZ;
-
-    PosType dr_new;
     T r_new;
     // T psi_new, dpsi_x_new, dpsi_y_new, dpsi_z_new,d2psi_new;
 
-#if not defined(QMC_COMPLEX)
-    const ValueType correctphase = 1;
-#else
-
-    RealType phasearg = SuperTwist[0] * Tv[0] + SuperTwist[1] * Tv[1] + SuperTwist[2] * Tv[2];
-    RealType s, c;
-    qmcplusplus::sincos(-phasearg, &s, &c);
-    const ValueType correctphase(c, s);
-#endif
+    const ValueType correctphase = correctionPhase(lattice, Tv);
 
     constexpr T cone(1);
     constexpr T ctwo(2);
@@ -166,17 +285,24 @@ public:
     RealType* restrict dphi  = tempS.data(1);
     RealType* restrict d2phi = tempS.data(2);
 
+    //with enough images the Ylm of all the images within Rmax are evaluated together, [5][Nlm][ldy]
+    const size_t n_img   = gatherImages(dr);
+    const bool block_ylm = n_img >= min_block_images;
+    const size_t nYlm    = Ylm.size();
+    const size_t ldy     = block_ylm ? image_xyzr_.capacity() : 1;
+    if (block_ylm)
+    {
+      image_ylm_.resize(5 * nYlm * ldy);
+      Ylm.block_evaluateVGL(image_xyzr_.data(0), image_xyzr_.data(1), image_xyzr_.data(2), n_img, image_ylm_.data(),
+                            ldy);
+    }
+
     //V,Gx,Gy,Gz,L
-    auto* restrict psi      = vgl.data(0) + offset;
-    const T* restrict ylm_v = Ylm[0]; //value
-    auto* restrict dpsi_x   = vgl.data(1) + offset;
-    const T* restrict ylm_x = Ylm[1]; //gradX
-    auto* restrict dpsi_y   = vgl.data(2) + offset;
-    const T* restrict ylm_y = Ylm[2]; //gradY
-    auto* restrict dpsi_z   = vgl.data(3) + offset;
-    const T* restrict ylm_z = Ylm[3]; //gradZ
-    auto* restrict d2psi    = vgl.data(4) + offset;
-    const T* restrict ylm_l = Ylm[4]; //lap
+    auto* restrict psi    = vgl.data(0) + offset;
+    auto* restrict dpsi_x = vgl.data(1) + offset;
+    auto* restrict dpsi_y = vgl.data(2) + offset;
+    auto* restrict dpsi_z = vgl.data(3) + offset;
+    auto* restrict d2psi  = vgl.data(4) + offset;
 
     for (size_t ib = 0; ib < BasisSetSize; ++ib)
     {
@@ -186,65 +312,59 @@ public:
       dpsi_z[ib] = 0;
       d2psi[ib]  = 0;
     }
-    //Phase_idx (iter) needs to be initialized at -1 as it has to be incremented first to comply with the if statement (r_new >=Rmax)
-    int iter = -1;
-    for (int i = 0; i <= PBCImages[0]; i++) //loop Translation over X
-    {
-      //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-      TransX = ((i % 2) * 2 - 1) * ((i + 1) / 2);
-      for (int j = 0; j <= PBCImages[1]; j++) //loop Translation over Y
-      {
-        //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-        TransY = ((j % 2) * 2 - 1) * ((j + 1) / 2);
-        for (int k = 0; k <= PBCImages[2]; k++) //loop Translation over Z
-        {
-          //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-          TransZ = ((k % 2) * 2 - 1) * ((k + 1) / 2);
-
-          dr_new[0] = dr[0] + (TransX * lattice.R(0, 0) + TransY * lattice.R(1, 0) + TransZ * lattice.R(2, 0));
-          dr_new[1] = dr[1] + (TransX * lattice.R(0, 1) + TransY * lattice.R(1, 1) + TransZ * lattice.R(2, 1));
-          dr_new[2] = dr[2] + (TransX * lattice.R(0, 2) + TransY * lattice.R(1, 2) + TransZ * lattice.R(2, 2));
-
-          r_new = std::sqrt(dot(dr_new, dr_new));
 
-          iter++;
-          if (r_new >= Rmax)
-            continue;
+    for (size_t i_img = 0; i_img < n_img; i_img++)
+    {
+      const T x = image_xyzr_.data(0)[i_img], y = image_xyzr_.data(1)[i_img], z = image_xyzr_.data(2)[i_img];
+      r_new     = image_xyzr_.data(3)[i_img];
 
-          //SIGN Change!!
-          const T x = -dr_new[0], y = -dr_new[1], z = -dr_new[2];
-          Ylm.evaluateVGL(x, y, z);
+      const RealType *ylm_v, *ylm_x, *ylm_y, *ylm_z, *ylm_l;
+      if (block_ylm)
+      {
+        ylm_v = image_ylm_.data() + i_img; //value
+        ylm_x = ylm_v + nYlm * ldy;        //gradX
+        ylm_y = ylm_x + nYlm * ldy;        //gradY
+        ylm_z = ylm_y + nYlm * ldy;        //gradZ
+        ylm_l = ylm_z + nYlm * ldy;        //lap
+      }
+      else
+      {
+        Ylm.evaluateVGL(x, y, z);
+        ylm_v = Ylm[0];
+        ylm_x = Ylm[1];
+        ylm_y = Ylm[2];
+        ylm_z = Ylm[3];
+        ylm_l = Ylm[4];
+      }
 
-          MultiRnl.evaluate(r_new, phi, dphi, d2phi);
+      MultiRnl.evaluate(r_new, phi, dphi, d2phi);
 
-          const T rinv = cone / r_new;
+      const T rinv = cone / r_new;
 
-          ///Phase for PBC containing the phase for the nearest image displacement and the correction due to the Distance table.
-          const ValueType Phase = periodic_image_phase_factors_[iter] * correctphase;
+      ///Phase for PBC containing the phase for the nearest image displacement and the correction due to the Distance table.
+      const ValueType Phase = periodic_image_phase_factors_[image_ids_[i_img]] * correctphase;
 
-          for (size_t ib = 0; ib < BasisSetSize; ++ib)
-          {
-            const int nl(NL[ib]);
-            const int lm(LM[ib]);
-            const T drnloverr = rinv * dphi[nl];
-            const T ang       = ylm_v[lm];
-            const T gr_x      = drnloverr * x;
-            const T gr_y      = drnloverr * y;
-            const T gr_z      = drnloverr * z;
-            const T ang_x     = ylm_x[lm];
-            const T ang_y     = ylm_y[lm];
-            const T ang_z     = ylm_z[lm];
-            const T vr        = phi[nl];
-
-            psi[ib] += ang * vr * Phase;
-            dpsi_x[ib] += (ang * gr_x + vr * ang_x) * Phase;
-            dpsi_y[ib] += (ang * gr_y + vr * ang_y) * Phase;
-            dpsi_z[ib] += (ang * gr_z + vr * ang_z) * Phase;
-            d2psi[ib] += (ang * (ctwo * drnloverr + d2phi[nl]) + ctwo * (gr_x * ang_x + gr_y * ang_y + gr_z * ang_z) +
-                          vr * ylm_l[lm]) *
-                Phase;
-          }
-        }
+      for (size_t ib = 0; ib < BasisSetSize; ++ib)
+      {
+        const int nl(NL[ib]);
+        const int lm(LM[ib]);
+        const T drnloverr = rinv * dphi[nl];
+        const T ang       = ylm_v[lm * ldy];
+        const T gr_x      = drnloverr * x;
+        const T gr_y      = drnloverr * y;
+        const T gr_z      = drnloverr * z;
+        const T ang_x     = ylm_x[lm * ldy];
+        const T ang_y     = ylm_y[lm * ldy];
+        const T ang_z     = ylm_z[lm * ldy];
+        const T vr        = phi[nl];
+
+        psi[ib] += ang * vr * Phase;
+        dpsi_x[ib] += (ang * gr_x + vr * ang_x) * Phase;
+        dpsi_y[ib] += (ang * gr_y + vr * ang_y) * Phase;
+        dpsi_z[ib] += (ang * gr_z + vr * ang_z) * Phase;
+        d2psi[ib] += (ang * (ctwo * drnloverr + d2phi[nl]) + ctwo * (gr_x * ang_x + gr_y * ang_y + gr_z * ang_z) +
+                      vr * ylm_l[lm * ldy]) *
+            Phase;
       }
     }
   }
@@ -252,8 +372,6 @@ public:
   template<typename LAT, typename T, typename PosType, typename VGH>
   inline void evaluateVGH(const LAT& lattice, const T r, const PosType& dr, const size_t offset, VGH& vgh, PosType Tv)
   {
-    int TransX, TransY, TransZ;
-
     PosType dr_new;
     T r_new;
 
@@ -263,15 +381,7 @@ public:
     constexpr T cone(1.);
     constexpr T ctwo(2.);
 
-#if not defined(QMC_COMPLEX)
-    const ValueType correctphase = 1;
-#else
-
-    RealType phasearg = SuperTwist[0] * Tv[0] + SuperTwist[1] * Tv[1] + SuperTwist[2] * Tv[2];
-    RealType s, c;
-    qmcplusplus::sincos(-phasearg, &s, &c);
-    const ValueType correctphase(c, s);
-#endif
+    const ValueType correctphase = correctionPhase(lattice, Tv);
 
     //one can assert the alignment
     RealType* restrict phi   = tempS.data(0);
@@ -316,91 +426,76 @@ public:
       //      d2psi[ib]  = 0;
     }
 
-    //Phase_idx (iter) needs to be initialized at -1 as it has to be incremented first to comply with the if statement (r_new >=Rmax)
-    int iter = -1;
-    for (int i = 0; i <= PBCImages[0]; i++) //loop Translation over X
+    //loop over the periodic images which were not screened out by setPBCParams
+    for (int i_img = 0; i_img < screened_images_.size(); i_img++)
     {
-      //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-      TransX = ((i % 2) * 2 - 1) * ((i + 1) / 2);
-      for (int j = 0; j <= PBCImages[1]; j++) //loop Translation over Y
-      {
-        //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-        TransY = ((j % 2) * 2 - 1) * ((j + 1) / 2);
-        for (int k = 0; k <= PBCImages[2]; k++) //loop Translation over Z
-        {
-          //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-          TransZ    = ((k % 2) * 2 - 1) * ((k + 1) / 2);
-          dr_new[0] = dr[0] + TransX * lattice.R(0, 0) + TransY * lattice.R(1, 0) + TransZ * lattice.R(2, 0);
-          dr_new[1] = dr[1] + TransX * lattice.R(0, 1) + TransY * lattice.R(1, 1) + TransZ * lattice.R(2, 1);
-          dr_new[2] = dr[2] + TransX * lattice.R(0, 2) + TransY * lattice.R(1, 2) + TransZ * lattice.R(2, 2);
-          r_new     = std::sqrt(dot(dr_new, dr_new));
-
-          //const size_t ib_max=NL.size();
-          iter++;
-          if (r_new >= Rmax)
-            continue;
+      const int iter = screened_images_[i_img];
+      dr_new[0]      = dr[0] + periodic_image_displacements_(iter, 0);
+      dr_new[1]      = dr[1] + periodic_image_displacements_(iter, 1);
+      dr_new[2]      = dr[2] + periodic_image_displacements_(iter, 2);
+      r_new          = std::sqrt(dot(dr_new, dr_new));
+      if (r_new >= Rmax)
+        continue;
 
-          //SIGN Change!!
-          const T x = -dr_new[0], y = -dr_new[1], z = -dr_new[2];
-          Ylm.evaluateVGH(x, y, z);
+      //SIGN Change!!
+      const T x = -dr_new[0], y = -dr_new[1], z = -dr_new[2];
+      Ylm.evaluateVGH(x, y, z);
 
-          MultiRnl.evaluate(r_new, phi, dphi, d2phi);
+      MultiRnl.evaluate(r_new, phi, dphi, d2phi);
 
-          const T rinv = cone / r_new;
+      const T rinv = cone / r_new;
 
-          ///Phase for PBC containing the phase for the nearest image displacement and the correction due to the Distance table.
-          const ValueType Phase = periodic_image_phase_factors_[iter] * correctphase;
+      ///Phase for PBC containing the phase for the nearest image displacement and the correction due to the Distance table.
+      const ValueType Phase = periodic_image_phase_factors_[iter] * correctphase;
 
-          for (size_t ib = 0; ib < BasisSetSize; ++ib)
-          {
-            const int nl(NL[ib]);
-            const int lm(LM[ib]);
-            const T drnloverr = rinv * dphi[nl];
-            const T ang       = ylm_v[lm];
-            const T gr_x      = drnloverr * x;
-            const T gr_y      = drnloverr * y;
-            const T gr_z      = drnloverr * z;
-
-            //The non-strictly diagonal term in \partial_i \partial_j R_{nl} is
-            // \frac{x_i x_j}{r^2}\left(\frac{\partial^2 R_{nl}}{\partial r^2} - \frac{1}{r}\frac{\partial R_{nl}}{\partial r})
-            // To save recomputation, I evaluate everything except the x_i*x_j term once, and store it in
-            // gr2_tmp.  The full term is obtained by x_i*x_j*gr2_tmp.
-            const T gr2_tmp = rinv * rinv * (d2phi[nl] - drnloverr);
-            const T gr_xx   = x * x * gr2_tmp + drnloverr;
-            const T gr_xy   = x * y * gr2_tmp;
-            const T gr_xz   = x * z * gr2_tmp;
-            const T gr_yy   = y * y * gr2_tmp + drnloverr;
-            const T gr_yz   = y * z * gr2_tmp;
-            const T gr_zz   = z * z * gr2_tmp + drnloverr;
-
-            const T ang_x  = ylm_x[lm];
-            const T ang_y  = ylm_y[lm];
-            const T ang_z  = ylm_z[lm];
-            const T ang_xx = ylm_xx[lm];
-            const T ang_xy = ylm_xy[lm];
-            const T ang_xz = ylm_xz[lm];
-            const T ang_yy = ylm_yy[lm];
-            const T ang_yz = ylm_yz[lm];
-            const T ang_zz = ylm_zz[lm];
-
-            const T vr = phi[nl];
-
-            psi[ib] += ang * vr * Phase;
-            dpsi_x[ib] += (ang * gr_x + vr * ang_x) * Phase;
-            dpsi_y[ib] += (ang * gr_y + vr * ang_y) * Phase;
-            dpsi_z[ib] += (ang * gr_z + vr * ang_z) * Phase;
-
-
-            // \partial_i \partial_j (R*Y) = Y \partial_i \partial_j R + R \partial_i \partial_j Y
-            //                             + (\partial_i R) (\partial_j Y) + (\partial_j R)(\partial_i Y)
-            dhpsi_xx[ib] += (gr_xx * ang + ang_xx * vr + ctwo * gr_x * ang_x) * Phase;
-            dhpsi_xy[ib] += (gr_xy * ang + ang_xy * vr + gr_x * ang_y + gr_y * ang_x) * Phase;
-            dhpsi_xz[ib] += (gr_xz * ang + ang_xz * vr + gr_x * ang_z + gr_z * ang_x) * Phase;
-            dhpsi_yy[ib] += (gr_yy * ang + ang_yy * vr + ctwo * gr_y * ang_y) * Phase;
-            dhpsi_yz[ib] += (gr_yz * ang + ang_yz * vr + gr_y * ang_z + gr_z * ang_y) * Phase;
-            dhpsi_zz[ib] += (gr_zz * ang + ang_zz * vr + ctwo * gr_z * ang_z) * Phase;
-          }
-        }
+      for (size_t ib = 0; ib < BasisSetSize; ++ib)
+      {
+        const int nl(NL[ib]);
+        const int lm(LM[ib]);
+        const T drnloverr = rinv * dphi[nl];
+        const T ang       = ylm_v[lm];
+        const T gr_x      = drnloverr * x;
+        const T gr_y      = drnloverr * y;
+        const T gr_z      = drnloverr * z;
+
+        //The non-strictly diagonal term in \partial_i \partial_j R_{nl} is
+        // \frac{x_i x_j}{r^2}\left(\frac{\partial^2 R_{nl}}{\partial r^2} - \frac{1}{r}\frac{\partial R_{nl}}{\partial r})
+        // To save recomputation, I evaluate everything except the x_i*x_j term once, and store it in
+        // gr2_tmp.  The full term is obtained by x_i*x_j*gr2_tmp.
+        const T gr2_tmp = rinv * rinv * (d2phi[nl] - drnloverr);
+        const T gr_xx   = x * x * gr2_tmp + drnloverr;
+        const T gr_xy   = x * y * gr2_tmp;
+        const T gr_xz   = x * z * gr2_tmp;
+        const T gr_yy   = y * y * gr2_tmp + drnloverr;
+        const T gr_yz   = y * z * gr2_tmp;
+        const T gr_zz   = z * z * gr2_tmp + drnloverr;
+
+        const T ang_x  = ylm_x[lm];
+        const T ang_y  = ylm_y[lm];
+        const T ang_z  = ylm_z[lm];
+        const T ang_xx = ylm_xx[lm];
+        const T ang_xy = ylm_xy[lm];
+        const T ang_xz = ylm_xz[lm];
+        const T ang_yy = ylm_yy[lm];
+        const T ang_yz = ylm_yz[lm];
+        const T ang_zz = ylm_zz[lm];
+
+        const T vr = phi[nl];
+
+        psi[ib] += ang * vr * Phase;
+        dpsi_x[ib] += (ang * gr_x + vr * ang_x) * Phase;
+        dpsi_y[ib] += (ang * gr_y + vr * ang_y) * Phase;
+        dpsi_z[ib] += (ang * gr_z + vr * ang_z) * Phase;
+
+
+        // \partial_i \partial_j (R*Y) = Y \partial_i \partial_j R + R \partial_i \partial_j Y
+        //                             + (\partial_i R) (\partial_j Y) + (\partial_j R)(\partial_i Y)
+        dhpsi_xx[ib] += (gr_xx * ang + ang_xx * vr + ctwo * gr_x * ang_x) * Phase;
+        dhpsi_xy[ib] += (gr_xy * ang + ang_xy * vr + gr_x * ang_y + gr_y * ang_x) * Phase;
+        dhpsi_xz[ib] += (gr_xz * ang + ang_xz * vr + gr_x * ang_z + gr_z * ang_x) * Phase;
+        dhpsi_yy[ib] += (gr_yy * ang + ang_yy * vr + ctwo * gr_y * ang_y) * Phase;
+        dhpsi_yz[ib] += (gr_yz * ang + ang_yz * vr + gr_y * ang_z + gr_z * ang_y) * Phase;
+        dhpsi_zz[ib] += (gr_zz * ang + ang_zz * vr + ctwo * gr_z * ang_z) * Phase;
       }
     }
   }
@@ -413,8 +508,6 @@ public:
                             VGHGH& vghgh,
                             PosType Tv)
   {
-    int TransX, TransY, TransZ;
-
     PosType dr_new;
     T r_new;
 
@@ -425,15 +518,7 @@ public:
     constexpr T ctwo(2.0);
     constexpr T cthree(3.0);
 
-#if not defined(QMC_COMPLEX)
-    const ValueType correctphase = 1.0;
-#else
-
-    RealType phasearg = SuperTwist[0] * Tv[0] + SuperTwist[1] * Tv[1] + SuperTwist[2] * Tv[2];
-    RealType s, c;
-    qmcplusplus::sincos(-phasearg, &s, &c);
-    const ValueType correctphase(c, s);
-#endif
+    const ValueType correctphase = correctionPhase(lattice, Tv);
 
     //one can assert the alignment
     RealType* restrict phi   = tempS.data(0);
@@ -512,146 +597,131 @@ public:
       dghpsi_zzz[ib] = 0;
     }
 
-    //Phase_idx (iter) needs to be initialized at -1 as it has to be incremented first to comply with the if statement (r_new >=Rmax)
-    int iter = -1;
-    for (int i = 0; i <= PBCImages[0]; i++) //loop Translation over X
+    //loop over the periodic images which were not screened out by setPBCParams
+    for (int i_img = 0; i_img < screened_images_.size(); i_img++)
     {
-      //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-      TransX = ((i % 2) * 2 - 1) * ((i + 1) / 2);
-      for (int j = 0; j <= PBCImages[1]; j++) //loop Translation over Y
-      {
-        //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-        TransY = ((j % 2) * 2 - 1) * ((j + 1) / 2);
-        for (int k = 0; k <= PBCImages[2]; k++) //loop Translation over Z
-        {
-          //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-          TransZ    = ((k % 2) * 2 - 1) * ((k + 1) / 2);
-          dr_new[0] = dr[0] + TransX * lattice.R(0, 0) + TransY * lattice.R(1, 0) + TransZ * lattice.R(2, 0);
-          dr_new[1] = dr[1] + TransX * lattice.R(0, 1) + TransY * lattice.R(1, 1) + TransZ * lattice.R(2, 1);
-          dr_new[2] = dr[2] + TransX * lattice.R(0, 2) + TransY * lattice.R(1, 2) + TransZ * lattice.R(2, 2);
-          r_new     = std::sqrt(dot(dr_new, dr_new));
-
-          //const size_t ib_max=NL.size();
-          iter++;
-          if (r_new >= Rmax)
-            continue;
+      const int iter = screened_images_[i_img];
+      dr_new[0]      = dr[0] + periodic_image_displacements_(iter, 0);
+      dr_new[1]      = dr[1] + periodic_image_displacements_(iter, 1);
+      dr_new[2]      = dr[2] + periodic_image_displacements_(iter, 2);
+      r_new          = std::sqrt(dot(dr_new, dr_new));
+      if (r_new >= Rmax)
+        continue;
 
-          //SIGN Change!!
-          const T x = -dr_new[0], y = -dr_new[1], z = -dr_new[2];
-          Ylm.evaluateVGHGH(x, y, z);
+      //SIGN Change!!
+      const T x = -dr_new[0], y = -dr_new[1], z = -dr_new[2];
+      Ylm.evaluateVGHGH(x, y, z);
 
-          MultiRnl.evaluate(r_new, phi, dphi, d2phi, d3phi);
+      MultiRnl.evaluate(r_new, phi, dphi, d2phi, d3phi);
 
-          const T rinv = cone / r_new;
-          const T xu = x * rinv, yu = y * rinv, zu = z * rinv;
+      const T rinv = cone / r_new;
+      const T xu = x * rinv, yu = y * rinv, zu = z * rinv;
 
-          ///Phase for PBC containing the phase for the nearest image displacement and the correction due to the Distance table.
-          const ValueType Phase = periodic_image_phase_factors_[iter] * correctphase;
+      ///Phase for PBC containing the phase for the nearest image displacement and the correction due to the Distance table.
+      const ValueType Phase = periodic_image_phase_factors_[iter] * correctphase;
 
-          for (size_t ib = 0; ib < BasisSetSize; ++ib)
-          {
-            const int nl(NL[ib]);
-            const int lm(LM[ib]);
-            const T drnloverr = rinv * dphi[nl];
-            const T ang       = ylm_v[lm];
-            const T gr_x      = drnloverr * x;
-            const T gr_y      = drnloverr * y;
-            const T gr_z      = drnloverr * z;
-
-            //The non-strictly diagonal term in \partial_i \partial_j R_{nl} is
-            // \frac{x_i x_j}{r^2}\left(\frac{\partial^2 R_{nl}}{\partial r^2} - \frac{1}{r}\frac{\partial R_{nl}}{\partial r})
-            // To save recomputation, I evaluate everything except the x_i*x_j term once, and store it in
-            // gr2_tmp.  The full term is obtained by x_i*x_j*gr2_tmp.  This is p(r) in the notes.
-            const T gr2_tmp = rinv * (d2phi[nl] - drnloverr);
-
-            const T gr_xx = x * xu * gr2_tmp + drnloverr;
-            const T gr_xy = x * yu * gr2_tmp;
-            const T gr_xz = x * zu * gr2_tmp;
-            const T gr_yy = y * yu * gr2_tmp + drnloverr;
-            const T gr_yz = y * zu * gr2_tmp;
-            const T gr_zz = z * zu * gr2_tmp + drnloverr;
-
-            //This is q(r) in the notes.
-            const T gr3_tmp = d3phi[nl] - cthree * gr2_tmp;
-
-            const T gr_xxx = xu * xu * xu * gr3_tmp + gr2_tmp * (3. * xu);
-            const T gr_xxy = xu * xu * yu * gr3_tmp + gr2_tmp * yu;
-            const T gr_xxz = xu * xu * zu * gr3_tmp + gr2_tmp * zu;
-            const T gr_xyy = xu * yu * yu * gr3_tmp + gr2_tmp * xu;
-            const T gr_xyz = xu * yu * zu * gr3_tmp;
-            const T gr_xzz = xu * zu * zu * gr3_tmp + gr2_tmp * xu;
-            const T gr_yyy = yu * yu * yu * gr3_tmp + gr2_tmp * (3. * yu);
-            const T gr_yyz = yu * yu * zu * gr3_tmp + gr2_tmp * zu;
-            const T gr_yzz = yu * zu * zu * gr3_tmp + gr2_tmp * yu;
-            const T gr_zzz = zu * zu * zu * gr3_tmp + gr2_tmp * (3. * zu);
-
-
-            //Angular derivatives up to third
-            const T ang_x = ylm_x[lm];
-            const T ang_y = ylm_y[lm];
-            const T ang_z = ylm_z[lm];
-
-            const T ang_xx = ylm_xx[lm];
-            const T ang_xy = ylm_xy[lm];
-            const T ang_xz = ylm_xz[lm];
-            const T ang_yy = ylm_yy[lm];
-            const T ang_yz = ylm_yz[lm];
-            const T ang_zz = ylm_zz[lm];
-
-            const T ang_xxx = ylm_xxx[lm];
-            const T ang_xxy = ylm_xxy[lm];
-            const T ang_xxz = ylm_xxz[lm];
-            const T ang_xyy = ylm_xyy[lm];
-            const T ang_xyz = ylm_xyz[lm];
-            const T ang_xzz = ylm_xzz[lm];
-            const T ang_yyy = ylm_yyy[lm];
-            const T ang_yyz = ylm_yyz[lm];
-            const T ang_yzz = ylm_yzz[lm];
-            const T ang_zzz = ylm_zzz[lm];
-
-            const T vr = phi[nl];
-
-            psi[ib] += ang * vr * Phase;
-            dpsi_x[ib] += (ang * gr_x + vr * ang_x) * Phase;
-            dpsi_y[ib] += (ang * gr_y + vr * ang_y) * Phase;
-            dpsi_z[ib] += (ang * gr_z + vr * ang_z) * Phase;
-
-
-            // \partial_i \partial_j (R*Y) = Y \partial_i \partial_j R + R \partial_i \partial_j Y
-            //                             + (\partial_i R) (\partial_j Y) + (\partial_j R)(\partial_i Y)
-            dhpsi_xx[ib] += (gr_xx * ang + ang_xx * vr + ctwo * gr_x * ang_x) * Phase;
-            dhpsi_xy[ib] += (gr_xy * ang + ang_xy * vr + gr_x * ang_y + gr_y * ang_x) * Phase;
-            dhpsi_xz[ib] += (gr_xz * ang + ang_xz * vr + gr_x * ang_z + gr_z * ang_x) * Phase;
-            dhpsi_yy[ib] += (gr_yy * ang + ang_yy * vr + ctwo * gr_y * ang_y) * Phase;
-            dhpsi_yz[ib] += (gr_yz * ang + ang_yz * vr + gr_y * ang_z + gr_z * ang_y) * Phase;
-            dhpsi_zz[ib] += (gr_zz * ang + ang_zz * vr + ctwo * gr_z * ang_z) * Phase;
-
-            dghpsi_xxx[ib] += (gr_xxx * ang + vr * ang_xxx + cthree * gr_xx * ang_x + cthree * gr_x * ang_xx) * Phase;
-            dghpsi_xxy[ib] += (gr_xxy * ang + vr * ang_xxy + gr_xx * ang_y + ang_xx * gr_y + ctwo * gr_xy * ang_x +
-                               ctwo * ang_xy * gr_x) *
-                Phase;
-            dghpsi_xxz[ib] += (gr_xxz * ang + vr * ang_xxz + gr_xx * ang_z + ang_xx * gr_z + ctwo * gr_xz * ang_x +
-                               ctwo * ang_xz * gr_x) *
-                Phase;
-            dghpsi_xyy[ib] += (gr_xyy * ang + vr * ang_xyy + gr_yy * ang_x + ang_yy * gr_x + ctwo * gr_xy * ang_y +
-                               ctwo * ang_xy * gr_y) *
-                Phase;
-            dghpsi_xyz[ib] += (gr_xyz * ang + vr * ang_xyz + gr_xy * ang_z + ang_xy * gr_z + gr_yz * ang_x +
-                               ang_yz * gr_x + gr_xz * ang_y + ang_xz * gr_y) *
-                Phase;
-            dghpsi_xzz[ib] += (gr_xzz * ang + vr * ang_xzz + gr_zz * ang_x + ang_zz * gr_x + ctwo * gr_xz * ang_z +
-                               ctwo * ang_xz * gr_z) *
-                Phase;
-            dghpsi_yyy[ib] += (gr_yyy * ang + vr * ang_yyy + cthree * gr_yy * ang_y + cthree * gr_y * ang_yy) * Phase;
-            dghpsi_yyz[ib] += (gr_yyz * ang + vr * ang_yyz + gr_yy * ang_z + ang_yy * gr_z + ctwo * gr_yz * ang_y +
-                               ctwo * ang_yz * gr_y) *
-                Phase;
-            dghpsi_yzz[ib] += (gr_yzz * ang + vr * ang_yzz + gr_zz * ang_y + ang_zz * gr_y + ctwo * gr_yz * ang_z +
-                               ctwo * ang_yz * gr_z) *
-                Phase;
-            dghpsi_zzz[ib] += (gr_zzz * ang + vr * ang_zzz + cthree * gr_zz * ang_z + cthree * gr_z * ang_zz) * Phase;
-          }
-        }
+      for (size_t ib = 0; ib < BasisSetSize; ++ib)
+      {
+        const int nl(NL[ib]);
+        const int lm(LM[ib]);
+        const T drnloverr = rinv * dphi[nl];
+        const T ang       = ylm_v[lm];
+        const T gr_x      = drnloverr * x;
+        const T gr_y      = drnloverr * y;
+        const T gr_z      = drnloverr * z;
+
+        //The non-strictly diagonal term in \partial_i \partial_j R_{nl} is
+        // \frac{x_i x_j}{r^2}\left(\frac{\partial^2 R_{nl}}{\partial r^2} - \frac{1}{r}\frac{\partial R_{nl}}{\partial r})
+        // To save recomputation, I evaluate everything except the x_i*x_j term once, and store it in
+        // gr2_tmp.  The full term is obtained by x_i*x_j*gr2_tmp.  This is p(r) in the notes.
+        const T gr2_tmp = rinv * (d2phi[nl] - drnloverr);
+
+        const T gr_xx = x * xu * gr2_tmp + drnloverr;
+        const T gr_xy = x * yu * gr2_tmp;
+        const T gr_xz = x * zu * gr2_tmp;
+        const T gr_yy = y * yu * gr2_tmp + drnloverr;
+        const T gr_yz = y * zu * gr2_tmp;
+        const T gr_zz = z * zu * gr2_tmp + drnloverr;
+
+        //This is q(r) in the notes.
+        const T gr3_tmp = d3phi[nl] - cthree * gr2_tmp;
+
+        const T gr_xxx = xu * xu * xu * gr3_tmp + gr2_tmp * (3. * xu);
+        const T gr_xxy = xu * xu * yu * gr3_tmp + gr2_tmp * yu;
+        const T gr_xxz = xu * xu * zu * gr3_tmp + gr2_tmp * zu;
+        const T gr_xyy = xu * yu * yu * gr3_tmp + gr2_tmp * xu;
+        const T gr_xyz = xu * yu * zu * gr3_tmp;
+        const T gr_xzz = xu * zu * zu * gr3_tmp + gr2_tmp * xu;
+        const T gr_yyy = yu * yu * yu * gr3_tmp + gr2_tmp * (3. * yu);
+        const T gr_yyz = yu * yu * zu * gr3_tmp + gr2_tmp * zu;
+        const T gr_yzz = yu * zu * zu * gr3_tmp + gr2_tmp * yu;
+        const T gr_zzz = zu * zu * zu * gr3_tmp + gr2_tmp * (3. * zu);
+
+
+        //Angular derivatives up to third
+        const T ang_x = ylm_x[lm];
+        const T ang_y = ylm_y[lm];
+        const T ang_z = ylm_z[lm];
+
+        const T ang_xx = ylm_xx[lm];
+        const T ang_xy = ylm_xy[lm];
+        const T ang_xz = ylm_xz[lm];
+        const T ang_yy = ylm_yy[lm];
+        const T ang_yz = ylm_yz[lm];
+        const T ang_zz = ylm_zz[lm];
+
+        const T ang_xxx = ylm_xxx[lm];
+        const T ang_xxy = ylm_xxy[lm];
+        const T ang_xxz = ylm_xxz[lm];
+        const T ang_xyy = ylm_xyy[lm];
+        const T ang_xyz = ylm_xyz[lm];
+        const T ang_xzz = ylm_xzz[lm];
+        const T ang_yyy = ylm_yyy[lm];
+        const T ang_yyz = ylm_yyz[lm];
+        const T ang_yzz = ylm_yzz[lm];
+        const T ang_zzz = ylm_zzz[lm];
+
+        const T vr = phi[nl];
+
+        psi[ib] += ang * vr * Phase;
+        dpsi_x[ib] += (ang * gr_x + vr * ang_x) * Phase;
+        dpsi_y[ib] += (ang * gr_y + vr * ang_y) * Phase;
+        dpsi_z[ib] += (ang * gr_z + vr * ang_z) * Phase;
+
+
+        // \partial_i \partial_j (R*Y) = Y \partial_i \partial_j R + R \partial_i \partial_j Y
+        //                             + (\partial_i R) (\partial_j Y) + (\partial_j R)(\partial_i Y)
+        dhpsi_xx[ib] += (gr_xx * ang + ang_xx * vr + ctwo * gr_x * ang_x) * Phase;
+        dhpsi_xy[ib] += (gr_xy * ang + ang_xy * vr + gr_x * ang_y + gr_y * ang_x) * Phase;
+        dhpsi_xz[ib] += (gr_xz * ang + ang_xz * vr + gr_x * ang_z + gr_z * ang_x) * Phase;
+        dhpsi_yy[ib] += (gr_yy * ang + ang_yy * vr + ctwo * gr_y * ang_y) * Phase;
+        dhpsi_yz[ib] += (gr_yz * ang + ang_yz * vr + gr_y * ang_z + gr_z * ang_y) * Phase;
+        dhpsi_zz[ib] += (gr_zz * ang + ang_zz * vr + ctwo * gr_z * ang_z) * Phase;
+
+        dghpsi_xxx[ib] += (gr_xxx * ang + vr * ang_xxx + cthree * gr_xx * ang_x + cthree * gr_x * ang_xx) * Phase;
+        dghpsi_xxy[ib] += (gr_xxy * ang + vr * ang_xxy + gr_xx * ang_y + ang_xx * gr_y + ctwo * gr_xy * ang_x +
+                           ctwo * ang_xy * gr_x) *
+            Phase;
+        dghpsi_xxz[ib] += (gr_xxz * ang + vr * ang_xxz + gr_xx * ang_z + ang_xx * gr_z + ctwo * gr_xz * ang_x +
+                           ctwo * ang_xz * gr_x) *
+            Phase;
+        dghpsi_xyy[ib] += (gr_xyy * ang + vr * ang_xyy + gr_yy * ang_x + ang_yy * gr_x + ctwo * gr_xy * ang_y +
+                           ctwo * ang_xy * gr_y) *
+            Phase;
+        dghpsi_xyz[ib] += (gr_xyz * ang + vr * ang_xyz + gr_xy * ang_z + ang_xy * gr_z + gr_yz * ang_x +
+                           ang_yz * gr_x + gr_xz * ang_y + ang_xz * gr_y) *
+            Phase;
+        dghpsi_xzz[ib] += (gr_xzz * ang + vr * ang_xzz + gr_zz * ang_x + ang_zz * gr_x + ctwo * gr_xz * ang_z +
+                           ctwo * ang_xz * gr_z) *
+            Phase;
+        dghpsi_yyy[ib] += (gr_yyy * ang + vr * ang_yyy + cthree * gr_yy * ang_y + cthree * gr_y * ang_yy) * Phase;
+        dghpsi_yyz[ib] += (gr_yyz * ang + vr * ang_yyz + gr_yy * ang_z + ang_yy * gr_z + ctwo * gr_yz * ang_y +
+                           ctwo * ang_yz * gr_y) *
+            Phase;
+        dghpsi_yzz[ib] += (gr_yzz * ang + vr * ang_yzz + gr_zz * ang_y + ang_zz * gr_y + ctwo * gr_yz * ang_z +
+                           ctwo * ang_yz * gr_z) *
+            Phase;
+        dghpsi_zzz[ib] += (gr_zzz * ang + vr * ang_zzz + cthree * gr_zz * ang_z + cthree * gr_z * ang_zz) * Phase;
       }
     }
   }
@@ -661,59 +731,37 @@ public:
   template<typename LAT, typename T, typename PosType, typename VT>
   inline void evaluateV(const LAT& lattice, const T r, const PosType& dr, VT* restrict psi, PosType Tv)
   {
-    int TransX, TransY, TransZ;
-
-    PosType dr_new;
-    T r_new;
+    const ValueType correctphase = correctionPhase(lattice, Tv);
 
-#if not defined(QMC_COMPLEX)
-    const ValueType correctphase = 1.0;
-#else
-
-    RealType phasearg = SuperTwist[0] * Tv[0] + SuperTwist[1] * Tv[1] + SuperTwist[2] * Tv[2];
-    RealType s, c;
-    qmcplusplus::sincos(-phasearg, &s, &c);
-    const ValueType correctphase(c, s);
-
-#endif
-
-    RealType* restrict ylm_v = tempS.data(0);
     RealType* restrict phi_r = tempS.data(1);
 
     for (size_t ib = 0; ib < BasisSetSize; ++ib)
       psi[ib] = 0;
-    //Phase_idx (iter) needs to be initialized at -1 as it has to be incremented first to comply with the if statement (r_new >=Rmax)
-    int iter = -1;
-    for (int i = 0; i <= PBCImages[0]; i++) //loop Translation over X
+
+    //with enough images the Ylm of all the images within Rmax are evaluated together, [Nlm][ldy]
+    const size_t n_img   = gatherImages(dr);
+    const bool block_ylm = n_img >= min_block_images;
+    const size_t ldy     = block_ylm ? image_xyzr_.capacity() : 1;
+    if (block_ylm)
     {
-      //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-      TransX = ((i % 2) * 2 - 1) * ((i + 1) / 2);
-      for (int j = 0; j <= PBCImages[1]; j++) //loop Translation over Y
-      {
-        //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-        TransY = ((j % 2) * 2 - 1) * ((j + 1) / 2);
-        for (int k = 0; k <= PBCImages[2]; k++) //loop Translation over Z
-        {
-          //Allows to increment cells from 0,1,-1,2,-2,3,-3 etc...
-          TransZ = ((k % 2) * 2 - 1) * ((k + 1) / 2);
-
-          dr_new[0] = dr[0] + (TransX * lattice.R(0, 0) + TransY * lattice.R(1, 0) + TransZ * lattice.R(2, 0));
-          dr_new[1] = dr[1] + (TransX * lattice.R(0, 1) + TransY * lattice.R(1, 1) + TransZ * lattice.R(2, 1));
-          dr_new[2] = dr[2] + (TransX * lattice.R(0, 2) + TransY * lattice.R(1, 2) + TransZ * lattice.R(2, 2));
-
-          r_new = std::sqrt(dot(dr_new, dr_new));
-          iter++;
-          if (r_new >= Rmax)
-            continue;
-
-          Ylm.evaluateV(-dr_new[0], -dr_new[1], -dr_new[2], ylm_v);
-          MultiRnl.evaluate(r_new, phi_r);
-          ///Phase for PBC containing the phase for the nearest image displacement and the correction due to the Distance table.
-          const ValueType Phase = periodic_image_phase_factors_[iter] * correctphase;
-          for (size_t ib = 0; ib < BasisSetSize; ++ib)
-            psi[ib] += ylm_v[LM[ib]] * phi_r[NL[ib]] * Phase;
-        }
-      }
+      image_ylm_.resize(Ylm.size() * ldy);
+      Ylm.block_evaluateV(image_xyzr_.data(0), image_xyzr_.data(1), image_xyzr_.data(2), n_img, image_ylm_.data(),
+                          ldy);
+    }
+
+    for (size_t i_img = 0; i_img < n_img; i_img++)
+    {
+      const RealType* restrict ylm_v = tempS.data(0);
+      if (block_ylm)
+        ylm_v = image_ylm_.data() + i_img;
+      else
+        Ylm.evaluateV(image_xyzr_.data(0)[i_img], image_xyzr_.data(1)[i_img], image_xyzr_.data(2)[i_img],
+                      tempS.data(0));
+      MultiRnl.evaluate(image_xyzr_.data(3)[i_img], phi_r);
+      ///Phase for PBC containing the phase for the nearest image displacement and the correction due to the Distance table.
+      const ValueType Phase = periodic_image_phase_factors_[image_ids_[i_img]] * correctphase;
+      for (size_t ib = 0; ib < BasisSetSize; ++ib)
+        psi[ib] += ylm_v[LM[ib] * ldy] * phi_r[NL[ib]] * Phase;
     }
   }
 
@@ -752,10 +800,8 @@ public:
     assert(this == &atom_bs_list.getLeader());
     auto& atom_bs_leader = atom_bs_list.template getCastedLeader<SoaAtomicBasisSet<ROT, SH>>();
 
-    int Nx         = PBCImages[0] + 1;
-    int Ny         = PBCImages[1] + 1;
-    int Nz         = PBCImages[2] + 1;
-    const int Nxyz = Nx * Ny * Nz;
+    // only the images which were not screened out by setPBCParams are evaluated
+    const int Nxyz = screened_images_.size();
 
     assert(psi_vgl.size(0) == 5);
     assert(psi_vgl.size(1) == nElec);
@@ -807,37 +853,35 @@ public:
         correctphase_ptr[i_e] = 1.0;
 
 #else
-      auto* SuperTwist_ptr = SuperTwist.data();
+      auto* SuperTwist_ptr     = SuperTwist.data();
+      auto* lattice_phases_ptr = lattice_phases_.data();
+      auto* latG_ptr           = lattice.G.data();
 
       PRAGMA_OFFLOAD("omp target teams distribute parallel for map(to:SuperTwist_ptr[:SuperTwist.size()], \
-		      Tv_list_ptr[3*nElec*center_idx:3*nElec], correctphase_ptr[:nElec]) ")
+		      lattice_phases_ptr[:3], latG_ptr[:9], Tv_list_ptr[3*nElec*center_idx:3*nElec], correctphase_ptr[:nElec]) ")
       for (size_t i_e = 0; i_e < nElec; i_e++)
-      {
-        //RealType phasearg = dot(3, SuperTwist.data(), 1, Tv_list.data() + 3 * i_e, 1);
-        RealType phasearg = 0;
-        for (size_t i_dim = 0; i_dim < 3; i_dim++)
-          phasearg += SuperTwist[i_dim] * Tv_list_ptr[i_dim + 3 * (i_e + center_idx * nElec)];
-        RealType s, c;
-        qmcplusplus::sincos(-phasearg, &s, &c);
-        correctphase_ptr[i_e] = ValueType(c, s);
-      }
+        correctphase_ptr[i_e] = latticeTranslationPhase(Tv_list_ptr + 3 * (i_e + center_idx * nElec), latG_ptr,
+                                                        lattice_phases_ptr, SuperTwist_ptr);
 #endif
     }
 
     {
       ScopedTimer local_timer(nelec_pbc_timer_);
       auto* periodic_image_displacements_ptr = periodic_image_displacements_.data();
+      auto* screened_images_ptr              = screened_images_.data();
+      const size_t nImages                   = periodic_image_displacements_.size(0);
       PRAGMA_OFFLOAD("omp target teams distribute parallel for collapse(2) \
-                      map(to:periodic_image_displacements_ptr[:3*Nxyz]) \
+                      map(to:periodic_image_displacements_ptr[:3*nImages], screened_images_ptr[:Nxyz]) \
                       map(to: dr_ptr[:3*nElec*Nxyz], r_ptr[:nElec*Nxyz], displ_list_ptr[3*nElec*center_idx:3*nElec]) ")
       for (size_t i_e = 0; i_e < nElec; i_e++)
         for (int i_xyz = 0; i_xyz < Nxyz; i_xyz++)
         {
+          const int i_img = screened_images_ptr[i_xyz];
           RealType tmp_r2 = 0.0;
           for (size_t i_dim = 0; i_dim < 3; i_dim++)
           {
             dr_ptr[i_dim + 3 * (i_xyz + Nxyz * i_e)] = -(displ_list_ptr[i_dim + 3 * (i_e + center_idx * nElec)] +
-                                                         periodic_image_displacements_ptr[i_dim + 3 * i_xyz]);
+                                                         periodic_image_displacements_ptr[i_dim + 3 * i_img]);
             tmp_r2 += dr_ptr[i_dim + 3 * (i_xyz + Nxyz * i_e)] * dr_ptr[i_dim + 3 * (i_xyz + Nxyz * i_e)];
           }
           r_ptr[i_xyz + Nxyz * i_e] = std::sqrt(tmp_r2);
@@ -857,9 +901,11 @@ public:
 
     {
       ScopedTimer local_timer(psi_timer_);
-      auto* phase_fac_ptr = periodic_image_phase_factors_.data();
-      auto* LM_ptr        = LM.data();
-      auto* NL_ptr        = NL.data();
+      auto* phase_fac_ptr       = periodic_image_phase_factors_.data();
+      auto* screened_images_ptr = screened_images_.data();
+      const size_t nImages      = periodic_image_phase_factors_.size();
+      auto* LM_ptr              = LM.data();
+      auto* NL_ptr              = NL.data();
       const int bset_size = BasisSetSize;
 
       RealType* restrict phi_ptr   = rnl_vgl.data_at(0, 0, 0, 0);
@@ -873,7 +919,7 @@ public:
       const RealType* restrict ylm_z_ptr = ylm_vgl.data_at(3, 0, 0, 0); //gradZ
       const RealType* restrict ylm_l_ptr = ylm_vgl.data_at(4, 0, 0, 0); //lap
       PRAGMA_OFFLOAD("omp target teams distribute parallel for collapse(2) \
-                      map(to:phase_fac_ptr[:Nxyz], LM_ptr[:BasisSetSize], NL_ptr[:BasisSetSize]) \
+                      map(to:phase_fac_ptr[:nImages], screened_images_ptr[:Nxyz], LM_ptr[:BasisSetSize], NL_ptr[:BasisSetSize]) \
 		      map(to:ylm_v_ptr[:nYlm*nElec*Nxyz], ylm_x_ptr[:nYlm*nElec*Nxyz], ylm_y_ptr[:nYlm*nElec*Nxyz], ylm_z_ptr[:nYlm*nElec*Nxyz], ylm_l_ptr[:nYlm*nElec*Nxyz], \
                       phi_ptr[:nRnl*nElec*Nxyz], dphi_ptr[:nRnl*nElec*Nxyz], d2phi_ptr[:nRnl*nElec*Nxyz], \
                       psi_ptr[:nBasTot*nElec], dpsi_x_ptr[:nBasTot*nElec], dpsi_y_ptr[:nBasTot*nElec], dpsi_z_ptr[:nBasTot*nElec], d2psi_ptr[:nBasTot*nElec], \
@@ -891,7 +937,7 @@ public:
 
           for (int i_xyz = 0; i_xyz < Nxyz; i_xyz++)
           {
-            const ValueType Phase    = phase_fac_ptr[i_xyz] * correctphase_ptr[i_e];
+            const ValueType Phase    = phase_fac_ptr[screened_images_ptr[i_xyz]] * correctphase_ptr[i_e];
             const RealType rinv      = cone / r_ptr[i_xyz + Nxyz * i_e];
             const RealType x         = dr_ptr[0 + 3 * (i_xyz + Nxyz * i_e)];
             const RealType y         = dr_ptr[1 + 3 * (i_xyz + Nxyz * i_e)];
@@ -960,10 +1006,8 @@ public:
     auto& atom_bs_leader = atom_bs_list.template getCastedLeader<SoaAtomicBasisSet<ROT, SH>>();
     //TODO: use QMCTraits::DIM instead of 3?
     //      DIM==3 is baked into so many parts here that it's probably not worth it for now
-    const int Nx   = PBCImages[0] + 1;
-    const int Ny   = PBCImages[1] + 1;
-    const int Nz   = PBCImages[2] + 1;
-    const int Nxyz = Nx * Ny * Nz;
+    // only the images which were not screened out by setPBCParams are evaluated
+    const int Nxyz = screened_images_.size();
     assert(psi.size(0) == nElec);
     assert(psi.size(1) == nBasTot);
 
@@ -1006,37 +1050,35 @@ public:
         correctphase_ptr[i_e] = 1.0;
 
 #else
-      auto* SuperTwist_ptr = SuperTwist.data();
+      auto* SuperTwist_ptr     = SuperTwist.data();
+      auto* lattice_phases_ptr = lattice_phases_.data();
+      auto* latG_ptr           = lattice.G.data();
 
       PRAGMA_OFFLOAD("omp target teams distribute parallel for map(to:SuperTwist_ptr[:SuperTwist.size()], \
-		      Tv_list_ptr[3*nElec*center_idx:3*nElec], correctphase_ptr[:nElec]) ")
+		      lattice_phases_ptr[:3], latG_ptr[:9], Tv_list_ptr[3*nElec*center_idx:3*nElec], correctphase_ptr[:nElec]) ")
       for (size_t i_e = 0; i_e < nElec; i_e++)
-      {
-        //RealType phasearg = dot(3, SuperTwist.data(), 1, Tv_list.data() + 3 * i_e, 1);
-        RealType phasearg = 0;
-        for (size_t i_dim = 0; i_dim < 3; i_dim++)
-          phasearg += SuperTwist[i_dim] * Tv_list_ptr[i_dim + 3 * (i_e + center_idx * nElec)];
-        RealType s, c;
-        qmcplusplus::sincos(-phasearg, &s, &c);
-        correctphase_ptr[i_e] = ValueType(c, s);
-      }
+        correctphase_ptr[i_e] = latticeTranslationPhase(Tv_list_ptr + 3 * (i_e + center_idx * nElec), latG_ptr,
+                                                        lattice_phases_ptr, SuperTwist_ptr);
 #endif
     }
 
     {
       ScopedTimer local_timer(nelec_pbc_timer_);
       auto* periodic_image_displacements_ptr = periodic_image_displacements_.data();
+      auto* screened_images_ptr              = screened_images_.data();
+      const size_t nImages                   = periodic_image_displacements_.size(0);
       PRAGMA_OFFLOAD("omp target teams distribute parallel for collapse(2) \
-                      map(to:periodic_image_displacements_ptr[:3*Nxyz]) \
+                      map(to:periodic_image_displacements_ptr[:3*nImages], screened_images_ptr[:Nxyz]) \
                       map(to: dr_ptr[:3*nElec*Nxyz], r_ptr[:nElec*Nxyz], displ_list_ptr[3*nElec*center_idx:3*nElec]) ")
       for (size_t i_e = 0; i_e < nElec; i_e++)
         for (int i_xyz = 0; i_xyz < Nxyz; i_xyz++)
         {
+          const int i_img = screened_images_ptr[i_xyz];
           RealType tmp_r2 = 0.0;
           for (size_t i_dim = 0; i_dim < 3; i_dim++)
           {
             dr_ptr[i_dim + 3 * (i_xyz + Nxyz * i_e)] = -(displ_list_ptr[i_dim + 3 * (i_e + center_idx * nElec)] +
-                                                         periodic_image_displacements_ptr[i_dim + 3 * i_xyz]);
+                                                         periodic_image_displacements_ptr[i_dim + 3 * i_img]);
             tmp_r2 += dr_ptr[i_dim + 3 * (i_xyz + Nxyz * i_e)] * dr_ptr[i_dim + 3 * (i_xyz + Nxyz * i_e)];
           }
           r_ptr[i_xyz + Nxyz * i_e] = std::sqrt(tmp_r2);
@@ -1057,16 +1099,18 @@ public:
     {
       ScopedTimer local_timer(psi_timer_);
       ///Phase for PBC containing the phase for the nearest image displacement and the correction due to the Distance table.
-      auto* phase_fac_ptr = periodic_image_phase_factors_.data();
-      auto* LM_ptr        = LM.data();
-      auto* NL_ptr        = NL.data();
+      auto* phase_fac_ptr       = periodic_image_phase_factors_.data();
+      auto* screened_images_ptr = screened_images_.data();
+      const size_t nImages      = periodic_image_phase_factors_.size();
+      auto* LM_ptr              = LM.data();
+      auto* NL_ptr              = NL.data();
       auto* psi_ptr       = psi.data();
       const int bset_size = BasisSetSize;
 
       auto* ylm_ptr = ylm_v.data();
       auto* rnl_ptr = rnl_v.data();
       PRAGMA_OFFLOAD("omp target teams distribute parallel for collapse(2) \
-                      map(to:phase_fac_ptr[:Nxyz], LM_ptr[:BasisSetSize], NL_ptr[:BasisSetSize]) \
+                      map(to:phase_fac_ptr[:nImages], screened_images_ptr[:Nxyz], LM_ptr[:BasisSetSize], NL_ptr[:BasisSetSize]) \
 		      map(to:ylm_ptr[:nYlm*nElec*Nxyz], rnl_ptr[:nRnl*nElec*Nxyz], psi_ptr[:nBasTot*nElec], correctphase_ptr[:nElec])")
       for (int i_e = 0; i_e < nElec; i_e++)
         for (int ib = 0; ib < bset_size; ++ib)
@@ -1074,7 +1118,7 @@ public:
           VT psi = 0;
           for (int i_xyz = 0; i_xyz < Nxyz; i_xyz++)
           {
-            const ValueType Phase = phase_fac_ptr[i_xyz] * correctphase_ptr[i_e];
+            const ValueType Phase = phase_fac_ptr[screened_images_ptr[i_xyz]] * correctphase_ptr[i_e];
             psi += ylm_ptr[(i_xyz + Nxyz * i_e) * nYlm + LM_ptr[ib]] *
                 rnl_ptr[(i_xyz + Nxyz * i_e) * nRnl + NL_ptr[ib]] * Phase;
           }
@@ -1104,6 +1148,25 @@ public:
   }
 
 private:
+  /// keeps the periodic images which can be within the support radius of this center for any electron
+  void screenImages()
+  {
+    const RealType rscreen = (Rsupport > 0) ? Rsupport : Rmax;
+    const int Nxyz         = periodic_image_displacements_.size(0);
+    std::vector<int> screened;
+    for (int i_xyz = 0; i_xyz < Nxyz; i_xyz++)
+    {
+      RealType image_r2 = 0.0;
+      for (size_t i_dim = 0; i_dim < 3; i_dim++)
+        image_r2 += periodic_image_displacements_(i_xyz, i_dim) * periodic_image_displacements_(i_xyz, i_dim);
+      if (i_xyz == 0 || cell_radius_ < 0 || std::sqrt(image_r2) < rscreen + cell_radius_)
+        screened.push_back(i_xyz);
+    }
+    screened_images_.resize(screened.size());
+    std::copy(screened.begin(), screened.end(), screened_images_.begin());
+    screened_images_.updateTo();
+  }
+
   /// multi walker shared memory buffer
   struct SoaAtomicBSetMultiWalkerMem : public Resource
   {
@@ -1135,6 +1198,10 @@ private:
   TinyVector<double, 3> SuperTwist;
   ///maximum radius of this center
   RealType Rmax;
+  ///radius beyond which all the radial orbitals are negligible
+  RealType Rsupport;
+  ///bound of the length of the displacements from the distance table, negative if they are not reduced to a cell
+  RealType cell_radius_;
   ///spherical harmonics
   SH Ylm;
   ///radial orbitals
@@ -1143,6 +1210,18 @@ private:
   std::vector<QuantumNumberType> RnlID;
   ///temporary storage
   VectorSoaContainer<RealType, 4> tempS;
+  ///x, y, z and r of the periodic images within Rmax
+  VectorSoaContainer<RealType, 4> image_xyzr_;
+  ///indices of the periodic images within Rmax
+  std::vector<int> image_ids_;
+  ///Ylm of the periodic images within Rmax, [Nlm][image] for each component
+  aligned_vector<RealType> image_ylm_;
+  /** fewest images within Rmax evaluated by the block Ylm
+   *
+   * The block evaluation of SoaSphericalTensor only pays off from about 4 points, below that
+   * and in particular for the single image of open boundary conditions, the Ylm are evaluated point by point.
+   */
+  static constexpr size_t min_block_images = 4;
   ///Phase Factor array of images
   std::shared_ptr<OffloadVector> periodic_image_phase_factors_ptr_;
   ///Displacements of images
@@ -1151,6 +1230,12 @@ private:
   OffloadVector& periodic_image_phase_factors_;
   ///reference to the displacements of images
   OffloadArray2D& periodic_image_displacements_;
+  ///indices of the images which can be within the support radius of this center
+  std::shared_ptr<OffloadIntVector> screened_images_ptr_;
+  ///reference to the indices of the screened images
+  OffloadIntVector& screened_images_;
+  ///phase factor exp(-i k.a) of each lattice vector a
+  TinyVector<ValueType, 3> lattice_phases_;
   /**index of the corresponding radial orbital with quantum numbers \f$ (n,l) \f$ */
   const std::shared_ptr<OffloadIntVector> NL_ptr_;
   ///index of the corresponding real Spherical Harmonic with quantum numbers \f$ (l,m) \f$
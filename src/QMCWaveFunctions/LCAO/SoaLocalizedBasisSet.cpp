@@ -127,7 +127,7 @@ void SoaLocalizedBasisSet<COT, ORBT>::setPBCParams(
     const Array<RealType, 2, OffloadPinnedAllocator<RealType>>& pbc_displacements)
 {
   for (int i = 0; i < LOBasisSet.size(); ++i)
-    LOBasisSet[i]->setPBCParams(PBCImages, Sup_Twist, phase_factor, pbc_displacements);
+    LOBasisSet[i]->setPBCParams(ions_.getLattice(), PBCImages, Sup_Twist, phase_factor, pbc_displacements);
 
   SuperTwist = Sup_Twist;
 }
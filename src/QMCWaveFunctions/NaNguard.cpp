@@ -15,23 +15,28 @@
 namespace qmcplusplus
 {
 
-void NaNguard::checkOneParticleRatio(const PsiValue& ratio, const std::string_view info)
+void NaNguard::checkOneParticleRatio(const PsiValue& ratio, const std::string_view info, const int iat)
 {
   if (qmcplusplus::isnan(std::norm(ratio)))
   {
     std::ostringstream error_message;
-    error_message << "NaNguard::checkOneParticleRatio error message: " << info << std::endl
-                  << "  ratio = " << ratio << std::endl;
+    error_message << "NaNguard::checkOneParticleRatio error message: " << info;
+    if (iat >= 0)
+      error_message << " at particle " << iat;
+    error_message << std::endl << "  ratio = " << ratio << std::endl;
     throw std::runtime_error(error_message.str());
   }
 }
 
-void NaNguard::checkOneParticleGradients(const GradType& grads, const std::string_view info)
+void NaNguard::checkOneParticleGradients(const GradType& grads, const std::string_view info, const int iat)
 {
   if (qmcplusplus::isnan(std::norm(dot(grads, grads))))
   {
     std::ostringstream error_message;
-    error_message << "NaNguard::checkOneParticleGradients error message: " << info << std::endl;
+    error_message << "NaNguard::checkOneParticleGradients error message: " << info;
+    if (iat >= 0)
+      error_message << " at particle " << iat;
+    error_message << std::endl;
     for (int i = 0; i < grads.size(); ++i)
       if (qmcplusplus::isnan(std::norm(grads[i])))
         error_message << "  grads[" << i << "] = " << grads[i] << std::endl;
@@ -27,14 +27,17 @@ public:
   /** check if ratio is NaN and throw an error if yes.
    * @param ratio psi ratio to be checked
    * @param message printout to indicate what the issue is.
+   * @param iat particle index reported with the message if not negative.
+   *            The message is only composed on error to keep the check free of allocation.
    */
-  static void checkOneParticleRatio(const PsiValue& ratio, const std::string_view info);
+  static void checkOneParticleRatio(const PsiValue& ratio, const std::string_view info, const int iat = -1);
 
   /** check if any gradient component (x,y,z) is NaN and throw an error if yes.
    * @param grads gradients to be checked
    * @param message printout to indicate what the issue is.
+   * @param iat particle index reported with the message if not negative.
    */
-  static void checkOneParticleGradients(const GradType& grads, const std::string_view info);
+  static void checkOneParticleGradients(const GradType& grads, const std::string_view info, const int iat = -1);
 };
 } // namespace qmcplusplus
 #endif
@@ -398,6 +398,19 @@ void SPOSet::evaluateGradSource(const ParticleSet& P,
                            "must be overloaded when the SPOSet has ion derivatives.");
 }
 
+void SPOSet::mw_evaluateGradSource(const RefVectorWithLeader<SPOSet>& spo_list,
+                                   const RefVectorWithLeader<ParticleSet>& P_list,
+                                   int first,
+                                   int last,
+                                   const ParticleSet& source,
+                                   int iat_src,
+                                   const RefVector<GradMatrix>& gradphi_list) const
+{
+  assert(this == &spo_list.getLeader());
+  for (int iw = 0; iw < spo_list.size(); iw++)
+    spo_list[iw].evaluateGradSource(P_list[iw], first, last, source, iat_src, gradphi_list[iw]);
+}
+
 void SPOSet::evaluateGradSource(const ParticleSet& P,
                                 int first,
                                 int last,
@@ -502,6 +502,20 @@ public:
                                   int iat_src,
                                   GradMatrix& gradphi);
 
+  /** batched version of evaluateGradSource
+   *  The default implementation loops over the walkers.
+   * @param spo_list the list of SPOSet of a walker batch
+   * @param P_list the list of target particle sets of a walker batch
+   * @param gradphi_list gradients of each walker
+   */
+  virtual void mw_evaluateGradSource(const RefVectorWithLeader<SPOSet>& spo_list,
+                                     const RefVectorWithLeader<ParticleSet>& P_list,
+                                     int first,
+                                     int last,
+                                     const ParticleSet& source,
+                                     int iat_src,
+                                     const RefVector<GradMatrix>& gradphi_list) const;
+
   /** evaluate the gradients of values, gradients, laplacians of this single-particle orbital
    *  for [first,last) target particles with respect to the given source particle
    * @param P current ParticleSet
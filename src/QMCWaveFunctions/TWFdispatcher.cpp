@@ -169,6 +169,23 @@ void TWFdispatcher::flex_evaluateRatios(const RefVectorWithLeader<TrialWaveFunct
       wf_list[iw].evaluateRatios(vp_list[iw], ratios_list[iw], ct);
 }
 
+void TWFdispatcher::flex_evalGradSource(const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                        const RefVectorWithLeader<ParticleSet>& p_list,
+                                        ParticleSet& source,
+                                        int iat,
+                                        std::vector<GradType>& grads) const
+{
+  assert(wf_list.size() == p_list.size());
+  if (use_batch_)
+    TrialWaveFunction::mw_evalGradSource(wf_list, p_list, source, iat, grads);
+  else
+  {
+    grads.resize(wf_list.size());
+    for (size_t iw = 0; iw < wf_list.size(); iw++)
+      grads[iw] = wf_list[iw].evalGradSource(p_list[iw], source, iat);
+  }
+}
+
 template void TWFdispatcher::flex_evalGrad<CoordsType::POS>(const RefVectorWithLeader<TrialWaveFunction>& wf_list,
                                                             const RefVectorWithLeader<ParticleSet>& p_list,
                                                             int iat,
@@ -80,6 +80,12 @@ public:
                            const RefVector<std::vector<ValueType>>& ratios_list,
                            ComputeType ct) const;
 
+  void flex_evalGradSource(const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                           const RefVectorWithLeader<ParticleSet>& p_list,
+                           ParticleSet& source,
+                           int iat,
+                           std::vector<GradType>& grads) const;
+
 private:
   bool use_batch_;
 };
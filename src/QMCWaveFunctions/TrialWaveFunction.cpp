@@ -459,7 +459,7 @@ TrialWaveFunction::ValueType TrialWaveFunction::calcRatio(ParticleSet& P, int ia
       r *= Z[i]->ratio(P, iat);
     }
 
-  NaNguard::checkOneParticleRatio(r, "TWF::calcRatio at particle " + std::to_string(iat));
+  NaNguard::checkOneParticleRatio(r, "TWF::calcRatio", iat);
   return static_cast<ValueType>(r);
 }
 
@@ -494,7 +494,7 @@ void TrialWaveFunction::mw_calcRatio(const RefVectorWithLeader<TrialWaveFunction
 
   for (int iw = 0; iw < wf_list.size(); iw++)
   {
-    NaNguard::checkOneParticleRatio(ratios[iw], "TWF::mw_calcRatio at particle " + std::to_string(iat));
+    NaNguard::checkOneParticleRatio(ratios[iw], "TWF::mw_calcRatio", iat);
     wf_list[iw].PhaseDiff = std::arg(ratios[iw]);
   }
 }
@@ -531,7 +531,7 @@ TrialWaveFunction::GradType TrialWaveFunction::evalGrad(ParticleSet& P, int iat)
     ScopedTimer z_timer(WFC_timers_[VGL_TIMER + TIMER_SKIP * i]);
     grad_iat += Z[i]->evalGrad(P, iat);
   }
-  NaNguard::checkOneParticleGradients(grad_iat, "TWF::evalGrad at particle " + std::to_string(iat));
+  NaNguard::checkOneParticleGradients(grad_iat, "TWF::evalGrad", iat);
   return grad_iat;
 }
 
@@ -545,7 +545,7 @@ TrialWaveFunction::GradType TrialWaveFunction::evalGradWithSpin(ParticleSet& P,
     ScopedTimer z_timer(WFC_timers_[VGL_TIMER + TIMER_SKIP * i]);
     grad_iat += Z[i]->evalGradWithSpin(P, iat, spingrad);
   }
-  NaNguard::checkOneParticleGradients(grad_iat, "TWF::evalGradWithSpin at particle " + std::to_string(iat));
+  NaNguard::checkOneParticleGradients(grad_iat, "TWF::evalGradWithSpin", iat);
   return grad_iat;
 }
 
@@ -574,7 +574,7 @@ void TrialWaveFunction::mw_evalGrad(const RefVectorWithLeader<TrialWaveFunction>
   }
 
   for (const GradType& grads : grads.grads_positions)
-    NaNguard::checkOneParticleGradients(grads, "TWF::mw_evalGrad at particle " + std::to_string(iat));
+    NaNguard::checkOneParticleGradients(grads, "TWF::mw_evalGrad", iat);
 }
 
 // Evaluates the gradient w.r.t. to the source of the Laplacian
@@ -587,6 +587,22 @@ TrialWaveFunction::GradType TrialWaveFunction::evalGradSource(ParticleSet& P, Pa
   return grad_iat;
 }
 
+void TrialWaveFunction::mw_evalGradSource(const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                          const RefVectorWithLeader<ParticleSet>& p_list,
+                                          ParticleSet& source,
+                                          int iat,
+                                          std::vector<GradType>& grads)
+{
+  auto& wf_leader = wf_list.getLeader();
+  grads.resize(wf_list.size());
+  std::fill(grads.begin(), grads.end(), GradType());
+  for (int i = 0; i < wf_leader.Z.size(); ++i)
+  {
+    const auto wfc_list(extractWFCRefList(wf_list, i));
+    wf_leader.Z[i]->mw_evalGradSource(wfc_list, p_list, source, iat, grads);
+  }
+}
+
 TrialWaveFunction::GradType TrialWaveFunction::evalGradSource(
     ParticleSet& P,
     ParticleSet& source,
@@ -635,9 +651,9 @@ TrialWaveFunction::ValueType TrialWaveFunction::calcRatioGrad(ParticleSet& P, in
       r *= Z[i]->ratioGrad(P, iat, grad_iat);
     }
 
-  NaNguard::checkOneParticleRatio(r, "TWF::calcRatioGrad at particle " + std::to_string(iat));
+  NaNguard::checkOneParticleRatio(r, "TWF::calcRatioGrad", iat);
   if (r != PsiValue(0)) // grad_iat is meaningful only when r is strictly non-zero
-    NaNguard::checkOneParticleGradients(grad_iat, "TWF::calcRatioGrad at particle " + std::to_string(iat));
+    NaNguard::checkOneParticleGradients(grad_iat, "TWF::calcRatioGrad", iat);
   LogValue logratio = convertValueToLog(r);
   PhaseDiff         = std::imag(logratio);
   return static_cast<ValueType>(r);
@@ -658,9 +674,9 @@ TrialWaveFunction::ValueType TrialWaveFunction::calcRatioGradWithSpin(ParticleSe
     r *= Z[i]->ratioGradWithSpin(P, iat, grad_iat, spingrad_iat);
   }
 
-  NaNguard::checkOneParticleRatio(r, "TWF::calcRatioGradWithSpin at particle " + std::to_string(iat));
+  NaNguard::checkOneParticleRatio(r, "TWF::calcRatioGradWithSpin", iat);
   if (r != PsiValue(0)) // grad_iat is meaningful only when r is strictly non-zero
-    NaNguard::checkOneParticleGradients(grad_iat, "TWF::calcRatioGradWithSpin at particle " + std::to_string(iat));
+    NaNguard::checkOneParticleGradients(grad_iat, "TWF::calcRatioGradWithSpin", iat);
   LogValue logratio = convertValueToLog(r);
   PhaseDiff         = std::imag(logratio);
   return static_cast<ValueType>(r);
@@ -717,10 +733,9 @@ void TrialWaveFunction::mw_calcRatioGrad(const RefVectorWithLeader<TrialWaveFunc
   for (int iw = 0; iw < wf_list.size(); iw++)
   {
     wf_list[iw].PhaseDiff = std::arg(ratios[iw]);
-    NaNguard::checkOneParticleRatio(ratios[iw], "TWF::mw_calcRatioGrad at particle " + std::to_string(iat));
+    NaNguard::checkOneParticleRatio(ratios[iw], "TWF::mw_calcRatioGrad", iat);
     if (ratios[iw] != PsiValue(0))
-      NaNguard::checkOneParticleGradients(grad_new.grads_positions[iw],
-                                          "TWF::mw_calcRatioGrad at particle " + std::to_string(iat));
+      NaNguard::checkOneParticleGradients(grad_new.grads_positions[iw], "TWF::mw_calcRatioGrad", iat);
   }
 }
 
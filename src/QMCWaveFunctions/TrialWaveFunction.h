@@ -341,6 +341,14 @@ public:
   /** Returns the logarithmic gradient of the trial wave function
    *  with respect to the iat^th atom of the source ParticleSet. */
   GradType evalGradSource(ParticleSet& P, ParticleSet& source, int iat);
+  /** batched version of evalGradSource
+   * @param grads grads[iw] is set to the logarithmic gradient of the iw-th walker w.r.t. source particle iat
+   */
+  static void mw_evalGradSource(const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                const RefVectorWithLeader<ParticleSet>& p_list,
+                                ParticleSet& source,
+                                int iat,
+                                std::vector<GradType>& grads);
   /** Returns the logarithmic gradient of the w.r.t. the iat^th atom
    * of the source ParticleSet of the sum of laplacians w.r.t. the
    * electrons (target ParticleSet) of the trial wave function. */
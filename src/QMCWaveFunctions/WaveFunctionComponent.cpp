@@ -194,6 +194,17 @@ void WaveFunctionComponent::mw_evaluateGL(const RefVectorWithLeader<WaveFunction
     wfc_list[iw].evaluateGL(p_list[iw], G_list[iw], L_list[iw], fromscratch);
 }
 
+void WaveFunctionComponent::mw_evalGradSource(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                              const RefVectorWithLeader<ParticleSet>& p_list,
+                                              ParticleSet& source,
+                                              int iat,
+                                              std::vector<GradType>& grads) const
+{
+  assert(this == &wfc_list.getLeader());
+  for (int iw = 0; iw < wfc_list.size(); iw++)
+    grads[iw] += wfc_list[iw].evalGradSource(p_list[iw], source, iat);
+}
+
 void WaveFunctionComponent::extractOptimizableObjectRefs(UniqueOptObjRefs&)
 {
   if (isOptimizable())
@@ -270,6 +270,20 @@ public:
     return GradType();
   }
 
+  /** compute the logarithmic gradients w.r.t. the iat-th particle of the source particleset
+   *  for multiple walkers. The default implementation loops over the walkers.
+   * @param wfc_list the list of WaveFunctionComponent pointers of the same component in a walker batch
+   * @param p_list the list of ParticleSet pointers in a walker batch
+   * @param source classical particle set (ions)
+   * @param iat particle index of source (ion)
+   * @param grads the gradients of each walker are added to grads[iw]
+   */
+  virtual void mw_evalGradSource(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                 const RefVectorWithLeader<ParticleSet>& p_list,
+                                 ParticleSet& source,
+                                 int iat,
+                                 std::vector<GradType>& grads) const;
+
 
   /** evaluate the ratio of the new to old WaveFunctionComponent value and the new gradient
    * @param P the active ParticleSet
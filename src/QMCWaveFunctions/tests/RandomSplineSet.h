@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_RANDOMSPLINESET_H
+#define QMCPLUSPLUS_RANDOMSPLINESET_H
+
+#include <random>
+#include "Particle/ParticleSet.h"
+#include "spline/einspline_engine.hpp"
+
+namespace qmcplusplus
+{
+namespace testing
+{
+/** fills the B-spline orbitals of SplineR2R, SplineC2R or SplineC2C with random splines
+ */
+class RandomSplineSet
+{
+public:
+  using Twist = TinyVector<double, 3>;
+
+  /** one random spline, complex or real depending on the class, per twist
+   * @param spo spline set or the spline base of a hybrid representation set
+   * @param make_two_copies the complex spline at the twist produces two real orbitals, SplineC2R only
+   * @param half_g antiperiodic directions, SplineR2R only
+   */
+  template<typename SPLINE>
+  static void fill(SPLINE& spo,
+                   const ParticleSet::ParticleLayout& lattice,
+                   const std::vector<Twist>& twists,
+                   const std::vector<bool>& make_two_copies,
+                   const TinyVector<int, 3>& half_g)
+  {
+    const int num_splines = twists.size();
+    int num_orbs          = 0;
+    for (int i = 0; i < num_splines; i++)
+      num_orbs += make_two_copies[i] ? 2 : 1;
+
+    spo.PrimLattice = lattice;
+    spo.GGt         = dot(transpose(spo.PrimLattice.G), spo.PrimLattice.G);
+    spo.HalfG       = half_g;
+    spo.first_spo   = 0;
+    spo.last_spo    = num_orbs;
+    spo.setOrbitalSetSize(num_orbs);
+    spo.resizeStorage(num_splines, num_splines);
+    for (int i = 0; i < num_splines; i++)
+    {
+      spo.kPoints[i]       = lattice.k_cart(-twists[i]);
+      spo.MakeTwoCopies[i] = make_two_copies[i];
+    }
+
+    constexpr int mesh = 8;
+    Ugrid grid[3];
+    typename SPLINE::BCType bc[3];
+    for (int i = 0; i < 3; i++)
+    {
+      grid[i].start = 0.0;
+      grid[i].end   = 1.0;
+      grid[i].num   = mesh;
+      bc[i].lCode = bc[i].rCode = half_g[i] ? ANTIPERIODIC : PERIODIC;
+    }
+    spo.create_spline(grid, bc);
+    spo.flush_zero();
+
+    const TinyVector<double, 3> start(0.0), end(1.0);
+    const TinyVector<int, 3> mesh_size(mesh);
+    UBspline_3d_d* spline_r = einspline::create(spline_r, start, end, mesh_size, half_g);
+    UBspline_3d_d* spline_i = einspline::create(spline_i, start, end, mesh_size, half_g);
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> data_r(mesh * mesh * mesh), data_i(mesh * mesh * mesh);
+    for (int i = 0; i < num_splines; i++)
+    {
+      for (int ig = 0; ig < data_r.size(); ig++)
+      {
+        data_r[ig] = dist(rng);
+        data_i[ig] = dist(rng);
+      }
+      einspline::set(spline_r, data_r.data());
+      einspline::set(spline_i, data_i.data());
+      spo.set_spline(spline_r, spline_i, 0, i, 0);
+    }
+    einspline::destroy(spline_r);
+    einspline::destroy(spline_i);
+  }
+};
+} // namespace testing
+} // namespace qmcplusplus
+#endif
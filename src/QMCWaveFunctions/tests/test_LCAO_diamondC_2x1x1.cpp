@@ -18,6 +18,10 @@
 #include "Particle/ParticleSet.h"
 #include "QMCWaveFunctions/WaveFunctionComponent.h"
 #include "LCAO/LCAOrbitalBuilder.h"
+#include "LCAO/MultiQuinticSpline1D.h"
+#include "LCAO/SoaAtomicBasisSet.h"
+#include "LCAO/SoaLocalizedBasisSet.h"
+#include "Numerics/SoaSphericalTensor.h"
 #include <ResourceCollection.h>
 #include "QMCHamiltonians/NLPPJob.h"
 #include "DistanceTable.h"
@@ -910,6 +914,137 @@ void test_LCAO_DiamondC_2x1x1_cplx(const bool useOffload)
   }
 }
 
+/** the periodic images screened out by the support radius of the radial orbitals must not change the orbitals
+ * @param href wavefunction file
+ * @param twist twist in the units of the reciprocal lattice
+ * @param coef_size number of basis functions
+ */
+void test_LCAO_DiamondC_2x1x1_screening(const std::string& href, const std::string& twist, const int coef_size)
+{
+  using Real           = QMCTraits::RealType;
+  using ValueType      = QMCTraits::ValueType;
+  using AtomicBasisSet = SoaAtomicBasisSet<MultiQuinticSpline1D<Real>, SoaSphericalTensor<Real>>;
+  using BasisSet       = SoaLocalizedBasisSet<AtomicBasisSet, ValueType>;
+  Communicate* c       = OHMMS::Controller;
+
+  ParticleSet::ParticleLayout lattice;
+  lattice.R         = {6.7463223, 6.7463223, 0.0, 0.0, 3.37316115, 3.37316115, 3.37316115, 0.0, 3.37316115};
+  lattice.BoxBConds = true;
+  lattice.reset();
+  SimulationCell simcell(lattice);
+  ParticleSet ions_(simcell);
+  ions_.setName("ion0");
+  ions_.create({4});
+  ions_.R[0] = {0.0, 0.0, 0.0};
+  ions_.R[1] = {1.686580575, 1.686580575, 1.686580575};
+  ions_.R[2] = {3.37316115, 3.37316115, 0.0};
+  ions_.R[3] = {5.059741726, 5.059741726, 1.686580575};
+  ions_.getSpeciesSet().addSpecies("C");
+  ions_.update();
+
+  // electrons in the cell and out of it, the latter are translated back by the distance table
+  ParticleSet elec_(simcell);
+  elec_.setName("elec");
+  elec_.create({2, 2});
+  elec_.R[0] = {0.0, 1.0, 0.0};
+  elec_.R[1] = {-3.1, 7.9, 12.4};
+  elec_.R[2] = {15.2, -4.3, 2.2};
+  elec_.R[3] = {2.5, 0.4, -9.7};
+  SpeciesSet& tspecies = elec_.getSpeciesSet();
+  tspecies.addSpecies("u");
+  tspecies.addSpecies("d");
+  elec_.addTable(ions_);
+  elec_.update();
+
+  const std::string wf_xml_str = R"(
+    <sposet_collection type="molecularorbital" name="LCAOBSet" source="ion0" transform="yes" twist=")" +
+      twist + R"(" href=")" + href + R"(" PBCimages="5  5  5" gpu="no">
+      <basisset name="LCAOBSet" key="GTO" transform="yes">
+        <grid type="log" ri="1.e-6" rf="1.e2" npts="1001"/>
+      </basisset>
+      <sposet name="spoud" size="8">
+        <occupation mode="ground"/>
+        <coefficient size=")" +
+      std::to_string(coef_size) + R"(" spindataset="0"/>
+      </sposet>
+    </sposet_collection>
+  )";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(wf_xml_str));
+  xmlNodePtr root       = doc.getRoot();
+  xmlNodePtr sposet_xml = xmlNextElementSibling(xmlFirstElementChild(root));
+
+  // the basis sets of a builder are shared by its SPO sets, the second one evaluates all the images
+  LCAOrbitalBuilder screened_builder(elec_, ions_, c, root);
+  LCAOrbitalBuilder all_images_builder(elec_, ions_, c, root);
+  auto* screened_bs   = dynamic_cast<BasisSet*>(screened_builder.getBasissetMap().at("LCAOBSet").get());
+  auto* all_images_bs = dynamic_cast<BasisSet*>(all_images_builder.getBasissetMap().at("LCAOBSet").get());
+  REQUIRE(screened_bs != nullptr);
+  REQUIRE(all_images_bs != nullptr);
+  auto screened_spo   = screened_builder.createSPOSetFromXML(sposet_xml);
+  auto all_images_spo = all_images_builder.createSPOSetFromXML(sposet_xml);
+  REQUIRE(screened_spo);
+  REQUIRE(all_images_spo);
+  // PBCimages of 5 gives 6 images per direction
+  const int num_images = 6 * 6 * 6;
+  for (auto& atom_bs : all_images_bs->LOBasisSet)
+    atom_bs->setSupportRadius(std::numeric_limits<Real>::max() / 2);
+  for (int i = 0; i < screened_bs->LOBasisSet.size(); i++)
+  {
+    CHECK(all_images_bs->LOBasisSet[i]->getNumScreenedImages() == num_images);
+    CHECK(screened_bs->LOBasisSet[i]->getNumScreenedImages() < num_images);
+  }
+
+  const auto check = [](const ValueType& ref, const ValueType& test) {
+    CHECK(std::real(test) == Approx(std::real(ref)).epsilon(1e-6).margin(1e-8));
+    CHECK(std::imag(test) == Approx(std::imag(ref)).epsilon(1e-6).margin(1e-8));
+  };
+  const int norb = screened_spo->getOrbitalSetSize();
+  SPOSet::ValueVector psi(norb), psi_ref(norb), d2psi(norb), d2psi_ref(norb);
+  SPOSet::GradVector dpsi(norb), dpsi_ref(norb);
+  for (int iat = 0; iat < elec_.getTotalNum(); iat++)
+  {
+    INFO("electron " << iat);
+    all_images_spo->evaluateVGL(elec_, iat, psi_ref, dpsi_ref, d2psi_ref);
+    screened_spo->evaluateVGL(elec_, iat, psi, dpsi, d2psi);
+    for (int i = 0; i < norb; i++)
+    {
+      check(psi_ref[i], psi[i]);
+      for (int idim = 0; idim < 3; idim++)
+        check(dpsi_ref[i][idim], dpsi[i][idim]);
+      check(d2psi_ref[i], d2psi[i]);
+    }
+  }
+
+  // the phase of a lattice translation composed from the phases of the lattice vectors and with sincos
+  TinyVector<double, 3> supertwist = lattice.k_cart(TinyVector<double, 3>(0.07761248, 0.07761248, -0.07761248));
+  TinyVector<ValueType, 3> lattice_phases;
+  const auto phase_ref = [&](const TinyVector<double, 3>& tv) {
+    const double phasearg = dot(supertwist, tv);
+#if defined(QMC_COMPLEX)
+    return ValueType(std::cos(phasearg), -std::sin(phasearg));
+#else
+    return ValueType(1);
+#endif
+  };
+  for (int i_dim = 0; i_dim < 3; i_dim++)
+    lattice_phases[i_dim] = phase_ref(lattice.a(i_dim));
+  for (const TinyVector<int, 3>& n : {TinyVector<int, 3>(0, 0, 0), TinyVector<int, 3>(1, 0, 0),
+                                      TinyVector<int, 3>(2, -1, 3), TinyVector<int, 3>(-4, 0, -2)})
+  {
+    INFO("translation " << n);
+    const auto phase = [&](const TinyVector<double, 3>& tv) {
+      return AtomicBasisSet::latticeTranslationPhase(tv.data(), lattice.G.data(), lattice_phases.data(),
+                                                     supertwist.data());
+    };
+    TinyVector<double, 3> tv = n[0] * lattice.a(0) + n[1] * lattice.a(1) + n[2] * lattice.a(2);
+    check(phase_ref(tv), phase(tv));
+    // not a lattice translation
+    tv += TinyVector<double, 3>(0.3, -0.2, 0.1);
+    check(phase_ref(tv), phase(tv));
+  }
+}
+
 TEST_CASE("LCAOrbitalSet batched PBC DiamondC", "[wavefunction]")
 {
   SECTION("2x1x1 real") { test_LCAO_DiamondC_2x1x1_real(false); }
@@ -925,4 +1060,15 @@ TEST_CASE("LCAOrbitalSet batched PBC DiamondC offload", "[wavefunction]")
   SECTION("2x1x1 cplx offload") { test_LCAO_DiamondC_2x1x1_cplx(true); }
 #endif
 }
+TEST_CASE("LCAOrbitalSet PBC image screening DiamondC", "[wavefunction]")
+{
+  SECTION("2x1x1 real") { test_LCAO_DiamondC_2x1x1_screening("C_Diamond_2x1x1-Gaussian.h5", "0  0  0", 116); }
+#ifdef QMC_COMPLEX
+  SECTION("2x1x1 cplx")
+  {
+    test_LCAO_DiamondC_2x1x1_screening("C_Diamond_2x1x1-Gaussian-tiled-cplx.h5", "0.07761248  0.07761248  -0.07761248",
+                                       52);
+  }
+#endif
+}
 } // namespace qmcplusplus
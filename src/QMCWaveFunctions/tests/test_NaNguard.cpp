@@ -23,5 +23,10 @@ TEST_CASE("NaNguard", "[wavefunction]")
   CHECK_NOTHROW(NaNguard::checkOneParticleRatio(0.0, "unit test"));
   CHECK_THROWS_WITH(NaNguard::checkOneParticleGradients({const_nan, -const_nan, const_nan}, "unit test"), Catch::Matchers::Contains("NaNguard::checkOneParticleGradients"));
   CHECK_NOTHROW(NaNguard::checkOneParticleGradients({0.0,0.0,0.0}, "unit test"));
+  // the particle index is only composed into the message on error
+  CHECK_THROWS_WITH(NaNguard::checkOneParticleRatio(const_nan, "unit test", 3),
+                    Catch::Matchers::Contains("unit test at particle 3"));
+  CHECK_THROWS_WITH(NaNguard::checkOneParticleGradients({0.0, const_nan, 0.0}, "unit test", 5),
+                    Catch::Matchers::Contains("unit test at particle 5"));
 }
 }
@@ -16,9 +16,16 @@
 #include "OhmmsPETE/OhmmsMatrix.h"
 #include "Particle/ParticleSet.h"
 #include "Particle/ParticleSetPool.h"
+#include "Particle/VirtualParticleSet.h"
 #include "QMCWaveFunctions/WaveFunctionComponent.h"
 #include "BsplineFactory/EinsplineSetBuilder.h"
 #include "BsplineFactory/EinsplineSpinorSetBuilder.h"
+#ifdef QMC_COMPLEX
+#include "BsplineFactory/SplineC2C.h"
+#else
+#include "BsplineFactory/SplineC2R.h"
+#include "BsplineFactory/SplineR2R.h"
+#endif
 #include <ResourceCollection.h>
 
 #include <stdio.h>
@@ -453,6 +460,33 @@ TEST_CASE("Einspline SPO from HDF diamond_2x1x1 5 electrons", "[wavefunction]")
   CHECK(std::real(grads_v[1][1]) == Approx(-0.7499371447));
   CHECK(std::real(grads_v[1][2]) == Approx(0.8570534314));
 #endif
+
+  // batched det ratios must agree with the single walker ones
+  using PosList = std::vector<ParticleSet::SingleParticlePos>;
+  const std::vector<PosList> deltas{PosList{{0.1, 0.2, 0.3}, {-0.2, 0.1, 0.4}, {0.3, -0.1, 0.2}},
+                                    PosList{{0.2, 0.3, 0.4}, {0.5, -0.4, 0.1}}};
+  VirtualParticleSet vp(elec_, deltas[0].size());
+  VirtualParticleSet vp_2(elec_2, deltas[1].size());
+  vp.makeMoves(elec_, 1, deltas[0]);
+  vp_2.makeMoves(elec_2, 2, deltas[1]);
+  RefVectorWithLeader<const VirtualParticleSet> vp_list(vp, {vp, vp_2});
+
+  SPOSet::ValueVector inv_row_host(spo->getOrbitalSetSize());
+  for (int i = 0; i < inv_row_host.size(); i++)
+    inv_row_host[i] = 0.1 * (i + 1);
+  std::vector<const SPOSet::ValueType*> inv_row_host_ptr(nw, inv_row_host.data());
+  std::vector<std::vector<SPOSet::ValueType>> ratios_list(nw);
+  for (size_t iw = 0; iw < nw; iw++)
+    ratios_list[iw].resize(deltas[iw].size());
+  spo->mw_evaluateDetRatios(spo_list, vp_list, psi_v_list, inv_row_host_ptr, ratios_list);
+
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    std::vector<SPOSet::ValueType> ratios_ref(deltas[iw].size());
+    spo_list[iw].evaluateDetRatios(vp_list[iw], psi, inv_row_host, ratios_ref);
+    for (size_t ivp = 0; ivp < ratios_ref.size(); ivp++)
+      CHECK(ratios_list[iw][ivp] == ValueApprox(ratios_ref[ivp]));
+  }
 }
 
 TEST_CASE("EinsplineSetBuilder CheckLattice", "[wavefunction]")
@@ -494,4 +528,40 @@ TEST_CASE("EinsplineSetBuilder CheckLattice", "[wavefunction]")
   REQUIRE_FALSE(esb.CheckLattice());
 }
 
+/// the operations needing the full precision table fail with a clear message once it is compressed
+template<class SPLINE>
+void testCompressedTableGuards()
+{
+  SPLINE spo("compressed");
+  spo.resizeStorage(2, 2);
+  Ugrid grid[3];
+  BCtype_d bc[3];
+  for (int i = 0; i < 3; i++)
+  {
+    grid[i].start = 0.0;
+    grid[i].end   = 1.0;
+    grid[i].num   = 4;
+    bc[i].lCode = bc[i].rCode = PERIODIC;
+  }
+  spo.create_spline(grid, bc);
+  spo.flush_zero();
+  spo.compress_tables();
+
+  using Catch::Matchers::Contains;
+  CHECK_THROWS_WITH(spo.flush_zero(), Contains("flush_zero") && Contains("released by compress_tables"));
+  CHECK_THROWS_WITH(spo.bcast_tables(OHMMS::Controller), Contains("bcast_tables"));
+  CHECK_THROWS_WITH(spo.compress_tables(), Contains("compress_tables"));
+  CHECK(!spo.isRotationSupported());
+}
+
+TEST_CASE("Spline tables after compression", "[wavefunction]")
+{
+#ifdef QMC_COMPLEX
+  testCompressedTableGuards<SplineC2C<double>>();
+#else
+  testCompressedTableGuards<SplineR2R<double>>();
+  testCompressedTableGuards<SplineC2R<double>>();
+#endif
+}
+
 } // namespace qmcplusplus
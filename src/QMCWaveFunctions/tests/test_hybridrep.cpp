@@ -15,6 +15,7 @@
 #include <cstdio>
 #include <string>
 #include <limits>
+#include <numeric>
 
 #include "OhmmsData/Libxml2Doc.h"
 #include "OhmmsPETE/OhmmsMatrix.h"
@@ -26,6 +27,15 @@
 #include "BsplineFactory/EinsplineSpinorSetBuilder.h"
 #include <ResourceCollection.h>
 #include "Utilities/for_testing/checkMatrix.hpp"
+#ifdef QMC_COMPLEX
+#include "BsplineFactory/SplineC2C.h"
+#else
+#include "BsplineFactory/SplineC2R.h"
+#include "BsplineFactory/SplineR2R.h"
+#include "BsplineFactory/HybridRepReal.h"
+#endif
+#include "BsplineFactory/HybridRepCplx.h"
+#include "RandomSplineSet.h"
 
 using std::string;
 
@@ -385,4 +395,218 @@ TEST_CASE("Hybridrep SPO from HDF diamond_2x1x1", "[wavefunction]")
 #endif
 }
 
+namespace testing
+{
+/** builds hybrid representation sets from random B-spline orbitals and random atomic centered orbitals
+ */
+class HybridRepTests
+{
+public:
+  static constexpr int lmax           = 3;
+  static constexpr int spline_npoints = 31;
+
+  /** one atomic center per ion on top of the B-spline orbitals of RandomSplineSet
+   * The ion distance table is added to elec, the crowd must be copied from elec afterwards.
+   */
+  template<typename HYBRID>
+  static std::unique_ptr<HYBRID> makeHybridSet(const ParticleSet& ions,
+                                               ParticleSet& elec,
+                                               const std::vector<RandomSplineSet::Twist>& twists,
+                                               const std::vector<bool>& make_two_copies,
+                                               const TinyVector<int, 3>& half_g)
+  {
+    using ST     = typename HYBRID::DataType;
+    using Hybrid = typename HYBRID::HYBRIDBASE;
+
+    auto spo = std::make_unique<HYBRID>("hybrid");
+    RandomSplineSet::fill<typename HYBRID::SplineBase>(*spo, ions.getLattice(), twists, make_two_copies, half_g);
+
+    Hybrid& hybrid        = *spo;
+    hybrid.smooth_scheme  = Hybrid::smoothing_schemes::CONSISTENT;
+    hybrid.smooth_func_id = smoothing_functions::LEKS2018;
+    std::vector<int> super_to_prim(ions.getTotalNum());
+    std::iota(super_to_prim.begin(), super_to_prim.end(), 0);
+    hybrid.set_info(ions, elec, super_to_prim);
+    for (int ic = 0; ic < ions.getTotalNum(); ic++)
+    {
+      AtomicOrbitals<ST> center(lmax);
+      // cutoff, inner cutoff, spline radius, non overlapping radius
+      center.set_info(ions.R[ic], 1.2, 0.8, 1.5, 1.4, spline_npoints);
+      hybrid.AtomicCenters.push_back(center);
+    }
+    hybrid.resizeStorage(spo->myV.size());
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> radial(spline_npoints);
+    const int num_slots = spo->isComplex() ? 2 * twists.size() : twists.size();
+    for (auto& center : hybrid.AtomicCenters)
+    {
+      const double spline_radius = center.getSplineRadius();
+      for (int lm = 0; lm < (lmax + 1) * (lmax + 1); lm++)
+        for (int islot = 0; islot < num_slots; islot++)
+        {
+          for (int ip = 0; ip < spline_npoints; ip++)
+            radial[ip] = dist(rng);
+          const bool flat_at_origin    = (lm == 0) || (lm > 3);
+          UBspline_1d_d* atomic_spline = nullptr;
+          atomic_spline =
+              einspline::create(atomic_spline, 0.0, spline_radius, spline_npoints, radial.data(), flat_at_origin);
+          center.set_spline(atomic_spline, lm, islot);
+          einspline::destroy(atomic_spline);
+        }
+    }
+    return spo;
+  }
+
+  template<typename HYBRID>
+  static auto getRegion(const HYBRID& spo)
+  {
+    return spo.info.region;
+  }
+};
+} // namespace testing
+
+/** compare the region partitioned crowd evaluation with the evaluation walker by walker
+ * The electron 0 of the walkers is inside an atomic sphere, in the buffer region, in the interstitial region,
+ * inside the sphere of a periodic image of an ion and far from the reference ion of its quadrature points.
+ * Each ion has two atomic region walkers at different distances, evaluated as one group.
+ */
+template<typename HYBRID>
+void testHybridRepCrowd(const std::vector<testing::RandomSplineSet::Twist>& twists,
+                        const std::vector<bool>& make_two_copies,
+                        const TinyVector<int, 3>& half_g,
+                        double tol)
+{
+  using ValueType   = SPOSet::ValueType;
+  using ValueVector = SPOSet::ValueVector;
+  using GradVector  = SPOSet::GradVector;
+  using PosType     = ParticleSet::PosType;
+  using Region      = typename HYBRID::HYBRIDBASE::Region;
+
+  ParticleSet::ParticleLayout lattice;
+  lattice.BoxBConds = true;
+  lattice.R         = {6.0, 0.2, 0.0, 0.1, 6.2, 0.3, 0.0, -0.2, 5.9};
+  lattice.reset();
+  const SimulationCell simulation_cell(lattice);
+  ParticleSet ions(simulation_cell);
+  ions.setName("ion");
+  ions.create({2});
+  ions.R[0] = {1.0, 1.0, 1.0};
+  ions.R[1] = {4.0, 3.6, 3.2};
+  ions.update();
+
+  ParticleSet elec(simulation_cell);
+  elec.setName("elec");
+  elec.create({2});
+  elec.R[1] = {3.0, 0.5, 4.5};
+  auto spo  = testing::HybridRepTests::makeHybridSet<HYBRID>(ions, elec, twists, make_two_copies, half_g);
+
+  // electron 0 of each walker relative to an ion, the expected region and the reference ion of the quadrature points
+  const std::vector<int> ref_ions{0, 1, 0, 1, 0, 0};
+  const std::vector<PosType> offsets{{0.3, 0.2, -0.1}, {0.6, -0.5, 0.4}, {-0.7, 0.8, 0.6},
+                                     {0.1, -0.4, 0.2}, {2.0, 1.5, -1.0}, {-0.2, 0.3, 0.3}};
+  const std::vector<Region> regions{Region::INSIDE, Region::BUFFER, Region::INTER,
+                                    Region::INSIDE, Region::INTER,  Region::INSIDE};
+  const size_t nw = offsets.size();
+
+  std::vector<std::unique_ptr<ParticleSet>> elecs;
+  std::vector<std::unique_ptr<SPOSet>> spos;
+  RefVectorWithLeader<ParticleSet> p_list(elec);
+  RefVectorWithLeader<SPOSet> spo_list(*spo);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    elecs.push_back(std::make_unique<ParticleSet>(elec));
+    elecs[iw]->R[0] = ions.R[ref_ions[iw]] + offsets[iw];
+    spos.push_back(spo->makeClone());
+    p_list.push_back(*elecs[iw]);
+    spo_list.push_back(*spos[iw]);
+  }
+  // the last walker is around the image of ion 0 shifted by the first lattice vector
+  elecs[nw - 1]->R[0] += lattice.a(0);
+  for (auto& p : elecs)
+    p->update();
+
+  const auto check = [tol](const ValueType& ref, const ValueType& test) {
+    CHECK(std::real(test) == Approx(std::real(ref)).epsilon(tol).margin(tol));
+    CHECK(std::imag(test) == Approx(std::imag(ref)).epsilon(tol).margin(tol));
+  };
+
+  const int norb = spo->getOrbitalSetSize();
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  ValueVector invrow(norb);
+  for (int i = 0; i < norb; i++)
+    invrow[i] = dist(rng);
+
+  // quadrature points on the sphere around the reference ion through electron 0
+  const std::vector<PosType> directions{{1.0, 0.0, 0.0}, {0.0, -1.0, 0.0}, {0.0, 0.6, 0.8}, {-0.48, 0.6, -0.64}};
+  std::vector<std::unique_ptr<VirtualParticleSet>> vps;
+  for (int iw = 0; iw < nw; iw++)
+  {
+    std::vector<PosType> deltas;
+    for (const auto& u : directions)
+      deltas.push_back(std::sqrt(dot(offsets[iw], offsets[iw])) * u - offsets[iw]);
+    vps.push_back(std::make_unique<VirtualParticleSet>(*elecs[iw], directions.size()));
+    vps[iw]->makeMoves(*elecs[iw], 0, deltas, true, ref_ions[iw]);
+  }
+  RefVectorWithLeader<const VirtualParticleSet> vp_list(*vps[0]);
+  for (auto& vp : vps)
+    vp_list.push_back(*vp);
+
+  std::vector<ValueVector> psi_v(nw, ValueVector(norb));
+  RefVector<ValueVector> psi_list(psi_v.begin(), psi_v.end());
+  const std::vector<const ValueType*> invrow_ptrs(nw, invrow.data());
+  std::vector<std::vector<ValueType>> ratios_list(nw, std::vector<ValueType>(directions.size()));
+  spo->mw_evaluateDetRatios(spo_list, vp_list, psi_list, invrow_ptrs, ratios_list);
+
+  ValueVector psi(norb), d2psi(norb);
+  GradVector dpsi(norb);
+  std::vector<ValueType> ratios(directions.size());
+  for (int iw = 0; iw < nw; iw++)
+  {
+    INFO("det ratios of walker " << iw);
+    spo_list[iw].evaluateDetRatios(*vps[iw], psi, invrow, ratios);
+    for (int ip = 0; ip < directions.size(); ip++)
+      check(ratios[ip], ratios_list[iw][ip]);
+  }
+
+  std::vector<ValueVector> d2psi_v(nw, ValueVector(norb));
+  std::vector<GradVector> dpsi_v(nw, GradVector(norb));
+  RefVector<GradVector> dpsi_list(dpsi_v.begin(), dpsi_v.end());
+  RefVector<ValueVector> d2psi_list(d2psi_v.begin(), d2psi_v.end());
+  spo->mw_evaluateVGL(spo_list, p_list, 0, psi_list, dpsi_list, d2psi_list);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    INFO("VGL of walker " << iw);
+    CHECK(testing::HybridRepTests::getRegion(spo_list.template getCastedElement<HYBRID>(iw)) == regions[iw]);
+    spo_list[iw].evaluateVGL(p_list[iw], 0, psi, dpsi, d2psi);
+    for (int i = 0; i < norb; i++)
+    {
+      check(psi[i], psi_v[iw][i]);
+      for (int idim = 0; idim < 3; idim++)
+        check(dpsi[i][idim], dpsi_v[iw][i][idim]);
+      check(d2psi[i], d2psi_v[iw][i]);
+    }
+  }
+}
+
+TEST_CASE("Hybridrep crowd partitioned by region", "[wavefunction]")
+{
+  using Twist = testing::RandomSplineSet::Twist;
+  const std::vector<Twist> twists{Twist(0.25, 0.0, 0.0), Twist(0.0), Twist(0.1, 0.3, -0.2), Twist(0.5, 0.0, 0.0)};
+  const std::vector<bool> one_copy(twists.size(), false);
+  const TinyVector<int, 3> periodic(0);
+#ifdef QMC_COMPLEX
+  testHybridRepCrowd<HybridRepCplx<SplineC2C<double>>>(twists, one_copy, periodic, 1e-10);
+  testHybridRepCrowd<HybridRepCplx<SplineC2C<float>>>(twists, one_copy, periodic, 1e-4);
+#else
+  const std::vector<bool> make_two_copies{true, false, true, false};
+  testHybridRepCrowd<HybridRepCplx<SplineC2R<double>>>(twists, make_two_copies, periodic, 1e-10);
+  testHybridRepCrowd<HybridRepCplx<SplineC2R<float>>>(twists, make_two_copies, periodic, 1e-4);
+  const std::vector<Twist> gamma(twists.size(), Twist(0.0));
+  testHybridRepCrowd<HybridRepReal<SplineR2R<double>>>(gamma, one_copy, TinyVector<int, 3>(1, 0, 1), 1e-10);
+#endif
+}
+
 } // namespace qmcplusplus
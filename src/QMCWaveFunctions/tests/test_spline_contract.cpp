@@ -0,0 +1,193 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <random>
+#include "RandomSplineSet.h"
+#include "Particle/ParticleSet.h"
+#include "Particle/VirtualParticleSet.h"
+#include "CPU/SIMD/inner_product.hpp"
+#ifdef QMC_COMPLEX
+#include "QMCWaveFunctions/BsplineFactory/SplineC2C.h"
+#else
+#include "QMCWaveFunctions/BsplineFactory/SplineC2R.h"
+#include "QMCWaveFunctions/BsplineFactory/SplineR2R.h"
+#endif
+
+namespace qmcplusplus
+{
+template<typename SPLINE>
+std::unique_ptr<SPLINE> makeSplineSet(const ParticleSet::ParticleLayout& lattice,
+                                      const std::vector<testing::RandomSplineSet::Twist>& twists,
+                                      const std::vector<bool>& make_two_copies,
+                                      const TinyVector<int, 3>& half_g)
+{
+  auto spo = std::make_unique<SPLINE>("contract");
+  testing::RandomSplineSet::fill(*spo, lattice, twists, make_two_copies, half_g);
+  return spo;
+}
+
+/** compare the det ratios contracted from the spline values with the dot of the inverse row and the VGL
+ * of the orbitals at the moved positions, for all the orbitals and for truncated inverse rows
+ */
+template<typename SPLINE>
+void testContractedRatios(std::unique_ptr<SPLINE> spo, const ParticleSet::ParticleLayout& lattice, double tol)
+{
+  using ValueType   = SPOSet::ValueType;
+  using ValueVector = SPOSet::ValueVector;
+  using GradVector  = SPOSet::GradVector;
+  using PosList     = std::vector<ParticleSet::SingleParticlePos>;
+
+  const SimulationCell simulation_cell(lattice);
+  ParticleSet elec(simulation_cell);
+  elec.create({2});
+  elec.R[0] = {0.3, 0.5, 0.7};
+  elec.R[1] = {2.1, 4.0, -1.2};
+  elec.update();
+  ParticleSet elec_2(elec);
+  elec_2.R[0] = {-0.8, 1.9, 3.3};
+  elec_2.update();
+
+  auto spo_2 = spo->makeClone();
+  RefVectorWithLeader<SPOSet> spo_list(*spo, {*spo, *spo_2});
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec_2});
+
+  const std::vector<PosList> deltas{PosList{{0.1, 0.2, 0.3}, {-1.2, 0.1, 2.4}, {3.3, -0.1, 0.2}},
+                                    PosList{{0.2, 3.3, 0.4}, {0.5, -0.4, -2.1}}};
+  VirtualParticleSet vp(elec, deltas[0].size());
+  VirtualParticleSet vp_2(elec_2, deltas[1].size());
+  vp.makeMoves(elec, 0, deltas[0]);
+  vp_2.makeMoves(elec_2, 0, deltas[1]);
+  RefVectorWithLeader<const VirtualParticleSet> vp_list(vp, {vp, vp_2});
+
+  const auto check = [tol](const ValueType& ref, const ValueType& test) {
+    CHECK(std::real(test) == Approx(std::real(ref)).epsilon(tol).margin(tol));
+    CHECK(std::imag(test) == Approx(std::imag(ref)).epsilon(tol).margin(tol));
+  };
+
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  const int num_orbs = spo->getOrbitalSetSize();
+  for (int num_requested : {num_orbs, num_orbs - 1, num_orbs - 3})
+  {
+    INFO("number of requested orbitals " << num_requested);
+    ValueVector invrow(num_requested);
+    for (int i = 0; i < num_requested; i++)
+#ifdef QMC_COMPLEX
+      invrow[i] = ValueType(dist(rng), dist(rng));
+#else
+      invrow[i] = dist(rng);
+#endif
+
+    // reference values from the full VGL of each walker and quadrature point
+    ValueVector psi(num_requested), d2psi(num_requested);
+    GradVector dpsi(num_requested);
+    const auto ratio_at = [&](ParticleSet& p, const ParticleSet::SingleParticlePos& delta) {
+      p.makeMove(0, delta);
+      spo->evaluateVGL(p, 0, psi, dpsi, d2psi);
+      p.rejectMove(0);
+      return simd::dot(psi.data(), invrow.data(), num_requested);
+    };
+
+    std::vector<ValueType> ratios(deltas[0].size());
+    spo->evaluateDetRatios(vp, psi, invrow, ratios);
+    for (int ip = 0; ip < deltas[0].size(); ip++)
+      check(ratio_at(elec, deltas[0][ip]), ratios[ip]);
+
+    std::vector<ValueVector> mw_psi(2, ValueVector(num_requested));
+    RefVector<ValueVector> psi_list{mw_psi[0], mw_psi[1]};
+    const std::vector<const ValueType*> invrow_ptrs(2, invrow.data());
+    std::vector<std::vector<ValueType>> ratios_list{std::vector<ValueType>(deltas[0].size()),
+                                                    std::vector<ValueType>(deltas[1].size())};
+    spo->mw_evaluateDetRatios(spo_list, vp_list, psi_list, invrow_ptrs, ratios_list);
+    for (int iw = 0; iw < 2; iw++)
+      for (int ip = 0; ip < deltas[iw].size(); ip++)
+        check(ratio_at(p_list[iw], deltas[iw][ip]), ratios_list[iw][ip]);
+
+    // VGL of the current positions with the ratios and the gradients, the crowd shrinks on the second pass
+    for (const int nw : {2, 1})
+    {
+      RefVectorWithLeader<SPOSet> sub_spo_list(*spo);
+      RefVectorWithLeader<ParticleSet> sub_p_list(elec);
+      for (int iw = 0; iw < nw; iw++)
+      {
+        sub_spo_list.push_back(spo_list[iw]);
+        sub_p_list.push_back(p_list[iw]);
+      }
+      SPOSet::OffloadMWVGLArray phi_vgl_v;
+      phi_vgl_v.resize(QMCTraits::DIM_VGL, nw, num_requested);
+      std::vector<ValueType> ratios_v(nw);
+      std::vector<SPOSet::GradType> grads_v(nw);
+      const std::vector<const ValueType*> sub_invrow_ptrs(nw, invrow.data());
+      spo->mw_evaluateVGLandDetRatioGrads(sub_spo_list, sub_p_list, 0, sub_invrow_ptrs, phi_vgl_v, ratios_v, grads_v);
+      for (int iw = 0; iw < nw; iw++)
+      {
+        spo->evaluateVGL(p_list[iw], 0, psi, dpsi, d2psi);
+        const ValueType ratio = simd::dot(psi.data(), invrow.data(), num_requested);
+        check(ratio, ratios_v[iw]);
+        for (int idim = 0; idim < 3; idim++)
+        {
+          ValueType grad(0);
+          for (int i = 0; i < num_requested; i++)
+            grad += invrow[i] * dpsi[i][idim];
+          check(grad / ratio, grads_v[iw][idim]);
+        }
+        for (int i = 0; i < num_requested; i++)
+        {
+          check(psi[i], *phi_vgl_v.data_at(0, iw, i));
+          for (int idim = 0; idim < 3; idim++)
+            check(dpsi[i][idim], *phi_vgl_v.data_at(1 + idim, iw, i));
+          check(d2psi[i], *phi_vgl_v.data_at(4, iw, i));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Spline det ratios contracted with the inverse row", "[wavefunction]")
+{
+  ParticleSet::ParticleLayout lattice;
+  lattice.R = {3.0, 0.2, 0.0, 0.1, 3.2, 0.3, 0.0, -0.2, 2.9};
+  lattice.reset();
+
+  using Twist = testing::RandomSplineSet::Twist;
+  // general twists first give two real orbitals each in SplineC2R, nComplexBands is smaller than the number of twists
+  const std::vector<Twist> twists{Twist(0.25, 0.0, 0.0), Twist(0.0), Twist(0.1, 0.3, -0.2), Twist(0.5, 0.0, 0.0),
+                                  Twist(0.0, 0.2, 0.4)};
+  const std::vector<bool> make_two_copies{true, false, true, false, true};
+  const std::vector<bool> one_copy(twists.size(), false);
+  const TinyVector<int, 3> periodic(0);
+
+#ifdef QMC_COMPLEX
+  testContractedRatios(makeSplineSet<SplineC2C<double>>(lattice, twists, one_copy, periodic),
+                       lattice, 1e-10);
+  testContractedRatios(makeSplineSet<SplineC2C<float>>(lattice, twists, one_copy, periodic),
+                       lattice, 1e-4);
+#else
+  testContractedRatios(makeSplineSet<SplineC2R<double>>(lattice, twists, make_two_copies,
+                                                                             periodic),
+                       lattice, 1e-10);
+  testContractedRatios(makeSplineSet<SplineC2R<float>>(lattice, twists, make_two_copies,
+                                                                            periodic),
+                       lattice, 1e-4);
+  const std::vector<Twist> gamma(twists.size(), Twist(0.0));
+  const TinyVector<int, 3> half_g(1, 0, 1);
+  testContractedRatios(makeSplineSet<SplineR2R<double>>(lattice, gamma, one_copy, periodic),
+                       lattice, 1e-10);
+  testContractedRatios(makeSplineSet<SplineR2R<double>>(lattice, gamma, one_copy, half_g),
+                       lattice, 1e-10);
+  testContractedRatios(makeSplineSet<SplineR2R<float>>(lattice, gamma, one_copy, half_g),
+                       lattice, 1e-4);
+#endif
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,434 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <cmath>
+#include "QMCWaveFunctions/BsplineFactory/SplineSymmetryImages.h"
+#ifdef QMC_COMPLEX
+#include <random>
+#include "Particle/ParticleSet.h"
+#include "Particle/VirtualParticleSet.h"
+#include "QMCWaveFunctions/BsplineFactory/SplineC2C.h"
+#include "spline/einspline_impl.hpp"
+#endif
+
+namespace qmcplusplus
+{
+using Frac = TinyVector<double, 3>;
+
+TEST_CASE("SpaceGroupOperations", "[wavefunction]")
+{
+  // simple cubic with one atom, Oh
+  const Tensor<double, 3> cubic(2.0, 0, 0, 0, 2.0, 0, 0, 0, 2.0);
+  CHECK(findSpaceGroupOperations(cubic, {Frac(0.1, 0.2, 0.3)}, {0}).size() == 48);
+
+  // diamond, Oh with half of the operations combined with a fractional translation
+  const Tensor<double, 3> fcc(0.0, 1.7, 1.7, 1.7, 0.0, 1.7, 1.7, 1.7, 0.0);
+  const auto diamond_ops = findSpaceGroupOperations(fcc, {Frac(0.0), Frac(0.25)}, {0, 0});
+  CHECK(diamond_ops.size() == 48);
+  int num_translated = 0;
+  for (const auto& op : diamond_ops)
+    if (std::abs(op.trans[0]) + std::abs(op.trans[1]) + std::abs(op.trans[2]) > 1e-8)
+      num_translated++;
+  CHECK(num_translated == 24);
+
+  // zincblende loses the inversion
+  CHECK(findSpaceGroupOperations(fcc, {Frac(0.0), Frac(0.25)}, {0, 1}).size() == 24);
+
+  // repeated periodic images do not change the group
+  CHECK(findSpaceGroupOperations(fcc, {Frac(0.0), Frac(0.25), Frac(1.0, 0.0, 0.0), Frac(1.25, 0.25, 0.25)},
+                                 {0, 0, 0, 0})
+            .size() == 48);
+}
+
+TEST_CASE("SplineSymmetryImages fcc 2x2x2", "[wavefunction]")
+{
+  const Tensor<double, 3> fcc(0.0, 1.7, 1.7, 1.7, 0.0, 1.7, 1.7, 1.7, 0.0);
+  const auto ops = findSpaceGroupOperations(fcc, {Frac(0.0), Frac(0.25)}, {0, 0});
+
+  // Gamma, 4 L and 3 X points with two bands each, ordered by band
+  std::vector<Frac> twists;
+  std::vector<int> bands;
+  for (int ib = 0; ib < 2; ib++)
+    for (int ik = 0; ik < 8; ik++)
+    {
+      twists.push_back(Frac(0.5 * (ik & 1), 0.5 * ((ik >> 1) & 1), 0.5 * ((ik >> 2) & 1)));
+      bands.push_back(ib);
+    }
+  // the last L point misses its second band and cannot be an image
+  twists.pop_back();
+  bands.pop_back();
+
+  const int alignment = 8;
+  const auto images   = findSymmetryImages(ops, twists, bands, alignment);
+  CHECK(images.num_stored_twists == 4);
+  CHECK(images.slot_orbitals.size() == 4 * alignment);
+  CHECK(images.blocks.size() == 8);
+  CHECK(images.num_image_slots == 8 * alignment);
+
+  std::vector<int> visits(twists.size(), 0);
+  for (const auto& block : images.blocks)
+  {
+    CHECK(block.first_slot % alignment == 0);
+    CHECK(block.image_slot % alignment == 0);
+    for (int m = 0; m < block.orbitals.size(); m++)
+    {
+      const int iorb   = block.orbitals[m];
+      const int stored = images.slot_orbitals[block.first_slot + m];
+      REQUIRE(stored >= 0);
+      visits[iorb]++;
+      CHECK(bands[iorb] == bands[stored]);
+      // the generated twist is the image of the stored one and matches the input up to reciprocal lattice vectors
+      Frac generated = dot(transpose(Tensor<double, 3>(block.rot_inv)), twists[stored]);
+      if (block.conjugate)
+        generated = -1.0 * generated;
+      for (int i = 0; i < 3; i++)
+      {
+        CHECK(images.twists[iorb][i] == Approx(generated[i]));
+        const double diff = images.twists[iorb][i] - twists[iorb][i];
+        CHECK(diff == Approx(std::round(diff)));
+      }
+    }
+  }
+  for (int iorb = 0; iorb < twists.size(); iorb++)
+    CHECK(visits[iorb] == 1);
+}
+
+TEST_CASE("SplineSymmetryImages derivatives", "[wavefunction]")
+{
+  // a periodic function without symmetry and its derivatives in fractional coordinates
+  const Frac q(1.0, 2.0, -1.0);
+  const auto u = [&](const Frac& x) { return std::sin(2 * M_PI * dot(q, x)) * std::cos(2 * M_PI * x[2]); };
+
+  SplineSymmetryImages::Block block;
+  block.rot_inv = Tensor<int, 3>(0, 1, 0, -1, 1, 0, 0, 0, -1);
+  block.trans   = Frac(0.25, 0.5, 0.0);
+  const auto image = [&](const Frac& x) { return u(SplineSymmetryImages::mapPosition(block, x)); };
+
+  const Frac x(0.3, 0.7, 0.45);
+  const double h = 1e-4;
+  // derivatives of u at the mapped position by finite differences
+  const Frac y = SplineSymmetryImages::mapPosition(block, x);
+  TinyVector<double, 3> g;
+  Tensor<double, 3> hess;
+  for (int i = 0; i < 3; i++)
+  {
+    Frac dx(0.0);
+    dx[i] = h;
+    g[i]  = (u(y + dx) - u(y - dx)) / (2 * h);
+    for (int j = 0; j < 3; j++)
+    {
+      Frac dy(0.0);
+      dy[j]      = h;
+      hess(i, j) = (u(y + dx + dy) - u(y + dx - dy) - u(y - dx + dy) + u(y - dx - dy)) / (4 * h * h);
+    }
+  }
+
+  const auto image_g = imageGradient(block.rot_inv, g);
+  const auto image_h = imageHessian(block.rot_inv, hess);
+  for (int i = 0; i < 3; i++)
+  {
+    Frac dx(0.0);
+    dx[i] = h;
+    CHECK(image_g[i] == Approx((image(x + dx) - image(x - dx)) / (2 * h)).epsilon(1e-5));
+    for (int j = 0; j < 3; j++)
+    {
+      Frac dy(0.0);
+      dy[j] = h;
+      CHECK(image_h(i, j) ==
+            Approx((image(x + dx + dy) - image(x + dx - dy) - image(x - dx + dy) + image(x - dx - dy)) / (4 * h * h))
+                .epsilon(1e-4)
+                .margin(1e-4));
+    }
+  }
+
+  // third derivatives of the image from those of u, compared to differences of the image hessians
+  const auto hessian_at = [&](const Frac& z) {
+    Tensor<double, 3> res;
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++)
+      {
+        Frac dx(0.0), dy(0.0);
+        dx[i]     = h;
+        dy[j]     = h;
+        res(i, j) = (u(z + dx + dy) - u(z + dx - dy) - u(z - dx + dy) + u(z - dx - dy)) / (4 * h * h);
+      }
+    return res;
+  };
+  const double h3 = 1e-3;
+  TinyVector<Tensor<double, 3>, 3> gh;
+  for (int i = 0; i < 3; i++)
+  {
+    Frac dx(0.0);
+    dx[i] = h3;
+    gh[i] = (hessian_at(y + dx) - hessian_at(y - dx)) / (2 * h3);
+  }
+  const auto image_gh = imageGradHessian(block.rot_inv, gh);
+  for (int i = 0; i < 3; i++)
+  {
+    Frac dx(0.0);
+    dx[i] = h3;
+    const auto image_hessian_at = [&](const Frac& z) {
+      return imageHessian(block.rot_inv, hessian_at(SplineSymmetryImages::mapPosition(block, z)));
+    };
+    const Tensor<double, 3> expected = (image_hessian_at(x + dx) - image_hessian_at(x - dx)) / (2 * h3);
+    for (int j = 0; j < 9; j++)
+      CHECK(image_gh[i][j] == Approx(expected[j]).epsilon(1e-3).margin(1e-2));
+  }
+}
+
+#ifdef QMC_COMPLEX
+namespace testing
+{
+/** builds SplineC2C sets from orbitals given on the grid points, the full table or the one reduced by symmetry
+ *
+ * The spline of a signed permutation of the grid points, shifted by a multiple of the grid spacing, is the same
+ * permutation of the spline, so both tables hold the same orbitals up to round-off.
+ */
+class SplineC2CSymmetryTests
+{
+public:
+  using GridData = std::vector<double>;
+
+  template<typename ST>
+  static std::unique_ptr<SplineC2C<ST>> makeSplineSet(const ParticleSet::ParticleLayout& lattice,
+                                                      int mesh,
+                                                      const std::vector<TinyVector<double, 3>>& twists,
+                                                      std::vector<GridData>& data_r,
+                                                      std::vector<GridData>& data_i,
+                                                      std::shared_ptr<const SplineSymmetryImages> images)
+  {
+    const int num_orbs = twists.size();
+    auto spo           = std::make_unique<SplineC2C<ST>>(images ? "reduced" : "full");
+    spo->PrimLattice   = lattice;
+    spo->GGt           = dot(transpose(spo->PrimLattice.G), spo->PrimLattice.G);
+    spo->resizeStorage(num_orbs, num_orbs);
+    spo->setOrbitalSetSize(num_orbs);
+    if (images)
+      spo->set_symmetry_images(std::move(images));
+    for (int iorb = 0; iorb < num_orbs; iorb++)
+      spo->kPoints[iorb] = lattice.k_cart(-twists[iorb]);
+
+    Ugrid grid[3];
+    typename SplineC2C<ST>::BCType bc[3];
+    for (int i = 0; i < 3; i++)
+    {
+      grid[i].start = 0.0;
+      grid[i].end   = 1.0;
+      grid[i].num   = mesh;
+      bc[i].lCode = bc[i].rCode = PERIODIC;
+    }
+    spo->create_spline(grid, bc);
+    spo->flush_zero();
+
+    const TinyVector<double, 3> start(0.0), end(1.0);
+    const TinyVector<int, 3> mesh_size(mesh), half_g(0);
+    UBspline_3d_d* spline_r = einspline::create(spline_r, start, end, mesh_size, half_g);
+    UBspline_3d_d* spline_i = einspline::create(spline_i, start, end, mesh_size, half_g);
+    for (int slot = 0; slot < spo->BandIndexMap.size(); slot++)
+    {
+      const int iorb = spo->BandIndexMap[slot];
+      if (iorb < 0)
+        continue;
+      einspline::set(spline_r, data_r[iorb].data());
+      einspline::set(spline_i, data_i[iorb].data());
+      spo->set_spline(spline_r, spline_i, 0, slot, 0);
+    }
+    einspline::destroy(spline_r);
+    einspline::destroy(spline_i);
+    return spo;
+  }
+};
+} // namespace testing
+
+/** compare a SplineC2C set reduced by symmetry with the one storing all the orbitals
+ * @param ion_frac fractional coordinates of the ions of a simple cubic cell
+ * @param twists_one_band twists holding two bands each
+ * @param tol tolerance of the comparison
+ */
+template<typename ST>
+void testReducedSplineSet(const std::vector<Frac>& ion_frac,
+                          const std::vector<int>& ion_types,
+                          const std::vector<Frac>& twists_one_band,
+                          double tol)
+{
+  ParticleSet::ParticleLayout lattice;
+  lattice.R = {3.0, 0.0, 0.0, 0.0, 3.0, 0.0, 0.0, 0.0, 3.0};
+  lattice.reset();
+  const auto ops = findSpaceGroupOperations(lattice.R, ion_frac, ion_types);
+
+  std::vector<Frac> twists;
+  std::vector<int> bands;
+  for (int ib = 0; ib < 2; ib++)
+    for (const auto& twist : twists_one_band)
+    {
+      twists.push_back(twist);
+      bands.push_back(ib);
+    }
+  const int num_orbs = twists.size();
+  auto images = std::make_shared<SplineSymmetryImages>(findSymmetryImages(ops, twists, bands, getAlignment<ST>() / 2));
+  REQUIRE(images->num_stored_twists < twists_one_band.size());
+
+  // random periodic parts of the stored orbitals on the grid points
+  constexpr int mesh = 8;
+  const auto index   = [](int ix, int iy, int iz) {
+    return ((ix + mesh) % mesh * mesh + (iy + mesh) % mesh) * mesh + (iz + mesh) % mesh;
+  };
+  std::mt19937 rng(17);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  using GridData = testing::SplineC2CSymmetryTests::GridData;
+  std::vector<GridData> data_r(num_orbs, GridData(mesh * mesh * mesh)), data_i(data_r);
+  for (int iorb : images->slot_orbitals)
+    if (iorb >= 0)
+      for (int ig = 0; ig < mesh * mesh * mesh; ig++)
+      {
+        data_r[iorb][ig] = dist(rng);
+        data_i[iorb][ig] = dist(rng);
+      }
+
+  // the image orbitals u(S^{-1}(x - f)) on the grid points, f is a multiple of the grid spacing
+  for (const auto& block : images->blocks)
+  {
+    TinyVector<int, 3> shift;
+    for (int i = 0; i < 3; i++)
+    {
+      shift[i] = std::lround(block.trans[i] * mesh);
+      REQUIRE(shift[i] == Approx(block.trans[i] * mesh));
+    }
+    for (int m = 0; m < block.orbitals.size(); m++)
+    {
+      const int iorb   = block.orbitals[m];
+      const int stored = images->slot_orbitals[block.first_slot + m];
+      if (iorb == stored)
+        continue;
+      for (int ix = 0; ix < mesh; ix++)
+        for (int iy = 0; iy < mesh; iy++)
+          for (int iz = 0; iz < mesh; iz++)
+          {
+            const TinyVector<int, 3> g(ix - shift[0], iy - shift[1], iz - shift[2]);
+            const TinyVector<int, 3> mapped(dot(block.rot_inv, g));
+            const int ig        = index(ix, iy, iz);
+            const int ig_mapped = index(mapped[0] % mesh, mapped[1] % mesh, mapped[2] % mesh);
+            data_r[iorb][ig]    = data_r[stored][ig_mapped];
+            data_i[iorb][ig]    = block.conjugate ? -data_i[stored][ig_mapped] : data_i[stored][ig_mapped];
+          }
+    }
+  }
+
+  using testing::SplineC2CSymmetryTests;
+  auto full    = SplineC2CSymmetryTests::makeSplineSet<ST>(lattice, mesh, images->twists, data_r, data_i, nullptr);
+  auto reduced = SplineC2CSymmetryTests::makeSplineSet<ST>(lattice, mesh, images->twists, data_r, data_i, images);
+  CHECK(!reduced->isRotationSupported());
+
+  const SimulationCell simulation_cell(lattice);
+  ParticleSet elec(simulation_cell);
+  elec.create({3});
+  elec.R[0] = {0.1, 0.2, 0.3};
+  elec.R[1] = {2.9, 1.3, -0.7};
+  elec.R[2] = {4.1, 2.2, 1.55};
+  elec.update();
+
+  using ValueVector = SPOSet::ValueVector;
+  using GradVector  = SPOSet::GradVector;
+  using HessVector  = SPOSet::HessVector;
+  using GGGVector   = SPOSet::GGGVector;
+  const auto check_values = [&](const ValueVector& ref, const ValueVector& test) {
+    for (int iorb = 0; iorb < num_orbs; iorb++)
+    {
+      CHECK(std::real(test[iorb]) == Approx(std::real(ref[iorb])).epsilon(tol).margin(tol));
+      CHECK(std::imag(test[iorb]) == Approx(std::imag(ref[iorb])).epsilon(tol).margin(tol));
+    }
+  };
+  const auto check = [&](const auto& ref, const auto& test) {
+    CHECK(std::real(test) == Approx(std::real(ref)).epsilon(tol).margin(tol));
+    CHECK(std::imag(test) == Approx(std::imag(ref)).epsilon(tol).margin(tol));
+  };
+
+  for (int iat = 0; iat < elec.getTotalNum(); iat++)
+  {
+    ValueVector psi_ref(num_orbs), psi(num_orbs), d2psi_ref(num_orbs), d2psi(num_orbs);
+    GradVector dpsi_ref(num_orbs), dpsi(num_orbs);
+    HessVector hess_ref(num_orbs), hess(num_orbs);
+    GGGVector ggg_ref(num_orbs), ggg(num_orbs);
+
+    full->evaluateValue(elec, iat, psi_ref);
+    reduced->evaluateValue(elec, iat, psi);
+    check_values(psi_ref, psi);
+
+    full->evaluateVGL(elec, iat, psi_ref, dpsi_ref, d2psi_ref);
+    reduced->evaluateVGL(elec, iat, psi, dpsi, d2psi);
+    check_values(psi_ref, psi);
+    check_values(d2psi_ref, d2psi);
+    for (int iorb = 0; iorb < num_orbs; iorb++)
+      for (int i = 0; i < 3; i++)
+        check(dpsi_ref[iorb][i], dpsi[iorb][i]);
+
+    full->evaluateVGHGH(elec, iat, psi_ref, dpsi_ref, hess_ref, ggg_ref);
+    reduced->evaluateVGHGH(elec, iat, psi, dpsi, hess, ggg);
+    check_values(psi_ref, psi);
+    for (int iorb = 0; iorb < num_orbs; iorb++)
+      for (int i = 0; i < 3; i++)
+      {
+        check(dpsi_ref[iorb][i], dpsi[iorb][i]);
+        for (int j = 0; j < 3; j++)
+        {
+          check(hess_ref[iorb](i, j), hess[iorb](i, j));
+          for (int k = 0; k < 3; k++)
+            check(ggg_ref[iorb][i](j, k), ggg[iorb][i](j, k));
+        }
+      }
+
+    full->evaluateVGH(elec, iat, psi_ref, dpsi_ref, hess_ref);
+    reduced->evaluateVGH(elec, iat, psi, dpsi, hess);
+    check_values(psi_ref, psi);
+    for (int iorb = 0; iorb < num_orbs; iorb++)
+      for (int i = 0; i < 3; i++)
+      {
+        check(dpsi_ref[iorb][i], dpsi[iorb][i]);
+        for (int j = 0; j < 3; j++)
+          check(hess_ref[iorb](i, j), hess[iorb](i, j));
+      }
+  }
+
+  // ratios on several quadrature points, the image blocks are shared by the threads at each point
+  const std::vector<SPOSet::PosType> deltas{{0.1, 0.2, 0.3}, {1.4, -0.6, 0.2}, {-2.1, 0.5, 3.7}, {0.0, 0.0, -1.9}};
+  VirtualParticleSet vp(elec, deltas.size());
+  vp.makeMoves(elec, 1, deltas);
+  ValueVector psiinv(num_orbs), psi(num_orbs);
+  for (int iorb = 0; iorb < num_orbs; iorb++)
+    psiinv[iorb] = SPOSet::ValueType(dist(rng), dist(rng));
+  std::vector<SPOSet::ValueType> ratios_ref(deltas.size()), ratios(deltas.size());
+  full->evaluateDetRatios(vp, psi, psiinv, ratios_ref);
+  reduced->evaluateDetRatios(vp, psi, psiinv, ratios);
+  for (int ip = 0; ip < deltas.size(); ip++)
+    check(ratios_ref[ip], ratios[ip]);
+}
+
+TEST_CASE("SplineC2C reduced by symmetry", "[wavefunction]")
+{
+  // bcc lattice in the cubic cell, half of the operations come with the translation (1/2, 1/2, 1/2)
+  const std::vector<Frac> bcc{Frac(0.0), Frac(0.5)};
+  const std::vector<Frac> half_twists{Frac(0.0), Frac(0.5, 0.0, 0.0), Frac(0.0, 0.5, 0.0), Frac(0.0, 0.0, 0.5),
+                                      Frac(0.5, 0.5, 0.0), Frac(0.0, 0.5, 0.5), Frac(0.5, 0.5, 0.5)};
+  // two species along the body diagonal, no inversion, -k is reached by time reversal only
+  const std::vector<Frac> c3v{Frac(0.0), Frac(0.25)};
+  const std::vector<Frac> quarter_twists{Frac(0.25, 0.0, 0.0), Frac(0.0, 0.25, 0.0), Frac(0.75, 0.0, 0.0),
+                                         Frac(0.0, 0.0, 0.75)};
+
+  testReducedSplineSet<double>(bcc, {0, 0}, half_twists, 1e-10);
+  testReducedSplineSet<double>(c3v, {0, 1}, quarter_twists, 1e-10);
+  testReducedSplineSet<float>(bcc, {0, 0}, half_twists, 1e-4);
+  testReducedSplineSet<float>(c3v, {0, 1}, quarter_twists, 1e-4);
+}
+#endif
+
+} // namespace qmcplusplus
@@ -402,8 +402,9 @@ inline bool h5d_append(hid_t grp,
                        hsize_t ndims,
                        const hsize_t* const dims,
                        const T* const first,
-                       hsize_t chunk_size = 1,
-                       hid_t xfer_plist   = H5P_DEFAULT)
+                       hsize_t chunk_size     = 1,
+                       hid_t xfer_plist       = H5P_DEFAULT,
+                       unsigned deflate_level = 0)
 {
   //app_log()<<omp_get_thread_num()<<"  h5d_append  group = "<<grp<<"  name = "<<aname.c_str()<< std::endl;
   if (grp < 0)
@@ -434,6 +435,9 @@ inline bool h5d_append(hid_t grp,
     hid_t sl = H5Pset_layout(p, H5D_CHUNKED);
     // set chunk size
     hid_t cs = H5Pset_chunk(p, ndims, chunk_dims.data());
+    // compress the chunks, only when the library can read them back
+    if (deflate_level > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+      H5Pset_deflate(p, deflate_level);
     // create the dataset
     dataset = H5Dcreate(grp, aname.c_str(), h5d_type_id, dataspace, H5P_DEFAULT, p, H5P_DEFAULT);
     // create memory dataspace, size of current buffer
@@ -0,0 +1,144 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/**@file MultiBsplineCompressed.hpp
+ *
+ * define classes MultiBsplineCompressed
+ * The evaluation functions are defined in MultiBsplineCompressedEval.hpp and used via MultiBsplineEval.hpp
+ */
+#ifndef QMCPLUSPLUS_MULTIEINSPLINE_COMPRESSED_HPP
+#define QMCPLUSPLUS_MULTIEINSPLINE_COMPRESSED_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "config.h"
+#include "spline2/bspline_traits.hpp"
+#include "CPU/SIMD/aligned_allocator.hpp"
+
+namespace qmcplusplus
+{
+/** einspline-like 3D multi spline object with coefficients stored as 16 bit integers
+ * @tparam T the precision of the scale factors and of the evaluation
+ *
+ * The coefficient of spline n at a grid point is coefs[...+n] * scale[n].
+ * Grid, strides and padding are identical to multi_UBspline_3d_(s,d) so that
+ * the evaluation kernels only differ in widening the coefficients and applying the scale at the end.
+ */
+template<typename T>
+struct multi_UBspline_3d_i16
+{
+  const int16_t* restrict coefs;
+  const T* restrict scale;
+  intptr_t x_stride, y_stride, z_stride;
+  Ugrid x_grid, y_grid, z_grid;
+  int num_splines;
+  size_t coefs_size;
+};
+
+/// errors of the values of a compressed table with respect to its source
+struct SplineCompressionError
+{
+  /// largest absolute difference
+  double max_abs_error = 0;
+  /// root mean square difference
+  double rms_error = 0;
+  /// largest absolute value of the source splines, the scale of the errors
+  double max_abs_value = 0;
+};
+
+/** container class holding the compressed copy of a MultiBspline table
+ * @tparam T the precision of the source splines
+ *
+ * Each spline is scaled by its largest coefficient magnitude and rounded to 16 bit integers.
+ * The absolute coefficient error of spline n is bounded by scale[n]/2, relative 1.5e-5 of its largest coefficient,
+ * while the table takes half of the float or a quarter of the double storage.
+ */
+template<typename T>
+class MultiBsplineCompressed
+{
+public:
+  using SplineType       = multi_UBspline_3d_i16<T>;
+  using SourceSplineType = typename bspline_traits<T, 3>::SplineType;
+  using coef_type        = int16_t;
+
+  /// compress the coefficients of source
+  MultiBsplineCompressed(const SourceSplineType& source);
+  MultiBsplineCompressed(const MultiBsplineCompressed& in) = delete;
+  MultiBsplineCompressed& operator=(const MultiBsplineCompressed& in) = delete;
+
+  const SplineType* getSplinePtr() const { return &spline_m; }
+
+  int num_splines() const { return spline_m.num_splines; }
+
+  size_t sizeInByte() const { return coefs_.size() * sizeof(coef_type) + scale_.size() * sizeof(T); }
+
+private:
+  ///einspline-like view of coefs_ and scale_
+  SplineType spline_m;
+  ///compressed coefficients
+  std::vector<coef_type, aligned_allocator<coef_type>> coefs_;
+  ///per spline scale factors
+  std::vector<T, aligned_allocator<T>> scale_;
+};
+
+template<typename T>
+MultiBsplineCompressed<T>::MultiBsplineCompressed(const SourceSplineType& source)
+    : coefs_(source.coefs_size), scale_(source.z_stride, T(0))
+{
+  constexpr T int_max       = std::numeric_limits<coef_type>::max();
+  const intptr_t nsplines   = source.z_stride;
+  const intptr_t num_points = source.coefs_size / nsplines;
+  const T* restrict src     = source.coefs;
+
+  for (intptr_t ip = 0; ip < num_points; ip++)
+  {
+    const T* restrict row = src + ip * nsplines;
+    T* restrict maxabs    = scale_.data();
+#pragma omp simd
+    for (int n = 0; n < nsplines; n++)
+      maxabs[n] = std::max(maxabs[n], std::abs(row[n]));
+  }
+
+  std::vector<T> inv_scale(nsplines);
+  for (int n = 0; n < nsplines; n++)
+  {
+    scale_[n]    = scale_[n] / int_max;
+    inv_scale[n] = scale_[n] > T(0) ? T(1) / scale_[n] : T(0);
+  }
+
+#pragma omp parallel for
+  for (intptr_t ip = 0; ip < num_points; ip++)
+  {
+    const T* restrict row     = src + ip * nsplines;
+    coef_type* restrict qrow  = coefs_.data() + ip * nsplines;
+    const T* restrict inv_ptr = inv_scale.data();
+    for (int n = 0; n < nsplines; n++)
+      qrow[n] = static_cast<coef_type>(std::lround(std::clamp(row[n] * inv_ptr[n], -int_max, int_max)));
+  }
+
+  spline_m.coefs       = coefs_.data();
+  spline_m.scale       = scale_.data();
+  spline_m.x_stride    = source.x_stride;
+  spline_m.y_stride    = source.y_stride;
+  spline_m.z_stride    = source.z_stride;
+  spline_m.x_grid      = source.x_grid;
+  spline_m.y_grid      = source.y_grid;
+  spline_m.z_grid      = source.z_grid;
+  spline_m.num_splines = source.num_splines;
+  spline_m.coefs_size  = source.coefs_size;
+}
+
+} // namespace qmcplusplus
+
+#endif
@@ -0,0 +1,412 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2026 QMCPACK developers.
+//
+// File developed by: agent, agent@local
+//
+// File created by: agent, agent@local
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/**@file MultiBsplineCompressedEval.hpp
+ *
+ * evaluate_v_impl, evaluate_vgh_impl and evaluate_vghgh_impl for multi_UBspline_3d_i16.
+ * The loops follow MultiBsplineValue.hpp, MultiBsplineVGLH.hpp and MultiBsplineVGHGH.hpp.
+ * The 16 bit coefficients are widened to T in registers and the per spline scale
+ * is folded into the final loop over the results.
+ * The offset first is only aligned for T, so the coefficient streams are not declared aligned.
+ */
+#ifndef SPLINE2_MULTIEINSPLINE_COMPRESSED_EVAL_HPP
+#define SPLINE2_MULTIEINSPLINE_COMPRESSED_EVAL_HPP
+
+#include <cmath>
+#include "spline2/MultiBsplineCompressed.hpp"
+#include "spline2/MultiBsplineEval_helper.hpp"
+
+namespace spline2
+{
+template<typename T>
+inline void evaluate_v_impl(const qmcplusplus::multi_UBspline_3d_i16<T>* restrict spline_m,
+                            T x,
+                            T y,
+                            T z,
+                            T* restrict vals,
+                            int first,
+                            int last)
+{
+  int ix, iy, iz;
+  T a[4], b[4], c[4];
+
+  computeLocationAndFractional(spline_m, x, y, z, ix, iy, iz, a, b, c);
+
+  const intptr_t xs = spline_m->x_stride;
+  const intptr_t ys = spline_m->y_stride;
+  const intptr_t zs = spline_m->z_stride;
+
+  constexpr T zero(0);
+  const int num_splines = last - first;
+  std::fill(vals, vals + num_splines, zero);
+
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+    {
+      const T pre00                    = a[i] * b[j];
+      const int16_t* restrict coefs    = spline_m->coefs + ((ix + i) * xs + (iy + j) * ys + iz * zs) + first;
+      const int16_t* restrict coefszs  = coefs + zs;
+      const int16_t* restrict coefs2zs = coefs + 2 * zs;
+      const int16_t* restrict coefs3zs = coefs + 3 * zs;
+#pragma omp simd aligned(vals: QMC_SIMD_ALIGNMENT)
+      for (int n = 0; n < num_splines; n++)
+        vals[n] += pre00 * (c[0] * coefs[n] + c[1] * coefszs[n] + c[2] * coefs2zs[n] + c[3] * coefs3zs[n]);
+    }
+
+  const T* restrict scale = spline_m->scale + first;
+#pragma omp simd aligned(vals, scale: QMC_SIMD_ALIGNMENT)
+  for (int n = 0; n < num_splines; n++)
+    vals[n] *= scale[n];
+}
+
+template<typename T>
+inline void evaluate_vgh_impl(const qmcplusplus::multi_UBspline_3d_i16<T>* restrict spline_m,
+                              T x,
+                              T y,
+                              T z,
+                              T* restrict vals,
+                              T* restrict grads,
+                              T* restrict hess,
+                              size_t out_offset,
+                              int first,
+                              int last)
+{
+  int ix, iy, iz;
+  T a[4], b[4], c[4], da[4], db[4], dc[4], d2a[4], d2b[4], d2c[4];
+
+  computeLocationAndFractional(spline_m, x, y, z, ix, iy, iz, a, b, c, da, db, dc, d2a, d2b, d2c);
+
+  const intptr_t xs = spline_m->x_stride;
+  const intptr_t ys = spline_m->y_stride;
+  const intptr_t zs = spline_m->z_stride;
+
+  const int num_splines = last - first;
+
+  T* restrict gx = grads;
+  T* restrict gy = grads + out_offset;
+  T* restrict gz = grads + 2 * out_offset;
+
+  T* restrict hxx = hess;
+  T* restrict hxy = hess + out_offset;
+  T* restrict hxz = hess + 2 * out_offset;
+  T* restrict hyy = hess + 3 * out_offset;
+  T* restrict hyz = hess + 4 * out_offset;
+  T* restrict hzz = hess + 5 * out_offset;
+
+  std::fill(vals, vals + num_splines, T());
+  std::fill(gx, gx + num_splines, T());
+  std::fill(gy, gy + num_splines, T());
+  std::fill(gz, gz + num_splines, T());
+  std::fill(hxx, hxx + num_splines, T());
+  std::fill(hxy, hxy + num_splines, T());
+  std::fill(hxz, hxz + num_splines, T());
+  std::fill(hyy, hyy + num_splines, T());
+  std::fill(hyz, hyz + num_splines, T());
+  std::fill(hzz, hzz + num_splines, T());
+
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+    {
+      const int16_t* restrict coefs    = spline_m->coefs + ((ix + i) * xs + (iy + j) * ys + iz * zs) + first;
+      const int16_t* restrict coefszs  = coefs + zs;
+      const int16_t* restrict coefs2zs = coefs + 2 * zs;
+      const int16_t* restrict coefs3zs = coefs + 3 * zs;
+
+      const T pre20 = d2a[i] * b[j];
+      const T pre10 = da[i] * b[j];
+      const T pre00 = a[i] * b[j];
+      const T pre11 = da[i] * db[j];
+      const T pre01 = a[i] * db[j];
+      const T pre02 = a[i] * d2b[j];
+
+#pragma omp simd aligned(gx, gy, gz, hxx, hxy, hxz, hyy, hyz, hzz, vals: QMC_SIMD_ALIGNMENT)
+      for (int n = 0; n < num_splines; n++)
+      {
+        const T coefsv    = coefs[n];
+        const T coefsvzs  = coefszs[n];
+        const T coefsv2zs = coefs2zs[n];
+        const T coefsv3zs = coefs3zs[n];
+
+        T sum0 = c[0] * coefsv + c[1] * coefsvzs + c[2] * coefsv2zs + c[3] * coefsv3zs;
+        T sum1 = dc[0] * coefsv + dc[1] * coefsvzs + dc[2] * coefsv2zs + dc[3] * coefsv3zs;
+        T sum2 = d2c[0] * coefsv + d2c[1] * coefsvzs + d2c[2] * coefsv2zs + d2c[3] * coefsv3zs;
+
+        hxx[n] += pre20 * sum0;
+        hxy[n] += pre11 * sum0;
+        hxz[n] += pre10 * sum1;
+        hyy[n] += pre02 * sum0;
+        hyz[n] += pre01 * sum1;
+        hzz[n] += pre00 * sum2;
+        gx[n] += pre10 * sum0;
+        gy[n] += pre01 * sum0;
+        gz[n] += pre00 * sum1;
+        vals[n] += pre00 * sum0;
+      }
+    }
+
+  const T dxInv = spline_m->x_grid.delta_inv;
+  const T dyInv = spline_m->y_grid.delta_inv;
+  const T dzInv = spline_m->z_grid.delta_inv;
+  const T dxx   = dxInv * dxInv;
+  const T dyy   = dyInv * dyInv;
+  const T dzz   = dzInv * dzInv;
+  const T dxy   = dxInv * dyInv;
+  const T dxz   = dxInv * dzInv;
+  const T dyz   = dyInv * dzInv;
+
+  const T* restrict scale = spline_m->scale + first;
+#pragma omp simd aligned(gx, gy, gz, hxx, hxy, hxz, hyy, hyz, hzz, vals, scale: QMC_SIMD_ALIGNMENT)
+  for (int n = 0; n < num_splines; n++)
+  {
+    const T s = scale[n];
+    vals[n] *= s;
+    gx[n] *= dxInv * s;
+    gy[n] *= dyInv * s;
+    gz[n] *= dzInv * s;
+    hxx[n] *= dxx * s;
+    hyy[n] *= dyy * s;
+    hzz[n] *= dzz * s;
+    hxy[n] *= dxy * s;
+    hxz[n] *= dxz * s;
+    hyz[n] *= dyz * s;
+  }
+}
+
+template<typename T>
+inline void evaluate_vghgh_impl(const qmcplusplus::multi_UBspline_3d_i16<T>* restrict spline_m,
+                                T x,
+                                T y,
+                                T z,
+                                T* restrict vals,
+                                T* restrict grads,
+                                T* restrict hess,
+                                T* restrict ghess,
+                                size_t out_offset,
+                                int first,
+                                int last)
+{
+  int ix, iy, iz;
+  T tx, ty, tz;
+  T a[4], b[4], c[4];
+  T da[4], db[4], dc[4];
+  T d2a[4], d2b[4], d2c[4];
+  T d3a[4], d3b[4], d3c[4];
+
+  x -= spline_m->x_grid.start;
+  y -= spline_m->y_grid.start;
+  z -= spline_m->z_grid.start;
+  qmcplusplus::getSplineBound(x * spline_m->x_grid.delta_inv, spline_m->x_grid.num - 1, ix, tx);
+  qmcplusplus::getSplineBound(y * spline_m->y_grid.delta_inv, spline_m->y_grid.num - 1, iy, ty);
+  qmcplusplus::getSplineBound(z * spline_m->z_grid.delta_inv, spline_m->z_grid.num - 1, iz, tz);
+
+  MultiBsplineData<T>::compute_prefactors(a, da, d2a, d3a, tx);
+  MultiBsplineData<T>::compute_prefactors(b, db, d2b, d3b, ty);
+  MultiBsplineData<T>::compute_prefactors(c, dc, d2c, d3c, tz);
+
+  const intptr_t xs = spline_m->x_stride;
+  const intptr_t ys = spline_m->y_stride;
+  const intptr_t zs = spline_m->z_stride;
+
+  const int num_splines = last - first;
+
+  T* restrict gx = grads;
+  T* restrict gy = grads + out_offset;
+  T* restrict gz = grads + 2 * out_offset;
+
+  T* restrict hxx = hess;
+  T* restrict hxy = hess + out_offset;
+  T* restrict hxz = hess + 2 * out_offset;
+  T* restrict hyy = hess + 3 * out_offset;
+  T* restrict hyz = hess + 4 * out_offset;
+  T* restrict hzz = hess + 5 * out_offset;
+
+  T* restrict gh_xxx = ghess;
+  T* restrict gh_xxy = ghess + out_offset;
+  T* restrict gh_xxz = ghess + 2 * out_offset;
+  T* restrict gh_xyy = ghess + 3 * out_offset;
+  T* restrict gh_xyz = ghess + 4 * out_offset;
+  T* restrict gh_xzz = ghess + 5 * out_offset;
+  T* restrict gh_yyy = ghess + 6 * out_offset;
+  T* restrict gh_yyz = ghess + 7 * out_offset;
+  T* restrict gh_yzz = ghess + 8 * out_offset;
+  T* restrict gh_zzz = ghess + 9 * out_offset;
+
+  std::fill(vals, vals + num_splines, T());
+  std::fill(gx, gx + num_splines, T());
+  std::fill(gy, gy + num_splines, T());
+  std::fill(gz, gz + num_splines, T());
+  std::fill(hxx, hxx + num_splines, T());
+  std::fill(hxy, hxy + num_splines, T());
+  std::fill(hxz, hxz + num_splines, T());
+  std::fill(hyy, hyy + num_splines, T());
+  std::fill(hyz, hyz + num_splines, T());
+  std::fill(hzz, hzz + num_splines, T());
+
+  std::fill(gh_xxx, gh_xxx + num_splines, T());
+  std::fill(gh_xxy, gh_xxy + num_splines, T());
+  std::fill(gh_xxz, gh_xxz + num_splines, T());
+  std::fill(gh_xyy, gh_xyy + num_splines, T());
+  std::fill(gh_xyz, gh_xyz + num_splines, T());
+  std::fill(gh_xzz, gh_xzz + num_splines, T());
+  std::fill(gh_yyy, gh_yyy + num_splines, T());
+  std::fill(gh_yyz, gh_yyz + num_splines, T());
+  std::fill(gh_yzz, gh_yzz + num_splines, T());
+  std::fill(gh_zzz, gh_zzz + num_splines, T());
+
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+    {
+      const int16_t* restrict coefs    = spline_m->coefs + ((ix + i) * xs + (iy + j) * ys + iz * zs) + first;
+      const int16_t* restrict coefszs  = coefs + zs;
+      const int16_t* restrict coefs2zs = coefs + 2 * zs;
+      const int16_t* restrict coefs3zs = coefs + 3 * zs;
+
+      const T pre20 = d2a[i] * b[j];
+      const T pre10 = da[i] * b[j];
+      const T pre00 = a[i] * b[j];
+      const T pre11 = da[i] * db[j];
+      const T pre01 = a[i] * db[j];
+      const T pre02 = a[i] * d2b[j];
+
+      const T pre30 = d3a[i] * b[j];
+      const T pre21 = d2a[i] * db[j];
+      const T pre12 = da[i] * d2b[j];
+      const T pre03 = a[i] * d3b[j];
+
+#pragma omp simd aligned(gx, gy, gz, hxx, hxy, hxz, hyy, hyz, hzz, gh_xxx, gh_xxy, gh_xxz, gh_xyy, gh_xyz, gh_xzz, \
+                             gh_yyy, gh_yyz, gh_yzz, gh_zzz, vals : QMC_SIMD_ALIGNMENT)
+      for (int n = 0; n < num_splines; n++)
+      {
+        const T coefsv    = coefs[n];
+        const T coefsvzs  = coefszs[n];
+        const T coefsv2zs = coefs2zs[n];
+        const T coefsv3zs = coefs3zs[n];
+
+        T sum0 = c[0] * coefsv + c[1] * coefsvzs + c[2] * coefsv2zs + c[3] * coefsv3zs;
+        T sum1 = dc[0] * coefsv + dc[1] * coefsvzs + dc[2] * coefsv2zs + dc[3] * coefsv3zs;
+        T sum2 = d2c[0] * coefsv + d2c[1] * coefsvzs + d2c[2] * coefsv2zs + d2c[3] * coefsv3zs;
+        T sum3 = d3c[0] * coefsv + d3c[1] * coefsvzs + d3c[2] * coefsv2zs + d3c[3] * coefsv3zs;
+
+        gh_xxx[n] += pre30 * sum0;
+        gh_xxy[n] += pre21 * sum0;
+        gh_xxz[n] += pre20 * sum1;
+        gh_xyy[n] += pre12 * sum0;
+        gh_xyz[n] += pre11 * sum1;
+        gh_xzz[n] += pre10 * sum2;
+        gh_yyy[n] += pre03 * sum0;
+        gh_yyz[n] += pre02 * sum1;
+        gh_yzz[n] += pre01 * sum2;
+        gh_zzz[n] += pre00 * sum3;
+
+        hxx[n] += pre20 * sum0;
+        hxy[n] += pre11 * sum0;
+        hxz[n] += pre10 * sum1;
+        hyy[n] += pre02 * sum0;
+        hyz[n] += pre01 * sum1;
+        hzz[n] += pre00 * sum2;
+        gx[n] += pre10 * sum0;
+        gy[n] += pre01 * sum0;
+        gz[n] += pre00 * sum1;
+        vals[n] += pre00 * sum0;
+      }
+    }
+
+  const T dxInv = spline_m->x_grid.delta_inv;
+  const T dyInv = spline_m->y_grid.delta_inv;
+  const T dzInv = spline_m->z_grid.delta_inv;
+  const T dxx   = dxInv * dxInv;
+  const T dyy   = dyInv * dyInv;
+  const T dzz   = dzInv * dzInv;
+  const T dxy   = dxInv * dyInv;
+  const T dxz   = dxInv * dzInv;
+  const T dyz   = dyInv * dzInv;
+
+  const T dxxx = dxInv * dxInv * dxInv;
+  const T dxxy = dxInv * dxInv * dyInv;
+  const T dxxz = dxInv * dxInv * dzInv;
+  const T dxyy = dxInv * dyInv * dyInv;
+  const T dxyz = dxInv * dyInv * dzInv;
+  const T dxzz = dxInv * dzInv * dzInv;
+  const T dyyy = dyInv * dyInv * dyInv;
+  const T dyyz = dyInv * dyInv * dzInv;
+  const T dyzz = dyInv * dzInv * dzInv;
+  const T dzzz = dzInv * dzInv * dzInv;
+
+  const T* restrict scale = spline_m->scale + first;
+#pragma omp simd aligned(gx, gy, gz, hxx, hxy, hxz, hyy, hyz, hzz, gh_xxx, gh_xxy, gh_xxz, gh_xyy, gh_xyz, gh_xzz, \
+                             gh_yyy, gh_yyz, gh_yzz, gh_zzz, vals, scale : QMC_SIMD_ALIGNMENT)
+  for (int n = 0; n < num_splines; n++)
+  {
+    const T s = scale[n];
+    vals[n] *= s;
+    gx[n] *= dxInv * s;
+    gy[n] *= dyInv * s;
+    gz[n] *= dzInv * s;
+    hxx[n] *= dxx * s;
+    hyy[n] *= dyy * s;
+    hzz[n] *= dzz * s;
+    hxy[n] *= dxy * s;
+    hxz[n] *= dxz * s;
+    hyz[n] *= dyz * s;
+
+    gh_xxx[n] *= dxxx * s;
+    gh_xxy[n] *= dxxy * s;
+    gh_xxz[n] *= dxxz * s;
+    gh_xyy[n] *= dxyy * s;
+    gh_xyz[n] *= dxyz * s;
+    gh_xzz[n] *= dxzz * s;
+    gh_yyy[n] *= dyyy * s;
+    gh_yyz[n] *= dyyz * s;
+    gh_yzz[n] *= dyzz * s;
+    gh_zzz[n] *= dzzz * s;
+  }
+}
+
+/** accuracy of a compressed table with respect to its source
+ * The values of all the splines are compared at num_points points spread over the grid.
+ */
+template<typename SPLINET, typename T>
+inline qmcplusplus::SplineCompressionError compressionError(const SPLINET* source,
+                                                              const qmcplusplus::multi_UBspline_3d_i16<T>* compressed,
+                                                              int num_points)
+{
+  const int num_splines = source->num_splines;
+  std::vector<T, qmcplusplus::aligned_allocator<T>> v_source(num_splines), v_compressed(num_splines);
+  // fractional parts of multiples of the generalized golden ratio cover the cell evenly
+  const double alpha[3] = {0.8191725133961645, 0.6710436067037893, 0.5497004779019703};
+  qmcplusplus::SplineCompressionError error;
+  double sum2 = 0;
+  for (int ip = 0; ip < num_points; ip++)
+  {
+    T r[3];
+    const Ugrid* grids[3] = {&source->x_grid, &source->y_grid, &source->z_grid};
+    for (int idim = 0; idim < 3; idim++)
+    {
+      const double frac = std::fmod(0.5 + alpha[idim] * (ip + 1), 1.0);
+      r[idim]           = grids[idim]->start + frac * (grids[idim]->end - grids[idim]->start);
+    }
+    evaluate_v_impl(source, r[0], r[1], r[2], v_source.data(), 0, num_splines);
+    evaluate_v_impl(compressed, r[0], r[1], r[2], v_compressed.data(), 0, num_splines);
+    for (int n = 0; n < num_splines; n++)
+    {
+      const double diff   = std::abs(v_source[n] - v_compressed[n]);
+      error.max_abs_error = std::max(error.max_abs_error, diff);
+      error.max_abs_value = std::max(error.max_abs_value, double(std::abs(v_source[n])));
+      sum2 += diff * diff;
+    }
+  }
+  if (num_points > 0 && num_splines > 0)
+    error.rms_error = std::sqrt(sum2 / (double(num_points) * num_splines));
+  return error;
+}
+
+} // namespace spline2
+#endif
@@ -25,6 +25,7 @@
 #define SPLINE2_MULTIEINSPLINE_EVAL_HPP
 
 #include <algorithm>
+#include <type_traits>
 #include "spline2/bspline_traits.hpp"
 #include "spline2/MultiBsplineEval_helper.hpp"
 
@@ -36,6 +37,9 @@
 ///include evaluate_vghgh_impl
 #include "spline2/MultiBsplineVGHGH.hpp"
 
+///include evaluate_v_impl, evaluate_vgh_impl and evaluate_vghgh_impl for compressed coefficients
+#include "spline2/MultiBsplineCompressedEval.hpp"
+
 namespace spline2
 {
 /// evaluate values optionally in the range [first,last)
@@ -100,5 +104,77 @@ inline void evaluate3d_vghgh(const SPLINET& spline,
                       ghess.data() + first, psi.size(), first, last);
 }
 
+/** evaluate values at multiple positions in the range [first,last)
+ * All the positions are evaluated on the same range of splines before the caller moves to the next range,
+ * so the result block and the coefficients shared by nearby positions stay in cache.
+ * @param rs positions in the lattice unit
+ * @param psi scratch result vector, overwritten for every position
+ * @param consume called as consume(ip) after the evaluation at position ip
+ */
+template<typename SPLINET, typename PTV, typename VT, typename F>
+inline void evaluate3d_multi(const SPLINET& spline, const PTV& rs, VT& psi, int first, int last, F&& consume)
+{
+  for (int ip = 0; ip < rs.size(); ip++)
+  {
+    evaluate_v_impl(spline, rs[ip][0], rs[ip][1], rs[ip][2], psi.data() + first, first, last);
+    consume(ip);
+  }
+}
+
+/// evaluate values, gradients, hessians at multiple positions in the range [first,last), see evaluate3d_multi
+template<typename SPLINET, typename PTV, typename VT, typename GT, typename HT, typename F>
+inline void evaluate3d_vgh_multi(const SPLINET& spline,
+                                 const PTV& rs,
+                                 VT& psi,
+                                 GT& grad,
+                                 HT& hess,
+                                 int first,
+                                 int last,
+                                 F&& consume)
+{
+  for (int ip = 0; ip < rs.size(); ip++)
+  {
+    evaluate_vgh_impl(spline, rs[ip][0], rs[ip][1], rs[ip][2], psi.data() + first, grad.data() + first,
+                      hess.data() + first, psi.size(), first, last);
+    consume(ip);
+  }
+}
+
+/** number of splines evaluated at once by evaluate3d_contract
+ * A multiple of the SIMD alignment, the tile of values fits in the L1 cache.
+ */
+constexpr int contract_tile_size = 64;
+
+/** evaluate values in the range [first,last) and reduce them on the fly without storing them
+ * The values are evaluated tile by tile into a buffer on the stack and handed to contract(vals, tile_first, tile_last)
+ * with vals[n - tile_first] the value of spline n. Reductions like determinant ratios are then computed while the
+ * values are in the L1 cache and the value vector of the whole range is never written.
+ * @param first must be a multiple of the SIMD alignment
+ */
+template<typename SPLINET, typename PT, typename F>
+inline void evaluate3d_contract(const SPLINET& spline, const PT& r, int first, int last, F&& contract)
+{
+  using T = std::decay_t<decltype(r[0])>;
+  alignas(QMC_SIMD_ALIGNMENT) T vals[contract_tile_size];
+  for (int tile_first = first; tile_first < last; tile_first += contract_tile_size)
+  {
+    const int tile_last = std::min(tile_first + contract_tile_size, last);
+    evaluate_v_impl(spline, r[0], r[1], r[2], vals, tile_first, tile_last);
+    contract(static_cast<const T*>(vals), tile_first, tile_last);
+  }
+}
+
+/** evaluate3d_contract at multiple positions in the range [first,last), see evaluate3d_multi
+ * @param contract called as contract(ip, vals, tile_first, tile_last)
+ */
+template<typename SPLINET, typename PTV, typename F>
+inline void evaluate3d_contract_multi(const SPLINET& spline, const PTV& rs, int first, int last, F&& contract)
+{
+  for (int ip = 0; ip < rs.size(); ip++)
+    evaluate3d_contract(spline, rs[ip], first, last, [&](const auto* vals, int tile_first, int tile_last) {
+      contract(ip, vals, tile_first, tile_last);
+    });
+}
+
 } // namespace spline2
 #endif
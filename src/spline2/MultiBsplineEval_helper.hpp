@@ -28,19 +28,19 @@ namespace spline2
 /** define computeLocationAndFractional: common to any implementation
  * compute the location of the spline grid point and residual coordinates
  * also it precomputes auxiliary array a, b and c
+ * SPLINET is any einspline-like 3D multi spline object providing the grids
  */
-template<typename T>
-inline void computeLocationAndFractional(
-    const typename qmcplusplus::bspline_traits<T, 3>::SplineType* restrict spline_m,
-    T x,
-    T y,
-    T z,
-    int& ix,
-    int& iy,
-    int& iz,
-    T a[4],
-    T b[4],
-    T c[4])
+template<typename SPLINET, typename T>
+inline void computeLocationAndFractional(const SPLINET* restrict spline_m,
+                                         T x,
+                                         T y,
+                                         T z,
+                                         int& ix,
+                                         int& iy,
+                                         int& iz,
+                                         T a[4],
+                                         T b[4],
+                                         T c[4])
 {
   x -= spline_m->x_grid.start;
   y -= spline_m->y_grid.start;
@@ -61,24 +61,23 @@ inline void computeLocationAndFractional(
  * compute the location of the spline grid point and residual coordinates
  * also it precomputes auxiliary array (a,b,c) (da,db,dc) (d2a,d2b,d2c)
  */
-template<typename T>
-inline void computeLocationAndFractional(
-    const typename qmcplusplus::bspline_traits<T, 3>::SplineType* restrict spline_m,
-    T x,
-    T y,
-    T z,
-    int& ix,
-    int& iy,
-    int& iz,
-    T a[4],
-    T b[4],
-    T c[4],
-    T da[4],
-    T db[4],
-    T dc[4],
-    T d2a[4],
-    T d2b[4],
-    T d2c[4])
+template<typename SPLINET, typename T>
+inline void computeLocationAndFractional(const SPLINET* restrict spline_m,
+                                         T x,
+                                         T y,
+                                         T z,
+                                         int& ix,
+                                         int& iy,
+                                         int& iz,
+                                         T a[4],
+                                         T b[4],
+                                         T c[4],
+                                         T da[4],
+                                         T db[4],
+                                         T dc[4],
+                                         T d2a[4],
+                                         T d2b[4],
+                                         T d2c[4])
 {
   x -= spline_m->x_grid.start;
   y -= spline_m->y_grid.start;
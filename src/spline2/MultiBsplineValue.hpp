@@ -14,6 +14,8 @@
 #ifndef SPLINE2_MULTIEINSPLINE_VALUE_STD3_HPP
 #define SPLINE2_MULTIEINSPLINE_VALUE_STD3_HPP
 
+#include <cassert>
+
 namespace spline2
 {
 /** define evaluate: common to any implementation */
@@ -53,5 +55,37 @@ inline void evaluate_v_impl(const typename qmcplusplus::bspline_traits<T, 3>::Sp
     }
 }
 
+/** evaluate_v_impl for a single spline UBspline_3d_(s,d)
+ * It lets the multi-position helpers drive tables holding one function without padding them to a multi spline.
+ * Only the range [first,last) = [0,1) is valid.
+ */
+template<typename T>
+inline void evaluate_v_impl(const typename qmcplusplus::bspline_traits<T, 3>::SingleSplineType* restrict spline,
+                            T x,
+                            T y,
+                            T z,
+                            T* restrict vals,
+                            int first,
+                            int last)
+{
+  assert(first == 0 && last == 1);
+  int ix, iy, iz;
+  T a[4], b[4], c[4];
+
+  computeLocationAndFractional(spline, x, y, z, ix, iy, iz, a, b, c);
+
+  const intptr_t xs = spline->x_stride;
+  const intptr_t ys = spline->y_stride;
+
+  T val(0);
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+    {
+      const T* restrict coefs = spline->coefs + ((ix + i) * xs + (iy + j) * ys + iz);
+      val += a[i] * b[j] * (c[0] * coefs[0] + c[1] * coefs[1] + c[2] * coefs[2] + c[3] * coefs[3]);
+    }
+  vals[0] = val;
+}
+
 } // namespace spline2
 #endif
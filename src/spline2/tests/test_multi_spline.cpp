@@ -14,6 +14,7 @@
 
 #include "OhmmsSoA/VectorSoaContainer.h"
 #include "spline2/MultiBspline.hpp"
+#include "spline2/MultiBsplineCompressed.hpp"
 #include "spline2/MultiBsplineEval.hpp"
 #include "QMCWaveFunctions/BsplineFactory/contraction_helper.hpp"
 #include "config/stdlib/Constants.h"
@@ -338,4 +339,179 @@ TEST_CASE("MultiBspline periodic double large", "[.spline2]")
 
 TEST_CASE("MultiBspline periodic float", "[spline2]") { test_splines<float>().test(); }
 
+TEST_CASE("MultiBsplineCompressed", "[spline2]")
+{
+  using T = float;
+  test_splines_base<T, 8, 3> base;
+  const int npad = base.npad;
+
+  MultiBspline<T> bs;
+  bs.create(base.grid, base.bc, npad);
+  bs.flush_zero();
+
+  // splines of very different magnitudes check the per spline scaling
+  const double amplitudes[3] = {1.0, 1e-3, 50.0};
+  BsplineAllocator<double> mAllocator;
+  for (int i = 0; i < base.num_splines; i++)
+  {
+    std::vector<double> data(base.data);
+    for (auto& d : data)
+      d *= amplitudes[i];
+    UBspline_3d_d* aspline = mAllocator.allocateUBspline(base.grid[0], base.grid[1], base.grid[2], base.bc[0],
+                                                         base.bc[1], base.bc[2], data.data());
+    bs.copy_spline(aspline, i);
+    mAllocator.destroy(aspline);
+  }
+
+  MultiBsplineCompressed<T> compressed(*bs.getSplinePtr());
+  REQUIRE(compressed.num_splines() == npad);
+  CHECK(compressed.sizeInByte() == bs.sizeInByte() / 2 + npad * sizeof(T));
+
+  aligned_vector<T> v(npad), v_ref(npad);
+  VectorSoaContainer<T, 3> dv(npad), dv_ref(npad);
+  VectorSoaContainer<T, 6> hess(npad), hess_ref(npad);
+  VectorSoaContainer<T, 10> ghess(npad), ghess_ref(npad);
+
+  for (const TinyVector<T, 3>& pos : {TinyVector<T, 3>{0, 0, 0}, TinyVector<T, 3>{0.1, 0.2, 0.3},
+                                      TinyVector<T, 3>{0.77, 0.41, 0.93}})
+  {
+    spline2::evaluate3d(bs.getSplinePtr(), pos, v_ref);
+    spline2::evaluate3d(compressed.getSplinePtr(), pos, v);
+    for (int i = 0; i < base.num_splines; i++)
+      CHECK(v[i] == Approx(v_ref[i]).margin(1e-4 * amplitudes[i]));
+
+    spline2::evaluate3d_vgh(bs.getSplinePtr(), pos, v_ref, dv_ref, hess_ref);
+    spline2::evaluate3d_vgh(compressed.getSplinePtr(), pos, v, dv, hess);
+    for (int i = 0; i < base.num_splines; i++)
+    {
+      CHECK(v[i] == Approx(v_ref[i]).margin(1e-4 * amplitudes[i]));
+      for (int idim = 0; idim < 3; idim++)
+        CHECK(dv[i][idim] == Approx(dv_ref[i][idim]).margin(1e-3 * amplitudes[i]));
+      for (int ih = 0; ih < 6; ih++)
+        CHECK(hess[i][ih] == Approx(hess_ref[i][ih]).margin(1e-2 * amplitudes[i]));
+    }
+
+    spline2::evaluate3d_vghgh(bs.getSplinePtr(), pos, v_ref, dv_ref, hess_ref, ghess_ref);
+    spline2::evaluate3d_vghgh(compressed.getSplinePtr(), pos, v, dv, hess, ghess);
+    for (int i = 0; i < base.num_splines; i++)
+      for (int igh = 0; igh < 10; igh++)
+        CHECK(ghess[i][igh] == Approx(ghess_ref[i][igh]).margin(1e-1 * amplitudes[i]));
+  }
+
+  const auto error = spline2::compressionError(bs.getSplinePtr(), compressed.getSplinePtr(), 16);
+  CHECK(error.max_abs_value > amplitudes[0]);
+  CHECK(error.max_abs_error < 1e-4 * error.max_abs_value);
+  CHECK(error.rms_error <= error.max_abs_error);
+}
+
+TEST_CASE("MultiBspline evaluate3d_contract", "[spline2]")
+{
+  using T = float;
+  // more splines than a tile
+  test_splines_base<T, 8, 100> base;
+  const int npad = base.npad;
+
+  MultiBspline<T> bs;
+  bs.create(base.grid, base.bc, npad);
+  bs.flush_zero();
+  BsplineAllocator<double> mAllocator;
+  for (int i = 0; i < base.num_splines; i++)
+  {
+    std::vector<double> data(base.data);
+    for (auto& d : data)
+      d *= (i % 2 ? -1.0 : 1.0) * (1.0 + 0.01 * i);
+    UBspline_3d_d* aspline = mAllocator.allocateUBspline(base.grid[0], base.grid[1], base.grid[2], base.bc[0],
+                                                         base.bc[1], base.bc[2], data.data());
+    bs.copy_spline(aspline, i);
+    mAllocator.destroy(aspline);
+  }
+
+  std::vector<double> weights(npad);
+  for (int i = 0; i < npad; i++)
+    weights[i] = 0.5 - 0.01 * i;
+
+  const std::vector<TinyVector<T, 3>> rs{{0, 0, 0}, {0.1, 0.2, 0.3}, {0.77, 0.41, 0.93}};
+  aligned_vector<T> v(npad);
+  // the second range starts at an aligned spline inside the first tile
+  for (const int first : {0, 16})
+  {
+    std::vector<double> refs;
+    for (const auto& pos : rs)
+    {
+      spline2::evaluate3d(bs.getSplinePtr(), pos, v);
+      double ref = 0;
+      for (int i = first; i < npad; i++)
+        ref += weights[i] * v[i];
+      refs.push_back(ref);
+
+      double sum    = 0;
+      int num_tiles = 0;
+      const auto contract = [&](const T* vals, int tile_first, int tile_last) {
+        CHECK(tile_last - tile_first <= spline2::contract_tile_size);
+        for (int i = tile_first; i < tile_last; i++)
+          sum += weights[i] * vals[i - tile_first];
+        num_tiles++;
+      };
+      spline2::evaluate3d_contract(bs.getSplinePtr(), pos, first, npad, contract);
+      CHECK(num_tiles == (npad - first + spline2::contract_tile_size - 1) / spline2::contract_tile_size);
+      CHECK(sum == Approx(ref));
+    }
+
+    std::vector<double> sums(rs.size(), 0.0);
+    spline2::evaluate3d_contract_multi(bs.getSplinePtr(), rs, first, npad,
+                                       [&](int ip, const T* vals, int tile_first, int tile_last) {
+                                         for (int i = tile_first; i < tile_last; i++)
+                                           sums[ip] += weights[i] * vals[i - tile_first];
+                                       });
+    for (int ip = 0; ip < rs.size(); ip++)
+      CHECK(sums[ip] == Approx(refs[ip]));
+  }
+}
+
+template<typename T>
+void test_single_spline_multi()
+{
+  test_splines_base<T, 8, 1> base;
+  const int npad = base.npad;
+
+  MultiBspline<T> bs;
+  bs.create(base.grid, base.bc, npad);
+  bs.flush_zero();
+  BsplineAllocator<double> mAllocator;
+  UBspline_3d_d* aspline = mAllocator.allocateUBspline(base.grid[0], base.grid[1], base.grid[2], base.bc[0],
+                                                       base.bc[1], base.bc[2], base.data.data());
+  bs.copy_spline(aspline, 0);
+
+  // the single spline holds the same coefficients as the first spline of the multi spline
+  BsplineAllocator<T> sAllocator;
+  typename bspline_traits<T, 3>::BCType bc_t[3];
+  for (int d = 0; d < 3; d++)
+  {
+    bc_t[d].lCode = bc_t[d].rCode = PERIODIC;
+    bc_t[d].lVal = bc_t[d].rVal = 0;
+  }
+  auto* single = sAllocator.allocateUBspline(base.grid[0], base.grid[1], base.grid[2], bc_t[0], bc_t[1], bc_t[2]);
+  std::copy_n(aspline->coefs, aspline->coefs_size, single->coefs);
+  mAllocator.destroy(aspline);
+
+  // the last position sits on the upper edge of the periodic box
+  const std::vector<TinyVector<T, 3>> rs{{0, 0, 0}, {0.1, 0.2, 0.3}, {0.77, 0.41, 0.93}, {0.5, 0.99, 1}};
+  aligned_vector<T> v(npad);
+  std::array<T, 1> val;
+  int count = 0;
+  spline2::evaluate3d_multi(single, rs, val, 0, 1, [&](int ip) {
+    spline2::evaluate3d(bs.getSplinePtr(), rs[ip], v);
+    CHECK(val[0] == Approx(v[0]));
+    count++;
+  });
+  CHECK(count == rs.size());
+  sAllocator.destroy(single);
+}
+
+TEST_CASE("single spline evaluate3d_multi", "[spline2]")
+{
+  test_single_spline_multi<double>();
+  test_single_spline_multi<float>();
+}
+
 } // namespace qmcplusplus
@@ -0,0 +1,120 @@
+#! /usr/bin/env python3
+
+'''
+Read the column stream files (.col) written by the PerParticleTrace estimator.
+Can be used as a library or as CLI tool
+
+read_column_stream.py qmc.s000.particle_trace.col           # Columns and number of rows
+read_column_stream.py qmc.s000.particle_trace.col R weight  # Rows of the columns R and weight
+
+The layout is described in docs/methods.rst and src/Estimators/ColumnStream.h.
+'''
+
+from __future__ import print_function
+
+import struct
+import sys
+import zlib
+from collections import namedtuple
+
+import numpy as np
+
+MAGIC = b'QMCCOL01'
+
+# ColumnType of ColumnStream.h, stored as written by a little endian host
+COLUMN_DTYPES = [np.dtype('<i8'), np.dtype('<f4'), np.dtype('<f8')]
+
+# bits of ColumnCodec
+COLUMN_ZLIB = 1
+COLUMN_SHUFFLE = 2
+
+Column = namedtuple('Column', ['name', 'dtype', 'width'])
+
+
+def _read(f, fmt):
+    size = struct.calcsize(fmt)
+    data = f.read(size)
+    if len(data) != size:
+        raise EOFError('truncated column stream')
+    return struct.unpack(fmt, data)
+
+
+def read_layout(f):
+    '''Read the header of an open column stream, returns a list of Column'''
+    if f.read(len(MAGIC)) != MAGIC:
+        raise ValueError('not a QMCPACK column stream')
+    num_columns, = _read(f, '<Q')
+    layout = []
+    for _ in range(num_columns):
+        name_length, = _read(f, '<Q')
+        name = f.read(name_length).decode()
+        column_type, width = _read(f, '<BQ')
+        layout.append(Column(name, COLUMN_DTYPES[column_type], width))
+    return layout
+
+
+def _decode(stored, codec, column, rows):
+    raw = zlib.decompress(stored) if codec & COLUMN_ZLIB else stored
+    num_values = rows * column.width
+    if codec & COLUMN_SHUFFLE:
+        # the k-th bytes of all the values were stored together
+        planes = np.frombuffer(raw, dtype=np.uint8).reshape(column.dtype.itemsize, num_values)
+        raw = planes.T.tobytes()
+    return np.frombuffer(raw, dtype=column.dtype).reshape(rows, column.width)
+
+
+def read_columns(file_name, names=None):
+    '''
+    Read a column stream file.
+    names: columns to read, all of them by default. The other columns are skipped without decoding.
+    Returns the layout and a dict from the column names to arrays of shape (rows, width).
+    '''
+    with open(file_name, 'rb') as f:
+        layout = read_layout(f)
+        if names is None:
+            names = [column.name for column in layout]
+        unknown = set(names) - set(column.name for column in layout)
+        if unknown:
+            raise KeyError('no column ' + ', '.join(sorted(unknown)))
+        chunks = dict((name, []) for name in names)
+        while f.read(1):
+            f.seek(-1, 1)
+            rows, = _read(f, '<Q')
+            for column in layout:
+                codec, stored_size = _read(f, '<BQ')
+                if column.name in chunks:
+                    stored = f.read(stored_size)
+                    if len(stored) != stored_size:
+                        raise EOFError('truncated column stream')
+                    chunks[column.name].append(_decode(stored, codec, column, rows))
+                else:
+                    f.seek(stored_size, 1)
+    columns = {}
+    for column in layout:
+        if column.name in chunks:
+            parts = chunks[column.name]
+            columns[column.name] = np.concatenate(parts) if parts else np.empty((0, column.width), column.dtype)
+    return layout, columns
+
+
+def main(argv):
+    if len(argv) < 2:
+        print(__doc__)
+        return 1
+    names = argv[2:] if len(argv) > 2 else None
+    layout, columns = read_columns(argv[1], names)
+    if names is None:
+        rows = len(next(iter(columns.values()))) if columns else 0
+        print('{} rows'.format(rows))
+        for column in layout:
+            print('  {:24s} {:8s} width {}'.format(column.name, column.dtype.name, column.width))
+    else:
+        np.set_printoptions(threshold=sys.maxsize, linewidth=200)
+        for name in names:
+            print(name)
+            print(columns[name])
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))